@@ -48,11 +48,18 @@ int main(int argc, char *argv[])
          break;
 
       // Send command to the OSSIM tool server:
-      if (!otc.execute(command.chars()))
+      bool ok = otc.execute(command.chars());
+      const char* text = otc.getTextResponse();
+      if (text && *text)
+         cout<<"Text response:\n-----------------\n"<<text<<"\n-----------------"<<endl;
+      if (!ok)
       {
          cout << "\nossim-client: Error encountred on execute."<<endl;
-         break;
+         continue;
       }
+      ossimFilename product = otc.getProductFilePath();
+      if (!product.empty() && !product.isDir())
+         cout<<"\nossim-client: Product written to <"<<product<<">."<<endl;
    }
 
    cout << "\nossim-client: Closing connection to OSSIM server."<<endl;
@@ -17,10 +17,16 @@ int main(int argc, char *argv[])
 
    const char* DEFAULT_PORT = "ossimd";
    const char* portid = DEFAULT_PORT;
+
+   // Service name, port number or path of a local socket (anything with a '/'):
    if (argc > 1)
       portid = argv[1];
 
+   // Optional number of worker threads, default is the ossim_threads preference:
    ossimToolServer ots;
+   if (argc > 2)
+      ots.setNumberOfThreads(ossimString(argv[2]).toUInt32());
+
    ots.startListening(portid);
 
    return 0;
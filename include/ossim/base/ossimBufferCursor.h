@@ -0,0 +1,171 @@
+//*******************************************************************
+//
+// License:  MIT
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description:
+//
+// Lightweight read cursor over a contiguous character buffer.
+//
+//*************************************************************************
+#ifndef ossimBufferCursor_HEADER
+#define ossimBufferCursor_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <cstddef>
+#include <ios>
+#include <string>
+
+/**
+ * Read cursor over a character buffer that mirrors the subset of the
+ * std::istream unformatted input interface used by the XML parsers: peek,
+ * get, ignore, unget, tellg, seekg and the state queries.
+ *
+ * State handling follows the standard stream rules (an operation on a stream
+ * that is not good sets failbit, reading past the end sets eofbit, unget and
+ * seekg clear eofbit first) so a parser templated on the input type gives the
+ * same result for both.  Unlike a stream every call is inline with no
+ * sentry, locale or virtual dispatch, which is where most of the time goes
+ * when parsing a file one character at a time.
+ *
+ * The buffer is not copied and must outlive the cursor.
+ */
+class ossimBufferCursor
+{
+public:
+   ossimBufferCursor(const char* buffer, std::size_t size)
+      :
+      m_begin(buffer),
+      m_pos(buffer),
+      m_end(buffer + size),
+      m_state(std::ios_base::goodbit)
+   {
+   }
+
+   explicit ossimBufferCursor(const std::string& buffer)
+      :
+      m_begin(buffer.data()),
+      m_pos(buffer.data()),
+      m_end(buffer.data() + buffer.size()),
+      m_state(std::ios_base::goodbit)
+   {
+   }
+
+   int peek()
+   {
+      if ( !good() )
+      {
+         m_state |= std::ios_base::failbit;
+         return std::char_traits<char>::eof();
+      }
+      if ( m_pos == m_end )
+      {
+         m_state |= std::ios_base::eofbit;
+         return std::char_traits<char>::eof();
+      }
+      return static_cast<unsigned char>(*m_pos);
+   }
+
+   int get()
+   {
+      if ( !good() )
+      {
+         m_state |= std::ios_base::failbit;
+         return std::char_traits<char>::eof();
+      }
+      if ( m_pos == m_end )
+      {
+         m_state |= std::ios_base::eofbit | std::ios_base::failbit;
+         return std::char_traits<char>::eof();
+      }
+      return static_cast<unsigned char>(*m_pos++);
+   }
+
+   ossimBufferCursor& ignore(std::size_t n = 1)
+   {
+      if ( !good() )
+      {
+         m_state |= std::ios_base::failbit;
+      }
+      else if ( static_cast<std::size_t>(m_end - m_pos) < n )
+      {
+         m_pos = m_end;
+         m_state |= std::ios_base::eofbit;
+      }
+      else
+      {
+         m_pos += n;
+      }
+      return *this;
+   }
+
+   ossimBufferCursor& unget()
+   {
+      m_state &= ~std::ios_base::eofbit;
+      if ( !good() )
+      {
+         m_state |= std::ios_base::failbit;
+      }
+      else if ( m_pos == m_begin )
+      {
+         m_state |= std::ios_base::badbit;
+      }
+      else
+      {
+         --m_pos;
+      }
+      return *this;
+   }
+
+   std::streampos tellg()
+   {
+      if ( !good() )
+      {
+         m_state |= std::ios_base::failbit;
+         return std::streampos(-1);
+      }
+      return std::streampos( static_cast<std::streamoff>(m_pos - m_begin) );
+   }
+
+   ossimBufferCursor& seekg(std::streampos pos)
+   {
+      m_state &= ~std::ios_base::eofbit;
+      if ( !good() )
+      {
+         m_state |= std::ios_base::failbit;
+      }
+      else
+      {
+         std::streamoff offset = pos;
+         if ( (offset < 0) || (offset > (m_end - m_begin)) )
+         {
+            m_state |= std::ios_base::failbit;
+         }
+         else
+         {
+            m_pos = m_begin + offset;
+         }
+      }
+      return *this;
+   }
+
+   bool good() const { return m_state == std::ios_base::goodbit; }
+   bool eof()  const { return (m_state & std::ios_base::eofbit) != 0; }
+   bool fail() const
+   {
+      return (m_state & (std::ios_base::failbit | std::ios_base::badbit)) != 0;
+   }
+   bool bad()  const { return (m_state & std::ios_base::badbit) != 0; }
+
+   /** @return Number of characters not yet consumed. */
+   std::size_t remaining() const { return m_end - m_pos; }
+
+private:
+   const char*             m_begin;
+   const char*             m_pos;
+   const char*             m_end;
+   std::ios_base::iostate  m_state;
+};
+
+#endif /* #ifndef ossimBufferCursor_HEADER */
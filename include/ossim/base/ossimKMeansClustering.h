@@ -21,6 +21,13 @@
  * populations of the corresponding samples are provided as well. The latter scheme is used by the
  * ossimKMeansFilter for clustering pixel values given the image histogram.
  *
+ * Samples can also be vectors (e.g. the bands of a pixel), see setSamples() with num_dims. These
+ * are seeded with k-means++ and refined with Lloyd iterations whose assignment step is spread
+ * over threads, each with its own centroid accumulators. With setBatchSize() the refinement uses
+ * random mini-batches instead, which converges in a fraction of the passes for large sample sets.
+ * Distances are computed for all clusters at once, one band at a time, so the inner loop runs
+ * over contiguous centroid values and vectorizes.
+ *
  **************************************************************************************************/
 class OSSIM_DLL ossimKMeansClustering : public ossimReferenced
 {
@@ -44,9 +51,51 @@ public:
 
    void setNumClusters(ossim_uint32 K);
    template<class T> void setSamples(T* samples, ossim_uint32 num_entries);
+
+   /**
+    * Multivariate samples: num_entries vectors of num_dims values each, one vector after the
+    * other (band interleaved by pixel). A num_dims of 1 is the same as the scalar setSamples().
+    */
+   template<class T> void setSamples(T* samples, ossim_uint32 num_entries, ossim_uint32 num_dims);
+
    template<class T> void setPopulations(T* populations, ossim_uint32 num_entries);
    bool computeKmeans();
 
+   /**
+    * Multivariate only. Samples drawn per mini-batch update, 0 (default) for full Lloyd passes
+    * over all samples.
+    */
+   void setBatchSize(ossim_uint32 n) { m_batchSize = n; }
+
+   /** Multivariate only. Full passes, or batches in mini-batch mode, default 20. */
+   void setMaxIterations(ossim_uint32 n) { m_maxIterations = n; }
+
+   /** Threads for the multivariate passes, 0 (default) for ossim::getNumberOfThreads(). */
+   void setNumThreads(ossim_uint32 n) { m_numThreads = n; }
+
+   ossim_uint32 getNumDimensions() const { return m_numDims; }
+
+   /**
+    * Restores clusters computed earlier, e.g. read back from a saved state, in place of
+    * computeKmeans(). centroids holds clusters.size() vectors of num_dims values, one cluster
+    * after the other.
+    */
+   void setClusters(const std::vector<Cluster>& clusters,
+                    const double* centroids,
+                    ossim_uint32 num_dims);
+
+   /** Multivariate centroid of the cluster, getNumDimensions() values. */
+   const double* getCentroid(ossim_uint32 groupId) const;
+
+   /** @return Index of the centroid nearest to the sample of getNumDimensions() values. */
+   ossim_uint32 classify(const double* sample) const;
+
+   /**
+    * Nearest centroids of count samples laid out as in setSamples(), over setNumThreads()
+    * threads.
+    */
+   void classify(const double* samples, ossim_uint32 count, ossim_uint32* groupIds) const;
+
    ossim_uint32 getNumClusters() const { return m_clusters.size(); }
    double getMean(ossim_uint32 groupId) const;
    double getSigma(ossim_uint32 groupId) const;
@@ -58,23 +107,49 @@ public:
    void setVerbose(bool v=true) const  { m_verbose = v; }
 
 private:
+   bool computeMultivariate();
+   void seedCentroids();
+   void setCentroid(ossim_uint32 groupId, const double* value);
+
+   /** Squared distances from the sample to every centroid, and the nearest one. */
+   ossim_uint32 nearest(const double* sample, double* distances) const;
+
+   ossim_uint32 getThreadCount() const;
+
    ossim_uint32 m_numEntries;
    double* m_samples;
    double* m_populations; // use double to handle arbitrarily large datasets
    std::vector<Cluster> m_clusters;
    bool m_clustersValid;
    mutable bool m_verbose;
+
+   ossim_uint32 m_numDims;
+   ossim_uint32 m_batchSize;
+   ossim_uint32 m_maxIterations;
+   ossim_uint32 m_numThreads;
+   std::vector<double> m_centroids;  // K x num_dims, cluster after cluster
+   std::vector<double> m_centroidsT; // num_dims x K, band after band, for the distance loops
 };
 
 template<class T> void ossimKMeansClustering::setSamples(T* samples, ossim_uint32 num_entries)
 {
-   if ((num_entries == 0) || (samples == 0))
+   setSamples(samples, num_entries, 1);
+}
+
+template<class T> void ossimKMeansClustering::setSamples(T* samples,
+                                                         ossim_uint32 num_entries,
+                                                         ossim_uint32 num_dims)
+{
+   if ((num_entries == 0) || (samples == 0) || (num_dims == 0))
       return;
 
    m_clustersValid = false;
    m_numEntries = num_entries;
-   m_samples = new double[num_entries];
-   for (ossim_uint32 i=0; i<num_entries; i++)
+   m_numDims = num_dims;
+   delete [] m_samples;
+   const size_t count = (size_t) num_entries * num_dims;
+   m_samples = new double[count];
+   for (size_t i=0; i<count; i++)
       m_samples[i] = (double) samples[i];
 }
 
@@ -85,6 +160,7 @@ template<class T> void ossimKMeansClustering::setPopulations(T* populations,
       return;
 
    m_clustersValid = false;
+   delete [] m_populations;
    m_populations = new double[num_entries];
    for (ossim_uint32 i=0; i<num_entries; i++)
       m_populations[i] = (double) populations[i];
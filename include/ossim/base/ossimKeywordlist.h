@@ -435,6 +435,21 @@ public:
    virtual bool parseStream(ossim::istream& is);
    virtual bool parseString(const std::string& inString);
 
+   /**
+    * @brief Parses keywords from a contiguous memory buffer.
+    *
+    * Same grammar and same resulting map as parseStream, but works with
+    * pointers into the buffer and appends runs of characters at once instead
+    * of one istream::get() per character.  parseFile and parseString use
+    * this.  parseStream still reads from the stream as callers can embed a
+    * keyword list in a larger stream.
+    *
+    * @param buffer Start of data.
+    * @param size Size of buffer in bytes.
+    * @return true if parsed, false on mal formed input.
+    */
+   bool parseBuffer(const char* buffer, std::size_t size);
+
    /**
    * This return the sorted keys if you have a list.
    * Example:
@@ -575,6 +590,15 @@ protected:
    KeywordlistParseState readValue(ossimString& sequence, ossim::istream& in)const;
    KeywordlistParseState readKeyAndValuePair(ossimString& key,
                                              ossimString& value, ossim::istream& in)const;
+
+   /** Buffer versions of the above used by parseBuffer. */
+   KeywordlistParseState readKey(std::string& sequence,
+                                 const char*& pos, const char* end)const;
+   KeywordlistParseState readValue(std::string& sequence,
+                                   const char*& pos, const char* end)const;
+
+   /** Handles a "#" line, e.g. "#include <file>", read as a value. */
+   void processPreprocDirective(const ossimString& sequence);
    
    // Method to see if keyword exists in list.
    KeywordMap::iterator getMapEntry(const std::string& key);
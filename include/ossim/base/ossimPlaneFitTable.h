@@ -0,0 +1,64 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Summed-area tables for constant time least squares plane
+// fits over any rectangle of a grid.
+//
+//*******************************************************************
+#ifndef ossimPlaneFitTable_HEADER
+#define ossimPlaneFitTable_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <vector>
+
+/**
+ * @brief Least squares planes z(x,y) = a*x + b*y + c over rectangles of a grid, each from a
+ * handful of lookups.
+ *
+ * build() makes summed-area tables (integral images) of z, x*z, y*z and z*z, and of a count of
+ * flagged cells, e.g. nulls. Over a whole rectangle of cells, with x and y taken from its center,
+ * the sums of x, y and x*y are zero and those of x*x and y*y are known, so the normal equations of
+ * ossimLeastSquaresPlane come apart and the plane and the RMS of its residuals follow from the four
+ * tables. Heights are kept relative to their mean to hold on to precision.
+ */
+class OSSIMDLLEXPORT ossimPlaneFitTable
+{
+public:
+   ossimPlaneFitTable();
+
+   /**
+    * Builds the tables of width x height heights, in rows. Cells with a non-zero flag are counted
+    * and left out of the sums. Either pointer may be null: without heights only the count of flags
+    * is kept, without flags no cell is left out.
+    */
+   void build(const double* z, const ossim_uint8* flags, ossim_uint32 width, ossim_uint32 height);
+
+   /** Number of flagged cells in the width x height rectangle at (x, y). */
+   ossim_uint32 getFlagCount(ossim_uint32 x, ossim_uint32 y,
+                             ossim_uint32 width, ossim_uint32 height) const;
+
+   /**
+    * Fits the plane to the width x height rectangle at (x, y), at least 2 x 2. Returns false if a
+    * cell of it is flagged or there are no heights.
+    *
+    * @param a set to dz/dx a cell.
+    * @param b set to dz/dy a cell.
+    * @param rms set to the RMS of the vertical residuals.
+    */
+   bool fit(ossim_uint32 x, ossim_uint32 y, ossim_uint32 width, ossim_uint32 height,
+            double& a, double& b, double& rms) const;
+
+private:
+   double sum(const std::vector<double>& table, ossim_uint32 x, ossim_uint32 y,
+              ossim_uint32 width, ossim_uint32 height) const;
+
+   ossim_uint32 m_width; //!< Of the tables, one more than the grid.
+   std::vector<double> m_z;
+   std::vector<double> m_xz;
+   std::vector<double> m_yz;
+   std::vector<double> m_zz;
+   std::vector<ossim_uint32> m_flags;
+};
+
+#endif /* #ifndef ossimPlaneFitTable_HEADER */
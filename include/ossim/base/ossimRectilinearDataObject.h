@@ -11,11 +11,21 @@
 #ifndef ossimRectilinearDataObject_HEADER
 #define ossimRectilinearDataObject_HEADER
 #include <ossim/base/ossimDataObject.h>
+#include <ossim/base/ossimTileBufferPool.h>
 
 class OSSIMDLLEXPORT ossimRectilinearDataObject : public ossimDataObject
 {
 public:
 
+   /**
+    * Type of m_dataBuffer. Before tile buffers were pooled it was
+    * std::vector<ossim_uint8>; code outside the library that names that type
+    * for m_dataBuffer, e.g. to pass it by reference, must use this instead and
+    * be rebuilt, as the change breaks source and binary compatibility of
+    * subclasses.
+    */
+   typedef std::vector<ossim_uint8, ossimTileBufferAllocator<ossim_uint8> > DataBuffer;
+
    /** default constructor */
    ossimRectilinearDataObject();
 
@@ -145,7 +155,9 @@ public:
 protected:
    ossim_uint64 m_numberOfDataComponents;
    ossimScalarType           m_scalarType;
-   std::vector<ossim_uint8>  m_dataBuffer;
+
+   /** Drawn from and returned to ossimTileBufferPool. */
+   DataBuffer                m_dataBuffer;
    std::vector<ossim_uint64> m_spatialExtents;
    
 TYPE_DATA
@@ -0,0 +1,151 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimTileBufferPool_HEADER
+#define ossimTileBufferPool_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/***************************************************************************************************
+ * Size-class pool for the data buffers of ossimRectilinearDataObject, i.e. every ossimImageData
+ * tile made by ossimImageDataFactory or directly.
+ *
+ * Requests are rounded up to a size class, four classes per power of two, so a 256x256 tile of
+ * any scalar type and band count reuses the buffer of a tile of the same class. Freed buffers go
+ * first to a cache owned by the calling thread, no locking, then to a global cache shared under a
+ * mutex. Both are capped in bytes, past the caps buffers are released to the heap. A thread's
+ * cache moves to the global cache when the thread exits.
+ *
+ * Requests smaller than getMinimumPooledSize() and larger than the biggest class go straight to
+ * the heap.
+ *
+ * Preferences, read the first time the pool is used:
+ *    tile_pool.enabled:            true
+ *    tile_pool.max_bytes:          268435456   (global cache)
+ *    tile_pool.thread_cache_bytes: 4194304     (each thread's cache)
+ **************************************************************************************************/
+class OSSIM_DLL ossimTileBufferPool
+{
+public:
+   struct Statistics
+   {
+      ossim_uint64 allocations;     ///< Requests of a pooled size.
+      ossim_uint64 threadHits;      ///< Served by the thread cache.
+      ossim_uint64 globalHits;      ///< Served by the global cache.
+      ossim_uint64 heapAllocations; ///< Served by the heap, pooled size or not.
+      ossim_uint64 heapReleases;    ///< Buffers released to the heap.
+      ossim_uint64 bytesInUse;      ///< Bytes of pooled buffers handed out and not returned.
+      ossim_uint64 bytesCached;     ///< Bytes held by the global cache.
+      ossim_uint64 peakBytes;       ///< Peak of bytesInUse + bytesCached + thread caches.
+   };
+
+   static ossimTileBufferPool* instance();
+
+   /** @return At least bytes, from a cache when one has a buffer of the same class. */
+   void* allocate(std::size_t bytes);
+
+   /** Returns a buffer from allocate(), bytes must be the size it was asked for. */
+   void deallocate(void* p, std::size_t bytes);
+
+   /** Releases all cached buffers to the heap, those of other threads' caches excepted. */
+   void trim();
+
+   void setEnabled(bool flag);
+   bool getEnabled() const { return m_enabled; }
+
+   /** Caps of the global cache and of each thread's cache. 0 disables the cache. */
+   void setMaxBytes(ossim_uint64 bytes);
+   ossim_uint64 getMaxBytes() const { return m_maxBytes; }
+   void setThreadCacheBytes(ossim_uint64 bytes) { m_threadCacheBytes = bytes; }
+   ossim_uint64 getThreadCacheBytes() const { return m_threadCacheBytes; }
+
+   Statistics getStatistics() const;
+   void resetStatistics();
+   std::ostream& print(std::ostream& out) const;
+
+   /** @return Size of the class bytes falls in, bytes if it is not pooled. */
+   static std::size_t getClassSize(std::size_t bytes);
+   static std::size_t getMinimumPooledSize();
+
+private:
+   struct ThreadCache;
+   friend struct ThreadCache;
+
+   ossimTileBufferPool();
+   ossimTileBufferPool(const ossimTileBufferPool&);
+   void operator=(const ossimTileBufferPool&);
+
+   static int classOf(std::size_t bytes);
+   static ThreadCache* threadCache();
+
+   /** Moves buffers to the global cache, releases those over the cap. */
+   void giveBack(int sizeClass, void** buffers, std::size_t count);
+   void* heapAllocate(std::size_t bytes);
+   void heapRelease(void* p);
+   void notePeak();
+
+   mutable std::mutex              m_mutex;
+   std::vector< std::vector<void*> > m_free;
+   std::atomic<ossim_uint64>       m_cachedBytes;
+   std::atomic<bool>               m_enabled;
+   std::atomic<ossim_uint64>       m_maxBytes;
+   std::atomic<ossim_uint64>       m_threadCacheBytes;
+
+   std::atomic<ossim_uint64>       m_allocations;
+   std::atomic<ossim_uint64>       m_threadHits;
+   std::atomic<ossim_uint64>       m_globalHits;
+   std::atomic<ossim_uint64>       m_heapAllocations;
+   std::atomic<ossim_uint64>       m_heapReleases;
+   std::atomic<ossim_uint64>       m_bytesInUse;
+   std::atomic<ossim_uint64>       m_threadCachedBytes;
+   std::atomic<ossim_uint64>       m_peakBytes;
+};
+
+/**
+ * Standard allocator over ossimTileBufferPool, for containers of tile data.
+ */
+template <class T>
+class ossimTileBufferAllocator
+{
+public:
+   typedef T value_type;
+
+   ossimTileBufferAllocator() {}
+   template <class U> ossimTileBufferAllocator(const ossimTileBufferAllocator<U>&) {}
+
+   T* allocate(std::size_t n)
+   {
+      if (n > std::size_t(-1) / sizeof(T))
+         throw std::bad_alloc();
+      return static_cast<T*>(ossimTileBufferPool::instance()->allocate(n * sizeof(T)));
+   }
+
+   void deallocate(T* p, std::size_t n)
+   {
+      ossimTileBufferPool::instance()->deallocate(p, n * sizeof(T));
+   }
+};
+
+template <class T, class U>
+inline bool operator==(const ossimTileBufferAllocator<T>&, const ossimTileBufferAllocator<U>&)
+{
+   return true;
+}
+
+template <class T, class U>
+inline bool operator!=(const ossimTileBufferAllocator<T>&, const ossimTileBufferAllocator<U>&)
+{
+   return false;
+}
+
+#endif /* #ifndef ossimTileBufferPool_HEADER */
@@ -17,6 +17,7 @@
 #include <ossim/base/ossimErrorStatusInterface.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimObject.h>
+#include <ossim/base/ossimBufferCursor.h>
 
 class OSSIMDLLEXPORT ossimXmlAttribute : public ossimObject,
                                          public ossimErrorStatusInterface
@@ -34,6 +35,7 @@ public:
    ~ossimXmlAttribute();
 
    bool read(std::istream& in);
+   bool read(ossimBufferCursor& in);
    const ossimString& getName()  const;
    const ossimString& getValue() const;
    void setNameValue(const ossimString& name,
@@ -48,8 +50,9 @@ protected:
    ossimString theName;
    ossimString theValue;
 
-   bool readName(std::istream& in);
-   bool readValue(std::istream& in);
+   template <class InputType> bool readAttribute(InputType& in);
+   template <class InputType> bool readName(InputType& in);
+   template <class InputType> bool readValue(InputType& in);
 TYPE_DATA
 };
 
@@ -37,6 +37,16 @@ public:
    bool openFile(const ossimFilename &filename);
    bool readString(const ossimString& xmlString);
    bool read(std::istream &in);
+
+   /**
+    * @brief Parses a document held in memory.  This is what openFile and
+    * readString use; the input is walked with an inline cursor rather than
+    * through stream calls per character.
+    * @param buffer Start of document.
+    * @param size Size of buffer in bytes.
+    * @return true on success, false on error.
+    */
+   bool read(const char* buffer, std::size_t size);
    /**
     * Appends any matching nodes to the list supplied (should be empty):
     */
@@ -58,7 +68,8 @@ private:
    ossimString                theXmlHeader;
    ossimFilename              theFilename;
    bool                       theStrictCheckFlag;
-   bool readHeader(std::istream& in);
+   template <class InputType> bool readDocument(InputType& in);
+   template <class InputType> bool readHeader(InputType& in);
 TYPE_DATA
 };
 
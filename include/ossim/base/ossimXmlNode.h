@@ -19,6 +19,7 @@
 #include <ossim/base/ossimErrorStatusInterface.h>
 #include <ossim/base/ossimXmlAttribute.h>
 #include <ossim/base/ossimString.h>
+#include <ossim/base/ossimBufferCursor.h>
 
 
 class OSSIMDLLEXPORT ossimXmlNode : public ossimObject,
@@ -38,6 +39,8 @@ public:
 	void duplicateAttributes(ossimXmlNode::AttributeListType result)const;
    void duplicateChildren(ossimXmlNode::ChildListType& result)const;
    bool read(std::istream& in);
+   /** @brief Same as read(std::istream&) but parses from a memory buffer. */
+   bool read(ossimBufferCursor& in);
    // Appends any matching nodes to the list supplied
    void findChildNodes(const ossimString& rel_xpath,
                        ossimXmlNode::ChildListType& nodelist)const;
@@ -106,14 +109,21 @@ public:
   
 protected:
    ~ossimXmlNode();
-   bool readTag(std::istream& in,
-                ossimString& tag);
-   bool readTextContent(std::istream& in);
-   bool readEndTag(std::istream& in,
-                   ossimString& endTag);
 
-   void skipCommentTag(std::istream& in);
-   bool readCDataContent(std::istream& in);
+   //---
+   // Parsing is templated on the input so that std::istream and
+   // ossimBufferCursor share one implementation.  Definitions live in
+   // ossimXmlNode.cpp.
+   //---
+   template <class InputType> bool readNode(InputType& in);
+   template <class InputType> bool readTag(InputType& in,
+                                           ossimString& tag);
+   template <class InputType> bool readTextContent(InputType& in);
+   template <class InputType> bool readEndTag(InputType& in,
+                                              ossimString& endTag);
+
+   template <class InputType> void skipCommentTag(InputType& in);
+   template <class InputType> bool readCDataContent(InputType& in);
    ossimString                 theTag;
    ossimXmlNode*         theParentNode;
    std::vector<ossimRefPtr<ossimXmlNode> >      theChildNodes;
@@ -13,6 +13,7 @@
 #define ossim3x3ConvolutionFilter_HEADER
 #include <ossim/imaging/ossimImageSourceFilter.h>
 
+class ossimDiscreteConvolutionKernel;
 
 class ossim3x3ConvolutionFilter : public ossimImageSourceFilter
 {
@@ -68,6 +69,9 @@ protected:
    ossimRefPtr<ossimImageData> theTile;
    double theKernel[3][3];
 
+   /** theKernel for the shared engine, refreshed with null/min/max. */
+   ossimDiscreteConvolutionKernel* theConvolutionKernel;
+
    std::vector<double> theNullPixValue;
    std::vector<double> theMinPixValue;
    std::vector<double> theMaxPixValue;
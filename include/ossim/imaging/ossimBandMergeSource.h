@@ -30,8 +30,12 @@ public:
     * You can also try to do fusions by converting to an YCbCr and
     * replace the Y or intensity channel with maybe a high-pass
     * convolution on the pan.
+    *
+    * If no object feeds more than one input and the band_merge.threads
+    * preference is not 1, the input tiles are fetched in parallel.
     */
    virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& rect, ossim_uint32 resLevel=0);
+
    virtual bool getTile(ossimImageData* tile, ossim_uint32 resLevel=0);
 
    virtual void initialize();
@@ -57,6 +61,15 @@ protected:
    
    ossim_uint32 computeNumberOfInputBands()const;
 
+   /** Fetches the input tiles for the rectangle of tile and copies their bands into it. */
+   void mergeInputTiles(ossimImageData* tile, ossim_uint32 resLevel);
+
+   /** True if no object is upstream of more than one input. */
+   bool theIndependentInputsFlag;
+
+   /** Threads fetching input tiles; 1 by default, 0 uses ossim_threads. */
+   ossim_uint32 theNumberOfThreads;
+
 TYPE_DATA
 };
 #endif /* #ifndef ossimBandMergeSource_HEADER */
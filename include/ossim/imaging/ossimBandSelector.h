@@ -84,6 +84,18 @@ public:
    virtual void setOutputBandList(const std::vector<ossim_uint32>& outputBandList,
                                   bool disablePassThru=false);
    
+   /**
+    * @brief Sets whether tiles may borrow the input's pixels.
+    *
+    * If set, the selected bands of the returned tile are views of the
+    * input tile where it matches ours (see ossimImageData::setBandView)
+    * rather than copies.  The caller must then treat the tile as
+    * read-only and done with at the input's next getTile.  Off by default;
+    * keyword "borrow_input_tiles".
+    */
+   void setBorrowInputTilesFlag(bool flag);
+   bool getBorrowInputTilesFlag() const;
+
    /**
     * Returns the number of bands in a tile returned from this TileSource.
     */
@@ -182,6 +194,7 @@ protected:
    bool                                  m_passThroughFlag;
    bool                                  m_delayLoadRgbFlag;
    bool                                  m_inputIsSelectable;
+   bool                                  m_borrowInputTilesFlag;
 
 TYPE_DATA
 };
@@ -10,6 +10,7 @@
 #ifndef ossimBrightnessContrastSource_HEADER
 #define ossimBrightnessContrastSource_HEADER
 #include <ossim/imaging/ossimImageSourceFilter.h>
+#include <ossim/imaging/ossimRemapChain.h>
 
 class OSSIM_DLL ossimBrightnessContrastSource : public ossimImageSourceFilter
 {
@@ -34,6 +35,16 @@ public:
    virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& tileRect,
                                                ossim_uint32 resLevel=0);
 
+   /**
+    * @return true unless an rgb input is adjusted, which is done in hsi
+    * space and so depends on all three bands.
+    */
+   virtual bool isPointwiseRemap() const;
+
+   /** Applies the brightness contrast to an input tile. */
+   virtual ossimRefPtr<ossimImageData> remapTile(
+      const ossimRefPtr<ossimImageData>& inputTile);
+
    /**
     * @param brightness Value between -1.0 and +1.0 with zero being no
     * brightness offset.
@@ -125,6 +136,7 @@ protected:
    ossim_float64               theContrast;  
    ossimRefPtr<ossimImageData> theTile;
    ossimRefPtr<ossimImageData> theNormTile;
+   ossimRemapChain             theRemapChain;
    
 TYPE_DATA
 };
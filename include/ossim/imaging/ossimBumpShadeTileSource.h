@@ -276,6 +276,27 @@ protected:
                      ossim_uint8 dr,
                      ossim_uint8 dg,
                      ossim_uint8 db)const;
+
+   /** Color of shading c, the normal dot the light direction. */
+   void computeColor(ossim_uint8& r,
+                     ossim_uint8& g,
+                     ossim_uint8& b,
+                     ossim_float64 c,
+                     ossim_uint8 dr,
+                     ossim_uint8 dg,
+                     ossim_uint8 db)const;
+
+   /**
+    * Fills shade, tileRect sized, with the shading of each pixel, nullPix where there is no
+    * normal. With an ossimImageToPlaneNormalFilter input the shading comes from the elevation
+    * in one pass, without its three band normal tile.
+    *
+    * @return false if there are no normals for tileRect.
+    */
+   bool getShade(const ossimIrect& tileRect,
+                 ossim_uint32 resLevel,
+                 ossim_float64* shade,
+                 ossim_float64 nullPix);
    
 TYPE_DATA
 };
@@ -472,11 +472,9 @@ protected:
    std::vector<ossimFrameEntryData> getIntersectingEntries(const ossimIrect& rect);
 
    /**
-    * This is a wrapper for the fill cib and fill cadrg.  It takes the frames
-    * involved that were found in the getIntersectingEntries and call the
-    * appropriate fill cib or fill cadrg on each frame entry data.  It will
-    * loop through making sure that the frame file exists before calling
-    * the associated fill routines.
+    * This is a wrapper for the subframe fill.  It takes the frames
+    * involved that were found in the getIntersectingEntries and calls
+    * fillSubTile on each frame entry data.
     *
     * @param tileRect Region to fill.
     * @param framesInvolved All intersecting frames used to render the region.
@@ -486,28 +484,41 @@ protected:
                  ossimImageData* tile);
 
    /**
-    * Will uncompress the CIB file using a VQ decompression algorithm.
+    * Fills the part of the tile covered by a frame.  Subframes are taken
+    * from the ossimRpfSubframeCache when present.  Missing subframes are
+    * VQ decompressed, in parallel when more than one is needed, and added
+    * to the cache.
     *
-    * @param aFrame Frame that overlaps the requested tile rect.
     * @param tileRect The region requested to render.
     * @param frameEntryData The frame entry data.
+    * @param tile Tile to fill.
     */
-   void fillSubTileCib(const ossimRpfFrame& aFrame,
-                       const ossimIrect& tileRect,
-                       const ossimFrameEntryData& frameEntryData,
-                       ossimImageData* tile);
-   
+   void fillSubTile(const ossimIrect& tileRect,
+                    const ossimFrameEntryData& frameEntryData,
+                    ossimImageData* tile);
+
    /**
-    * Will uncompress the CADRG file using a VQ decompression algorithm.
+    * Will uncompress a single 256x256 subframe using a VQ decompression
+    * algorithm.  Codes are first expanded to color table indexes, then the
+    * color table is applied one band at a time in a tight loop.  The
+    * buffer is band sequential with 1 band for CIB and 3 for CADRG.
     *
-    * @param aFrame Frame that overlaps the requested tile rect.
-    * @param tileRect The region requested to render.
-    * @param frameEntryData The frame entry data.
-    */
-   void fillSubTileCadrg(const ossimRpfFrame& aFrame,
-                         const ossimIrect& tileRect,
-                         const ossimFrameEntryData& frameEntryData,
-                         ossimImageData* tile);
+    * This method does not touch member buffers so it is safe to call from
+    * multiple threads on the same frame.
+    *
+    * @param aFrame Frame holding the subframe.
+    * @param palette Band sequential color table of 256 entries per band.
+    * @param row Subframe row.
+    * @param col Subframe column.
+    * @param buffer Destination of 256*256*bands bytes.
+    * @return true if the subframe existed, false if it was filled with
+    * zeroes.
+    */
+   bool decodeSubframe(const ossimRpfFrame& aFrame,
+                       const ossim_uint8* palette,
+                       ossim_uint32 row,
+                       ossim_uint32 col,
+                       ossim_uint8* buffer)const;
    
    /**
     * Will allocate an internal buffer for the given product.  If the product is
@@ -530,16 +541,6 @@ protected:
 
    void populateLut();
 
-   /**
-    * This is for storage of a single compressed buffer.
-    */
-   unsigned char*               theCompressedBuffer;
-
-   /**
-    * This is used as a buffer to uncompress the data to
-    */
-   unsigned char*               theUncompressedBuffer;
-   
    /**
     * This will be computed based on the frames organized within
     * the directory.  The CibCadrg have fixed size frames of 1536x1536
@@ -593,6 +594,13 @@ protected:
     */
    bool                         theSkipEmptyCheck;
 
+   /**
+    * Number of threads used to decode the subframes needed by one request.
+    * Initialized from the preference keyword "rpf.decode_threads", default
+    * one.  Zero means use ossim::getNumberOfThreads().
+    */
+   ossim_uint32                 theDecodeThreads;
+
 	// data to use in property retrieval
 	
 TYPE_DATA
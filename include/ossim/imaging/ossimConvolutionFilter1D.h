@@ -57,6 +57,19 @@ public:
 
    virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& tileRect,ossim_uint32 resLevel=0);
 
+   /**
+    * @return The input rect getTile(tileRect) asks for, the tile stretched along the kernel.
+    */
+   ossimIrect getInputRect(const ossimIrect& tileRect) const;
+
+   /**
+    * Convolves data, which must be the tile of getInputRect(tileRect), into the output tile
+    * for tileRect. Lets callers that already hold the input skip fetching it again.
+    * @return The output tile, null if it could not be allocated.
+    */
+   ossimRefPtr<ossimImageData> convolveTile(ossimRefPtr<ossimImageData> data,
+                                            const ossimIrect& tileRect);
+
    virtual void initialize();
 
    virtual double getNullPixelValue(ossim_uint32 band=0) const;
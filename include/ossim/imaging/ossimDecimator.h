@@ -0,0 +1,66 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimDecimator_HEADER
+#define ossimDecimator_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimString.h>
+
+class ossimImageData;
+
+/***************************************************************************************************
+ * Halves tiles for reduced resolution levels with the nearest, box, Lanczos-3 or mode reducer.
+ *
+ * Each band is taken through in blocks of rows. The rows are turned into values and validity
+ * weights, nulls weighing nothing, and the reducers work on those, so a null never leaks into
+ * an output pixel. An output is null where no valid pixel goes into it, for LANCZOS3 where the
+ * valid pixels carry less than half the filter weight. Outputs are rounded to the nearest
+ * integer for integer data and limited to the band's min and max. The row loops have AVX2
+ * versions, switched with the rest of the ossimImageDataKernels ("image_data.simd").
+ *
+ * The reducers, for output pixel (x, y) and the 2 x 2 input block at (2x, 2y):
+ *  - NEAREST:  the upper left pixel of the block.
+ *  - BOX:      the mean of the valid pixels of the block.
+ *  - LANCZOS3: separable Lanczos-3, 12 taps a side centered on the block, the weights of null
+ *              taps dropped. Sharper than BOX with less aliasing.
+ *  - MODE:     the most common valid value of the block, the first in raster order on a tie.
+ *              For class maps and other index data, where means make no sense.
+ **************************************************************************************************/
+class OSSIM_DLL ossimDecimator
+{
+public:
+   enum Method
+   {
+      NEAREST  = 0,
+      BOX      = 1,
+      LANCZOS3 = 2,
+      MODE     = 3
+   };
+
+   /** @return Method named "nearest", "box", "lanczos" or "mode", BOX for anything else. */
+   static Method getMethod(const ossimString& name);
+
+   static const char* getMethodName(Method method);
+
+   /** @return Input pixels past each side of its block an output pixel reads. */
+   static ossim_uint32 getMargin(Method method);
+
+   /**
+    * Halves input into output. Writes the output pixels whose block meets the input rectangle
+    * and leaves the rest alone, so an output can be put together from several inputs. Input
+    * pixels outside the input rectangle count as null. Both tiles must have the same scalar
+    * type. The output status is not updated, call validate() when done.
+    */
+   static void decimate(const ossimImageData* input, ossimImageData* output, Method method);
+
+   /** As decimate() but reduces by factor, a power of 2, halving as many times as it takes. */
+   static void decimate(const ossimImageData* input, ossimImageData* output, Method method,
+                        ossim_uint32 factor);
+};
+
+#endif /* #ifndef ossimDecimator_HEADER */
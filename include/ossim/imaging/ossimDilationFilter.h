@@ -10,15 +10,18 @@
 #define ossimDilationFilter_HEADER
 
 #include <ossim/imaging/ossimImageSourceFilter.h>
+#include <ossim/imaging/ossimMaskMorphology.h>
 #include <ossim/base/ossimPolygon.h>
 
 /*!
  * class ossimDilationFilter
  *
- * Allows you to change between a median or mean filter.  You can
- * also specify a window size which the median or mean is computed and
- * the center pixel is replaced.
+ * Fills null pixels inside the valid image with the mean of the valid pixels in the window
+ * around them.
  *
+ * In "closing" mode the dilated mask is eroded back, so only null holes smaller than the window
+ * are filled and the outer edges of the valid areas are kept. Cost per pixel does not depend on
+ * the window size, see ossimMaskMorphology.
  */
 class OSSIM_DLL ossimDilationFilter : public ossimImageSourceFilter
 {
@@ -40,6 +43,15 @@ public:
    void setRecursiveFlag(bool flag=true) { theRecursiveFlag = flag; }
    bool getRecursiveFlag() const         { return theRecursiveFlag; }
 
+   /**
+    * DILATION (default) or CLOSING, other operations are taken as DILATION. The string form is
+    * "dilation" or "closing", same as the "mode" keyword.
+    */
+   void setMode(ossimMaskMorphology::Operation mode);
+   void setMode(const ossimString& mode);
+   ossimMaskMorphology::Operation getMode() const { return theOperation; }
+   ossimString getModeString() const;
+
    virtual void setProperty(ossimRefPtr<ossimProperty> property);
    virtual ossimRefPtr<ossimProperty> getProperty(const ossimString& name)const;
    virtual void getPropertyNames(std::vector<ossimString>& propertyNames)const;
@@ -65,8 +77,8 @@ protected:
    bool                        theRecursiveFlag;
    ossimPolygon                theValidImagePoly;
    bool                        theNullFoundFlag;
-
-   template <class T> void doDilation(T scalarType, ossimRefPtr<ossimImageData>& inputData);
+   ossimMaskMorphology::Operation theOperation;
+   ossimMaskMorphology         theMorphology;
 
    TYPE_DATA
 };
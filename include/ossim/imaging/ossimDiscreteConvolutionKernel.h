@@ -16,6 +16,8 @@
 #include <ossim/matrix/newmat.h>
 #include <ossim/matrix/newmatio.h>
 
+class ossimImageData;
+
 class ossimDiscreteConvolutionKernel
 {
 public:
@@ -125,11 +127,84 @@ public:
       {
          return *theKernel;
       }
+
+   /*!
+    * True if the kernel is the outer product of a column and a row
+    * (box, Gaussian, Sobel...).  Set when the kernel is set.
+    */
+   bool isSeparable()const
+      {
+         return theSeparableFlag;
+      }
+
+   /*!
+    * Convolves every band of a tile that has no null pixels.  The input
+    * must cover the output rectangle grown by getWidth()/2 columns to the
+    * left and getHeight()/2 lines up, plus the rest of the kernel to the
+    * right and down.  Results are clamped to minPix/maxPix per band.
+    *
+    * Bands are copied to a contiguous float buffer (double for double
+    * tiles) and convolved either as two 1-D passes for separable kernels
+    * or in cache sized column strips otherwise.
+    *
+    * @return false if the scalar types differ or are not handled, or if
+    * the input does not cover the output.
+    */
+   bool convolveFull(const ossimImageData* input,
+                     ossimImageData* output,
+                     const double* minPix,
+                     const double* maxPix)const;
+
+   /*!
+    * Buffer level engine used by convolveFull.  src holds
+    * (dstWidth + getWidth() - 1) x (dstHeight + getHeight() - 1) samples,
+    * srcWidth apart.  No null checks.
+    */
+   void convolveBuffer(const float* src,
+                       long srcWidth,
+                       float* dst,
+                       long dstWidth,
+                       long dstHeight)const;
+   void convolveBuffer(const double* src,
+                       long srcWidth,
+                       double* dst,
+                       long dstWidth,
+                       long dstHeight)const;
+   
 protected:
+   /*!
+    * Refreshes the flat weights and the separable factors from theKernel.
+    * Subclasses that change theKernel in place must call this.
+    */
+   void analyzeKernel();
+
+   template <class R>
+   void convolveBufferT(const R* src,
+                        long srcWidth,
+                        R* dst,
+                        long dstWidth,
+                        long dstHeight)const;
+
+   template <class T, class R>
+   void convolveFullT(const ossimImageData* input,
+                      ossimImageData* output,
+                      long startX,
+                      long startY,
+                      const double* minPix,
+                      const double* maxPix)const;
+   
    NEWMAT::Matrix  *theKernel;
    long theWidth;
    long theHeight;
    bool theComputeWeightedAverageFlag;
+
+   // Row ordered copy of theKernel and, when separable, theKernel equals
+   // theColumnFactor * theRowFactor.
+   std::vector<double> theWeights;
+   std::vector<double> theRowFactor;
+   std::vector<double> theColumnFactor;
+   double              theWeightSum;
+   bool                theSeparableFlag;
 };
 
 #endif
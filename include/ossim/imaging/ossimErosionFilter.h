@@ -9,6 +9,7 @@
 #define ossimErosionFilter_HEADER
 
 #include <ossim/imaging/ossimImageSourceFilter.h>
+#include <ossim/imaging/ossimMaskMorphology.h>
 #include <ossim/base/ossimPolygon.h>
 
 /*!
@@ -16,6 +17,10 @@
  *
  * Causes null pixels to erode neighboring valid pixels. This is the opposite of dilation.
  * If a null pixel is detected inside the sampling window, the center pixel is set to null.
+ *
+ * In "opening" mode the eroded mask is dilated back, so valid specks smaller than the window are
+ * nulled while the edges of larger valid areas are kept. Cost per pixel does not depend on the
+ * window size, see ossimMaskMorphology.
  */
 class OSSIM_DLL ossimErosionFilter : public ossimImageSourceFilter
 {
@@ -30,6 +35,15 @@ public:
    void setWindowSize(ossim_uint32 windowSize) { theWindowSize = windowSize; }
    ossim_uint32 getWindowSize() const          { return theWindowSize; }
 
+   /**
+    * EROSION (default) or OPENING, other operations are taken as EROSION. The string form is
+    * "erosion" or "opening", same as the "mode" keyword.
+    */
+   void setMode(ossimMaskMorphology::Operation mode);
+   void setMode(const ossimString& mode);
+   ossimMaskMorphology::Operation getMode() const { return theOperation; }
+   ossimString getModeString() const;
+
    virtual void setProperty(ossimRefPtr<ossimProperty> property);
    virtual ossimRefPtr<ossimProperty> getProperty(const ossimString& name)const;
    virtual void getPropertyNames(std::vector<ossimString>& propertyNames)const;
@@ -53,8 +67,8 @@ protected:
    ossimRefPtr<ossimImageData> theTempTile; //!> Used for recursion when recursive fill enabled
    ossim_uint32                theWindowSize;
    ossimPolygon                theValidImagePoly;
-
-   template <class T> void doErosion(T scalarType, ossimRefPtr<ossimImageData>& inputData);
+   ossimMaskMorphology::Operation theOperation;
+   ossimMaskMorphology         theMorphology;
 
    TYPE_DATA
 };
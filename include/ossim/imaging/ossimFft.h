@@ -0,0 +1,80 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimFft_HEADER
+#define ossimFft_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <complex>
+
+/***************************************************************************************************
+ * Discrete Fourier transforms of any size, float or double, used by ossimFftFilter.
+ *
+ * Lengths are factored into radix 4, 2 and 3 butterflies, other prime factors use a direct
+ * butterfly, so sizes need not be powers of two. Twiddle factors are computed once per length
+ * and kept for the life of the process, tiles of the same size share them.
+ *
+ * Real images go through the real transforms: an even length n row is packed into n/2 complex
+ * values, transformed, and split into its n/2 + 1 non-redundant coefficients, about half the work
+ * of a complex transform. 2-D transforms do all rows, then all columns, each pass spread over
+ * the threads given to the constructor.
+ *
+ * Sign convention is exp(-2 pi i k n / N) forward. Forward transforms are not scaled, 2-D inverse
+ * transforms are scaled by 1 / (width * height) so a round trip returns the input.
+ **************************************************************************************************/
+class OSSIM_DLL ossimFft
+{
+public:
+   /** @param numThreads Threads for the 2-D passes, 0 for ossim::getNumberOfThreads(). */
+   ossimFft(ossim_uint32 numThreads = 0);
+
+   void setNumberOfThreads(ossim_uint32 numThreads) { m_numThreads = numThreads; }
+   ossim_uint32 getNumberOfThreads() const { return m_numThreads; }
+
+   /** In place complex transform of n values. The inverse is not scaled. */
+   void transform(std::complex<float>* data, ossim_uint32 n, bool inverse) const;
+   void transform(std::complex<double>* data, ossim_uint32 n, bool inverse) const;
+
+   /**
+    * Forward transform of a real width x height image in line order. Only the width / 2 + 1
+    * non-redundant columns are written, out is height lines of width / 2 + 1 values. The others
+    * are conjugates: X(y, x) = conj(X((height - y) % height, width - x)).
+    */
+   void forward2d(const float* in, ossim_uint32 width, ossim_uint32 height,
+                  std::complex<float>* out) const;
+   void forward2d(const double* in, ossim_uint32 width, ossim_uint32 height,
+                  std::complex<double>* out) const;
+
+   /** Inverse of forward2d(), in has the same layout as its output. */
+   void inverse2d(const std::complex<float>* in, ossim_uint32 width, ossim_uint32 height,
+                  float* out) const;
+   void inverse2d(const std::complex<double>* in, ossim_uint32 width, ossim_uint32 height,
+                  double* out) const;
+
+   /** In place complex 2-D transform of a width x height image in line order. */
+   void transform2d(std::complex<float>* data, ossim_uint32 width, ossim_uint32 height,
+                    bool inverse) const;
+   void transform2d(std::complex<double>* data, ossim_uint32 width, ossim_uint32 height,
+                    bool inverse) const;
+
+private:
+   template <class T> void forward2dT(const T* in, ossim_uint32 width, ossim_uint32 height,
+                                      std::complex<T>* out) const;
+   template <class T> void inverse2dT(const std::complex<T>* in, ossim_uint32 width,
+                                      ossim_uint32 height, T* out) const;
+   template <class T> void transform2dT(std::complex<T>* data, ossim_uint32 width,
+                                        ossim_uint32 height, bool inverse) const;
+   template <class T> void columns(std::complex<T>* data, ossim_uint32 width,
+                                   ossim_uint32 height, ossim_uint32 stride, bool inverse) const;
+
+   /** Splits count lines into blocks and runs body(begin, end) on each, in parallel. */
+   template <class F> void forLines(ossim_uint32 count, const F& body) const;
+
+   ossim_uint32 m_numThreads;
+};
+
+#endif /* #ifndef ossimFft_HEADER */
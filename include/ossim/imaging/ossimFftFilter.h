@@ -12,6 +12,9 @@
 #ifndef ossimFftFilter_HEADER
 #define ossimFftFilter_HEADER
 #include <ossim/imaging/ossimImageSourceFilter.h>
+#include <ossim/imaging/ossimFft.h>
+#include <complex>
+#include <vector>
 
 class ossimScalarRemapper;
 
@@ -60,20 +63,13 @@ protected:
    ossimRefPtr<ossimImageData> theTile;
    ossimFftFilterDirectionType theDirectionType;
    ossimRefPtr<ossimScalarRemapper>        theScalarRemapper;
+   /** One thread by default, tiles are usually run in parallel already; "fft_threads" opts in. */
+   ossimFft                                theFft;
+   std::vector<ossim_float64>              theSamples;
+   std::vector< std::complex<double> >     theSpectrum;
    virtual void runFft(ossimRefPtr<ossimImageData>& input,
                        ossimRefPtr<ossimImageData>& output);
 
-   template <class T>
-   void fillMatrixForward(T *realPart,
-                          T nullPix,
-                          NEWMAT::Matrix& real,
-                          NEWMAT::Matrix& img)const;
-   template <class T>
-   void fillMatrixInverse(T *realPart,
-                          T *imgPart,
-                          NEWMAT::Matrix& real,
-                          NEWMAT::Matrix& img)const;
-
 
 TYPE_DATA
 };
@@ -15,6 +15,7 @@
 #define ossimGammaRemapper_HEADER
 
 #include <ossim/imaging/ossimImageSourceFilter.h>
+#include <ossim/imaging/ossimRemapChain.h>
 
 /*
 * The gamma remapper is based on the equation:
@@ -45,6 +46,13 @@ public:
 
    virtual void initialize();
 
+   /** Gamma is pointwise. */
+   virtual bool isPointwiseRemap() const;
+
+   /** Applies the gamma to an input tile. */
+   virtual ossimRefPtr<ossimImageData> remapTile(
+      const ossimRefPtr<ossimImageData>& inputTile);
+
    void setGamma(const double& gamma);
    double getGamma()const { return m_gamma; }
    /*!
@@ -76,6 +84,7 @@ protected:
    ossimRefPtr<ossimImageData> m_tile;
    ossimRefPtr<ossimImageData> m_normalizedTile;
    mutable std::vector<ossim_float32> m_lookupTable;
+   ossimRemapChain m_remapChain;
 
    static const ossim_float64 MIN_GAMMA;   
    static const ossim_float64 MAX_GAMMA;   
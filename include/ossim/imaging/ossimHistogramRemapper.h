@@ -60,6 +60,13 @@ public:
    virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& tileRect,
                                                ossim_uint32 resLevel=0);
 
+   /** Remaps inputTile unless bypassed, see ossimTableRemapper::remapTile. */
+   virtual ossimRefPtr<ossimImageData> remapTile(
+      const ossimRefPtr<ossimImageData>& inputTile);
+
+   /** Also moves while the table is dirty. */
+   virtual ossim_uint32 getRemapStamp() const;
+
    virtual void initialize();
    /**
     * - Disables this source.
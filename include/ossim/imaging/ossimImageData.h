@@ -158,6 +158,49 @@ public:
    virtual void assignBand(const ossimImageData* data,
                            ossim_uint32 source_band,
                            ossim_uint32 output_band);
+
+   /**
+    * @brief Makes a band of this tile a view of a band of another tile.
+    *
+    * getBuf(band) then returns the source's buffer: the pixels are shared,
+    * not copied, and the source is referenced until the view is dropped.
+    * Views are for sources that hand out borrowed, read-only tiles: like
+    * any tile from getTile, the source's pixels only hold until its
+    * owner's next getTile, and writes through getBuf go to the source.
+    *
+    * The owner of this tile sets the views and then calls
+    * resolveBandViews() before handing the tile out.  getBuf() returns
+    * this tile's own buffer while the views are not all the bands of one
+    * tile, in order.
+    *
+    * Views are dropped without a copy by makeBlank(), a change of size or
+    * band count, and by fill() or assignBand() of the band.  Copies and
+    * saveState copy them in.
+    *
+    * @param band Band of this tile, which must be initialized.
+    * @param source Tile of the same scalar type and size.
+    * @param sourceBand Band of source.
+    * @return true on success, false if the tiles don't match.
+    */
+   virtual bool setBandView(ossim_uint32 band,
+                            ossimImageData* source,
+                            ossim_uint32 sourceBand);
+
+   /** @return true if any band is a view of another tile. */
+   bool hasBandViews() const;
+
+   /**
+    * @brief Keeps the views if they are all the bands of one tile, in
+    * order, so getBuf() returns that tile's buffer.  Otherwise copies them
+    * into this tile's own buffer and releases the other tiles.
+    */
+   void resolveBandViews();
+
+   /**
+    * @brief Copies the bands that are views of other tiles into this tile's
+    * own buffer and releases the other tiles.
+    */
+   void releaseBandViews();
    
    virtual ossimObject* dup() const;
 
@@ -1280,6 +1323,21 @@ protected:
 
 private:
 
+   /** Drops band views without copying them. */
+   void clearBandViews();
+   void clearBandView(ossim_uint32 band);
+
+   /** Copies the bands of src that are views into the same bands of this buffer. */
+   void copyBandViews(const ossimImageData& src);
+
+   /** @return The first view if the views are all the bands of one tile, in order; else 0. */
+   ossim_uint8* getContiguousBandViews() const;
+
+   /** Buffer of each band that is a view of another tile, else null.  Empty if none. */
+   std::vector<ossim_uint8*> m_bandViews;
+
+   /** Tile each view is of, held for the life of the view. */
+   std::vector< ossimRefPtr<ossimImageData> > m_bandViewSources;
    
 TYPE_DATA
 };
@@ -16,6 +16,7 @@
 
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimTileBufferPool.h>
 #include <mutex>
 class ossimSource;
 class ossimImageSource;
@@ -24,6 +25,9 @@ class ossimImageSource;
 /*!
  * This factory should be called by all image source producers to allocate
  * an image tile.
+ *
+ * Tile buffers come from ossimTileBufferPool and go back to it when the
+ * tile is destroyed or resized, see getBufferPool().
  */
 class OSSIM_DLL ossimImageDataFactory
 {
@@ -50,6 +54,9 @@ public:
    virtual ossimRefPtr<ossimImageData> create(
       ossimSource* owner,
       ossimImageSource* inputSource)const;
+
+   /** @return The pool tile buffers are drawn from, for its caps and statistics. */
+   ossimTileBufferPool* getBufferPool()const;
    
 protected:
    ossimImageDataFactory(); // hide
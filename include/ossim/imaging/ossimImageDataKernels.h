@@ -0,0 +1,80 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimImageDataKernels_HEADER
+#define ossimImageDataKernels_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+
+/***************************************************************************************************
+ * Inner loops of ossimImageData: normalization both ways, null counting for validate(), min/max
+ * scans and band interleave conversions.
+ *
+ * Each kernel has a plain loop and, on x86 with gcc or clang, an AVX2 one picked at run time when
+ * the cpu has it. The AVX2 kernels cover 8 and 16 bit, signed 16 bit and float data and give
+ * the same bits as the plain loops, nulls included; other types and the odd pixels at the end of
+ * a run use the plain loops. The interleave kernels handle 8 and 16 bit samples of 2 to 4 bands
+ * with byte shuffles, the rest use the plain loops.
+ *
+ * The AVX2 kernels can be turned off with the preference "image_data.simd: false".
+ **************************************************************************************************/
+class OSSIM_DLL ossimImageDataKernels
+{
+public:
+   enum Isa
+   {
+      ISA_SCALAR = 0,
+      ISA_AVX2   = 1
+   };
+
+   /** @return Instruction set the kernels use. */
+   static Isa getIsa();
+
+   /** @return Best instruction set of this cpu and build. */
+   static Isa getBestIsa();
+
+   /** Sets the instruction set, limited to getBestIsa(). For testing and benchmarks. */
+   static void setIsa(Isa isa);
+
+   static const char* getIsaName(Isa isa);
+
+   /**
+    * d[i] = 0 where s[i] is nullPix, the minimum normalized value where s[i] is minPix, else
+    * (s[i] - minPix) / (maxPix - minPix). F is ossim_float32 or ossim_float64.
+    */
+   template <class T, class F>
+   static void normalize(const T* s, F* d, ossim_uint32 count,
+                         ossim_float64 nullPix, ossim_float64 minPix, ossim_float64 maxPix);
+
+   /**
+    * d[i] = nullPix where s[i] is 0, else minPix + (maxPix - minPix) * s[i], limited to maxPix
+    * if clampToMax.
+    */
+   template <class T, class F>
+   static void unnormalize(const F* s, T* d, ossim_uint32 count,
+                           ossim_float64 nullPix, ossim_float64 minPix, ossim_float64 maxPix,
+                           bool clampToMax);
+
+   /** @return Number of s[i] not equal to nullPix. */
+   template <class T>
+   static ossim_uint32 countNonNull(const T* s, ossim_uint32 count, T nullPix);
+
+   /** Lowers minPix and raises maxPix to the values of s other than nullPix. */
+   template <class T>
+   static void minMax(const T* s, ossim_uint32 count, T nullPix,
+                      ossim_float64& minPix, ossim_float64& maxPix);
+
+   /** Splits count pixels of bands interleaved samples, s, into d[0] ... d[bands-1]. */
+   template <class T>
+   static void deinterleave(const T* s, T* const* d, ossim_uint32 count, ossim_uint32 bands);
+
+   /** Interleaves count pixels of s[0] ... s[bands-1] into d. */
+   template <class T>
+   static void interleave(const T* const* s, T* d, ossim_uint32 count, ossim_uint32 bands);
+};
+
+#endif /* #ifndef ossimImageDataKernels_HEADER */
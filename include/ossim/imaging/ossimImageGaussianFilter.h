@@ -11,6 +11,8 @@
 #include <ossim/imaging/ossimImageSourceFilter.h>
 #include <ossim/imaging/ossimConvolutionFilter1D.h>
 
+class ossimDiscreteConvolutionKernel;
+
 /**
  * class for symmetric Gaussian filtering
  * implemented as two separable horizontal/vertical gaussian filters
@@ -22,6 +24,10 @@
  *   true  : any NODATA pixels in the convolution will Nullify the center pixel
  *   false : center pixel will be NODATA only if it was NODATA before 
  *     other NODATA pixels are processed as zero in the convolution calculation
+ *
+ * Tiles with no NODATA pixels in reach of the kernel are convolved in one
+ * pass by the separable engine of ossimDiscreteConvolutionKernel; others
+ * go through the horizontal/vertical filter pair.
  */
 class OSSIM_DLL ossimImageGaussianFilter : public ossimImageSourceFilter
 {
@@ -74,6 +80,9 @@ protected:
    ossimRefPtr<ossimConvolutionFilter1D> theHF; //horizontal filter
    ossimRefPtr<ossimConvolutionFilter1D> theVF; //vertical filter
 
+   ossimDiscreteConvolutionKernel* theKernel; //2-D kernel for full tiles
+   ossimRefPtr<ossimImageData>     theTile;
+
 TYPE_DATA
 };
 
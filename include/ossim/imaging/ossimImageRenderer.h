@@ -284,11 +284,6 @@ private:
 
    ossimRefPtr<ossimImageData> getTileAtResLevel(const ossimIrect& boundingRect,
                                      ossim_uint32 resLevel);
-  template <class T>
-  void resampleTileToDecimation(T dummyVariable,
-				ossimRefPtr<ossimImageData> result,
-				ossimRefPtr<ossimImageData> tile,
-				ossim_uint32 multiplier);
 
    long computeClosestResLevel(const std::vector<ossimDpt>& decimationFactors,
                                double scale)const;
@@ -53,13 +53,43 @@ public:
    virtual void refreshEvent(ossimRefreshEvent& event);
    
 
+   virtual void setEnableFlag(bool flag);
    virtual void setProperty(ossimRefPtr<ossimProperty> property);
    virtual ossimRefPtr<ossimProperty> getProperty(const ossimString& name)const;
    virtual void getPropertyNames(std::vector<ossimString>& propertyNames)const;
+
+   /**
+    * @return true if each output pixel depends only on the input pixel of
+    * the same band, so runs of such filters can be fused into one lookup
+    * table by ossimRemapChain. Default is false.
+    */
+   virtual bool isPointwiseRemap()const;
+
+   /**
+    * The second half of getTile() for pointwise filters: remaps a tile
+    * already fetched from the input. Default returns inputTile.
+    *
+    * @param inputTile Tile from the input, may be null or empty.
+    * @return The output tile, inputTile itself if nothing was done.
+    */
+   virtual ossimRefPtr<ossimImageData> remapTile(
+      const ossimRefPtr<ossimImageData>& inputTile);
+
+   /**
+    * @return A stamp that moves whenever what remapTile() does may have
+    * changed.  ossimRemapChain rebuilds its table when the stamp of any
+    * filter it fused moves.
+    */
+   virtual ossim_uint32 getRemapStamp()const;
    
 protected:
    virtual ~ossimImageSourceFilter();
+
+   /** Moves the remap stamp, for pointwise filters whose settings changed. */
+   void remapChanged();
+
    ossimImageSource* theInputConnection;
+   ossim_uint32      theRemapStamp;
 TYPE_DATA
 };
 
@@ -12,6 +12,7 @@
 #ifndef ossimImageToPlaneNormalFilter_HEADER
 #define ossimImageToPlaneNormalFilter_HEADER
 #include <ossim/imaging/ossimImageSourceFilter.h>
+#include <ossim/imaging/ossimTerrainKernels.h>
 
 class OSSIMDLLEXPORT ossimImageToPlaneNormalFilter : public ossimImageSourceFilter
 {
@@ -39,6 +40,23 @@ public:
    
    void   setSmoothnessFactor(double value);
    double getSmoothnessFactor()const;
+
+   /** Gradient stencil, default Zevenbergen-Thorne. Keyword "stencil", "horn" or "zt". */
+   void setStencil(ossimTerrainKernels::Stencil stencil);
+   ossimTerrainKernels::Stencil getStencil()const;
+
+   /**
+    * Computes the products of outputs for tileRect straight from the input, in one pass and
+    * without the three band normal tile of getTile(). The planes are the size of tileRect.
+    *
+    * @param light Unit vector toward the light, needed for outputs.m_shade.
+    * @return false if tileRect is off the input or the filter is disabled, outputs untouched.
+    */
+   bool getTerrainTile(const ossimIrect& tileRect,
+                       ossim_uint32 resLevel,
+                       const ossimTerrainKernels::Outputs& outputs,
+                       ossim_float64 outputNull,
+                       const ossim_float64* light=0);
    
    bool loadState(const ossimKeywordlist& kwl,
                   const char* prefix);
@@ -59,8 +77,15 @@ protected:
    double          theXScale;
    double          theYScale;
    double          theSmoothnessFactor;
+   ossimTerrainKernels::Stencil theStencil;
    
    void initializeTile();
+
+   //! Input with the one pixel border the stencils need, null if there is none.
+   ossimRefPtr<ossimImageData> getInputTile(const ossimIrect& tileRect, ossim_uint32 resLevel);
+
+   //! Kernel parameters for resLevel, the scales decimated to it.
+   void getKernelParams(ossim_uint32 resLevel, ossimTerrainKernels::Params& params) const;
    virtual void computeNormals(ossimRefPtr<ossimImageData>& inputTile,
                                ossimRefPtr<ossimImageData>& outputTile);
 
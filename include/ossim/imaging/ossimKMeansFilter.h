@@ -29,6 +29,12 @@ class ossimHistogram;
  * this would be UInt8. Multiple bands are treated separately, so the number of output bands is
  * the same as the number of input bands.
  *
+ * Alternatively, in multispectral mode (see setMultispectral()), pixels are clustered as vectors
+ * of all their bands and the output is a single band of cluster DNs. No histogram is needed:
+ * the clusters are trained on a regular subsample of the pixels, read from the coarsest
+ * reduced resolution level that still holds enough of them. Pixels with a null in any band are
+ * left null.
+ *
  * This filter requires a histogram for the input source. If none is provided, one is computed.
  *
  * A common use for this class is for thresholding an image based on the histogram. This corresponds
@@ -104,6 +110,25 @@ public:
     */
    const ossimKMeansClustering* getBandClassifier(ossim_uint32 band=0) const;
 
+   /**
+    * Clusters pixels on all their bands jointly into a single output band. The band 0
+    * classifier is then the multivariate one.
+    */
+   void setMultispectral(bool flag=true);
+   bool getMultispectral() const { return m_multispectral; }
+
+   /** Multispectral mode: most pixels sampled for training, default 100000. */
+   void setMaxTrainingSamples(ossim_uint32 n);
+   ossim_uint32 getMaxTrainingSamples() const { return m_maxTrainingSamples; }
+
+   /**
+    * Multispectral mode: samples per mini-batch update while training, 0 (default) for full
+    * passes over the training samples.
+    */
+   void setTrainingBatchSize(ossim_uint32 n);
+
+   virtual ossim_uint32 getNumberOfOutputBands() const;
+
    virtual double getMinPixelValue(ossim_uint32 band=0)const;
    virtual double getMaxPixelValue(ossim_uint32 band=0)const;
 
@@ -114,6 +139,21 @@ public:
 
 protected:
    bool computeKMeans();
+   bool computeMultispectral();
+
+   /**
+    * Reads up to m_maxTrainingSamples pixels without nulls from the input, band interleaved by
+    * pixel. @return Number of pixels read.
+    */
+   ossim_uint32 collectTrainingSamples(std::vector<double>& samples) const;
+
+   void classifyMultispectral(const ossimImageData* inTile);
+
+   /** Appends the threshold of a two cluster band classifier when a threshold mode is set. */
+   void addThreshold(const ossimKMeansClustering* classifier);
+
+   /** Classifiers from the cluster keywords of saveState(). @return false if any are missing. */
+   bool loadClusters(const ossimKeywordlist& kwl, const char* prefix, ossim_uint32 numBands);
 
    /**
     * Called on first getTile, will initialize all data needed.
@@ -132,6 +172,12 @@ protected:
    bool m_initialized;
    ThresholdMode m_thresholdMode;
    std::vector<double> m_thresholds;
+   bool m_multispectral;
+   ossim_uint32 m_maxTrainingSamples;
+   ossim_uint32 m_trainingBatchSize;
+   std::vector<double> m_pixels;          //! Tile pixels for multispectral classification
+   std::vector<ossim_uint32> m_groupIds;
+   std::vector<ossim_uint32> m_offsets;   //! Tile offsets of the classified pixels
 
 TYPE_DATA
 };
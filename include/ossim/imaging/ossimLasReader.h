@@ -20,6 +20,7 @@
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/projection/ossimProjection.h>
+#include <ossim/point_cloud/ossimLasGridder.h>
 #include <mutex>
 
 class ossimLasHdr;
@@ -231,6 +232,12 @@ public:
    /** @return The total number of decimation levels. */
    virtual ossim_uint32 getNumberOfDecimationLevels() const;
 
+   /**
+    * @brief Selects the per pixel statistic returned by the elevation entry (0).
+    * Default is ossimLasGridder::MEAN.
+    */
+   void setElevationStatistic(ossimLasGridder::Statistic stat);
+
    virtual ossim_uint32 getNumberOfOutputBands() const;
 
 protected:
@@ -292,6 +299,12 @@ private:
 
    void convertToMeters(ossim_float64& value) const;
 
+   /**
+    * @brief Fills an elevation tile from m_gridder, streaming the point records once per
+    * accumulator strip rather than once per tile.
+    */
+   bool getElevationTile(ossimImageData* result, ossim_uint32 resLevel);
+
    /**
     * Returns a point of type.
     */
@@ -311,6 +324,9 @@ private:
    bool                         m_scan;  // Scan for bounds at open.
    ossimUnitType                m_units;
    ossimUnitConversionTool*     m_unitConverter;
+   ossimLasGridder*             m_gridder;
+   ossim_int32                  m_gridderResLevel; // -1 when the grid needs to be set.
+   ossimLasGridder::Statistic   m_elevationStatistic;
 TYPE_DATA
 };
 
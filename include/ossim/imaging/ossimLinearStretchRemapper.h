@@ -15,6 +15,7 @@
 #include <ossim/base/ossimRgbVector.h>
 #include <ossim/base/ossimFilename.h>
 #include <ossim/imaging/ossimImageSourceFilter.h>
+#include <ossim/imaging/ossimRemapChain.h>
 #include <vector>
 
 class ossimImageData;
@@ -49,6 +50,12 @@ public:
 
    virtual void initialize();
 
+   /** The stretch is pointwise. */
+   virtual bool isPointwiseRemap() const;
+
+   /** Stretches an input tile. */
+   virtual ossimRefPtr<ossimImageData> remapTile(const ossimRefPtr<ossimImageData>& tile);
+
    virtual bool saveState(ossimKeywordlist& kwl, const char* prefix=NULL)const;
 
    virtual bool loadState(const ossimKeywordlist& kwl, const char* prefix=NULL);
@@ -65,6 +72,7 @@ protected:
    std::vector<double> m_minValues;
    std::vector<double> m_maxValues;
    ossimRefPtr<ossimImageData> m_tile;
+   ossimRemapChain m_remapChain;
    
 TYPE_DATA
 };
@@ -0,0 +1,95 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimMaskMorphology_HEADER
+#define ossimMaskMorphology_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <vector>
+
+class ossimImageData;
+class ossimPolygon;
+
+/***************************************************************************************************
+ * Morphology of the valid (non-null) pixel mask over square windows, shared by
+ * ossimErosionFilter and ossimDilationFilter:
+ *
+ * - EROSION: valid pixels with a null in their window become null.
+ * - DILATION: null pixels with valid pixels in their window get the mean of those pixels.
+ * - OPENING: erosion then dilation of the mask; drops valid specks smaller than the window and
+ *   keeps the input values elsewhere.
+ * - CLOSING: dilation then erosion of the mask; fills null holes smaller than the window with
+ *   the mean of their valid neighbors.
+ *
+ * Mask minima and maxima use van Herk/Gil-Werman running extrema and fill means use running sums,
+ * both separable, so the cost per pixel does not depend on the window size. The vertical passes
+ * work on whole lines at a time so they vectorize.
+ *
+ * Samples outside the input tile count as null. Pixels outside the valid image polygon, if given,
+ * are never made valid by dilation or kept valid by erosion.
+ **************************************************************************************************/
+class OSSIM_DLL ossimMaskMorphology
+{
+public:
+   enum Operation
+   {
+      EROSION  = 0,
+      DILATION = 1,
+      OPENING  = 2,
+      CLOSING  = 3
+   };
+
+   ossimMaskMorphology();
+
+   /** Window width and height, even sizes are rounded up. */
+   void setWindowSize(ossim_uint32 windowSize);
+   ossim_uint32 getWindowSize() const { return m_windowSize; }
+
+   void setOperation(Operation operation) { m_operation = operation; }
+   Operation getOperation() const { return m_operation; }
+
+   /** @return Margin the input needs around the output for the current operation. */
+   ossim_uint32 getMargin() const;
+
+   /**
+    * Filters the bands of input into output.
+    * @param validPoly Valid image vertices in image space, or null for no limit.
+    * @return false if the scalar types differ or are not handled.
+    */
+   bool apply(const ossimImageData* input, ossimImageData* output, const ossimPolygon* validPoly);
+
+   /** @return Null pixels inside the valid polygon the last apply() filled. */
+   ossim_uint64 getNumFilled() const { return m_numFilled; }
+
+   /** @return Null pixels inside the valid polygon the last apply() left null. */
+   ossim_uint64 getNumUnfilled() const { return m_numUnfilled; }
+
+   /**
+    * Running minimum (erode) or maximum of a width x height mask over w x w windows; out is
+    * (width - w + 1) x (height - w + 1).
+    */
+   static void erode(const std::vector<ossim_uint8>& mask, long width, long height, long w,
+                     std::vector<ossim_uint8>& out);
+   static void dilate(const std::vector<ossim_uint8>& mask, long width, long height, long w,
+                      std::vector<ossim_uint8>& out);
+
+   /** Sums over w x w windows, same layout as erode(). */
+   static void boxSum(const std::vector<double>& values, long width, long height, long w,
+                      std::vector<double>& out);
+
+private:
+   template <class T> void applyT(const ossimImageData* input,
+                                  ossimImageData* output,
+                                  const ossimPolygon* validPoly);
+
+   ossim_uint32 m_windowSize;
+   Operation    m_operation;
+   ossim_uint64 m_numFilled;
+   ossim_uint64 m_numUnfilled;
+};
+
+#endif /* #ifndef ossimMaskMorphology_HEADER */
@@ -13,6 +13,7 @@
 #define ossimMeanMedianFilter_HEADER
 
 #include <ossim/imaging/ossimImageSourceFilter.h>
+#include <ossim/imaging/ossimSlidingWindowRank.h>
 
 /*!
  * class ossimMeanMedianFilter
@@ -21,6 +22,10 @@
  * also specify a window size which the median or mean is computed and
  * the center pixel is replaced.
  *
+ * The median types pick the "rank" fraction of the sorted window, 0.5 by
+ * default, so they also serve as percentile (rank) filters.  See
+ * ossimSlidingWindowRank for the engine.
+ *
  */
 class OSSIM_DLL ossimMeanMedianFilter : public ossimImageSourceFilter
 {
@@ -58,6 +63,13 @@ public:
    void setWindowSize(ossim_uint32 windowSize);
    ossim_uint32 getWindowSize()const;
 
+   /**
+    * @param rank Fraction (0 to 1) of the sorted valid window samples the
+    * median types output, 0.5 (default) for the median.
+    */
+   void setRank(double rank);
+   double getRank()const;
+
    /**
     * @param flag Set "theAutoGrowRectFlag".  This only affects filter types
     * that set nulls.  Will have a growing affect on the edges.
@@ -108,6 +120,9 @@ protected:
     */
    bool theAutoGrowRectFlag;
 
+   /** Median/rank engine, also holds the rank. */
+   ossimSlidingWindowRank theRankEngine;
+
    void applyFilter(ossimRefPtr<ossimImageData>& input);
 
    template <class T>
@@ -117,12 +132,6 @@ protected:
       void applyMeanNullCenterOnly(T dummyVariable,
                                    ossimRefPtr<ossimImageData>& inputData);
 
-   template <class T>
-      void applyMedian(T dummyVariable,
-                       ossimRefPtr<ossimImageData>& inputData);
-   template <class T>
-      void applyMedianNullCenterOnly(T dummyVariable,
-                                     ossimRefPtr<ossimImageData>& inputData);
 TYPE_DATA
 };
 
@@ -16,6 +16,7 @@
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimMultiBandHistogram.h>
 #include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimDecimator.h>
 #include <ossim/imaging/ossimFilterResampler.h>
 #include <ossim/imaging/ossimBitMaskWriter.h>
 #include <ossim/imaging/ossimMaskFilter.h>
@@ -161,7 +162,7 @@ public:
    /**
     * @brief Sets the resampling type.
     *
-    * Supports BOX or NEAREST NEIGHBOR.
+    * Supports BOX, NEAREST NEIGHBOR and LANCZOS, anything else is BOX.
     * When indexed you should probably use nearest neighbor.
     * default = ossimFilterResampler::ossimFilterResampler_BOX
     *
@@ -170,6 +171,13 @@ public:
    void setResampleType(
       ossimFilterResampler::ossimFilterResamplerType resampleType);
 
+   /**
+    * @brief Sets the decimation method, see ossimDecimator.
+    * default = ossimDecimator::BOX
+    * @param method The method to use.
+    */
+   void setDecimationMethod(ossimDecimator::Method method);
+
    /**
     * @brief Turn on/off scan for min max flag.
     * This method assumes the null is known.
@@ -237,9 +245,6 @@ protected:
     */
    void resampleTile(const ossimImageData* inputTile);
 
-   template <class T> void resampleTile(const ossimImageData* inputTile,
-                                        T dummy);
-
    /** @brief Clears out the arrays from a scan for min, max, nulls. */
    void clearMinMaxNullArrays();
    
@@ -264,8 +269,8 @@ protected:
    /** TODO make this handle any decimation.  Right now hard coded to two. */
    ossim_int32                    m_decimationFactor;
 
-   /** Currently only handles NEAREST_NEIGHBOR and BOX (default = BOX) */
-   ossimFilterResampler::ossimFilterResamplerType m_resampleType;
+   /** Reducer of the decimation (default = BOX) */
+   ossimDecimator::Method m_decimationMethod;
 
    ossimRefPtr<ossimMultiBandHistogram> m_histogram;
 
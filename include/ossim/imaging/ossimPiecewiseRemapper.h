@@ -91,6 +91,14 @@ public:
    virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& tileRect,
                                                ossim_uint32 resLevel = 0);
 
+   /**
+    * @brief Remaps inputTile through the table when enabled.
+    * @param inputTile Tile from the input connection.
+    * @return The remapped tile, or inputTile.
+    */
+   virtual ossimRefPtr<ossimImageData> remapTile(
+      const ossimRefPtr<ossimImageData>& inputTile);
+
    /** @brief Initialization method.  Called on state change of chain. */ 
    virtual void initialize();
 
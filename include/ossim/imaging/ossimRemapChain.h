@@ -0,0 +1,99 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimRemapChain_HEADER
+#define ossimRemapChain_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <vector>
+
+class ossimImageSource;
+class ossimImageSourceFilter;
+
+/***************************************************************************************************
+ * Fuses a run of pointwise remappers (ossimImageSourceFilter::isPointwiseRemap()), e.g. histogram
+ * remapper -> scalar remapper -> brightness/contrast -> gamma, into one lookup table per band so
+ * the run costs one pass over the tile instead of one per filter.
+ *
+ * Owned by the last filter of the run, the head, which calls getTile() from its own getTile().
+ * The table is made by passing a ramp tile through each filter's remapTile(), so it holds exactly
+ * what the filters would have produced:
+ *    - 8 and 16 bit inputs: one entry per input value, a direct lookup.
+ *    - float inputs: knots spread over the input's min to max, interpolated linearly.
+ * Other input types, and runs of one filter, are not fused and the head works as before. Input
+ * tiles with another null, min or max than the source's, or null or empty, go through the filters.
+ *
+ * The table is built on the first getTile() after reset(), which the head calls from its
+ * initialize(), and rebuilt when the remap stamp (ossimImageSourceFilter::getRemapStamp()) of any
+ * filter of the run moves, so a filter changed anywhere in the run takes effect on the next tile.
+ * Fusion can be turned off with the preference "remap_chain.fuse: false".
+ **************************************************************************************************/
+class OSSIM_DLL ossimRemapChain
+{
+public:
+   ossimRemapChain();
+
+   /** Drops the table, rebuilt by the next fuse(). */
+   void reset();
+
+   /**
+    * @return true if head ends a run of two or more pointwise filters that could be fused,
+    * building the table on first call. When false head must make its tiles itself.
+    */
+   bool fuse(ossimImageSourceFilter* head);
+
+   /** @return The head's output for tileRect, only valid after fuse() returned true. */
+   ossimRefPtr<ossimImageData> getTile(const ossimIrect& tileRect, ossim_uint32 resLevel);
+
+   /** @return Number of filters fused, 0 if not fused. */
+   ossim_uint32 getNumberOfStages() const;
+
+private:
+   enum State
+   {
+      UNBUILT,
+      FUSED,
+      UNFUSED
+   };
+
+   bool build();
+   bool isLinked() const;
+   bool matchesRamp(const ossimImageData* input) const;
+   ossimRefPtr<ossimImageData> makeRamp();
+   ossimRefPtr<ossimImageData> runStages(ossimRefPtr<ossimImageData> tile) const;
+   void storeKnots(const ossimImageData* output);
+
+   template <class In> void applyTable(const ossimImageData* input);
+   template <class In, class Out> void applyTable(const ossimImageData* input);
+   template <class In> void applyKnots(const ossimImageData* input);
+   template <class In, class Out> void applyKnots(const ossimImageData* input);
+
+   State                                m_state;
+   ossimImageSourceFilter*              m_head;
+   ossimImageSource*                    m_source;
+   std::vector<ossimImageSourceFilter*> m_stages;  ///< Source side first, head last.
+   std::vector<ossim_uint32>            m_stamps;  ///< Remap stamps of m_stages when built.
+   ossimScalarType                      m_inputType;
+   ossimScalarType                      m_outputType;
+   ossim_uint32                         m_bands;
+   ossim_uint32                         m_entries; ///< Per band, table entries or knots.
+   ossim_int32                          m_offset;  ///< Added to input values to index the table.
+   std::vector<ossim_uint8>             m_table;   ///< Output values of m_outputType.
+   std::vector<ossim_float64>           m_knots;
+   std::vector<ossim_float64>           m_knotMin;
+   std::vector<ossim_float64>           m_knotScale;
+   std::vector<ossim_float64>           m_inputNull;
+   std::vector<ossim_float64>           m_inputMin;
+   std::vector<ossim_float64>           m_inputMax;
+   std::vector<ossim_float64>           m_nullOutput; ///< Float inputs, output for null.
+   ossimRefPtr<ossimImageData>          m_tile;
+};
+
+#endif /* #ifndef ossimRemapChain_HEADER */
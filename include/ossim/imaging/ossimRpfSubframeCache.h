@@ -0,0 +1,117 @@
+//*******************************************************************
+//
+// License:  MIT
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description:
+//
+// Process wide, byte budgeted cache of decoded (VQ decompressed) RPF
+// subframes.  Used by ossimCibCadrgTileSource so that panning across a frame
+// does not decode the same 256x256 subframes over and over.
+//
+//*************************************************************************
+#ifndef ossimRpfSubframeCache_HEADER
+#define ossimRpfSubframeCache_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Least recently used cache of decoded RPF subframes.  Items are keyed by
+ * frame file path plus subframe row and column.  The buffer held is the
+ * band sequential (BSQ) 256x256 subframe as handed to
+ * ossimImageData::loadTile.
+ *
+ * The maximum cache size is in bytes and is initialized from the preference
+ * keyword "rpf.subframe_cache_size" which is given in megabytes.  When an
+ * add pushes the cache over the limit, least recently used subframes are
+ * dropped until it fits again.
+ *
+ * All methods are thread safe.
+ */
+class OSSIM_DLL ossimRpfSubframeCache
+{
+public:
+   typedef std::shared_ptr< const std::vector<ossim_uint8> > SubframeBuffer;
+
+   /** @return The single instance of this class. */
+   static ossimRpfSubframeCache* instance();
+
+   /**
+    * @brief Gets a decoded subframe and marks it most recently used.
+    * @param framePath Full path to the frame file.
+    * @param row Subframe row in the frame.
+    * @param col Subframe column in the frame.
+    * @return Buffer or null pointer if not in the cache.
+    */
+   SubframeBuffer getSubframe( const ossimFilename& framePath,
+                               ossim_uint32 row,
+                               ossim_uint32 col );
+
+   /**
+    * @brief Adds a decoded subframe.  If the key is present the buffer is
+    * replaced.
+    * @param framePath Full path to the frame file.
+    * @param row Subframe row in the frame.
+    * @param col Subframe column in the frame.
+    * @param buffer Decoded buffer.
+    */
+   void addSubframe( const ossimFilename& framePath,
+                     ossim_uint32 row,
+                     ossim_uint32 col,
+                     SubframeBuffer buffer );
+
+   /** @brief Removes all subframes from the cache. */
+   void flush();
+
+   /**
+    * @brief Sets the maximum number of bytes to hold.  Zero disables
+    * caching.
+    */
+   void setMaxCacheSize( ossim_uint64 bytes );
+
+   /** @return The maximum number of bytes to hold. */
+   ossim_uint64 getMaxCacheSize() const;
+
+   /** @return The number of bytes currently held. */
+   ossim_uint64 getCacheSize() const;
+
+protected:
+   ossimRpfSubframeCache();
+   ossimRpfSubframeCache(const ossimRpfSubframeCache&){} // hide
+   void operator = (const ossimRpfSubframeCache&){} // hide
+
+   struct Node
+   {
+      std::string    m_key;
+      SubframeBuffer m_buffer;
+   };
+   typedef std::list<Node> LruList;
+   typedef std::map<std::string, LruList::iterator> IndexMap;
+
+   /** @return Cache key for frame and subframe. */
+   static std::string makeKey( const ossimFilename& framePath,
+                               ossim_uint32 row,
+                               ossim_uint32 col );
+
+   /** Drops least recently used nodes until within budget.  Caller locks. */
+   void shrinkToFit();
+
+   mutable std::mutex m_mutex;
+   LruList            m_lru; // front is most recently used
+   IndexMap           m_index;
+   ossim_uint64       m_cacheSize;
+   ossim_uint64       m_maxCacheSize;
+
+   static ossimRpfSubframeCache* m_instance;
+   static std::mutex             m_instanceMutex;
+};
+
+#endif /* #ifndef ossimRpfSubframeCache_HEADER */
@@ -16,6 +16,7 @@
 #define ossimScalarRemapper_HEADER
 
 #include <ossim/imaging/ossimImageSourceFilter.h>
+#include <ossim/imaging/ossimRemapChain.h>
 
 class OSSIMDLLEXPORT ossimScalarRemapper : public ossimImageSourceFilter
 {
@@ -34,6 +35,13 @@ public:
    virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& tile_rect,
                                                ossim_uint32 resLevel=0);
 
+   /** Scalar conversion is pointwise. */
+   virtual bool isPointwiseRemap() const;
+
+   /** Converts an input tile to the output scalar type. */
+   virtual ossimRefPtr<ossimImageData> remapTile(
+      const ossimRefPtr<ossimImageData>& inputTile);
+
    /**
     *  Returns the output pixel type of the tile source.  This override the
     *  base class since it simply returns it's input scalar type which is
@@ -97,6 +105,10 @@ protected:
     *  Deletes allocated memory.  Used by both allocate and destructor.
     */
    void destroy();
+
+   /** Converts inputTile, returns a blank tileRect if it is null. */
+   ossimRefPtr<ossimImageData> remapInput(ossimRefPtr<ossimImageData> inputTile,
+                                          const ossimIrect& tileRect);
    
    double*                     theNormBuf;
    ossimRefPtr<ossimImageData> theTile;
@@ -104,6 +116,7 @@ protected:
 
    bool                        theByPassFlag;
    bool                        thePreserveMagnitudeFlag;
+   ossimRemapChain             theRemapChain;
 TYPE_DATA
 };
 
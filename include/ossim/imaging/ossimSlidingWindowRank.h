@@ -0,0 +1,131 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimSlidingWindowRank_HEADER
+#define ossimSlidingWindowRank_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <vector>
+
+class ossimImageData;
+
+/***************************************************************************************************
+ * Rank (median, percentile) and valid count filters over square windows, shared by
+ * ossimMeanMedianFilter and ossimDespeckleFilter.
+ *
+ * 8 and 16 bit data go through a sliding histogram (Huang): the window moves in a serpentine
+ * over the tile, dropping the samples that leave and adding the ones that enter, so a pixel costs
+ * two window edges instead of a sort of the whole window. The histogram is hierarchical, 16 bins
+ * per level, so picking the rank scans at most 32 bins for 8 bit and 64 for 16 bit data.
+ * 3x3 medians of tiles with no nulls use a sorting network, other types std::nth_element.
+ *
+ * Null samples are left out of the window. Not thread safe, the histogram is reused across calls.
+ **************************************************************************************************/
+class OSSIM_DLL ossimSlidingWindowRank
+{
+public:
+   enum NullMode
+   {
+      /** Null centers stay null, others get the rank of their valid neighborhood. */
+      SKIP_NULL_CENTER = 0,
+
+      /** Every pixel with a valid neighborhood gets its rank, null centers included. */
+      FILL_NULLS       = 1,
+
+      /** Only null centers are filled, valid ones are copied. */
+      NULL_CENTER_ONLY = 2
+   };
+
+   ossimSlidingWindowRank();
+
+   /** Odd window width and height, even sizes are rounded up. */
+   void setWindowSize(ossim_uint32 windowSize);
+   ossim_uint32 getWindowSize() const { return m_windowSize; }
+
+   /**
+    * Fraction of the sorted valid samples to pick, 0.5 (default) for the median. With n valid
+    * samples the pick is element min(n - 1, rank * n) of the sorted window.
+    */
+   void setRank(double rank);
+   double getRank() const { return m_rank; }
+
+   void setNullMode(NullMode mode) { m_nullMode = mode; }
+   NullMode getNullMode() const { return m_nullMode; }
+
+   /**
+    * Filters the bands of input into output. The input must cover the output rectangle grown by
+    * half a window on every side. Input nulls are only checked for tiles that are not full.
+    * @return false if the scalar types differ or are not handled, or the input is too small.
+    */
+   bool apply(const ossimImageData* input, ossimImageData* output);
+
+   /**
+    * Counts the valid samples in the window around every pixel of outputRect, line order, in
+    * constant time per pixel. Same coverage rules as apply().
+    */
+   bool countValid(const ossimImageData* input,
+                   ossim_uint32 band,
+                   const ossimImageData* output,
+                   std::vector<ossim_uint32>& counts) const;
+
+private:
+   /** Histogram bins per level. */
+   enum { RADIX_BITS = 4, RADIX = 1 << RADIX_BITS };
+
+   bool getStart(const ossimImageData* input,
+                 const ossimImageData* output,
+                 long& startX,
+                 long& startY) const;
+
+   template <class T> void applyHistogram(const ossimImageData* input,
+                                          ossimImageData* output,
+                                          long startX,
+                                          long startY,
+                                          ossim_uint32 keyBits,
+                                          long keyOffset);
+
+   template <class T> void applySelect(const ossimImageData* input,
+                                       ossimImageData* output,
+                                       long startX,
+                                       long startY);
+
+   template <class T> void applyMedian9(const ossimImageData* input,
+                                        ossimImageData* output,
+                                        long startX,
+                                        long startY) const;
+
+   template <class T> void countValidT(const ossimImageData* input,
+                                       ossim_uint32 band,
+                                       long startX,
+                                       long startY,
+                                       long width,
+                                       long height,
+                                       std::vector<ossim_uint32>& counts) const;
+
+   void resetHistogram(ossim_uint32 keyBits);
+   inline void add(ossim_uint32 key);
+   inline void remove(ossim_uint32 key);
+   ossim_uint32 select(ossim_uint32 k) const;
+
+   /** Index of the rank to pick among n samples. */
+   inline ossim_uint32 rankIndex(ossim_uint32 n) const
+   {
+      ossim_uint32 k = (ossim_uint32) (m_rank * n);
+      return (k < n) ? k : n - 1;
+   }
+
+   ossim_uint32 m_windowSize;
+   double       m_rank;
+   NullMode     m_nullMode;
+
+   // Hierarchical histogram, level l has RADIX^(l+1) bins:
+   ossim_uint32 m_levels;
+   std::vector< std::vector<ossim_uint32> > m_histogram;
+   ossim_uint32 m_count;
+};
+
+#endif /* #ifndef ossimSlidingWindowRank_HEADER */
@@ -21,6 +21,7 @@
 #define ossimTableRemapper_HEADER
 
 #include <ossim/imaging/ossimImageSourceFilter.h>
+#include <ossim/imaging/ossimRemapChain.h>
 
 class OSSIMDLLEXPORT ossimTableRemapper : public ossimImageSourceFilter
 {
@@ -43,7 +44,12 @@ public:
 
    virtual void initialize();
 
+   /** Table lookups are pointwise. */
+   virtual bool isPointwiseRemap() const;
 
+   /** Remaps an input tile through the table. */
+   virtual ossimRefPtr<ossimImageData> remapTile(
+      const ossimRefPtr<ossimImageData>& inputTile);
 
    virtual bool saveState(ossimKeywordlist& kwl,
                           const char* prefix=0)const;
@@ -73,6 +79,9 @@ protected:
    RemapTableType  theTableType;
    ossimScalarType theInputScalarType;
    ossimScalarType theOutputScalarType;
+
+   /** Fused run of pointwise remappers ending with this one. */
+   ossimRemapChain theRemapChain;
    
    void allocate(const ossimIrect& rect);
    void destroy();
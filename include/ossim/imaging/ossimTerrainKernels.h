@@ -0,0 +1,81 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimTerrainKernels_HEADER
+#define ossimTerrainKernels_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+
+/***************************************************************************************************
+ * Surface normal, aspect and shading of an elevation tile in one pass, the inner loop of
+ * ossimImageToPlaneNormalFilter and, through it, of ossimBumpShadeTileSource and ossimSlopeFilter.
+ *
+ * The gradient (p, q) = (dz/dx, dz/dy) of each pixel comes from its 3x3 neighborhood by either
+ * stencil below, scaled by the x and y scales, and the normal is (p, q, 1) made unit length. Any
+ * of the products can be asked for; the rest are not computed or written.
+ *
+ * Like ossimImageDataKernels there is a plain loop and an AVX2 one, four pixels at a time in double
+ * precision, picked by ossimImageDataKernels::getIsa() so "image_data.simd: false" turns it off.
+ * Groups of four with a null among their neighbors go through the plain loop, so both give the
+ * same bits. The AVX2 loop covers 8 and 16 bit, signed 16 bit, float and double elevations.
+ * Aspect needs an atan2 a pixel, so it costs more than all the rest together.
+ **************************************************************************************************/
+class OSSIM_DLL ossimTerrainKernels
+{
+public:
+   enum Stencil
+   {
+      /**
+       * Zevenbergen-Thorne: central differences of the four side neighbors. Beside a null the
+       * difference is one sided, the historic output of ossimImageToPlaneNormalFilter.
+       */
+      ZEVENBERGEN_THORNE = 0,
+
+      /**
+       * Horn: the 1-2-1 weighted differences of all eight neighbors. Smoother on noisy surfaces.
+       * Pixels with a null in their neighborhood fall back to Zevenbergen-Thorne.
+       */
+      HORN = 1
+   };
+
+   struct OSSIM_DLL Params
+   {
+      Params();
+
+      Stencil       m_stencil;
+      ossim_float64 m_xScale;     //!< Multiplies dz/dx per pixel, e.g. gain / meters per pixel.
+      ossim_float64 m_yScale;     //!< Multiplies dz/dy per pixel.
+      ossim_float64 m_inputNull;  //!< Null elevation.
+      ossim_float64 m_outputNull; //!< Written to every product of a pixel with no gradient.
+      ossim_float64 m_light[3];   //!< Unit vector toward the light, for m_shade.
+   };
+
+   /** Output planes, width x height. Leave null the ones not wanted. */
+   struct OSSIM_DLL Outputs
+   {
+      Outputs();
+
+      ossim_float64* m_normalX;
+      ossim_float64* m_normalY;
+      ossim_float64* m_normalZ; //!< Also the cosine of the slope.
+      ossim_float64* m_aspect;  //!< Degrees clockwise from north of downhill, -1 where flat.
+      ossim_float64* m_shade;   //!< Lambertian shading, normal dot light, -1 to 1.
+   };
+
+   /**
+    * Computes outputs for width x height pixels of dem, which has a one pixel border around them,
+    * i.e. is (width + 2) x (height + 2).
+    */
+   template <class T>
+   static void compute(const T* dem, ossim_uint32 width, ossim_uint32 height,
+                       const Params& params, const Outputs& outputs);
+
+   /** Writes the products of a flat surface to count pixels of outputs. */
+   static void fillFlat(ossim_uint32 count, const Params& params, const Outputs& outputs);
+};
+
+#endif /* #ifndef ossimTerrainKernels_HEADER */
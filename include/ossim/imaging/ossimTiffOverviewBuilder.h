@@ -22,6 +22,7 @@
 #include <ossim/base/ossimFilename.h>
 
 #include <ossim/imaging/ossimOverviewBuilderBase.h>
+#include <ossim/imaging/ossimDecimator.h>
 #include <ossim/imaging/ossimFilterResampler.h>
 
 #include <tiffio.h>
@@ -48,9 +49,13 @@ public:
    virtual ~ossimTiffOverviewBuilder();
 
    /**
-    * Supports BOX or NEAREST NEIGHBOR.  When indexed you should probably use nearest neighbor
+    * Supports BOX, NEAREST NEIGHBOR and LANCZOS.  When indexed you should probably use nearest
+    * neighbor, or setDecimationMethod(ossimDecimator::MODE).
     */ 
    void setResampleType(ossimFilterResampler::ossimFilterResamplerType resampleType);
+
+   /** Sets the decimation method, see ossimDecimator.  Default is BOX. */
+   void setDecimationMethod(ossimDecimator::Method method);
    
    /**
     *  Builds overview file and sets "theOutputFile" to that of
@@ -178,7 +183,8 @@ public:
     * Satisfies pure virtual from ossimOverviewBuilderBase.
     * 
     * Currently handled types are:
-    * "ossim_tiff_nearest" and "ossim_tiff_box"
+    * "ossim_tiff_nearest", "ossim_tiff_box", "ossim_tiff_lanczos" and
+    * "ossim_tiff_mode"
     *
     * @param type This should be the string representing the type.  This method
     * will do nothing if type is not handled and return false.
@@ -291,7 +297,7 @@ private:
    ossim_int32                                        m_currentTiffDir;
    ossim_uint16                                       m_tiffCompressType;
    ossim_int32                                        m_jpegCompressQuality;
-   ossimFilterResampler::ossimFilterResamplerType     m_resampleType;
+   ossimDecimator::Method                             m_decimationMethod;
    std::vector<double>                                m_nullPixelValues;
    bool                                               m_copyAllFlag;
    ossimString                                        m_tempExtension;
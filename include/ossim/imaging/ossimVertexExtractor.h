@@ -110,6 +110,17 @@ public:
       }
 
    const std::vector<ossimIpt>& getVertices() const { return theVertice; }
+
+   /*!
+    *  Turns the coarse to fine edge scan on or off.  When on, and the
+    *  source has reduced resolution levels, the edges are found on the
+    *  coarsest level and refined level by level, reading only a few pixels
+    *  either side of the coarser edges.  Lines are refined in parallel when
+    *  the source is an image handler.  Edge features too small to show on
+    *  the coarsest level are lost.  Defaults to the preference
+    *  "vertex_extractor.coarse_to_fine", true if not set.
+    */
+   void setCoarseToFine(bool flag) { theCoarseToFineFlag = flag; }
    
 protected:
    virtual ~ossimVertexExtractor();
@@ -119,6 +130,12 @@ protected:
     */
    bool scanForEdges();
 
+   /*!
+    *  Coarse to fine version of scanForEdges.  Returns false, leaving the
+    *  edges alone, if the source has no usable reduced resolution levels.
+    */
+   bool scanForEdgesCoarseToFine();
+
    /*!
     *  Extracts the vertices of the source.  Uses "theLeftEdge" and
     *  "theRightEdge" data members.
@@ -147,9 +164,10 @@ protected:
    std::vector<ossimIpt> theVertice;
    std::vector<ossim_int32>     theLeftEdge;
    std::vector<ossim_int32>     theRightEdge;
+   bool             theCoarseToFineFlag;
 
    //! Disallow copy constructor and operator=
-   ossimVertexExtractor(const ossimVertexExtractor&) : theLeftEdge(0), theRightEdge(0) {}
+   ossimVertexExtractor(const ossimVertexExtractor&) : theLeftEdge(0), theRightEdge(0), theCoarseToFineFlag(true) {}
    const ossimVertexExtractor& operator=(const ossimVertexExtractor& rhs)
       {return rhs;}
 
@@ -0,0 +1,79 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+//**************************************************************************************************
+#ifndef ossimParallelChipRenderer_HEADER
+#define ossimParallelChipRenderer_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimIpt.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimConnectableContainer.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <vector>
+
+class ossimImageSource;
+
+//*************************************************************************************************
+//! Renders one large getTile() request across several threads. The requested rectangle is cut
+//! into sub-tiles that are pulled through clones of the source, one clone per extra thread, and
+//! copied straight into the chip as they come out.
+//!
+//! The clones are made the way ossimImageChainMtAdaptor makes them: the state of the source and
+//! everything feeding it is saved to a keyword list and loaded into a container, so each clone
+//! has its own image handlers and needs no locking. They are kept as long as the saved state of
+//! the source stays the same and made again when it changes. Sources that cannot be cloned
+//! (state not saved, or a clone that does not come out with the same bounds, bands and scalar
+//! type) and chips of one sub-tile are rendered with a single getTile() on the source.
+//!
+//! Threads default to the "chip.threads" preference (0 for ossim::getNumberOfThreads()), then 1;
+//! sub-tiles to the "chip.tile_size" preference, then 512 pixels square.
+//*************************************************************************************************
+class OSSIM_DLL ossimParallelChipRenderer
+{
+public:
+   ossimParallelChipRenderer();
+   ~ossimParallelChipRenderer();
+
+   //! Threads to render a chip on, counting the calling thread. 0 is the default, 1 disables.
+   void setNumberOfThreads(ossim_uint32 numThreads);
+   ossim_uint32 getNumberOfThreads() const;
+
+   //! Size of the pieces a chip is cut into.
+   void setTileSize(const ossimIpt& tileSize);
+   const ossimIpt& getTileSize() const { return m_tileSize; }
+
+   //! Same as source->getTile(rect, resLevel), in parallel where it can be.
+   ossimRefPtr<ossimImageData> getChip(ossimImageSource* source,
+                                       const ossimIrect& rect,
+                                       ossim_uint32 resLevel=0);
+
+   //! Releases the clones and the handlers they hold open.
+   void clear();
+
+private:
+   //! Makes sure there are at least count clones of the current state of source.
+   bool cloneSource(ossimImageSource* source, ossim_uint32 resLevel, ossim_uint32 count);
+
+   //! Copies the part of tile inside chip into chip. False if the two do not match in scalar
+   //! type and bands.
+   bool copyTile(const ossimImageData* tile, ossimImageData* chip) const;
+
+   ossim_uint32 m_numThreads;
+   ossim_uint32 m_defaultThreads;
+   ossimIpt     m_tileSize;
+
+   //! Source the clones were made from and its state at the time.
+   const ossimImageSource* m_source;
+   ossimKeywordlist        m_sourceState;
+
+   //! The containers own the cloned objects, m_clones points at the clone of the source in each.
+   std::vector< ossimRefPtr<ossimConnectableContainer> > m_containers;
+   std::vector< ossimImageSource* >                      m_clones;
+};
+
+#endif /* #ifndef ossimParallelChipRenderer_HEADER */
@@ -0,0 +1,78 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+//**************************************************************************************************
+#ifndef ossimParallelChipSequencer_HEADER
+#define ossimParallelChipSequencer_HEADER 1
+
+#include <ossim/imaging/ossimImageSourceSequencer.h>
+#include <ossim/parallel/ossimParallelChipRenderer.h>
+
+//*************************************************************************************************
+//! Writer sequencer that renders the output tile grid a strip at a time on an
+//! ossimParallelChipRenderer and hands the tiles of the strip out in order. A strip is as many
+//! rows of tiles across the area of interest as it takes to give every thread of the renderer a
+//! couple of its sub-tiles, so only one strip of the product is ever held in memory however large
+//! the product is.
+//!
+//! The renderer is not owned and must outlive the sequencer. Its clones of the input are kept
+//! between strips, and between writes, as long as the input does not change.
+//!
+//! With adaptive threads the second strip, the first after the clones are made, is timed. If a
+//! sub-tile of the chain costs less than a couple of milliseconds of one thread the rest of the
+//! product is rendered on the calling thread alone, as the threads would only wait on the
+//! writer and each other.
+//*************************************************************************************************
+class OSSIM_DLL ossimParallelChipSequencer : public ossimImageSourceSequencer
+{
+public:
+   ossimParallelChipSequencer(ossimParallelChipRenderer* renderer,
+                              ossimImageSource* inputSource=0,
+                              ossimObject* owner=0);
+
+   virtual ~ossimParallelChipSequencer();
+
+   //! Drops the strip so the next getNextTile() renders from the first row again.
+   virtual void setToStartOfSequence();
+
+   //! Next tile in row major order, cut from the current strip. The tile is owned by the
+   //! sequencer and good until the next call.
+   virtual ossimRefPtr<ossimImageData> getNextTile(ossim_uint32 resLevel=0);
+
+   //! Rows of tiles rendered at once. 0, the default, works it out from the renderer.
+   void setRowsPerStrip(ossim_uint32 rows);
+
+   //! Lets the sequencer drop to one thread for a cheap chain. Off by default.
+   void setAdaptiveThreads(bool adaptive);
+
+   //! Threads the strips are rendered on, after any adaptation.
+   ossim_uint32 getNumberOfThreads() const;
+
+   //! Seconds spent rendering strips since the start of the sequence.
+   double getRenderSeconds() const { return m_renderSeconds; }
+
+protected:
+   //! Renders the strip holding the tile row, m_strip left null if nothing came out.
+   void renderStrip(ossim_int64 tileRow, ossim_uint32 resLevel);
+
+   //! Rows of tiles in a strip for the current area of interest.
+   ossim_uint32 getRowsPerStrip() const;
+
+   //! Settles the thread count on the cost of the strip just rendered.
+   void adaptThreads(double seconds, const ossimIrect& stripRect);
+
+   ossimParallelChipRenderer*  m_renderer;
+   ossim_uint32                m_rowsPerStrip;
+   ossimRefPtr<ossimImageData> m_strip;
+   ossim_int64                 m_stripFirstRow; //!< -1 when no strip is rendered.
+   ossim_int64                 m_stripRows;
+   ossimRefPtr<ossimImageData> m_tile;
+   bool                        m_adaptive;
+   ossim_uint32                m_threads;       //!< 0 until adapted, then the count settled on.
+   ossim_uint32                m_stripsRendered;
+   double                      m_renderSeconds;
+};
+
+#endif /* #ifndef ossimParallelChipSequencer_HEADER */
@@ -0,0 +1,29 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+//**************************************************************************************************
+#ifndef ossimParallelFor_HEADER
+#define ossimParallelFor_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <functional>
+
+namespace ossim
+{
+   //! Runs body(i) for i in [0, count) across up to numThreads threads and returns when all
+   //! iterations are done. Iterations are handed out dynamically so uneven work balances out.
+   //! The calling thread participates, so numThreads <= 1 (or count <= 1) runs inline with no
+   //! thread creation. A numThreads of 0 means ossim::getNumberOfThreads().
+   //!
+   //! Intended for short, fine grained fan-out inside a single request (e.g. the pieces of one
+   //! tile). Long running batch work should keep using ossimJobMultiThreadQueue.
+   //!
+   //! The body must not throw.
+   OSSIM_DLL void parallelFor(ossim_uint32 count,
+                              ossim_uint32 numThreads,
+                              const std::function<void(ossim_uint32)>& body);
+}
+
+#endif /* #ifndef ossimParallelFor_HEADER */
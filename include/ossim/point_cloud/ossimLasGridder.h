@@ -0,0 +1,146 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimLasGridder_HEADER
+#define ossimLasGridder_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimIrect.h>
+#include <fstream>
+#include <vector>
+
+class ossimLasHdr;
+
+/***************************************************************************************************
+ * Streams the point records of a LAS file straight into a raster of per-pixel lowest, highest,
+ * mean and count accumulators, without building ossimPointRecord objects.
+ *
+ * Records are read in large blocks. Each block is binned in parallel slices, with every slice
+ * sorting its points by the accumulator tile that owns them, then each tile owner merges the
+ * points of all slices. No locks are taken and no per-thread copies of the raster are made.
+ *
+ * Memory use is bounded by the block size and by "las.gridder_memory_limit" (MB, default 256),
+ * not by the point count. When the full raster does not fit in the limit, the accumulator holds
+ * a strip of lines and the file is streamed once per strip as getValues() walks down the image.
+ *
+ * Not thread safe; callers serialize access.
+ **************************************************************************************************/
+class OSSIMDLLEXPORT ossimLasGridder
+{
+public:
+   enum Statistic
+   {
+      LOWEST  = 0,
+      HIGHEST = 1,
+      MEAN    = 2,
+      COUNT   = 3
+   };
+
+   ossimLasGridder();
+   ~ossimLasGridder();
+
+   /** Reads the LAS header. Returns false if the file is not LAS or the point format unknown. */
+   bool open(const ossimFilename& lasFile);
+
+   void close();
+
+   /** @return Header of the open file or null. */
+   const ossimLasHdr* getHeader() const { return m_hdr; }
+
+   /**
+    * Defines the output raster.
+    * @param ulCorner Upper left corner (not center) of the upper left pixel.
+    * @param gsd Pixel size, same units as ulCorner.
+    * @param width Samples.
+    * @param height Lines.
+    * @param unitScale Multiplier taking LAS coordinates (after header scale and offset) to the
+    * units of ulCorner, gsd and the output heights, e.g. 0.3048 for feet to meters.
+    */
+   void setGrid(const ossimDpt& ulCorner,
+                const ossimDpt& gsd,
+                ossim_uint32 width,
+                ossim_uint32 height,
+                ossim_float64 unitScale = 1.0);
+
+   /** Zero (default) uses ossim::getNumberOfThreads(). */
+   void setNumberOfThreads(ossim_uint32 nThreads);
+
+   /** Overrides the "las.gridder_memory_limit" preference. */
+   void setMemoryLimit(ossim_uint64 bytes);
+
+   /**
+    * Copies the statistic for rect into buf (rect.width() * rect.height() values, line order).
+    * Pixels with no points, or outside the grid, get nullValue. Streams the file as needed.
+    * @return false if no file is open, no grid is set or the file could not be read.
+    */
+   bool getValues(const ossimIrect& rect,
+                  Statistic stat,
+                  ossim_float32* buf,
+                  ossim_float32 nullValue);
+
+   /**
+    * Streams the whole file into the accumulator lines [startLine, startLine + numLines).
+    * getValues() calls this itself; exposed for callers that want to control strips.
+    */
+   bool accumulate(ossim_uint32 startLine, ossim_uint32 numLines);
+
+private:
+   /** Accumulator cells are laid out tile by tile, TILE_DIM x TILE_DIM each. */
+   enum { TILE_DIM = 64, TILE_CELLS = TILE_DIM * TILE_DIM };
+
+   /** Point records per block read. */
+   enum { BLOCK_POINTS = 1 << 20 };
+
+   struct BinnedPoint
+   {
+      ossim_uint32  m_cell;
+      ossim_float32 m_z;
+   };
+
+   /** Lines per strip, a multiple of requestLines when the memory limit allows. */
+   ossim_uint32 getStripLines(ossim_uint32 requestLines) const;
+   void allocateStrip(ossim_uint32 startLine, ossim_uint32 numLines);
+   ossim_uint64 readBlock(std::vector<char>& block, ossim_uint64 firstPoint, ossim_uint64 maxPoints);
+   void binSlice(const char* records,
+                 ossim_uint64 count,
+                 std::vector<BinnedPoint>* bins,
+                 ossim_uint32 numOwners) const;
+   void mergeOwner(ossim_uint32 owner, ossim_uint32 numSlices);
+
+   inline ossim_uint64 cellIndex(ossim_uint32 line, ossim_uint32 samp) const
+   {
+      return (ossim_uint64) ((line / TILE_DIM) * m_tilesAcross + samp / TILE_DIM) * TILE_CELLS +
+             (line % TILE_DIM) * TILE_DIM + samp % TILE_DIM;
+   }
+
+   std::ifstream  m_str;
+   ossimLasHdr*   m_hdr;
+   ossim_uint32   m_recordLength;
+   ossimDpt       m_ulCorner;
+   ossimDpt       m_gsd;
+   ossim_uint32   m_width;
+   ossim_uint32   m_height;
+   ossim_float64  m_unitScale;
+   ossim_uint32   m_numThreads;
+   ossim_uint64   m_memoryLimit;
+
+   // Current strip:
+   ossim_uint32   m_stripStart;
+   ossim_uint32   m_stripLines;
+   ossim_uint32   m_tilesAcross;
+   std::vector<ossim_float32> m_lowest;
+   std::vector<ossim_float32> m_highest;
+   std::vector<ossim_float64> m_sum;
+   std::vector<ossim_uint32>  m_count;
+
+   // Per slice, per tile owner binned points, kept between blocks to reuse their capacity:
+   std::vector< std::vector<BinnedPoint> > m_bins;
+};
+
+#endif /* #ifndef ossimLasGridder_HEADER */
@@ -17,6 +17,7 @@
 #include <ossim/point_cloud/ossimPointBlock.h>
 #include <ossim/base/ossimFilename.h>
 #include <ossim/point_cloud/ossimPointCloudGeometry.h>
+#include <ossim/point_cloud/ossimPointCloudIndex.h>
 #include <vector>
 
 
@@ -70,6 +71,26 @@ public:
     */
    virtual void getBlock(const ossimGrect& bounds, ossimPointBlock& block) const;
 
+   /**
+    * Same as getBlock(bounds, block) at resLevel 0. For resLevel > 0 and an open index (see
+    * openIndex()), only the index's subsample of the nodes resLevel levels above the leaves is
+    * returned. Without an index all points in bounds are returned.
+    */
+   virtual void getBlock(const ossimGrect& bounds,
+                         ossimPointBlock& block,
+                         ossim_uint32 resLevel) const;
+
+   /**
+    * Loads the spatial index from its sidecar file (see ossimPointCloudIndex), building it with
+    * one pass over the points and writing the sidecar if it is missing or out of date. Once
+    * open, getBlock() reads only the points of the index nodes overlapping the bounds.
+    * @return true if an index is available.
+    */
+   bool openIndex();
+
+   /** @return The spatial index or null if openIndex() was not called or failed. */
+   const ossimPointCloudIndex* getIndex() const { return m_index.get(); }
+
    virtual const ossimPointRecord*  getMinPoint() const { return m_minRecord.get(); }
    virtual const ossimPointRecord*  getMaxPoint() const { return m_maxRecord.get(); }
 
@@ -90,6 +111,7 @@ protected:
    ossimRefPtr<ossimPointRecord> m_minRecord;
    ossimRefPtr<ossimPointRecord>  m_maxRecord;
    mutable ossim_uint32 m_currentPID;
+   ossimRefPtr<ossimPointCloudIndex> m_index;
 
 TYPE_DATA
 };
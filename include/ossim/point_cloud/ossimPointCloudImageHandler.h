@@ -233,6 +233,9 @@ protected:
 
    void initTile();
 
+   /** Opens the point cloud's spatial index unless the "point_cloud.index" preference is false. */
+   void openIndex();
+
    void addSample(std::map<ossim_int32, PcrBucket*>& accumulator,
                   ossim_int32 index,
                   const ossimPointRecord* sample);
@@ -0,0 +1,113 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+#ifndef ossimPointCloudIndex_HEADER
+#define ossimPointCloudIndex_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimGrect.h>
+#include <ossim/base/ossimReferenced.h>
+#include <iosfwd>
+#include <vector>
+
+class ossimPointCloudHandler;
+
+/***************************************************************************************************
+ * Quadtree over the horizontal extent of a point cloud, mapping each node to the runs of point
+ * IDs (file order) that fall in it. Points are not reordered, so queries read only the runs of the
+ * overlapping leaves through ossimPointCloudHandler::getFileBlock(). Collections written in
+ * flight line or tile order give long runs and a small index.
+ *
+ * Every node above the leaves also keeps an evenly spread subsample of its points (at most
+ * LOD_POINTS) for coarse reduced resolution queries.
+ *
+ * The index is built with one pass over the points and kept in a sidecar file next to the
+ * point cloud (see getIndexFilename()). It is rebuilt when the point cloud's size or number of
+ * points no longer match.
+ **************************************************************************************************/
+class OSSIMDLLEXPORT ossimPointCloudIndex : public ossimReferenced
+{
+public:
+   /** Run of consecutive point IDs. */
+   struct Range
+   {
+      ossim_uint32 m_start;
+      ossim_uint32 m_count;
+   };
+
+   /** Points kept per node for reduced resolution queries. */
+   enum { LOD_POINTS = 4096 };
+
+   /** Target average number of points per leaf. */
+   enum { LEAF_POINTS = 16384 };
+
+   /** Deepest tree allowed, 4^MAX_DEPTH leaves. */
+   enum { MAX_DEPTH = 10 };
+
+   ossimPointCloudIndex();
+
+   /** Builds the index with one pass over all points of the handler. */
+   bool build(const ossimPointCloudHandler* pch);
+
+   /**
+    * Reads the index from file. Fails if the file is not an index of sourceFile in its
+    * current state (size, modification time and point count), or if its offsets or point IDs
+    * are out of range.
+    */
+   bool read(const ossimFilename& indexFile,
+             const ossimFilename& sourceFile,
+             ossim_uint32 numPoints);
+
+   bool write(const ossimFilename& indexFile, const ossimFilename& sourceFile) const;
+
+   /** @return The sidecar file name for a point cloud, e.g. "foo.pci" for "foo.las". */
+   static ossimFilename getIndexFilename(const ossimFilename& sourceFile);
+
+   /**
+    * Returns the sorted, merged runs of point IDs that may fall in bounds. Level 0 gives all
+    * the points of the overlapping leaves; level n > 0 gives the subsamples of the overlapping
+    * nodes n levels above the leaves (clamped at the root).
+    */
+   void getRanges(const ossimGrect& bounds, ossim_uint32 level, std::vector<Range>& ranges) const;
+
+   /** @return Depth of the leaves, 0 when the tree is a single node. */
+   ossim_uint32 getDepth() const { return m_depth; }
+
+   ossim_uint32 getNumPoints() const { return m_numPoints; }
+
+   bool isValid() const { return m_numPoints != 0; }
+
+private:
+   /** @return Index of the first node at depth d, nodes are stored level by level. */
+   static ossim_uint32 levelStart(ossim_uint32 d);
+
+   /** Node containing the lat/lon at depth d. */
+   ossim_uint32 nodeAt(double lat, double lon, ossim_uint32 d) const;
+
+   void buildSamples(const std::vector< std::vector<Range> >& leafRanges);
+
+   bool readData(std::istream& in);
+   void writeData(std::ostream& out) const;
+
+   ossim_uint32 m_numPoints;
+   ossim_uint32 m_depth;
+   double       m_minLat;
+   double       m_minLon;
+   double       m_maxLat;
+   double       m_maxLon;
+
+   // Leaf runs, compressed rows: leaf i owns m_ranges[m_leafStart[i] .. m_leafStart[i+1]).
+   std::vector<ossim_uint32> m_leafStart;
+   std::vector<Range>        m_ranges;
+
+   // Subsamples of nodes above the leaves, indexed by node, same layout.
+   std::vector<ossim_uint32> m_sampleStart;
+   std::vector<ossim_uint32> m_samples;
+};
+
+#endif /* #ifndef ossimPointCloudIndex_HEADER */
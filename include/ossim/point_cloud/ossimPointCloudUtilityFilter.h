@@ -28,6 +28,8 @@ public:
    ossimPointCloudUtilityFilter( ossimPointCloudTool* pc_util);
    virtual ~ossimPointCloudUtilityFilter() {}
 
+   virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& tileRect, ossim_uint32 resLevel=0);
+
    virtual bool getTile(ossimImageData* result, ossim_uint32 resLevel);
    
    ossimScalarType getOutputScalarType() const { return OSSIM_FLOAT32; }
@@ -38,6 +40,7 @@ public:
 
 protected:
    ossimRefPtr<ossimPointCloudTool> m_util;
+   ossimRefPtr<ossimImageData> m_tile;
 
    TYPE_DATA
 };
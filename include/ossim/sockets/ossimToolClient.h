@@ -30,6 +30,7 @@ public:
 
    /**
     * Accepts hostname and portname as a string. Returns socket file descriptor or -1 if error.
+    * A hostname starting with '/' and no portname is the path of a server's local socket.
     */
    int connectToServer(char* hostname, char* portname=NULL);
 
@@ -77,7 +78,8 @@ protected:
 
    bool receiveText();
    bool receiveFile();
-   bool acknowledgeRcv();
+   bool sendAll(const void* buf, size_t size);
+   bool recvAll(void* buf, size_t size);
 
    int m_svrsockfd;
    char* m_buffer;
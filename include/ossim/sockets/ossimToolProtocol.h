@@ -0,0 +1,70 @@
+//**************************************************************************************************
+//
+//     OSSIM Open Source Geospatial Data Processing Library
+//     See top level LICENSE.txt file for license information
+//
+//**************************************************************************************************
+
+#ifndef ossimToolProtocol_HEADER
+#define ossimToolProtocol_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+
+/**
+ * Wire format shared by ossimToolServer and ossimToolClient. All integers are big endian.
+ *
+ * Request (client to server):
+ *
+ *    u32 length | command text (length bytes, no terminator)
+ *
+ * Response (server to client), one per request, in request order:
+ *
+ *    "TEXT " | u64 length | text
+ *    "ERROR" | u64 length | text
+ *    "FILE " | u64 length | text | u32 name length | name | u64 file size | file bytes
+ *
+ * The text is whatever the tool wrote to the console. For FILE the name is the product file name
+ * without the server side path. Requests may be pipelined; there are no acknowledgements.
+ */
+namespace ossimToolProtocol
+{
+   /** Size of the response type tag. */
+   const ossim_uint32 TYPE_SIZE = 5;
+
+   const char* const TEXT_TYPE  = "TEXT ";
+   const char* const ERROR_TYPE = "ERROR";
+   const char* const FILE_TYPE  = "FILE ";
+
+   /** Requests longer than this are rejected and the connection is closed. */
+   const ossim_uint32 MAX_REQUEST_SIZE = 1024 * 1024;
+
+   inline void encodeU32(ossim_uint32 value, ossim_uint8* buf)
+   {
+      for (int i = 3; i >= 0; --i, value >>= 8)
+         buf[i] = (ossim_uint8) (value & 0xff);
+   }
+
+   inline void encodeU64(ossim_uint64 value, ossim_uint8* buf)
+   {
+      for (int i = 7; i >= 0; --i, value >>= 8)
+         buf[i] = (ossim_uint8) (value & 0xff);
+   }
+
+   inline ossim_uint32 decodeU32(const ossim_uint8* buf)
+   {
+      ossim_uint32 value = 0;
+      for (int i = 0; i < 4; ++i)
+         value = (value << 8) | buf[i];
+      return value;
+   }
+
+   inline ossim_uint64 decodeU64(const ossim_uint8* buf)
+   {
+      ossim_uint64 value = 0;
+      for (int i = 0; i < 8; ++i)
+         value = (value << 8) | buf[i];
+      return value;
+   }
+}
+
+#endif
@@ -10,35 +10,109 @@
 
 #include <ossim/base/ossimConstants.h>
 #include <ossim/base/ossimFilename.h>
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+class ossimJobMultiThreadQueue;
 
 /**
- * Utility class provides the server interface to ossimTool-derived functionality via TCP sockets
+ * Utility class provides the server interface to ossimTool-derived functionality via TCP sockets,
+ * or a unix domain socket for clients on the same host.
  * Results are returned either as streamed text (for non-image responses such as image info) or
  * streamed binary file representing imagery or vector products. Clients interfacing to this class
  * should know the commands available (or execute the command "help" and view the text response).
+ *
+ * All connections are serviced by one process. A single event loop (epoll on Linux, poll
+ * elsewhere) accepts connections and reads length framed requests (see ossimToolProtocol.h).
+ * Complete requests are run on a pool of worker threads, so the elevation, image handler and tile
+ * caches stay warm between requests. Console output written through std::cout (including
+ * ossimNotify) by the tool is captured per request and returned as the response text. Output
+ * written with printf is not captured.
+ *
+ * Besides the tool commands the server understands "help", "stats" (request latency metrics)
+ * and "goodbye" (close the connection).
+ *
  * @see ossimToolClient for concrete client implementation.
  */
 class OSSIM_DLL ossimToolServer
 {
 public:
+   /** Number of latency histogram buckets. Bucket i counts requests under 2^i milliseconds. */
+   enum { NUM_LATENCY_BUCKETS = 20 };
+
+   /** Request counters and latency histogram, latency measured from receipt to response sent. */
+   struct Metrics
+   {
+      Metrics();
+      ossim_uint64 m_requests;
+      ossim_uint64 m_errors;
+      ossim_uint64 m_connections;
+      double       m_totalSeconds;
+      double       m_maxSeconds;
+      ossim_uint64 m_histogram[NUM_LATENCY_BUCKETS];
+
+      /** @return Upper bound in seconds of the latency at fraction (0 to 1) of requests. */
+      double percentile(double fraction) const;
+
+      void print(std::ostream& out) const;
+   };
+
    ossimToolServer();
    ~ossimToolServer();
+
+   /**
+    * Sets the number of worker threads. Zero (the default) uses ossim::getNumberOfThreads().
+    * Must be called before startListening().
+    */
+   void setNumberOfThreads(ossim_uint32 nThreads);
+
+   /**
+    * Serves requests on the port given until stop() is called. A portid with a '/' is the path
+    * of a local (unix domain) socket, made on start and removed on return.
+    */
    void startListening(const char* portid);
 
+   /** Makes startListening() return. May be called from any thread. */
+   void stop();
+
+   /** @return Copy of the metrics gathered so far. */
+   Metrics getMetrics() const;
+
 private:
+   class Connection;
+   class RequestJob;
+   class Poller;
+
    void initSocket(const char* portid);
-   bool processOssimRequest(struct sockaddr_in& cli_addr);
-   bool runCommand(ossimString& command);
-   void writeSocket(const char* buf, int bufsize);
-   bool sendFile(const ossimFilename& fname);
+   void initLocalSocket(const char* path);
+   void acceptConnections();
+   void readConnection(int fd);
+   bool dispatchRequest(std::shared_ptr<Connection> conn);
+   void processRequest(std::shared_ptr<Connection> conn,
+                       std::string& command,
+                       std::chrono::steady_clock::time_point received);
+   bool runCommand(Connection& conn, ossimString& command);
+   bool writeResponse(Connection& conn, const char* type, const std::string& text);
+   bool sendFile(Connection& conn, const std::string& text, const ossimFilename& fname);
+   void closeConnection(int fd);
+   void recordRequest(double seconds, bool ok);
    void error(const char* msg);
-   bool acknowledgeRcvd();
-
-   static void sigchld_handler(int s);
 
    int m_svrsockfd;
-   int m_clisockfd;
-   char* m_buffer;
+   std::string m_localPath;
+   ossim_uint32 m_numThreads;
+   std::atomic<bool> m_stop;
+   std::unique_ptr<Poller> m_poller;
+   std::shared_ptr<ossimJobMultiThreadQueue> m_jobQueue;
+
+   mutable std::mutex m_mutex; // guards m_connections and m_metrics
+   std::map<int, std::shared_ptr<Connection> > m_connections;
+   Metrics m_metrics;
 };
 
 
@@ -107,6 +107,9 @@ public:
    /** @return Point data format ID */
    ossim_uint8 getPointDataFormatId() const;
 
+   /** @return Size in bytes of one point data record. */
+   ossim_uint16 getPointDataRecordLength() const;
+
    /** @return The number of total points. */
    ossim_uint64 getNumberOfPoints() const;
 
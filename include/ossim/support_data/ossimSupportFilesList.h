@@ -12,12 +12,14 @@
 #define ossimSupportFilesList_HEADER
 
 #include <vector>
+#include <mutex>
 #include <ossim/base/ossimFilename.h>
 
 class ossimKeywordlist;
 
 //*************************************************************************************************
-//! Singleton class for logging all support data files opened during a session.
+//! Singleton class for logging all support data files opened during a session. Handlers opened
+//! on several threads at once may add to it.
 //*************************************************************************************************
 class OSSIMDLLEXPORT ossimSupportFilesList
 {
@@ -25,19 +27,28 @@ public:
    static ossimSupportFilesList* instance();
 
    //! Add support data filename to the list:
-   void add(const ossimFilename& f) { m_list.push_back(f); }
+   void add(const ossimFilename& f)
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_list.push_back(f);
+   }
 
    //! Output list to the kwl.
    void save(ossimKeywordlist& kwl, const char* prefix) const;
    
    //! Clears the list to ready for new accumulation:
-   void clear() { m_list.clear(); }
+   void clear()
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_list.clear();
+   }
 
 private:
    ossimSupportFilesList()  { }
    ~ossimSupportFilesList() { m_instance=0; }
 
    std::vector<ossimFilename>       m_list;
+   mutable std::mutex               m_mutex;
    static ossimSupportFilesList*    m_instance;
 };
 
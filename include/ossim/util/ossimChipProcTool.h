@@ -12,6 +12,7 @@
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/base/ossimIrect.h>
 #include <ossim/base/ossimGrect.h>
+#include <ossim/base/ossimHistogram.h>
 #include <ossim/imaging/ossimImageSource.h>
 #include <ossim/imaging/ossimSingleImageChain.h>
 #include <ossim/imaging/ossimImageFileWriter.h>
@@ -20,6 +21,7 @@
 #include <ossim/projection/ossimImageViewAffineTransform.h>
 #include <ossim/base/ossimProcessInterface.h>
 #include <ossim/base/ossimListenerManager.h>
+#include <ossim/parallel/ossimParallelChipRenderer.h>
 #include <ossim/util/ossimTool.h>
 #include <map>
 #include <vector>
@@ -93,7 +95,9 @@ public:
    virtual ossimObject* getObject();
    virtual const ossimObject* getObject() const;
 
-   /** The meat and potatos of this class. Performs an execute on specified rect. */
+   /** The meat and potatos of this class. Performs an execute on specified rect. The chip is
+    * rendered across threads, keyword "threads" sets how many (1 for the calling thread only),
+    * see ossimParallelChipRenderer. */
    virtual ossimRefPtr<ossimImageData> getChip(const ossimIrect& img_rect);
    virtual ossimRefPtr<ossimImageData> getChip(const ossimGrect& gnd_rect);
    ossimRefPtr<ossimImageData> getChip(const ossimDrect& map_bounding_rect, const ossimDpt& gsd);
@@ -218,6 +222,18 @@ protected:
     */
    ossimRefPtr<ossimImageSource>  mosaicDemSources();
 
+   /**
+    * Histogram of one band of an image for statistics passes (auto thresholds and the like) that
+    * would otherwise need a full extra pass over the product. The tiles of the finest reduced
+    * resolution level of at most maxPixels pixels, or of the coarsest level there is, are read
+    * across m_chipRenderer's threads, each on its own handler of the image, and the per thread
+    * counts summed. Float data is binned over the handler's min and max pixel values.
+    * @return Null if the image cannot be read.
+    */
+   ossimRefPtr<ossimHistogram> computeHistogram(ossimImageHandler* handler,
+                                                ossim_uint32 band=0,
+                                                ossim_uint64 maxPixels=4194304);
+
    ossimRefPtr<ossimImageGeometry> m_geom; //> Product chip/image geometry
    ossimIrect m_aoiViewRect;
    ossimGrect m_aoiGroundRect;
@@ -232,6 +248,8 @@ protected:
    ossimFilename m_productFilename;
    ossimScalarType m_productScalarType;
    bool m_needCutRect; // True when a specific AOI, different from the input, was requested
+   ossimParallelChipRenderer m_chipRenderer; //> Renders getChip() on clones of m_procChain
+   bool m_tiledWrite; //> execute() writes strips of tiles rendered on m_chipRenderer
 };
 
 #endif /* #ifndef ossimChipProcUtil_HEADER */
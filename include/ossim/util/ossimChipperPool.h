@@ -0,0 +1,98 @@
+//**************************************************************************************************
+//
+//     OSSIM Open Source Geospatial Data Processing Library
+//     See top level LICENSE.txt file for license information
+//
+//**************************************************************************************************
+#ifndef ossimChipperPool_HEADER
+#define ossimChipperPool_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/util/ossimChipperUtil.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <utility>
+
+/**
+ * Keeps initialized ossimChipperUtil objects between requests so that a long running process
+ * (ossim-tool-server, a web service) does not open the inputs, read their geometries, overviews
+ * and histograms and build the chains again for every chip.
+ *
+ * Chippers are keyed by their chain options, i.e. every option that is not a view option (see
+ * ossimChipperUtil::isViewOption). A request with the chain options of an idle chipper takes it
+ * and only changes its view (output projection, gsd, cut, output file). Otherwise a new chipper
+ * is initialized. A chipper serves one request at a time and goes back to the pool when the
+ * request succeeds; on error it is dropped. The least recently used idle chippers are released
+ * past the "chipper_pool.size" preference, default 8, 0 keeping none.
+ */
+class OSSIM_DLL ossimChipperPool
+{
+public:
+   struct Stats
+   {
+      Stats() : m_hits(0), m_misses(0), m_idle(0) {}
+
+      ossim_uint64 m_hits;   //!< Requests served by a warm chipper.
+      ossim_uint64 m_misses; //!< Requests that initialized a new one.
+      ossim_uint32 m_idle;   //!< Chippers in the pool now.
+   };
+
+   static ossimChipperPool* instance();
+
+   /** @return The chain options of options as one string, "key=value" lines in key order. */
+   static std::string getChainKey(const ossimKeywordlist& options);
+
+   /**
+    * Writes the product of options, as ossimChipperUtil::initialize(options) followed by
+    * execute() would.
+    * @note Throws ossimException on error.
+    */
+   void execute(const ossimKeywordlist& options);
+
+   /**
+    * @return The chip of options, as ossimChipperUtil::initialize(options) followed by
+    * getChip() would. The chip belongs to the caller.
+    * @note Throws ossimException on error.
+    */
+   ossimRefPtr<ossimImageData> getChip(const ossimKeywordlist& options);
+
+   /** Idle chippers to keep. Extra ones are released on the spot. */
+   void setMaxIdle(ossim_uint32 maxIdle);
+   ossim_uint32 getMaxIdle() const;
+
+   Stats getStats() const;
+
+   /** Releases all idle chippers and the files they hold open. */
+   void clear();
+
+private:
+   ossimChipperPool();
+   ossimChipperPool(const ossimChipperPool&);
+   const ossimChipperPool& operator=(const ossimChipperPool&);
+
+   /** Takes an idle chipper for options and sets its view, or initializes a new one. */
+   ossimRefPtr<ossimChipperUtil> checkOut(const ossimKeywordlist& options,
+                                          const std::string& key);
+
+   /** Puts chipper at the front of the idle list. */
+   void checkIn(const std::string& key, ossimRefPtr<ossimChipperUtil> chipper);
+
+   typedef std::pair< std::string, ossimRefPtr<ossimChipperUtil> > Entry;
+
+   /**
+    * Moves idle chippers past m_maxIdle, last used first, to released, to be let go of once
+    * m_mutex, which must be locked, is not.
+    */
+   void trim(std::list<Entry>& released);
+
+   mutable std::mutex m_mutex;
+   std::list<Entry>   m_idle; //!< Most recently used first.
+   ossim_uint32       m_maxIdle;
+   Stats              m_stats;
+};
+
+#endif /* #ifndef ossimChipperPool_HEADER */
@@ -0,0 +1,59 @@
+//**************************************************************************************************
+//
+//     OSSIM Open Source Geospatial Data Processing Library
+//     See top level LICENSE.txt file for license information
+//
+//**************************************************************************************************
+
+#ifndef ossimChipperTool_HEADER
+#define ossimChipperTool_HEADER 1
+
+#include <ossim/base/ossimFilename.h>
+#include <ossim/util/ossimTool.h>
+
+/*!
+ *  Tool class running ossim-chipper commands on the chippers kept in the ossimChipperPool, so
+ *  that in a long running process (ossim-tool-server) requests on the same inputs and chain
+ *  options only pay for the new view. Takes the ossim-chipper command line.
+ */
+class OSSIMDLLEXPORT ossimChipperTool : public ossimTool
+{
+public:
+   ossimChipperTool();
+   virtual ~ossimChipperTool();
+
+   /**
+    * Reads the ossim-chipper command line into the options. Does not open the inputs.
+    * @return Always TRUE, with helpRequested() set if --help was requested or no arguments given.
+    * @note Throws ossimException on error.
+    */
+   virtual bool initialize(ossimArgumentParser& ap);
+
+   /**
+    * Takes kwl as the ossim-chipper options.
+    */
+   virtual void initialize(const ossimKeywordlist& kwl);
+
+   /**
+    * Writes the product with a pooled chipper. Always returns true since using exception on error.
+    * @note Throws ossimException on error.
+    */
+   virtual bool execute();
+
+   virtual void clear();
+
+   virtual ossimString getClassName() const { return "ossimChipperTool"; }
+
+   /** @return The file written by the last execute(). */
+   const ossimFilename& getProductFilename() const { return m_productFilename; }
+
+   /** Used by ossimUtilityFactory */
+   static const char* DESCRIPTION;
+
+protected:
+   virtual void setUsage(ossimArgumentParser& ap);
+
+   ossimFilename m_productFilename;
+};
+
+#endif
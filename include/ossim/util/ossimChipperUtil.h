@@ -27,6 +27,7 @@
 #include <ossim/imaging/ossimImageFileWriter.h>
 #include <ossim/projection/ossimMapProjection.h>
 #include <ossim/base/ossimConnectableContainer.h>
+#include <ossim/parallel/ossimParallelChipRenderer.h>
 
 #include <map>
 #include <vector>
@@ -113,6 +114,33 @@ public:
     */
    void initialize(const ossimKeywordlist& kwl);
 
+   /**
+    * @brief Parses the command line into the options keyword list without
+    * opening any inputs. initialize(ap) is this followed by the chain set up.
+    * @return false if --help was requested or no arguments were given.
+    * @note Throws ossimException on error.
+    */
+   bool parseOptions(ossimArgumentParser& ap);
+
+   /** @return The options keyword list. */
+   const ossimKeywordlist& getOptions() const;
+
+   /**
+    * @return true if key only changes the view of the product (output
+    * projection, gsd, cut, rotation, thumbnail, output file and writer), not
+    * the input chains, so that it can be changed with setViewOptions().
+    */
+   static bool isViewOption(const std::string& key);
+
+   /**
+    * @brief Replaces the view options (see isViewOption) with those of kwl
+    * and sets up the output projection, keeping the input chains with their
+    * open handlers, histograms and look up tables. Follow with execute() or
+    * getChip().
+    * @note Throws ossimException on error.
+    */
+   void setViewOptions(const ossimKeywordlist& kwl);
+
    /**
     * @brief execute method.  Performs the actual product write.
     * @note Throws ossimException on error.
@@ -139,8 +167,8 @@ public:
    *  cut_width:
    *  cut_height:
    *
-   *
-   *
+   * The chip is rendered across threads, "threads: <n>" sets how many (1
+   * for the calling thread only), see ossimParallelChipRenderer.
    */
    ossimRefPtr<ossimImageData> getChip(const ossimKeywordlist& optionsKwl= ossimKeywordlist());
 
@@ -878,6 +906,11 @@ private:
     * Final container that holds any cuts or stretching, ... etc just before we output 
     */
    ossimRefPtr<ossimConnectableContainer> m_container;
+
+   /**
+    * Renders getChip() requests across threads on clones of the final input.
+    */
+   ossimParallelChipRenderer m_chipRenderer;
 };
 
 #endif /* #ifndef ossimChipperUtil_HEADER */
@@ -20,7 +20,11 @@
 #include <ossim/base/ossimFilename.h>
 #include <ossim/parallel/ossimJob.h>
 #include <ossim/parallel/ossimJobMultiThreadQueue.h>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <mutex>
 #include <memory>
@@ -36,6 +40,19 @@ class ossimFileProcessorInterface;
  * method is excecuted.  Internally the processFile calls are placed in a job
  * queue.
  *
+ * Directories are listed on several threads at once (see
+ * setNumberOfCrawlThreads), each handing its files to the job queue as soon as
+ * it has listed them, so processing starts with the first directory instead of
+ * after the whole tree is walked.  File types come from the directory entries
+ * where the file system gives them, so a file is only stat'ed when needed.
+ * The queue is kept to a few thousand jobs, the crawl waiting on the
+ * processing beyond that.
+ *
+ * With a checkpoint file (see setCheckpointFile) every processed file is
+ * recorded with its modification time and size, and files recorded unchanged
+ * are skipped.  The file is written as files are processed, so an interrupted
+ * walk picks up where it was on the next run.
+ *
  * Typical usage (snip from ossimTiledElevationDatabase):
  *
  * ossimFileWalker* fw = new ossimFileWalker();
@@ -114,10 +131,14 @@ public:
    /**
     * @brief Sets recurse flag.
     *
-    * If set to true this stops recursing of the
+    * If set to false this stops recursing of the
     * current directory.  Defaulted to true in the constructor.
     * Typically used to indicate the directory being processed holds a
-    * directory based image, e.g. RPF data.
+    * directory based image, e.g. RPF data.  Called from
+    * ossimFileProcessorInterface::processFile it applies to the directory of
+    * the file being processed, which requires the waitOnDir flag, and to
+    * nothing for a file passed to walk() itself; called from anywhere else it
+    * applies to the rest of the walk.
     *
     * @param flag True to recurse, false to stop recursion of current
     * directory.
@@ -144,20 +165,76 @@ public:
 
    /** @brief Sets the max number of threads(jobs) to run at one time. */
    void setNumberOfThreads(ossim_uint32 nThreads);
-   
+
+   /**
+    * @brief Sets the number of directories listed at one time.
+    *
+    * Defaulted to ossim::getNumberOfThreads() in the constructor.  These
+    * threads only list directories, the processFile calls are run by the job
+    * queue (see setNumberOfThreads).
+    */
+   void setNumberOfCrawlThreads(ossim_uint32 nThreads);
+
+   /**
+    * @brief Sets the checkpoint file.  Empty, the default, for none.
+    *
+    * Files recorded in it with the same modification time and size are not
+    * processed.  The file is created if it does not exist.
+    */
+   void setCheckpointFile(const ossimFilename& file);
+
+   /** @return The checkpoint file, empty if none. */
+   const ossimFilename& getCheckpointFile() const;
+
+   /** @return Files skipped in the last walk as unchanged since checkpointed. */
+   ossim_uint64 getNumberOfSkippedFiles() const;
+
 private:
 
+   /**
+    * @brief Modification time and size a file is checkpointed with, and
+    * whether processing it turned recursion of its directory off.
+    */
+   struct FileStamp
+   {
+      FileStamp() : m_mtime(0), m_size(-1), m_stopsRecursion(false) {}
+      ossim_int64 m_mtime;
+      ossim_int64 m_size;
+      bool        m_stopsRecursion;
+   };
+
+   /** @brief Jobs of a directory not done yet and its recurse flag. */
+   struct DirState
+   {
+      DirState() : m_pending(0), m_recurse(true) {}
+      ossim_uint32      m_pending; // Guarded by m_jobMutex.
+      std::atomic<bool> m_recurse;
+   };
+
    /** @brief Private ossimJob class. */
    class ossimFileWalkerJob : public ossimJob
    {
    public:
       /**
        * @brief Constructor that takes file processor pointer and file.
+       * @param walker The walker, counted out when the job goes.
        * @param fpi ossimFileProcessorInterface pointer
        * @param file The file to process.
+       * @param stamp The file's stamp, checkpointed once it is processed if
+       * m_size is not negative.
+       * @param dirState State of the directory of the file, may be null.
        */
-      ossimFileWalkerJob(ossimFileProcessorInterface* fpi,
-                         const ossimFilename& file);
+      ossimFileWalkerJob(ossimFileWalker* walker,
+                         ossimFileProcessorInterface* fpi,
+                         const ossimFilename& file,
+                         const FileStamp& stamp,
+                         std::shared_ptr<DirState> dirState);
+
+      /**
+       * @brief Counts the job out of the walker.  Done here rather than at
+       * the end of run so that jobs cleared off the queue count too.
+       */
+      virtual ~ossimFileWalkerJob();
 
 protected:
       /**
@@ -168,8 +245,11 @@ protected:
       virtual void run();
       
    private:
+      ossimFileWalker*             m_walker;
       ossimFileProcessorInterface* m_fileProcessor;
       ossimFilename                m_file;
+      FileStamp                    m_stamp;
+      std::shared_ptr<DirState>    m_dirState;
       
    }; // End: class ossimFileWalkerJob
 
@@ -183,13 +263,57 @@ protected:
       virtual void canceled(std::shared_ptr<ossimJob> job);
    };
 
+   /**
+    * @brief Walks dirs and everything under them on the crawl threads.
+    */
+   void crawl(const std::vector<ossimFilename>& dirs);
+
+   /**
+    * @brief Crawl thread loop.  Lists directories off the stack until it is
+    * empty with no crawl thread left to add to it.
+    */
+   void crawlDirs();
+
    /**
     * @brief Processes files in directory.
     *
-    * If a file in the directory is itself a directory this will do a recursive
-    * call to itself.  Individual files are processed in a job queue...
+    * Individual files are processed in a job queue...  Sub directories to
+    * walk next are passed back in subDirs.
+    */
+   void walkDir(const ossimFilename& dir, std::vector<ossimFilename>& subDirs);
+
+   /**
+    * @brief Queues the job for file, waiting while the queue is full.
     */
-   void walkDir(const ossimFilename& dir);
+   void submit(const ossimFilename& file,
+               const FileStamp& stamp,
+               std::shared_ptr<DirState> dirState);
+
+   /**
+    * @brief Waits for the jobs of dirState, or of the whole walk if null.
+    * Clears the queue if aborted.
+    */
+   void waitForJobs(const DirState* dirState);
+
+   /** @brief Called by the destructor of each job. */
+   void jobDone(DirState* dirState);
+
+   /** @brief Resets per walk state and reads the checkpoint. */
+   void beginWalk();
+
+   /** @brief Rewrites the checkpoint without duplicates. */
+   void endWalk();
+
+   /**
+    * @return true if checkpointing and file is checkpointed with stamp.
+    * stopsRecursion is set from the checkpoint.
+    */
+   bool isUnchanged(const ossimFilename& file,
+                    const FileStamp& stamp,
+                    bool& stopsRecursion) const;
+
+   /** @brief Adds file to the checkpoint. */
+   void checkpoint(const ossimFilename& file, const FileStamp& stamp);
    
    /**
     * @brief Convenience method for file walker code to check file to see is
@@ -218,8 +342,27 @@ protected:
    std::vector<std::string>              m_filteredExtensions;
    bool                                  m_recurseFlag;
    bool                                  m_waitOnDirFlag;
-   bool                                  m_abortFlag;
+   std::atomic<bool>                     m_abortFlag;
    std::mutex                            m_mutex;
+
+   /** Directory stack of the crawl threads. */
+   ossim_uint32                          m_crawlThreads;
+   std::vector<ossimFilename>            m_dirStack;
+   ossim_uint32                          m_activeCrawlers;
+   std::mutex                            m_crawlMutex;
+   std::condition_variable               m_crawlCondition;
+
+   /** Jobs queued or running. */
+   ossim_uint32                          m_outstandingJobs;
+   std::mutex                            m_jobMutex;
+   std::condition_variable               m_jobCondition;
+
+   /** Checkpoint file, its records and the stream new ones are added to. */
+   ossimFilename                         m_checkpointFile;
+   std::unordered_map<std::string, FileStamp> m_checkpoint;
+   std::ofstream                         m_checkpointStream;
+   mutable std::mutex                    m_checkpointMutex;
+   std::atomic<ossim_uint64>             m_skippedFiles;
 };
 
 #endif /* #ifndef ossimFileWalker_HEADER */
@@ -14,20 +14,15 @@
 #include <ossim/base/ossimIpt.h>
 #include <ossim/base/ossimIrect.h>
 #include <ossim/base/ossimGrect.h>
-#include <ossim/base/ossimLeastSquaresPlane.h>
 #include <ossim/imaging/ossimImageSource.h>
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimMemoryImageSource.h>
 #include <ossim/projection/ossimImageViewProjectionTransform.h>
-#include <ossim/parallel/ossimJob.h>
-#include <ossim/parallel/ossimJobMultiThreadQueue.h>
 #include <ossim/point_cloud/ossimPointCloudHandler.h>
 #include <ossim/util/ossimChipProcTool.h>
 #include <vector>
-
-#include <mutex>
 /*!
  *  Class for finding helicopter landing zones (HLZ) on a DEM given the final destination and max
  *  range from destination.
@@ -75,8 +70,38 @@ protected:
    void setProductGSD(const double& meters_per_pixel);
    bool computeHLZ();
 
+   /**
+    * Loads the AOI of the DEM (or slope) into heights, and flags the cells no LZ may cover: nulls,
+    * slopes over the threshold and cells failing the masks.
+    */
+   void loadCells(std::vector<double>& heights, std::vector<ossim_uint8>& rejects);
+
+   /**
+    * Tests the patches with origins in rows [first_row, first_row + num_rows) of the AOI, setting
+    * good_patches to 1 for those passing. Plane fits and roughness come from summed-area tables of
+    * the band, the point cloud test runs on the survivors.
+    */
+   void evaluatePatches(ossim_int32 first_row, ossim_int32 num_rows,
+                        const std::vector<double>& heights,
+                        const std::vector<ossim_uint8>& rejects,
+                        std::vector<ossim_uint8>& good_patches) const;
+
+   /**
+    * Largest vertical distance of the posts of the patch at heights[origin] from the best-fit
+    * plane, given its slopes a and b a cell.
+    */
+   double peakDeviation(const std::vector<double>& heights, size_t origin,
+                        double a, double b) const;
+
+   /** Paints every pixel covered by a good patch as good, the rest covered by any as bad. */
+   void paintPatches(const std::vector<ossim_uint8>& good_patches);
+
+   /** Point cloud test of the patch [ul, lr). True if clear of obstructions. */
+   bool level2Test(const ossimIpt& ul, const ossimIpt& lr) const;
+
    double m_slopeThreshold; // (degrees)
-   double m_roughnessThreshold; // peak deviation from plane (meters)
+   double m_roughnessThreshold; // peak deviation from best-fit plane (meters)
+   double m_rmsRoughnessThreshold; // RMS deviation from best-fit plane (meters), NaN if not used
    double m_hlzMinRadius; // meters
    ossimFilename m_slopeFile; // optional byproduct output
    ossimIpt m_demFilterSize;
@@ -94,51 +119,6 @@ protected:
    // For debugging:
    ossim_uint32 m_numThreads;
    double d_accumT;
-
-   class PatchProcessorJob : public ossimJob
-   {
-   public:
-      PatchProcessorJob(ossimHlzTool* hlzUtil, const ossimIpt& origin, ossim_uint32 chip_id=0);
-
-      virtual bool level1Test() = 0;
-      bool level2Test();
-      bool maskTest();
-
-      ossimHlzTool* m_hlzUtil;
-      ossimIpt m_demPatchUL;
-      ossimIpt m_demPatchLR;
-      ossim_uint8 m_status;
-      float m_nullValue;
-
-      // ossim_uint32 m_chipId; // for debug
-      static std::mutex m_bufMutex;
-
-   protected:
-      virtual void run();
-
-   };
-
-   class LsFitPatchProcessorJob : public PatchProcessorJob
-   {
-   public:
-      LsFitPatchProcessorJob(ossimHlzTool* hlzUtil, const ossimIpt& origin, ossim_uint32 chip_id=0)
-         : PatchProcessorJob(hlzUtil, origin, chip_id),
-           m_plane (new ossimLeastSquaresPlane) {}
-
-      ~LsFitPatchProcessorJob() { delete m_plane; }
-      virtual bool level1Test();
-      ossimLeastSquaresPlane* m_plane;
-   };
-
-   class NormPatchProcessorJob : public PatchProcessorJob
-   {
-   public:
-      NormPatchProcessorJob(ossimHlzTool* hlzUtil, const ossimIpt& origin, ossim_uint32 chip_id=0)
-         : PatchProcessorJob(hlzUtil, origin, chip_id) {}
-
-      virtual bool level1Test();
-   };
-
 };
 
 #endif
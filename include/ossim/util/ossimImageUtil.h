@@ -168,6 +168,8 @@ public:
     * Available types depends on plugins.  Known types:
     * ossim_tiff_box ( defualt )
     * ossim_tiff_nearest
+    * ossim_tiff_lanczos
+    * ossim_tiff_mode
     * ossim_kakadu_nitf_j2k ( kakadu plugin )
     * gdal_tiff_nearest	    ( gdal plugin )
     * gdal_tiff_average	    ( gdal plugin )
@@ -21,7 +21,9 @@
 #include <ossim/base/ossimRefPtr.h>
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/util/ossimTool.h>
+#include <istream>
 #include <ostream>
+#include <string>
 
 class ossimGpt;
 
@@ -84,6 +86,32 @@ public:
     */
    ossim_uint32 executeImageOptions(const ossimFilename& file);
 
+   /**
+    * @brief Batch mode, i.e. ossim-info --batch.
+    *
+    * Reads image files, one a line, from in and writes the getImageRecord of
+    * each, one a line, to out. Files are read concurrently on the "threads"
+    * option's threads, default all cores, each on a handler of its own, so
+    * records come out in the order files finish.
+    *
+    * @return Number of files that could not be read.
+    */
+   ossim_uint64 executeBatch(std::istream& in, std::ostream& out);
+
+   /**
+    * @brief Gets what the image options ask for, i.e. -i -p -m -d --dno
+    * --palette, -i -p if none, less the "skip" option's items, as a one line
+    * JSON object with a "file" member. Keywords nest on their dots down to
+    * the "max_depth" option's levels.
+    *
+    * Thread safe.
+    *
+    * @param file Image file to get information for.
+    * @return JSON record.
+    * @note Throws ossimException if file cannot be opened.
+    */
+   std::string getImageRecord(const ossimFilename& file) const;
+
    /**
     * @brief getImageInfo Method to open image "file" and get image info
     * in the form of a ossimKeywordlist.
@@ -801,6 +829,16 @@ private:
    /** @return true if key is set to true; false, if not. */
    bool keyIsTrue( const std::string& key ) const;
 
+   /** @return true if item is in the "skip" option's comma separated list. */
+   bool isSkipped( const std::string& item ) const;
+
+   /**
+    * @brief Runs executeBatch on the files listed in list, standard in if
+    * "-", to the output file if one was given; else, standard out.
+    * @note Throws ossimException on error.
+    */
+   void executeBatch( const ossimFilename& list );
+
    /** Holds the open image. */
    ossimRefPtr<ossimImageHandler> m_img;
 };
@@ -16,6 +16,7 @@
 #include <ossim/base/ossimIrect.h>
 #include <ossim/base/ossimArgumentParser.h>
 #include <ossim/imaging/ossimImageGeometry.h>
+#include <ossim/imaging/ossimLasReader.h>
 #include <ossim/point_cloud/ossimPointCloudHandler.h>
 #include <ossim/point_cloud/ossimPointCloudUtilityFilter.h>
 
@@ -47,10 +48,19 @@ protected:
    bool loadPC();
    bool loadDem();
 
+   /**
+    * Returns a copy of the highest or lowest point elevation tile from whichever source is open,
+    * so both can be held at once.
+    */
+   ossimRefPtr<ossimImageData> getElevationTile(bool highest,
+                                                const ossimIrect& rect,
+                                                ossim_uint32 resLevel);
+
    enum Operation { HIGHEST_DEM, LOWEST_DEM, HIGHEST_LOWEST } m_operation;
    ossimRefPtr<ossimImageGeometry> m_prodGeom;
    ossimRefPtr<ossimPointCloudHandler> m_pcHandler;
    ossimRefPtr<ossimPointCloudImageHandler> m_pciHandler;
+   ossimRefPtr<ossimLasReader> m_lasReader; // LAS input is gridded by streaming, not via m_pcHandler
    ossimRefPtr<ossimPointCloudUtilityFilter> m_pcuFilter;
    double m_gsd;
    ossimFilename m_lutFile;
@@ -0,0 +1,77 @@
+//**************************************************************************************************
+//
+//     OSSIM Open Source Geospatial Data Processing Library
+//     See top level LICENSE.txt file for license information
+//
+//**************************************************************************************************
+#ifndef ossimViewshedSweep_HEADER
+#define ossimViewshedSweep_HEADER 1
+
+#include <ossim/base/ossimConstants.h>
+#include <ossim/base/ossimDpt.h>
+#include <ossim/base/ossimIpt.h>
+#include <vector>
+
+/***************************************************************************************************
+ * XDraw line-of-sight sweep over an elevation grid in memory, the default algorithm of
+ * ossimViewshedTool.
+ *
+ * Cells are visited in square rings of growing size around the observer. The horizon of a cell,
+ * the steepest elevation angle between it and the observer, is interpolated from the two cells of
+ * the previous ring its line of sight passes between, so each cell is visited once and the
+ * horizon of the cells near the observer is shared by every line of sight going out through them,
+ * where marching radials walks them again for each radial. The interpolation makes it an
+ * approximation of the exact (R3) viewshed, off by a few cells along the edges of hidden areas.
+ *
+ * The grid is only read, so one sweep can run observers in as many threads as there are bitmap
+ * and horizon buffers.
+ **************************************************************************************************/
+class OSSIM_DLL ossimViewshedSweep
+{
+public:
+   ossimViewshedSweep();
+
+   /**
+    * Sets the grid, width x height heights in meters, NaN where null. Not copied, it must outlive
+    * the calls to compute(). The gsd is meters per pixel in x and y.
+    */
+   void setElevations(const ossim_float32* heights, ossim_uint32 width, ossim_uint32 height,
+                      const ossimDpt& gsd);
+
+   /**
+    * Limits the viewshed to radius pixels from the observer and paints the circle at the radius
+    * with the overlay value. Zero, the default, sweeps the whole grid.
+    */
+   void setRadius(double radius);
+
+   /** Field of view azimuths in degrees, clockwise from start to stop. Equal for all around. */
+   void setFov(double start, double stop);
+
+   /** Values written for visible and hidden cells and the circle at the radius. */
+   void setCoding(ossim_uint8 visible, ossim_uint8 hidden, ossim_uint8 overlay);
+
+   /**
+    * Computes the viewshed of an observer at a cell of the grid, with an eye at height meters,
+    * into bitmap (width x height). Cells with no height, out of the field of view or outside the
+    * radius are left as they are. The horizon buffer is sized as needed. Nothing is done for an
+    * observer outside the grid.
+    */
+   void compute(const ossimIpt& observer, double height, ossim_uint8* bitmap,
+                std::vector<ossim_float32>& horizon) const;
+
+private:
+   bool inFov(ossim_int32 dx, ossim_int32 dy) const;
+
+   const ossim_float32* m_heights;
+   ossim_int32   m_width;
+   ossim_int32   m_height;
+   ossimDpt      m_gsd;
+   double        m_radius;
+   double        m_startFov;
+   double        m_stopFov;
+   ossim_uint8   m_visibleValue;
+   ossim_uint8   m_hiddenValue;
+   ossim_uint8   m_overlayValue;
+};
+
+#endif /* #ifndef ossimViewshedSweep_HEADER */
@@ -14,6 +14,7 @@
 #include <ossim/parallel/ossimJobMultiThreadQueue.h>
 #include <ossim/util/ossimChipProcTool.h>
 #include <mutex>
+#include <vector>
 /*!
  *  Class for computing the viewshed on a DEM given the viewer location and max range of visibility
  */
@@ -75,6 +76,23 @@ protected:
       bool insideAoi;
    };
 
+   enum Algorithm
+   {
+      XDRAW_ALGORITHM,  //!< One sweep of the DEM chip in memory, see ossimViewshedSweep.
+      RADIAL_ALGORITHM  //!< Marches each radial separately through the elevation manager, default.
+   };
+
+   /** One observer of a --observers batch. */
+   class Observer
+   {
+   public:
+      Observer() : heightOfEye(0) {}
+
+      ossimGpt gpt; // hgt is of the eye once the chain is initialized
+      ossimDpt vpt;
+      double heightOfEye;
+   };
+
    virtual void initProcessingChain();
    virtual void initializeProjectionGsd();
    virtual void initializeAOI();
@@ -84,6 +102,13 @@ protected:
    void computeRadius();
    bool optimizeFOV();
    bool computeViewshed(); // assigns m_outBuffer with single-band viewshed image
+   bool computeSweepViewshed();
+   bool readObserversFile();
+   ossimIrect getVisibilityRect() const;
+   void loadElevations(const ossimIrect& rect, std::vector<ossim_float32>& heights) const;
+   void paintReticle(ossimImageData* buffer, const ossimDpt& observerVpt);
+   ossimFilename getObserverFilename(ossim_uint32 index) const;
+   void writeObserverBitmap(ossimImageData* bitmap, const ossimFilename& filename);
 
    ossimGpt  m_observerGpt;
    ossimDpt  m_observerVpt;
@@ -107,6 +132,9 @@ protected:
    bool m_threadBySector;
    ossimFilename m_horizonFile;
    std::map<double, double> m_horizonMap;
+   Algorithm m_algorithm;
+   ossimFilename m_observersFile;
+   std::vector<Observer> m_observers; // Batch mode when not empty, m_outBuffer holds counts
 
    // For debugging:
    double d_accumT;
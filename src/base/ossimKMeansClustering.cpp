@@ -6,24 +6,49 @@
 //**************************************************************************************************
 
 #include <ossim/base/ossimKMeansClustering.h>
+#include <ossim/parallel/ossimParallelFor.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <random>
 
 using namespace std;
 
+namespace
+{
+   // Samples per reduction block. Fixed so partial sums are formed and merged in the same order
+   // whatever the thread count:
+   const ossim_uint32 BLOCK_SAMPLES = 16384;
+
+   inline ossim_uint32 blockCount(ossim_uint32 n)
+   {
+      return std::max<ossim_uint32>(1, n/BLOCK_SAMPLES + ((n % BLOCK_SAMPLES) ? 1 : 0));
+   }
+
+   inline ossim_uint32 blockEnd(ossim_uint32 n, ossim_uint32 b)
+   {
+      return (ossim_uint32) std::min<ossim_uint64>(n, (ossim_uint64) (b + 1)*BLOCK_SAMPLES);
+   }
+}
+
 ossimKMeansClustering::ossimKMeansClustering()
 :  m_numEntries(0),
    m_samples(0),
    m_populations(0),
    m_clustersValid(false),
-   m_verbose(false)
+   m_verbose(false),
+   m_numDims(1),
+   m_batchSize(0),
+   m_maxIterations(20),
+   m_numThreads(0)
 {
 
 }
 
 ossimKMeansClustering::~ossimKMeansClustering()
 {
-   delete m_samples;
-   delete m_populations;
+   delete [] m_samples;
+   delete [] m_populations;
    m_clusters.clear();
 }
 
@@ -31,6 +56,8 @@ void ossimKMeansClustering::setNumClusters(ossim_uint32 K)
 {
    m_clusters.clear();
    m_clusters.resize(K);
+   m_centroids.clear();
+   m_centroidsT.clear();
    m_clustersValid = false;
 }
 
@@ -50,6 +77,9 @@ bool ossimKMeansClustering::computeKmeans()
          m_populations[i] = 1.0;
    }
 
+   if (m_numDims > 1)
+      return computeMultivariate();
+
    // Scan for min and max:
    double overall_min = OSSIM_DEFAULT_MAX_PIX_DOUBLE;
    double overall_max = OSSIM_DEFAULT_MIN_PIX_DOUBLE;
@@ -192,9 +222,357 @@ bool ossimKMeansClustering::computeKmeans()
 
    delete [] variances;
    delete [] priorCounts;
+
+   // Scalar centroids for classify():
+   for (ossim_uint32 gid=0; gid<numClusters; ++gid)
+      setCentroid(gid, &m_clusters[gid].mean);
+
+   m_clustersValid = true;
+   return true;
+
+}
+
+ossim_uint32 ossimKMeansClustering::getThreadCount() const
+{
+   return m_numThreads ? m_numThreads : ossim::getNumberOfThreads();
+}
+
+void ossimKMeansClustering::setCentroid(ossim_uint32 gid, const double* value)
+{
+   const ossim_uint32 K = (ossim_uint32) m_clusters.size();
+   if (m_centroids.size() != (size_t) K * m_numDims)
+   {
+      m_centroids.assign((size_t) K * m_numDims, 0.0);
+      m_centroidsT.assign((size_t) K * m_numDims, 0.0);
+   }
+   for (ossim_uint32 d=0; d<m_numDims; ++d)
+   {
+      m_centroids[gid*m_numDims + d] = value[d];
+      m_centroidsT[d*K + gid] = value[d];
+   }
+}
+
+ossim_uint32 ossimKMeansClustering::nearest(const double* sample, double* distances) const
+{
+   // Band by band over all centroids at once, the inner loop is contiguous:
+   const ossim_uint32 K = (ossim_uint32) m_clusters.size();
+   const double* c = &m_centroidsT.front();
+   std::fill(distances, distances + K, 0.0);
+   for (ossim_uint32 d=0; d<m_numDims; ++d, c += K)
+   {
+      const double x = sample[d];
+      for (ossim_uint32 gid=0; gid<K; ++gid)
+      {
+         const double t = x - c[gid];
+         distances[gid] += t*t;
+      }
+   }
+
+   ossim_uint32 best = 0;
+   for (ossim_uint32 gid=1; gid<K; ++gid)
+   {
+      if (distances[gid] < distances[best])
+         best = gid;
+   }
+   return best;
+}
+
+void ossimKMeansClustering::seedCentroids()
+{
+   // k-means++: each new centroid is a sample drawn with probability proportional to its
+   // (population weighted) squared distance from the nearest centroid so far. Fixed seed so runs
+   // repeat.
+   const ossim_uint32 K = (ossim_uint32) m_clusters.size();
+   const ossim_uint32 N = m_numEntries;
+   const ossim_uint32 D = m_numDims;
+   std::mt19937 rng (1);
+   std::vector<double> d2 (N, OSSIM_DEFAULT_MAX_PIX_DOUBLE);
+
+   double total = 0.0;
+   for (ossim_uint32 i=0; i<N; ++i)
+      total += m_populations[i];
+
+   ossim_uint32 pick = 0;
+   for (ossim_uint32 gid=0; gid<K; ++gid)
+   {
+      if (total > 0.0)
+      {
+         double r = std::uniform_real_distribution<double>(0.0, total)(rng);
+         ossim_uint32 i = 0;
+         for (; i<N-1; ++i)
+         {
+            r -= (gid ? d2[i] : 1.0) * m_populations[i];
+            if (r < 0.0)
+               break;
+         }
+         pick = i;
+      }
+      // else every sample sits on a centroid already, repeat the last pick.
+      setCentroid(gid, m_samples + (size_t) pick*D);
+
+      if (gid + 1 == K)
+         break;
+
+      // Distances to the new centroid:
+      const double* c = m_samples + (size_t) pick*D;
+      const ossim_uint32 blocks = blockCount(N);
+      std::vector<double> partial (blocks, 0.0);
+      ossim::parallelFor(blocks, getThreadCount(), [&](ossim_uint32 b)
+      {
+         ossim_uint32 end = blockEnd(N, b);
+         double sum = 0.0;
+         for (ossim_uint32 i=b*BLOCK_SAMPLES; i<end; ++i)
+         {
+            const double* x = m_samples + (size_t) i*D;
+            double dist = 0.0;
+            for (ossim_uint32 d=0; d<D; ++d)
+               dist += (x[d] - c[d])*(x[d] - c[d]);
+            if (dist < d2[i])
+               d2[i] = dist;
+            sum += d2[i]*m_populations[i];
+         }
+         partial[b] = sum;
+      });
+      total = 0.0;
+      for (ossim_uint32 b=0; b<blocks; ++b)
+         total += partial[b];
+   }
+}
+
+bool ossimKMeansClustering::computeMultivariate()
+{
+   const ossim_uint32 K = (ossim_uint32) m_clusters.size();
+   const ossim_uint32 N = m_numEntries;
+   const ossim_uint32 D = m_numDims;
+   if (K == 0)
+      return false;
+
+   seedCentroids();
+
+   // Blocks of BLOCK_SAMPLES samples. Each block has its own accumulators, merged in block order
+   // so the result does not depend on the thread count:
+   const ossim_uint32 threads = getThreadCount();
+   const ossim_uint32 blocks = blockCount(N);
+   std::vector< std::vector<double> > sums (blocks);
+   std::vector< std::vector<double> > counts (blocks);
+   std::vector<ossim_uint32> changes (blocks);
+   std::vector<ossim_uint32> labels (N, K);
+   ossim_uint32 iters = 0;
+
+   if (m_batchSize == 0)
+   {
+      // Lloyd iterations:
+      bool converged = false;
+      while (!converged && (iters < m_maxIterations))
+      {
+         ++iters;
+         ossim::parallelFor(blocks, threads, [&](ossim_uint32 b)
+         {
+            std::vector<double>& sum = sums[b];
+            std::vector<double>& count = counts[b];
+            sum.assign((size_t) K*D, 0.0);
+            count.assign(K, 0.0);
+            changes[b] = 0;
+            std::vector<double> distances (K);
+            ossim_uint32 end = blockEnd(N, b);
+            for (ossim_uint32 i=b*BLOCK_SAMPLES; i<end; ++i)
+            {
+               const double w = m_populations[i];
+               if (w == 0)
+                  continue;
+               const double* x = m_samples + (size_t) i*D;
+               ossim_uint32 gid = nearest(x, &distances.front());
+               if (gid != labels[i])
+               {
+                  labels[i] = gid;
+                  ++changes[b];
+               }
+               count[gid] += w;
+               double* s = &sum[(size_t) gid*D];
+               for (ossim_uint32 d=0; d<D; ++d)
+                  s[d] += w*x[d];
+            }
+         });
+
+         converged = true;
+         for (ossim_uint32 b=1; b<blocks; ++b)
+         {
+            for (size_t j=0; j<sums[0].size(); ++j)
+               sums[0][j] += sums[b][j];
+            for (ossim_uint32 gid=0; gid<K; ++gid)
+               counts[0][gid] += counts[b][gid];
+         }
+         for (ossim_uint32 b=0; b<blocks; ++b)
+         {
+            if (changes[b])
+               converged = false;
+         }
+
+         // Empty clusters keep their centroid:
+         std::vector<double> centroid (D);
+         for (ossim_uint32 gid=0; gid<K; ++gid)
+         {
+            if (counts[0][gid] == 0)
+               continue;
+            for (ossim_uint32 d=0; d<D; ++d)
+               centroid[d] = sums[0][(size_t) gid*D + d] / counts[0][gid];
+            setCentroid(gid, &centroid.front());
+         }
+      }
+   }
+   else
+   {
+      // Mini-batch: each centroid moves toward the batch samples nearest it by the sample's
+      // share of all the samples it has seen so far.
+      const ossim_uint32 batch = std::min(m_batchSize, N);
+      const ossim_uint32 batchBlocks = blockCount(batch);
+      std::mt19937 rng (2);
+      std::uniform_int_distribution<ossim_uint32> uniform (0, N - 1);
+      std::vector<ossim_uint32> picks (batch);
+      std::vector<ossim_uint32> batchLabels (batch);
+      std::vector<double> seen (K, 0.0);
+      std::vector<double> centroid (D);
+      for (iters=1; iters<=m_maxIterations; ++iters)
+      {
+         for (ossim_uint32 j=0; j<batch; ++j)
+            picks[j] = uniform(rng);
+
+         ossim::parallelFor(batchBlocks, threads, [&](ossim_uint32 b)
+         {
+            std::vector<double> distances (K);
+            ossim_uint32 end = blockEnd(batch, b);
+            for (ossim_uint32 j=b*BLOCK_SAMPLES; j<end; ++j)
+               batchLabels[j] = nearest(m_samples + (size_t) picks[j]*D, &distances.front());
+         });
+
+         for (ossim_uint32 j=0; j<batch; ++j)
+         {
+            const double w = m_populations[picks[j]];
+            if (w == 0)
+               continue;
+            const ossim_uint32 gid = batchLabels[j];
+            const double* x = m_samples + (size_t) picks[j]*D;
+            const double* c = &m_centroids[(size_t) gid*D];
+            seen[gid] += w;
+            const double eta = w / seen[gid];
+            for (ossim_uint32 d=0; d<D; ++d)
+               centroid[d] = c[d] + eta*(x[d] - c[d]);
+            setCentroid(gid, &centroid.front());
+         }
+      }
+      --iters;
+   }
+
+   // Final assignment for the cluster statistics. Mean, min and max are those of the first band,
+   // sigma is the RMS distance of the members to the centroid:
+   std::vector< std::vector<double> > mins (blocks);
+   std::vector< std::vector<double> > maxs (blocks);
+   ossim::parallelFor(blocks, threads, [&](ossim_uint32 b)
+   {
+      std::vector<double>& sumSq = sums[b];
+      std::vector<double>& count = counts[b];
+      sumSq.assign(K, 0.0);
+      count.assign(K, 0.0);
+      mins[b].assign(K, OSSIM_DEFAULT_MAX_PIX_DOUBLE);
+      maxs[b].assign(K, OSSIM_DEFAULT_MIN_PIX_DOUBLE);
+      std::vector<double> distances (K);
+      ossim_uint32 end = blockEnd(N, b);
+      for (ossim_uint32 i=b*BLOCK_SAMPLES; i<end; ++i)
+      {
+         const double w = m_populations[i];
+         if (w == 0)
+            continue;
+         const double* x = m_samples + (size_t) i*D;
+         ossim_uint32 gid = nearest(x, &distances.front());
+         count[gid] += w;
+         sumSq[gid] += w*distances[gid];
+         mins[b][gid] = std::min(mins[b][gid], x[0]);
+         maxs[b][gid] = std::max(maxs[b][gid], x[0]);
+      }
+   });
+
+   for (ossim_uint32 gid=0; gid<K; ++gid)
+   {
+      Cluster& cluster = m_clusters[gid];
+      double sumSq = 0.0;
+      cluster.n = 0;
+      cluster.min = OSSIM_DEFAULT_MAX_PIX_DOUBLE;
+      cluster.max = OSSIM_DEFAULT_MIN_PIX_DOUBLE;
+      for (ossim_uint32 b=0; b<blocks; ++b)
+      {
+         cluster.n += counts[b][gid];
+         sumSq += sums[b][gid];
+         cluster.min = std::min(cluster.min, mins[b][gid]);
+         cluster.max = std::max(cluster.max, maxs[b][gid]);
+      }
+      cluster.mean = m_centroids[(size_t) gid*D];
+      cluster.new_mean = cluster.mean;
+      cluster.sigma = cluster.n ? sqrt(sumSq / cluster.n) : 0.0;
+   }
+
+   if (m_verbose)
+   {
+      cout<<"\nossimKMeansClustering Summary ("<<iters<<(m_batchSize ? " batches, " : " iterations, ")
+          <<D<<" bands):"<<endl;
+      for (ossim_uint32 gid=0; gid<K; gid++)
+      {
+         cout<<"\n  cluster["<<gid<<"] n        = "<<(ossim_uint64)m_clusters[gid].n<<endl;
+         cout<<"             centroid =";
+         for (ossim_uint32 d=0; d<D; ++d)
+            cout<<" "<<m_centroids[(size_t) gid*D + d];
+         cout<<"\n             sigma    = "<<m_clusters[gid].sigma<<endl;
+      }
+      cout << endl;
+   }
+
    m_clustersValid = true;
    return true;
+}
 
+void ossimKMeansClustering::setClusters(const std::vector<Cluster>& clusters,
+                                        const double* centroids,
+                                        ossim_uint32 num_dims)
+{
+   m_clusters = clusters;
+   m_numDims = num_dims ? num_dims : 1;
+   m_centroids.clear();
+   m_centroidsT.clear();
+   for (ossim_uint32 gid=0; centroids && (gid<m_clusters.size()); ++gid)
+      setCentroid(gid, centroids + (size_t) gid*m_numDims);
+   m_clustersValid = !m_centroids.empty();
+}
+
+const double* ossimKMeansClustering::getCentroid(ossim_uint32 groupId) const
+{
+   if ((groupId >= m_clusters.size()) || m_centroids.empty())
+      return 0;
+   return &m_centroids[(size_t) groupId*m_numDims];
+}
+
+ossim_uint32 ossimKMeansClustering::classify(const double* sample) const
+{
+   if (m_centroidsT.empty())
+      return 0;
+   std::vector<double> distances (m_clusters.size());
+   return nearest(sample, &distances.front());
+}
+
+void ossimKMeansClustering::classify(const double* samples,
+                                     ossim_uint32 count,
+                                     ossim_uint32* groupIds) const
+{
+   if (m_centroidsT.empty() || !count)
+      return;
+
+   const ossim_uint32 threads = getThreadCount();
+   const ossim_uint32 blocks = blockCount(count);
+   ossim::parallelFor(blocks, threads, [&](ossim_uint32 b)
+   {
+      std::vector<double> distances (m_clusters.size());
+      ossim_uint32 end = blockEnd(count, b);
+      for (ossim_uint32 i=b*BLOCK_SAMPLES; i<end; ++i)
+         groupIds[i] = nearest(samples + (size_t) i*m_numDims, &distances.front());
+   });
 }
 
 double ossimKMeansClustering::getMean(ossim_uint32 clusterId) const
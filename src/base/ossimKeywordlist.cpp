@@ -737,8 +737,34 @@ bool ossimKeywordlist::parseFile(const ossimFilename& file,
    if ( is )
    {
       m_currentlyParsing = file;
-      result = parseStream(*is, ignoreBinaryChars);
+
+      //---
+      // Pull the file into memory with block reads and parse from there.
+      // The parser fails at the first byte that isn't valid keyword list
+      // text, so stop reading there rather than pull in all of, say, an
+      // image handed to addFile.
+      //---
+      std::string buffer;
+      char chunk[65536];
+      bool badByte = false;
+      while ( !badByte && ( is->read( chunk, sizeof(chunk) ) || is->gcount() ) )
+      {
+         const char* end = chunk + is->gcount();
+         const char* pos = chunk;
+         while ( ( pos < end ) && isValidKeywordlistCharacter( (ossim_uint8)*pos ) )
+         {
+            ++pos;
+         }
+         if ( pos < end )
+         {
+            badByte = true;
+            ++pos; // Keep it so the parse still ends there.
+         }
+         buffer.append( chunk, static_cast<std::string::size_type>( pos - chunk ) );
+      }
       is.reset();
+
+      result = parseBuffer( buffer.data(), buffer.size() );
    }
    
    return result;
@@ -751,9 +777,7 @@ bool ossimKeywordlist::parseStream(ossim::istream& is, bool /* ignoreBinaryChars
 
 bool ossimKeywordlist::parseString(const std::string& inString)
 {
-   ossim::istringstream in(inString);
-   
-   return parseStream(in);
+   return parseBuffer( inString.data(), inString.size() );
 }
 
 bool ossimKeywordlist::isValidKeywordlistCharacter(ossim_uint8 c)const
@@ -830,36 +854,41 @@ ossimKeywordlist::readPreprocDirective(ossim::istream& in)
       if (status)
          break;
 
-      ossimString directive = sequence.before(" ");
+      processPreprocDirective(sequence);
 
-      // Check for external KWL include file:
-      if (directive == "#include")
-      {
-         ossimFilename includeFile = sequence.after(" ");
-         if (includeFile.empty())
-            break; // ignore bogus preproc line
-         includeFile.trim("\"");
-         includeFile.expandEnvironmentVariable();
+      status = KeywordlistParseState_OK;
+      break;
+   }
+   return status;
+}
 
-         // The filename can be either relative to the current file being parsed or absolute:
-         if (includeFile.string()[0] != '/')
-            includeFile = m_currentlyParsing.path() + "/" + includeFile;
+void ossimKeywordlist::processPreprocDirective(const ossimString& sequence)
+{
+   ossimString directive = sequence.before(" ");
 
-         // Save the current path in case the new one contains it's own include directive!
-         ossimFilename savedCurrentPath = m_currentlyParsing;
-         addFile(includeFile); // Quietly ignore any errors loading external KWL.
-         m_currentlyParsing = savedCurrentPath;
-      }
+   // Check for external KWL include file:
+   if (directive == "#include")
+   {
+      ossimFilename includeFile = sequence.after(" ");
+      if (includeFile.empty())
+         return; // ignore bogus preproc line
+      includeFile.trim("\"");
+      includeFile.expandEnvironmentVariable();
 
-//      else if (directive == "#add_new_directive_here")
-//      {
-//         process directive
-//      }
+      // The filename can be either relative to the current file being parsed or absolute:
+      if (includeFile.string()[0] != '/')
+         includeFile = m_currentlyParsing.path() + "/" + includeFile;
 
-      status = KeywordlistParseState_OK;
-      break;
+      // Save the current path in case the new one contains it's own include directive!
+      ossimFilename savedCurrentPath = m_currentlyParsing;
+      addFile(includeFile); // Quietly ignore any errors loading external KWL.
+      m_currentlyParsing = savedCurrentPath;
    }
-   return status;
+
+//   else if (directive == "#add_new_directive_here")
+//   {
+//      process directive
+//   }
 }
 
 ossimKeywordlist::KeywordlistParseState ossimKeywordlist::readKey(ossimString& sequence, ossim::istream& in)const
@@ -1085,6 +1114,301 @@ bool ossimKeywordlist::parseStream(ossim::istream& is)
    return true;
 }
 
+//---
+// Buffer parsing.  The methods below follow the stream versions above rule for
+// rule (including their handling of end of input), they just scan pointers and
+// append whole runs of characters.  Keep the two in sync.
+//---
+
+namespace
+{
+   const std::string TRIM_CHARS = " \t\n\r";
+   const std::string TRIPLE_QUOTE = "\"\"\"";
+
+   // Same result as ossimString::trim() with default arguments.
+   void trimInPlace( std::string& s )
+   {
+      std::string::size_type startPos = s.find_first_not_of( TRIM_CHARS );
+      if ( startPos == std::string::npos )
+      {
+         s.clear();
+      }
+      else
+      {
+         std::string::size_type stopPos = s.find_last_not_of( TRIM_CHARS );
+         if ( ( startPos != 0 ) || ( stopPos != s.size()-1 ) )
+         {
+            s = s.substr( startPos, stopPos-startPos+1 );
+         }
+      }
+   }
+}
+
+ossimKeywordlist::KeywordlistParseState ossimKeywordlist::readKey(
+   std::string& sequence, const char*& pos, const char* end)const
+{
+   KeywordlistParseState result = KeywordlistParseState_FAIL;
+   if(!sequence.empty())
+   {
+      if(sequence[sequence.size()-1] == m_delimiter)
+      {
+         sequence.erase(sequence.size()-1);
+         return KeywordlistParseState_OK;
+      }
+   }
+
+   // Take the run of plain key characters in one append.
+   const char* runStart = pos;
+   while ( pos < end )
+   {
+      ossim_uint8 c = (ossim_uint8)*pos;
+      if ( (c == (ossim_uint8)m_delimiter) || (c == '\n') || (c == '\r') ||
+           !isValidKeywordlistCharacter(c) )
+      {
+         break;
+      }
+      ++pos;
+   }
+   sequence.append( runStart, pos );
+
+   if ( pos == end )
+   {
+      // Stream version gets EOF here which is not a valid character.
+      result = KeywordlistParseState_BAD_STREAM;
+   }
+   else
+   {
+      ossim_uint8 c = (ossim_uint8)*pos++;
+      if ( !isValidKeywordlistCharacter(c) )
+      {
+         // mal formed input stream for keyword list specification
+         result = KeywordlistParseState_BAD_STREAM;
+      }
+      else if ( (c == '\n') || (c == '\r') )
+      {
+         // Hit end of line with no delimiter.
+         if ( pos == end )
+         {
+            //---
+            // Allowing on last line only.
+            // Note the empty key will trigger parseBuffer to return true.
+            //---
+            sequence.clear();
+            result = KeywordlistParseState_OK;
+         }
+         else // Line with no delimiter.
+         {
+            // mal formed input stream for keyword list specification
+            result = KeywordlistParseState_BAD_STREAM;
+         }
+      }
+      else // at m_delimiter
+      {
+         result = KeywordlistParseState_OK;
+         trimInPlace( sequence );
+      }
+   }
+
+   // we never found a delimeter so we are mal formed
+   if(!sequence.empty()&&(result!=KeywordlistParseState_OK))
+   {
+      result = KeywordlistParseState_BAD_STREAM;
+   }
+   return result;
+}
+
+ossimKeywordlist::KeywordlistParseState ossimKeywordlist::readValue(
+   std::string& sequence, const char*& pos, const char* end)const
+{
+   KeywordlistParseState result = KeywordlistParseState_OK;
+   
+   ossim_int32 quoteCount = 0; // mark as not set
+   
+   // make sure we check for a blank value
+   while ( pos < end )
+   {
+      if ( (*pos == ' ') || (*pos == '\t') )
+      {
+         ++pos;
+      }
+      else if ( (*pos == '\n') || (*pos == '\r') )
+      {
+         ++pos;
+         return result;
+      }
+      else
+      {
+         break;
+      }
+   }
+
+   while ( pos < end )
+   {
+      //---
+      // Once three characters are in without a leading tripple quote,
+      // quoteCount can never change, so take the rest of the line in one
+      // append.
+      //---
+      if ( ( quoteCount == 0 ) && ( sequence.size() > 2 ) )
+      {
+         const char* runStart = pos;
+         while ( ( pos < end ) && ( *pos != '\n' ) && ( *pos != '\r' ) &&
+                 isValidKeywordlistCharacter( (ossim_uint8)*pos ) )
+         {
+            ++pos;
+         }
+         sequence.append( runStart, pos );
+         if ( pos < end )
+         {
+            if ( !isValidKeywordlistCharacter( (ossim_uint8)*pos ) )
+            {
+               result = KeywordlistParseState_BAD_STREAM;
+            }
+            ++pos; // Consume line break or bad character.
+         }
+         break;
+      }
+
+      ossim_uint8 c = (ossim_uint8)*pos++;
+      if(isValidKeywordlistCharacter(c))
+      {
+         if((c == '\n'||c=='\r') && !quoteCount)
+         {
+            break;
+         }
+         sequence += (char)c;
+         if(sequence.size() >2)
+         {
+            if(quoteCount < 1)
+            {
+               //---
+               // If string has leading tripple quoted bump the "quoteCount" so
+               // we start skipping line breaks, preserving paragraph style strings.
+               //---
+               if(sequence.compare(0, 3, TRIPLE_QUOTE) == 0)
+               {
+                  ++quoteCount;
+               }
+            }
+            else // check for ending quotes 
+            {
+               if(sequence.compare(sequence.size()-3, 3, TRIPLE_QUOTE) == 0)
+               {
+                  ++quoteCount;
+               }
+            }
+         }
+         if(quoteCount > 1)
+         {
+            //---
+            // Have leading and trailing tripple quotes. Some tiff writers, e.g. Space
+            // Imaging are using four quotes.  Below code strips all quotes from each end.
+            //---
+            char quote = '"';
+            std::string::size_type startPos = sequence.find_first_not_of(quote);
+            std::string::size_type stopPos  = sequence.find_last_not_of(quote);
+            if ( ( startPos != std::string::npos ) && (stopPos != std::string::npos) )
+            {
+               sequence = sequence.substr( startPos, stopPos-startPos+1 );
+            }
+            break;
+         }
+      }
+      else 
+      {
+         result = KeywordlistParseState_BAD_STREAM;
+         break;
+      }
+   }
+   return result;
+}
+
+bool ossimKeywordlist::parseBuffer(const char* buffer, std::size_t size)
+{
+   if ( !buffer && size )
+   {
+      return false;
+   }
+
+   const char* pos = buffer;
+   const char* end = buffer + size;
+
+   std::string key;
+   std::string value;
+   while ( true )
+   {
+      // Skip white space:
+      while ( ( pos < end ) &&
+              ( (*pos == ' ') || (*pos == '\t') || (*pos == '\n') || (*pos == '\r') ) )
+      {
+         ++pos;
+      }
+      if ( pos == end )
+         return true; // we skipped to end so valid keyword list
+
+      key.clear();
+      value.clear();
+
+      // Preprocessor directive:
+      if ( *pos == '#' )
+      {
+         // Read the line as one big value:
+         if ( readValue(value, pos, end) & KeywordlistParseState_BAD_STREAM )
+            return false;
+         processPreprocDirective( ossimString(value) );
+         continue;
+      }
+
+      // Comment:
+      if ( *pos == '/' )
+      {
+         ++pos;
+         if ( ( pos < end ) && ( *pos == '/' ) )
+         {
+            while ( pos < end )
+            {
+               ossim_uint8 c = (ossim_uint8)*pos++;
+               if ( !isValidKeywordlistCharacter(c) )
+                  return false;
+               if ( (c == '\n') || (c == '\r') )
+                  break;
+            }
+            continue;
+         }
+
+         // Single slash is the start of the key.
+         key = "/";
+      }
+
+      // Key value pair:
+      KeywordlistParseState keyState = readKey(key, pos, end);
+      if ( keyState & KeywordlistParseState_BAD_STREAM )
+         return false;
+      KeywordlistParseState valueState = readValue(value, pos, end);
+      int state = static_cast<int>(keyState) | static_cast<int>(valueState);
+      if ( state == KeywordlistParseState_OK )
+      {
+         trimInPlace( key );
+         if ( key.empty() )
+            return true;
+
+         if ( ( m_expandEnvVars == true ) && ( value.find("$(") != std::string::npos ) )
+         {
+            value = ossimString(value).expandEnvironmentVariable().string();
+         }
+
+         // Files are usually written in key order so hint at the end.
+         m_map.insert( m_map.end(), std::make_pair(key, value) );
+      }
+      else if ( state & KeywordlistParseState_BAD_STREAM )
+      {
+         return false;
+      }
+   }
+   
+   return true;
+}
+
 void ossimKeywordlist::getSortedList(std::vector<ossimString>& prefixValues,
                                      const ossimString &prefixKey)const
 {
@@ -0,0 +1,133 @@
+//*******************************************************************
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Summed-area tables for constant time least squares plane
+// fits over any rectangle of a grid.
+//
+//*******************************************************************
+
+#include <ossim/base/ossimPlaneFitTable.h>
+#include <cmath>
+
+ossimPlaneFitTable::ossimPlaneFitTable()
+   : m_width(0)
+{
+}
+
+void ossimPlaneFitTable::build(const double* z,
+                               const ossim_uint8* flags,
+                               ossim_uint32 width,
+                               ossim_uint32 height)
+{
+   m_width = width + 1;
+   const size_t SIZE = static_cast<size_t>(m_width) * (height + 1);
+   m_flags.assign(SIZE, 0);
+   if (z)
+   {
+      m_z.assign(SIZE, 0.0);
+      m_xz.assign(SIZE, 0.0);
+      m_yz.assign(SIZE, 0.0);
+      m_zz.assign(SIZE, 0.0);
+   }
+   else
+   {
+      m_z.clear();
+      m_xz.clear();
+      m_yz.clear();
+      m_zz.clear();
+   }
+
+   // Heights relative to their mean, so the sums stay small:
+   double zRef = 0.0;
+   if (z)
+   {
+      size_t count = 0;
+      for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i)
+      {
+         if (!flags || !flags[i])
+         {
+            zRef += z[i];
+            ++count;
+         }
+      }
+      if (count)
+         zRef /= count;
+   }
+
+   // Each entry is the sum of the cells above and to the left of it:
+   for (ossim_uint32 y = 0; y < height; ++y)
+   {
+      const size_t IN = static_cast<size_t>(y) * width;
+      const size_t ABOVE = static_cast<size_t>(y) * m_width;
+      const size_t OUT = ABOVE + m_width;
+      ossim_uint32 flagged = 0;
+      double sz = 0.0;
+      double sxz = 0.0;
+      double syz = 0.0;
+      double szz = 0.0;
+      for (ossim_uint32 x = 0; x < width; ++x)
+      {
+         if (flags && flags[IN + x])
+         {
+            ++flagged;
+         }
+         else if (z)
+         {
+            const double DZ = z[IN + x] - zRef;
+            sz  += DZ;
+            sxz += x * DZ;
+            syz += y * DZ;
+            szz += DZ * DZ;
+         }
+         m_flags[OUT + x + 1] = m_flags[ABOVE + x + 1] + flagged;
+         if (z)
+         {
+            m_z[OUT + x + 1]  = m_z[ABOVE + x + 1]  + sz;
+            m_xz[OUT + x + 1] = m_xz[ABOVE + x + 1] + sxz;
+            m_yz[OUT + x + 1] = m_yz[ABOVE + x + 1] + syz;
+            m_zz[OUT + x + 1] = m_zz[ABOVE + x + 1] + szz;
+         }
+      }
+   }
+}
+
+ossim_uint32 ossimPlaneFitTable::getFlagCount(ossim_uint32 x, ossim_uint32 y,
+                                              ossim_uint32 width, ossim_uint32 height) const
+{
+   const size_t UL = static_cast<size_t>(y) * m_width + x;
+   const size_t LL = UL + static_cast<size_t>(height) * m_width;
+   return m_flags[LL + width] - m_flags[LL] - m_flags[UL + width] + m_flags[UL];
+}
+
+double ossimPlaneFitTable::sum(const std::vector<double>& table, ossim_uint32 x, ossim_uint32 y,
+                               ossim_uint32 width, ossim_uint32 height) const
+{
+   const size_t UL = static_cast<size_t>(y) * m_width + x;
+   const size_t LL = UL + static_cast<size_t>(height) * m_width;
+   return table[LL + width] - table[LL] - table[UL + width] + table[UL];
+}
+
+bool ossimPlaneFitTable::fit(ossim_uint32 x, ossim_uint32 y, ossim_uint32 width,
+                             ossim_uint32 height, double& a, double& b, double& rms) const
+{
+   if ( m_z.empty() || (width < 2) || (height < 2) || getFlagCount(x, y, width, height) )
+      return false;
+
+   const double N = static_cast<double>(width) * height;
+   const double SZ = sum(m_z, x, y, width, height);
+
+   // Moments about the center of the rectangle, (u, v) = (x - xc, y - yc):
+   const double XC = x + 0.5 * (width - 1.0);
+   const double YC = y + 0.5 * (height - 1.0);
+   const double SUZ = sum(m_xz, x, y, width, height) - XC * SZ;
+   const double SVZ = sum(m_yz, x, y, width, height) - YC * SZ;
+   const double SUU = N * (static_cast<double>(width) * width - 1.0) / 12.0;
+   const double SVV = N * (static_cast<double>(height) * height - 1.0) / 12.0;
+
+   a = SUZ / SUU;
+   b = SVZ / SVV;
+   const double RSS = sum(m_zz, x, y, width, height) - SZ * SZ / N - SUZ * a - SVZ * b;
+   rms = (RSS > 0.0) ? std::sqrt(RSS / N) : 0.0;
+   return true;
+}
@@ -261,7 +261,8 @@ const ossimRectilinearDataObject& ossimRectilinearDataObject::operator=(
 bool ossimRectilinearDataObject::saveState(ossimKeywordlist& kwl, const char* prefix)const
 {
    ossimString byteEncoded;
-   ossim::toSimpleStringList(byteEncoded, m_dataBuffer);
+   std::vector<ossim_uint8> dataBuffer(m_dataBuffer.begin(), m_dataBuffer.end());
+   ossim::toSimpleStringList(byteEncoded, dataBuffer);
    kwl.add(prefix, "data_buffer", byteEncoded, true);
    ossim::toSimpleStringList(byteEncoded, m_spatialExtents);
    kwl.add(prefix, "spatial_extents", byteEncoded, true);
@@ -289,10 +290,12 @@ bool ossimRectilinearDataObject::loadState(const ossimKeywordlist& kwl, const ch
    }
    if(data_buffer)
    {
-      if(!ossim::toSimpleVector(m_dataBuffer, ossimString(kwl.find(prefix, "data_buffer"))))
+      std::vector<ossim_uint8> dataBuffer;
+      if(!ossim::toSimpleVector(dataBuffer, ossimString(kwl.find(prefix, "data_buffer"))))
       {
          return false;
       }
+      m_dataBuffer.assign(dataBuffer.begin(), dataBuffer.end());
    }
    if(scalar_type)
    {
@@ -0,0 +1,370 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/base/ossimTileBufferPool.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <cstdlib>
+#include <iostream>
+
+// Classes are 2^e * (1 + k/4), k = 0..3, from 4 KB up to 1 GB:
+static const int         MIN_EXPONENT = 12;
+static const int         MAX_EXPONENT = 30;
+static const int         STEPS        = 4;
+static const int         NUM_CLASSES  = (MAX_EXPONENT - MIN_EXPONENT) * STEPS + 1;
+static const std::size_t MIN_POOLED   = std::size_t(1) << MIN_EXPONENT;
+static const std::size_t MAX_POOLED   = std::size_t(1) << MAX_EXPONENT;
+
+static std::size_t classSize(int sizeClass)
+{
+   std::size_t base = std::size_t(1) << (MIN_EXPONENT + sizeClass / STEPS);
+   return base + (sizeClass % STEPS) * (base / STEPS);
+}
+
+// Per thread free lists, flushed to the global cache when the thread exits.
+struct ossimTileBufferPool::ThreadCache
+{
+   ThreadCache() : m_lists(NUM_CLASSES), m_bytes(0) {}
+   ~ThreadCache();
+
+   std::vector< std::vector<void*> > m_lists;
+   ossim_uint64                      m_bytes;
+};
+
+// Trivially destructible, still readable while other thread locals are destroyed:
+static thread_local bool threadCacheGone = false;
+
+ossimTileBufferPool::ThreadCache::~ThreadCache()
+{
+   ossimTileBufferPool* pool = ossimTileBufferPool::instance();
+   for (int c = 0; c < NUM_CLASSES; ++c)
+   {
+      if (!m_lists[c].empty())
+      {
+         pool->m_threadCachedBytes -= m_lists[c].size() * classSize(c);
+         pool->giveBack(c, &m_lists[c].front(), m_lists[c].size());
+      }
+   }
+   threadCacheGone = true;
+}
+
+ossimTileBufferPool* ossimTileBufferPool::instance()
+{
+   // Never deleted, tiles held by other statics may be freed after exit() starts.
+   static ossimTileBufferPool* pool = new ossimTileBufferPool;
+   return pool;
+}
+
+ossimTileBufferPool::ossimTileBufferPool()
+   : m_mutex(),
+     m_free(NUM_CLASSES),
+     m_cachedBytes(0),
+     m_enabled(true),
+     m_maxBytes(256 * 1024 * 1024),
+     m_threadCacheBytes(4 * 1024 * 1024),
+     m_allocations(0),
+     m_threadHits(0),
+     m_globalHits(0),
+     m_heapAllocations(0),
+     m_heapReleases(0),
+     m_bytesInUse(0),
+     m_threadCachedBytes(0),
+     m_peakBytes(0)
+{
+   ossimPreferences* prefs = ossimPreferences::instance();
+   const char* lookup = prefs->findPreference("tile_pool.enabled");
+   if (lookup)
+   {
+      m_enabled = ossimString(lookup).toBool();
+   }
+   lookup = prefs->findPreference("tile_pool.max_bytes");
+   if (lookup)
+   {
+      m_maxBytes = ossimString(lookup).toUInt64();
+   }
+   lookup = prefs->findPreference("tile_pool.thread_cache_bytes");
+   if (lookup)
+   {
+      m_threadCacheBytes = ossimString(lookup).toUInt64();
+   }
+}
+
+int ossimTileBufferPool::classOf(std::size_t bytes)
+{
+   if ((bytes < MIN_POOLED) || (bytes > MAX_POOLED))
+   {
+      return -1;
+   }
+   int e = MIN_EXPONENT;
+   while ((std::size_t(2) << e) <= bytes)
+   {
+      ++e;
+   }
+   std::size_t base = std::size_t(1) << e;
+   std::size_t step = base / STEPS;
+   int k = static_cast<int>((bytes - base + step - 1) / step);
+   return (e - MIN_EXPONENT) * STEPS + k; // k == STEPS is the next power of two.
+}
+
+std::size_t ossimTileBufferPool::getClassSize(std::size_t bytes)
+{
+   int c = classOf(bytes);
+   return (c < 0) ? bytes : classSize(c);
+}
+
+std::size_t ossimTileBufferPool::getMinimumPooledSize()
+{
+   return MIN_POOLED;
+}
+
+ossimTileBufferPool::ThreadCache* ossimTileBufferPool::threadCache()
+{
+   if (threadCacheGone)
+   {
+      return 0;
+   }
+   static thread_local ThreadCache cache;
+   return &cache;
+}
+
+void* ossimTileBufferPool::allocate(std::size_t bytes)
+{
+   int c = classOf(bytes);
+   if (c < 0)
+   {
+      return heapAllocate(bytes ? bytes : 1);
+   }
+
+   // Pooled sizes always get the full class so the buffer can be cached on return, even if the
+   // pool was disabled in between.
+   const std::size_t size = classSize(c);
+   void* p = 0;
+   ++m_allocations;
+
+   ThreadCache* cache = m_enabled ? threadCache() : 0;
+   if (cache && !cache->m_lists[c].empty())
+   {
+      p = cache->m_lists[c].back();
+      cache->m_lists[c].pop_back();
+      cache->m_bytes -= size;
+      m_threadCachedBytes -= size;
+      ++m_threadHits;
+   }
+   else if (m_enabled)
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_free[c].empty())
+      {
+         p = m_free[c].back();
+         m_free[c].pop_back();
+         m_cachedBytes -= size;
+         ++m_globalHits;
+      }
+   }
+   if (!p)
+   {
+      p = heapAllocate(size);
+   }
+   m_bytesInUse += size;
+   notePeak();
+   return p;
+}
+
+void ossimTileBufferPool::deallocate(void* p, std::size_t bytes)
+{
+   if (!p)
+   {
+      return;
+   }
+   int c = classOf(bytes);
+   if (c < 0)
+   {
+      heapRelease(p);
+      return;
+   }
+
+   const std::size_t size = classSize(c);
+   m_bytesInUse -= size;
+   if (!m_enabled)
+   {
+      heapRelease(p);
+      return;
+   }
+
+   ThreadCache* cache = threadCache();
+   if (cache && (cache->m_bytes + size <= m_threadCacheBytes))
+   {
+      cache->m_lists[c].push_back(p);
+      cache->m_bytes += size;
+      m_threadCachedBytes += size;
+   }
+   else
+   {
+      giveBack(c, &p, 1);
+   }
+}
+
+void ossimTileBufferPool::giveBack(int sizeClass, void** buffers, std::size_t count)
+{
+   const std::size_t size = classSize(sizeClass);
+   std::size_t kept = 0;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      const ossim_uint64 maxBytes = m_enabled ? ossim_uint64(m_maxBytes) : 0;
+      while ((kept < count) && (m_cachedBytes + size <= maxBytes))
+      {
+         m_free[sizeClass].push_back(buffers[kept++]);
+         m_cachedBytes += size;
+      }
+   }
+   for (std::size_t i = kept; i < count; ++i)
+   {
+      heapRelease(buffers[i]);
+   }
+}
+
+void ossimTileBufferPool::trim()
+{
+   ThreadCache* cache = threadCache();
+   std::vector<void*> released;
+   if (cache)
+   {
+      for (int c = 0; c < NUM_CLASSES; ++c)
+      {
+         released.insert(released.end(), cache->m_lists[c].begin(), cache->m_lists[c].end());
+         cache->m_lists[c].clear();
+      }
+      m_threadCachedBytes -= cache->m_bytes;
+      cache->m_bytes = 0;
+   }
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (int c = 0; c < NUM_CLASSES; ++c)
+      {
+         released.insert(released.end(), m_free[c].begin(), m_free[c].end());
+         m_free[c].clear();
+      }
+      m_cachedBytes = 0;
+   }
+   for (std::size_t i = 0; i < released.size(); ++i)
+   {
+      heapRelease(released[i]);
+   }
+}
+
+void ossimTileBufferPool::setEnabled(bool flag)
+{
+   m_enabled = flag;
+   if (!flag)
+   {
+      trim();
+   }
+}
+
+void ossimTileBufferPool::setMaxBytes(ossim_uint64 bytes)
+{
+   m_maxBytes = bytes;
+
+   // Release the biggest buffers first until under the new cap:
+   std::vector<void*> released;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (int c = NUM_CLASSES - 1; (c >= 0) && (m_cachedBytes > bytes); --c)
+      {
+         while (!m_free[c].empty() && (m_cachedBytes > bytes))
+         {
+            released.push_back(m_free[c].back());
+            m_free[c].pop_back();
+            m_cachedBytes -= classSize(c);
+         }
+      }
+   }
+   for (std::size_t i = 0; i < released.size(); ++i)
+   {
+      heapRelease(released[i]);
+   }
+}
+
+void* ossimTileBufferPool::heapAllocate(std::size_t bytes)
+{
+   void* p = std::malloc(bytes);
+   if (!p)
+   {
+      // Cached buffers may be what is in the way:
+      trim();
+      p = std::malloc(bytes);
+      if (!p)
+      {
+         throw std::bad_alloc();
+      }
+   }
+   ++m_heapAllocations;
+   return p;
+}
+
+void ossimTileBufferPool::heapRelease(void* p)
+{
+   std::free(p);
+   ++m_heapReleases;
+}
+
+void ossimTileBufferPool::notePeak()
+{
+   ossim_uint64 total = m_bytesInUse + m_cachedBytes + m_threadCachedBytes;
+   ossim_uint64 peak = m_peakBytes;
+   while ((total > peak) && !m_peakBytes.compare_exchange_weak(peak, total))
+   {
+   }
+}
+
+ossimTileBufferPool::Statistics ossimTileBufferPool::getStatistics() const
+{
+   Statistics stats;
+   stats.allocations     = m_allocations;
+   stats.threadHits      = m_threadHits;
+   stats.globalHits      = m_globalHits;
+   stats.heapAllocations = m_heapAllocations;
+   stats.heapReleases    = m_heapReleases;
+   stats.bytesInUse      = m_bytesInUse;
+   stats.bytesCached     = m_cachedBytes;
+   stats.peakBytes       = m_peakBytes;
+   return stats;
+}
+
+void ossimTileBufferPool::resetStatistics()
+{
+   m_allocations     = 0;
+   m_threadHits      = 0;
+   m_globalHits      = 0;
+   m_heapAllocations = 0;
+   m_heapReleases    = 0;
+   m_peakBytes       = m_bytesInUse + m_cachedBytes + m_threadCachedBytes;
+}
+
+std::ostream& ossimTileBufferPool::print(std::ostream& out) const
+{
+   Statistics stats = getStatistics();
+   double hitRate = stats.allocations ?
+      100.0 * (stats.threadHits + stats.globalHits) / stats.allocations : 0.0;
+   out << "ossimTileBufferPool:"
+       << "\nenabled:              " << (m_enabled ? "true" : "false")
+       << "\nmax_bytes:            " << m_maxBytes
+       << "\nthread_cache_bytes:   " << m_threadCacheBytes
+       << "\nallocations:          " << stats.allocations
+       << "\nthread cache hits:    " << stats.threadHits
+       << "\nglobal cache hits:    " << stats.globalHits
+       << "\nhit rate (%):         " << hitRate
+       << "\nheap allocations:     " << stats.heapAllocations
+       << "\nheap releases:        " << stats.heapReleases
+       << "\nbytes in use:         " << stats.bytesInUse
+       << "\nbytes cached:         " << stats.bytesCached
+       << "\nbytes thread cached:  " << m_threadCachedBytes
+       << "\npeak bytes:           " << stats.peakBytes
+       << std::endl;
+   return out;
+}
@@ -20,7 +20,8 @@
 
 RTTI_DEF2(ossimXmlAttribute, "ossimXmlAttribute", ossimObject, ossimErrorStatusInterface)
 
-static std::istream& xmlskipws(std::istream& in)
+template <class InputType>
+static InputType& xmlskipws(InputType& in)
 {
    int c = in.peek();
    while((!in.fail())&&
@@ -50,6 +51,17 @@ ossimXmlAttribute::ossimXmlAttribute(const ossimXmlAttribute& src)
 }
 
 bool ossimXmlAttribute::read(std::istream& in)
+{
+   return readAttribute(in);
+}
+
+bool ossimXmlAttribute::read(ossimBufferCursor& in)
+{
+   return readAttribute(in);
+}
+
+template <class InputType>
+bool ossimXmlAttribute::readAttribute(InputType& in)
 {
    xmlskipws(in);
    if(in.fail()) return false;
@@ -158,7 +170,8 @@ std::ostream& operator << (std::ostream& os, const ossimXmlAttribute* xml_attr)
 }
 
 
-bool ossimXmlAttribute::readName(std::istream& in)
+template <class InputType>
+bool ossimXmlAttribute::readName(InputType& in)
 {
    xmlskipws(in);
    theName = "";
@@ -181,7 +194,8 @@ bool ossimXmlAttribute::readName(std::istream& in)
            (theName != ""));
 }
 
-bool ossimXmlAttribute::readValue(std::istream& in)
+template <class InputType>
+bool ossimXmlAttribute::readValue(InputType& in)
 {
    xmlskipws(in);
    if(in.fail()) return false;
@@ -236,7 +250,8 @@ bool ossimXmlAttribute::readValue(std::istream& in)
          return false;
          setErrorStatus();
       }
-      if(*endIter != startQuote)
+      // A lone quote (value cut off by a newline) has no closing quote.
+      if((*endIter != startQuote) || (theValue.size() < 2))
       {
          return false;
          setErrorStatus();
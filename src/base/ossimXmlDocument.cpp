@@ -31,7 +31,8 @@ static ossimTrace traceDebug("ossimXmlDocument:debug");
 
 using namespace std;
 
-static std::istream& xmlskipws(std::istream& in)
+template <class InputType>
+static InputType& xmlskipws(InputType& in)
 {
    int c = in.peek();
    while((!in.fail())&&
@@ -117,16 +118,48 @@ bool ossimXmlDocument::openFile(const ossimFilename& filename)
       return false;
    }
 
-   return read(xml_stream);
+   //---
+   // Slurp the file and parse from memory.  Metadata files are small enough
+   // to hold and parsing through the stream a character at a time is the
+   // bottleneck.
+   //---
+   std::string buffer;
+   ossim_int64 fileSize = filename.fileSize();
+   if ( fileSize > 0 )
+   {
+      buffer.reserve( static_cast<std::string::size_type>(fileSize) );
+   }
+   char chunk[65536];
+   while ( xml_stream )
+   {
+      xml_stream.read( chunk, sizeof(chunk) );
+      buffer.append( chunk, static_cast<std::string::size_type>(xml_stream.gcount()) );
+   }
+   if ( xml_stream.bad() )
+   {
+      return false;
+   }
+
+   return read( buffer.data(), buffer.size() );
 }
 bool ossimXmlDocument::readString(const ossimString &xmlString)
 {
-   std::istringstream xmlInStream(xmlString.string());
-
-   return read(xmlInStream);
+   return read( xmlString.string().data(), xmlString.string().size() );
 }
 
 bool ossimXmlDocument::read(std::istream& in)
+{
+   return readDocument(in);
+}
+
+bool ossimXmlDocument::read(const char* buffer, std::size_t size)
+{
+   ossimBufferCursor in(buffer, size);
+   return readDocument(in);
+}
+
+template <class InputType>
+bool ossimXmlDocument::readDocument(InputType& in)
 {
 //   char buffer[BUFFER_MAX_LEN];
 //   streampos file_pos;
@@ -172,7 +205,8 @@ bool ossimXmlDocument::read(std::istream& in)
       setErrorStatus();
       return false;
    }
-   theRootNode = new ossimXmlNode(in, 0);
+   theRootNode = new ossimXmlNode();
+   theRootNode->read(in);
    setErrorStatus(theRootNode->getErrorStatus());
    return (getErrorStatus()==ossimErrorCodes::OSSIM_OK);
 }
@@ -381,7 +415,8 @@ void ossimXmlDocument::toKwl(ossimKeywordlist& kwl ,
 //    }
 }
 
-bool ossimXmlDocument::readHeader(std::istream& in)
+template <class InputType>
+bool ossimXmlDocument::readHeader(InputType& in)
 {
    //---
    // Clear the existing header so we don't get double:
@@ -390,7 +425,7 @@ bool ossimXmlDocument::readHeader(std::istream& in)
    theXmlHeader.clear();
    
    char c;
-   in>>xmlskipws;
+   xmlskipws(in);
 
    while(in.peek() == '<')
    {
@@ -406,7 +441,7 @@ bool ossimXmlDocument::readHeader(std::istream& in)
          theXmlHeader += (char)in.get();
          
          while(!theLessThanStack.empty()&&
-               (!in.bad()))
+               (!in.fail()))
          {
             if(in.peek() == '<')
             {
@@ -430,7 +465,7 @@ bool ossimXmlDocument::readHeader(std::istream& in)
 //          {
 //             theXmlHeader += (char)in.get();
 //          }
-         in>>xmlskipws;
+         xmlskipws(in);
       }
    }
 
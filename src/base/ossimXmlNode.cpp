@@ -32,7 +32,8 @@ RTTI_DEF2(ossimXmlNode, "ossimXmlNode", ossimObject, ossimErrorStatusInterface);
 
 using namespace std;
 
-static std::istream &xmlskipws(std::istream &in)
+template <class InputType>
+static InputType &xmlskipws(InputType &in)
 {
 	int c = in.peek();
 	while (!in.fail() &&
@@ -102,7 +103,18 @@ void ossimXmlNode::setParent(ossimXmlNode *parent)
 	theParentNode = parent;
 }
 
-void ossimXmlNode::skipCommentTag(std::istream &in)
+bool ossimXmlNode::read(std::istream &in)
+{
+	return readNode(in);
+}
+
+bool ossimXmlNode::read(ossimBufferCursor &in)
+{
+	return readNode(in);
+}
+
+template <class InputType>
+void ossimXmlNode::skipCommentTag(InputType &in)
 {
 	char c;
 	while (!in.fail())
@@ -123,7 +135,8 @@ void ossimXmlNode::skipCommentTag(std::istream &in)
 	}
 }
 
-bool ossimXmlNode::read(std::istream &in)
+template <class InputType>
+bool ossimXmlNode::readNode(InputType &in)
 {
 	if (traceDebug())
 	{
@@ -1058,7 +1071,8 @@ void ossimXmlNode::toKwl(ossimKeywordlist &kwl,
 	}
 }
 
-bool ossimXmlNode::readTag(std::istream &in,
+template <class InputType>
+bool ossimXmlNode::readTag(InputType &in,
 									ossimString &tag)
 {
 	if (traceDebug())
@@ -1103,7 +1117,8 @@ bool ossimXmlNode::readTag(std::istream &in,
 	return (!tag.empty()) && (!in.fail());
 }
 
-bool ossimXmlNode::readCDataContent(std::istream &in)
+template <class InputType>
+bool ossimXmlNode::readCDataContent(InputType &in)
 {
 	if (traceDebug())
 	{
@@ -1303,7 +1318,8 @@ bool ossimXmlNode::readTextContent(std::istream& in)
 }
 #endif
 
-bool ossimXmlNode::readTextContent(std::istream &in)
+template <class InputType>
+bool ossimXmlNode::readTextContent(InputType &in)
 {
 	if (traceDebug())
 	{
@@ -1426,7 +1442,8 @@ bool ossimXmlNode::readTextContent(std::istream &in)
 	return result;
 }
 
-bool ossimXmlNode::readEndTag(std::istream &in,
+template <class InputType>
+bool ossimXmlNode::readEndTag(InputType &in,
 										ossimString &endTag)
 {
 	bool result = false;
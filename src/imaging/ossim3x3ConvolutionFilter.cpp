@@ -14,6 +14,7 @@
 #include <ossim/imaging/ossim3x3ConvolutionFilter.h>
 #include <ossim/base/ossimIrect.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimDiscreteConvolutionKernel.h>
 #include <ossim/base/ossimMatrixProperty.h>
 
 RTTI_DEF1(ossim3x3ConvolutionFilter, "ossim3x3ConvolutionFilter", ossimImageSourceFilter);
@@ -23,6 +24,7 @@ using namespace std;
 ossim3x3ConvolutionFilter::ossim3x3ConvolutionFilter(ossimObject* owner)
    :ossimImageSourceFilter(owner),
     theTile(NULL),
+    theConvolutionKernel(0),
     theNullPixValue(0),
     theMinPixValue(0),
     theMaxPixValue(0)
@@ -35,6 +37,7 @@ ossim3x3ConvolutionFilter::ossim3x3ConvolutionFilter(ossimObject* owner)
 
 ossim3x3ConvolutionFilter::~ossim3x3ConvolutionFilter()
 {
+   delete theConvolutionKernel;
 }
 
 ossimRefPtr<ossimImageData> ossim3x3ConvolutionFilter::getTile(
@@ -91,6 +94,17 @@ ossimRefPtr<ossimImageData> ossim3x3ConvolutionFilter::getTile(
 
    theTile->setImageRectangle(tileRect);
    theTile->makeBlank();
+
+   // No nulls, use the shared blocked/separable engine:
+   if((data->getDataObjectStatus() == OSSIM_FULL) &&
+      theConvolutionKernel->convolveFull(data.get(),
+                                         theTile.get(),
+                                         &theMinPixValue.front(),
+                                         &theMaxPixValue.front()))
+   {
+      theTile->validate();
+      return theTile;
+   }
    
    switch(data->getScalarType())
    {
@@ -401,6 +415,8 @@ void ossim3x3ConvolutionFilter::setProperty(ossimRefPtr<ossimProperty> property)
          theKernel[1][2] = (*matrixProperty)(1,2);
          theKernel[2][2] = (*matrixProperty)(2,2);
 
+         // Will be recomputed first getTile call.
+         clearNullMinMax();
       }
       else
       {
@@ -497,6 +513,7 @@ bool ossim3x3ConvolutionFilter::loadState(const ossimKeywordlist& kwl,
          }
       }
    }
+   clearNullMinMax();
    
    return ossimImageSourceFilter::loadState(kwl, prefix);
 }
@@ -578,6 +595,23 @@ void ossim3x3ConvolutionFilter::computeNullMinMax()
    ossim_float64 defaultNull = ossim::defaultNull(getOutputScalarType());
    ossim_float64 defaultMin = ossim::defaultMin(getOutputScalarType());
    ossim_float64 defaultMax = ossim::defaultMax(getOutputScalarType());
+
+   NEWMAT::Matrix kernel(3, 3);
+   for(int i=0;i<3;++i)
+   {
+      for(int j=0;j<3;++j)
+      {
+         kernel[i][j] = theKernel[i][j];
+      }
+   }
+   if(!theConvolutionKernel)
+   {
+      theConvolutionKernel = new ossimDiscreteConvolutionKernel(kernel, false);
+   }
+   else
+   {
+      theConvolutionKernel->setKernel(kernel);
+   }
   
    for (ossim_uint32 band = 0; band < BANDS; ++band)
    {
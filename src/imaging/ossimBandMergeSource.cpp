@@ -13,20 +13,48 @@
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
 #include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/parallel/ossimParallelFor.h>
+#include <exception>
+#include <set>
+#include <vector>
 
 RTTI_DEF1(ossimBandMergeSource, "ossimBandMergeSource", ossimImageCombiner)
 
+// Adds obj and everything upstream of it to objects.
+static void collectUpstream(ossimConnectableObject* obj,
+                            std::set<ossimConnectableObject*>& objects)
+{
+   if ( obj && objects.insert(obj).second )
+   {
+      for (ossim_uint32 idx = 0; idx < obj->getNumberOfInputs(); ++idx)
+      {
+         collectUpstream(obj->getInput(idx), objects);
+      }
+   }
+}
+
+static ossim_uint32 getMergeThreads()
+{
+   const char* lookup = ossimPreferences::instance()->findPreference("band_merge.threads");
+   return lookup ? ossimString(lookup).toUInt32() : 1;
+}
+
 ossimBandMergeSource::ossimBandMergeSource()
    :ossimImageCombiner(),
     theNumberOfOutputBands(0),
-    theTile(NULL)
+    theTile(NULL),
+    theIndependentInputsFlag(false),
+    theNumberOfThreads(getMergeThreads())
 {
 }
 
 ossimBandMergeSource::ossimBandMergeSource(ossimConnectableObject::ConnectableObjectList& inputSources)
    :ossimImageCombiner(inputSources),
     theNumberOfOutputBands(0),
-    theTile(NULL)
+    theTile(NULL),
+    theIndependentInputsFlag(false),
+    theNumberOfThreads(getMergeThreads())
 {
    initialize();
 }
@@ -79,7 +107,7 @@ ossimRefPtr<ossimImageData> ossimBandMergeSource::getTile(const ossimIrect& tile
    }
 
    theTile->setOrigin(tileRect.ul());
-   getTile(theTile.get(), resLevel);
+   mergeInputTiles(theTile.get(), resLevel);
 
    return theTile;
 }
@@ -95,56 +123,85 @@ bool ossimBandMergeSource::getTile(ossimImageData* tile, ossim_uint32 resLevel)
       return getNextTile(layerIdx, 0, tile, resLevel);
    }
 
+   mergeInputTiles(tile, resLevel);
+   return true;
+}
+
+void ossimBandMergeSource::mergeInputTiles(ossimImageData* tile, ossim_uint32 resLevel)
+{
    tile->makeBlank();
-   ossim_uint32 currentBand = 0;
-   ossim_uint32 maxBands = tile->getNumberOfBands();
-   ossim_uint32 inputIdx = 0;
-   ossimRefPtr<ossimImageData> currentTile;
-   for(inputIdx = 0; inputIdx < getNumberOfInputs(); ++inputIdx)
-   {
-      ossimImageSource* input = PTR_CAST(ossimImageSource, getInput(inputIdx));
-      ossim_uint32 maxInputBands = 1;
 
-      if(input)
+   const ossim_uint32 INPUTS = getNumberOfInputs();
+   const ossimIrect RECT = tile->getImageRectangle();
+   std::vector< ossimRefPtr<ossimImageData> > inputTiles(INPUTS);
+   const bool PARALLEL = theIndependentInputsFlag && (theNumberOfThreads != 1);
+   if (PARALLEL)
+   {
+      // Independent chains can be asked for their tiles at once:
+      std::vector<std::exception_ptr> errors(INPUTS);
+      ossim::parallelFor(INPUTS, theNumberOfThreads, [&](ossim_uint32 inputIdx)
       {
-         currentTile = input->getTile(tile->getImageRectangle(), resLevel);
-         if(currentTile.valid())
+         ossimImageSource* input = PTR_CAST(ossimImageSource, getInput(inputIdx));
+         if (input)
          {
-            maxInputBands = currentTile->getNumberOfBands();
-            //std::cout << "MAX INPUT BANDS === " << maxInputBands << "\n";
-            if (maxInputBands == 0)
-               maxInputBands = 1;
+            try
+            {
+               inputTiles[inputIdx] = input->getTile(RECT, resLevel);
+            }
+            catch (...)
+            {
+               errors[inputIdx] = std::current_exception();
+            }
          }
+      });
+      for(ossim_uint32 inputIdx = 0; inputIdx < INPUTS; ++inputIdx)
+      {
+         if (errors[inputIdx])
+            std::rethrow_exception(errors[inputIdx]);
       }
-      else
+   }
+
+   ossim_uint32 currentBand = 0;
+   ossim_uint32 maxBands = tile->getNumberOfBands();
+   for(ossim_uint32 inputIdx = 0; inputIdx < INPUTS; ++inputIdx)
+   {
+      if (!PARALLEL)
+      {
+         // Otherwise each is copied before the next fetch can change it:
+         ossimImageSource* input = PTR_CAST(ossimImageSource, getInput(inputIdx));
+         if (input)
+            inputTiles[inputIdx] = input->getTile(RECT, resLevel);
+      }
+
+      ossimImageData* currentTile = inputTiles[inputIdx].get();
+      if(!currentTile || !currentTile->getBuf(0))
       {
-         currentTile = 0;
+         continue;
       }
 
-      if(currentTile.valid()&&(currentTile->getBuf()))
+      ossim_uint32 maxInputBands = currentTile->getNumberOfBands();
+      if (maxInputBands == 0)
+         maxInputBands = 1;
+
+      const bool HAS_DATA = (currentTile->getDataObjectStatus() != OSSIM_NULL) &&
+                            (currentTile->getDataObjectStatus() != OSSIM_EMPTY);
+      for(ossim_uint32 band = 0; (band < maxInputBands) && (currentBand < maxBands); ++band)
       {
-         for(ossim_uint32 band = 0; (band < maxInputBands) && (currentBand < maxBands); ++band)
+         if ( !HAS_DATA )
          {
-            //std::cout << "Actual Band, BAND == " << currentBand << ", " << band << "\n";
             // clear the band with the actual NULL
             tile->fill(currentBand, tile->getNullPix(band));
-
-            if(currentTile.valid())
-            {
-               if((currentTile->getDataObjectStatus() != OSSIM_NULL) &&
-                  (currentTile->getDataObjectStatus() != OSSIM_EMPTY))
-               {
-                  memmove(tile->getBuf(currentBand),
-                          currentTile->getBuf(band),
-                          currentTile->getSizePerBandInBytes());
-               }
-            }
-            ++currentBand;
          }
+         else
+         {
+            memmove(tile->getBuf(currentBand),
+                    currentTile->getBuf(band),
+                    currentTile->getSizePerBandInBytes());
+         }
+         ++currentBand;
       }
    }
    tile->validate();
-   return true;
 }
 
 double ossimBandMergeSource::getNullPixelValue(ossim_uint32 band)const
@@ -241,6 +298,24 @@ void ossimBandMergeSource::initialize()
    }
    
    theNumberOfOutputBands = computeNumberOfInputBands();
+
+   // Inputs that share an upstream object can't be fetched at once, and
+   // fetching one could change the tile of another, so they get copied:
+   std::set<ossimConnectableObject*> all;
+   theIndependentInputsFlag = true;
+   for(ossim_uint32 idx = 0; idx < getNumberOfInputs(); ++idx)
+   {
+      std::set<ossimConnectableObject*> upstream;
+      collectUpstream(getInput(idx), upstream);
+      for(std::set<ossimConnectableObject*>::const_iterator i = upstream.begin();
+          i != upstream.end(); ++i)
+      {
+         if (!all.insert(*i).second)
+         {
+            theIndependentInputsFlag = false;
+         }
+      }
+   }
 }
 
 void ossimBandMergeSource::allocate()
@@ -25,6 +25,8 @@
 
 static ossimTrace traceDebug("ossimBandSelector:debug");
 
+static const char BORROW_INPUT_TILES_KW[] = "borrow_input_tiles";
+
 RTTI_DEF1(ossimBandSelector,"ossimBandSelector", ossimImageSourceFilter)
 
 using namespace std;
@@ -37,7 +39,8 @@ ossimBandSelector::ossimBandSelector()
       m_withinRangeFlag(ossimBandSelectorWithinRangeFlagState_NOT_SET),
       m_passThroughFlag(false),
       m_delayLoadRgbFlag(false),
-      m_inputIsSelectable(false)
+      m_inputIsSelectable(false),
+      m_borrowInputTilesFlag(false)
 {
 //   theEnableFlag = false; // Start off disabled.
    theEnableFlag = true; 
@@ -101,17 +104,31 @@ ossimRefPtr<ossimImageData> ossimBandSelector::getTile(
       return m_tile;
    }
 
-   // Copy selected bands to our tile.
    for ( ossim_uint32 i = 0; i < m_outputBandList.size(); ++i)
    {
-      m_tile->assignBand(t.get(), m_outputBandList[i], i);
+      // Borrowed bands are views of the input tile where it matches ours:
+      if ( !m_borrowInputTilesFlag || !m_tile->setBandView(i, t.get(), m_outputBandList[i]) )
+      {
+         m_tile->assignBand(t.get(), m_outputBandList[i], i);
+      }
    }
+   m_tile->resolveBandViews();
    
    m_tile->validate();
 
    return m_tile;
 }
 
+void ossimBandSelector::setBorrowInputTilesFlag(bool flag)
+{
+   m_borrowInputTilesFlag = flag;
+}
+
+bool ossimBandSelector::getBorrowInputTilesFlag() const
+{
+   return m_borrowInputTilesFlag;
+}
+
 void ossimBandSelector::setThreeBandRgb()
 {
    m_outputBandList.clear();
@@ -396,6 +413,8 @@ bool ossimBandSelector::saveState(ossimKeywordlist& kwl,
               ossimString::toString(m_outputBandList[counter]+1).c_str());
    }
 */   
+   kwl.add(prefix, BORROW_INPUT_TILES_KW, m_borrowInputTilesFlag, true);
+
    return ossimImageSourceFilter::saveState(kwl, prefix);
 }
 
@@ -407,6 +426,9 @@ bool ossimBandSelector::loadState(const ossimKeywordlist& kwl,
    ossimImageSourceFilter::loadState(kwl, prefix);
 
    m_outputBandList.clear();
+
+   ossimString borrow = kwl.find(prefix, BORROW_INPUT_TILES_KW);
+   m_borrowInputTilesFlag = borrow.empty() ? false : borrow.toBool();
    
    ossimString copyPrefix = prefix;
    
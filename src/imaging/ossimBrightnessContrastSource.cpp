@@ -45,13 +45,32 @@ ossimRefPtr<ossimImageData> ossimBrightnessContrastSource::getTile(
 
    if(theInputConnection)
    {
-      tile = theInputConnection->getTile(tileRect, resLevel);
-      
-      if(!tile.valid())
+      // Runs of pointwise remappers ending here are one table lookup:
+      if (theRemapChain.fuse(this))
       {
-         return tile;
+         return theRemapChain.getTile(tileRect, resLevel);
       }
+      tile = remapTile(theInputConnection->getTile(tileRect, resLevel));
+   }
+   
+   return tile;
+}
 
+bool ossimBrightnessContrastSource::isPointwiseRemap() const
+{
+   // Rgb input is adjusted in hsi space which mixes the bands:
+   return ( !isSourceEnabled() ||
+            ( (theBrightness == 0.0) && (theContrast == 1.0) ) ||
+            ( getNumberOfOutputBands() != 3 ) );
+}
+
+ossimRefPtr<ossimImageData> ossimBrightnessContrastSource::remapTile(
+   const ossimRefPtr<ossimImageData>& inputTile)
+{
+   ossimRefPtr<ossimImageData> tile = inputTile;
+
+   if(tile.valid())
+   {
       if(!isSourceEnabled() ||
          (tile->getDataObjectStatus()==OSSIM_NULL)||
          (tile->getDataObjectStatus()==OSSIM_EMPTY)||
@@ -70,8 +89,8 @@ ossimRefPtr<ossimImageData> ossimBrightnessContrastSource::getTile(
          return tile;
       }
 
-      theTile->setImageRectangle(tileRect);
-      theNormTile->setImageRectangle(tileRect);
+      theTile->setImageRectangle(tile->getImageRectangle());
+      theNormTile->setImageRectangle(tile->getImageRectangle());
 
       tile->copyTileToNormalizedBuffer((ossim_float32*)theNormTile->getBuf());
       theNormTile->setDataObjectStatus(tile->getDataObjectStatus());
@@ -172,6 +191,7 @@ void ossimBrightnessContrastSource::initialize()
 
    theTile     = 0;
    theNormTile = 0;
+   theRemapChain.reset();
 }
 
 void ossimBrightnessContrastSource::allocate()
@@ -217,6 +237,7 @@ void ossimBrightnessContrastSource::setProperty(ossimRefPtr<ossimProperty> prope
    {
       ossimImageSourceFilter::setProperty(property);
    }
+   remapChanged();
 }
 
 ossimRefPtr<ossimProperty> ossimBrightnessContrastSource::getProperty(const ossimString& name)const
@@ -291,6 +312,7 @@ void ossimBrightnessContrastSource::setBrightnessContrast(
 {
    theBrightness = brightness;
    theContrast   = contrast;
+   remapChanged();
 }
 
 void ossimBrightnessContrastSource::setBrightness(ossim_float64 brightness)
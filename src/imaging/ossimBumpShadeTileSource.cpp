@@ -12,7 +12,7 @@
 
 #include <ossim/imaging/ossimBumpShadeTileSource.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
-#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageToPlaneNormalFilter.h>
 #include <ossim/imaging/ossimTilePatch.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/base/ossimColumnVector3d.h>
@@ -22,6 +22,7 @@
 #include <ossim/base/ossimKeyword.h>
 #include <ossim/base/ossimMatrix3x3.h>
 #include <ossim/base/ossimRgbVector.h>
+#include <vector>
 
 static const char COLOR_RED_KW[]   = "color_red";
 static const char COLOR_GREEN_KW[] = "color_green";
@@ -96,29 +97,14 @@ bool ossimBumpShadeTileSource::getTile(ossimImageData* tile, ossim_uint32 resLev
       colorSource->getTile(colorData.get(), resLevel);
    }
 
-   ossimImageSource* normalSource = PTR_CAST(ossimImageSource, getInput(0));
-   ossimRefPtr<ossimImageData> normalData =
-         new ossimImageData(normalSource, normalSource->getOutputScalarType(),
-                            normalSource->getNumberOfOutputBands(),
-                            tile->getWidth(), tile->getHeight());
-
-   // Caution: Must set rect prior to getTile:
-   normalData->setImageRectangle(tileRect);
-
-   normalSource->getTile(normalData.get(), resLevel);
-   ossimDataObjectStatus status = normalData->getDataObjectStatus();
-   if ((status == OSSIM_NULL) || (status == OSSIM_EMPTY) ||
-       (normalData->getNumberOfBands() != 3) ||
-       (normalData->getScalarType() != OSSIM_DOUBLE))
+   // Shading, normal dot light, of each pixel:
+   const ossim_float64 SHADE_NP = OSSIM_DEFAULT_NULL_PIX_DOUBLE;
+   std::vector<ossim_float64> shade(tile->getSizePerBand(), SHADE_NP);
+   if ( !getShade(tileRect, resLevel, &shade.front(), SHADE_NP) )
    {
       return false;
    }
-
-   ossim_float64* normalBuf[3];
-   normalBuf[0] = static_cast<ossim_float64*>(normalData->getBuf(0));
-   normalBuf[1] = static_cast<ossim_float64*>(normalData->getBuf(1));
-   normalBuf[2] = static_cast<ossim_float64*>(normalData->getBuf(2));
-   ossim_float64 normalNp = normalData->getNullPix(0);
+   const ossim_float64* shadeBuf = &shade.front();
 
    //---
    // If we have some color data then use it for the bump
@@ -161,18 +147,14 @@ bool ossimBumpShadeTileSource::getTile(ossimImageData* tile, ossim_uint32 resLev
             {
                for(long x = 0; x < w; ++x)
                {
-                  if((*normalBuf[0] != normalNp) &&
-                     (*normalBuf[1] != normalNp) &&
-                     (*normalBuf[2] != normalNp) )
+                  if(*shadeBuf != SHADE_NP)
                   {
                      if((*colorBuf[0])||(*colorBuf[1])||(*colorBuf[2]))
                      {
                         computeColor(*resultBuf[0],
                                      *resultBuf[1],
                                      *resultBuf[2],
-                                     *normalBuf[0],
-                                     *normalBuf[1],
-                                     *normalBuf[2],
+                                     *shadeBuf,
                                      *colorBuf[0],
                                      *colorBuf[1],
                                      *colorBuf[2]);
@@ -182,9 +164,7 @@ bool ossimBumpShadeTileSource::getTile(ossimImageData* tile, ossim_uint32 resLev
                         computeColor(*resultBuf[0],
                                      *resultBuf[1],
                                      *resultBuf[2],
-                                     *normalBuf[0],
-                                     *normalBuf[1],
-                                     *normalBuf[2],
+                                     *shadeBuf,
                                      m_r,
                                      m_g,
                                      m_b);
@@ -202,9 +182,7 @@ bool ossimBumpShadeTileSource::getTile(ossimImageData* tile, ossim_uint32 resLev
                   colorBuf[0]++;
                   colorBuf[1]++;
                   colorBuf[2]++;
-                  normalBuf[0]++;
-                  normalBuf[1]++;
-                  normalBuf[2]++;
+                  shadeBuf++;
                }
             }
             break;
@@ -229,16 +207,12 @@ bool ossimBumpShadeTileSource::getTile(ossimImageData* tile, ossim_uint32 resLev
       {
          for(long x = 0; x < w; ++x)
          {
-            if((*normalBuf[0] != normalNp) &&
-                  (*normalBuf[1] != normalNp) &&
-                  (*normalBuf[2] != normalNp) )
+            if(*shadeBuf != SHADE_NP)
             {
                computeColor(*resultBuf[0],
                             *resultBuf[1],
                             *resultBuf[2],
-                            *normalBuf[0],
-                            *normalBuf[1],
-                            *normalBuf[2],
+                            *shadeBuf,
                             m_r,
                             m_g,
                             m_b);
@@ -252,9 +226,7 @@ bool ossimBumpShadeTileSource::getTile(ossimImageData* tile, ossim_uint32 resLev
             resultBuf[0]++;
             resultBuf[1]++;
             resultBuf[2]++;
-            normalBuf[0]++;
-            normalBuf[1]++;
-            normalBuf[2]++;
+            shadeBuf++;
          }
       }
    }
@@ -276,12 +248,89 @@ void ossimBumpShadeTileSource::computeColor(ossim_uint8& r,
    double c = /*fabs*/(normalX*m_lightDirection[0] +
                    normalY*m_lightDirection[1] +
                    normalZ*m_lightDirection[2]);
-   
+
+   computeColor(r, g, b, c, dr, dg, db);
+}
+
+void ossimBumpShadeTileSource::computeColor(ossim_uint8& r,
+                                            ossim_uint8& g,
+                                            ossim_uint8& b,
+                                            ossim_float64 c,
+                                            ossim_uint8 dr,
+                                            ossim_uint8 dg,
+                                            ossim_uint8 db)const
+{
    r = ossimRgbVector::clamp(ossim::round<int>(c*dr), 1, 255);
    g = ossimRgbVector::clamp(ossim::round<int>(c*dg), 1, 255);
    b = ossimRgbVector::clamp(ossim::round<int>(c*db), 1, 255);
 }
 
+bool ossimBumpShadeTileSource::getShade(const ossimIrect& tileRect,
+                                        ossim_uint32 resLevel,
+                                        ossim_float64* shade,
+                                        ossim_float64 nullPix)
+{
+   //---
+   // Straight from the elevation when the input is the normal filter, else from the normals
+   // of whatever is there:
+   //---
+   ossimImageToPlaneNormalFilter* normalFilter =
+      dynamic_cast<ossimImageToPlaneNormalFilter*>( getInput(0) );
+   if ( normalFilter && normalFilter->isSourceEnabled() )
+   {
+      const ossim_float64 LIGHT[3] =
+         { m_lightDirection[0], m_lightDirection[1], m_lightDirection[2] };
+      ossimTerrainKernels::Outputs outputs;
+      outputs.m_shade = shade;
+      return normalFilter->getTerrainTile(tileRect, resLevel, outputs, nullPix, LIGHT);
+   }
+
+   ossimImageSource* normalSource = PTR_CAST(ossimImageSource, getInput(0));
+   if ( !normalSource )
+   {
+      return false;
+   }
+   ossimRefPtr<ossimImageData> normalData =
+         new ossimImageData(normalSource, normalSource->getOutputScalarType(),
+                            normalSource->getNumberOfOutputBands(),
+                            tileRect.width(), tileRect.height());
+
+   // Caution: Must set rect prior to getTile:
+   normalData->setImageRectangle(tileRect);
+
+   normalSource->getTile(normalData.get(), resLevel);
+   ossimDataObjectStatus status = normalData->getDataObjectStatus();
+   if ((status == OSSIM_NULL) || (status == OSSIM_EMPTY) ||
+       (normalData->getNumberOfBands() != 3) ||
+       (normalData->getScalarType() != OSSIM_DOUBLE))
+   {
+      return false;
+   }
+
+   const ossim_float64* normalBuf[3];
+   normalBuf[0] = static_cast<const ossim_float64*>(normalData->getBuf(0));
+   normalBuf[1] = static_cast<const ossim_float64*>(normalData->getBuf(1));
+   normalBuf[2] = static_cast<const ossim_float64*>(normalData->getBuf(2));
+   const ossim_float64 normalNp = normalData->getNullPix(0);
+   const ossim_uint32 SIZE = normalData->getSizePerBand();
+   for(ossim_uint32 i = 0; i < SIZE; ++i)
+   {
+      if((normalBuf[0][i] != normalNp) &&
+         (normalBuf[1][i] != normalNp) &&
+         (normalBuf[2][i] != normalNp))
+      {
+         shade[i] = normalBuf[0][i]*m_lightDirection[0] +
+                    normalBuf[1][i]*m_lightDirection[1] +
+                    normalBuf[2][i]*m_lightDirection[2];
+      }
+      else
+      {
+         shade[i] = nullPix;
+      }
+   }
+   return true;
+}
+
 void ossimBumpShadeTileSource::initialize()
 {
    ossimImageCombiner::initialize();
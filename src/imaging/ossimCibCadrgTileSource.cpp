@@ -9,6 +9,7 @@
 //********************************************************************
 // $Id: ossimCibCadrgTileSource.cpp 23021 2014-12-04 20:57:16Z dburken $
 #include <algorithm>
+#include <cstring>
 
 #include <ossim/imaging/ossimCibCadrgTileSource.h>
 
@@ -31,11 +32,14 @@
 #include <ossim/support_data/ossimRpfTocEntry.h>
 #include <ossim/support_data/ossimRpfCompressionSection.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimRpfSubframeCache.h>
+#include <ossim/parallel/ossimParallelFor.h>
 #include <ossim/projection/ossimEquDistCylProjection.h>
 #include <ossim/projection/ossimCylEquAreaProjection.h>
 #include <ossim/projection/ossimProjectionFactoryRegistry.h>
 #include <ossim/base/ossimEndian.h>
 #include <ossim/base/ossimTrace.h>
+#include <ossim/base/ossimPreferences.h>
 
 static ossimTrace traceDebug = ossimTrace("ossimCibCadrgTileSource:debug");
 
@@ -52,8 +56,6 @@ using namespace std;
 
 ossimCibCadrgTileSource::ossimCibCadrgTileSource()
    :ossimImageHandler(),
-    theCompressedBuffer(0),
-    theUncompressedBuffer(0),
     theNumberOfLines(0),
     theNumberOfSamples(0),
     theTile(0),
@@ -62,7 +64,8 @@ ossimCibCadrgTileSource::ossimCibCadrgTileSource()
     theEntryNumberToRender(1),
     theProductType(OSSIM_PRODUCT_TYPE_UNKNOWN),
     theWorkFrame(0),
-    theSkipEmptyCheck(false)
+    theSkipEmptyCheck(false),
+    theDecodeThreads(1)
 {
    if (traceDebug())
    {
@@ -77,29 +80,17 @@ ossimCibCadrgTileSource::ossimCibCadrgTileSource()
    // Moved memory allocation to happen in first get tile. drb
    
    // theWorkFrame = new ossimRpfFrame;
-   
-   // a CADRG and CIBis a 64*64*12 bit buffer and must divide by 8 to
-   // convert to bytes
-   // theCompressedBuffer   = new ossim_uint8[(64*64*12)/8];
-
-   // whether CIB or CADRG we will alocate the buffer
-   // to the larger of the 2 (CADRG is 3 bands)
-   // theUncompressedBuffer = new ossim_uint8[256*256*3];
-                           
+
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("rpf.decode_threads");
+   if ( lookup )
+   {
+      theDecodeThreads = ossimString(lookup).toUInt32();
+   }
 }
 
 ossimCibCadrgTileSource::~ossimCibCadrgTileSource()
 {
-   if(theCompressedBuffer)
-   {
-      delete [] theCompressedBuffer;
-      theCompressedBuffer = 0;
-   }
-   if(theUncompressedBuffer)
-   {
-      delete [] theUncompressedBuffer;
-      theUncompressedBuffer = 0;
-   }
    if(theWorkFrame)
    {
       delete theWorkFrame;
@@ -287,13 +278,13 @@ bool ossimCibCadrgTileSource::getTile(ossimImageData* result,
 
       if (!status) // Did not get an overview tile.
       {
-         if ( !theCompressedBuffer )
+         if ( !theWorkFrame )
          {
             // First time through.
             allocateForProduct(); 
          }
 
-         if ( theCompressedBuffer )
+         if ( theWorkFrame )
          {
             status = true;
             
@@ -732,32 +723,13 @@ void ossimCibCadrgTileSource::fillTile(
        idx < framesInvolved.size();
        ++idx)
    {
-
-      if(theWorkFrame->parseFile(framesInvolved[idx].theFrameEntry.getFullPath())
-         == ossimErrorCodes::OSSIM_OK)
-      {
-         // we will fill a subtile.  We pass in which frame it is and the position of the frame.
-         // the actual pixel will be 1536*row and 1536 *col.
-         if(theProductType == OSSIM_PRODUCT_TYPE_CIB)
-         {
-            fillSubTileCib(*theWorkFrame,
-                           tileRect,
-                           framesInvolved[idx],
-                           tile);
-         }
-         else
-         {
-            fillSubTileCadrg(*theWorkFrame,
-                             tileRect,
-                             framesInvolved[idx],
-                             tile);
-         }
-      }
+      // we will fill a subtile.  We pass in which frame it is and the position of the frame.
+      // the actual pixel will be 1536*row and 1536 *col.
+      fillSubTile(tileRect, framesInvolved[idx], tile);
    }
 }
 
-void ossimCibCadrgTileSource::fillSubTileCadrg(
-   const ossimRpfFrame&  aFrame,
+void ossimCibCadrgTileSource::fillSubTile(
    const ossimIrect& tileRect,
    const ossimFrameEntryData& frameEntryData,
    ossimImageData* tile)
@@ -767,41 +739,14 @@ void ossimCibCadrgTileSource::fillSubTileCadrg(
                         frameEntryData.thePixelRow,
                         frameEntryData.thePixelCol + CIBCADRG_FRAME_WIDTH  - 1,
                         frameEntryData.thePixelRow + CIBCADRG_FRAME_HEIGHT - 1);
-
    
    // now clip it to the tile
    ossimIrect clipRect = tileRect.clipToRect(frameRect);
-   
-   const ossimRpfCompressionSection* compressionSection = aFrame.getCompressionSection();
-   
-   if(!compressionSection)
-   {
-      return;
-   }
-
-   const vector<ossimRpfColorGrayscaleTable>& colorTable =
-      aFrame.getColorGrayscaleTable();
 
-   // ESH 03/2009 -- Partial fix for ticket #646.
-   // Crash fix on reading RPFs: Make sure the colorTable vector 
-   // has entries before trying to make use of them. 
-   int numTables = (int)colorTable.size();
-   if ( numTables <= 0 )
-   {
-      return;
-   }
-
-   ossim_uint8 *tempRows[3];
-   
-   tempRows[0] = theUncompressedBuffer;
-   tempRows[1] = (theUncompressedBuffer + 256*256);
-   tempRows[2] = (tempRows[1] + 256*256);
-   
    // find the shift to 0,0
    ossimIpt tempDelta(clipRect.ul().x - frameEntryData.thePixelCol,
                       clipRect.ul().y - frameEntryData.thePixelRow);
    
-   
    // In order to compute the subframe we will need the corner offsets of
    // the upper left of the frame and the upper left of the clip rect.  The
    // clip rect should be completely within the frame.  This just translates the value
@@ -816,223 +761,178 @@ void ossimCibCadrgTileSource::fillSubTileCadrg(
    // we will be uncompressing them.  Note CADRG is a 256x256 tile
    // compressed to 64x64x12 bit data
    //
-    ossimIrect subFrameRect(offsetRect.ul().x/256,
-                            offsetRect.ul().y/256,
-                            (offsetRect.lr().x)/256,
-                            (offsetRect.lr().y)/256);
-   
-   ossim_uint32 readPtr  = 0;
-
+   ossimIrect subFrameRect(offsetRect.ul().x/256,
+                           offsetRect.ul().y/256,
+                           (offsetRect.lr().x)/256,
+                           (offsetRect.lr().y)/256);
+
+   const ossim_uint32 BANDS = (theProductType == OSSIM_PRODUCT_TYPE_CIB) ? 1 : 3;
+   const ossim_uint32 SUBFRAME_BYTES = 256*256*BANDS;
+   const ossimFilename framePath = frameEntryData.theFrameEntry.getFullPath();
+   ossimRpfSubframeCache* cache = ossimRpfSubframeCache::instance();
+
+   // Gather the subframes, picking up what we can from the cache:
+   vector<ossimIpt> subframes;
+   vector<ossimRpfSubframeCache::SubframeBuffer> buffers;
+   vector<ossim_uint32> missing;
    ossim_int32 row = 0;
    ossim_int32 col = 0;
-   ossim_uint32 i = 0;
-   ossim_uint32 j = 0;
-   ossim_int32 upperY = subFrameRect.lr().y;
-   ossim_int32 upperX = subFrameRect.lr().x;
-   ossim_int32 lowerY = subFrameRect.ul().y;
-   ossim_int32 lowerX = subFrameRect.ul().x; 
-   for(row = lowerY; row <= upperY; ++row)
+   for(row = subFrameRect.ul().y; row <= subFrameRect.lr().y; ++row)
    {
-      for(col = lowerX; col <= upperX; ++col)
+      for(col = subFrameRect.ul().x; col <= subFrameRect.lr().x; ++col)
       {
-         readPtr = 0;
-         if(aFrame.fillSubFrameBuffer(theCompressedBuffer, 0, row, col))
+         subframes.push_back(ossimIpt(col, row));
+         buffers.push_back(cache->getSubframe(framePath, row, col));
+         if ( !buffers.back() )
          {
-            for (i = 0; i < 256; i += 4)
-            {
-               for (j = 0; j < 256; j += 8)
-               {
-                  ossim_uint16 firstByte  = theCompressedBuffer[readPtr++] & 0xff;
-                  ossim_uint16 secondByte = theCompressedBuffer[readPtr++] & 0xff;
-                  ossim_uint16 thirdByte  = theCompressedBuffer[readPtr++] & 0xff;
-                  
-                  //because dealing with half-bytes is hard, we
-                  //uncompress two 4x4 tiles at the same time. (a
-                  //4x4 tile compressed is 12 bits )
-                  // this little code was grabbed from openmap software.
-                  
-                  /* Get first 12-bit value as index into VQ table */
-                  // I think we need to swap
-                  ossim_uint16 val1 = (firstByte << 4) | (secondByte >> 4);
-                  
-                  /* Get second 12-bit value as index into VQ table*/
-                  ossim_uint16 val2 = ((secondByte & 0x000F) << 8) | thirdByte;
-                  
-                  for (ossim_uint32 t = 0; t < 4; ++t)
-                  {
-                     for (ossim_uint32 e = 0; e < 4; ++e)
-                     {
-                        ossim_uint16 tableVal1 = compressionSection->getTable()[t].theData[val1*4 + e] & 0xff;
-                        ossim_uint16 tableVal2 = compressionSection->getTable()[t].theData[val2*4 + e] & 0xff;
-
-                        ossim_uint32 pixindex = ((i+t)*256) +
-                                                 (j + e);
-                        const ossim_uint8* color1 = colorTable[0].getStartOfData(tableVal1);
-                        const ossim_uint8* color2 = colorTable[0].getStartOfData(tableVal2);
-                        
-                        
-                        tempRows[0][pixindex] = color1[0];
-                        tempRows[1][pixindex] = color1[1];
-                        tempRows[2][pixindex] = color1[2];
-                        
-                        tempRows[0][pixindex+4] = color2[0];
-                        tempRows[1][pixindex+4] = color2[1];
-                        tempRows[2][pixindex+4] = color2[2];
-                     } //for e
-                  } //for t
-               }  /* for j */
-            } //for i
+            missing.push_back( (ossim_uint32)(buffers.size() - 1) );
          }
-         else
+      }
+   }
+
+   if ( missing.size() )
+   {
+      if(theWorkFrame->parseFile(framePath) != ossimErrorCodes::OSSIM_OK)
+      {
+         return;
+      }
+      
+      const ossimRpfCompressionSection* compressionSection =
+         theWorkFrame->getCompressionSection();
+      if ( !compressionSection || (compressionSection->getTable().size() < 4) )
+      {
+         return;
+      }
+      
+      const vector<ossimRpfColorGrayscaleTable>& colorTable =
+         theWorkFrame->getColorGrayscaleTable();
+      
+      // ESH 03/2009 -- Partial fix for ticket #646.
+      // Crash fix on reading RPFs: Make sure the colorTable vector 
+      // has entries before trying to make use of them. 
+      int numTables = (int)colorTable.size();
+      if ( numTables <= 0 )
+      {
+         return;
+      }
+
+      // Band sequential copy of the color table so decode is a plain lookup.
+      vector<ossim_uint8> palette(256*BANDS, 0);
+      ossim_uint32 entries = std::min<ossim_uint32>(
+         256, (ossim_uint32)colorTable[0].getNumberOfElements() );
+      for ( ossim_uint32 entry = 0; entry < entries; ++entry )
+      {
+         const ossim_uint8* color = colorTable[0].getStartOfData(entry);
+         for ( ossim_uint32 band = 0; band < BANDS; ++band )
          {
-            memset(theUncompressedBuffer, 0, 256*256*3);
+            palette[band*256 + entry] = color[band];
          }
-         ossim_int32 tempCol = col*256;
-         ossim_int32 tempRow = row*256;
-         ossimIrect subRectToFill(frameRect.ul().x + tempCol,
-                                  frameRect.ul().y + tempRow,
-                                  frameRect.ul().x + tempCol + 255,
-                                  frameRect.ul().y + tempRow + 255);
-         tile->loadTile(theUncompressedBuffer,
-                        subRectToFill,
-                        OSSIM_BSQ);
       }
-   }
-}
 
-void ossimCibCadrgTileSource::fillSubTileCib(
-   const ossimRpfFrame&  aFrame,
-   const ossimIrect& tileRect,
-   const ossimFrameEntryData& frameEntryData,
-   ossimImageData* tile)
-{
-   // first let's grab the absolute position of the frame rectangle in pixel
-   // space
-   ossimIrect frameRect(frameEntryData.thePixelCol,
-                        frameEntryData.thePixelRow,
-                        frameEntryData.thePixelCol + CIBCADRG_FRAME_WIDTH  - 1,
-                        frameEntryData.thePixelRow + CIBCADRG_FRAME_HEIGHT - 1);
+      vector< std::shared_ptr< vector<ossim_uint8> > > decoded( missing.size() );
+      const ossimRpfFrame& aFrame = *theWorkFrame;
+      ossim::parallelFor( (ossim_uint32)missing.size(), theDecodeThreads,
+                          [&](ossim_uint32 i)
+      {
+         const ossimIpt& sf = subframes[ missing[i] ];
+         decoded[i] = std::make_shared< vector<ossim_uint8> >(SUBFRAME_BYTES);
+         decodeSubframe(aFrame, &palette.front(), sf.y, sf.x, &decoded[i]->front());
+      } );
 
-   
-   // now clip it to the tile
-   ossimIrect clipRect = tileRect.clipToRect(frameRect);
+      for ( ossim_uint32 i = 0; i < missing.size(); ++i )
+      {
+         const ossimIpt& sf = subframes[ missing[i] ];
+         buffers[ missing[i] ] = decoded[i];
+         cache->addSubframe(framePath, sf.y, sf.x, decoded[i]);
+      }
+   }
 
-   const ossimRpfCompressionSection* compressionSection = aFrame.getCompressionSection();
-   
-   if(!compressionSection)
+   for ( ossim_uint32 i = 0; i < subframes.size(); ++i )
    {
-      return;
+      ossim_int32 tempCol = subframes[i].x*256;
+      ossim_int32 tempRow = subframes[i].y*256;
+      ossimIrect subRectToFill(frameRect.ul().x + tempCol,
+                               frameRect.ul().y + tempRow,
+                               frameRect.ul().x + tempCol + 255,
+                               frameRect.ul().y + tempRow + 255);
+      tile->loadTile((void*)&buffers[i]->front(),
+                     subRectToFill,
+                     OSSIM_BSQ);
    }
+}
 
-   const vector<ossimRpfColorGrayscaleTable>& colorTable =
-      aFrame.getColorGrayscaleTable();
+bool ossimCibCadrgTileSource::decodeSubframe(const ossimRpfFrame& aFrame,
+                                             const ossim_uint8* palette,
+                                             ossim_uint32 row,
+                                             ossim_uint32 col,
+                                             ossim_uint8* buffer)const
+{
+   const ossim_uint32 BANDS = (theProductType == OSSIM_PRODUCT_TYPE_CIB) ? 1 : 3;
+   const ossim_uint32 PLANE = 256*256;
 
-   // ESH 03/2009 -- Partial fix for ticket #646.
-   // Crash fix on reading RPFs: Make sure the colorTable vector 
-   // has entries before trying to make use of them. 
-   int numTables = (int)colorTable.size();
-   if ( numTables <= 0 )
+   // A CADRG and CIB is a 64*64*12 bit buffer; divide by 8 to convert to bytes.
+   ossim_uint8 compressed[(64*64*12)/8];
+   if ( !aFrame.fillSubFrameBuffer(compressed, 0, row, col) )
    {
-      return;
+      memset(buffer, 0, PLANE*BANDS);
+      return false;
    }
 
-   // check to see if it does overlap.  If it doesn't then the width and height
-   // will be a single point
-   {
-      ossim_uint8 *tempRow;
+   const vector<ossimRpfCompressionOffsetTableData>& vqTable =
+      aFrame.getCompressionSection()->getTable();
 
-      tempRow = theUncompressedBuffer;
-      
-      // find the shift to 0,0
-      ossimIpt tempDelta(clipRect.ul().x - frameEntryData.thePixelCol,
-                         clipRect.ul().y - frameEntryData.thePixelRow);
-      
-      // In order to compute the subframe we will need the corner offsets of
-      // the upper left of the frame and the upper left of the clip rect.  The
-      // clip rect should be completely within the frame.  This just translates the value
-      // to make the upper left of the frame be 0,0.
-      //
-      ossimIrect offsetRect(tempDelta.x,
-                            tempDelta.y,
-                            tempDelta.x + clipRect.width()-1,
-                            tempDelta.y + clipRect.height()-1);
-
-      // each subframe is 64x64.  We will actually use 256x256 since
-      // we will be uncompressing them.  Note CADRG is a 256x256 tile
-      // compressed to 64x64x12 bit data
-      //
-      ossimIrect subFrameRect(offsetRect.ul().x/256,
-                              offsetRect.ul().y/256,
-                              (offsetRect.lr().x)/256,
-                              (offsetRect.lr().y)/256);
-
-      ossim_int32 row = 0;
-      ossim_int32 col = 0;
-      ossim_uint32 i = 0;
-      ossim_uint32 j = 0;
-      ossim_uint32 readPtr = 0;
-      for(row = subFrameRect.ul().y; row <= subFrameRect.lr().y; ++row)
+   //---
+   // Pass 1: expand the 12 bit codes into color table indexes.  Each code
+   // is a 4x4 block; each row of the block is 4 contiguous bytes of the
+   // table for that row.  Indexes go into the last band plane so pass 2 can
+   // run in place.
+   //---
+   ossim_uint8* indexes = buffer + (BANDS-1)*PLANE;
+   ossim_uint32 readPtr = 0;
+   for (ossim_uint32 i = 0; i < 256; i += 4)
+   {
+      for (ossim_uint32 j = 0; j < 256; j += 8)
       {
-         for(col = subFrameRect.ul().x; col <= subFrameRect.lr().x; ++col)
+         ossim_uint16 firstByte  = compressed[readPtr++] & 0xff;
+         ossim_uint16 secondByte = compressed[readPtr++] & 0xff;
+         ossim_uint16 thirdByte  = compressed[readPtr++] & 0xff;
+         
+         //because dealing with half-bytes is hard, we
+         //uncompress two 4x4 tiles at the same time. (a
+         //4x4 tile compressed is 12 bits )
+         // this little code was grabbed from openmap software.
+         
+         /* Get first 12-bit value as index into VQ table */
+         ossim_uint16 val1 = (firstByte << 4) | (secondByte >> 4);
+         
+         /* Get second 12-bit value as index into VQ table*/
+         ossim_uint16 val2 = ((secondByte & 0x000F) << 8) | thirdByte;
+         
+         for (ossim_uint32 t = 0; t < 4; ++t)
          {
-            readPtr = 0;
-            if(aFrame.fillSubFrameBuffer(theCompressedBuffer, 0, row, col))
-            {
-               for (i = 0; i < 256; i += 4)
-               {
-                  for (j = 0; j < 256; j += 8)
-                  {
-                     ossim_uint16 firstByte  = theCompressedBuffer[readPtr++] & 0xff;
-                     ossim_uint16 secondByte = theCompressedBuffer[readPtr++] & 0xff;
-                     ossim_uint16 thirdByte  = theCompressedBuffer[readPtr++] & 0xff;
-                     
-                     //because dealing with half-bytes is hard, we
-                     //uncompress two 4x4 tiles at the same time. (a
-                     //4x4 tile compressed is 12 bits )
-                     // this little code was grabbed from openmap software.
-                     
-                     /* Get first 12-bit value as index into VQ table */
-                     // I think we need to swap
-                     ossim_uint16 val1 = (firstByte << 4) | (secondByte >> 4);
-                     
-                     /* Get second 12-bit value as index into VQ table*/
-                     ossim_uint16 val2 = ((secondByte & 0x000F) << 8) | thirdByte;
-
-                     for (ossim_uint32 t = 0; t < 4; ++t)
-                     {
-                        for (ossim_uint32 e = 0; e < 4; ++e)
-                        {
-                           ossim_uint16 tableVal1 = compressionSection->getTable()[t].theData[val1*4 + e] & 0xff;
-                           ossim_uint16 tableVal2 = compressionSection->getTable()[t].theData[val2*4 + e] & 0xff;
-
-                           ossim_uint32 pixindex = ((i+t)*256) + (j + e);
-                           const ossim_uint8* color1 = colorTable[0].getStartOfData(tableVal1);
-                           const ossim_uint8* color2 = colorTable[0].getStartOfData(tableVal2);
-
-                           
-                           tempRow[pixindex]      = color1[0];
-                           tempRow[pixindex + 4]  = color2[0];
-                        } //for e
-                     } //for t
-                  }  /* for j */
-               } //for i
-            }
-            else
-            {
-               memset(theUncompressedBuffer, 0, 256*256);
-            }
-            ossim_int32 tCol = col*256;
-            ossim_int32 tRow = row*256;
-            ossimIrect subRectToFill(frameRect.ul().x + tCol,
-                                     frameRect.ul().y + tRow,
-                                     frameRect.ul().x + tCol + 255,
-                                     frameRect.ul().y + tRow + 255);
-            tile->loadTile(theUncompressedBuffer,
-                           subRectToFill,
-                           OSSIM_BSQ);
+            ossim_uint8* dest = indexes + (i+t)*256 + j;
+            memcpy(dest,     vqTable[t].theData + val1*4, 4);
+            memcpy(dest + 4, vqTable[t].theData + val2*4, 4);
          }
       }
-   }  
+   }
+
+   //---
+   // Pass 2: color table lookup one band at a time.  Branch free loop over
+   // contiguous memory.  The index plane is the last band so it is done
+   // last, in place.
+   //---
+   for (ossim_uint32 band = 0; band < BANDS; ++band)
+   {
+      const ossim_uint8* lut = palette + band*256;
+      ossim_uint8* out = buffer + band*PLANE;
+      for (ossim_uint32 p = 0; p < PLANE; ++p)
+      {
+         out[p] = lut[ indexes[p] ];
+      }
+   }
+
+   return true;
 }
 
 void ossimCibCadrgTileSource::allocateForProduct()
@@ -1047,30 +947,6 @@ void ossimCibCadrgTileSource::allocateForProduct()
       delete theWorkFrame;
    }  
    theWorkFrame = new ossimRpfFrame;
-
-   if(theCompressedBuffer)
-   {
-      delete [] theCompressedBuffer;
-   }
-
-   //---
-   // A CADRG and CIBis a 64*64*12 bit buffer and must divide by 8 to convert
-   // to bytes.
-   //---
-   theCompressedBuffer   = new ossim_uint8[(64*64*12)/8];
-   
-   if(theUncompressedBuffer)
-   {
-      delete [] theUncompressedBuffer;
-   }
-   if(theProductType == OSSIM_PRODUCT_TYPE_CIB)
-   {
-      theUncompressedBuffer = new ossim_uint8[256*256];
-   }
-   else
-   {
-      theUncompressedBuffer = new ossim_uint8[256*256*3];
-   }   
    
    theTile = ossimImageDataFactory::instance()->create(this, this);
    theTile->initialize();
@@ -55,6 +55,20 @@ ossimRefPtr<ossimImageData> ossimConvolutionFilter1D::getTile(
       return theInputConnection->getTile(tileRect, resLevel);
    }
 
+   ossimRefPtr<ossimImageData> data = theInputConnection->getTile(getInputRect(tileRect),
+                                                                  resLevel);
+
+   if(!data.valid() || !data->getBuf())
+   {
+      return data;
+   }
+
+   ossimRefPtr<ossimImageData> result = convolveTile(data, tileRect);
+   return result.valid() ? result : data;
+}
+
+ossimIrect ossimConvolutionFilter1D::getInputRect(const ossimIrect& tileRect) const
+{
    //---
    // We have a 1xn or nx1 matrix, + a center offset
    // so stretch the input rect out to cover the required pixels
@@ -75,21 +89,20 @@ ossimRefPtr<ossimImageData> ossimConvolutionFilter1D::getTile(
                            ossimIpt(tileRect.lr().x,
                                     tileRect.lr().y - theCenterOffset + kl -1));
    }
-   ossimRefPtr<ossimImageData> data = theInputConnection->getTile(newRect,
-                                                                  resLevel);
-
-   if(!data.valid() || !data->getBuf())
-   {
-      return data;
-   }
+   return newRect;
+}
 
+ossimRefPtr<ossimImageData> ossimConvolutionFilter1D::convolveTile(
+   ossimRefPtr<ossimImageData> data,
+   const ossimIrect& tileRect)
+{
     // First time through or after an initialize()...
    if (!theTile.valid())
    {
       allocate();
       if (!theTile.valid()) // Should never happen!
       {
-         return data;
+         return 0;
       }
    }
 
@@ -99,7 +112,7 @@ ossimRefPtr<ossimImageData> ossimConvolutionFilter1D::getTile(
       computeNullMinMax();
       if (!theNullPixValue.size()) // Should never happen!
       {
-         return data;
+         return 0;
       }
    }
 
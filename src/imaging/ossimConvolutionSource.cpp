@@ -343,6 +343,15 @@ void ossimConvolutionSource::convolve(T /* dummyVariable */,
    }
    else  // do not need to check for nulls here.
    {
+      // Separable or cache blocked engine over a contiguous copy:
+      std::vector<double> minPixels(outputBands, minPix);
+      std::vector<double> maxPixels(outputBands, maxPix);
+      if(kernel->convolveFull(inputTile.get(), theTile.get(),
+                              &minPixels.front(), &maxPixels.front()))
+      {
+         return;
+      }
+      
       for(long b = 0; b < outputBands; ++b)
       {                  
          double convolveResult = 0;
@@ -0,0 +1,680 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/imaging/ossimDecimator.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
+#include <ossim/base/ossimIrect.h>
+#include <ossim/base/ossimNotify.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define OSSIM_DECIMATOR_AVX2 1
+#  include <immintrin.h>
+#  define OSSIM_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace
+{
+   // Output rows per block:
+   const ossim_int32 BLOCK_ROWS = 32;
+
+   // Lanczos-3 halving, 6 input pixels either side of the block center:
+   const ossim_int32 LANCZOS_TAPS   = 12;
+   const ossim_int32 LANCZOS_MARGIN = 5;
+
+   // Least weight of valid pixels for a valid output, of 4 for the 2 x 2 reducers and of 1 for
+   // Lanczos:
+   const double MIN_WEIGHT = 0.5;
+
+   // Samples are reduced as float, as double for 32 bit integers and double data:
+   template <class T> struct Accum                { typedef ossim_float32 type; };
+   template <>        struct Accum<ossim_uint32>  { typedef ossim_float64 type; };
+   template <>        struct Accum<ossim_sint32>  { typedef ossim_float64 type; };
+   template <>        struct Accum<ossim_float64> { typedef ossim_float64 type; };
+
+   ossim_int32 floorDiv2(ossim_int32 a)
+   {
+      return (a >= 0) ? (a / 2) : -((-a + 1) / 2);
+   }
+
+   // 1D Lanczos-3 taps of a halving, summing to 1:
+   template <class F>
+   const F* lanczosWeights()
+   {
+      struct Table
+      {
+         Table()
+         {
+            double w[LANCZOS_TAPS];
+            double sum = 0.0;
+            for (ossim_int32 k = 0; k < LANCZOS_TAPS; ++k)
+            {
+               // Tap k is (k - 5.5) input pixels off the block center, half that in output pixels:
+               const double T = M_PI * (k - 5.5) / 2.0;
+               w[k] = 3.0 * std::sin(T) * std::sin(T / 3.0) / (T * T);
+               sum += w[k];
+            }
+            for (ossim_int32 k = 0; k < LANCZOS_TAPS; ++k)
+            {
+               weights[k] = static_cast<F>(w[k] / sum);
+            }
+         }
+         F weights[LANCZOS_TAPS];
+      };
+      static const Table TABLE;
+      return TABLE.weights;
+   }
+
+   //---
+   // Row loops. The AVX2 ones give the same bits, nothing is fused or reordered.
+   //---
+
+   // v = s where valid, else 0; m = 1 where valid, else 0. NaNs are null.
+   template <class T, class F>
+   void loadLoop(const T* s, ossim_uint32 n, F nullPix, F* v, F* m)
+   {
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         const F X = static_cast<F>(s[i]);
+         const bool VALID = (X == X) && (X != nullPix);
+         v[i] = VALID ? X : F(0);
+         m[i] = VALID ? F(1) : F(0);
+      }
+   }
+
+   template <class F>
+   void axpyLoop(F* d, const F* s, F w, ossim_uint32 n)
+   {
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         d[i] = d[i] + w * s[i];
+      }
+   }
+
+   template <class F>
+   void pairSumLoop(const F* s, F* d, ossim_uint32 n)
+   {
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         d[i] = s[2 * i] + s[2 * i + 1];
+      }
+   }
+
+   // d = v / w, rounded for integer data and limited to [minPix, maxPix]; null where w < minWeight.
+   template <class T, class F>
+   void storeLoop(const F* v, const F* w, T* d, ossim_uint32 n, F minWeight,
+                  F nullPix, F minPix, F maxPix)
+   {
+      for (ossim_uint32 i = 0; i < n; ++i)
+      {
+         if (w[i] < minWeight)
+         {
+            d[i] = static_cast<T>(nullPix);
+         }
+         else
+         {
+            F r = v[i] / w[i];
+            if (std::numeric_limits<T>::is_integer)
+            {
+               r = std::floor(r + F(0.5));
+            }
+            r = (r < minPix) ? minPix : r;
+            r = (r > maxPix) ? maxPix : r;
+            d[i] = static_cast<T>(r);
+         }
+      }
+   }
+
+#ifdef OSSIM_DECIMATOR_AVX2
+   OSSIM_AVX2 __m256 loadPs(const ossim_uint8* s)
+   {
+      return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)s)));
+   }
+   OSSIM_AVX2 __m256 loadPs(const ossim_sint8* s)
+   {
+      return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)s)));
+   }
+   OSSIM_AVX2 __m256 loadPs(const ossim_uint16* s)
+   {
+      return _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)s)));
+   }
+   OSSIM_AVX2 __m256 loadPs(const ossim_sint16* s)
+   {
+      return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)s)));
+   }
+   OSSIM_AVX2 __m256 loadPs(const ossim_float32* s)
+   {
+      return _mm256_loadu_ps(s);
+   }
+
+   // Values are whole and in range when stored, the saturating packs only narrow them:
+   OSSIM_AVX2 void storePs(__m256 r, ossim_uint8* d)
+   {
+      const __m256i I = _mm256_cvtps_epi32(r);
+      const __m128i W = _mm_packus_epi32(_mm256_castsi256_si128(I), _mm256_extracti128_si256(I, 1));
+      _mm_storel_epi64((__m128i*)d, _mm_packus_epi16(W, W));
+   }
+   OSSIM_AVX2 void storePs(__m256 r, ossim_sint8* d)
+   {
+      const __m256i I = _mm256_cvtps_epi32(r);
+      const __m128i W = _mm_packs_epi32(_mm256_castsi256_si128(I), _mm256_extracti128_si256(I, 1));
+      _mm_storel_epi64((__m128i*)d, _mm_packs_epi16(W, W));
+   }
+   OSSIM_AVX2 void storePs(__m256 r, ossim_uint16* d)
+   {
+      const __m256i I = _mm256_cvtps_epi32(r);
+      _mm_storeu_si128((__m128i*)d,
+                       _mm_packus_epi32(_mm256_castsi256_si128(I), _mm256_extracti128_si256(I, 1)));
+   }
+   OSSIM_AVX2 void storePs(__m256 r, ossim_sint16* d)
+   {
+      const __m256i I = _mm256_cvtps_epi32(r);
+      _mm_storeu_si128((__m128i*)d,
+                       _mm_packs_epi32(_mm256_castsi256_si128(I), _mm256_extracti128_si256(I, 1)));
+   }
+   OSSIM_AVX2 void storePs(__m256 r, ossim_float32* d)
+   {
+      _mm256_storeu_ps(d, r);
+   }
+
+   // Types with AVX2 loops:
+   template <class T> struct HasAvx2                { enum { value = 0 }; };
+   template <>        struct HasAvx2<ossim_uint8>   { enum { value = 1 }; };
+   template <>        struct HasAvx2<ossim_sint8>   { enum { value = 1 }; };
+   template <>        struct HasAvx2<ossim_uint16>  { enum { value = 1 }; };
+   template <>        struct HasAvx2<ossim_sint16>  { enum { value = 1 }; };
+   template <>        struct HasAvx2<ossim_float32> { enum { value = 1 }; };
+
+   template <class T>
+   OSSIM_AVX2 void loadAvx2(const T* s, ossim_uint32 n, ossim_float32 nullPix,
+                            ossim_float32* v, ossim_float32* m)
+   {
+      const __m256 NP  = _mm256_set1_ps(nullPix);
+      const __m256 ONE = _mm256_set1_ps(1.0f);
+      const ossim_uint32 END = n - n % 8;
+      for (ossim_uint32 i = 0; i < END; i += 8)
+      {
+         const __m256 X = loadPs(s + i);
+         // Ordered compares, false for NaN:
+         const __m256 VALID = _mm256_cmp_ps(X, NP, _CMP_NEQ_OQ);
+         _mm256_storeu_ps(v + i, _mm256_and_ps(X, VALID));
+         _mm256_storeu_ps(m + i, _mm256_and_ps(ONE, VALID));
+      }
+      loadLoop(s + END, n - END, nullPix, v + END, m + END);
+   }
+
+   OSSIM_AVX2 void axpyAvx2(ossim_float32* d, const ossim_float32* s, ossim_float32 w,
+                            ossim_uint32 n)
+   {
+      const __m256 W = _mm256_set1_ps(w);
+      const ossim_uint32 END = n - n % 8;
+      for (ossim_uint32 i = 0; i < END; i += 8)
+      {
+         _mm256_storeu_ps(d + i, _mm256_add_ps(_mm256_loadu_ps(d + i),
+                                               _mm256_mul_ps(W, _mm256_loadu_ps(s + i))));
+      }
+      axpyLoop(d + END, s + END, w, n - END);
+   }
+
+   OSSIM_AVX2 void pairSumAvx2(const ossim_float32* s, ossim_float32* d, ossim_uint32 n)
+   {
+      const ossim_uint32 END = n - n % 8;
+      for (ossim_uint32 i = 0; i < END; i += 8)
+      {
+         // hadd sums pairs within 128 bit lanes, the permute puts them back in order:
+         const __m256 H = _mm256_hadd_ps(_mm256_loadu_ps(s + 2 * i), _mm256_loadu_ps(s + 2 * i + 8));
+         _mm256_storeu_ps(d + i, _mm256_castpd_ps(
+                             _mm256_permute4x64_pd(_mm256_castps_pd(H), _MM_SHUFFLE(3, 1, 2, 0))));
+      }
+      pairSumLoop(s + 2 * END, d + END, n - END);
+   }
+
+   template <class T>
+   OSSIM_AVX2 void storeAvx2(const ossim_float32* v, const ossim_float32* w, T* d, ossim_uint32 n,
+                             ossim_float32 minWeight, ossim_float32 nullPix,
+                             ossim_float32 minPix, ossim_float32 maxPix)
+   {
+      const bool INTEGER = std::numeric_limits<T>::is_integer;
+      const __m256 MIN_WEIGHT_V = _mm256_set1_ps(minWeight);
+      const __m256 NP   = _mm256_set1_ps(nullPix);
+      const __m256 MINV = _mm256_set1_ps(minPix);
+      const __m256 MAXV = _mm256_set1_ps(maxPix);
+      const __m256 HALF = _mm256_set1_ps(0.5f);
+      const ossim_uint32 END = n - n % 8;
+      for (ossim_uint32 i = 0; i < END; i += 8)
+      {
+         const __m256 W = _mm256_loadu_ps(w + i);
+         __m256 r = _mm256_div_ps(_mm256_loadu_ps(v + i), W);
+         if (INTEGER)
+         {
+            r = _mm256_floor_ps(_mm256_add_ps(r, HALF));
+         }
+         // max_ps(a, b) is a > b ? a : b, as the plain loop has it:
+         r = _mm256_max_ps(MINV, r);
+         r = _mm256_min_ps(MAXV, r);
+         r = _mm256_blendv_ps(NP, r, _mm256_cmp_ps(W, MIN_WEIGHT_V, _CMP_GE_OQ));
+         storePs(r, d + i);
+      }
+      storeLoop(v + END, w + END, d + END, n - END, minWeight, nullPix, minPix, maxPix);
+   }
+
+   // Dispatch, false where there is no AVX2 loop:
+   template <class T, class F, bool AVX2 = (HasAvx2<T>::value != 0)>
+   struct Avx2
+   {
+      static bool load(const T*, ossim_uint32, F, F*, F*) { return false; }
+      static bool axpy(F*, const F*, F, ossim_uint32) { return false; }
+      static bool pairSum(const F*, F*, ossim_uint32) { return false; }
+      static bool store(const F*, const F*, T*, ossim_uint32, F, F, F, F) { return false; }
+   };
+
+   template <class T>
+   struct Avx2<T, ossim_float32, true>
+   {
+      typedef ossim_float32 F;
+      static bool load(const T* s, ossim_uint32 n, F nullPix, F* v, F* m)
+      {
+         loadAvx2(s, n, nullPix, v, m);
+         return true;
+      }
+      static bool axpy(F* d, const F* s, F w, ossim_uint32 n)
+      {
+         axpyAvx2(d, s, w, n);
+         return true;
+      }
+      static bool pairSum(const F* s, F* d, ossim_uint32 n)
+      {
+         pairSumAvx2(s, d, n);
+         return true;
+      }
+      static bool store(const F* v, const F* w, T* d, ossim_uint32 n, F minWeight,
+                        F nullPix, F minPix, F maxPix)
+      {
+         storeAvx2(v, w, d, n, minWeight, nullPix, minPix, maxPix);
+         return true;
+      }
+   };
+#endif /* #ifdef OSSIM_DECIMATOR_AVX2 */
+
+   // Row loops of one band, AVX2 when on:
+   template <class T>
+   class Rows
+   {
+   public:
+      typedef typename Accum<T>::type F;
+
+      Rows()
+#ifdef OSSIM_DECIMATOR_AVX2
+         : m_avx2(ossimImageDataKernels::getIsa() == ossimImageDataKernels::ISA_AVX2)
+#endif
+      {
+      }
+
+      void load(const T* s, ossim_uint32 n, F nullPix, F* v, F* m) const
+      {
+#ifdef OSSIM_DECIMATOR_AVX2
+         if (m_avx2 && Avx2<T, F>::load(s, n, nullPix, v, m))
+            return;
+#endif
+         loadLoop(s, n, nullPix, v, m);
+      }
+
+      void axpy(F* d, const F* s, F w, ossim_uint32 n) const
+      {
+#ifdef OSSIM_DECIMATOR_AVX2
+         if (m_avx2 && Avx2<T, F>::axpy(d, s, w, n))
+            return;
+#endif
+         axpyLoop(d, s, w, n);
+      }
+
+      void pairSum(const F* s, F* d, ossim_uint32 n) const
+      {
+#ifdef OSSIM_DECIMATOR_AVX2
+         if (m_avx2 && Avx2<T, F>::pairSum(s, d, n))
+            return;
+#endif
+         pairSumLoop(s, d, n);
+      }
+
+      void store(const F* v, const F* w, T* d, ossim_uint32 n, F minWeight,
+                 F nullPix, F minPix, F maxPix) const
+      {
+#ifdef OSSIM_DECIMATOR_AVX2
+         if (m_avx2 && Avx2<T, F>::store(v, w, d, n, minWeight, nullPix, minPix, maxPix))
+            return;
+#endif
+         storeLoop(v, w, d, n, minWeight, nullPix, minPix, maxPix);
+      }
+
+   private:
+#ifdef OSSIM_DECIMATOR_AVX2
+      bool m_avx2;
+#endif
+   };
+
+   // Most common valid value of a 2 x 2 block, the first in raster order on a tie:
+   template <class F>
+   bool modeOf(const F* v, const F* m, F& value)
+   {
+      ossim_int32 best = 0;
+      for (ossim_int32 i = 0; i < 4; ++i)
+      {
+         if (m[i] == F(0))
+         {
+            continue;
+         }
+         ossim_int32 count = 0;
+         for (ossim_int32 j = 0; j < 4; ++j)
+         {
+            if ( (m[j] != F(0)) && (v[j] == v[i]) )
+            {
+               ++count;
+            }
+         }
+         if (count > best)
+         {
+            best  = count;
+            value = v[i];
+         }
+      }
+      return best > 0;
+   }
+
+   // Halves one band of input into region of output:
+   template <class T>
+   void decimateBand(const ossimImageData* input, ossimImageData* output, ossim_uint32 band,
+                     ossimDecimator::Method method, const ossimIrect& region)
+   {
+      typedef typename Accum<T>::type F;
+      const Rows<T> ROWS;
+
+      const ossim_int32 MARGIN = static_cast<ossim_int32>(ossimDecimator::getMargin(method));
+      const ossim_int32 OW     = region.width();
+      const ossim_int32 IX0    = 2 * region.ul().x - MARGIN;
+      const ossim_int32 IW     = 2 * OW + 2 * MARGIN;
+
+      const ossimIrect IN_RECT = input->getImageRectangle();
+      const ossim_int32 IN_W   = IN_RECT.width();
+      const T* IN_BUF = static_cast<const T*>(input->getBuf(band));
+      const bool HAS_DATA = IN_BUF && (input->getDataObjectStatus() != OSSIM_NULL) &&
+         (input->getDataObjectStatus() != OSSIM_EMPTY);
+      const F IN_NULL = static_cast<F>(input->getNullPix(band));
+
+      const ossimIrect OUT_RECT = output->getImageRectangle();
+      const ossim_int32 OUT_W   = OUT_RECT.width();
+      T* outBuf = static_cast<T*>(output->getBuf(band));
+      const F OUT_NULL = static_cast<F>(output->getNullPix(band));
+      const F OUT_MIN  = static_cast<F>(output->getMinPix(band));
+      const F OUT_MAX  = static_cast<F>(output->getMaxPix(band));
+
+      // Input rows of a block as values and weights:
+      const ossim_int32 BLOCK_IN_ROWS = 2 * BLOCK_ROWS + 2 * MARGIN;
+      std::vector<F> values(BLOCK_IN_ROWS * IW);
+      std::vector<F> weights(BLOCK_IN_ROWS * IW);
+
+      // Work rows:
+      std::vector<F> sumV(IW);
+      std::vector<F> sumM(IW);
+      std::vector<F> outV(OW);
+      std::vector<F> outM(OW);
+      std::vector<F> evenV(IW / 2);
+      std::vector<F> oddV(IW / 2);
+      std::vector<F> evenM(IW / 2);
+      std::vector<F> oddM(IW / 2);
+      const F* LANCZOS = lanczosWeights<F>();
+
+      for (ossim_int32 oy0 = region.ul().y; oy0 <= region.lr().y; oy0 += BLOCK_ROWS)
+      {
+         const ossim_int32 OY1    = std::min(oy0 + BLOCK_ROWS - 1, region.lr().y);
+         const ossim_int32 IY0    = 2 * oy0 - MARGIN;
+         const ossim_int32 IN_ROWS = 2 * (OY1 - oy0 + 1) + 2 * MARGIN;
+
+         for (ossim_int32 r = 0; r < IN_ROWS; ++r)
+         {
+            const ossim_int32 Y = IY0 + r;
+            F* v = &values[r * IW];
+            F* m = &weights[r * IW];
+            std::fill(v, v + IW, F(0));
+            std::fill(m, m + IW, F(0));
+            const ossim_int32 X0 = std::max(IX0, IN_RECT.ul().x);
+            const ossim_int32 X1 = std::min(IX0 + IW - 1, IN_RECT.lr().x);
+            if ( HAS_DATA && (Y >= IN_RECT.ul().y) && (Y <= IN_RECT.lr().y) && (X0 <= X1) )
+            {
+               ROWS.load(IN_BUF + (Y - IN_RECT.ul().y) * IN_W + (X0 - IN_RECT.ul().x),
+                         static_cast<ossim_uint32>(X1 - X0 + 1), IN_NULL, v + (X0 - IX0),
+                         m + (X0 - IX0));
+            }
+         }
+
+         for (ossim_int32 oy = oy0; oy <= OY1; ++oy)
+         {
+            // First input row of this output row:
+            const F* V = &values[2 * (oy - oy0) * IW];
+            const F* M = &weights[2 * (oy - oy0) * IW];
+
+            switch (method)
+            {
+               case ossimDecimator::NEAREST:
+               {
+                  for (ossim_int32 x = 0; x < OW; ++x)
+                  {
+                     outV[x] = V[2 * x];
+                     outM[x] = M[2 * x];
+                  }
+                  break;
+               }
+               case ossimDecimator::MODE:
+               {
+                  for (ossim_int32 x = 0; x < OW; ++x)
+                  {
+                     const F BV[4] = { V[2 * x], V[2 * x + 1], V[IW + 2 * x], V[IW + 2 * x + 1] };
+                     const F BM[4] = { M[2 * x], M[2 * x + 1], M[IW + 2 * x], M[IW + 2 * x + 1] };
+                     outM[x] = modeOf(BV, BM, outV[x]) ? F(1) : F(0);
+                  }
+                  break;
+               }
+               case ossimDecimator::LANCZOS3:
+               {
+                  // Down the columns, then along the row by even and odd columns:
+                  std::fill(sumV.begin(), sumV.end(), F(0));
+                  std::fill(sumM.begin(), sumM.end(), F(0));
+                  for (ossim_int32 k = 0; k < LANCZOS_TAPS; ++k)
+                  {
+                     ROWS.axpy(&sumV.front(), V + k * IW, LANCZOS[k], IW);
+                     ROWS.axpy(&sumM.front(), M + k * IW, LANCZOS[k], IW);
+                  }
+                  for (ossim_int32 i = 0; i < IW / 2; ++i)
+                  {
+                     evenV[i] = sumV[2 * i];
+                     oddV[i]  = sumV[2 * i + 1];
+                     evenM[i] = sumM[2 * i];
+                     oddM[i]  = sumM[2 * i + 1];
+                  }
+                  std::fill(outV.begin(), outV.end(), F(0));
+                  std::fill(outM.begin(), outM.end(), F(0));
+                  for (ossim_int32 j = 0; j < LANCZOS_TAPS / 2; ++j)
+                  {
+                     ROWS.axpy(&outV.front(), &evenV[j], LANCZOS[2 * j], OW);
+                     ROWS.axpy(&outV.front(), &oddV[j], LANCZOS[2 * j + 1], OW);
+                     ROWS.axpy(&outM.front(), &evenM[j], LANCZOS[2 * j], OW);
+                     ROWS.axpy(&outM.front(), &oddM[j], LANCZOS[2 * j + 1], OW);
+                  }
+                  break;
+               }
+               case ossimDecimator::BOX:
+               default:
+               {
+                  std::copy(V, V + IW, sumV.begin());
+                  std::copy(M, M + IW, sumM.begin());
+                  ROWS.axpy(&sumV.front(), V + IW, F(1), IW);
+                  ROWS.axpy(&sumM.front(), M + IW, F(1), IW);
+                  ROWS.pairSum(&sumV.front(), &outV.front(), OW);
+                  ROWS.pairSum(&sumM.front(), &outM.front(), OW);
+                  break;
+               }
+            }
+
+            ROWS.store(&outV.front(), &outM.front(),
+                       outBuf + (oy - OUT_RECT.ul().y) * OUT_W + (region.ul().x - OUT_RECT.ul().x),
+                       OW, static_cast<F>(MIN_WEIGHT), OUT_NULL, OUT_MIN, OUT_MAX);
+         }
+      }
+   }
+}
+
+ossimDecimator::Method ossimDecimator::getMethod(const ossimString& name)
+{
+   const ossimString NAME = name.downcase();
+   if (NAME == "nearest")
+   {
+      return NEAREST;
+   }
+   if ( (NAME == "lanczos") || (NAME == "lanczos3") )
+   {
+      return LANCZOS3;
+   }
+   if (NAME == "mode")
+   {
+      return MODE;
+   }
+   return BOX;
+}
+
+const char* ossimDecimator::getMethodName(Method method)
+{
+   switch (method)
+   {
+      case NEAREST:
+         return "nearest";
+      case LANCZOS3:
+         return "lanczos";
+      case MODE:
+         return "mode";
+      case BOX:
+      default:
+         return "box";
+   }
+}
+
+ossim_uint32 ossimDecimator::getMargin(Method method)
+{
+   return (method == LANCZOS3) ? LANCZOS_MARGIN : 0;
+}
+
+void ossimDecimator::decimate(const ossimImageData* input, ossimImageData* output, Method method)
+{
+   if ( !input || !output || !output->getBuf() )
+   {
+      return;
+   }
+   if (input->getScalarType() != output->getScalarType())
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimDecimator::decimate WARNING: Input and output scalar types differ!"
+         << std::endl;
+      return;
+   }
+
+   // Output pixels whose block meets the input:
+   const ossimIrect IN_RECT = input->getImageRectangle();
+   const ossimIrect HALF(floorDiv2(IN_RECT.ul().x), floorDiv2(IN_RECT.ul().y),
+                         floorDiv2(IN_RECT.lr().x), floorDiv2(IN_RECT.lr().y));
+   const ossimIrect OUT_RECT = output->getImageRectangle();
+   if ( !HALF.intersects(OUT_RECT) )
+   {
+      return;
+   }
+   const ossimIrect REGION = HALF.clipToRect(OUT_RECT);
+
+   const ossim_uint32 BANDS = std::min(input->getNumberOfBands(), output->getNumberOfBands());
+   for (ossim_uint32 band = 0; band < BANDS; ++band)
+   {
+      switch (output->getScalarType())
+      {
+         case OSSIM_UINT8:
+            decimateBand<ossim_uint8>(input, output, band, method, REGION);
+            break;
+         case OSSIM_SINT8:
+            decimateBand<ossim_sint8>(input, output, band, method, REGION);
+            break;
+         case OSSIM_USHORT11:
+         case OSSIM_USHORT12:
+         case OSSIM_USHORT13:
+         case OSSIM_USHORT14:
+         case OSSIM_USHORT15:
+         case OSSIM_UINT16:
+            decimateBand<ossim_uint16>(input, output, band, method, REGION);
+            break;
+         case OSSIM_SINT16:
+            decimateBand<ossim_sint16>(input, output, band, method, REGION);
+            break;
+         case OSSIM_UINT32:
+            decimateBand<ossim_uint32>(input, output, band, method, REGION);
+            break;
+         case OSSIM_SINT32:
+            decimateBand<ossim_sint32>(input, output, band, method, REGION);
+            break;
+         case OSSIM_NORMALIZED_FLOAT:
+         case OSSIM_FLOAT32:
+            decimateBand<ossim_float32>(input, output, band, method, REGION);
+            break;
+         case OSSIM_NORMALIZED_DOUBLE:
+         case OSSIM_FLOAT64:
+            decimateBand<ossim_float64>(input, output, band, method, REGION);
+            break;
+         default:
+            ossimNotify(ossimNotifyLevel_WARN)
+               << "ossimDecimator::decimate WARNING: Unhandled scalar type!" << std::endl;
+            return;
+      }
+   }
+}
+
+void ossimDecimator::decimate(const ossimImageData* input, ossimImageData* output, Method method,
+                              ossim_uint32 factor)
+{
+   if ( !input || !output )
+   {
+      return;
+   }
+   if (factor < 2)
+   {
+      output->loadTile(input);
+      return;
+   }
+
+   // Halve into temporary tiles down to the last step:
+   ossimRefPtr<const ossimImageData> current = input;
+   while (factor > 2)
+   {
+      const ossimIrect RECT = current->getImageRectangle();
+      const ossimIrect HALF(floorDiv2(RECT.ul().x), floorDiv2(RECT.ul().y),
+                            floorDiv2(RECT.lr().x), floorDiv2(RECT.lr().y));
+      ossimRefPtr<ossimImageData> half = new ossimImageData(0, input->getScalarType(),
+                                                            input->getNumberOfBands(),
+                                                            HALF.width(), HALF.height());
+      half->setOrigin(HALF.ul());
+      for (ossim_uint32 band = 0; band < input->getNumberOfBands(); ++band)
+      {
+         half->setNullPix(input->getNullPix(band), band);
+         half->setMinPix(input->getMinPix(band), band);
+         half->setMaxPix(input->getMaxPix(band), band);
+      }
+      half->initialize();
+      decimate(current.get(), half.get(), method);
+      half->validate();
+      current = half.get();
+      factor /= 2;
+   }
+   decimate(current.get(), output, method);
+}
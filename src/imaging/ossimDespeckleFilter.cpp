@@ -12,6 +12,7 @@
 #include <ossim/imaging/ossimDespeckleFilter.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimSlidingWindowRank.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimKeyword.h>
 #include <ossim/base/ossimNumericProperty.h>
@@ -122,57 +123,40 @@ template <class T>
 void ossimDespeckleFilter::despeckle(T /* dummyVariable */, ossimRefPtr<ossimImageData> inputTile)
 {
    ossimIpt inUL  (inputTile->getImageRectangle().ul());
-   ossimIpt inLR  (inputTile->getImageRectangle().lr());
    ossimIpt outUL (theTile->getImageRectangle().ul());
-   ossimIpt outLR (theTile->getImageRectangle().lr());
    long inWidth   = inputTile->getWidth();
    long outWidth  = theTile->getWidth();
+   long outHeight = theTile->getHeight();
    long num_bands = theTile->getNumberOfBands();
-   
-      // Loop over all bands first:
+
+   // A pixel survives if any other pixel within the radius is valid, i.e. the window around it
+   // holds at least two valid pixels. The counts come from running sums, so the cost per pixel
+   // does not depend on the radius:
+   ossimSlidingWindowRank counter;
+   counter.setWindowSize(2*theFilterRadius + 1);
+   std::vector<ossim_uint32> counts;
+
+   // Loop over all bands first:
    for(long b = 0; b < num_bands; ++b)
    {                  
+      if (!counter.countValid(inputTile.get(), b, theTile.get(), counts))
+      {
+         theTile->loadBand(inputTile->getBuf(b), inputTile->getImageRectangle(), b);
+         continue;
+      }
+
       const T* inbuf = (const T*) inputTile->getBuf(b);
       T* outBuf = (T*) theTile->getBuf(b);
       T null_pixel = (T) inputTile->getNullPix(b);
 
-      for (long y=outUL.y; y<=outLR.y; y++)
+      for (long y=0; y<outHeight; y++)
       {
-         for (long x=outUL.x; x<=outLR.x; x++)
+         long idx = (y + outUL.y - inUL.y)*inWidth + outUL.x - inUL.x; // index to input buffer
+         long odx = y*outWidth;                                         // index to output buffer
+         for (long x=0; x<outWidth; ++x, ++idx, ++odx)
          {
-            bool found_valid = false;
-            long idx = (y - inUL.y)*inWidth + x - inUL.x; // index to input buffer
-            long odx = (y-outUL.y)*outWidth + x - outUL.x;// index to output buffer
-          
             T pixel = inbuf[idx];
-            if (pixel != null_pixel)
-            {
-               // Inside loop over input "kernel" pixels centered at x, y:
-               for (long iy=-theFilterRadius; (iy<=theFilterRadius) && !found_valid; iy++)
-               {
-                  // Compute row number in image space and skip this row if outside input tile:
-                  long row = y + iy;
-                  if ((row < inUL.y) || (row > inLR.y))
-                     continue;
-
-                  for (long ix=-theFilterRadius; (ix<=theFilterRadius) && !found_valid; ix++)
-                  {
-                     // Compute column number in image space and skip this col if outside input tile:
-                     long col = x + ix;
-                     if ((col < inUL.x) || (col > inLR.x))
-                        continue;
-
-                     // Compute offset into input buffer for the neighbor pixel. If we aren't at the 
-                     // kernel center, consider if valid neighbor was found:
-                     idx = (row - inUL.y)*inWidth + col - inUL.x;
-                     if ( ((iy != 0) || (ix != 0)) && (inbuf[idx] != null_pixel) )
-                        found_valid = true;
-                  }
-               }
-            }
-
-            // Finished scanning neighborhood. Save output to tile buffer:
-            if (found_valid)
+            if ((pixel != null_pixel) && (counts[odx] > 1))
                outBuf[odx] = pixel;
             else
                outBuf[odx] = null_pixel;
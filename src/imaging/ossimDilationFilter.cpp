@@ -16,7 +16,6 @@
 #include <ossim/base/ossimStringProperty.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <vector>
-#include <numeric>
 
 using namespace std;
 
@@ -25,6 +24,9 @@ RTTI_DEF1(ossimDilationFilter, "ossimDilationFilter", ossimImageSourceFilter);
 // Keywords used throughout.
 static const ossimString WINDOW_SIZE_KW = "window_size";
 static const ossimString RECURSIVE_DILATION_KW = "recursive_dilation";
+static const ossimString MODE_KW = "mode";
+static const ossimString DILATION_MODE = "dilation";
+static const ossimString CLOSING_MODE = "closing";
 
 ossimDilationFilter::ossimDilationFilter(ossimObject* owner)
    :ossimImageSourceFilter(owner),
@@ -32,7 +34,9 @@ ossimDilationFilter::ossimDilationFilter(ossimObject* owner)
     theTempTile(0),
     theWindowSize(15),
     theRecursiveFlag(false),
-    theNullFoundFlag(false)
+    theNullFoundFlag(false),
+    theOperation(ossimMaskMorphology::DILATION),
+    theMorphology()
 {
    setDescription(ossimString("Dilation Filter"));
 }
@@ -53,19 +57,15 @@ ossimRefPtr<ossimImageData> ossimDilationFilter::getTile(const ossimIrect& rect,
    if(!isSourceEnabled())
       return ossimImageSourceFilter::getTile(rect, resLevel);
 
-   ossimRefPtr<ossimImageData> inputData;
-   if (theRecursiveFlag)
-      inputData =  ossimImageSourceFilter::getTile(rect, resLevel);
-   else
-   {
-      ossim_uint32 halfSize = getWindowSize()>>1;
-      ossimIrect requestRect(rect.ul().x - halfSize,
-                             rect.ul().y - halfSize,
-                             rect.lr().x + halfSize,
-                             rect.lr().y + halfSize);
+   theMorphology.setWindowSize(theWindowSize);
+   theMorphology.setOperation(theOperation);
+   ossim_int32 margin = (ossim_int32)theMorphology.getMargin();
+   ossimIrect requestRect(rect.ul().x - margin,
+                          rect.ul().y - margin,
+                          rect.lr().x + margin,
+                          rect.lr().y + margin);
 
-      inputData =  ossimImageSourceFilter::getTile(requestRect, resLevel);
-   }
+   ossimRefPtr<ossimImageData> inputData = ossimImageSourceFilter::getTile(requestRect, resLevel);
 
    if(!inputData.valid() || !inputData->getBuf())
       return inputData;
@@ -84,162 +84,55 @@ ossimRefPtr<ossimImageData> ossimDilationFilter::getTile(const ossimIrect& rect,
       theTile->setImageRectangleAndBands(rect, inputData->getNumberOfBands());
    }
 
-   theNullFoundFlag = false;
-   switch(inputData->getScalarType())
-   {
-      case OSSIM_UINT8:
-         doDilation(ossim_uint8(0), inputData);
-         break;
-      case OSSIM_USHORT11:
-      case OSSIM_USHORT12:
-      case OSSIM_USHORT13:
-      case OSSIM_USHORT14:
-      case OSSIM_USHORT15:
-      case OSSIM_UINT16:
-         doDilation(ossim_uint16(0), inputData);
-         break;
-      case OSSIM_SINT16:
-         doDilation(ossim_sint16(0), inputData);
-         break;
-      case OSSIM_UINT32:
-         doDilation(ossim_uint32(0), inputData);
-         break;
-      case OSSIM_FLOAT32:
-      case OSSIM_NORMALIZED_FLOAT:
-         doDilation(ossim_float32(0), inputData);
-         break;
-      case OSSIM_FLOAT64:
-      case OSSIM_NORMALIZED_DOUBLE:
-         doDilation(ossim_float64(0), inputData);
-         break;
-      default:
-      {
-         ossimNotify(ossimNotifyLevel_WARN)
-            << "ossimDilationFilter::applyFilter WARNING:\n"
-            << "Unhandled scalar type!" << endl;
-      }
-   }
-   return theTile;
-}
-
-template <class T>
-void ossimDilationFilter::doDilation(T scalarType , ossimRefPtr<ossimImageData>& inputData)
-{
    ossimDataObjectStatus status = inputData->getDataObjectStatus();
-
    if ((status == OSSIM_FULL) || (status == OSSIM_EMPTY))
    {
       // Nothing to do just copy the tile.
       theTile->loadTile(inputData.get());
-      return;
+      return theTile;
    }
 
-   ossim_int32 halfWindow = (ossim_int32)(theWindowSize >> 1);
-   ossim_int32 x, y, kernelX, kernelY;   
-   ossim_int32 iw = (ossim_int32)inputData->getWidth();
-   ossim_int32 ih = (ossim_int32)inputData->getHeight();
-   ossim_int32 ow = (ossim_int32)theTile->getWidth();
-   ossim_int32 oh = (ossim_int32)theTile->getHeight();
-   ossim_uint32 numBands = ossim::min(theTile->getNumberOfBands(), inputData->getNumberOfBands());
-
-   // It may be that the input rect is the same size as the output (i.e., the tile bounds aren't
-   // expanded in the input's request to permit full kernels for output edge pixels:
-   ossim_uint32 i_offset = 0;
-   ossim_int32 delta = (ossim_int32)((iw - ow) >> 1);
-   ossim_int32 xi, yi;
-   if (delta > 0)
-      i_offset = (ossim_uint32) halfWindow*(iw + 1);
-
-   ossimIpt tile_ul (theTile->getImageRectangle().ul());
-   vector<double> values;
-   for(ossim_uint32 bandIdx = 0; bandIdx < numBands; ++bandIdx)
+   if (!theMorphology.apply(inputData.get(), theTile.get(), &theValidImagePoly))
    {
-      T* inputBuf     = (T*)inputData->getBuf(bandIdx);
-      T* outputBuf    = (T*)theTile->getBuf(bandIdx);
-      if (!inputBuf || !outputBuf)
-      {
-         return; // Shouldn't happen...
-      }
-
-      const T NP = (T)inputData->getNullPix(bandIdx);
-
-      for(y = 0; y < oh; ++y)
-      {
-         for(x = 0; x < ow; ++x)
-         {
-            // Get the center input pixel. Only process those points inside the valid image
-            // (to avoid dilation beyond valid image)
-            const T CP = *(inputBuf+i_offset);
-            ossimDpt ipt (tile_ul.x+x, tile_ul.y+y);
-            if ((CP == NP) && theValidImagePoly.isPointWithin(ipt))
-            {
-               theNullFoundFlag = true; // Needed for recursion
-               values.clear();
-               for(kernelY = -halfWindow; kernelY <= halfWindow; ++kernelY)
-               {
-                  yi = y + kernelY + delta;
-                  if ((yi < 0) || (y > ih))
-                     continue;
-
-                  for(kernelX = -halfWindow; kernelX <= halfWindow; ++kernelX)
-                  {
-                     xi = x + kernelX + delta;
-                     if ((xi < 0) || (x > iw))
-                        continue;
-
-                     T tempValue = *(inputBuf+kernelX+delta + (kernelY+delta)*iw);
-                     if(tempValue != NP)
-                        values.push_back((double)tempValue);
-                  }
-               }
-
-               if(values.size() > 0)
-               {
-                  double accum = accumulate(values.begin(), values.end(), 0.0);
-                  double average = accum/(double)values.size();
-                  (*outputBuf) = (T)average;
-               }
-               else
-               {
-                  (*outputBuf) = NP;
-               }
-
-            }
-            else // Center pixel (CP) not null.
-            {
-               (*outputBuf) = CP;
-            }
-
-            // Move over...
-            ++inputBuf;
-            ++outputBuf;
-
-         } // End of loop in x direction.
-
-         // Move down...
-         inputBuf += iw - ow;
-
-      }  // End of loop in y direction.
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimDilationFilter::getTile WARNING:\n"
+         << "Unhandled scalar type!" << endl;
+      return theTile;
+   }
 
-   }  // End of band loop.
+   // "Dilation fill mode": keep dilating the output until the nulls inside the valid image are
+   // filled, or a pass fills nothing (no valid pixels left to grow from):
+   theNullFoundFlag = (theMorphology.getNumUnfilled() > 0);
+   while (theRecursiveFlag && theNullFoundFlag && (theMorphology.getNumFilled() > 0))
+   {
+      if (!theTempTile.valid())
+         theTempTile = (ossimImageData*)theTile->dup();
+      else
+         theTempTile->setImageRectangleAndBands(rect, theTile->getNumberOfBands());
+      theTempTile->loadTile(theTile.get());
+      theTempTile->setDataObjectStatus(theTile->getDataObjectStatus());
+
+      theMorphology.apply(theTempTile.get(), theTile.get(), &theValidImagePoly);
+      theNullFoundFlag = (theMorphology.getNumUnfilled() > 0);
+   }
+   return theTile;
+}
 
-   theTile->validate();
+void ossimDilationFilter::setMode(ossimMaskMorphology::Operation mode)
+{
+   theOperation = (mode == ossimMaskMorphology::CLOSING) ?
+      ossimMaskMorphology::CLOSING : ossimMaskMorphology::DILATION;
+}
 
-   // Set up recursion for "dilation fill mode", we'll keep calling this getTile until all pixels
-   // are filled with non-null values:
-   if (theRecursiveFlag)
-   {
-      //cout << "Percent Full: "<<theTile->percentFull()<<endl; //###
-      //theTile->write("filtered.ras"); //###
+void ossimDilationFilter::setMode(const ossimString& mode)
+{
+   setMode((mode.downcase() == CLOSING_MODE) ?
+           ossimMaskMorphology::CLOSING : ossimMaskMorphology::DILATION);
+}
 
-      status = theTile->getDataObjectStatus();
-      if (theNullFoundFlag)
-      {
-         theNullFoundFlag = false; // assume will fill, set true in next recursion if null found
-         theTempTile = new ossimImageData(*theTile.get());
-         doDilation(scalarType, theTempTile);
-      }
-   }
+ossimString ossimDilationFilter::getModeString() const
+{
+   return (theOperation == ossimMaskMorphology::CLOSING) ? CLOSING_MODE : DILATION_MODE;
 }
 
 void ossimDilationFilter::setProperty(ossimRefPtr<ossimProperty> property)
@@ -259,6 +152,10 @@ void ossimDilationFilter::setProperty(ossimRefPtr<ossimProperty> property)
       property->valueToString(value);
       setRecursiveFlag(value.toBool());
    }
+   else if (name == MODE_KW)
+   {
+      setMode(property->valueToString());
+   }
    else
    {
       ossimImageSourceFilter::setProperty(property);
@@ -280,6 +177,15 @@ ossimRefPtr<ossimProperty> ossimDilationFilter::getProperty(const ossimString& n
       prop->setFullRefreshBit();
       return prop;
    }
+   else if (name == MODE_KW)
+   {
+      vector<ossimString> constraintList;
+      constraintList.push_back(DILATION_MODE);
+      constraintList.push_back(CLOSING_MODE);
+      prop = new ossimStringProperty(MODE_KW, getModeString(), false, constraintList);
+      prop->setCacheRefreshBit();
+      return prop;
+   }
    return ossimImageSourceFilter::getProperty(name);
 }
 
@@ -287,6 +193,7 @@ void ossimDilationFilter::getPropertyNames(vector<ossimString>& propertyNames) c
 {
    propertyNames.push_back(WINDOW_SIZE_KW);
    propertyNames.push_back(RECURSIVE_DILATION_KW);
+   propertyNames.push_back(MODE_KW);
    ossimImageSourceFilter::getPropertyNames(propertyNames);
 }
 
@@ -294,6 +201,7 @@ bool ossimDilationFilter::saveState(ossimKeywordlist& kwl, const char* prefix)co
 {
    kwl.add(prefix, WINDOW_SIZE_KW.c_str(), theWindowSize, true);
    kwl.add(prefix, RECURSIVE_DILATION_KW.c_str(), (theRecursiveFlag?"true":"false"), true);
+   kwl.add(prefix, MODE_KW.c_str(), getModeString(), true);
    return ossimImageSourceFilter::saveState(kwl, prefix);
 }
 
@@ -307,5 +215,9 @@ bool ossimDilationFilter::loadState(const ossimKeywordlist& kwl, const char* pre
    if (lookup)
       setRecursiveFlag(ossimString(lookup).toBool());
 
+   lookup = kwl.find(prefix, MODE_KW.c_str());
+   if (lookup)
+      setMode(ossimString(lookup));
+
    return ossimImageSourceFilter::loadState(kwl, prefix);
 }
@@ -24,6 +24,7 @@ ossimDiscrete3x3HatFilter::ossimDiscrete3x3HatFilter()
    (*theKernel)[2][0] = 0;
    (*theKernel)[2][1] = 0;
    (*theKernel)[2][2] = 0;
+   analyzeKernel();
 }
 
 void ossimDiscrete3x3HatFilter::convolve(const float* data,
@@ -285,4 +286,5 @@ void ossimDiscrete3x3HatFilter::buildConvolution(double xLocation,
    col[2] = std::abs(yLocation);
   
    (*theKernel) = col*row;
+   analyzeKernel();
 }
@@ -7,6 +7,16 @@
 //*******************************************************************
 //  $Id: ossimDiscreteConvolutionKernel.cpp 12912 2008-05-28 15:05:54Z gpotts $
 #include <ossim/imaging/ossimDiscreteConvolutionKernel.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <algorithm>
+#include <cmath>
+
+// Output samples per column strip of the 2-D engine.  With the rows the
+// kernel covers this keeps a strip of a 31x31 kernel inside L1/L2.
+static const long STRIP_WIDTH = 256;
+
+// Relative tolerance when factoring a kernel into a column and a row.
+static const double SEPARABLE_TOLERANCE = 1.0e-9;
 
  
 ossimDiscreteConvolutionKernel::ossimDiscreteConvolutionKernel(long width,
@@ -22,6 +32,7 @@ ossimDiscreteConvolutionKernel::ossimDiscreteConvolutionKernel(long width,
    
    theKernel = new NEWMAT::Matrix(theHeight, theWidth);
    *theKernel = (1.0/(theHeight*theWidth));
+   analyzeKernel();
 }
 
 ossimDiscreteConvolutionKernel::ossimDiscreteConvolutionKernel(const NEWMAT::Matrix& kernel,
@@ -31,6 +42,7 @@ ossimDiscreteConvolutionKernel::ossimDiscreteConvolutionKernel(const NEWMAT::Mat
 {
    theWidth  = theKernel->Ncols();
    theHeight = theKernel->Nrows();
+   analyzeKernel();
 }
 
 ossimDiscreteConvolutionKernel::~ossimDiscreteConvolutionKernel()
@@ -79,13 +91,307 @@ void ossimDiscreteConvolutionKernel::buildSymmetric(float *coefficients,
 
 void ossimDiscreteConvolutionKernel::setKernel(const NEWMAT::Matrix& kernel)
 {
-   if(theKernel)
+   if(!theKernel)
    {
       theKernel = new NEWMAT::Matrix;
    }
    *theKernel = kernel;
    theWidth  = theKernel->Ncols();
    theHeight = theKernel->Nrows();   
+   analyzeKernel();
+}
+
+void ossimDiscreteConvolutionKernel::analyzeKernel()
+{
+   theWeights.resize(theWidth*theHeight);
+   theWeightSum = 0.0;
+   long maxRow = 0;
+   long maxCol = 0;
+   double maxAbs = 0.0;
+   for(long row = 0; row < theHeight; ++row)
+   {
+      for(long col = 0; col < theWidth; ++col)
+      {
+         double w = (*theKernel)[row][col];
+         theWeights[row*theWidth + col] = w;
+         theWeightSum += w;
+         if(std::fabs(w) > maxAbs)
+         {
+            maxAbs = std::fabs(w);
+            maxRow = row;
+            maxCol = col;
+         }
+      }
+   }
+
+   // Rank one test: factor through the largest element and check the
+   // product reproduces every weight.
+   theSeparableFlag = false;
+   theRowFactor.clear();
+   theColumnFactor.clear();
+   if((maxAbs > 0.0) && (theWidth > 1) && (theHeight > 1))
+   {
+      theColumnFactor.resize(theHeight);
+      theRowFactor.resize(theWidth);
+      for(long row = 0; row < theHeight; ++row)
+      {
+         theColumnFactor[row] = theWeights[row*theWidth + maxCol];
+      }
+      double pivot = theWeights[maxRow*theWidth + maxCol];
+      for(long col = 0; col < theWidth; ++col)
+      {
+         theRowFactor[col] = theWeights[maxRow*theWidth + col]/pivot;
+      }
+      theSeparableFlag = true;
+      for(long row = 0; theSeparableFlag && (row < theHeight); ++row)
+      {
+         for(long col = 0; col < theWidth; ++col)
+         {
+            double error = theWeights[row*theWidth + col] -
+                           theColumnFactor[row]*theRowFactor[col];
+            if(std::fabs(error) > SEPARABLE_TOLERANCE*maxAbs)
+            {
+               theSeparableFlag = false;
+               break;
+            }
+         }
+      }
+      if(!theSeparableFlag)
+      {
+         theRowFactor.clear();
+         theColumnFactor.clear();
+      }
+   }
+}
+
+void ossimDiscreteConvolutionKernel::convolveBuffer(const float* src,
+                                                    long srcWidth,
+                                                    float* dst,
+                                                    long dstWidth,
+                                                    long dstHeight)const
+{
+   convolveBufferT(src, srcWidth, dst, dstWidth, dstHeight);
+}
+
+void ossimDiscreteConvolutionKernel::convolveBuffer(const double* src,
+                                                    long srcWidth,
+                                                    double* dst,
+                                                    long dstWidth,
+                                                    long dstHeight)const
+{
+   convolveBufferT(src, srcWidth, dst, dstWidth, dstHeight);
+}
+
+template <class R>
+void ossimDiscreteConvolutionKernel::convolveBufferT(const R* src,
+                                                     long srcWidth,
+                                                     R* dst,
+                                                     long dstWidth,
+                                                     long dstHeight)const
+{
+   // Full input has no nulls so the weighted average divisor is the
+   // kernel sum.
+   const double scale = (theComputeWeightedAverageFlag && (theWeightSum > 0.0)) ?
+      1.0/theWeightSum : 1.0;
+
+   // The inner loops below run over contiguous samples with the weight
+   // hoisted out so the compiler can vectorize them.
+   if(theSeparableFlag)
+   {
+      std::vector<R> rowFactor(theWidth);
+      std::vector<R> columnFactor(theHeight);
+      for(long col = 0; col < theWidth; ++col)
+      {
+         rowFactor[col] = (R)(theRowFactor[col]*scale);
+      }
+      for(long row = 0; row < theHeight; ++row)
+      {
+         columnFactor[row] = (R)theColumnFactor[row];
+      }
+
+      // Vertical pass into one line wide enough for the horizontal pass,
+      // then the horizontal pass into the output line.
+      const long lineWidth = dstWidth + theWidth - 1;
+      std::vector<R> line(lineWidth);
+      R* l = &line.front();
+      for(long y = 0; y < dstHeight; ++y)
+      {
+         const R* s = src + y*srcWidth;
+         R w = columnFactor[0];
+         for(long x = 0; x < lineWidth; ++x)
+         {
+            l[x] = w*s[x];
+         }
+         for(long k = 1; k < theHeight; ++k)
+         {
+            s += srcWidth;
+            w = columnFactor[k];
+            for(long x = 0; x < lineWidth; ++x)
+            {
+               l[x] += w*s[x];
+            }
+         }
+
+         R* d = dst + y*dstWidth;
+         w = rowFactor[0];
+         for(long x = 0; x < dstWidth; ++x)
+         {
+            d[x] = w*l[x];
+         }
+         for(long k = 1; k < theWidth; ++k)
+         {
+            const R* lk = l + k;
+            w = rowFactor[k];
+            for(long x = 0; x < dstWidth; ++x)
+            {
+               d[x] += w*lk[x];
+            }
+         }
+      }
+   }
+   else
+   {
+      std::vector<R> weights(theWeights.size());
+      for(ossim_uint32 i = 0; i < weights.size(); ++i)
+      {
+         weights[i] = (R)(theWeights[i]*scale);
+      }
+
+      // Column strips keep the source rows a strip touches in cache while
+      // every weight is applied.
+      for(long x0 = 0; x0 < dstWidth; x0 += STRIP_WIDTH)
+      {
+         const long n = std::min(STRIP_WIDTH, dstWidth - x0);
+         for(long y = 0; y < dstHeight; ++y)
+         {
+            R* d = dst + y*dstWidth + x0;
+            for(long x = 0; x < n; ++x)
+            {
+               d[x] = 0;
+            }
+            for(long row = 0; row < theHeight; ++row)
+            {
+               const R* s = src + (y + row)*srcWidth + x0;
+               const R* w = &weights[row*theWidth];
+               for(long col = 0; col < theWidth; ++col)
+               {
+                  const R wc = w[col];
+                  const R* sc = s + col;
+                  for(long x = 0; x < n; ++x)
+                  {
+                     d[x] += wc*sc[x];
+                  }
+               }
+            }
+         }
+      }
+   }
+}
+
+bool ossimDiscreteConvolutionKernel::convolveFull(const ossimImageData* input,
+                                                  ossimImageData* output,
+                                                  const double* minPix,
+                                                  const double* maxPix)const
+{
+   if(!input || !output || !input->getBuf() || !output->getBuf() ||
+      (input->getScalarType() != output->getScalarType()) ||
+      (input->getNumberOfBands() < output->getNumberOfBands()))
+   {
+      return false;
+   }
+
+   // Upper left of the source window inside the input tile:
+   long startX = output->getOrigin().x - theWidth/2  - input->getOrigin().x;
+   long startY = output->getOrigin().y - theHeight/2 - input->getOrigin().y;
+   if((startX < 0) || (startY < 0) ||
+      (startX + (long)output->getWidth()  + theWidth  - 1 > (long)input->getWidth()) ||
+      (startY + (long)output->getHeight() + theHeight - 1 > (long)input->getHeight()))
+   {
+      return false;
+   }
+
+   switch(output->getScalarType())
+   {
+      case OSSIM_UINT8:
+         convolveFullT<ossim_uint8, float>(input, output, startX, startY, minPix, maxPix);
+         break;
+      case OSSIM_SINT16:
+         convolveFullT<ossim_sint16, float>(input, output, startX, startY, minPix, maxPix);
+         break;
+      case OSSIM_UINT16:
+      case OSSIM_USHORT11:
+      case OSSIM_USHORT12:
+      case OSSIM_USHORT13:
+      case OSSIM_USHORT14:
+      case OSSIM_USHORT15:
+         convolveFullT<ossim_uint16, float>(input, output, startX, startY, minPix, maxPix);
+         break;
+      case OSSIM_FLOAT32:
+      case OSSIM_NORMALIZED_FLOAT:
+         convolveFullT<ossim_float32, float>(input, output, startX, startY, minPix, maxPix);
+         break;
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_DOUBLE:
+         convolveFullT<ossim_float64, double>(input, output, startX, startY, minPix, maxPix);
+         break;
+      default:
+         return false;
+   }
+   return true;
+}
+
+template <class T, class R>
+void ossimDiscreteConvolutionKernel::convolveFullT(const ossimImageData* input,
+                                                   ossimImageData* output,
+                                                   long startX,
+                                                   long startY,
+                                                   const double* minPix,
+                                                   const double* maxPix)const
+{
+   const long inputWidth  = input->getWidth();
+   const long outputWidth = output->getWidth();
+   const long outputHeight= output->getHeight();
+   const long srcWidth    = outputWidth  + theWidth  - 1;
+   const long srcHeight   = outputHeight + theHeight - 1;
+   const long size        = outputWidth*outputHeight;
+   const ossim_uint32 bands = output->getNumberOfBands();
+
+   std::vector<R> src(srcWidth*srcHeight);
+   std::vector<R> dst(size);
+   
+   for(ossim_uint32 band = 0; band < bands; ++band)
+   {
+      const T* inBuf = static_cast<const T*>(input->getBuf(band)) +
+                       startY*inputWidth + startX;
+      T* outBuf = static_cast<T*>(output->getBuf(band));
+      if(!inBuf || !outBuf)
+      {
+         continue;
+      }
+
+      R* s = &src.front();
+      for(long y = 0; y < srcHeight; ++y)
+      {
+         const T* in = inBuf + y*inputWidth;
+         for(long x = 0; x < srcWidth; ++x)
+         {
+            s[x] = (R)in[x];
+         }
+         s += srcWidth;
+      }
+
+      convolveBufferT(&src.front(), srcWidth, &dst.front(), outputWidth, outputHeight);
+
+      const R minValue = (R)minPix[band];
+      const R maxValue = (R)maxPix[band];
+      for(long i = 0; i < size; ++i)
+      {
+         R v = dst[i];
+         v = v < minValue ? minValue : v;
+         v = v > maxValue ? maxValue : v;
+         outBuf[i] = (T)v;
+      }
+   }
 }
 
 void ossimDiscreteConvolutionKernel::convolve(const float* data,
@@ -0,0 +1,524 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+// The mixed radix butterflies and the real transform split are derived from KISS FFT, which
+// carries the following notice:
+//
+// Copyright (c) 2003-2010, Mark Borgerding
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted
+// provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice, this list of
+//      conditions and the following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice, this list of
+//      conditions and the following disclaimer in the documentation and/or other materials
+//      provided with the distribution.
+//    * Neither the author nor the names of any contributors may be used to endorse or promote
+//      products derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+// FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//**************************************************************************************************
+
+#include <ossim/imaging/ossimFft.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/parallel/ossimParallelFor.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+   // Factors and twiddles for one transform length.
+   class Plan
+   {
+   public:
+      explicit Plan(ossim_uint32 length)
+         : n(length)
+      {
+         // Radix 4 first, then 2, then odd factors; what is left past sqrt(n) is prime:
+         ossim_uint32 rest = n;
+         ossim_uint32 p = 4;
+         const double floorSqrt = std::floor(std::sqrt((double) n));
+         do
+         {
+            while (rest % p)
+            {
+               switch (p)
+               {
+                  case 4:  p = 2; break;
+                  case 2:  p = 3; break;
+                  default: p += 2; break;
+               }
+               if (p > floorSqrt)
+                  p = rest;
+            }
+            rest /= p;
+            factors.push_back(p);
+            factors.push_back(rest);
+         } while (rest > 1);
+
+         twiddlesD.resize(n);
+         twiddlesF.resize(n);
+         for (ossim_uint32 k = 0; k < n; ++k)
+         {
+            double phase = -2.0 * M_PI * k / n;
+            twiddlesD[k] = std::complex<double>(std::cos(phase), std::sin(phase));
+            twiddlesF[k] = std::complex<float>(twiddlesD[k]);
+         }
+
+         // Split factors for real transforms of length 2n:
+         splitD.resize(n / 2);
+         splitF.resize(n / 2);
+         for (ossim_uint32 k = 0; k < n / 2; ++k)
+         {
+            double phase = -M_PI * ((double) (k + 1) / n + 0.5);
+            splitD[k] = std::complex<double>(std::cos(phase), std::sin(phase));
+            splitF[k] = std::complex<float>(splitD[k]);
+         }
+      }
+
+      const std::complex<float>*  twiddles(float) const  { return twiddlesF.data(); }
+      const std::complex<double>* twiddles(double) const { return twiddlesD.data(); }
+      const std::complex<float>*  split(float) const     { return splitF.data(); }
+      const std::complex<double>* split(double) const    { return splitD.data(); }
+
+      ossim_uint32 n;
+      std::vector<ossim_uint32> factors; // radix, remaining length pairs
+      std::vector< std::complex<double> > twiddlesD;
+      std::vector< std::complex<float> >  twiddlesF;
+      std::vector< std::complex<double> > splitD;
+      std::vector< std::complex<float> >  splitF;
+   };
+
+   // Plans live for the process; tile sizes are few.
+   std::shared_ptr<const Plan> getPlan(ossim_uint32 n)
+   {
+      static std::mutex plansMutex;
+      static std::map< ossim_uint32, std::shared_ptr<const Plan> > plans;
+      std::lock_guard<std::mutex> lock(plansMutex);
+      std::shared_ptr<const Plan>& plan = plans[n];
+      if (!plan)
+         plan = std::make_shared<Plan>(n);
+      return plan;
+   }
+
+   // std::complex multiplication checks for infinities; these never are.
+   template <class T>
+   inline std::complex<T> cmul(const std::complex<T>& a, const std::complex<T>& b)
+   {
+      return std::complex<T>(a.real() * b.real() - a.imag() * b.imag(),
+                             a.real() * b.imag() + a.imag() * b.real());
+   }
+
+   template <class T>
+   void butterfly2(std::complex<T>* out, size_t fstride, const Plan& plan, ossim_uint32 m)
+   {
+      const std::complex<T>* tw = plan.twiddles(T());
+      std::complex<T>* out2 = out + m;
+      for (ossim_uint32 k = 0; k < m; ++k)
+      {
+         std::complex<T> t = cmul(out2[k], *tw);
+         tw += fstride;
+         out2[k] = out[k] - t;
+         out[k] += t;
+      }
+   }
+
+   template <class T>
+   void butterfly3(std::complex<T>* out, size_t fstride, const Plan& plan, ossim_uint32 m)
+   {
+      const std::complex<T>* tw1 = plan.twiddles(T());
+      const std::complex<T>* tw2 = tw1;
+      const T epi3 = plan.twiddles(T())[fstride * m].imag();
+      const ossim_uint32 m2 = 2 * m;
+      for (ossim_uint32 k = 0; k < m; ++k, ++out)
+      {
+         std::complex<T> s1 = cmul(out[m], *tw1);
+         std::complex<T> s2 = cmul(out[m2], *tw2);
+         std::complex<T> s3 = s1 + s2;
+         std::complex<T> s0 = (s1 - s2) * epi3;
+         tw1 += fstride;
+         tw2 += 2 * fstride;
+
+         std::complex<T> half = out[0] - s3 * T(0.5);
+         out[0] += s3;
+         out[m2] = std::complex<T>(half.real() + s0.imag(), half.imag() - s0.real());
+         out[m]  = std::complex<T>(half.real() - s0.imag(), half.imag() + s0.real());
+      }
+   }
+
+   template <class T>
+   void butterfly4(std::complex<T>* out, size_t fstride, const Plan& plan, ossim_uint32 m)
+   {
+      const std::complex<T>* tw1 = plan.twiddles(T());
+      const std::complex<T>* tw2 = tw1;
+      const std::complex<T>* tw3 = tw1;
+      const ossim_uint32 m2 = 2 * m;
+      const ossim_uint32 m3 = 3 * m;
+      for (ossim_uint32 k = 0; k < m; ++k, ++out)
+      {
+         std::complex<T> s0 = cmul(out[m], *tw1);
+         std::complex<T> s1 = cmul(out[m2], *tw2);
+         std::complex<T> s2 = cmul(out[m3], *tw3);
+         std::complex<T> s5 = out[0] - s1;
+         out[0] += s1;
+         std::complex<T> s3 = s0 + s2;
+         std::complex<T> s4 = s0 - s2;
+         out[m2] = out[0] - s3;
+         out[0] += s3;
+         tw1 += fstride;
+         tw2 += 2 * fstride;
+         tw3 += 3 * fstride;
+         out[m]  = std::complex<T>(s5.real() + s4.imag(), s5.imag() - s4.real());
+         out[m3] = std::complex<T>(s5.real() - s4.imag(), s5.imag() + s4.real());
+      }
+   }
+
+   // Direct butterfly for the other prime factors.
+   template <class T>
+   void butterflyP(std::complex<T>* out, size_t fstride, const Plan& plan, ossim_uint32 m,
+                   ossim_uint32 p)
+   {
+      const std::complex<T>* tw = plan.twiddles(T());
+      const size_t n = plan.n;
+      std::vector< std::complex<T> > scratch (p);
+      for (ossim_uint32 u = 0; u < m; ++u)
+      {
+         for (ossim_uint32 q = 0, k = u; q < p; ++q, k += m)
+            scratch[q] = out[k];
+         for (ossim_uint32 q1 = 0, k = u; q1 < p; ++q1, k += m)
+         {
+            size_t index = 0;
+            std::complex<T> sum = scratch[0];
+            for (ossim_uint32 q = 1; q < p; ++q)
+            {
+               index += fstride * k;
+               if (index >= n)
+                  index -= n * (index / n);
+               sum += cmul(scratch[q], tw[index]);
+            }
+            out[k] = sum;
+         }
+      }
+   }
+
+   // Mixed radix decimation in time, in -> out, forward direction.
+   template <class T>
+   void work(std::complex<T>* out, const std::complex<T>* in, size_t fstride,
+             const ossim_uint32* factors, const Plan& plan)
+   {
+      const ossim_uint32 p = factors[0];
+      const ossim_uint32 m = factors[1];
+      std::complex<T>* const begin = out;
+      std::complex<T>* const end = out + p * m;
+      if (m == 1)
+      {
+         for (; out != end; ++out, in += fstride)
+            *out = *in;
+      }
+      else
+      {
+         for (; out != end; out += m, in += fstride)
+            work(out, in, fstride * p, factors + 2, plan);
+      }
+
+      switch (p)
+      {
+         case 2:  butterfly2(begin, fstride, plan, m); break;
+         case 3:  butterfly3(begin, fstride, plan, m); break;
+         case 4:  butterfly4(begin, fstride, plan, m); break;
+         default: butterflyP(begin, fstride, plan, m, p); break;
+      }
+   }
+
+   // In place transform, scratch holds n values. Inverse as conj(forward(conj(x))).
+   template <class T>
+   void fft(std::complex<T>* data, const Plan& plan, std::vector< std::complex<T> >& scratch,
+            bool inverse)
+   {
+      const ossim_uint32 n = plan.n;
+      if (n < 2)
+         return;
+      scratch.resize(n);
+      if (inverse)
+      {
+         for (ossim_uint32 i = 0; i < n; ++i)
+            scratch[i] = std::conj(data[i]);
+      }
+      else
+      {
+         std::copy(data, data + n, scratch.begin());
+      }
+      work(data, scratch.data(), 1, plan.factors.data(), plan);
+      if (inverse)
+      {
+         for (ossim_uint32 i = 0; i < n; ++i)
+            data[i] = std::conj(data[i]);
+      }
+   }
+
+   // Real line of length n to its n / 2 + 1 coefficients. For even n, plan is for n / 2.
+   template <class T>
+   void realForward(const T* in, ossim_uint32 n, std::complex<T>* out, const Plan& plan,
+                    std::vector< std::complex<T> >& z, std::vector< std::complex<T> >& scratch)
+   {
+      if (n & 1)
+      {
+         z.resize(n);
+         for (ossim_uint32 i = 0; i < n; ++i)
+            z[i] = std::complex<T>(in[i], T(0));
+         fft(z.data(), plan, scratch, false);
+         std::copy(z.begin(), z.begin() + n / 2 + 1, out);
+         return;
+      }
+
+      // Pack even and odd samples as one complex line of half the length:
+      const ossim_uint32 half = n / 2;
+      z.resize(half);
+      for (ossim_uint32 i = 0; i < half; ++i)
+         z[i] = std::complex<T>(in[2 * i], in[2 * i + 1]);
+      fft(z.data(), plan, scratch, false);
+
+      const std::complex<T>* split = plan.split(T());
+      out[0] = std::complex<T>(z[0].real() + z[0].imag(), T(0));
+      out[half] = std::complex<T>(z[0].real() - z[0].imag(), T(0));
+      for (ossim_uint32 k = 1; k <= half / 2; ++k)
+      {
+         std::complex<T> fpk = z[k];
+         std::complex<T> fpnk = std::conj(z[half - k]);
+         std::complex<T> f1k = fpk + fpnk;
+         std::complex<T> tw = cmul(fpk - fpnk, split[k - 1]);
+         out[k] = (f1k + tw) * T(0.5);
+         out[half - k] = std::conj(f1k - tw) * T(0.5);
+      }
+   }
+
+   // n / 2 + 1 coefficients back to a real line of length n, not scaled.
+   template <class T>
+   void realInverse(const std::complex<T>* in, ossim_uint32 n, T* out, const Plan& plan,
+                    std::vector< std::complex<T> >& z, std::vector< std::complex<T> >& scratch)
+   {
+      const ossim_uint32 half = n / 2;
+      if (n & 1)
+      {
+         z.resize(n);
+         z[0] = in[0];
+         for (ossim_uint32 k = 1; k <= half; ++k)
+         {
+            z[k] = in[k];
+            z[n - k] = std::conj(in[k]);
+         }
+         fft(z.data(), plan, scratch, true);
+         for (ossim_uint32 i = 0; i < n; ++i)
+            out[i] = z[i].real();
+         return;
+      }
+
+      z.resize(half);
+      const std::complex<T>* split = plan.split(T());
+      z[0] = std::complex<T>(in[0].real() + in[half].real(), in[0].real() - in[half].real());
+      for (ossim_uint32 k = 1; k <= half / 2; ++k)
+      {
+         std::complex<T> fk = in[k];
+         std::complex<T> fnkc = std::conj(in[half - k]);
+         std::complex<T> fek = fk + fnkc;
+         std::complex<T> fok = cmul(fk - fnkc, std::conj(split[k - 1]));
+         z[k] = fek + fok;
+         z[half - k] = std::conj(fek - fok);
+      }
+      fft(z.data(), plan, scratch, true);
+      for (ossim_uint32 i = 0; i < half; ++i)
+      {
+         out[2 * i] = z[i].real();
+         out[2 * i + 1] = z[i].imag();
+      }
+   }
+
+   // Plan for the real transforms of a line of length n.
+   std::shared_ptr<const Plan> getRealPlan(ossim_uint32 n)
+   {
+      return getPlan((n & 1) ? n : n / 2);
+   }
+}
+
+ossimFft::ossimFft(ossim_uint32 numThreads)
+   : m_numThreads(numThreads)
+{
+}
+
+template <class F>
+void ossimFft::forLines(ossim_uint32 count, const F& body) const
+{
+   const ossim_uint32 threads = m_numThreads ? m_numThreads : ossim::getNumberOfThreads();
+   if ((threads <= 1) || (count < 2))
+   {
+      body(0, count);
+      return;
+   }
+
+   // A few blocks per thread so uneven lines balance out:
+   const ossim_uint32 blocks = std::min(count, threads * 4);
+   ossim::parallelFor(blocks, threads, [&body, count, blocks](ossim_uint32 b)
+   {
+      body((ossim_uint32) ((ossim_uint64) count * b / blocks),
+           (ossim_uint32) ((ossim_uint64) count * (b + 1) / blocks));
+   });
+}
+
+void ossimFft::transform(std::complex<float>* data, ossim_uint32 n, bool inverse) const
+{
+   std::vector< std::complex<float> > scratch;
+   fft(data, *getPlan(n), scratch, inverse);
+}
+
+void ossimFft::transform(std::complex<double>* data, ossim_uint32 n, bool inverse) const
+{
+   std::vector< std::complex<double> > scratch;
+   fft(data, *getPlan(n), scratch, inverse);
+}
+
+void ossimFft::forward2d(const float* in, ossim_uint32 width, ossim_uint32 height,
+                         std::complex<float>* out) const
+{
+   forward2dT(in, width, height, out);
+}
+
+void ossimFft::forward2d(const double* in, ossim_uint32 width, ossim_uint32 height,
+                         std::complex<double>* out) const
+{
+   forward2dT(in, width, height, out);
+}
+
+void ossimFft::inverse2d(const std::complex<float>* in, ossim_uint32 width, ossim_uint32 height,
+                         float* out) const
+{
+   inverse2dT(in, width, height, out);
+}
+
+void ossimFft::inverse2d(const std::complex<double>* in, ossim_uint32 width, ossim_uint32 height,
+                         double* out) const
+{
+   inverse2dT(in, width, height, out);
+}
+
+void ossimFft::transform2d(std::complex<float>* data, ossim_uint32 width, ossim_uint32 height,
+                           bool inverse) const
+{
+   transform2dT(data, width, height, inverse);
+}
+
+void ossimFft::transform2d(std::complex<double>* data, ossim_uint32 width, ossim_uint32 height,
+                           bool inverse) const
+{
+   transform2dT(data, width, height, inverse);
+}
+
+template <class T>
+void ossimFft::columns(std::complex<T>* data, ossim_uint32 width, ossim_uint32 height,
+                       ossim_uint32 stride, bool inverse) const
+{
+   if (height < 2)
+      return;
+   std::shared_ptr<const Plan> plan = getPlan(height);
+   forLines(width, [&](ossim_uint32 begin, ossim_uint32 end)
+   {
+      std::vector< std::complex<T> > column (height);
+      std::vector< std::complex<T> > scratch;
+      for (ossim_uint32 x = begin; x < end; ++x)
+      {
+         for (ossim_uint32 y = 0; y < height; ++y)
+            column[y] = data[y * stride + x];
+         fft(column.data(), *plan, scratch, inverse);
+         for (ossim_uint32 y = 0; y < height; ++y)
+            data[y * stride + x] = column[y];
+      }
+   });
+}
+
+template <class T>
+void ossimFft::forward2dT(const T* in, ossim_uint32 width, ossim_uint32 height,
+                          std::complex<T>* out) const
+{
+   if (!in || !out || !width || !height)
+      return;
+
+   const ossim_uint32 outWidth = width / 2 + 1;
+   std::shared_ptr<const Plan> plan = getRealPlan(width);
+   forLines(height, [&](ossim_uint32 begin, ossim_uint32 end)
+   {
+      std::vector< std::complex<T> > z;
+      std::vector< std::complex<T> > scratch;
+      for (ossim_uint32 y = begin; y < end; ++y)
+         realForward(in + y * width, width, out + y * outWidth, *plan, z, scratch);
+   });
+   columns(out, outWidth, height, outWidth, false);
+}
+
+template <class T>
+void ossimFft::inverse2dT(const std::complex<T>* in, ossim_uint32 width, ossim_uint32 height,
+                          T* out) const
+{
+   if (!in || !out || !width || !height)
+      return;
+
+   const ossim_uint32 inWidth = width / 2 + 1;
+   std::vector< std::complex<T> > spectrum (in, in + inWidth * height);
+   columns(spectrum.data(), inWidth, height, inWidth, true);
+
+   const T scale = T(1.0 / ((double) width * height));
+   std::shared_ptr<const Plan> plan = getRealPlan(width);
+   forLines(height, [&](ossim_uint32 begin, ossim_uint32 end)
+   {
+      std::vector< std::complex<T> > z;
+      std::vector< std::complex<T> > scratch;
+      for (ossim_uint32 y = begin; y < end; ++y)
+      {
+         T* line = out + y * width;
+         realInverse(&spectrum[y * inWidth], width, line, *plan, z, scratch);
+         for (ossim_uint32 x = 0; x < width; ++x)
+            line[x] *= scale;
+      }
+   });
+}
+
+template <class T>
+void ossimFft::transform2dT(std::complex<T>* data, ossim_uint32 width, ossim_uint32 height,
+                            bool inverse) const
+{
+   if (!data || !width || !height)
+      return;
+
+   std::shared_ptr<const Plan> plan = getPlan(width);
+   forLines(height, [&](ossim_uint32 begin, ossim_uint32 end)
+   {
+      std::vector< std::complex<T> > scratch;
+      for (ossim_uint32 y = begin; y < end; ++y)
+         fft(data + y * width, *plan, scratch, inverse);
+   });
+   columns(data, width, height, width, inverse);
+
+   if (inverse)
+   {
+      const T scale = T(1.0 / ((double) width * height));
+      const size_t count = (size_t) width * height;
+      for (size_t i = 0; i < count; ++i)
+         data[i] *= scale;
+   }
+}
@@ -12,8 +12,6 @@
 
 #include <ossim/imaging/ossimFftFilter.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
-#include <ossim/matrix/newmat.h>
-#include <ossim/matrix/newmatap.h>
 #include <ossim/imaging/ossimScalarRemapper.h>
 #include <ossim/base/ossimStringProperty.h>
 
@@ -23,7 +21,8 @@ ossimFftFilter::ossimFftFilter(ossimObject* owner)
    :ossimImageSourceFilter(owner),
     theTile(0),
     theDirectionType(FORWARD),
-    theScalarRemapper(new ossimScalarRemapper())
+    theScalarRemapper(new ossimScalarRemapper()),
+    theFft(1)
 {
    theScalarRemapper->setOutputScalarType(OSSIM_NORMALIZED_DOUBLE);
 }
@@ -32,7 +31,8 @@ ossimFftFilter::ossimFftFilter(ossimImageSource* inputSource)
    :ossimImageSourceFilter(inputSource),
     theTile(0),
     theDirectionType(FORWARD),
-    theScalarRemapper(new ossimScalarRemapper())
+    theScalarRemapper(new ossimScalarRemapper()),
+    theFft(1)
 {
    theScalarRemapper->setOutputScalarType(OSSIM_NORMALIZED_DOUBLE);
 }
@@ -42,7 +42,8 @@ ossimFftFilter::ossimFftFilter(ossimObject* owner,
    :ossimImageSourceFilter(owner, inputSource),
     theTile(0),
     theDirectionType(FORWARD),
-    theScalarRemapper(new ossimScalarRemapper())
+    theScalarRemapper(new ossimScalarRemapper()),
+    theFft(1)
 {
    theScalarRemapper->setOutputScalarType(OSSIM_NORMALIZED_DOUBLE);
 }
@@ -283,146 +284,80 @@ void ossimFftFilter::getPropertyNames(std::vector<ossimString>& propertyNames)co
 void ossimFftFilter::runFft(ossimRefPtr<ossimImageData>& input,
                             ossimRefPtr<ossimImageData>& output)
 {
-
-   NEWMAT::Matrix* realIn = new NEWMAT::Matrix(input->getHeight(),
-                                               input->getWidth());
-   NEWMAT::Matrix* imgIn = new NEWMAT::Matrix(input->getHeight(),
-                                              input->getWidth());
-   NEWMAT::Matrix* realOut = new NEWMAT::Matrix(input->getHeight(),
-                                                input->getWidth());
-   NEWMAT::Matrix* imgOut = new NEWMAT::Matrix(input->getHeight(),
-                                               input->getWidth());
+   // Real transforms only keep the non-redundant columns, the rest of the spectrum is their
+   // conjugate: X(y, x) = conj(X((h - y) % h, (w - x) % w)).
    ossim_uint32 bandIdx = 0;
    ossim_uint32 w = input->getWidth();
    ossim_uint32 h = input->getHeight();
+   ossim_uint32 cw = w/2 + 1;
    ossim_uint32 x = 0;
    ossim_uint32 y = 0;
+   theSamples.resize(w*h);
+   theSpectrum.resize(cw*h);
    if(theDirectionType == FORWARD)
    {
       ossim_uint32 bands = input->getNumberOfBands();
       for(bandIdx = 0; bandIdx < bands; ++bandIdx)
       {
-         ossim_float64* bandReal = 0;
-         ossim_float64* bandImg  = 0;
-         fillMatrixForward((ossim_float64*)input->getBuf(bandIdx),
-                           (ossim_float64)input->getNullPix(bandIdx),
-                           *realIn,
-                           *imgIn);
-         NEWMAT::FFT2(*realIn, *imgIn, *realOut, *imgOut);
-         bandReal = (ossim_float64*)output->getBuf(2*bandIdx);
-         bandImg  = (ossim_float64*)output->getBuf(2*bandIdx + 1);
-         if(bandReal&&bandImg)
+         const ossim_float64* inBuf = (const ossim_float64*)input->getBuf(bandIdx);
+         ossim_float64* bandReal = (ossim_float64*)output->getBuf(2*bandIdx);
+         ossim_float64* bandImg  = (ossim_float64*)output->getBuf(2*bandIdx + 1);
+         if(!inBuf || !bandReal || !bandImg)
+         {
+            continue;
+         }
+         const ossim_float64 nullPix = (ossim_float64)input->getNullPix(bandIdx);
+         for(ossim_uint32 i = 0; i < w*h; ++i)
+         {
+            theSamples[i] = (inBuf[i] != nullPix) ? inBuf[i] : 0.0;
+         }
+         theFft.forward2d(&theSamples.front(), w, h, &theSpectrum.front());
+         for(y = 0; y < h; ++y)
          {
-            for(y = 0; y < h; ++y)
+            const std::complex<double>* line = &theSpectrum[y*cw];
+            const std::complex<double>* mirror = &theSpectrum[((h - y)%h)*cw];
+            for(x = 0; x < w; ++x)
             {
-               for(x = 0; x < w; ++x)
-               {
-                  *bandReal = (ossim_float64)((*realOut)[y][x]);
-                  *bandImg  = (ossim_float64)((*imgOut)[y][x]);
-                  ++bandReal;
-                  ++bandImg;
-               }
+               std::complex<double> value = (x < cw) ? line[x] : std::conj(mirror[w - x]);
+               *bandReal = value.real();
+               *bandImg  = value.imag();
+               ++bandReal;
+               ++bandImg;
             }
          }
       }
    }
    else
    {
-      ossim_float64* bandReal = 0;
       ossim_uint32 bands = input->getNumberOfBands();
-      for(bandIdx = 0; bandIdx < bands; bandIdx+=2)
+      for(bandIdx = 0; bandIdx + 1 < bands; bandIdx+=2)
       {
-         bandReal = (ossim_float64*)output->getBuf(bandIdx/2);
-         if(input->getBuf(bandIdx)&&
-            input->getBuf(bandIdx+1))
+         const ossim_float64* real = (const ossim_float64*)input->getBuf(bandIdx);
+         const ossim_float64* img  = (const ossim_float64*)input->getBuf(bandIdx+1);
+         ossim_float64* bandReal = (ossim_float64*)output->getBuf(bandIdx/2);
+         if(!real || !img || !bandReal)
          {
-            fillMatrixInverse((double*)input->getBuf(bandIdx),
-                              (double*)input->getBuf(bandIdx+1),
-                              *realIn,
-                              *imgIn);
-            NEWMAT::FFT2I(*realIn, *imgIn, *realOut, *imgOut);
-            for(y = 0; y < h; ++y)
-            {
-               for(x = 0; x < w; ++x)
-               {
-                  *bandReal = (ossim_float64)((*realOut)[y][x]);
-//                  if(*bandReal > 1.0)
-//                  {
-//                     *bandReal = 1.0;
-//                  }
-//                  if(*bandReal < 0.0)
-//                  {
-//                     *bandReal = 0.0;
-//                  }
-                  ++bandReal;
-               }
-            }
+            continue;
          }
-      }
-   }
-   
-   delete realIn;
-   delete imgIn;
-   delete realOut;
-   delete imgOut;
-}
 
-template <class T>
-void ossimFftFilter::fillMatrixForward(T *realPart,
-                                       T nullPix,
-                                       NEWMAT::Matrix& real,
-                                       NEWMAT::Matrix& img)const
-{
-   ossim_uint32 w = real.Ncols();
-   ossim_uint32 h = real.Nrows();
-   ossim_uint32 yIdx = 0;
-   ossim_uint32 xIdx = 0;
-   
-   for(yIdx = 0; yIdx < h; ++yIdx)
-   {
-      for(xIdx = 0; xIdx < w; ++xIdx)
-      {
-         if((double)(*realPart) != nullPix)
-         {
-            real[yIdx][xIdx] = (double)(*realPart);
-         }
-         else
+         // The real part of the inverse only depends on the conjugate symmetric part of the
+         // input, which the real transform takes:
+         for(y = 0; y < h; ++y)
          {
-            real[yIdx][xIdx] = 0.0;
+            ossim_uint32 my = (h - y)%h;
+            for(x = 0; x < cw; ++x)
+            {
+               ossim_uint32 i = y*w + x;
+               ossim_uint32 mi = my*w + (w - x)%w;
+               theSpectrum[y*cw + x] = std::complex<double>(0.5*(real[i] + real[mi]),
+                                                            0.5*(img[i] - img[mi]));
+            }
          }
-         
-         img[yIdx][xIdx]  = 0.0;
-         
-         ++realPart;
-      }
-   }
-}
-
-template <class T>
-void ossimFftFilter::fillMatrixInverse(T *realPart,
-                                       T *imgPart,
-                                       NEWMAT::Matrix& real,
-                                       NEWMAT::Matrix& img)const
-{
-   ossim_uint32 w = real.Ncols();
-   ossim_uint32 h = real.Nrows();
-   ossim_uint32 yIdx = 0;
-   ossim_uint32 xIdx = 0;
-   
-   for(yIdx = 0; yIdx < h; ++yIdx)
-   {
-      for(xIdx = 0; xIdx < w; ++xIdx)
-      {
-         real[yIdx][xIdx] = (double)(*realPart);
-         img[yIdx][xIdx]  = (double)(*imgPart);
-         
-         ++realPart;
-         ++imgPart;
+         theFft.inverse2d(&theSpectrum.front(), w, h, bandReal);
       }
    }
 }
 
-
 bool ossimFftFilter::loadState(const ossimKeywordlist& kwl,
                                const char* prefix)
 {
@@ -431,6 +366,11 @@ bool ossimFftFilter::loadState(const ossimKeywordlist& kwl,
    {
       setDirectionType(ossimString(direction));
    }
+   const char* threads = kwl.find(prefix, "fft_threads");
+   if(threads)
+   {
+      theFft.setNumberOfThreads(ossimString(threads).toUInt32());
+   }
    
    return ossimImageSourceFilter::loadState(kwl, prefix);
 }
@@ -442,6 +382,10 @@ bool ossimFftFilter::saveState(ossimKeywordlist& kwl,
            "fft_direction",
            getDirectionTypeAsString(),
            true);
+   kwl.add(prefix,
+           "fft_threads",
+           theFft.getNumberOfThreads(),
+           true);
    
    return ossimImageSourceFilter::saveState(kwl, prefix);
 }
@@ -52,8 +52,21 @@ ossimRefPtr<ossimImageData> ossimGammaRemapper::getTile(const ossimIrect& tileRe
 
    if ( theInputConnection )
    {
-      ossimRefPtr<ossimImageData> inputTile = theInputConnection->getTile(tileRect, resLevel);
+      if (m_dirtyFlag)
+      {
+         // Gamma changed since the fused table was made:
+         m_remapChain.reset();
+      }
+      if (m_remapChain.fuse(this))
+      {
+         return m_remapChain.getTile(tileRect, resLevel);
+      }
 
+      ossimRefPtr<ossimImageData> inputTile = theInputConnection->getTile(tileRect, resLevel);
+      if ( inputTile.valid() )
+      {
+         return remapTile(inputTile);
+      }
 
       if(!m_tile||!m_tile->getBuf())
       {
@@ -63,39 +76,60 @@ ossimRefPtr<ossimImageData> ossimGammaRemapper::getTile(const ossimIrect& tileRe
       if (!m_tile || ossim::almostEqual(m_gamma, 0.0))
          return inputTile;
 
+      // Since the filter is enabled, return theTile which is of the correct scalar type.
       m_tile->setImageRectangle(tileRect);
       m_tile->makeBlank();
-      if ( !inputTile.valid() ||
-         (inputTile->getDataObjectStatus() == OSSIM_NULL) ||
-         (inputTile->getDataObjectStatus() == OSSIM_EMPTY) )
-      {
-         //---
-         // Since the filter is enabled, return theTile which is of the
-         // correct scalar type.
-         //---
-         return m_tile;
-      }
-      if (m_dirtyFlag)
-      {
-         computeLookup();
-      }
-
-      if(!m_lookupTable.empty())
-      {
-         calculateGammaWithLookup(inputTile);
-      }
-      else
-      {
-         calculateGamma(inputTile);
-      }
-      m_tile->validate();
-
       result = m_tile;
    }
 
    return result;
 }
 
+bool ossimGammaRemapper::isPointwiseRemap() const
+{
+   return true;
+}
+
+ossimRefPtr<ossimImageData> ossimGammaRemapper::remapTile(
+   const ossimRefPtr<ossimImageData>& inputTile)
+{
+   if(!m_tile||!m_tile->getBuf())
+   {
+      allocate();
+   }
+
+   if (!m_tile || !inputTile.valid() || ossim::almostEqual(m_gamma, 0.0))
+      return inputTile;
+
+   m_tile->setImageRectangle(inputTile->getImageRectangle());
+   m_tile->makeBlank();
+   if ( (inputTile->getDataObjectStatus() == OSSIM_NULL) ||
+        (inputTile->getDataObjectStatus() == OSSIM_EMPTY) )
+   {
+      //---
+      // Since the filter is enabled, return theTile which is of the
+      // correct scalar type.
+      //---
+      return m_tile;
+   }
+   if (m_dirtyFlag)
+   {
+      computeLookup();
+   }
+
+   if(!m_lookupTable.empty())
+   {
+      calculateGammaWithLookup(inputTile);
+   }
+   else
+   {
+      calculateGamma(inputTile);
+   }
+   m_tile->validate();
+
+   return m_tile;
+}
+
 void ossimGammaRemapper::calculateGammaWithLookup(ossimRefPtr<ossimImageData> inputTile)
 {
    switch(inputTile->getScalarType())
@@ -202,6 +236,7 @@ void ossimGammaRemapper::initialize()
    ossimImageSourceFilter::initialize();
    m_tile = 0;
    m_dirtyFlag = true;
+   m_remapChain.reset();
    m_lookupTable.clear();
 }
 
@@ -291,6 +326,7 @@ void ossimGammaRemapper::setGamma(const double& gamma)
    if(m_gamma > MAX_GAMMA) m_gamma = MAX_GAMMA;
 
    m_dirtyFlag = true;
+   remapChanged();
 }
 
 ossimString ossimGammaRemapper::getShortName() const
@@ -233,25 +233,35 @@ ossimRefPtr<ossimImageData> ossimHistogramRemapper::getTile(
       {
          // Rebuild the table if dirty flag set:
          makeClean();
+         theRemapChain.reset();
       }
-      if ( theEnableFlag && !theBypassFlag && theTable.size() ) 
-      {
-         //---
-         // Not bypassed and has a table...
-         // Base handles the rest...
-         //---
-         result = ossimTableRemapper::getTile(tileRect, resLevel);
-      }
-      else
-      {
-         // Fetch tile from pointer from the input source.
-         result = theInputConnection->getTile(tileRect, resLevel);
-      }
+
+      // Base fuses pointwise runs, or calls remapTile:
+      result = ossimTableRemapper::getTile(tileRect, resLevel);
    }
 
    return result;
 }
 
+ossimRefPtr<ossimImageData> ossimHistogramRemapper::remapTile(
+   const ossimRefPtr<ossimImageData>& inputTile)
+{
+   if ( theDirtyFlag )
+   {
+      // Rebuild the table if dirty flag set:
+      makeClean();
+   }
+   if ( theEnableFlag && !theBypassFlag && theTable.size() ) 
+   {
+      //---
+      // Not bypassed and has a table...
+      // Base handles the rest...
+      //---
+      return ossimTableRemapper::remapTile(inputTile);
+   }
+   return inputTile;
+}
+
 void ossimHistogramRemapper::setLowNormalizedClipPoint(const ossim_float64& clip)
 {
    const ossim_uint32 BANDS = getNumberOfInputBands();
@@ -1150,6 +1160,7 @@ void ossimHistogramRemapper::setStretchModeAsString(const ossimString& mode)
 
 void ossimHistogramRemapper::buildTable()
 {
+   remapChanged();
    setupTable();
    switch(theStretchMode)
    {
@@ -2187,9 +2198,16 @@ void ossimHistogramRemapper::setBypassFlag(bool flag)
          theDirtyFlag = true;
       }
       theBypassFlag = flag;
+      remapChanged();
    }
 }
 
+ossim_uint32 ossimHistogramRemapper::getRemapStamp() const
+{
+   // Settings only mark the table dirty, it's rebuilt by the next remapTile:
+   return ossimTableRemapper::getRemapStamp() + (theDirtyFlag ? 1 : 0);
+}
+
 double ossimHistogramRemapper::getMinPixelValue(ossim_uint32 band)const
 {
    double result = ossimTableRemapper::getMinPixelValue(band);
@@ -23,6 +23,7 @@
 //#include <ossim/base/ossimSource.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
 #include <algorithm>
 #include <cstring>
 #include <fstream>
@@ -111,14 +112,18 @@ ossimImageData::ossimImageData(const ossimImageData &rhs)
   m_indexedFlag(rhs.m_indexedFlag),
   m_percentFull(0)
 {
+   copyBandViews(rhs);
 }
 
 const ossimImageData& ossimImageData::operator=(const ossimImageData& rhs)
 {
    if (this != &rhs)
    {
+      clearBandViews();
+
       // ossimRectilinearDataObject initialization:
       ossimRectilinearDataObject::operator=(rhs);
+      copyBandViews(rhs);
 
       // ossimImageData (this) members:
       m_nullPixelValue = rhs.m_nullPixelValue;
@@ -180,6 +185,14 @@ ossim_uint8* ossimImageData::getAlphaBuf()
 
 const void* ossimImageData::getBuf() const
 {
+   if (m_bandViews.size())
+   {
+      const ossim_uint8* b = getContiguousBandViews();
+      if (b)
+      {
+         return static_cast<const void*>(b);
+      }
+   }
    if (m_dataBuffer.size() > 0)
    {
       return static_cast<const void*>(&m_dataBuffer.front());
@@ -189,35 +202,138 @@ const void* ossimImageData::getBuf() const
 
 void* ossimImageData::getBuf()
 {
-   if (m_dataBuffer.size() > 0)
+   return const_cast<void*>(static_cast<const ossimImageData*>(this)->getBuf());
+}
+
+const void* ossimImageData::getBuf(ossim_uint32 band) const
+{
+   if (isValidBand(band))
    {
-      return static_cast<void*>(&m_dataBuffer.front());
+      if ( (band < m_bandViews.size()) && m_bandViews[band] )
+      {
+         return static_cast<const void*>(m_bandViews[band]);
+      }
+      if (m_dataBuffer.size() > 0)
+      {
+         const ossim_uint8* b = &m_dataBuffer.front() + band * getSizePerBandInBytes();
+         return static_cast<const void*>(b);
+      }
    }
    return 0;
 }
 
-const void* ossimImageData::getBuf(ossim_uint32 band) const
+void* ossimImageData::getBuf(ossim_uint32 band)
 {
-   const ossim_uint8* b = static_cast<const ossim_uint8*>(getBuf());
+   return const_cast<void*>(static_cast<const ossimImageData*>(this)->getBuf(band));
+}
 
-   if (isValidBand(band) && b != 0)
+bool ossimImageData::setBandView(ossim_uint32 band,
+                                 ossimImageData* source,
+                                 ossim_uint32 sourceBand)
+{
+   if ( !source || (source == this) || !isValidBand(band) ||
+        !source->isValidBand(sourceBand) ||
+        (source->getScalarType() != getScalarType()) ||
+        (source->getWidth() != getWidth()) ||
+        (source->getHeight() != getHeight()) ||
+        (m_dataBuffer.size() != getDataSizeInBytes()) )
    {
-      b += (band * getSizePerBandInBytes());
-      return static_cast<const void*>(b);
+      return false;
    }
-   return 0;
+
+   ossim_uint8* b = static_cast<ossim_uint8*>(source->getBuf(sourceBand));
+   if (!b)
+   {
+      return false;
+   }
+
+   // A view of a view holds the tile that owns the pixels:
+   ossimRefPtr<ossimImageData> owner = source;
+   if ( (sourceBand < source->m_bandViews.size()) && source->m_bandViews[sourceBand] )
+   {
+      owner = source->m_bandViewSources[sourceBand];
+   }
+   if (owner.get() == this)
+   {
+      return false;
+   }
+
+   if (m_bandViews.size() != getNumberOfBands())
+   {
+      m_bandViews.assign(getNumberOfBands(), 0);
+      m_bandViewSources.assign(getNumberOfBands(), 0);
+   }
+   m_bandViews[band] = b;
+   m_bandViewSources[band] = owner;
+   return true;
 }
 
-void* ossimImageData::getBuf(ossim_uint32 band)
+bool ossimImageData::hasBandViews() const
 {
-   ossim_uint8* b = static_cast<ossim_uint8*>(getBuf());
+   return (m_bandViews.size() > 0);
+}
 
-   if (isValidBand(band) && b != 0)
+void ossimImageData::resolveBandViews()
+{
+   if ( m_bandViews.size() && !getContiguousBandViews() )
    {
-      b += (band * getSizePerBandInBytes());
-      return static_cast<void*>(b);
+      releaseBandViews();
    }
-   return 0;
+}
+
+void ossimImageData::releaseBandViews()
+{
+   if (m_bandViews.size())
+   {
+      copyBandViews(*this);
+      clearBandViews();
+   }
+}
+
+void ossimImageData::clearBandViews()
+{
+   m_bandViews.clear();
+   m_bandViewSources.clear();
+}
+
+void ossimImageData::clearBandView(ossim_uint32 band)
+{
+   if ( (band < m_bandViews.size()) && m_bandViews[band] )
+   {
+      m_bandViews[band] = 0;
+      m_bandViewSources[band] = 0;
+      if ( std::count(m_bandViews.begin(), m_bandViews.end(), (ossim_uint8*)0) ==
+           (std::ptrdiff_t)m_bandViews.size() )
+      {
+         clearBandViews();
+      }
+   }
+}
+
+void ossimImageData::copyBandViews(const ossimImageData& src)
+{
+   const ossim_uint64 BYTES = getSizePerBandInBytes();
+   for (ossim_uint32 band = 0; band < src.m_bandViews.size(); ++band)
+   {
+      if ( src.m_bandViews[band] && (m_dataBuffer.size() >= (band + 1) * BYTES) )
+      {
+         memcpy(&m_dataBuffer.front() + band * BYTES, src.m_bandViews[band], BYTES);
+      }
+   }
+}
+
+ossim_uint8* ossimImageData::getContiguousBandViews() const
+{
+   const ossim_uint64 BYTES = getSizePerBandInBytes();
+   for (ossim_uint32 band = 0; band < m_bandViews.size(); ++band)
+   {
+      if ( !m_bandViews[band] || (m_bandViewSources[band] != m_bandViewSources[0]) ||
+           (m_bandViews[band] != m_bandViews[0] + band * BYTES) )
+      {
+         return 0;
+      }
+   }
+   return m_bandViews.size() ? m_bandViews[0] : 0;
 }
 
 const ossim_uint8* ossimImageData::getUcharBuf() const
@@ -1556,11 +1672,7 @@ ossimDataObjectStatus ossimImageData::validate(T /* dummyTemplate */ ) const
       const T NP = static_cast<T>(m_nullPixelValue[band]);
       const T* p = static_cast<const T*>(getBuf(band));
 
-      for (ossim_uint32 i = 0; i < BOUNDS; ++i)
-      {
-         // check if the band is null
-         if (p[i] != NP) ++count;         
-      }
+      count += ossimImageDataKernels::countNonNull(p, BOUNDS, NP);
    }
 
    if (!count)
@@ -1583,6 +1695,8 @@ ossimDataObjectStatus ossimImageData::validate(T /* dummyTemplate */ ) const
 
 void ossimImageData::makeBlank()
 {
+   clearBandViews();
+
    if ( (m_dataBuffer.size() == 0) || (getDataObjectStatus() == OSSIM_EMPTY) )
    {
       return; // nothing to do...
@@ -2080,6 +2194,7 @@ ossim_float64 ossimImageData::getPix(ossim_uint32 offset, ossim_uint32 band) con
 
 void ossimImageData::fill(ossim_uint32 band, ossim_float64 value)
 {
+   clearBandView(band);
    void* s         = getBuf(band);
 
    if (s == 0) return; // nothing to do...
@@ -2327,7 +2442,7 @@ bool ossimImageData::isNull(ossim_uint32 offset)const
 {
    ossim_uint32 numberOfBands = getNumberOfBands();
    ossim_uint32 band=0;
-   if(!getBuf())
+   if(!getBuf(0))
    {
       return true;
    }
@@ -2958,6 +3073,7 @@ void ossimImageData::setNumberOfBands(ossim_uint32 bands,
    ossim_uint32 b  = getNumberOfBands();
    if(bands && (b != bands))
    {
+      clearBandViews();
       setNumberOfDataComponents(bands);
       if(reallocate)
       {
@@ -3059,6 +3175,11 @@ void ossimImageData::assign(const ossimDataObject* data)
 
 void ossimImageData::assign(const ossimImageData* data)
 {
+   if (this != data)
+   {
+      clearBandViews();
+   }
+
    ossimSource* tmp_owner = getOwner();
 
    ossimRectilinearDataObject::assign(data);
@@ -3152,6 +3273,7 @@ void ossimImageData::assignBand(const ossimImageData* data,
 
    // Get the pointers to the bands.
    const void*  s = data->getBuf(source_band);
+   clearBandView(output_band);
    void*        d = getBuf(output_band);
 
    // One last check.
@@ -3391,7 +3513,7 @@ void ossimImageData::loadTile(const ossimImageData* src)
       return;
    }
 
-   if (!src->getBuf())
+   if (!src->getBuf(0))
    {
       ossimNotify(ossimNotifyLevel_WARN)
                << "ossimImageData::loadTile ERROR:"
@@ -3421,7 +3543,16 @@ void ossimImageData::loadTile(const ossimImageData* src)
    //***
    setDataObjectStatus(src->getDataObjectStatus());
 
-   if(getScalarType() == src->getScalarType())
+   if ( (getScalarType() == src->getScalarType()) && src->hasBandViews() )
+   {
+      // Band at a time so the views aren't copied into src first:
+      for (ossim_uint32 band = 0; band < src->getNumberOfBands(); ++band)
+      {
+         loadBand(src->getBuf(band), src->getImageRectangle(), band);
+      }
+      setNullPix(src->getNullPix(), src->getNumberOfBands());
+   }
+   else if(getScalarType() == src->getScalarType())
    {      
       loadTile((void*)(src->getBuf()),
                src->getImageRectangle(),
@@ -4245,25 +4376,7 @@ void ossimImageData::computeMinMaxPix(T /* dummyValue */,
       if(bandBuffer)
       {
          const T NP   = static_cast<T>(getNullPix(band));
-         ossim_float64 currentMin = minBands[band];
-         ossim_float64 currentMax = maxBands[band];
-         for(ossim_uint32 offset = 0; offset < SPB; ++offset)
-         {
-            T p = bandBuffer[offset];
-            if(p != NP)
-            {
-               if(p < currentMin)
-               {
-                  currentMin = p;
-               }
-               else if(p > currentMax)
-               {
-                  currentMax = p;
-               }
-            }
-         }
-         minBands[band] = currentMin;
-         maxBands[band] = currentMax;
+         ossimImageDataKernels::minMax(bandBuffer, SPB, NP, minBands[band], maxBands[band]);
       }
    }
 }
@@ -4530,15 +4643,7 @@ void ossimImageData::loadTileFromBipTemplate(T, // dummy template variable
 
    for (ossim_uint32 line = 0; line < clipHeight; ++line)
    {
-      ossim_uint32 j = 0;
-      for (ossim_uint32 sample = 0; sample < clipWidth; ++sample)
-      {
-         for (band=0; band<num_bands; band++)
-         {
-            d[band][sample] = s[j+band];
-         }
-         j += num_bands;
-      }
+      ossimImageDataKernels::deinterleave(s, d, clipWidth, num_bands);
 
       s += s_width;
       for (band=0; band<num_bands; band++)
@@ -4720,10 +4825,7 @@ void ossimImageData::loadTileFromBilTemplate(T, // dummy template variable
    {
       for (band = 0; band < num_bands; ++band)
       {
-         for (ossim_uint32 sample = 0; sample < clipWidth; ++sample)
-         {
-            d[band][sample] = s[sample];
-         }
+         memcpy(d[band], s, clipWidth * sizeof(T));
          s       += s_width;
          d[band] += d_width;
       }
@@ -4810,11 +4912,7 @@ void ossimImageData::loadTileFromBsqTemplate(T, // dummy template variable
 
       for (ossim_uint32 line = 0; line < clipHeight; ++line)
       {
-         for (ossim_uint32 sample = 0; sample < clipWidth; ++sample)
-         {
-            destinationBand[destinationIndex + sample]
-                            = s[sourceIndex+sample];
-         }
+         memcpy(destinationBand + destinationIndex, s + sourceIndex, clipWidth * sizeof(T));
          sourceIndex += s_width;
          destinationIndex += d_width;
       }
@@ -5622,17 +5720,9 @@ ossimImageData::unloadTileToBipTemplate(T, // dummy template variable
          s[band] += src_offset;
       }
 
-      ossim_int32 j;
       for (ossim_int32 line=0; line<output_clip_height; ++line)
       {
-         j = 0;
-         for (ossim_int32 samp=0; samp<output_clip_width; ++samp, j+=num_bands)
-         {
-            for (band=0; band<num_bands; ++band)
-            {
-               d[j+band] = s[band][samp];
-            }
-         }
+         ossimImageDataKernels::interleave(s, d, output_clip_width, num_bands);
 
          // increment to next line...
          d += buf_width;
@@ -6515,33 +6605,11 @@ void ossimImageData::copyTileToNormalizedBuffer(T /* dummyTemplate */,
 
    for(ossim_uint32 band = 0; band < BANDS; ++band)
    {
-      const ossim_float64 MIN_PIX = getMinPix(band);
-      const ossim_float64 MAX_PIX = getMaxPix(band);
-      const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-      const ossim_float64 NP      = getNullPix(band);
-
       const T* s = (T*)getBuf(band);  // source
       ossim_float64* d = (ossim_float64*)(buf + (band*SIZE));  // destination
 
-      for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-      {
-         ossim_float64 p = s[offset];
-         if(p != NP)
-         {
-            if( p == MIN_PIX)
-            {
-               d[offset] = OSSIM_DEFAULT_MIN_PIX_NORM_DOUBLE;
-            }
-            else
-            {
-               d[offset] = (p-MIN_PIX)/RANGE;
-            }
-         }
-         else
-         {
-            d[offset] = 0.0;
-         }
-      }
+      ossimImageDataKernels::normalize(s, d, SIZE, getNullPix(band),
+                                       getMinPix(band), getMaxPix(band));
    }   
 }
 
@@ -6554,33 +6622,11 @@ void ossimImageData::copyTileToNormalizedBuffer(T /* dummyTemplate */,
 
    for(ossim_uint32 band = 0; band < BANDS; ++band)
    {
-      const ossim_float64 MIN_PIX = getMinPix(band);
-      const ossim_float64 MAX_PIX = getMaxPix(band);
-      const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-      const ossim_float64 NP      = getNullPix(band);
-
       const T* s = (T*)getBuf(band);  // source
       ossim_float32* d = (ossim_float32*)(buf + (band*SIZE));  // destination
 
-      for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-      {
-         ossim_float64 p = s[offset];
-         if(p != NP)
-         {
-            if( p == MIN_PIX)
-            {
-               d[offset] = OSSIM_DEFAULT_MIN_PIX_NORM_FLOAT;
-            }
-            else
-            {
-               d[offset] = (p-MIN_PIX)/RANGE;
-            }
-         }
-         else
-         {
-            d[offset] = 0.0;
-         }
-      }
+      ossimImageDataKernels::normalize(s, d, SIZE, getNullPix(band),
+                                       getMinPix(band), getMaxPix(band));
    }   
 }
 
@@ -6589,34 +6635,10 @@ void ossimImageData::copyTileToNormalizedBuffer(T /* dummyTemplate */,
                                                 ossim_uint32 band,
                                                 ossim_float64* buf) const
 {
-   const ossim_uint32  SIZE    = getSizePerBand();
-   const ossim_float64 MIN_PIX = getMinPix(band);
-   const ossim_float64 MAX_PIX = getMaxPix(band);
-   const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-   const ossim_float64 NP      = getNullPix(band);
-
    const T* s = (T*)getBuf(band);  // source
-   ossim_float64* d = (ossim_float64*)(buf);  // destination
 
-   for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-   {
-      ossim_float64 p = s[offset];
-      if(p != NP)
-      {
-         if( p == MIN_PIX)
-         {
-            d[offset] = OSSIM_DEFAULT_MIN_PIX_NORM_DOUBLE;
-         }
-         else
-         {
-            d[offset] = (p-MIN_PIX)/RANGE;
-         }
-      }
-      else
-      {
-         d[offset] = 0.0;
-      }
-   }   
+   ossimImageDataKernels::normalize(s, buf, getSizePerBand(), getNullPix(band),
+                                    getMinPix(band), getMaxPix(band));
 }
 
 template <class T>
@@ -6624,34 +6646,10 @@ void ossimImageData::copyTileToNormalizedBuffer(T /* dummyTemplate */,
                                                 ossim_uint32 band,
                                                 ossim_float32* buf) const
 {
-   const ossim_uint32  SIZE    = getSizePerBand();
-   const ossim_float64 MIN_PIX = getMinPix(band);
-   const ossim_float64 MAX_PIX = getMaxPix(band);
-   const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-   const ossim_float64 NP      = getNullPix(band);
-
    const T* s = (T*)getBuf(band);  // source
-   ossim_float32* d     = (ossim_float32*)(buf);  // destination
 
-   for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-   {
-      ossim_float64 p = s[offset];
-      if(p != NP)
-      {
-         if( p == MIN_PIX)
-         {
-            d[offset] = OSSIM_DEFAULT_MIN_PIX_NORM_FLOAT;
-         }
-         else
-         {
-            d[offset] = (p-MIN_PIX)/RANGE;
-         }
-      }
-      else
-      {
-         d[offset] = 0.0;
-      }
-   }   
+   ossimImageDataKernels::normalize(s, buf, getSizePerBand(), getNullPix(band),
+                                    getMinPix(band), getMaxPix(band));
 }
 
 template <class T>
@@ -6663,26 +6661,12 @@ void ossimImageData::copyNormalizedBufferToTile(T /* dummyTemplate */,
 
    for(ossim_uint32 band = 0; band < BANDS; ++band)
    {
-      const ossim_float64 MIN_PIX = getMinPix(band);
-      const ossim_float64 MAX_PIX = getMaxPix(band);
-      const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-      const T NP                  = (T)getNullPix(band);
-
       ossim_float64* s = buf + (band*SIZE); // source
       T* d   = (T*)getBuf(band); // destination
 
-      for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-      {
-         const ossim_float64 P = s[offset];
-         if(P != 0.0)
-         {
-            d[offset] = (T)(MIN_PIX + RANGE*P);
-         }
-         else
-         {
-            d[offset] = NP;
-         }
-      }
+      // Not clamped to the max pixel, unlike the others:
+      ossimImageDataKernels::unnormalize(s, d, SIZE, getNullPix(band),
+                                         getMinPix(band), getMaxPix(band), false);
    }
 }
 
@@ -6695,28 +6679,11 @@ void ossimImageData::copyNormalizedBufferToTile(T /* dummyTemplate */,
 
    for(ossim_uint32 band = 0; band < BANDS; ++band)
    {
-      const ossim_float64 MIN_PIX = getMinPix(band);
-      const ossim_float64 MAX_PIX = getMaxPix(band);
-      const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-      const T             NP      = (T)getNullPix(band);
-
       ossim_float32* s = buf + (band*SIZE); // source
       T* d   = (T*)getBuf(band); // destination
 
-      for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-      {
-         const ossim_float64 P = s[offset];
-         if(P != 0.0)
-         {
-            ossim_float64 test = MIN_PIX + RANGE*P;
-            if(test > MAX_PIX) test = MAX_PIX;
-            d[offset] = (T)test;
-         }
-         else
-         {
-            d[offset] = NP;
-         }
-      }
+      ossimImageDataKernels::unnormalize(s, d, SIZE, getNullPix(band),
+                                         getMinPix(band), getMaxPix(band), true);
    }
 }
 
@@ -6725,29 +6692,10 @@ void ossimImageData::copyNormalizedBufferToTile(T /* dummyTemplate */,
                                                 ossim_uint32 band,
                                                 ossim_float64* buf)
 {
-   const ossim_uint32  SIZE    = getSizePerBand();
-   const ossim_float64 MIN_PIX = getMinPix(band);
-   const ossim_float64 MAX_PIX = getMaxPix(band);
-   const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-   const T             NP      = (T)getNullPix(band);
-
-   ossim_float64* s = buf; // source
    T* d   = (T*)getBuf(band); // destination
 
-   for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-   {
-      const ossim_float64 P = s[offset];
-      if(P != 0.0)
-      {
-         ossim_float64 test = MIN_PIX + RANGE*P;
-         if(test > MAX_PIX) test = MAX_PIX;
-         d[offset] = (T)test;
-      }
-      else
-      {
-         d[offset] = NP;
-      }
-   }
+   ossimImageDataKernels::unnormalize(buf, d, getSizePerBand(), getNullPix(band),
+                                      getMinPix(band), getMaxPix(band), true);
 }
 
 template <class T>
@@ -6755,29 +6703,10 @@ void ossimImageData::copyNormalizedBufferToTile(T /* dummyTemplate */,
                                                 ossim_uint32 band,
                                                 ossim_float32* buf)
 {
-   const ossim_uint32 SIZE     = getSizePerBand();
-   const ossim_float64 MIN_PIX = getMinPix(band);
-   const ossim_float64 MAX_PIX = getMaxPix(band);
-   const ossim_float64 RANGE   = (MAX_PIX-MIN_PIX);
-   const T NP                  = (T)getNullPix(band);
-
-   ossim_float32* s = buf; // source
    T* d   = (T*)getBuf(band); // destination
 
-   for(ossim_uint32 offset = 0; offset < SIZE; ++offset)
-   {
-      const ossim_float64 P = s[offset];
-      if(P != 0.0)
-      {
-         ossim_float64 test = MIN_PIX + RANGE*P;
-         if(test > MAX_PIX) test = MAX_PIX;
-         d[offset] = (T)test;
-      }
-      else
-      {
-         d[offset] = NP;
-      }
-   }
+   ossimImageDataKernels::unnormalize(buf, d, getSizePerBand(), getNullPix(band),
+                                      getMinPix(band), getMaxPix(band), true);
 }
 
 void ossimImageData::copyTileBandToNormalizedBuffer(ossim_uint32 band,
@@ -7792,18 +7721,26 @@ void ossimImageData::getWidthHeight(ossim_uint32& w, ossim_uint32& h)
 
 void ossimImageData::setWidth(ossim_uint32 width)
 {
+   if (m_spatialExtents[0] != width)
+   {
+      clearBandViews();
+   }
    m_spatialExtents[0] = width;
 }
 
 void ossimImageData::setHeight(ossim_uint32 height)
 {
+   if (m_spatialExtents[1] != height)
+   {
+      clearBandViews();
+   }
    m_spatialExtents[1] = height;
 }
 
 void ossimImageData::setWidthHeight(ossim_uint32 w, ossim_uint32 h)
 {
-   m_spatialExtents[0] = w;
-   m_spatialExtents[1] = h;
+   setWidth(w);
+   setHeight(h);
 }
 
 void ossimImageData::setOrigin(const ossimIpt& origin)
@@ -7988,6 +7925,13 @@ bool ossimImageData::getIndexedFlag() const
 
 bool ossimImageData::saveState(ossimKeywordlist& kwl, const char* prefix)const
 {
+   if (m_bandViews.size())
+   {
+      // The base class saves its own buffer, so save a copy with the views copied in:
+      ossimImageData copy(*this);
+      return copy.saveState(kwl, prefix);
+   }
+
    bool result = ossimRectilinearDataObject::saveState(kwl, prefix);
    ossimString null_pixels;
    ossimString min_pixels;
@@ -8011,6 +7955,7 @@ bool ossimImageData::saveState(ossimKeywordlist& kwl, const char* prefix)const
 
 bool ossimImageData::loadState(const ossimKeywordlist& kwl, const char* prefix)
 {
+   clearBandViews();
    bool result = ossimRectilinearDataObject::loadState(kwl, prefix);
    m_spatialExtents.resize(2);
    if(result)
@@ -279,3 +279,8 @@ ossimRefPtr<ossimImageData> ossimImageDataFactory::create(
 
    return result;
 }
+
+ossimTileBufferPool* ossimImageDataFactory::getBufferPool()const
+{
+   return ossimTileBufferPool::instance();
+}
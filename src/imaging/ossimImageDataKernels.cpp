@@ -0,0 +1,894 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/imaging/ossimImageDataKernels.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define OSSIM_KERNELS_AVX2 1
+#  include <immintrin.h>
+#  define OSSIM_AVX2 __attribute__((target("avx2")))
+#endif
+
+//---
+// Plain loops, also the reference of the AVX2 ones.
+//---
+template <class F> static F minNorm();
+template <> ossim_float32 minNorm<ossim_float32>() { return OSSIM_DEFAULT_MIN_PIX_NORM_FLOAT; }
+template <> ossim_float64 minNorm<ossim_float64>() { return OSSIM_DEFAULT_MIN_PIX_NORM_DOUBLE; }
+
+template <class T, class F>
+static void normalizeLoop(const T* s, F* d, ossim_uint32 count, ossim_float64 nullPix,
+                          ossim_float64 minPix, ossim_float64 maxPix)
+{
+   const ossim_float64 RANGE = maxPix - minPix;
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      ossim_float64 p = s[i];
+      if (p != nullPix)
+      {
+         if (p == minPix)
+         {
+            d[i] = minNorm<F>();
+         }
+         else
+         {
+            d[i] = (p - minPix) / RANGE;
+         }
+      }
+      else
+      {
+         d[i] = 0.0;
+      }
+   }
+}
+
+template <class T, class F>
+static void unnormalizeLoop(const F* s, T* d, ossim_uint32 count, ossim_float64 nullPix,
+                            ossim_float64 minPix, ossim_float64 maxPix, bool clampToMax)
+{
+   const ossim_float64 RANGE = maxPix - minPix;
+   const T NP = static_cast<T>(nullPix);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      const ossim_float64 P = s[i];
+      if (P != 0.0)
+      {
+         ossim_float64 test = minPix + RANGE * P;
+         if (clampToMax && (test > maxPix))
+         {
+            test = maxPix;
+         }
+         d[i] = static_cast<T>(test);
+      }
+      else
+      {
+         d[i] = NP;
+      }
+   }
+}
+
+template <class T>
+static ossim_uint32 countNonNullLoop(const T* s, ossim_uint32 count, T nullPix)
+{
+   ossim_uint32 result = 0;
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      if (s[i] != nullPix)
+      {
+         ++result;
+      }
+   }
+   return result;
+}
+
+template <class T>
+static void minMaxLoop(const T* s, ossim_uint32 count, T nullPix,
+                       ossim_float64& minPix, ossim_float64& maxPix)
+{
+   ossim_float64 currentMin = minPix;
+   ossim_float64 currentMax = maxPix;
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      const T P = s[i];
+      if (P != nullPix)
+      {
+         if (P < currentMin)
+         {
+            currentMin = P;
+         }
+         if (P > currentMax)
+         {
+            currentMax = P;
+         }
+      }
+   }
+   minPix = currentMin;
+   maxPix = currentMax;
+}
+
+template <class T>
+static void deinterleaveLoop(const T* s, T* const* d, ossim_uint32 count, ossim_uint32 bands)
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         d[band][i] = s[band];
+      }
+      s += bands;
+   }
+}
+
+template <class T>
+static void interleaveLoop(const T* const* s, T* d, ossim_uint32 count, ossim_uint32 bands)
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         d[band] = s[band][i];
+      }
+      d += bands;
+   }
+}
+
+#ifdef OSSIM_KERNELS_AVX2
+
+//---
+// AVX2 kernels. Types without one get the generic templates, which return false so the plain
+// loop runs. Four pixels at a time go through double precision, as the plain loops do.
+//---
+template <class T, class F>
+static bool normalizeAvx2(const T*, F*, ossim_uint32, ossim_float64, ossim_float64,
+                          ossim_float64)
+{
+   return false;
+}
+template <class T, class F>
+static bool unnormalizeAvx2(const F*, T*, ossim_uint32, ossim_float64, ossim_float64,
+                            ossim_float64, bool)
+{
+   return false;
+}
+template <class T>
+static bool countNonNullAvx2(const T*, ossim_uint32, T, ossim_uint32&)
+{
+   return false;
+}
+template <class T>
+static bool minMaxAvx2(const T*, ossim_uint32, T, ossim_float64&, ossim_float64&)
+{
+   return false;
+}
+
+static inline OSSIM_AVX2 __m256d load4(const ossim_uint8* s)
+{
+   ossim_int32 v;
+   memcpy(&v, s, sizeof(v));
+   return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(v)));
+}
+static inline OSSIM_AVX2 __m256d load4(const ossim_uint16* s)
+{
+   return _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)s)));
+}
+static inline OSSIM_AVX2 __m256d load4(const ossim_sint16* s)
+{
+   return _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*)s)));
+}
+static inline OSSIM_AVX2 __m256d load4(const ossim_float32* s)
+{
+   return _mm256_cvtps_pd(_mm_loadu_ps(s));
+}
+static inline OSSIM_AVX2 __m256d load4(const ossim_float64* s)
+{
+   return _mm256_loadu_pd(s);
+}
+
+// Low 32 bits of each 64 bit lane, e.g. a double compare mask as int or float lanes:
+static inline OSSIM_AVX2 __m128i narrowMask(__m256d mask)
+{
+   const __m256i LOW = _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0);
+   return _mm256_castsi256_si128(
+      _mm256_permutevar8x32_epi32(_mm256_castpd_si256(mask), LOW));
+}
+
+//---
+// store4 writes four doubles as T with the plain loops' casts: nulls where mask is set,
+// truncation to int32 then the low bits for the integer types.
+//---
+static inline OSSIM_AVX2 void store4(ossim_float64* d, __m256d v, __m256d mask, ossim_float64 np)
+{
+   _mm256_storeu_pd(d, _mm256_blendv_pd(v, _mm256_set1_pd(np), mask));
+}
+static inline OSSIM_AVX2 void store4(ossim_float32* d, __m256d v, __m256d mask, ossim_float32 np)
+{
+   __m128 f = _mm256_cvtpd_ps(v);
+   _mm_storeu_ps(d, _mm_blendv_ps(f, _mm_set1_ps(np), _mm_castsi128_ps(narrowMask(mask))));
+}
+static inline OSSIM_AVX2 __m128i truncate4(__m256d v, __m256d mask, ossim_int32 np)
+{
+   return _mm_blendv_epi8(_mm256_cvttpd_epi32(v), _mm_set1_epi32(np), narrowMask(mask));
+}
+static inline OSSIM_AVX2 void store4(ossim_uint8* d, __m256d v, __m256d mask, ossim_uint8 np)
+{
+   __m128i i = _mm_and_si128(truncate4(v, mask, np), _mm_set1_epi32(0xff));
+   i = _mm_packus_epi16(_mm_packus_epi32(i, i), i);
+   ossim_int32 bytes = _mm_cvtsi128_si32(i);
+   memcpy(d, &bytes, sizeof(bytes));
+}
+static inline OSSIM_AVX2 void store4(ossim_uint16* d, __m256d v, __m256d mask, ossim_uint16 np)
+{
+   __m128i i = _mm_and_si128(truncate4(v, mask, np), _mm_set1_epi32(0xffff));
+   _mm_storel_epi64((__m128i*)d, _mm_packus_epi32(i, i));
+}
+static inline OSSIM_AVX2 void store4(ossim_sint16* d, __m256d v, __m256d mask, ossim_sint16 np)
+{
+   __m128i i = _mm_srai_epi32(_mm_slli_epi32(truncate4(v, mask, np), 16), 16);
+   _mm_storel_epi64((__m128i*)d, _mm_packs_epi32(i, i));
+}
+
+template <class T, class F>
+static OSSIM_AVX2 void normalizeRun(const T* s, F* d, ossim_uint32 count, ossim_float64 nullPix,
+                                    ossim_float64 minPix, ossim_float64 maxPix)
+{
+   const __m256d NP    = _mm256_set1_pd(nullPix);
+   const __m256d MIN   = _mm256_set1_pd(minPix);
+   const __m256d RANGE = _mm256_set1_pd(maxPix - minPix);
+   const __m256d NORM  = _mm256_set1_pd(minNorm<F>());
+   const ossim_uint32 END = count & ~3u;
+   for (ossim_uint32 i = 0; i < END; i += 4)
+   {
+      const __m256d P = load4(s + i);
+      __m256d v = _mm256_div_pd(_mm256_sub_pd(P, MIN), RANGE);
+      v = _mm256_blendv_pd(v, NORM, _mm256_cmp_pd(P, MIN, _CMP_EQ_OQ));
+      store4(d + i, v, _mm256_cmp_pd(P, NP, _CMP_EQ_OQ), F(0));
+   }
+   normalizeLoop(s + END, d + END, count - END, nullPix, minPix, maxPix);
+}
+
+template <class T, class F>
+static OSSIM_AVX2 void unnormalizeRun(const F* s, T* d, ossim_uint32 count,
+                                      ossim_float64 nullPix, ossim_float64 minPix,
+                                      ossim_float64 maxPix, bool clampToMax)
+{
+   const T       NP    = static_cast<T>(nullPix);
+   const __m256d MIN   = _mm256_set1_pd(minPix);
+   const __m256d MAX   = _mm256_set1_pd(maxPix);
+   const __m256d RANGE = _mm256_set1_pd(maxPix - minPix);
+   const __m256d ZERO  = _mm256_setzero_pd();
+   const ossim_uint32 END = count & ~3u;
+   for (ossim_uint32 i = 0; i < END; i += 4)
+   {
+      const __m256d P = load4(s + i);
+
+      // Multiply then add, never fused, as the plain loop:
+      __m256d test = _mm256_add_pd(MIN, _mm256_mul_pd(RANGE, P));
+      if (clampToMax)
+      {
+         test = _mm256_blendv_pd(test, MAX, _mm256_cmp_pd(test, MAX, _CMP_GT_OQ));
+      }
+      store4(d + i, test, _mm256_cmp_pd(P, ZERO, _CMP_EQ_OQ), NP);
+   }
+   unnormalizeLoop(s + END, d + END, count - END, nullPix, minPix, maxPix, clampToMax);
+}
+
+#define OSSIM_NORMALIZE_AVX2(T)                                                                    \
+static bool normalizeAvx2(const T* s, ossim_float32* d, ossim_uint32 count,                        \
+                          ossim_float64 nullPix, ossim_float64 minPix, ossim_float64 maxPix)       \
+{                                                                                                  \
+   normalizeRun(s, d, count, nullPix, minPix, maxPix);                                             \
+   return true;                                                                                    \
+}                                                                                                  \
+static bool normalizeAvx2(const T* s, ossim_float64* d, ossim_uint32 count,                        \
+                          ossim_float64 nullPix, ossim_float64 minPix, ossim_float64 maxPix)       \
+{                                                                                                  \
+   normalizeRun(s, d, count, nullPix, minPix, maxPix);                                             \
+   return true;                                                                                    \
+}                                                                                                  \
+static bool unnormalizeAvx2(const ossim_float32* s, T* d, ossim_uint32 count,                      \
+                            ossim_float64 nullPix, ossim_float64 minPix, ossim_float64 maxPix,     \
+                            bool clampToMax)                                                       \
+{                                                                                                  \
+   unnormalizeRun(s, d, count, nullPix, minPix, maxPix, clampToMax);                               \
+   return true;                                                                                    \
+}                                                                                                  \
+static bool unnormalizeAvx2(const ossim_float64* s, T* d, ossim_uint32 count,                      \
+                            ossim_float64 nullPix, ossim_float64 minPix, ossim_float64 maxPix,     \
+                            bool clampToMax)                                                       \
+{                                                                                                  \
+   unnormalizeRun(s, d, count, nullPix, minPix, maxPix, clampToMax);                               \
+   return true;                                                                                    \
+}
+
+OSSIM_NORMALIZE_AVX2(ossim_uint8)
+OSSIM_NORMALIZE_AVX2(ossim_uint16)
+OSSIM_NORMALIZE_AVX2(ossim_sint16)
+OSSIM_NORMALIZE_AVX2(ossim_float32)
+OSSIM_NORMALIZE_AVX2(ossim_float64)
+
+#undef OSSIM_NORMALIZE_AVX2
+
+static inline int popCount(ossim_uint32 bits)
+{
+   return __builtin_popcount(bits);
+}
+
+static OSSIM_AVX2 bool countNonNullAvx2(const ossim_uint8* s, ossim_uint32 count,
+                                        ossim_uint8 nullPix, ossim_uint32& result)
+{
+   const __m256i NP = _mm256_set1_epi8(static_cast<char>(nullPix));
+   const ossim_uint32 END = count & ~31u;
+   ossim_uint32 nulls = 0;
+   for (ossim_uint32 i = 0; i < END; i += 32)
+   {
+      const __m256i X = _mm256_loadu_si256((const __m256i*)(s + i));
+      nulls += popCount(_mm256_movemask_epi8(_mm256_cmpeq_epi8(X, NP)));
+   }
+   result = END - nulls + countNonNullLoop(s + END, count - END, nullPix);
+   return true;
+}
+
+template <class T>
+static OSSIM_AVX2 ossim_uint32 countNonNull16(const T* s, ossim_uint32 count, T nullPix)
+{
+   const __m256i NP = _mm256_set1_epi16(static_cast<short>(nullPix));
+   const ossim_uint32 END = count & ~15u;
+   ossim_uint32 nullBytes = 0;
+   for (ossim_uint32 i = 0; i < END; i += 16)
+   {
+      const __m256i X = _mm256_loadu_si256((const __m256i*)(s + i));
+      nullBytes += popCount(_mm256_movemask_epi8(_mm256_cmpeq_epi16(X, NP)));
+   }
+   return END - nullBytes / 2 + countNonNullLoop(s + END, count - END, nullPix);
+}
+
+static bool countNonNullAvx2(const ossim_uint16* s, ossim_uint32 count,
+                             ossim_uint16 nullPix, ossim_uint32& result)
+{
+   result = countNonNull16(s, count, nullPix);
+   return true;
+}
+
+static bool countNonNullAvx2(const ossim_sint16* s, ossim_uint32 count,
+                             ossim_sint16 nullPix, ossim_uint32& result)
+{
+   result = countNonNull16(s, count, nullPix);
+   return true;
+}
+
+// Unordered not equal, true for NaN, as != is:
+static OSSIM_AVX2 bool countNonNullAvx2(const ossim_float32* s, ossim_uint32 count,
+                                        ossim_float32 nullPix, ossim_uint32& result)
+{
+   const __m256 NP = _mm256_set1_ps(nullPix);
+   const ossim_uint32 END = count & ~7u;
+   ossim_uint32 n = 0;
+   for (ossim_uint32 i = 0; i < END; i += 8)
+   {
+      n += popCount(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(s + i), NP, _CMP_NEQ_UQ)));
+   }
+   result = n + countNonNullLoop(s + END, count - END, nullPix);
+   return true;
+}
+
+static OSSIM_AVX2 bool countNonNullAvx2(const ossim_float64* s, ossim_uint32 count,
+                                        ossim_float64 nullPix, ossim_uint32& result)
+{
+   const __m256d NP = _mm256_set1_pd(nullPix);
+   const ossim_uint32 END = count & ~3u;
+   ossim_uint32 n = 0;
+   for (ossim_uint32 i = 0; i < END; i += 4)
+   {
+      n += popCount(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(s + i), NP, _CMP_NEQ_UQ)));
+   }
+   result = n + countNonNullLoop(s + END, count - END, nullPix);
+   return true;
+}
+
+//---
+// Min/max: nulls are replaced by values that can not win, the lanes are only folded in when
+// one of them saw a value.
+//---
+template <class T>
+static void foldMinMax(const T* lanesMin, const T* lanesMax, ossim_uint32 lanes,
+                       ossim_float64& minPix, ossim_float64& maxPix)
+{
+   for (ossim_uint32 i = 0; i < lanes; ++i)
+   {
+      if (lanesMin[i] < minPix)
+      {
+         minPix = lanesMin[i];
+      }
+      if (lanesMax[i] > maxPix)
+      {
+         maxPix = lanesMax[i];
+      }
+   }
+}
+
+static OSSIM_AVX2 bool minMaxAvx2(const ossim_uint8* s, ossim_uint32 count, ossim_uint8 nullPix,
+                                  ossim_float64& minPix, ossim_float64& maxPix)
+{
+   const __m256i NP = _mm256_set1_epi8(static_cast<char>(nullPix));
+   const ossim_uint32 END = count & ~31u;
+   __m256i vmin  = _mm256_set1_epi8(-1);
+   __m256i vmax  = _mm256_setzero_si256();
+   __m256i valid = _mm256_setzero_si256();
+   for (ossim_uint32 i = 0; i < END; i += 32)
+   {
+      const __m256i X = _mm256_loadu_si256((const __m256i*)(s + i));
+      const __m256i M = _mm256_cmpeq_epi8(X, NP);
+      vmin  = _mm256_min_epu8(vmin, _mm256_or_si256(X, M));
+      vmax  = _mm256_max_epu8(vmax, _mm256_andnot_si256(M, X));
+      valid = _mm256_or_si256(valid, _mm256_xor_si256(M, _mm256_set1_epi8(-1)));
+   }
+   if (!_mm256_testz_si256(valid, valid))
+   {
+      ossim_uint8 lanesMin[32];
+      ossim_uint8 lanesMax[32];
+      _mm256_storeu_si256((__m256i*)lanesMin, vmin);
+      _mm256_storeu_si256((__m256i*)lanesMax, vmax);
+      foldMinMax(lanesMin, lanesMax, 32, minPix, maxPix);
+   }
+   minMaxLoop(s + END, count - END, nullPix, minPix, maxPix);
+   return true;
+}
+
+static OSSIM_AVX2 bool minMaxAvx2(const ossim_uint16* s, ossim_uint32 count, ossim_uint16 nullPix,
+                                  ossim_float64& minPix, ossim_float64& maxPix)
+{
+   const __m256i NP = _mm256_set1_epi16(static_cast<short>(nullPix));
+   const ossim_uint32 END = count & ~15u;
+   __m256i vmin  = _mm256_set1_epi16(-1);
+   __m256i vmax  = _mm256_setzero_si256();
+   __m256i valid = _mm256_setzero_si256();
+   for (ossim_uint32 i = 0; i < END; i += 16)
+   {
+      const __m256i X = _mm256_loadu_si256((const __m256i*)(s + i));
+      const __m256i M = _mm256_cmpeq_epi16(X, NP);
+      vmin  = _mm256_min_epu16(vmin, _mm256_or_si256(X, M));
+      vmax  = _mm256_max_epu16(vmax, _mm256_andnot_si256(M, X));
+      valid = _mm256_or_si256(valid, _mm256_xor_si256(M, _mm256_set1_epi16(-1)));
+   }
+   if (!_mm256_testz_si256(valid, valid))
+   {
+      ossim_uint16 lanesMin[16];
+      ossim_uint16 lanesMax[16];
+      _mm256_storeu_si256((__m256i*)lanesMin, vmin);
+      _mm256_storeu_si256((__m256i*)lanesMax, vmax);
+      foldMinMax(lanesMin, lanesMax, 16, minPix, maxPix);
+   }
+   minMaxLoop(s + END, count - END, nullPix, minPix, maxPix);
+   return true;
+}
+
+static OSSIM_AVX2 bool minMaxAvx2(const ossim_sint16* s, ossim_uint32 count, ossim_sint16 nullPix,
+                                  ossim_float64& minPix, ossim_float64& maxPix)
+{
+   const __m256i NP     = _mm256_set1_epi16(nullPix);
+   const __m256i HIGHEST = _mm256_set1_epi16(std::numeric_limits<ossim_sint16>::max());
+   const __m256i LOWEST  = _mm256_set1_epi16(std::numeric_limits<ossim_sint16>::min());
+   const ossim_uint32 END = count & ~15u;
+   __m256i vmin  = HIGHEST;
+   __m256i vmax  = LOWEST;
+   __m256i valid = _mm256_setzero_si256();
+   for (ossim_uint32 i = 0; i < END; i += 16)
+   {
+      const __m256i X = _mm256_loadu_si256((const __m256i*)(s + i));
+      const __m256i M = _mm256_cmpeq_epi16(X, NP);
+      vmin  = _mm256_min_epi16(vmin, _mm256_blendv_epi8(X, HIGHEST, M));
+      vmax  = _mm256_max_epi16(vmax, _mm256_blendv_epi8(X, LOWEST, M));
+      valid = _mm256_or_si256(valid, _mm256_xor_si256(M, _mm256_set1_epi16(-1)));
+   }
+   if (!_mm256_testz_si256(valid, valid))
+   {
+      ossim_sint16 lanesMin[16];
+      ossim_sint16 lanesMax[16];
+      _mm256_storeu_si256((__m256i*)lanesMin, vmin);
+      _mm256_storeu_si256((__m256i*)lanesMax, vmax);
+      foldMinMax(lanesMin, lanesMax, 16, minPix, maxPix);
+   }
+   minMaxLoop(s + END, count - END, nullPix, minPix, maxPix);
+   return true;
+}
+
+// NaN is not null but never compares, so it is skipped like a null:
+static OSSIM_AVX2 bool minMaxAvx2(const ossim_float32* s, ossim_uint32 count,
+                                  ossim_float32 nullPix,
+                                  ossim_float64& minPix, ossim_float64& maxPix)
+{
+   const __m256 NP   = _mm256_set1_ps(nullPix);
+   const __m256 HIGH = _mm256_set1_ps(std::numeric_limits<ossim_float32>::infinity());
+   const __m256 LOW  = _mm256_set1_ps(-std::numeric_limits<ossim_float32>::infinity());
+   const ossim_uint32 END = count & ~7u;
+   __m256 vmin = HIGH;
+   __m256 vmax = LOW;
+   int    seen = 0;
+   for (ossim_uint32 i = 0; i < END; i += 8)
+   {
+      const __m256 X = _mm256_loadu_ps(s + i);
+      const __m256 V = _mm256_andnot_ps(_mm256_cmp_ps(X, NP, _CMP_EQ_OQ),
+                                        _mm256_cmp_ps(X, X, _CMP_ORD_Q));
+      vmin  = _mm256_min_ps(vmin, _mm256_blendv_ps(HIGH, X, V));
+      vmax  = _mm256_max_ps(vmax, _mm256_blendv_ps(LOW, X, V));
+      seen |= _mm256_movemask_ps(V);
+   }
+   if (seen)
+   {
+      ossim_float32 lanesMin[8];
+      ossim_float32 lanesMax[8];
+      _mm256_storeu_ps(lanesMin, vmin);
+      _mm256_storeu_ps(lanesMax, vmax);
+      foldMinMax(lanesMin, lanesMax, 8, minPix, maxPix);
+   }
+   minMaxLoop(s + END, count - END, nullPix, minPix, maxPix);
+   return true;
+}
+
+static OSSIM_AVX2 bool minMaxAvx2(const ossim_float64* s, ossim_uint32 count,
+                                  ossim_float64 nullPix,
+                                  ossim_float64& minPix, ossim_float64& maxPix)
+{
+   const __m256d NP   = _mm256_set1_pd(nullPix);
+   const __m256d HIGH = _mm256_set1_pd(std::numeric_limits<ossim_float64>::infinity());
+   const __m256d LOW  = _mm256_set1_pd(-std::numeric_limits<ossim_float64>::infinity());
+   const ossim_uint32 END = count & ~3u;
+   __m256d vmin = HIGH;
+   __m256d vmax = LOW;
+   int     seen = 0;
+   for (ossim_uint32 i = 0; i < END; i += 4)
+   {
+      const __m256d X = _mm256_loadu_pd(s + i);
+      const __m256d V = _mm256_andnot_pd(_mm256_cmp_pd(X, NP, _CMP_EQ_OQ),
+                                         _mm256_cmp_pd(X, X, _CMP_ORD_Q));
+      vmin  = _mm256_min_pd(vmin, _mm256_blendv_pd(HIGH, X, V));
+      vmax  = _mm256_max_pd(vmax, _mm256_blendv_pd(LOW, X, V));
+      seen |= _mm256_movemask_pd(V);
+   }
+   if (seen)
+   {
+      ossim_float64 lanesMin[4];
+      ossim_float64 lanesMax[4];
+      _mm256_storeu_pd(lanesMin, vmin);
+      _mm256_storeu_pd(lanesMax, vmax);
+      foldMinMax(lanesMin, lanesMax, 4, minPix, maxPix);
+   }
+   minMaxLoop(s + END, count - END, nullPix, minPix, maxPix);
+   return true;
+}
+
+//---
+// Band interleave by byte shuffles. One 16 byte vector per band holds 16 / sizeof(T) pixels, the
+// same pixels interleaved take one vector per band too. Each output vector is the or of one
+// shuffle per input vector, the masks pick the bytes that land in it and zero the rest. Only 8 and
+// 16 bit samples gain from it; wider ones move few enough pixels per vector that the plain loop
+// is as fast.
+//---
+struct ShuffleMasks
+{
+   ossim_uint8 split[4][4][16]; ///< [band][input vector], interleaved to bands.
+   ossim_uint8 merge[4][4][16]; ///< [output vector][band], bands to interleaved.
+};
+
+static ShuffleMasks makeShuffleMasks(ossim_uint32 size, ossim_uint32 bands)
+{
+   ShuffleMasks masks;
+   memset(&masks, 0x80, sizeof(masks));
+   for (ossim_uint32 band = 0; band < bands; ++band)
+   {
+      for (ossim_uint32 k = 0; k < 16; ++k)
+      {
+         // Byte k of band's vector is byte b of pixel j:
+         const ossim_uint32 J   = k / size;
+         const ossim_uint32 IDX = (J * bands + band) * size + k % size;
+         masks.split[band][IDX / 16][k]  = static_cast<ossim_uint8>(IDX % 16);
+         masks.merge[IDX / 16][band][IDX % 16] = static_cast<ossim_uint8>(k);
+      }
+   }
+   return masks;
+}
+
+// Sizes 1 and 2 bytes by 2 to 4 bands:
+static const ShuffleMasks& shuffleMasks(ossim_uint32 size, ossim_uint32 bands)
+{
+   struct Table
+   {
+      Table()
+      {
+         for (ossim_uint32 s = 0; s < 2; ++s)
+         {
+            for (ossim_uint32 b = 0; b < 3; ++b)
+            {
+               masks[s][b] = makeShuffleMasks(1 << s, b + 2);
+            }
+         }
+      }
+      ShuffleMasks masks[2][3];
+   };
+   static const Table TABLE;
+   return TABLE.masks[size - 1][bands - 2];
+}
+
+template <class T>
+static OSSIM_AVX2 bool deinterleaveAvx2(const T* s, T* const* d, ossim_uint32 count,
+                                        ossim_uint32 bands)
+{
+   if ( (sizeof(T) > 2) || (bands < 2) || (bands > 4) )
+   {
+      return false;
+   }
+   const ShuffleMasks& MASKS = shuffleMasks(sizeof(T), bands);
+   __m128i masks[4][4];
+   for (ossim_uint32 band = 0; band < bands; ++band)
+   {
+      for (ossim_uint32 v = 0; v < bands; ++v)
+      {
+         masks[band][v] = _mm_loadu_si128((const __m128i*)MASKS.split[band][v]);
+      }
+   }
+
+   const ossim_uint32 STEP = 16 / sizeof(T);
+   const ossim_uint32 END  = count - count % STEP;
+   __m128i in[4];
+   for (ossim_uint32 i = 0; i < END; i += STEP)
+   {
+      const char* src = reinterpret_cast<const char*>(s + i * bands);
+      for (ossim_uint32 v = 0; v < bands; ++v)
+      {
+         in[v] = _mm_loadu_si128((const __m128i*)(src + 16 * v));
+      }
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         __m128i out = _mm_shuffle_epi8(in[0], masks[band][0]);
+         for (ossim_uint32 v = 1; v < bands; ++v)
+         {
+            out = _mm_or_si128(out, _mm_shuffle_epi8(in[v], masks[band][v]));
+         }
+         _mm_storeu_si128((__m128i*)(d[band] + i), out);
+      }
+   }
+   if (END < count)
+   {
+      T* tail[4];
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         tail[band] = d[band] + END;
+      }
+      deinterleaveLoop(s + END * bands, tail, count - END, bands);
+   }
+   return true;
+}
+
+template <class T>
+static OSSIM_AVX2 bool interleaveAvx2(const T* const* s, T* d, ossim_uint32 count,
+                                      ossim_uint32 bands)
+{
+   if ( (sizeof(T) > 2) || (bands < 2) || (bands > 4) )
+   {
+      return false;
+   }
+   const ShuffleMasks& MASKS = shuffleMasks(sizeof(T), bands);
+   __m128i masks[4][4];
+   for (ossim_uint32 v = 0; v < bands; ++v)
+   {
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         masks[v][band] = _mm_loadu_si128((const __m128i*)MASKS.merge[v][band]);
+      }
+   }
+
+   const ossim_uint32 STEP = 16 / sizeof(T);
+   const ossim_uint32 END  = count - count % STEP;
+   __m128i in[4];
+   for (ossim_uint32 i = 0; i < END; i += STEP)
+   {
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         in[band] = _mm_loadu_si128((const __m128i*)(s[band] + i));
+      }
+      char* dst = reinterpret_cast<char*>(d + i * bands);
+      for (ossim_uint32 v = 0; v < bands; ++v)
+      {
+         __m128i out = _mm_shuffle_epi8(in[0], masks[v][0]);
+         for (ossim_uint32 band = 1; band < bands; ++band)
+         {
+            out = _mm_or_si128(out, _mm_shuffle_epi8(in[band], masks[v][band]));
+         }
+         _mm_storeu_si128((__m128i*)(dst + 16 * v), out);
+      }
+   }
+   if (END < count)
+   {
+      const T* tail[4];
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         tail[band] = s[band] + END;
+      }
+      interleaveLoop(tail, d + END * bands, count - END, bands);
+   }
+   return true;
+}
+
+#endif /* #ifdef OSSIM_KERNELS_AVX2 */
+
+//---
+// Dispatch.
+//---
+static ossimImageDataKernels::Isa detectIsa()
+{
+#ifdef OSSIM_KERNELS_AVX2
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+   {
+      return ossimImageDataKernels::ISA_AVX2;
+   }
+#endif
+   return ossimImageDataKernels::ISA_SCALAR;
+}
+
+static std::atomic<int>& isaSetting()
+{
+   static std::atomic<int> isa(-1);
+   return isa;
+}
+
+ossimImageDataKernels::Isa ossimImageDataKernels::getBestIsa()
+{
+   static const Isa BEST = detectIsa();
+   return BEST;
+}
+
+ossimImageDataKernels::Isa ossimImageDataKernels::getIsa()
+{
+   int isa = isaSetting();
+   if (isa < 0)
+   {
+      isa = getBestIsa();
+      const char* lookup = ossimPreferences::instance()->findPreference("image_data.simd");
+      if (lookup && !ossimString(lookup).toBool())
+      {
+         isa = ISA_SCALAR;
+      }
+      isaSetting() = isa;
+   }
+   return static_cast<Isa>(isa);
+}
+
+void ossimImageDataKernels::setIsa(Isa isa)
+{
+   isaSetting() = (isa > getBestIsa()) ? getBestIsa() : isa;
+}
+
+const char* ossimImageDataKernels::getIsaName(Isa isa)
+{
+   return (isa == ISA_AVX2) ? "avx2" : "scalar";
+}
+
+template <class T, class F>
+void ossimImageDataKernels::normalize(const T* s, F* d, ossim_uint32 count,
+                                      ossim_float64 nullPix, ossim_float64 minPix,
+                                      ossim_float64 maxPix)
+{
+#ifdef OSSIM_KERNELS_AVX2
+   if ( (getIsa() == ISA_AVX2) && normalizeAvx2(s, d, count, nullPix, minPix, maxPix) )
+   {
+      return;
+   }
+#endif
+   normalizeLoop(s, d, count, nullPix, minPix, maxPix);
+}
+
+template <class T, class F>
+void ossimImageDataKernels::unnormalize(const F* s, T* d, ossim_uint32 count,
+                                        ossim_float64 nullPix, ossim_float64 minPix,
+                                        ossim_float64 maxPix, bool clampToMax)
+{
+#ifdef OSSIM_KERNELS_AVX2
+   if ( (getIsa() == ISA_AVX2) &&
+        unnormalizeAvx2(s, d, count, nullPix, minPix, maxPix, clampToMax) )
+   {
+      return;
+   }
+#endif
+   unnormalizeLoop(s, d, count, nullPix, minPix, maxPix, clampToMax);
+}
+
+template <class T>
+ossim_uint32 ossimImageDataKernels::countNonNull(const T* s, ossim_uint32 count, T nullPix)
+{
+#ifdef OSSIM_KERNELS_AVX2
+   ossim_uint32 result = 0;
+   if ( (getIsa() == ISA_AVX2) && countNonNullAvx2(s, count, nullPix, result) )
+   {
+      return result;
+   }
+#endif
+   return countNonNullLoop(s, count, nullPix);
+}
+
+template <class T>
+void ossimImageDataKernels::minMax(const T* s, ossim_uint32 count, T nullPix,
+                                   ossim_float64& minPix, ossim_float64& maxPix)
+{
+#ifdef OSSIM_KERNELS_AVX2
+   if ( (getIsa() == ISA_AVX2) && minMaxAvx2(s, count, nullPix, minPix, maxPix) )
+   {
+      return;
+   }
+#endif
+   minMaxLoop(s, count, nullPix, minPix, maxPix);
+}
+
+template <class T>
+void ossimImageDataKernels::deinterleave(const T* s, T* const* d, ossim_uint32 count,
+                                         ossim_uint32 bands)
+{
+   if (bands == 1)
+   {
+      memcpy(d[0], s, count * sizeof(T));
+      return;
+   }
+#ifdef OSSIM_KERNELS_AVX2
+   if ( (getIsa() == ISA_AVX2) && deinterleaveAvx2(s, d, count, bands) )
+   {
+      return;
+   }
+#endif
+   deinterleaveLoop(s, d, count, bands);
+}
+
+template <class T>
+void ossimImageDataKernels::interleave(const T* const* s, T* d, ossim_uint32 count,
+                                       ossim_uint32 bands)
+{
+   if (bands == 1)
+   {
+      memcpy(d, s[0], count * sizeof(T));
+      return;
+   }
+#ifdef OSSIM_KERNELS_AVX2
+   if ( (getIsa() == ISA_AVX2) && interleaveAvx2(s, d, count, bands) )
+   {
+      return;
+   }
+#endif
+   interleaveLoop(s, d, count, bands);
+}
+
+#define OSSIM_INSTANTIATE_KERNELS(T)                                                               \
+template void ossimImageDataKernels::normalize<T, ossim_float32>(                                  \
+   const T*, ossim_float32*, ossim_uint32, ossim_float64, ossim_float64, ossim_float64);           \
+template void ossimImageDataKernels::normalize<T, ossim_float64>(                                  \
+   const T*, ossim_float64*, ossim_uint32, ossim_float64, ossim_float64, ossim_float64);           \
+template void ossimImageDataKernels::unnormalize<T, ossim_float32>(                                \
+   const ossim_float32*, T*, ossim_uint32, ossim_float64, ossim_float64, ossim_float64, bool);     \
+template void ossimImageDataKernels::unnormalize<T, ossim_float64>(                                \
+   const ossim_float64*, T*, ossim_uint32, ossim_float64, ossim_float64, ossim_float64, bool);     \
+template ossim_uint32 ossimImageDataKernels::countNonNull<T>(const T*, ossim_uint32, T);           \
+template void ossimImageDataKernels::minMax<T>(const T*, ossim_uint32, T,                          \
+                                               ossim_float64&, ossim_float64&);                    \
+template void ossimImageDataKernels::deinterleave<T>(const T*, T* const*, ossim_uint32,            \
+                                                     ossim_uint32);                                \
+template void ossimImageDataKernels::interleave<T>(const T* const*, T*, ossim_uint32,              \
+                                                   ossim_uint32);
+
+OSSIM_INSTANTIATE_KERNELS(ossim_uint8)
+OSSIM_INSTANTIATE_KERNELS(ossim_sint8)
+OSSIM_INSTANTIATE_KERNELS(ossim_uint16)
+OSSIM_INSTANTIATE_KERNELS(ossim_sint16)
+OSSIM_INSTANTIATE_KERNELS(ossim_uint32)
+OSSIM_INSTANTIATE_KERNELS(ossim_sint32)
+OSSIM_INSTANTIATE_KERNELS(ossim_float32)
+OSSIM_INSTANTIATE_KERNELS(ossim_float64)
+
+#undef OSSIM_INSTANTIATE_KERNELS
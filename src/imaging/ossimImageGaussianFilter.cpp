@@ -10,6 +10,8 @@
 #include <ossim/base/ossimNumericProperty.h>
 #include <ossim/base/ossimBooleanProperty.h>
 #include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimDiscreteConvolutionKernel.h>
 #include <cmath>
 
 using namespace std;
@@ -25,7 +27,9 @@ static const char* PROPERTYNAME_STRICTNODATA = "StrictNoData";
 ossimImageGaussianFilter::ossimImageGaussianFilter()
    : ossimImageSourceFilter(),
      theGaussStd(0.5),
-     theStrictNoData(true)
+     theStrictNoData(true),
+     theKernel(0),
+     theTile(0)
 {
    // ingredients: 
    // 2x  ConvolutionFilter1D
@@ -55,6 +59,7 @@ ossimImageGaussianFilter::~ossimImageGaussianFilter()
       theVF->disconnect();
       theVF = 0;
    }
+   delete theKernel;
 }
 
 void ossimImageGaussianFilter::setProperty(ossimRefPtr<ossimProperty> property)
@@ -155,6 +160,7 @@ ossimImageGaussianFilter::initialize()
 {
    ossimImageSourceFilter::initialize();
    initializeProcesses();
+   theTile = 0;
 }
 
 ossimRefPtr<ossimImageData>
@@ -162,6 +168,53 @@ ossimImageGaussianFilter::getTile(const ossimIrect &tileRect,ossim_uint32 resLev
 {
     if(isSourceEnabled())
     {
+       if(theInputConnection && theKernel)
+       {
+          // One pass when nothing in reach of the kernel is null:
+          ossim_int32 halfw = (ossim_int32)(theKernel->getWidth()/2);
+          ossimIrect inputRect(tileRect.ul() - ossimIpt(halfw, halfw),
+                               tileRect.lr() + ossimIpt(halfw, halfw));
+          ossimRefPtr<ossimImageData> data = theInputConnection->getTile(inputRect, resLevel);
+          if(data.valid() && (data->getDataObjectStatus() == OSSIM_FULL))
+          {
+             if(!theTile.valid())
+             {
+                theTile = ossimImageDataFactory::instance()->create(this, this);
+                theTile->initialize();
+             }
+             theTile->setImageRectangle(tileRect);
+
+             ossim_uint32 bands = theTile->getNumberOfBands();
+             vector<ossim_float64> minPix(bands);
+             vector<ossim_float64> maxPix(bands);
+             for(ossim_uint32 band = 0; band < bands; ++band)
+             {
+                minPix[band] = getMinPixelValue(band);
+                maxPix[band] = getMaxPixelValue(band);
+             }
+             if(theKernel->convolveFull(data.get(), theTile.get(), &minPix.front(), &maxPix.front()))
+             {
+                theTile->validate();
+                return theTile;
+             }
+          }
+          else if(data.valid() && data->getBuf())
+          {
+             // Nulls in reach: the null aware 1-D passes, on the tile already fetched. The
+             // horizontal pass covers the lines the vertical one needs, which is all of data:
+             ossimIrect rowsRect(tileRect.ul().x, inputRect.ul().y,
+                                 tileRect.lr().x, inputRect.lr().y);
+             ossimRefPtr<ossimImageData> rows = theHF->convolveTile(data, rowsRect);
+             if(rows.valid())
+             {
+                ossimRefPtr<ossimImageData> result = theVF->convolveTile(rows, tileRect);
+                if(result.valid())
+                {
+                   return result;
+                }
+             }
+          }
+       }
        return theVF->getTile(tileRect, resLevel);
     }
     if(theInputConnection)
@@ -239,6 +292,24 @@ ossimImageGaussianFilter::updateKernels()
       newk[i] *= invsum;
    }
 
+   //same kernel in 2-D for the separable engine
+   NEWMAT::Matrix kernel(supsize, supsize);
+   for(ossim_uint32 r=0; r<supsize ;++r)
+   {
+      for(ossim_uint32 c=0; c<supsize ;++c)
+      {
+         kernel[r][c] = newk[r]*newk[c];
+      }
+   }
+   if(!theKernel)
+   {
+      theKernel = new ossimDiscreteConvolutionKernel(kernel, false);
+   }
+   else
+   {
+      theKernel->setKernel(kernel);
+   }
+
    //send to 1d conv filters
    theHF->setKernel(newk);
    theVF->setKernel(newk);
@@ -23,6 +23,7 @@
 #include <ossim/base/ossimStringProperty.h>
 #include <ossim/base/ossimNumericProperty.h>
 #include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimDecimator.h>
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimImageDataFactory.h>
 #include <ossim/imaging/ossimImageHandler.h>
@@ -2400,61 +2401,8 @@ ossimRefPtr<ossimImageData>  ossimImageRenderer::getTileAtResLevel(const ossimIr
                data->getBuf()&&
                boundingRect.intersects(request))
             {
-               switch(data->getScalarType())
-               {
-                  case OSSIM_UINT8:
-                  {
-                     resampleTileToDecimation((ossim_uint8)0,
-                                              m_TemporaryBuffer,
-                                              data,
-                                              multiplier);
-                     break;
-                  }
-                  case OSSIM_SINT16:
-                  {
-                     resampleTileToDecimation((ossim_sint16)0,
-                                              m_TemporaryBuffer,
-                                              data,
-                                              multiplier);
-                     break;
-                  }
-                  case OSSIM_UINT16:
-                  case OSSIM_USHORT11:
-                  case OSSIM_USHORT12:
-                  case OSSIM_USHORT13:
-                  case OSSIM_USHORT14:
-                  case OSSIM_USHORT15:
-                  {
-                     resampleTileToDecimation((ossim_uint16)0,
-                                              m_TemporaryBuffer,
-                                              data,
-                                              multiplier);
-                     break;
-                  }
-                  case OSSIM_FLOAT32:
-                  case OSSIM_NORMALIZED_FLOAT:
-                  {
-                     resampleTileToDecimation((ossim_float32)0,
-                                              m_TemporaryBuffer,
-                                              data,
-                                              multiplier);
-                     break;
-                  }
-                  case OSSIM_FLOAT64:
-                  case OSSIM_NORMALIZED_DOUBLE:
-                  {
-                     resampleTileToDecimation((ossim_float64)0,
-                                              m_TemporaryBuffer,
-                                              data,
-                                              multiplier);
-                     break;
-                  }
-                  case OSSIM_SCALAR_UNKNOWN:
-                  default:
-                  {
-                     break;
-                  }
-               }
+               ossimDecimator::decimate(data.get(), m_TemporaryBuffer.get(),
+                                        ossimDecimator::BOX, multiplier);
             }
             ++currentCount;
          }
@@ -2476,148 +2424,6 @@ ossim_uint32 ossimImageRenderer::getMaxLevelsToCompute()const
    return m_MaxLevelsToCompute;
 }
 
-template <class T>
-void ossimImageRenderer::resampleTileToDecimation(T /* dummyVariable */,
-                    ossimRefPtr<ossimImageData> result,
-                    ossimRefPtr<ossimImageData> tile,
-                    ossim_uint32 multiplier)
-{
-   if(tile->getDataObjectStatus() == OSSIM_EMPTY ||
-      !tile->getBuf())
-   {
-      return;
-   }
-   
-   ossim_int32 maxX     = (ossim_int32)tile->getWidth();
-   ossim_int32 maxY     = (ossim_int32)tile->getHeight();
-   ossim_int32 resultHeight = result->getHeight();
-   ossim_int32* offsetX = new ossim_int32[maxX];
-   ossim_int32* offsetY = new ossim_int32[maxY];
-   ossim_int32 i        = 0;
-   ossim_int32 resultWidth     = (ossim_int32)result->getWidth();
-   ossimIpt tileOrigin   = tile->getOrigin();
-   ossimIpt resultOrigin = result->getOrigin();
-   
-   // create a lookup table. that maps the tile to the result
-   for(i = 0; i < maxX; ++i)
-   {
-      offsetX[i] = (i+tileOrigin.x)/(ossim_int32)multiplier - resultOrigin.x;
-      if(offsetX[i] < 0 )
-      {
-         offsetX[i] = 0;
-      }
-      else if(offsetX[i] >= resultWidth)
-      {
-         offsetX[i] = resultWidth-1;
-      }
-   }
-   for(i = 0; i < maxY; ++i)
-   {
-      offsetY[i] = ( ((i+tileOrigin.y)/(ossim_int32)multiplier) - resultOrigin.y);
-      if(offsetY[i] < 0 )
-      {
-         offsetY[i] = 0;
-      }
-      else if(offsetY[i] >= resultHeight)
-      {
-         offsetY[i] = resultHeight-1;
-      }
-      offsetY[i] *= resultWidth;
-   }
-   
-   if(tile->getDataObjectStatus() == OSSIM_FULL)
-   {
-      ossim_int32 numberOfBands = (ossim_int32)std::min(result->getNumberOfBands(),
-                                                        tile->getNumberOfBands());
-      ossim_int32 band = 0;
-      for(band = 0; band < numberOfBands; ++band)
-      {
-         T* tileBuf   = static_cast<T*>(tile->getBuf(band));
-         T* resultBuf = static_cast<T*>(result->getBuf(band));
-         ossim_int32 dx = 0;
-         ossim_int32 dy = 0;
-         ossim_int32 boxAverageX = 0;
-         ossim_int32 boxAverageY = 0;
-         for(dy = 0; dy < maxY; dy+=multiplier)
-         {
-            for(dx = 0; dx < maxX; dx+=multiplier)
-            {
-               double sum = 0.0;
-               for(boxAverageY = 0; 
-                   ((boxAverageY < (ossim_int32)multiplier)&& 
-                    ((boxAverageY+dy)<maxY)); ++boxAverageY)
-               {
-                  for(boxAverageX = 0; 
-                      ((boxAverageX < (ossim_int32)multiplier)&& 
-                       ((boxAverageX+dx)<maxX)); ++boxAverageX)
-                  {
-                     sum += tileBuf[((boxAverageY+dy)*maxX + boxAverageX + dx)];
-                  }
-               }
-               sum /= (double)(multiplier*multiplier);
-               resultBuf[ offsetX[dx] + offsetY[dy] ] = (T)sum;
-            }
-         }
-      }
-   }
-   else
-   {
-      ossim_int32 numberOfBands = (ossim_int32)std::min(result->getNumberOfBands(),
-                                                        tile->getNumberOfBands());
-      ossim_int32 band = 0;
-      for(band = 0; band < numberOfBands; ++band)
-      {
-         T* tileBuf   = static_cast<T*>(tile->getBuf(band));
-         T* resultBuf = static_cast<T*>(result->getBuf(band));
-         T tileBufNp  = static_cast<T>(tile->getNullPix(band));
-         ossim_int32 dx = 0;
-         ossim_int32 dy = 0;
-         ossim_int32 boxAverageX = 0;
-         ossim_int32 boxAverageY = 0;
-         for(dy = 0; dy < maxY; dy+=multiplier)
-         {
-            for(dx = 0; dx < maxX; dx+=multiplier)
-            {
-               double sum = 0.0;
-               if(tileBuf[((dy+(multiplier>>1))*maxX + dx+(multiplier>>1))] != tileBufNp)
-               {
-                  ossim_uint32 nullCount = 0;
-                  for(boxAverageY = 0; 
-                      ((boxAverageY < (ossim_int32)multiplier)&& 
-                       ((boxAverageY+dy)<maxY)); ++boxAverageY)
-                  {
-                     for(boxAverageX = 0; 
-                         ((boxAverageX < (ossim_int32)multiplier)&& 
-                          ((boxAverageX+dx)<maxX)); ++boxAverageX)
-                     {
-                        T value = tileBuf[((boxAverageY+dy)*maxX + boxAverageX + dx)];
-                        if(value != tileBufNp)
-                        {
-                           sum += value;
-                        }
-                        else
-                        {
-                           ++nullCount;
-                        }
-                     }
-                  }
-                  ossim_uint32 area = multiplier*multiplier;
-                  sum /= (double)(area);
-                  if(nullCount!= area)
-                  {
-                     resultBuf[ offsetX[dx] + offsetY[dy] ] = (T)sum;
-                  }
-               }
-            }
-         }
-      }
-      
-   }
-   
-  delete [] offsetX;
-  delete [] offsetY;
-}
-
 ossimString ossimImageRenderer::getLongName() const
 {
    return ossimString("Image Renderer");
@@ -27,7 +27,8 @@ ossimImageSourceFilter::ossimImageSourceFilter(ossimObject* owner)
                       0, // number of outputs
                       true, // input's fixed
                       false), // outputs ar not fixed
-     theInputConnection(NULL)
+     theInputConnection(NULL),
+     theRemapStamp(0)
 {
    addListener((ossimConnectableObjectListener*)this);
 }
@@ -38,7 +39,8 @@ ossimImageSourceFilter::ossimImageSourceFilter(ossimImageSource* inputSource)
                       0,
                       true,
                       false),
-     theInputConnection(inputSource)
+     theInputConnection(inputSource),
+     theRemapStamp(0)
 {
    if(inputSource)
    {
@@ -54,7 +56,8 @@ ossimImageSourceFilter::ossimImageSourceFilter(ossimObject* owner,
                       0,
                       true,
                       false),
-     theInputConnection(inputSource)
+     theInputConnection(inputSource),
+     theRemapStamp(0)
 {
    if(inputSource)
    {
@@ -84,12 +87,14 @@ ossim_uint32 ossimImageSourceFilter::getNumberOfInputBands()const
 void ossimImageSourceFilter::initialize()
 {
    theInputConnection = PTR_CAST(ossimImageSource, getInput(0));
+   remapChanged();
 }
 
 bool ossimImageSourceFilter::loadState(const ossimKeywordlist& kwl,
                                        const char* prefix)
 {
    bool result = ossimImageSource::loadState(kwl, prefix);
+   remapChanged();
 
    // make sure we have 1 input.
    //setNumberOfInputs(1);
@@ -198,9 +203,16 @@ void ossimImageSourceFilter::getOutputBandList(std::vector<ossim_uint32>& bandLi
    return ossimImageSource::getOutputBandList(bandList);
 }
 
+void ossimImageSourceFilter::setEnableFlag(bool flag)
+{
+   ossimImageSource::setEnableFlag(flag);
+   remapChanged();
+}
+
 void ossimImageSourceFilter::setProperty(ossimRefPtr<ossimProperty> property)
 {
    ossimImageSource::setProperty(property);
+   remapChanged();
 }
 
 ossimRefPtr<ossimProperty> ossimImageSourceFilter::getProperty(const ossimString& name)const
@@ -213,3 +225,24 @@ void ossimImageSourceFilter::getPropertyNames(std::vector<ossimString>& property
 {
    ossimImageSource::getPropertyNames(propertyNames);
 }
+
+bool ossimImageSourceFilter::isPointwiseRemap()const
+{
+   return false;
+}
+
+ossimRefPtr<ossimImageData> ossimImageSourceFilter::remapTile(
+   const ossimRefPtr<ossimImageData>& inputTile)
+{
+   return inputTile;
+}
+
+ossim_uint32 ossimImageSourceFilter::getRemapStamp()const
+{
+   return theRemapStamp;
+}
+
+void ossimImageSourceFilter::remapChanged()
+{
+   ++theRemapStamp;
+}
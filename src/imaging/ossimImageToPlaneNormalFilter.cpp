@@ -19,6 +19,7 @@
 #include <ossim/base/ossimBooleanProperty.h>
 
 static const char* SMOOTHNESS_FACTOR_KW="smoothness_factor";
+static const char* STENCIL_KW="stencil";
 
 RTTI_DEF1(ossimImageToPlaneNormalFilter, "ossimImageToPlaneNormalFilter", ossimImageSourceFilter);
 
@@ -29,7 +30,8 @@ ossimImageToPlaneNormalFilter::ossimImageToPlaneNormalFilter()
     theTrackScaleFlag(true),
     theXScale(1.0),
     theYScale(1.0),
-    theSmoothnessFactor(1.0)
+    theSmoothnessFactor(1.0),
+    theStencil(ossimTerrainKernels::ZEVENBERGEN_THORNE)
 {
 }
 
@@ -40,7 +42,8 @@ ossimImageToPlaneNormalFilter::ossimImageToPlaneNormalFilter(ossimImageSource* i
     theTrackScaleFlag(true),
     theXScale(1.0),
     theYScale(1.0),
-    theSmoothnessFactor(1.0)
+    theSmoothnessFactor(1.0),
+    theStencil(ossimTerrainKernels::ZEVENBERGEN_THORNE)
 {
 }
 
@@ -65,15 +68,9 @@ ossimRefPtr<ossimImageData> ossimImageToPlaneNormalFilter::getTile(
 
    theTile->setImageRectangle(tileRect);
 
-   ossimIrect requestRect(tileRect.ul().x - 1,
-                          tileRect.ul().y - 1,
-                          tileRect.lr().x + 1,
-                          tileRect.lr().y + 1);
-
-   ossimRefPtr<ossimImageData> input =
-      theInputConnection->getTile(requestRect, resLevel);
+   ossimRefPtr<ossimImageData> input = getInputTile(tileRect, resLevel);
 
-   if(!input||(input->getDataObjectStatus()==OSSIM_EMPTY)||!input->getBuf())
+   if(!input)
    {
       if(tileRect.completely_within(theInputBounds))
       {
@@ -110,6 +107,117 @@ ossimRefPtr<ossimImageData> ossimImageToPlaneNormalFilter::getTile(
    return theTile;
 }
 
+bool ossimImageToPlaneNormalFilter::getTerrainTile(const ossimIrect& tileRect,
+                                                   ossim_uint32 resLevel,
+                                                   const ossimTerrainKernels::Outputs& outputs,
+                                                   ossim_float64 outputNull,
+                                                   const ossim_float64* light)
+{
+   if(!isSourceEnabled()||!theInputConnection)
+   {
+      return false;
+   }
+
+   if(!theTile.valid())
+   {
+      initialize();
+   }
+
+   ossimTerrainKernels::Params params;
+   getKernelParams(resLevel, params);
+   params.m_outputNull = outputNull;
+   if(light)
+   {
+      params.m_light[0] = light[0];
+      params.m_light[1] = light[1];
+      params.m_light[2] = light[2];
+   }
+
+   ossimRefPtr<ossimImageData> input = getInputTile(tileRect, resLevel);
+   if(!input)
+   {
+      // Same as getTile(), flat inside the input and nothing outside:
+      if(tileRect.completely_within(theInputBounds))
+      {
+         ossimTerrainKernels::fillFlat(tileRect.area(), params, outputs);
+         return true;
+      }
+      return false;
+   }
+
+   params.m_inputNull = input->getNullPix(0);
+   const ossim_uint32 W = tileRect.width();
+   const ossim_uint32 H = tileRect.height();
+   const void* BUF = input->getBuf();
+   switch(input->getScalarType())
+   {
+      case OSSIM_SSHORT16:
+         ossimTerrainKernels::compute((const ossim_sint16*)BUF, W, H, params, outputs);
+         break;
+      case OSSIM_UCHAR:
+         ossimTerrainKernels::compute((const ossim_uint8*)BUF, W, H, params, outputs);
+         break;
+      case OSSIM_USHORT11:
+      case OSSIM_USHORT12:
+      case OSSIM_USHORT13:
+      case OSSIM_USHORT14:
+      case OSSIM_USHORT15:
+      case OSSIM_USHORT16:
+         ossimTerrainKernels::compute((const ossim_uint16*)BUF, W, H, params, outputs);
+         break;
+      case OSSIM_NORMALIZED_DOUBLE:
+      case OSSIM_DOUBLE:
+         ossimTerrainKernels::compute((const ossim_float64*)BUF, W, H, params, outputs);
+         break;
+      case OSSIM_NORMALIZED_FLOAT:
+      case OSSIM_FLOAT:
+         ossimTerrainKernels::compute((const ossim_float32*)BUF, W, H, params, outputs);
+         break;
+      default:
+         return false;
+   }
+   return true;
+}
+
+ossimRefPtr<ossimImageData> ossimImageToPlaneNormalFilter::getInputTile(
+   const ossimIrect& tileRect, ossim_uint32 resLevel)
+{
+   ossimIrect requestRect(tileRect.ul().x - 1,
+                          tileRect.ul().y - 1,
+                          tileRect.lr().x + 1,
+                          tileRect.lr().y + 1);
+
+   ossimRefPtr<ossimImageData> input =
+      theInputConnection->getTile(requestRect, resLevel);
+
+   if(!input||(input->getDataObjectStatus()==OSSIM_EMPTY)||!input->getBuf())
+   {
+      input = 0;
+   }
+   return input;
+}
+
+void ossimImageToPlaneNormalFilter::getKernelParams(ossim_uint32 resLevel,
+                                                    ossimTerrainKernels::Params& params) const
+{
+   double xScale = theXScale;
+   double yScale = theYScale;
+   if(resLevel > 0)
+   {
+      ossimDpt scaleFactor;
+      theInputConnection->getDecimationFactor(resLevel, scaleFactor);
+
+      if(!scaleFactor.hasNans())
+      {
+         xScale *= scaleFactor.x;
+         yScale *= scaleFactor.y;
+      }
+   }
+   params.m_stencil = theStencil;
+   params.m_xScale  = xScale*theSmoothnessFactor;
+   params.m_yScale  = yScale*theSmoothnessFactor;
+}
+
 void ossimImageToPlaneNormalFilter::initializeTile()
 {
    double* x = static_cast<double*>(theTile->getBuf(0));
@@ -206,88 +314,23 @@ template <class T> void ossimImageToPlaneNormalFilter::computeNormalsTemplate(
    ossimRefPtr<ossimImageData>& inputTile,
    ossimRefPtr<ossimImageData>& outputTile)
 {
-   T inputNull = (T) inputTile->getNullPix(0);
-   T* inbuf = (T*) inputTile->getBuf();
-   T outputNull = (T) outputTile->getNullPix(0);
-   double* normX = (double*)outputTile->getBuf(0);
-   double* normY = (double*)outputTile->getBuf(1);
-   double* normZ = (double*)outputTile->getBuf(2);
-   ossim_int32 inbuf_width = inputTile->getWidth();
-   ossim_int32 normbuf_width = outputTile->getWidth();
-   ossim_int32 normbuf_height = outputTile->getHeight();
-   ossimColumnVector3d normal;
-   bool valid_component = true;
-   for (ossim_int32 y=0; y<normbuf_height; y++)
-   {
-      // Establish offsets into the image and output normals buffers given row:
-      ossim_uint32 n = y*normbuf_width;
-      ossim_uint32 i = (y+1)*inbuf_width + 1;
-      
-      // Loop to compute the gradient (normal) vector [dh/dx, dh/dy, 1]:
-      for (ossim_int32 x=0; x<normbuf_width; x++)
-      {
-         // Default in case of null inputs is a flat earth:
-         normal[0] = 0;
-         normal[1] = 0;
-         normal[2] = 1.0;
-
-         // Compute the x-direction differential:
-         if (inbuf[i+1] != inputNull)
-         {
-            if (inbuf[i-1] != inputNull)
-               normal[0] = theXScale*theSmoothnessFactor*(inbuf[i+1] - inbuf[i-1]) / 2.0;
-            else if (inbuf[i] != inputNull)
-               normal[0] = theXScale*theSmoothnessFactor*(inbuf[i+1] - inbuf[i]);
-         }
-         else if ((inbuf[i] != inputNull) && (inbuf[i-1] != inputNull))
-         {
-            normal[0] = theXScale*theSmoothnessFactor*(inbuf[i] - inbuf[i-1]);
-         }
-         else
-         {
-            valid_component = false;
-         }
-
-         // Compute the y-direction differential:
-         if (valid_component)
-         {
-            if (inbuf[i+inbuf_width] != inputNull)
-            {
-               if (inbuf[i-inbuf_width] != inputNull)
-                  normal[1] = theYScale*theSmoothnessFactor*(inbuf[i+inbuf_width] - inbuf[i-inbuf_width]) / 2.0;
-               else if (inbuf[i] != inputNull)
-                  normal[1] = theYScale*theSmoothnessFactor*(inbuf[i+inbuf_width] - inbuf[i]);
-            }
-            else if ((inbuf[i] != inputNull) && (inbuf[i-inbuf_width] != inputNull))
-            {
-               normal[1] = theYScale*theSmoothnessFactor*(inbuf[i] - inbuf[i-inbuf_width]);
-            }
-            else
-            {
-               valid_component = false;
-            }
-         }
-
-         // Stuff the normalized gradient vector into the output buffers:
-         if (valid_component)
-         {
-            normal = normal.unit();
-            normX[n] = normal[0];
-            normY[n] = normal[1];
-            normZ[n] = normal[2];
-         }
-         else
-         {
-            normX[n] = outputNull;
-            normY[n] = outputNull;
-            normZ[n] = outputNull;
-         }
-         
-         ++n;
-         ++i;
-         valid_component = true;
-      }
-   }
+   ossimTerrainKernels::Params params;
+   params.m_stencil    = theStencil;
+   params.m_xScale     = theXScale*theSmoothnessFactor;
+   params.m_yScale     = theYScale*theSmoothnessFactor;
+   params.m_inputNull  = inputTile->getNullPix(0);
+   params.m_outputNull = outputTile->getNullPix(0);
+
+   ossimTerrainKernels::Outputs outputs;
+   outputs.m_normalX = (double*)outputTile->getBuf(0);
+   outputs.m_normalY = (double*)outputTile->getBuf(1);
+   outputs.m_normalZ = (double*)outputTile->getBuf(2);
+
+   ossimTerrainKernels::compute((const T*)inputTile->getBuf(),
+                                outputTile->getWidth(),
+                                outputTile->getHeight(),
+                                params,
+                                outputs);
 }
 
 bool ossimImageToPlaneNormalFilter::loadState(const ossimKeywordlist& kwl,
@@ -297,6 +340,7 @@ bool ossimImageToPlaneNormalFilter::loadState(const ossimKeywordlist& kwl,
    ossimString scaleY     = kwl.find(prefix, ossimKeywordNames::SCALE_PER_PIXEL_Y_KW);
    ossimString trackFlag  = kwl.find(prefix, "track_scale_flag");
    ossimString smoothness = kwl.find(prefix, SMOOTHNESS_FACTOR_KW);
+   ossimString stencil    = kwl.find(prefix, STENCIL_KW);
 
    if(scaleX != "")
    {
@@ -314,6 +358,11 @@ bool ossimImageToPlaneNormalFilter::loadState(const ossimKeywordlist& kwl,
    {
       theSmoothnessFactor = smoothness.toDouble();
    }
+   if(stencil!="")
+   {
+      theStencil = (stencil.downcase() == "horn") ? ossimTerrainKernels::HORN :
+                                                    ossimTerrainKernels::ZEVENBERGEN_THORNE;
+   }
 
    return ossimImageSourceFilter::loadState(kwl, prefix);
 }
@@ -341,6 +390,11 @@ bool ossimImageToPlaneNormalFilter::saveState(ossimKeywordlist& kwl,
            theSmoothnessFactor,
            true);
 
+   kwl.add(prefix,
+           STENCIL_KW,
+           (theStencil == ossimTerrainKernels::HORN) ? "horn" : "zt",
+           true);
+
    return ossimImageSourceFilter::saveState(kwl, prefix);
 }
 
@@ -421,6 +475,16 @@ double ossimImageToPlaneNormalFilter::getSmoothnessFactor()const
    return theSmoothnessFactor;
 }
 
+void ossimImageToPlaneNormalFilter::setStencil(ossimTerrainKernels::Stencil stencil)
+{
+   theStencil = stencil;
+}
+
+ossimTerrainKernels::Stencil ossimImageToPlaneNormalFilter::getStencil()const
+{
+   return theStencil;
+}
+
 void ossimImageToPlaneNormalFilter::setProperty(ossimRefPtr<ossimProperty> property)
 {
    ossimString name = property->getName();
@@ -17,9 +17,94 @@
 #include <ossim/imaging/ossimRectangleCutFilter.h>
 #include <ossim/imaging/ossimImageHistogramSource.h>
 #include <ossim/imaging/ossimHistogramWriter.h>
+#include <algorithm>
+#include <cmath>
 
 using namespace std;
 
+namespace
+{
+   // Copies the pixels at offsets first, first + step, ... below end of the tile, band
+   // interleaved, straight from the band buffers. Pixels with a null band are skipped, at most
+   // maxCount are copied. @return Pixels copied.
+   template <class T>
+   ossim_uint32 gatherPixels(const ossimImageData* tile, T /* dummy */, ossim_uint32 numBands,
+                             ossim_uint32 first, ossim_uint32 step, ossim_uint32 end,
+                             ossim_uint32 maxCount, double* pixels, ossim_uint32* offsets)
+   {
+      std::vector<const T*> bufs (numBands);
+      std::vector<double> nulls (numBands);
+      for (ossim_uint32 band=0; band<numBands; ++band)
+      {
+         bufs[band] = static_cast<const T*>(tile->getBuf(band));
+         nulls[band] = tile->getNullPix(band);
+      }
+
+      ossim_uint32 count = 0;
+      for (ossim_uint32 i=first; (i<end) && (count<maxCount); i+=step)
+      {
+         double* pixel = pixels + (size_t)count*numBands;
+         bool valid = true;
+         for (ossim_uint32 band=0; (band<numBands) && valid; ++band)
+         {
+            pixel[band] = bufs[band][i];
+            valid = (pixel[band] != nulls[band]);
+         }
+         if (valid)
+         {
+            if (offsets)
+               offsets[count] = i;
+            ++count;
+         }
+      }
+      return count;
+   }
+
+   ossim_uint32 gatherPixels(const ossimImageData* tile, ossim_uint32 numBands,
+                             ossim_uint32 first, ossim_uint32 step, ossim_uint32 end,
+                             ossim_uint32 maxCount, double* pixels, ossim_uint32* offsets)
+   {
+      switch (tile->getScalarType())
+      {
+         case OSSIM_UINT8:
+            return gatherPixels(tile, (ossim_uint8)0, numBands, first, step, end, maxCount,
+                                pixels, offsets);
+         case OSSIM_SINT8:
+            return gatherPixels(tile, (ossim_sint8)0, numBands, first, step, end, maxCount,
+                                pixels, offsets);
+         case OSSIM_UINT9:
+         case OSSIM_UINT10:
+         case OSSIM_UINT11:
+         case OSSIM_UINT12:
+         case OSSIM_UINT13:
+         case OSSIM_UINT14:
+         case OSSIM_UINT15:
+         case OSSIM_UINT16:
+            return gatherPixels(tile, (ossim_uint16)0, numBands, first, step, end, maxCount,
+                                pixels, offsets);
+         case OSSIM_SINT16:
+            return gatherPixels(tile, (ossim_sint16)0, numBands, first, step, end, maxCount,
+                                pixels, offsets);
+         case OSSIM_UINT32:
+            return gatherPixels(tile, (ossim_uint32)0, numBands, first, step, end, maxCount,
+                                pixels, offsets);
+         case OSSIM_SINT32:
+            return gatherPixels(tile, (ossim_sint32)0, numBands, first, step, end, maxCount,
+                                pixels, offsets);
+         case OSSIM_FLOAT32:
+         case OSSIM_NORMALIZED_FLOAT:
+            return gatherPixels(tile, (ossim_float32)0, numBands, first, step, end, maxCount,
+                                pixels, offsets);
+         case OSSIM_FLOAT64:
+         case OSSIM_NORMALIZED_DOUBLE:
+            return gatherPixels(tile, (ossim_float64)0, numBands, first, step, end, maxCount,
+                                pixels, offsets);
+         default:
+            return 0;
+      }
+   }
+}
+
 RTTI_DEF1(ossimKMeansFilter, "ossimKMeansFilter", ossimImageSourceFilter);
 
 ossimKMeansFilter::ossimKMeansFilter()
@@ -28,7 +113,10 @@ ossimKMeansFilter::ossimKMeansFilter()
     m_tile(0),
     m_outputScalarType(OSSIM_SCALAR_UNKNOWN),
     m_initialized(false),
-    m_thresholdMode(NONE)
+    m_thresholdMode(NONE),
+    m_multispectral(false),
+    m_maxTrainingSamples(100000),
+    m_trainingBatchSize(0)
 {
    setDescription("K-Means pixel classification filter.");
 }
@@ -41,7 +129,10 @@ ossimKMeansFilter::ossimKMeansFilter(ossimImageSource* input_source,
     m_tile(0),
     m_outputScalarType(OSSIM_SCALAR_UNKNOWN),
     m_initialized(false),
-    m_thresholdMode(NONE)
+    m_thresholdMode(NONE),
+    m_multispectral(false),
+    m_maxTrainingSamples(100000),
+    m_trainingBatchSize(0)
 {
    setDescription("K-Means pixel classification filter.");
 }
@@ -90,6 +181,13 @@ ossimRefPtr<ossimImageData> ossimKMeansFilter::getTile(const ossimIrect& tileRec
    if (inTile->getDataObjectStatus() == OSSIM_EMPTY)
       return m_tile;
 
+   if (m_multispectral)
+   {
+      classifyMultispectral(inTile.get());
+      m_tile->validate();
+      return m_tile;
+   }
+
    // Since a histogram is being used, the bin value reflects a range:
    ossimKMeansClustering* bandClusters = 0;
    const ossimKMeansClustering::Cluster* cluster = 0;
@@ -105,6 +203,7 @@ ossimRefPtr<ossimImageData> ossimKMeansFilter::getTile(const ossimIrect& tileRec
       double delta = m_histogram->getHistogram(band)->GetBucketSize() / 2.0;
       bandClusters = m_classifiers[band].get();
       outBuf = (ossim_uint8*)(m_tile->getBuf(band));
+      offset = 0;
       for (ipt.y=tileRect.ul().y; ipt.y<=tileRect.lr().y; ++ipt.y)
       {
          for (ipt.x=tileRect.ul().x; ipt.x<=tileRect.lr().x; ++ipt.x)
@@ -154,12 +253,12 @@ void ossimKMeansFilter::allocate()
          return;
    }
 
-   m_tile = ossimImageDataFactory::instance()->create(this, getNumberOfInputBands(), this);
+   m_tile = ossimImageDataFactory::instance()->create(this, getNumberOfOutputBands(), this);
    if(!m_tile.valid())
       return;
 
    ossim_uint32 numBands = getNumberOfInputBands();
-   if (m_numClusters && (m_classifiers.size() == numBands))
+   if (m_numClusters && !m_multispectral && (m_classifiers.size() == numBands))
    {
       for (ossim_uint32 band=0; band<numBands; band++)
       {
@@ -190,6 +289,13 @@ void ossimKMeansFilter::initialize()
    if ( !theInputConnection )
       return;
 
+   // Multispectral clusters are trained on sampled pixels, no histogram needed:
+   if (m_multispectral)
+   {
+      m_initialized = true;
+      return;
+   }
+
    // If an input histogram was provided, use it. Otherwise compute one:
    if (!m_histogram.valid())
    {
@@ -234,6 +340,9 @@ bool ossimKMeansFilter::computeKMeans()
    if (!m_initialized)
       initialize();
 
+   if (m_multispectral)
+      return computeMultispectral();
+
    ossim_uint32 numBands = getNumberOfInputBands();
    for (ossim_uint32 band=0; band<numBands; band++)
    {
@@ -255,34 +364,168 @@ bool ossimKMeansFilter::computeKMeans()
          break;
       }
       m_classifiers.push_back(classifier);
+      addThreshold(classifier.get());
+   }
+
+   return (m_classifiers.size() == numBands);
+}
+
+void ossimKMeansFilter::addThreshold(const ossimKMeansClustering* classifier)
+{
+   if ((m_thresholdMode == NONE) || (classifier->getNumClusters() != 2))
+      return;
+
+   double mean0 = classifier->getMean(0);
+   double mean1 = classifier->getMean(1);
+   double sigma0 = classifier->getSigma(0);
+   double sigma1 = classifier->getSigma(1);
+   double threshold = 0;
+   switch (m_thresholdMode)
+   {
+   case MEAN:
+      threshold = (mean0 + mean1)/2.0;
+      break;
+   case SIGMA_WEIGHTED:
+      threshold = (sigma1*mean0 + sigma0*mean1)/(sigma0 + sigma1);
+      break;
+   case VARIANCE_WEIGHTED:
+      threshold = (sigma1*sigma1*mean0 + sigma0*sigma0*mean1)/(sigma0*sigma0 + sigma1*sigma1);
+      break;
+   default:
+      break;
+   }
+   m_thresholds.push_back(threshold);
+   cout<<"ossimKMeansFilter:"<<__LINE__<<" Using threshold = "<<threshold<<endl;
+}
+
+bool ossimKMeansFilter::computeMultispectral()
+{
+   std::vector<double> samples;
+   ossim_uint32 count = collectTrainingSamples(samples);
+   if (count < m_numClusters)
+   {
+      cout<<"ossimKMeansFilter:"<<__LINE__<<" Only "<<count<<" valid training pixels found."<<endl;
+      return false;
+   }
 
-      if ((m_thresholdMode != NONE) && (classifier->getNumClusters() == 2))
+   ossimRefPtr<ossimKMeansClustering> classifier = new ossimKMeansClustering;
+   classifier->setVerbose();
+   classifier->setNumClusters(m_numClusters);
+   classifier->setSamples(&samples.front(), count, getNumberOfInputBands());
+   classifier->setBatchSize(m_trainingBatchSize);
+   if (m_trainingBatchSize)
+      classifier->setMaxIterations(100);
+   if (!classifier->computeKmeans())
+   {
+      cout<<"ossimKMeansFilter:"<<__LINE__<<" No K-means clustering data available."<<endl;
+      return false;
+   }
+
+   // Tiles are classified serially, callers run tiles in parallel:
+   classifier->setNumThreads(1);
+   m_classifiers.push_back(classifier);
+   return true;
+}
+
+ossim_uint32 ossimKMeansFilter::collectTrainingSamples(std::vector<double>& samples) const
+{
+   samples.clear();
+   if (!theInputConnection || (m_maxTrainingSamples == 0))
+      return 0;
+
+   // Coarsest resolution level that still has at least the number of samples wanted:
+   ossim_uint32 resLevel = 0;
+   ossimIrect bounds = theInputConnection->getBoundingRect(0);
+   ossim_uint32 numLevels = theInputConnection->getNumberOfDecimationLevels();
+   for (ossim_uint32 level=1; level<numLevels; ++level)
+   {
+      ossimIrect levelRect = theInputConnection->getBoundingRect(level);
+      if (levelRect.hasNans() ||
+          ((ossim_float64)levelRect.width()*levelRect.height() < m_maxTrainingSamples))
       {
-         double mean0 = classifier->getMean(0);
-         double mean1 = classifier->getMean(1);
-         double sigma0 = classifier->getSigma(0);
-         double sigma1 = classifier->getSigma(1);
-         double threshold = 0;
-         switch (m_thresholdMode)
-         {
-         case MEAN:
-            threshold = (mean0 + mean1)/2.0;
-            break;
-         case SIGMA_WEIGHTED:
-            threshold = (sigma1*mean0 + sigma0*mean1)/(sigma0 + sigma1);
-            break;
-         case VARIANCE_WEIGHTED:
-            threshold = (sigma1*sigma1*mean0 + sigma0*sigma0*mean1)/(sigma0*sigma0 + sigma1*sigma1);
-            break;
-         default:
-            break;
-         }
-         m_thresholds.push_back(threshold);
-         cout<<"ossimKMeansFilter:"<<__LINE__<<" Using threshold = "<<threshold<<endl;
+         break;
       }
+      resLevel = level;
+      bounds = levelRect;
    }
+   if (bounds.hasNans())
+      return 0;
 
-   return (m_classifiers.size() == numBands);
+   // Regular grid of samples over the level:
+   ossim_float64 area = (ossim_float64)bounds.width()*bounds.height();
+   ossim_int32 stride = (ossim_int32) std::sqrt(area / m_maxTrainingSamples);
+   if (stride < 1)
+      stride = 1;
+
+   ossim_uint32 numBands = getNumberOfInputBands();
+   ossim_uint32 count = 0;
+   const ossim_int32 STRIP_HEIGHT = 256;
+   for (ossim_int32 y0=bounds.ul().y; y0<=bounds.lr().y; y0+=STRIP_HEIGHT)
+   {
+      ossimIrect strip (bounds.ul().x, y0, bounds.lr().x,
+                        std::min(y0 + STRIP_HEIGHT - 1, bounds.lr().y));
+      ossimRefPtr<ossimImageData> tile = theInputConnection->getTile(strip, resLevel);
+      if (!tile.valid() || !tile->getBuf() || (tile->getDataObjectStatus() == OSSIM_EMPTY))
+         continue;
+
+      ossim_int32 firstY = y0 + (stride - (y0 - bounds.ul().y) % stride) % stride;
+      const ossim_uint32 rowSamples = (strip.width() + stride - 1) / stride;
+      for (ossim_int32 y=firstY; (y<=strip.lr().y) && (count<m_maxTrainingSamples); y+=stride)
+      {
+         ossim_uint32 offset = (y - strip.ul().y)*strip.width();
+         samples.resize((size_t)(count + rowSamples)*numBands);
+         count += gatherPixels(tile.get(), numBands, offset, stride, offset + strip.width(),
+                               m_maxTrainingSamples - count, &samples[(size_t)count*numBands], 0);
+      }
+   }
+   samples.resize((size_t)count*numBands);
+   return count;
+}
+
+void ossimKMeansFilter::classifyMultispectral(const ossimImageData* inTile)
+{
+   const ossimKMeansClustering* classifier = m_classifiers[0].get();
+   ossim_uint32 numBands = classifier->getNumDimensions();
+   ossim_uint32 size = inTile->getSizePerBand();
+   m_pixels.resize((size_t)size*numBands);
+   m_groupIds.resize(size);
+   m_offsets.resize(size);
+
+   // Gather the valid pixels band interleaved, classify them all at once, then scatter:
+   ossim_uint32 count = gatherPixels(inTile, numBands, 0, 1, size, size, &m_pixels.front(),
+                                     &m_offsets.front());
+   classifier->classify(&m_pixels.front(), count, &m_groupIds.front());
+
+   ossim_uint8* outBuf = (ossim_uint8*)(m_tile->getBuf(0)); // TODO: Only K < 256 is currently supported
+   for (ossim_uint32 j=0; j<count; ++j)
+      outBuf[m_offsets[j]] = (ossim_uint8) m_pixelValues[m_groupIds[j]];
+}
+
+void ossimKMeansFilter::setMultispectral(bool flag)
+{
+   m_multispectral = flag;
+   m_classifiers.clear();
+   m_initialized = false;
+   m_tile = 0;
+}
+
+void ossimKMeansFilter::setMaxTrainingSamples(ossim_uint32 n)
+{
+   m_maxTrainingSamples = n;
+   m_classifiers.clear();
+}
+
+void ossimKMeansFilter::setTrainingBatchSize(ossim_uint32 n)
+{
+   m_trainingBatchSize = n;
+   m_classifiers.clear();
+}
+
+ossim_uint32 ossimKMeansFilter::getNumberOfOutputBands() const
+{
+   if (m_multispectral && isSourceEnabled())
+      return 1;
+   return ossimImageSourceFilter::getNumberOfOutputBands();
 }
 
 void ossimKMeansFilter::clear()
@@ -345,13 +588,37 @@ bool ossimKMeansFilter::saveState(ossimKeywordlist& kwl, const char* prefix)cons
    ossim_uint32 numBands = getNumberOfInputBands();
    kwl.add(prefix, "num_bands", numBands);
    kwl.add(prefix, "num_clusters", m_numClusters);
+   kwl.add(prefix, "multispectral", (m_multispectral ? "true" : "false"));
+   kwl.add(prefix, "max_training_samples", m_maxTrainingSamples);
+   kwl.add(prefix, "training_batch_size", m_trainingBatchSize);
 
    ossimString key;
    ossimString keybase1;
    ossimString keybase2;
    const ossimKMeansClustering* bandClusters = 0;
    const ossimKMeansClustering::Cluster* cluster = 0;
-   for (ossim_uint32 band=0; band<numBands; band++)
+   if (m_multispectral && !m_classifiers.empty())
+   {
+      bandClusters = m_classifiers[0].get();
+      for (ossim_uint32 gid=0; gid < m_numClusters; ++gid)
+      {
+         ossimString centroid;
+         const double* c = bandClusters->getCentroid(gid);
+         for (ossim_uint32 band=0; c && (band<bandClusters->getNumDimensions()); ++band)
+         {
+            if (band)
+               centroid += " ";
+            centroid += ossimString::toString(c[band]);
+         }
+         keybase2 = "cluster";
+         keybase2 += ossimString::toString(gid);
+         key = keybase2 + ".centroid";
+         kwl.add(prefix, key.chars(), centroid);
+         key = keybase2 + ".sigma";
+         kwl.add(prefix, key.chars(), bandClusters->getSigma(gid));
+      }
+   }
+   for (ossim_uint32 band=0; !m_multispectral && (band<m_classifiers.size()); band++)
    {
       if (numBands > 1)
       {
@@ -387,13 +654,116 @@ bool ossimKMeansFilter::loadState(const ossimKeywordlist& orig_kwl, const char*
    bool return_state = true;
    //ossimKeywordlist kwl (orig_kwl); // need non-const copy
 
-   // TODO: Need to implement
+   const char* lookup = orig_kwl.find(prefix, "multispectral");
+   if (lookup)
+      setMultispectral(ossimString(lookup).toBool());
+   lookup = orig_kwl.find(prefix, "max_training_samples");
+   if (lookup)
+      setMaxTrainingSamples(ossimString(lookup).toUInt32());
+   lookup = orig_kwl.find(prefix, "training_batch_size");
+   if (lookup)
+      setTrainingBatchSize(ossimString(lookup).toUInt32());
 
    return_state &= ossimImageSourceFilter::loadState(orig_kwl, prefix);
 
+   // Clusters saved by saveState() are restored, so the filter does not train again. Without
+   // all of them it trains on the first tile as usual:
+   lookup = orig_kwl.find(prefix, "num_clusters");
+   ossim_uint32 K = lookup ? ossimString(lookup).toUInt32() : 0;
+   lookup = orig_kwl.find(prefix, "num_bands");
+   ossim_uint32 numBands = lookup ? ossimString(lookup).toUInt32() : 0;
+   if (K && numBands)
+   {
+      setNumClusters(K);
+      if (!loadClusters(orig_kwl, prefix, numBands))
+      {
+         m_classifiers.clear();
+         m_thresholds.clear();
+      }
+   }
+
    return return_state;
 }
 
+bool ossimKMeansFilter::loadClusters(const ossimKeywordlist& kwl,
+                                     const char* prefix,
+                                     ossim_uint32 numBands)
+{
+   ossimString key;
+   ossimString keybase1;
+   ossimString keybase2;
+   const char* lookup = 0;
+   std::vector<ossimKMeansClustering::Cluster> clusters (m_numClusters);
+   std::vector<double> centroids;
+   if (m_multispectral)
+   {
+      for (ossim_uint32 gid=0; gid < m_numClusters; ++gid)
+      {
+         keybase2 = "cluster";
+         keybase2 += ossimString::toString(gid);
+         key = keybase2 + ".centroid";
+         lookup = kwl.find(prefix, key.chars());
+         if (!lookup)
+            return false;
+         std::vector<ossimString> values = ossimString(lookup).split(" ", true);
+         if (values.size() != numBands)
+            return false;
+         for (ossim_uint32 band=0; band<numBands; ++band)
+            centroids.push_back(values[band].toDouble());
+         key = keybase2 + ".sigma";
+         lookup = kwl.find(prefix, key.chars());
+         clusters[gid].sigma = lookup ? ossimString(lookup).toDouble() : 0.0;
+         clusters[gid].mean = centroids[(size_t)gid*numBands];
+         clusters[gid].new_mean = clusters[gid].mean;
+      }
+
+      ossimRefPtr<ossimKMeansClustering> classifier = new ossimKMeansClustering;
+      classifier->setNumThreads(1);
+      classifier->setClusters(clusters, &centroids.front(), numBands);
+      m_classifiers.push_back(classifier);
+      return true;
+   }
+
+   const char* STATS[] = { ".mean", ".sigma", ".min", ".max" };
+   for (ossim_uint32 band=0; band<numBands; band++)
+   {
+      if (numBands > 1)
+      {
+         keybase1 = "band";
+         keybase1 += ossimString::toString(band) + ".";
+      }
+
+      centroids.clear();
+      for (ossim_uint32 gid=0; gid < m_numClusters; ++gid)
+      {
+         keybase2 = keybase1;
+         keybase2 += "cluster";
+         keybase2 += ossimString::toString(gid);
+         double values[4];
+         for (int i=0; i<4; ++i)
+         {
+            key = keybase2 + STATS[i];
+            lookup = kwl.find(prefix, key.chars());
+            if (!lookup)
+               return false;
+            values[i] = ossimString(lookup).toDouble();
+         }
+         clusters[gid].mean = values[0];
+         clusters[gid].new_mean = values[0];
+         clusters[gid].sigma = values[1];
+         clusters[gid].min = values[2];
+         clusters[gid].max = values[3];
+         centroids.push_back(values[0]);
+      }
+
+      ossimRefPtr<ossimKMeansClustering> classifier = new ossimKMeansClustering;
+      classifier->setClusters(clusters, &centroids.front(), 1);
+      m_classifiers.push_back(classifier);
+      addThreshold(classifier.get());
+   }
+   return true;
+}
+
 ossimScalarType ossimKMeansFilter::getOutputScalarType() const
 {
    ossimScalarType myType = OSSIM_SCALAR_UNKNOWN;
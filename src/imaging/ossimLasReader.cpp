@@ -68,7 +68,10 @@ ossimLasReader::ossimLasReader()
      m_mutex(),
      m_scan(false), // ???
      m_units(OSSIM_METERS),
-     m_unitConverter(0)   
+     m_unitConverter(0),
+     m_gridder(0),
+     m_gridderResLevel(-1),
+     m_elevationStatistic(ossimLasGridder::MEAN)
 {
    //---
    // Nan out as can be set in several places, i.e. setProperty,
@@ -165,6 +168,9 @@ void ossimLasReader::close()
       m_proj  = 0;
       ossimImageHandler::close();
    }
+   delete m_gridder;
+   m_gridder = 0;
+   m_gridderResLevel = -1;
 }
 
 ossimRefPtr<ossimImageData> ossimLasReader::getTile(
@@ -198,6 +204,12 @@ bool ossimLasReader::getTile(ossimImageData* result, ossim_uint32 resLevel)
 
    bool status = false;
 
+   if ( ( m_entry == 0 ) && m_hdr && result && ( result->getScalarType() == OSSIM_FLOAT32 ) &&
+        ( result->getDataObjectStatus() != OSSIM_NULL ) &&
+        !m_ul.hasNans() && !m_gsd.hasNans() )
+   {
+      return getElevationTile( result, resLevel );
+   }
 
    if ( m_hdr && result && (result->getScalarType() == OSSIM_FLOAT32||result->getScalarType() == OSSIM_UINT16) &&
         (result->getDataObjectStatus() != OSSIM_NULL) &&
@@ -348,6 +360,54 @@ bool ossimLasReader::getTile(ossimImageData* result, ossim_uint32 resLevel)
    
 } // End: bool ossimLibLasReader::getTile(ossimImageData* result, ossim_uint32 resLevel)
 
+bool ossimLasReader::getElevationTile(ossimImageData* result, ossim_uint32 resLevel)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+
+   if ( !m_gridder )
+   {
+      m_gridder = new ossimLasGridder();
+      if ( !m_gridder->open( theImageFile ) )
+      {
+         delete m_gridder;
+         m_gridder = 0;
+         return false;
+      }
+      m_gridderResLevel = -1;
+   }
+
+   if ( m_gridderResLevel != static_cast<ossim_int32>(resLevel) )
+   {
+      // m_ul is the center of the upper left pixel, same convention as getTile:
+      ossimDpt scale;
+      getScale(scale, resLevel);
+      const ossimDpt UL_CORNER( m_ul.x - scale.x / 2.0, m_ul.y + scale.y / 2.0 );
+
+      ossim_float64 unitScale = 1.0;
+      if ( m_unitConverter )
+      {
+         convertToMeters( unitScale );
+      }
+
+      m_gridder->setGrid( UL_CORNER, scale,
+                          getNumberOfSamples( resLevel ), getNumberOfLines( resLevel ),
+                          unitScale );
+      m_gridderResLevel = static_cast<ossim_int32>(resLevel);
+   }
+
+   bool status = m_gridder->getValues( result->getImageRectangle(),
+                                       m_elevationStatistic,
+                                       result->getFloatBuf(),
+                                       static_cast<ossim_float32>( getNullPixelValue(0) ) );
+   result->validate();
+   return status;
+}
+
+void ossimLasReader::setElevationStatistic(ossimLasGridder::Statistic stat)
+{
+   m_elevationStatistic = stat;
+}
+
 ossim_uint32 ossimLasReader::getNumberOfInputBands() const
 {
    return 1; // tmp
@@ -1275,6 +1335,7 @@ void ossimLasReader::setGsd( const ossim_float64& gsd )
 {
    m_gsd.x = gsd;
    m_gsd.y = m_gsd.x;
+   m_gridderResLevel = -1;
 
    if ( m_proj.valid() && ( m_gsd.hasNans() == false ) )
    {
@@ -40,7 +40,20 @@ ossimRefPtr<ossimImageData> ossimLinearStretchRemapper::getTile(const ossimIrect
    if(!theInputConnection)
       return 0;
 
-   ossimRefPtr<ossimImageData> tile = theInputConnection->getTile(tileRect, resLevel);
+   if (m_remapChain.fuse(this))
+      return m_remapChain.getTile(tileRect, resLevel);
+
+   return remapTile(theInputConnection->getTile(tileRect, resLevel));
+}
+
+bool ossimLinearStretchRemapper::isPointwiseRemap() const
+{
+   return true;
+}
+
+ossimRefPtr<ossimImageData> ossimLinearStretchRemapper::remapTile(
+   const ossimRefPtr<ossimImageData>& tile)
+{
    if ( !theEnableFlag )
       return tile;
 
@@ -53,7 +66,7 @@ ossimRefPtr<ossimImageData> ossimLinearStretchRemapper::getTile(const ossimIrect
          return 0;
    }
 
-   m_tile->setImageRectangle(tileRect);
+   m_tile->setImageRectangle(tile->getImageRectangle());
    m_tile->makeBlank();
 
    // Quick handling special case of empty input tile:
@@ -141,6 +154,7 @@ void ossimLinearStretchRemapper::initialize()
    ossimImageSourceFilter::initialize();
 
    m_tile = 0;
+   m_remapChain.reset();
    if ( theInputConnection )
    {
       // Initialize the chain on the left hand side of us.
@@ -204,6 +218,7 @@ bool ossimLinearStretchRemapper::loadState(const ossimKeywordlist& kwl, const ch
          m_maxValues[i] = maximums[i].toDouble();
       }
    }
+   remapChanged();
    return true;
 }
 
@@ -226,6 +241,7 @@ void ossimLinearStretchRemapper::setMinPixelValue(double value, ossim_uint32 ban
    if (m_minValues.size() <= band)
       m_minValues.resize(band+1);
    m_minValues[band] = value;
+   remapChanged();
 }
 
 void ossimLinearStretchRemapper::setMaxPixelValue(double value, ossim_uint32 band)
@@ -233,6 +249,7 @@ void ossimLinearStretchRemapper::setMaxPixelValue(double value, ossim_uint32 ban
    if (m_maxValues.size() <= band)
       m_maxValues.resize(band+1);
    m_maxValues[band] = value;
+   remapChanged();
 }
 
 
@@ -0,0 +1,376 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/imaging/ossimMaskMorphology.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/base/ossimPolygon.h>
+#include <algorithm>
+
+struct MaskMin { static inline ossim_uint8 op(ossim_uint8 a, ossim_uint8 b) { return a < b ? a : b; } };
+struct MaskMax { static inline ossim_uint8 op(ossim_uint8 a, ossim_uint8 b) { return a > b ? a : b; } };
+
+// van Herk/Gil-Werman along x: the line is cut into blocks of w samples, g holds the running
+// extremum from the start of each block, h the one to its end, and the window starting at x is
+// op(h[x], g[x + w - 1]): three operations per sample whatever w is.
+template <class Op>
+static void runningExtremumX(const ossim_uint8* in, long width, long height, long w,
+                             ossim_uint8* out)
+{
+   const long outWidth = width - w + 1;
+   std::vector<ossim_uint8> g (width);
+   std::vector<ossim_uint8> h (width);
+   for (long y = 0; y < height; ++y)
+   {
+      const ossim_uint8* f = in + y * width;
+      for (long x = 0; x < width; ++x)
+         g[x] = (x % w) ? Op::op(g[x - 1], f[x]) : f[x];
+      for (long x = width - 1; x >= 0; --x)
+         h[x] = (((x + 1) % w) && (x < width - 1)) ? Op::op(h[x + 1], f[x]) : f[x];
+
+      ossim_uint8* o = out + y * outWidth;
+      for (long x = 0; x < outWidth; ++x)
+         o[x] = Op::op(h[x], g[x + w - 1]);
+   }
+}
+
+// Same along y, a line at a time so the inner loops run over contiguous x and vectorize.
+template <class Op>
+static void runningExtremumY(const ossim_uint8* in, long width, long height, long w,
+                             ossim_uint8* out)
+{
+   const long outHeight = height - w + 1;
+   std::vector<ossim_uint8> g (width * height);
+   std::vector<ossim_uint8> h (width * height);
+   for (long y = 0; y < height; ++y)
+   {
+      const ossim_uint8* f = in + y * width;
+      ossim_uint8* gy = &g[y * width];
+      if (y % w)
+      {
+         const ossim_uint8* gp = gy - width;
+         for (long x = 0; x < width; ++x)
+            gy[x] = Op::op(gp[x], f[x]);
+      }
+      else
+         std::copy(f, f + width, gy);
+   }
+   for (long y = height - 1; y >= 0; --y)
+   {
+      const ossim_uint8* f = in + y * width;
+      ossim_uint8* hy = &h[y * width];
+      if (((y + 1) % w) && (y < height - 1))
+      {
+         const ossim_uint8* hn = hy + width;
+         for (long x = 0; x < width; ++x)
+            hy[x] = Op::op(hn[x], f[x]);
+      }
+      else
+         std::copy(f, f + width, hy);
+   }
+   for (long y = 0; y < outHeight; ++y)
+   {
+      const ossim_uint8* hy = &h[y * width];
+      const ossim_uint8* gy = &g[(y + w - 1) * width];
+      ossim_uint8* o = out + y * width;
+      for (long x = 0; x < width; ++x)
+         o[x] = Op::op(hy[x], gy[x]);
+   }
+}
+
+template <class Op>
+static void runningExtremum(const std::vector<ossim_uint8>& mask, long width, long height, long w,
+                            std::vector<ossim_uint8>& out)
+{
+   const long outWidth = width - w + 1;
+   const long outHeight = height - w + 1;
+   if ((outWidth <= 0) || (outHeight <= 0))
+   {
+      out.clear();
+      return;
+   }
+   std::vector<ossim_uint8> rows (outWidth * height);
+   runningExtremumX<Op>(&mask.front(), width, height, w, &rows.front());
+   out.resize(outWidth * outHeight);
+   runningExtremumY<Op>(&rows.front(), outWidth, height, w, &out.front());
+}
+
+ossimMaskMorphology::ossimMaskMorphology()
+   : m_windowSize(3),
+     m_operation(EROSION),
+     m_numFilled(0),
+     m_numUnfilled(0)
+{
+}
+
+void ossimMaskMorphology::setWindowSize(ossim_uint32 windowSize)
+{
+   m_windowSize = (windowSize < 1) ? 1 : (windowSize | 1);
+}
+
+ossim_uint32 ossimMaskMorphology::getMargin() const
+{
+   const ossim_uint32 half = m_windowSize / 2;
+   return ((m_operation == OPENING) || (m_operation == CLOSING)) ? 2 * half : half;
+}
+
+void ossimMaskMorphology::erode(const std::vector<ossim_uint8>& mask, long width, long height,
+                                long w, std::vector<ossim_uint8>& out)
+{
+   runningExtremum<MaskMin>(mask, width, height, w, out);
+}
+
+void ossimMaskMorphology::dilate(const std::vector<ossim_uint8>& mask, long width, long height,
+                                 long w, std::vector<ossim_uint8>& out)
+{
+   runningExtremum<MaskMax>(mask, width, height, w, out);
+}
+
+void ossimMaskMorphology::boxSum(const std::vector<double>& values, long width, long height,
+                                 long w, std::vector<double>& out)
+{
+   const long outWidth = width - w + 1;
+   const long outHeight = height - w + 1;
+   if ((outWidth <= 0) || (outHeight <= 0))
+   {
+      out.clear();
+      return;
+   }
+
+   // Running sums along x, then along y a line at a time:
+   std::vector<double> rows (outWidth * height);
+   for (long y = 0; y < height; ++y)
+   {
+      const double* f = &values[y * width];
+      double* r = &rows[y * outWidth];
+      double sum = 0.0;
+      for (long x = 0; x < w; ++x)
+         sum += f[x];
+      r[0] = sum;
+      for (long x = 1; x < outWidth; ++x)
+      {
+         sum += f[x + w - 1] - f[x - 1];
+         r[x] = sum;
+      }
+   }
+
+   out.assign(outWidth * outHeight, 0.0);
+   double* o = &out.front();
+   for (long y = 0; y < w; ++y)
+   {
+      const double* r = &rows[y * outWidth];
+      for (long x = 0; x < outWidth; ++x)
+         o[x] += r[x];
+   }
+   for (long y = 1; y < outHeight; ++y)
+   {
+      const double* prev = o + (y - 1) * outWidth;
+      const double* enter = &rows[(y + w - 1) * outWidth];
+      const double* leave = &rows[(y - 1) * outWidth];
+      double* cur = o + y * outWidth;
+      for (long x = 0; x < outWidth; ++x)
+         cur[x] = prev[x] + enter[x] - leave[x];
+   }
+}
+
+bool ossimMaskMorphology::apply(const ossimImageData* input,
+                                ossimImageData* output,
+                                const ossimPolygon* validPoly)
+{
+   m_numFilled = 0;
+   m_numUnfilled = 0;
+   if (!input || !output || !input->getBuf() || !output->getBuf() ||
+       (input->getScalarType() != output->getScalarType()))
+   {
+      return false;
+   }
+
+   switch (input->getScalarType())
+   {
+      case OSSIM_UINT8:
+         applyT<ossim_uint8>(input, output, validPoly);
+         break;
+      case OSSIM_UINT16:
+      case OSSIM_USHORT11:
+      case OSSIM_USHORT12:
+      case OSSIM_USHORT13:
+      case OSSIM_USHORT14:
+      case OSSIM_USHORT15:
+         applyT<ossim_uint16>(input, output, validPoly);
+         break;
+      case OSSIM_SINT16:
+         applyT<ossim_sint16>(input, output, validPoly);
+         break;
+      case OSSIM_UINT32:
+         applyT<ossim_uint32>(input, output, validPoly);
+         break;
+      case OSSIM_SINT32:
+         applyT<ossim_sint32>(input, output, validPoly);
+         break;
+      case OSSIM_FLOAT32:
+      case OSSIM_NORMALIZED_FLOAT:
+         applyT<ossim_float32>(input, output, validPoly);
+         break;
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_DOUBLE:
+         applyT<ossim_float64>(input, output, validPoly);
+         break;
+      default:
+         return false;
+   }
+   output->validate();
+   return true;
+}
+
+template <class T>
+void ossimMaskMorphology::applyT(const ossimImageData* input,
+                                 ossimImageData* output,
+                                 const ossimPolygon* validPoly)
+{
+   const long w = m_windowSize;
+   const long half = w / 2;
+   const long margin = getMargin();
+   const long ow = output->getWidth();
+   const long oh = output->getHeight();
+   const long iw = input->getWidth();
+   const long ih = input->getHeight();
+
+   // Padded working area, output rect grown by the margin, in input coordinates:
+   const long pw = ow + 2 * margin;
+   const long ph = oh + 2 * margin;
+   const long px = output->getOrigin().x - margin - input->getOrigin().x;
+   const long py = output->getOrigin().y - margin - input->getOrigin().y;
+
+   // Only test pixels against the polygon when the tile is not entirely inside it:
+   const ossimIpt ul = output->getOrigin();
+   const bool checkPoly = validPoly && !validPoly->isRectWithin(output->getImageRectangle());
+   std::vector<ossim_uint8> inside;
+   if (checkPoly)
+   {
+      inside.resize(ow * oh);
+      for (long y = 0; y < oh; ++y)
+         for (long x = 0; x < ow; ++x)
+            inside[y * ow + x] = validPoly->isPointWithin(ossimDpt(ul.x + x, ul.y + y));
+   }
+
+   const bool fill = (m_operation == DILATION) || (m_operation == CLOSING);
+   std::vector<ossim_uint8> mask (pw * ph);
+   std::vector<double> values;
+   std::vector<double> counts;
+   std::vector<ossim_uint8> pass;
+   std::vector<ossim_uint8> result;
+   std::vector<double> sums;
+   std::vector<double> windowCounts;
+
+   const ossim_uint32 numBands =
+      std::min(input->getNumberOfBands(), output->getNumberOfBands());
+   for (ossim_uint32 band = 0; band < numBands; ++band)
+   {
+      const T* in = (const T*) input->getBuf(band);
+      T* out = (T*) output->getBuf(band);
+      const T np = (T) input->getNullPix(band);
+      const T onp = (T) output->getNullPix(band);
+
+      if (fill)
+      {
+         values.assign(pw * ph, 0.0);
+         counts.assign(pw * ph, 0.0);
+      }
+      for (long y = 0; y < ph; ++y)
+      {
+         const long yi = py + y;
+         ossim_uint8* m = &mask[y * pw];
+         if ((yi < 0) || (yi >= ih))
+         {
+            std::fill(m, m + pw, 0);
+            continue;
+         }
+         const T* line = in + yi * iw;
+         for (long x = 0; x < pw; ++x)
+         {
+            const long xi = px + x;
+            m[x] = (xi >= 0) && (xi < iw) && (line[xi] != np);
+            if (fill && m[x])
+            {
+               values[y * pw + x] = (double) line[xi];
+               counts[y * pw + x] = 1.0;
+            }
+         }
+      }
+
+      // Mask after the operation, ow x oh:
+      const std::vector<ossim_uint8>* keep = &result;
+      switch (m_operation)
+      {
+         case EROSION:
+            erode(mask, pw, ph, w, result);
+            break;
+         case OPENING:
+            erode(mask, pw, ph, w, pass);
+            dilate(pass, pw - 2 * half, ph - 2 * half, w, result);
+            break;
+         case CLOSING:
+            dilate(mask, pw, ph, w, pass);
+            erode(pass, pw - 2 * half, ph - 2 * half, w, result);
+            break;
+         case DILATION:
+            keep = 0;
+            break;
+      }
+
+      // Window sums of the valid samples around every output pixel for the fills:
+      long sumWidth = ow;
+      long sumOffset = 0;
+      if (fill)
+      {
+         boxSum(values, pw, ph, w, sums);
+         boxSum(counts, pw, ph, w, windowCounts);
+         sumWidth = pw - 2 * half;
+         sumOffset = (margin - half) * (sumWidth + 1);
+      }
+
+      for (long y = 0; y < oh; ++y)
+      {
+         const ossim_uint8* m = &mask[(y + margin) * pw + margin];
+         const long srcOffset = (py + margin + y) * iw + px + margin;
+         T* dst = out + y * ow;
+         for (long x = 0; x < ow; ++x)
+         {
+            const long i = y * ow + x;
+            const T v = m[x] ? in[srcOffset + x] : onp;
+            const bool isInside = !checkPoly || inside[i];
+            if (!fill)
+            {
+               dst[x] = (m[x] && (*keep)[i] && isInside) ? v : onp;
+            }
+            else if (m[x])
+            {
+               dst[x] = v;
+            }
+            else if (!isInside)
+            {
+               dst[x] = onp;
+            }
+            else
+            {
+               const long s = sumOffset + y * sumWidth + x;
+               const double n = windowCounts[s];
+               if ((n > 0.5) && (!keep || (*keep)[i]))
+               {
+                  dst[x] = (T) (sums[s] / n);
+                  ++m_numFilled;
+               }
+               else
+               {
+                  dst[x] = onp;
+                  ++m_numUnfilled;
+               }
+            }
+         }
+      }
+   }
+}
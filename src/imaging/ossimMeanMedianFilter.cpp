@@ -29,6 +29,7 @@ RTTI_DEF1(ossimMeanMedianFilter,
 static const ossimString WINDOW_SIZE_KW = "window_size";
 static const ossimString FILTER_TYPE_KW = "filter_type";
 static const ossimString AUTO_GROW_KW   = "auto_grow_rectangle_flag";
+static const ossimString RANK_KW        = "rank";
 
 ossimMeanMedianFilter::ossimMeanMedianFilter(ossimObject* owner)
    :ossimImageSourceFilter(owner),
@@ -36,7 +37,8 @@ ossimMeanMedianFilter::ossimMeanMedianFilter(ossimObject* owner)
     theFilterType(OSSIM_MEDIAN),
     theWindowSize(3),
     theEnableFillNullFlag(false),
-    theAutoGrowRectFlag(false)
+    theAutoGrowRectFlag(false),
+    theRankEngine()
 {
    setDescription(ossimString("Mean Median Filter"));
 }
@@ -98,6 +100,16 @@ ossim_uint32 ossimMeanMedianFilter::getWindowSize()const
    return theWindowSize;
 }
 
+void ossimMeanMedianFilter::setRank(double rank)
+{
+   theRankEngine.setRank(rank);
+}
+
+double ossimMeanMedianFilter::getRank()const
+{
+   return theRankEngine.getRank();
+}
+
 void ossimMeanMedianFilter::initialize()
 {
    ossimImageSourceFilter::initialize();
@@ -107,21 +119,30 @@ void ossimMeanMedianFilter::initialize()
 
 void ossimMeanMedianFilter::applyFilter(ossimRefPtr<ossimImageData>& input)
 {
+   if ( (theFilterType == OSSIM_MEDIAN) ||
+        (theFilterType == OSSIM_MEDIAN_FILL_NULLS) ||
+        (theFilterType == OSSIM_MEDIAN_NULL_CENTER_ONLY) )
+   {
+      theRankEngine.setWindowSize(theWindowSize);
+      theRankEngine.setNullMode(
+         (theFilterType == OSSIM_MEDIAN) ? ossimSlidingWindowRank::SKIP_NULL_CENTER :
+         ((theFilterType == OSSIM_MEDIAN_FILL_NULLS) ? ossimSlidingWindowRank::FILL_NULLS :
+          ossimSlidingWindowRank::NULL_CENTER_ONLY) );
+      if ( !theRankEngine.apply(input.get(), theTile.get()) )
+      {
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimMeanMedianFilter::applyFilter WARNING:\n"
+            << "Unhandled scalar type!" << endl;
+      }
+      return;
+   }
+   
    switch(input->getScalarType())
    {
       case OSSIM_UINT8:
       {
          switch (theFilterType)
          {
-            case OSSIM_MEDIAN:
-            case OSSIM_MEDIAN_FILL_NULLS:
-               applyMedian(ossim_uint8(0), input);
-               break;
-               
-            case OSSIM_MEDIAN_NULL_CENTER_ONLY:
-               applyMedianNullCenterOnly(ossim_uint8(0), input);
-               break;
-               
             case OSSIM_MEAN:
             case OSSIM_MEAN_FILL_NULLS:
                applyMean(ossim_uint8(0), input);
@@ -144,15 +165,6 @@ void ossimMeanMedianFilter::applyFilter(ossimRefPtr<ossimImageData>& input)
       {
          switch (theFilterType)
          {
-            case OSSIM_MEDIAN:
-            case OSSIM_MEDIAN_FILL_NULLS:
-               applyMedian(ossim_uint16(0), input);
-               break;
-               
-            case OSSIM_MEDIAN_NULL_CENTER_ONLY:
-               applyMedianNullCenterOnly(ossim_uint16(0), input);
-               break;
-               
             case OSSIM_MEAN:
             case OSSIM_MEAN_FILL_NULLS:
                applyMean(ossim_uint16(0), input);
@@ -171,15 +183,6 @@ void ossimMeanMedianFilter::applyFilter(ossimRefPtr<ossimImageData>& input)
       {
          switch (theFilterType)
          {
-            case OSSIM_MEDIAN:
-            case OSSIM_MEDIAN_FILL_NULLS:
-               applyMedian(ossim_sint16(0), input);
-               break;
-               
-            case OSSIM_MEDIAN_NULL_CENTER_ONLY:
-               applyMedianNullCenterOnly(ossim_sint16(0), input);
-               break;
-               
             case OSSIM_MEAN:
             case OSSIM_MEAN_FILL_NULLS:
                applyMean(ossim_sint16(0), input);
@@ -198,15 +201,6 @@ void ossimMeanMedianFilter::applyFilter(ossimRefPtr<ossimImageData>& input)
       {
          switch (theFilterType)
          {
-            case OSSIM_MEDIAN:
-            case OSSIM_MEDIAN_FILL_NULLS:
-               applyMedian(ossim_uint32(0), input);
-               break;
-               
-            case OSSIM_MEDIAN_NULL_CENTER_ONLY:
-               applyMedianNullCenterOnly(ossim_uint32(0), input);
-               break;
-               
             case OSSIM_MEAN:
             case OSSIM_MEAN_FILL_NULLS:
                applyMean(ossim_uint32(0), input);
@@ -225,15 +219,6 @@ void ossimMeanMedianFilter::applyFilter(ossimRefPtr<ossimImageData>& input)
       {
          switch (theFilterType)
          {
-            case OSSIM_MEDIAN:
-            case OSSIM_MEDIAN_FILL_NULLS:
-               applyMedian(ossim_float32(0.0), input);
-               break;
-               
-            case OSSIM_MEDIAN_NULL_CENTER_ONLY:
-               applyMedianNullCenterOnly(ossim_float32(0.0), input);
-               break;
-               
             case OSSIM_MEAN:
             case OSSIM_MEAN_FILL_NULLS:
                applyMean(ossim_float32(0.0), input);
@@ -253,15 +238,6 @@ void ossimMeanMedianFilter::applyFilter(ossimRefPtr<ossimImageData>& input)
       {
          switch (theFilterType)
          {
-            case OSSIM_MEDIAN:
-            case OSSIM_MEDIAN_FILL_NULLS:
-               applyMedian(ossim_float64(0.0), input);
-               break;
-               
-            case OSSIM_MEDIAN_NULL_CENTER_ONLY:
-               applyMedianNullCenterOnly(ossim_float64(0.0), input);
-               break;
-               
             case OSSIM_MEAN:
             case OSSIM_MEAN_FILL_NULLS:
                applyMean(ossim_float64(0.0), input);
@@ -504,219 +480,6 @@ template <class T> void ossimMeanMedianFilter::applyMeanNullCenterOnly(
    }  // End of else "partial tile" block.
 }
 
-template <class T>
-void ossimMeanMedianFilter::applyMedian(T /* dummyVariable */,
-                                        ossimRefPtr<ossimImageData>& inputData)
-{
-   ossim_uint32 halfWindow = (theWindowSize >> 1);
-   ossim_uint32 bandIdx = 0;
-   ossim_uint32 x = 0;
-   ossim_uint32 y = 0;
-   ossim_uint32 kernelX   = 0;
-   ossim_uint32 kernelY   = 0;
-   ossim_uint32 kernelIdx = 0;
-   ossim_uint32 iw  = inputData->getWidth();
-   ossim_uint32 ow  = theTile->getWidth();
-   ossim_uint32 oh = theTile->getHeight();
-   ossim_uint32 numberOfBands = ossim::min(theTile->getNumberOfBands(),
-                                         inputData->getNumberOfBands());
-   ossimDataObjectStatus status = inputData->getDataObjectStatus();
-   std::vector<T> values(theWindowSize*theWindowSize);
-
-   if(status == OSSIM_FULL)
-   {
-      for(bandIdx = 0; bandIdx < numberOfBands; ++bandIdx)
-      {
-         T* inputBuf     = (T*)inputData->getBuf(bandIdx);
-         T* outputBuf    = (T*)theTile->getBuf(bandIdx);
-
-         if(inputBuf&&outputBuf)
-         {
-            for(y = 0; y < oh; ++y)
-            {
-               for(x = 0; x < ow; ++x)
-               {
-                  kernelIdx = 0;
-                  for(kernelY = 0; kernelY < theWindowSize; ++kernelY)
-                  {
-                     for(kernelX = 0; kernelX < theWindowSize;++kernelX)
-                     {
-                        values[kernelIdx] = *(inputBuf+kernelX + kernelY*iw);
-                        ++kernelIdx;
-                     }
-                  }
-
-                  std::sort(values.begin(),
-                            values.end());
-
-                  if(values.size() > 0)
-                  {
-                     (*outputBuf) = values[values.size()>>1];
-                  }
-                  ++inputBuf;
-                  ++outputBuf;
-               }
-
-               inputBuf+=(halfWindow<<1);
-            }
-         }
-      }
-   }
-   else
-   {
-      for(bandIdx = 0; bandIdx < numberOfBands; ++bandIdx)
-      {
-         T* inputBuf     = (T*)inputData->getBuf(bandIdx);
-         T* outputBuf    = (T*)theTile->getBuf(bandIdx);
-         T np            = (T)inputData->getNullPix(bandIdx);
-         if(inputBuf&&outputBuf)
-         {
-            for(y = 0; y < oh; ++y)
-            {
-               for(x = 0; x < ow; ++x)
-               {
-                  values.clear();
-                  for(kernelY = 0; kernelY < theWindowSize; ++kernelY)
-                  {
-                     for(kernelX = 0; kernelX < theWindowSize;++kernelX)
-                     {
-                        T tempValue = *(inputBuf+kernelX + kernelY*iw);
-
-                        if(tempValue != np)
-                        {
-                           values.push_back(tempValue);
-                        }
-                     }
-                  }
-
-                  std::sort(values.begin(),
-                            values.end());
-
-                  if(values.size() > 0)
-                  {
-                     if(*(inputBuf+halfWindow + halfWindow*iw) == np)
-                     {
-                        if(theEnableFillNullFlag)
-                        {
-                           (*outputBuf) = values[values.size()>>1];
-                        }
-                        else
-                        {
-                           (*outputBuf) = np;
-                        }
-                     }
-                     else
-                     {
-                        (*outputBuf) = values[values.size()>>1];
-                     }
-                  }
-                  else
-                  {
-                     *outputBuf = np;
-                  }
-                  ++inputBuf;
-                  ++outputBuf;
-               }
-
-               inputBuf+=(halfWindow<<1);
-            }
-         }
-      }
-   }
-}
-
-template <class T> void ossimMeanMedianFilter::applyMedianNullCenterOnly (
-   T /* dummyVariable */,
-   ossimRefPtr<ossimImageData>& inputData)
-{
-   ossim_uint32 halfWindow = (theWindowSize >> 1);
-   ossim_uint32 bandIdx = 0;
-   ossim_uint32 x = 0;
-   ossim_uint32 y = 0;
-   ossim_uint32 kernelX   = 0;
-   ossim_uint32 kernelY   = 0;
-   ossim_uint32 iw  = inputData->getWidth();
-   ossim_uint32 ow  = theTile->getWidth();
-   ossim_uint32 oh = theTile->getHeight();
-   ossim_uint32 numberOfBands = ossim::min(theTile->getNumberOfBands(),
-                                         inputData->getNumberOfBands());
-   ossimDataObjectStatus status = inputData->getDataObjectStatus();
-   std::vector<T> values;
-
-   if(status == OSSIM_FULL)
-   {
-      // Nothing to do just copy the tile.
-      theTile->loadTile(inputData.get());
-   }
-   else
-   {
-       // Partial tile with nulls in it.
-      for(bandIdx = 0; bandIdx < numberOfBands; ++bandIdx)
-      {
-         T* inputBuf     = (T*)inputData->getBuf(bandIdx);
-         T* outputBuf    = (T*)theTile->getBuf(bandIdx);
-         if (!inputBuf || !outputBuf)
-         {
-            return; // Shouldn't happen...
-         }
-         
-         const T NP = (T)inputData->getNullPix(bandIdx);
-
-         for(y = 0; y < oh; ++y)
-         {
-            for(x = 0; x < ow; ++x)
-            {
-               // Get the center input pixel.
-               const T CP = *(inputBuf+halfWindow + halfWindow*iw);
-               if (CP == NP)
-               {
-                  values.clear();
-                  for(kernelY = 0; kernelY < theWindowSize; ++kernelY)
-                  {
-                     for(kernelX = 0; kernelX < theWindowSize;++kernelX)
-                     {
-                        T tempValue = *(inputBuf+kernelX + kernelY*iw);
-                        
-                        if(tempValue != NP)
-                        {
-                           values.push_back(tempValue);
-                        }
-                     }
-                  }
-
-                  std::sort(values.begin(),
-                            values.end());
-                  
-                  if(values.size() > 0)
-                  {
-                     (*outputBuf) = values[values.size()>>1];
-                  }
-                  else
-                  {
-                     (*outputBuf) = NP;
-                  }
-               }
-               else // Center pixel (CP) not null.
-               {
-                  (*outputBuf) = CP;
-               }
-
-               // Move over...
-               ++inputBuf;
-               ++outputBuf;
-               
-            }  // End of loop in x direction.
-
-            // Move down...
-            inputBuf+=(halfWindow<<1);
-            
-         }  // End of loop in y direction.
-         
-      }  // End of band loop.
-      
-   }  // End of else "partial tile" block.
-}
-
 void ossimMeanMedianFilter::setProperty(ossimRefPtr<ossimProperty> property)
 {
    if(!property.valid())
@@ -741,6 +504,10 @@ void ossimMeanMedianFilter::setProperty(ossimRefPtr<ossimProperty> property)
       property->valueToString(value);
       setAutoGrowRectFlag(value.toBool());
    }
+   else if (name == RANK_KW)
+   {
+      setRank(property->valueToString().toDouble());
+   }
    else
    {
       ossimImageSourceFilter::setProperty(property);
@@ -780,6 +547,17 @@ ossimRefPtr<ossimProperty> ossimMeanMedianFilter::getProperty(const ossimString&
       p->setFullRefreshBit();
       return p;
    }
+   else if (name == RANK_KW)
+   {
+      ossimProperty* prop =
+         new ossimNumericProperty(RANK_KW,
+                                  ossimString::toString(getRank()),
+                                  0.0,
+                                  1.0);
+      prop->setCacheRefreshBit();
+
+      return prop;
+   }
    return ossimImageSourceFilter::getProperty(name);
 }
 
@@ -789,6 +567,7 @@ void ossimMeanMedianFilter::getPropertyNames(
    propertyNames.push_back(WINDOW_SIZE_KW);
    propertyNames.push_back(FILTER_TYPE_KW);
    propertyNames.push_back(AUTO_GROW_KW);
+   propertyNames.push_back(RANK_KW);
 
    ossimImageSourceFilter::getPropertyNames(propertyNames);
 }
@@ -808,6 +587,10 @@ bool ossimMeanMedianFilter::saveState(ossimKeywordlist& kwl,
            AUTO_GROW_KW.c_str(),
            (theAutoGrowRectFlag?"true":"false"),
            true);   
+   kwl.add(prefix,
+           RANK_KW.c_str(),
+           getRank(),
+           true);
 
    return ossimImageSourceFilter::saveState(kwl, prefix);
 }
@@ -837,6 +620,12 @@ bool ossimMeanMedianFilter::loadState(const ossimKeywordlist& kwl,
       setAutoGrowRectFlag(flag.toBool());
    }
 
+   lookup = kwl.find(prefix, RANK_KW.c_str());
+   if(lookup)
+   {
+      setRank(ossimString(lookup).toDouble());
+   }
+
    return ossimImageSourceFilter::loadState(kwl, prefix);
 }
 void ossimMeanMedianFilter::setFilterType(ossimMeanMedianFilterType type)
@@ -46,7 +46,7 @@ ossimOverviewSequencer::ossimOverviewSequencer()
    m_sourceResLevel(0),
    m_dirtyFlag(true),
    m_decimationFactor(2),
-   m_resampleType(ossimFilterResampler::ossimFilterResampler_BOX),
+   m_decimationMethod(ossimDecimator::BOX),
    m_histogram(0),
    m_histoMode(OSSIM_HISTO_MODE_UNKNOWN),
    m_histoTileIndex(1),
@@ -288,7 +288,7 @@ void ossimOverviewSequencer::initialize()
          << "\ntiles high:             " << m_numberOfTilesVertical
          << "\nsource rlevel:          " << m_sourceResLevel
          << "\ndecimation factor:      " << m_decimationFactor
-         << "\nresamp type:            " << m_resampleType
+         << "\ndecimation method:      " << ossimDecimator::getMethodName(m_decimationMethod)
          << "\nscan for min max:       " << (m_scanForMinMax?"true\n":"false\n")
          << "\nscan for min, max null: " << (m_scanForMinMaxNull?"true\n":"false\n")
          << "\nhisto mode:             " << m_histoMode << "\n";
@@ -412,7 +412,23 @@ void ossimOverviewSequencer::setTileSize(const ossimIpt& tileSize)
 void ossimOverviewSequencer::setResampleType(
    ossimFilterResampler::ossimFilterResamplerType resampleType)
 {
-   m_resampleType = resampleType;
+   switch (resampleType)
+   {
+      case ossimFilterResampler::ossimFilterResampler_NEAREST_NEIGHBOR:
+         m_decimationMethod = ossimDecimator::NEAREST;
+         break;
+      case ossimFilterResampler::ossimFilterResampler_LANCZOS:
+         m_decimationMethod = ossimDecimator::LANCZOS3;
+         break;
+      default:
+         m_decimationMethod = ossimDecimator::BOX;
+         break;
+   }
+}
+
+void ossimOverviewSequencer::setDecimationMethod(ossimDecimator::Method method)
+{
+   m_decimationMethod = method;
 }
 
 void ossimOverviewSequencer::setScanForMinMax(bool flag)
@@ -786,6 +802,14 @@ void ossimOverviewSequencer::getInputTileRectangle(ossimIrect& inputRect) const
    getOutputTileRectangle(inputRect);
    inputRect = inputRect * m_decimationFactor;
 
+   // Pixels around the tile the decimation filter reaches:
+   const ossim_int32 MARGIN = static_cast<ossim_int32>(ossimDecimator::getMargin(m_decimationMethod));
+   if (MARGIN)
+   {
+      inputRect = ossimIrect(inputRect.ul().x - MARGIN, inputRect.ul().y - MARGIN,
+                             inputRect.lr().x + MARGIN, inputRect.lr().y + MARGIN);
+   }
+
 #if 0
    if (traceDebug())
    {
@@ -857,203 +881,7 @@ void ossimOverviewSequencer::updateTileDimensions()
 
 void ossimOverviewSequencer::resampleTile(const ossimImageData* inputTile)
 {
-   switch(m_imageHandler->getOutputScalarType())
-   {
-      case OSSIM_UINT8:
-      {
-         resampleTile(inputTile, ossim_uint8(0));
-         break;
-      }
-
-      case OSSIM_USHORT11:
-      case OSSIM_USHORT12:
-      case OSSIM_USHORT13:
-      case OSSIM_USHORT14:
-      case OSSIM_USHORT15:
-      case OSSIM_UINT16:
-      {
-         resampleTile(inputTile, ossim_uint16(0));
-         break;
-      }
-      case OSSIM_SINT16:
-      {
-         resampleTile(inputTile, ossim_sint16(0));
-         break;
-      }
-
-      case OSSIM_UINT32:
-      {
-         resampleTile(inputTile, ossim_uint32(0));
-         break;
-      }
-         
-      case OSSIM_SINT32:
-      {
-         resampleTile(inputTile, ossim_sint32(0));
-         break;
-      }
-         
-      case OSSIM_FLOAT32:
-      {
-         resampleTile(inputTile, ossim_float32(0.0));
-         break;
-      }
-         
-      case OSSIM_NORMALIZED_DOUBLE:
-      case OSSIM_FLOAT64:
-      {
-         resampleTile(inputTile, ossim_float64(0.0));
-         break;
-      }
-      default:
-         ossimNotify(ossimNotifyLevel_WARN)
-            << "ossimOverviewSequencer::resampleTile Unknown pixel type!"
-            << std::endl;
-         return;
-         
-   } // End of "switch(m_imageHandler->getOutputScalarType())"
-}
-
-template <class T>
-void  ossimOverviewSequencer::resampleTile(const ossimImageData* inputTile, T  /* dummy */ )
-{
-#if 0
-   if (traceDebug())
-   {
-      ossimNotify(ossimNotifyLevel_DEBUG)
-         << "ossimOverviewSequencer::resampleTile DEBUG: "
-         << "\ncurrent tile: " << m_currentTileNumber
-         << "\ninput tile:\n" << *inputTile
-         << "output tile:\n" << *(m_tile.get())
-         << endl;
-   }
-#endif
-   
-   const ossim_uint32 BANDS = m_tile->getNumberOfBands();
-   const ossim_uint32 LINES = m_tile->getHeight();
-   const ossim_uint32 SAMPS = m_tile->getWidth();
-   const ossim_uint32 INPUT_WIDTH = m_decimationFactor*m_tileSize.x;
-   
-   T nullPixel              = 0;
-   ossim_float64 weight     = 0.0;
-   ossim_float64 value      = 0.0;
-   ossim_uint32 sampOffset  = 0;
-   
-   if (m_resampleType == ossimFilterResampler::ossimFilterResampler_NEAREST_NEIGHBOR)
-   {
-      for (ossim_uint32 band=0; band<BANDS; ++band)
-      {
-         const T* s = static_cast<const T*>(inputTile->getBuf(band)); // source
-         T*       d = static_cast<T*>(m_tile->getBuf(band)); // destination
-         
-         nullPixel = static_cast<T>(inputTile->getNullPix(band));
-         weight = 0.0;
-         value  = 0.0;
-         
-         for (ossim_uint32 i=0; i<LINES; ++i)
-         {
-            for (ossim_uint32 j=0; j<SAMPS; ++j)
-            {
-               sampOffset = j*m_decimationFactor;
-               
-               weight = 1.0;
-               value  = *(s + i*m_decimationFactor*INPUT_WIDTH + sampOffset);
-               
-               if(weight)
-               {
-                  d[j] = static_cast<T>( value/weight );
-               }
-               else
-               {
-                  d[j] = nullPixel;
-               }
-               
-            } // End of sample loop.
-            
-            d += m_tileSize.x;
-            
-         } // End of line loop.
-         
-      } // End of band loop.
-      
-   }
-   else // ossimFilterResampler::ossimFilterResampler_BOX
-   {
-      ossim_uint32 lineOffset1 = 0;
-      ossim_uint32 lineOffset2 = 0;
-      ossim_float64 ul = 0.0;
-      ossim_float64 ur = 0.0;
-      ossim_float64 ll = 0.0;
-      ossim_float64 lr = 0.0;
-
-      for (ossim_uint32 band=0; band<BANDS; ++band)
-      {
-         const T* s = static_cast<const T*>(inputTile->getBuf(band)); // source
-         T*       d = static_cast<T*>(m_tile->getBuf(band)); // destination
-
-         nullPixel = static_cast<T>(inputTile->getNullPix(band));
-         weight = 0.0;
-         value  = 0.0;
-         
-         for (ossim_uint32 i=0; i<LINES; ++i)
-         {
-            lineOffset1 = i*m_decimationFactor*INPUT_WIDTH;
-            lineOffset2 = (i*m_decimationFactor+1)*INPUT_WIDTH;
-            
-            for (ossim_uint32 j=0; j<SAMPS; ++j)
-            {
-               sampOffset = j*m_decimationFactor;
-               
-               weight = 0.0;
-               value  = 0.0;
-               
-               //---
-               // Grab four pixels from the source, average, and assign
-               // to output.
-               //---
-               ul = *(s + lineOffset1 + sampOffset);
-               ur = *(s + lineOffset1 + sampOffset + 1);
-               ll = *(s + lineOffset2 + sampOffset);
-               lr = *(s + lineOffset2 + sampOffset + 1);
-               
-               if(ul != nullPixel)
-               {
-                  ++weight;
-                  value += ul;
-               }
-               if(ur != nullPixel)
-               {
-                  ++weight;
-                  value += ur;
-               }
-               if(ll != nullPixel)
-               {
-                  ++weight;
-                  value += ll;
-               }
-               if(lr != nullPixel)
-               {
-                  ++weight;
-                  value += lr;
-               }
-
-               if(weight)
-               {
-                  d[j] = static_cast<T>( value/weight );
-               }
-               else
-               {
-                  d[j] = nullPixel;
-               }
-            
-            } // End of sample loop.
-            
-            d += m_tileSize.x;
-            
-         } // End of line loop.
-         
-      } // End of band loop.
-   }
+   ossimDecimator::decimate(inputTile, m_tile.get(), m_decimationMethod);
 }
 
 void ossimOverviewSequencer::setBitMaskObjects(ossimBitMaskWriter* mask_writer,
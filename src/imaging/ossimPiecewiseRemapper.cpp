@@ -345,37 +345,45 @@ void ossimPiecewiseRemapper::setRemapType( const std::string& type )
 }
 
 ossimRefPtr<ossimImageData> ossimPiecewiseRemapper::getTile(
-   const ossimIrect& tileRect,
-   ossim_uint32 resLevel)
+   const ossimIrect& tileRect, ossim_uint32 resLevel)
 {
    ossimRefPtr<ossimImageData> result = 0;
-   
+
    if ( theInputConnection )
    {
       if ( m_dirty )
       {
          // Rebuild the table if dirty flag set:
          buildTable();
+         theRemapChain.reset();
       }
 
-      if ( theEnableFlag && theTable.size() ) 
-      {
-         //---
-         // Not bypassed and has a table...
-         // Base handles the rest...
-         //---
-         result = ossimTableRemapper::getTile(tileRect, resLevel);
-      }
-      else
-      {
-         // Fetch tile from pointer from the input source.
-         result = theInputConnection->getTile(tileRect, resLevel);
-      }
+      // Base fuses pointwise runs, or calls remapTile:
+      result = ossimTableRemapper::getTile(tileRect, resLevel);
    }
 
    return result;
 }
 
+ossimRefPtr<ossimImageData> ossimPiecewiseRemapper::remapTile(
+   const ossimRefPtr<ossimImageData>& inputTile)
+{
+   if ( m_dirty )
+   {
+      // Rebuild the table if dirty flag set:
+      buildTable();
+   }
+   if ( theEnableFlag && theTable.size() ) 
+   {
+      //---
+      // Not bypassed and has a table...
+      // Base handles the rest...
+      //---
+      return ossimTableRemapper::remapTile(inputTile);
+   }
+   return inputTile;
+}
+
 void ossimPiecewiseRemapper::getRemapTypeString(
    ossimPiecewiseRemapper::PiecewiseRemapType remapType, std::string& s ) const
 {
@@ -0,0 +1,545 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/imaging/ossimRemapChain.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTrace.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageSourceFilter.h>
+#include <cstring>
+
+static ossimTrace traceDebug("ossimRemapChain:debug");
+
+// Knots over the min to max of float inputs, a 256 x 16 ramp plus a row of nulls:
+static const ossim_uint32 FLOAT_KNOTS = 4096;
+static const ossim_uint32 RAMP_WIDTH  = 256;
+
+ossimRemapChain::ossimRemapChain()
+   : m_state(UNBUILT),
+     m_head(0),
+     m_source(0),
+     m_stages(),
+     m_stamps(),
+     m_inputType(OSSIM_SCALAR_UNKNOWN),
+     m_outputType(OSSIM_SCALAR_UNKNOWN),
+     m_bands(0),
+     m_entries(0),
+     m_offset(0),
+     m_table(),
+     m_knots(),
+     m_knotMin(),
+     m_knotScale(),
+     m_inputNull(),
+     m_inputMin(),
+     m_inputMax(),
+     m_nullOutput(),
+     m_tile(0)
+{
+}
+
+void ossimRemapChain::reset()
+{
+   m_state  = UNBUILT;
+   m_source = 0;
+   m_stages.clear();
+   m_stamps.clear();
+   m_table.clear();
+   m_knots.clear();
+   m_knotMin.clear();
+   m_knotScale.clear();
+   m_inputNull.clear();
+   m_inputMin.clear();
+   m_inputMax.clear();
+   m_nullOutput.clear();
+   m_tile = 0;
+}
+
+bool ossimRemapChain::fuse(ossimImageSourceFilter* head)
+{
+   if ( (m_state == UNBUILT) || (head != m_head) )
+   {
+      m_head = head;
+      build();
+   }
+   else if ( (m_state == FUSED) && !isLinked() )
+   {
+      // Filters of the run were removed, replaced, changed or stopped being pointwise:
+      build();
+   }
+   return (m_state == FUSED);
+}
+
+ossim_uint32 ossimRemapChain::getNumberOfStages() const
+{
+   return (m_state == FUSED) ? (ossim_uint32)m_stages.size() : 0;
+}
+
+bool ossimRemapChain::isLinked() const
+{
+   // Only follows live connections, the stored pointers are compared, never dereferenced:
+   ossimConnectableObject* object = m_head;
+   for (ossim_int32 i = (ossim_int32)m_stages.size() - 1; i >= 0; --i)
+   {
+      ossimImageSourceFilter* filter = dynamic_cast<ossimImageSourceFilter*>(object);
+      if ( !filter || (filter != m_stages[i]) || !filter->isPointwiseRemap() ||
+           (filter->getRemapStamp() != m_stamps[i]) )
+      {
+         return false;
+      }
+      object = filter->getInput(0);
+   }
+   return (object == m_source);
+}
+
+bool ossimRemapChain::build()
+{
+   reset();
+   m_state = UNFUSED;
+
+   const char* lookup = ossimPreferences::instance()->findPreference("remap_chain.fuse");
+   if ( !m_head || (lookup && !ossimString(lookup).toBool()) )
+   {
+      return false;
+   }
+
+   // Walk up from the head while the filters are pointwise:
+   ossimImageSource* source = m_head;
+   ossimImageSourceFilter* filter = m_head;
+   while ( filter && filter->isPointwiseRemap() )
+   {
+      m_stages.insert(m_stages.begin(), filter);
+      source = dynamic_cast<ossimImageSource*>(filter->getInput(0));
+      filter = dynamic_cast<ossimImageSourceFilter*>(source);
+   }
+   if ( (m_stages.size() < 2) || !source )
+   {
+      m_stages.clear();
+      return false;
+   }
+   m_source    = source;
+   m_inputType = m_source->getOutputScalarType();
+   m_bands     = m_source->getNumberOfOutputBands();
+
+   switch (m_inputType)
+   {
+      case OSSIM_UINT8:
+      {
+         m_entries = 256;
+         m_offset  = 0;
+         break;
+      }
+      case OSSIM_UINT9:
+      case OSSIM_UINT10:
+      case OSSIM_UINT11:
+      case OSSIM_UINT12:
+      case OSSIM_UINT13:
+      case OSSIM_UINT14:
+      case OSSIM_UINT15:
+      case OSSIM_UINT16:
+      {
+         m_entries = 65536;
+         m_offset  = 0;
+         break;
+      }
+      case OSSIM_SINT16:
+      {
+         m_entries = 65536;
+         m_offset  = 32768;
+         break;
+      }
+      case OSSIM_FLOAT32:
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_FLOAT:
+      case OSSIM_NORMALIZED_DOUBLE:
+      {
+         m_entries = FLOAT_KNOTS;
+         m_offset  = 0;
+         break;
+      }
+      default:
+      {
+         m_entries = 0;
+         break;
+      }
+   }
+
+   ossimRefPtr<ossimImageData> ramp = m_entries && m_bands ? makeRamp() : 0;
+   ossimRefPtr<ossimImageData> output = ramp.valid() ? runStages(ramp) : 0;
+   if ( !output.valid() || (output->getDataObjectStatus() == OSSIM_NULL) ||
+        (output->getNumberOfBands() != m_bands) ||
+        (output->getSizePerBand() != ramp->getSizePerBand()) )
+   {
+      m_stages.clear();
+      return false;
+   }
+
+   m_outputType = output->getScalarType();
+   switch (m_outputType)
+   {
+      case OSSIM_UINT8:
+      case OSSIM_UINT9:
+      case OSSIM_UINT10:
+      case OSSIM_UINT11:
+      case OSSIM_UINT12:
+      case OSSIM_UINT13:
+      case OSSIM_UINT14:
+      case OSSIM_UINT15:
+      case OSSIM_UINT16:
+      case OSSIM_SINT16:
+      case OSSIM_FLOAT32:
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_FLOAT:
+      case OSSIM_NORMALIZED_DOUBLE:
+         break;
+      default:
+      {
+         m_stages.clear();
+         return false;
+      }
+   }
+
+   if (m_entries == FLOAT_KNOTS)
+   {
+      storeKnots(output.get());
+   }
+   else
+   {
+      // The output bands are the table:
+      const ossim_uint32 BAND_BYTES = m_entries * ossim::scalarSizeInBytes(m_outputType);
+      m_table.resize(BAND_BYTES * m_bands);
+      for (ossim_uint32 band = 0; band < m_bands; ++band)
+      {
+         memcpy(&m_table[band * BAND_BYTES], output->getBuf(band), BAND_BYTES);
+      }
+   }
+
+   // Output tile with the null, min and max the head would have given:
+   m_tile = ossimImageDataFactory::instance()->create(m_head, m_outputType, m_bands,
+                                                      RAMP_WIDTH, RAMP_WIDTH);
+   m_tile->setNullPix(output->getNullPix(), m_bands);
+   m_tile->setMinPix(output->getMinPix(), m_bands);
+   m_tile->setMaxPix(output->getMaxPix(), m_bands);
+   m_tile->initialize();
+
+   // Stamps last, running the ramp may have rebuilt tables of the filters:
+   m_stamps.resize(m_stages.size());
+   for (size_t i = 0; i < m_stages.size(); ++i)
+   {
+      m_stamps[i] = m_stages[i]->getRemapStamp();
+   }
+
+   m_state = FUSED;
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimRemapChain::build: fused " << m_stages.size() << " filters ending with "
+         << m_head->getClassName() << std::endl;
+   }
+   return true;
+}
+
+template <class T>
+static void fillRamp(ossimImageData* ramp, ossim_uint32 entries, ossim_int32 offset,
+                     const std::vector<ossim_float64>& minimum,
+                     const std::vector<ossim_float64>& scale,
+                     const std::vector<ossim_float64>& null)
+{
+   for (ossim_uint32 band = 0; band < ramp->getNumberOfBands(); ++band)
+   {
+      T* buf = static_cast<T*>(ramp->getBuf(band));
+      if (scale.empty())
+      {
+         for (ossim_uint32 i = 0; i < entries; ++i)
+         {
+            buf[i] = static_cast<T>((ossim_int32)i - offset);
+         }
+      }
+      else
+      {
+         for (ossim_uint32 i = 0; i < entries; ++i)
+         {
+            buf[i] = static_cast<T>(minimum[band] + i / scale[band]);
+         }
+
+         // What the filters make of nulls:
+         for (ossim_uint32 i = entries; i < ramp->getSizePerBand(); ++i)
+         {
+            buf[i] = static_cast<T>(null[band]);
+         }
+      }
+   }
+}
+
+ossimRefPtr<ossimImageData> ossimRemapChain::makeRamp()
+{
+   const ossim_uint32 ROWS = m_entries / RAMP_WIDTH + ( (m_entries == FLOAT_KNOTS) ? 1 : 0 );
+   ossimRefPtr<ossimImageData> ramp = ossimImageDataFactory::instance()->create(
+      0, m_inputType, m_bands, RAMP_WIDTH, ROWS);
+   if ( !ramp.valid() )
+   {
+      return ramp;
+   }
+   m_inputNull.resize(m_bands);
+   m_inputMin.resize(m_bands);
+   m_inputMax.resize(m_bands);
+   for (ossim_uint32 band = 0; band < m_bands; ++band)
+   {
+      m_inputNull[band] = m_source->getNullPixelValue(band);
+      m_inputMin[band]  = m_source->getMinPixelValue(band);
+      m_inputMax[band]  = m_source->getMaxPixelValue(band);
+      ramp->setNullPix(m_source->getNullPixelValue(band), band);
+      ramp->setMinPix(m_source->getMinPixelValue(band), band);
+      ramp->setMaxPix(m_source->getMaxPixelValue(band), band);
+   }
+   ramp->initialize();
+
+   if (m_entries == FLOAT_KNOTS)
+   {
+      m_knotMin.resize(m_bands);
+      m_knotScale.resize(m_bands);
+      for (ossim_uint32 band = 0; band < m_bands; ++band)
+      {
+         const ossim_float64 MIN_PIX = ramp->getMinPix(band);
+         const ossim_float64 MAX_PIX = ramp->getMaxPix(band);
+         if ( !(MAX_PIX > MIN_PIX) || ossim::isnan(MIN_PIX) || ossim::isnan(MAX_PIX) )
+         {
+            return 0;
+         }
+         m_knotMin[band]   = MIN_PIX;
+         m_knotScale[band] = (FLOAT_KNOTS - 1) / (MAX_PIX - MIN_PIX);
+      }
+   }
+
+   switch (m_inputType)
+   {
+      case OSSIM_UINT8:
+         fillRamp<ossim_uint8>(ramp.get(), m_entries, m_offset, m_knotMin, m_knotScale,
+                               m_inputNull);
+         break;
+      case OSSIM_SINT16:
+         fillRamp<ossim_sint16>(ramp.get(), m_entries, m_offset, m_knotMin, m_knotScale,
+                                m_inputNull);
+         break;
+      case OSSIM_FLOAT32:
+      case OSSIM_NORMALIZED_FLOAT:
+         fillRamp<ossim_float32>(ramp.get(), m_entries, m_offset, m_knotMin, m_knotScale,
+                                 m_inputNull);
+         break;
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_DOUBLE:
+         fillRamp<ossim_float64>(ramp.get(), m_entries, m_offset, m_knotMin, m_knotScale,
+                                 m_inputNull);
+         break;
+      default:
+         fillRamp<ossim_uint16>(ramp.get(), m_entries, m_offset, m_knotMin, m_knotScale,
+                                m_inputNull);
+         break;
+   }
+   ramp->validate();
+   return ramp;
+}
+
+ossimRefPtr<ossimImageData> ossimRemapChain::runStages(ossimRefPtr<ossimImageData> tile) const
+{
+   for (size_t i = 0; i < m_stages.size(); ++i)
+   {
+      tile = m_stages[i]->remapTile(tile);
+   }
+   return tile;
+}
+
+void ossimRemapChain::storeKnots(const ossimImageData* output)
+{
+   m_knots.resize(m_entries * m_bands);
+   m_nullOutput.resize(m_bands);
+   for (ossim_uint32 band = 0; band < m_bands; ++band)
+   {
+      m_nullOutput[band] = output->getPix(m_entries, band);
+      for (ossim_uint32 i = 0; i < m_entries; ++i)
+      {
+         m_knots[band * m_entries + i] = output->getPix(i, band);
+      }
+   }
+}
+
+ossimRefPtr<ossimImageData> ossimRemapChain::getTile(const ossimIrect& tileRect,
+                                                     ossim_uint32 resLevel)
+{
+   ossimRefPtr<ossimImageData> input = m_source ? m_source->getTile(tileRect, resLevel) : 0;
+   if ( !input.valid() || !m_tile.valid() ||
+        (input->getDataObjectStatus() == OSSIM_NULL) ||
+        (input->getDataObjectStatus() == OSSIM_EMPTY) ||
+        (input->getScalarType() != m_inputType) ||
+        (input->getNumberOfBands() != m_bands) || !matchesRamp(input.get()) )
+   {
+      // Nothing to look up, the filters do what they do with these:
+      return runStages(input);
+   }
+
+   m_tile->setImageRectangle(input->getImageRectangle());
+   switch (m_inputType)
+   {
+      case OSSIM_UINT8:
+         applyTable<ossim_uint8>(input.get());
+         break;
+      case OSSIM_SINT16:
+         applyTable<ossim_sint16>(input.get());
+         break;
+      case OSSIM_FLOAT32:
+      case OSSIM_NORMALIZED_FLOAT:
+         applyKnots<ossim_float32>(input.get());
+         break;
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_DOUBLE:
+         applyKnots<ossim_float64>(input.get());
+         break;
+      default:
+         applyTable<ossim_uint16>(input.get());
+         break;
+   }
+   m_tile->validate();
+   return m_tile;
+}
+
+bool ossimRemapChain::matchesRamp(const ossimImageData* input) const
+{
+   // Filters normalize with the tile's null, min and max, not the source's:
+   for (ossim_uint32 band = 0; band < m_bands; ++band)
+   {
+      if ( (input->getNullPix(band) != m_inputNull[band]) ||
+           (input->getMinPix(band)  != m_inputMin[band])  ||
+           (input->getMaxPix(band)  != m_inputMax[band]) )
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+template <class In> void ossimRemapChain::applyTable(const ossimImageData* input)
+{
+   switch (m_outputType)
+   {
+      case OSSIM_UINT8:
+         applyTable<In, ossim_uint8>(input);
+         break;
+      case OSSIM_SINT16:
+         applyTable<In, ossim_sint16>(input);
+         break;
+      case OSSIM_FLOAT32:
+      case OSSIM_NORMALIZED_FLOAT:
+         applyTable<In, ossim_float32>(input);
+         break;
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_DOUBLE:
+         applyTable<In, ossim_float64>(input);
+         break;
+      default:
+         applyTable<In, ossim_uint16>(input);
+         break;
+   }
+}
+
+template <class In, class Out> void ossimRemapChain::applyTable(const ossimImageData* input)
+{
+   const ossim_uint32 SIZE = input->getSizePerBand();
+   for (ossim_uint32 band = 0; band < m_bands; ++band)
+   {
+      const In* s = static_cast<const In*>(input->getBuf(band));
+      Out*      d = static_cast<Out*>(m_tile->getBuf(band));
+
+      // Offset so signed inputs index directly:
+      const Out* t = reinterpret_cast<const Out*>(&m_table.front()) + band * m_entries + m_offset;
+      for (ossim_uint32 i = 0; i < SIZE; ++i)
+      {
+         d[i] = t[s[i]];
+      }
+   }
+}
+
+template <class In> void ossimRemapChain::applyKnots(const ossimImageData* input)
+{
+   switch (m_outputType)
+   {
+      case OSSIM_UINT8:
+         applyKnots<In, ossim_uint8>(input);
+         break;
+      case OSSIM_SINT16:
+         applyKnots<In, ossim_sint16>(input);
+         break;
+      case OSSIM_FLOAT32:
+      case OSSIM_NORMALIZED_FLOAT:
+         applyKnots<In, ossim_float32>(input);
+         break;
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_DOUBLE:
+         applyKnots<In, ossim_float64>(input);
+         break;
+      default:
+         applyKnots<In, ossim_uint16>(input);
+         break;
+   }
+}
+
+template <class In, class Out> void ossimRemapChain::applyKnots(const ossimImageData* input)
+{
+   const ossim_uint32  SIZE = input->getSizePerBand();
+   const ossim_float64 LAST = m_entries - 1;
+   for (ossim_uint32 band = 0; band < m_bands; ++band)
+   {
+      const In* s = static_cast<const In*>(input->getBuf(band));
+      Out*      d = static_cast<Out*>(m_tile->getBuf(band));
+      const ossim_float64* k = &m_knots[band * m_entries];
+      const ossim_float64 MIN_PIX  = m_knotMin[band];
+      const ossim_float64 SCALE    = m_knotScale[band];
+      const ossim_float64 IN_NULL  = m_inputNull[band];
+      const ossim_float64 OUT_NULL = m_tile->getNullPix(band);
+      const ossim_float64 NULL_OUT = m_nullOutput[band];
+
+      for (ossim_uint32 i = 0; i < SIZE; ++i)
+      {
+         const ossim_float64 P = s[i];
+         if ( (P == IN_NULL) || ossim::isnan(P) )
+         {
+            d[i] = static_cast<Out>(NULL_OUT);
+            continue;
+         }
+
+         ossim_float64 v;
+         const ossim_float64 X = (P - MIN_PIX) * SCALE;
+         if (X <= 0.0)
+         {
+            v = k[0];
+         }
+         else if (X >= LAST)
+         {
+            v = k[m_entries - 1];
+         }
+         else
+         {
+            const ossim_uint32  IDX = static_cast<ossim_uint32>(X);
+            const ossim_float64 F   = X - IDX;
+            const ossim_float64 A   = k[IDX];
+            const ossim_float64 B   = k[IDX + 1];
+
+            // Never blend into null, take the nearer knot:
+            if ( (A == OUT_NULL) || (B == OUT_NULL) )
+            {
+               v = (F < 0.5) ? A : B;
+            }
+            else
+            {
+               v = A + F * (B - A);
+            }
+         }
+         d[i] = static_cast<Out>(v);
+      }
+   }
+}
@@ -0,0 +1,148 @@
+//*******************************************************************
+//
+// License:  MIT
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description:
+//
+// Process wide, byte budgeted cache of decoded RPF subframes.
+//
+//*************************************************************************
+
+#include <ossim/imaging/ossimRpfSubframeCache.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <sstream>
+
+ossimRpfSubframeCache* ossimRpfSubframeCache::m_instance = 0;
+std::mutex ossimRpfSubframeCache::m_instanceMutex;
+
+// Default is 64 megabytes, about ten decoded CADRG frames.
+static const ossim_uint64 DEFAULT_CACHE_SIZE = 64 * 1024 * 1024;
+
+ossimRpfSubframeCache::ossimRpfSubframeCache()
+   :
+   m_mutex(),
+   m_lru(),
+   m_index(),
+   m_cacheSize(0),
+   m_maxCacheSize(DEFAULT_CACHE_SIZE)
+{
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("rpf.subframe_cache_size");
+   if ( lookup )
+   {
+      m_maxCacheSize = ossimString(lookup).toUInt64() * 1024 * 1024;
+   }
+}
+
+ossimRpfSubframeCache* ossimRpfSubframeCache::instance()
+{
+   std::lock_guard<std::mutex> lock(m_instanceMutex);
+   if ( !m_instance )
+   {
+      m_instance = new ossimRpfSubframeCache();
+   }
+   return m_instance;
+}
+
+ossimRpfSubframeCache::SubframeBuffer ossimRpfSubframeCache::getSubframe(
+   const ossimFilename& framePath, ossim_uint32 row, ossim_uint32 col )
+{
+   SubframeBuffer result;
+   std::string key = makeKey( framePath, row, col );
+
+   std::lock_guard<std::mutex> lock(m_mutex);
+   IndexMap::iterator i = m_index.find( key );
+   if ( i != m_index.end() )
+   {
+      // Move to front:
+      m_lru.splice( m_lru.begin(), m_lru, i->second );
+      result = i->second->m_buffer;
+   }
+   return result;
+}
+
+void ossimRpfSubframeCache::addSubframe( const ossimFilename& framePath,
+                                         ossim_uint32 row,
+                                         ossim_uint32 col,
+                                         SubframeBuffer buffer )
+{
+   if ( !buffer )
+   {
+      return;
+   }
+
+   std::string key = makeKey( framePath, row, col );
+
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if ( buffer->size() > m_maxCacheSize )
+   {
+      return; // Caching disabled or item will never fit.
+   }
+
+   IndexMap::iterator i = m_index.find( key );
+   if ( i != m_index.end() )
+   {
+      m_cacheSize -= i->second->m_buffer->size();
+      m_lru.erase( i->second );
+      m_index.erase( i );
+   }
+
+   Node node;
+   node.m_key    = key;
+   node.m_buffer = buffer;
+   m_lru.push_front( node );
+   m_index.insert( std::make_pair( key, m_lru.begin() ) );
+   m_cacheSize += buffer->size();
+
+   shrinkToFit();
+}
+
+void ossimRpfSubframeCache::flush()
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_lru.clear();
+   m_index.clear();
+   m_cacheSize = 0;
+}
+
+void ossimRpfSubframeCache::setMaxCacheSize( ossim_uint64 bytes )
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   m_maxCacheSize = bytes;
+   shrinkToFit();
+}
+
+ossim_uint64 ossimRpfSubframeCache::getMaxCacheSize() const
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_maxCacheSize;
+}
+
+ossim_uint64 ossimRpfSubframeCache::getCacheSize() const
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_cacheSize;
+}
+
+std::string ossimRpfSubframeCache::makeKey( const ossimFilename& framePath,
+                                            ossim_uint32 row,
+                                            ossim_uint32 col )
+{
+   std::ostringstream os;
+   os << framePath.string() << "|" << row << "|" << col;
+   return os.str();
+}
+
+void ossimRpfSubframeCache::shrinkToFit()
+{
+   while ( ( m_cacheSize > m_maxCacheSize ) && m_lru.size() )
+   {
+      Node& node = m_lru.back();
+      m_cacheSize -= node.m_buffer->size();
+      m_index.erase( node.m_key );
+      m_lru.pop_back();
+   }
+}
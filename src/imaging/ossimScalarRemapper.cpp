@@ -98,10 +98,42 @@ ossimRefPtr<ossimImageData> ossimScalarRemapper::getTile(
       return ossimRefPtr<ossimImageData>();
    }
 
+   // Runs of pointwise remappers ending here are one table lookup:
+   if (theRemapChain.fuse(this))
+   {
+      return theRemapChain.getTile(tileRect, resLevel);
+   }
+
    // Fetch tile from pointer from the input source.
    ossimRefPtr<ossimImageData> inputTile =
       theInputConnection->getTile(tileRect, resLevel);
 
+   ossimRefPtr<ossimImageData> result = remapInput(inputTile, tileRect);
+   if(traceDebug())
+   {
+     std::cout << "ossimScalarRemapper::getTile END ... " << tileRect << " RES: " << resLevel << std::endl;
+   }
+   return result;
+}
+
+bool ossimScalarRemapper::isPointwiseRemap() const
+{
+   return true;
+}
+
+ossimRefPtr<ossimImageData> ossimScalarRemapper::remapTile(
+   const ossimRefPtr<ossimImageData>& inputTile)
+{
+   if ( !inputTile.valid() )
+   {
+      return inputTile;
+   }
+   return remapInput(inputTile, inputTile->getImageRectangle());
+}
+
+ossimRefPtr<ossimImageData> ossimScalarRemapper::remapInput(
+   ossimRefPtr<ossimImageData> inputTile, const ossimIrect& tileRect)
+{
    // Check for remap bypass:
    if ( !isSourceEnabled()||theByPassFlag )
    {
@@ -239,11 +271,6 @@ ossimRefPtr<ossimImageData> ossimScalarRemapper::getTile(
    }
    
    theTile->validate();
-   if(traceDebug())
-   {
-     std::cout << "ossimScalarRemapper::getTile END ... " << tileRect << " RES: " << resLevel << std::endl;
-   }
-
    
    return theTile;
 }
@@ -291,6 +318,7 @@ void ossimScalarRemapper::setOutputScalarType(ossimScalarType scalarType)
    }
 
    theOutputScalarType = scalarType;
+   remapChanged();
 }
 
 void ossimScalarRemapper::setOutputScalarType(ossimString scalarType)
@@ -320,6 +348,7 @@ void ossimScalarRemapper::initialize()
    // Note:  This will reset "theInputConnection" if it changed...
    //---
    ossimImageSourceFilter::initialize();
+   theRemapChain.reset();
 
    if (theInputConnection)
    {
@@ -415,6 +444,7 @@ void ossimScalarRemapper::setProperty(ossimRefPtr<ossimProperty> property)
    {
       theOutputScalarType = ossimScalarTypeLut::instance()->
          getScalarTypeFromString(property->valueToString());
+      remapChanged();
    }
    else
    {
@@ -623,6 +653,7 @@ double ossimScalarRemapper::getMaxPixelValue(ossim_uint32 band) const
 void ossimScalarRemapper::setPreserveMagnitude(bool value)
 {
    thePreserveMagnitudeFlag = value;
+   remapChanged();
 }
 
 ossimString ossimScalarRemapper::getLongName()const
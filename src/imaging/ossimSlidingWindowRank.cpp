@@ -0,0 +1,459 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/imaging/ossimSlidingWindowRank.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <algorithm>
+
+// Compare-exchange for the 3x3 median network.
+template <class T> static inline void sort2(T& a, T& b)
+{
+   T t = std::min(a, b);
+   b = std::max(a, b);
+   a = t;
+}
+
+// Median of nine with 19 compare-exchanges (Paeth), p is reordered.
+template <class T> static inline T median9(T* p)
+{
+   sort2(p[1], p[2]); sort2(p[4], p[5]); sort2(p[7], p[8]);
+   sort2(p[0], p[1]); sort2(p[3], p[4]); sort2(p[6], p[7]);
+   sort2(p[1], p[2]); sort2(p[4], p[5]); sort2(p[7], p[8]);
+   sort2(p[0], p[3]); sort2(p[5], p[8]); sort2(p[4], p[7]);
+   sort2(p[3], p[6]); sort2(p[1], p[4]); sort2(p[2], p[5]);
+   sort2(p[4], p[7]); sort2(p[4], p[2]); sort2(p[6], p[4]);
+   sort2(p[4], p[2]);
+   return p[4];
+}
+
+ossimSlidingWindowRank::ossimSlidingWindowRank()
+   : m_windowSize(3),
+     m_rank(0.5),
+     m_nullMode(SKIP_NULL_CENTER),
+     m_levels(0),
+     m_histogram(),
+     m_count(0)
+{
+}
+
+void ossimSlidingWindowRank::setWindowSize(ossim_uint32 windowSize)
+{
+   m_windowSize = (windowSize / 2) * 2 + 1;
+}
+
+void ossimSlidingWindowRank::setRank(double rank)
+{
+   m_rank = (rank < 0.0) ? 0.0 : ((rank > 1.0) ? 1.0 : rank);
+}
+
+bool ossimSlidingWindowRank::getStart(const ossimImageData* input,
+                                      const ossimImageData* output,
+                                      long& startX,
+                                      long& startY) const
+{
+   if (!input || !output || !input->getBuf() || !output->getBuf())
+      return false;
+
+   const long half = m_windowSize / 2;
+   startX = output->getOrigin().x - half - input->getOrigin().x;
+   startY = output->getOrigin().y - half - input->getOrigin().y;
+   return (startX >= 0) && (startY >= 0) &&
+      (startX + (long) output->getWidth()  + 2 * half <= (long) input->getWidth()) &&
+      (startY + (long) output->getHeight() + 2 * half <= (long) input->getHeight());
+}
+
+bool ossimSlidingWindowRank::apply(const ossimImageData* input, ossimImageData* output)
+{
+   long startX = 0;
+   long startY = 0;
+   if (!getStart(input, output, startX, startY) ||
+       (input->getScalarType() != output->getScalarType()))
+   {
+      return false;
+   }
+
+   const bool full = (input->getDataObjectStatus() == OSSIM_FULL);
+   const bool network = full && (m_windowSize == 3) && (rankIndex(9) == 4) &&
+      (m_nullMode != NULL_CENTER_ONLY);
+
+   switch (input->getScalarType())
+   {
+      case OSSIM_UINT8:
+         if (network)
+            applyMedian9<ossim_uint8>(input, output, startX, startY);
+         else
+            applyHistogram<ossim_uint8>(input, output, startX, startY, 8, 0);
+         break;
+      case OSSIM_UINT16:
+      case OSSIM_USHORT11:
+      case OSSIM_USHORT12:
+      case OSSIM_USHORT13:
+      case OSSIM_USHORT14:
+      case OSSIM_USHORT15:
+         if (network)
+            applyMedian9<ossim_uint16>(input, output, startX, startY);
+         else
+            applyHistogram<ossim_uint16>(input, output, startX, startY, 16, 0);
+         break;
+      case OSSIM_SINT16:
+         if (network)
+            applyMedian9<ossim_sint16>(input, output, startX, startY);
+         else
+            applyHistogram<ossim_sint16>(input, output, startX, startY, 16, 32768);
+         break;
+      case OSSIM_UINT32:
+         if (network)
+            applyMedian9<ossim_uint32>(input, output, startX, startY);
+         else
+            applySelect<ossim_uint32>(input, output, startX, startY);
+         break;
+      case OSSIM_FLOAT32:
+      case OSSIM_NORMALIZED_FLOAT:
+         if (network)
+            applyMedian9<ossim_float32>(input, output, startX, startY);
+         else
+            applySelect<ossim_float32>(input, output, startX, startY);
+         break;
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_DOUBLE:
+         if (network)
+            applyMedian9<ossim_float64>(input, output, startX, startY);
+         else
+            applySelect<ossim_float64>(input, output, startX, startY);
+         break;
+      default:
+         return false;
+   }
+   return true;
+}
+
+void ossimSlidingWindowRank::resetHistogram(ossim_uint32 keyBits)
+{
+   m_levels = keyBits / RADIX_BITS;
+   m_histogram.resize(m_levels);
+   ossim_uint32 bins = RADIX;
+   for (ossim_uint32 level = 0; level < m_levels; ++level)
+   {
+      m_histogram[level].assign(bins, 0);
+      bins *= RADIX;
+   }
+   m_count = 0;
+}
+
+inline void ossimSlidingWindowRank::add(ossim_uint32 key)
+{
+   ossim_uint32 shift = (m_levels - 1) * RADIX_BITS;
+   for (ossim_uint32 level = 0; level < m_levels; ++level, shift -= RADIX_BITS)
+      ++m_histogram[level][key >> shift];
+   ++m_count;
+}
+
+inline void ossimSlidingWindowRank::remove(ossim_uint32 key)
+{
+   ossim_uint32 shift = (m_levels - 1) * RADIX_BITS;
+   for (ossim_uint32 level = 0; level < m_levels; ++level, shift -= RADIX_BITS)
+      --m_histogram[level][key >> shift];
+   --m_count;
+}
+
+ossim_uint32 ossimSlidingWindowRank::select(ossim_uint32 k) const
+{
+   // Walk down the levels, at each one skipping the bins holding fewer than k samples:
+   ossim_uint32 node = 0;
+   for (ossim_uint32 level = 0; level < m_levels; ++level)
+   {
+      const ossim_uint32 base = node * RADIX;
+      const ossim_uint32* bins = &m_histogram[level][base];
+      ossim_uint32 i = 0;
+      while (k >= bins[i])
+      {
+         k -= bins[i];
+         ++i;
+      }
+      node = base + i;
+   }
+   return node;
+}
+
+template <class T>
+void ossimSlidingWindowRank::applyHistogram(const ossimImageData* input,
+                                            ossimImageData* output,
+                                            long startX,
+                                            long startY,
+                                            ossim_uint32 keyBits,
+                                            long keyOffset)
+{
+   const long w    = m_windowSize;
+   const long half = w / 2;
+   const long iw   = input->getWidth();
+   const long ow   = output->getWidth();
+   const long oh   = output->getHeight();
+   const bool checkNulls = (input->getDataObjectStatus() != OSSIM_FULL);
+   const ossim_uint32 bands = std::min(input->getNumberOfBands(), output->getNumberOfBands());
+
+   for (ossim_uint32 band = 0; band < bands; ++band)
+   {
+      const T* in = static_cast<const T*>(input->getBuf(band)) + startY * iw + startX;
+      T* out = static_cast<T*>(output->getBuf(band));
+      const T np = static_cast<T>(input->getNullPix(band));
+
+      resetHistogram(keyBits);
+      for (long r = 0; r < w; ++r)
+      {
+         for (long c = 0; c < w; ++c)
+         {
+            const T v = in[r * iw + c];
+            if (!checkNulls || (v != np))
+               add((ossim_uint32) ((long) v + keyOffset));
+         }
+      }
+
+      // Serpentine: right on even lines, left on odd ones, so every move shifts one edge.
+      long x = 0;
+      for (long y = 0; y < oh; ++y)
+      {
+         if (y > 0)
+         {
+            const T* top    = in + (y - 1) * iw + x;
+            const T* bottom = top + w * iw;
+            for (long c = 0; c < w; ++c)
+            {
+               if (!checkNulls || (top[c] != np))
+                  remove((ossim_uint32) ((long) top[c] + keyOffset));
+               if (!checkNulls || (bottom[c] != np))
+                  add((ossim_uint32) ((long) bottom[c] + keyOffset));
+            }
+         }
+
+         const long step = (y & 1) ? -1 : 1;
+         for (long i = 0; i < ow; ++i)
+         {
+            if (i > 0)
+            {
+               const T* leaving  = in + y * iw + ((step > 0) ? x : x + w - 1);
+               const T* entering = in + y * iw + ((step > 0) ? x + w : x - 1);
+               for (long r = 0; r < w; ++r)
+               {
+                  const T vl = leaving[r * iw];
+                  const T ve = entering[r * iw];
+                  if (!checkNulls || (vl != np))
+                     remove((ossim_uint32) ((long) vl + keyOffset));
+                  if (!checkNulls || (ve != np))
+                     add((ossim_uint32) ((long) ve + keyOffset));
+               }
+               x += step;
+            }
+
+            const T center = in[(y + half) * iw + x + half];
+            T& o = out[y * ow + x];
+            if (checkNulls && (center == np))
+            {
+               o = ((m_nullMode != SKIP_NULL_CENTER) && m_count) ?
+                  (T) ((long) select(rankIndex(m_count)) - keyOffset) : np;
+            }
+            else if ((m_nullMode == NULL_CENTER_ONLY) || !m_count)
+            {
+               o = center;
+            }
+            else
+            {
+               o = (T) ((long) select(rankIndex(m_count)) - keyOffset);
+            }
+         }
+      }
+   }
+}
+
+template <class T>
+void ossimSlidingWindowRank::applySelect(const ossimImageData* input,
+                                         ossimImageData* output,
+                                         long startX,
+                                         long startY)
+{
+   const long w    = m_windowSize;
+   const long half = w / 2;
+   const long iw   = input->getWidth();
+   const long ow   = output->getWidth();
+   const long oh   = output->getHeight();
+   const bool checkNulls = (input->getDataObjectStatus() != OSSIM_FULL);
+   const ossim_uint32 bands = std::min(input->getNumberOfBands(), output->getNumberOfBands());
+   std::vector<T> values(w * w);
+
+   for (ossim_uint32 band = 0; band < bands; ++band)
+   {
+      const T* in = static_cast<const T*>(input->getBuf(band)) + startY * iw + startX;
+      T* out = static_cast<T*>(output->getBuf(band));
+      const T np = static_cast<T>(input->getNullPix(band));
+
+      for (long y = 0; y < oh; ++y)
+      {
+         for (long x = 0; x < ow; ++x)
+         {
+            const T* window = in + y * iw + x;
+            const T center = window[half * iw + half];
+            T& o = out[y * ow + x];
+            bool nullCenter = checkNulls && (center == np);
+            if ((nullCenter && (m_nullMode == SKIP_NULL_CENTER)) ||
+                (!nullCenter && (m_nullMode == NULL_CENTER_ONLY)))
+            {
+               o = center;
+               continue;
+            }
+
+            ossim_uint32 n = 0;
+            for (long r = 0; r < w; ++r)
+            {
+               for (long c = 0; c < w; ++c)
+               {
+                  const T v = window[r * iw + c];
+                  if (!checkNulls || (v != np))
+                     values[n++] = v;
+               }
+            }
+            if (n)
+            {
+               typename std::vector<T>::iterator pick = values.begin() + rankIndex(n);
+               std::nth_element(values.begin(), pick, values.begin() + n);
+               o = *pick;
+            }
+            else
+            {
+               o = np;
+            }
+         }
+      }
+   }
+}
+
+template <class T>
+void ossimSlidingWindowRank::applyMedian9(const ossimImageData* input,
+                                          ossimImageData* output,
+                                          long startX,
+                                          long startY) const
+{
+   const long iw = input->getWidth();
+   const long ow = output->getWidth();
+   const long oh = output->getHeight();
+   const ossim_uint32 bands = std::min(input->getNumberOfBands(), output->getNumberOfBands());
+   T p[9];
+
+   for (ossim_uint32 band = 0; band < bands; ++band)
+   {
+      const T* in = static_cast<const T*>(input->getBuf(band)) + startY * iw + startX;
+      T* out = static_cast<T*>(output->getBuf(band));
+      for (long y = 0; y < oh; ++y)
+      {
+         const T* r0 = in + y * iw;
+         const T* r1 = r0 + iw;
+         const T* r2 = r1 + iw;
+         for (long x = 0; x < ow; ++x)
+         {
+            p[0] = r0[x]; p[1] = r0[x + 1]; p[2] = r0[x + 2];
+            p[3] = r1[x]; p[4] = r1[x + 1]; p[5] = r1[x + 2];
+            p[6] = r2[x]; p[7] = r2[x + 1]; p[8] = r2[x + 2];
+            out[y * ow + x] = median9(p);
+         }
+      }
+   }
+}
+
+bool ossimSlidingWindowRank::countValid(const ossimImageData* input,
+                                        ossim_uint32 band,
+                                        const ossimImageData* output,
+                                        std::vector<ossim_uint32>& counts) const
+{
+   long startX = 0;
+   long startY = 0;
+   if (!getStart(input, output, startX, startY) || (band >= input->getNumberOfBands()))
+      return false;
+
+   const long width  = output->getWidth();
+   const long height = output->getHeight();
+   switch (input->getScalarType())
+   {
+      case OSSIM_UINT8:
+         countValidT<ossim_uint8>(input, band, startX, startY, width, height, counts);
+         break;
+      case OSSIM_UINT16:
+      case OSSIM_USHORT11:
+      case OSSIM_USHORT12:
+      case OSSIM_USHORT13:
+      case OSSIM_USHORT14:
+      case OSSIM_USHORT15:
+         countValidT<ossim_uint16>(input, band, startX, startY, width, height, counts);
+         break;
+      case OSSIM_SINT16:
+         countValidT<ossim_sint16>(input, band, startX, startY, width, height, counts);
+         break;
+      case OSSIM_UINT32:
+         countValidT<ossim_uint32>(input, band, startX, startY, width, height, counts);
+         break;
+      case OSSIM_FLOAT32:
+      case OSSIM_NORMALIZED_FLOAT:
+         countValidT<ossim_float32>(input, band, startX, startY, width, height, counts);
+         break;
+      case OSSIM_FLOAT64:
+      case OSSIM_NORMALIZED_DOUBLE:
+         countValidT<ossim_float64>(input, band, startX, startY, width, height, counts);
+         break;
+      default:
+         return false;
+   }
+   return true;
+}
+
+template <class T>
+void ossimSlidingWindowRank::countValidT(const ossimImageData* input,
+                                         ossim_uint32 band,
+                                         long startX,
+                                         long startY,
+                                         long width,
+                                         long height,
+                                         std::vector<ossim_uint32>& counts) const
+{
+   const long w  = m_windowSize;
+   const long iw = input->getWidth();
+   counts.resize(width * height);
+   if (input->getDataObjectStatus() == OSSIM_FULL)
+   {
+      std::fill(counts.begin(), counts.end(), (ossim_uint32) (w * w));
+      return;
+   }
+
+   const T* in = static_cast<const T*>(input->getBuf(band)) + startY * iw + startX;
+   const T np = static_cast<T>(input->getNullPix(band));
+
+   // Valid samples per column over the window's lines, then a running sum along each line:
+   const long columns = width + w - 1;
+   std::vector<ossim_uint32> columnCounts(columns, 0);
+   for (long r = 0; r < w; ++r)
+      for (long c = 0; c < columns; ++c)
+         columnCounts[c] += (in[r * iw + c] != np);
+
+   for (long y = 0; y < height; ++y)
+   {
+      if (y > 0)
+      {
+         const T* top    = in + (y - 1) * iw;
+         const T* bottom = top + w * iw;
+         for (long c = 0; c < columns; ++c)
+            columnCounts[c] += (ossim_uint32) (bottom[c] != np) - (ossim_uint32) (top[c] != np);
+      }
+
+      ossim_uint32 sum = 0;
+      for (long c = 0; c < w; ++c)
+         sum += columnCounts[c];
+      ossim_uint32* line = &counts[y * width];
+      line[0] = sum;
+      for (long x = 1; x < width; ++x)
+      {
+         sum += columnCounts[x + w - 1] - columnCounts[x - 1];
+         line[x] = sum;
+      }
+   }
+}
@@ -47,22 +47,29 @@ ossimRefPtr<ossimImageData> ossimSlopeFilter::getTile(const ossimIrect& rect, os
    if (!m_normals.valid())
       initialize();
 
-   ossimRefPtr<ossimImageData> normals = m_normals->getTile(rect, rLevel);
-   if (!normals.valid())
-      return ossimRefPtr<ossimImageData>();
-
    ossimRefPtr<ossimImageData> outputTile = new ossimImageData(this, OSSIM_FLOAT32, 1);
    outputTile->setImageRectangle(rect);
    outputTile->initialize();
+
+   // Only the z of the normals, the cosine of the slope, straight from the elevation:
+   const double null_input = OSSIM_DEFAULT_NULL_PIX_DOUBLE;
+   ossim_uint32 num_pix = outputTile->getSizePerBand();
+   vector<double> normalZ (num_pix);
+   ossimTerrainKernels::Outputs normals;
+   normals.m_normalZ = &normalZ.front();
+   if (!m_normals->getTerrainTile(rect, rLevel, normals, null_input))
+   {
+      outputTile->makeBlank();
+      return outputTile;
+   }
+
    ossim_float32* output_buf = outputTile->getFloatBuf();
    ossim_float32 null_output = (ossim_float32) outputTile->getNullPix(0);
 
    double z, theta;
-   double null_input = normals->getNullPix(2);
-   ossim_uint32 num_pix = normals->getSizePerBand();
    for (ossim_uint32 i=0; i<num_pix; ++i)
    {
-      z = normals->getPix(i, 2);
+      z = normalZ[i];
       if (z == null_input)
       {
          theta = null_output;
@@ -75,6 +75,7 @@ void ossimTableRemapper::initialize()
    //---
    ossimImageSourceFilter::initialize();
    destroy();
+   theRemapChain.reset();
    if (theInputConnection)
    {
       theInputScalarType = theInputConnection->getOutputScalarType();
@@ -157,44 +158,72 @@ ossimRefPtr<ossimImageData> ossimTableRemapper::getTile(
    
    if(theInputConnection)
    {
+      // Runs of pointwise remappers ending here are one table lookup:
+      if (theRemapChain.fuse(this))
+      {
+         return theRemapChain.getTile(tile_rect, resLevel);
+      }
+
       // Fetch tile from pointer from the input source.
-      result = theInputConnection->getTile(tile_rect, resLevel);
-      if (theEnableFlag&&result.valid())
-      {  
-         // Get its status of the input tile.
-         ossimDataObjectStatus tile_status = result->getDataObjectStatus();
-         
-         // Check for remap bypass:
-         if ( (tile_status != OSSIM_NULL) &&
-              (tile_status != OSSIM_EMPTY) && theTable.size() )
+      result = remapTile(theInputConnection->getTile(tile_rect, resLevel));
+   }
+   return result;
+}
+
+bool ossimTableRemapper::isPointwiseRemap() const
+{
+   return true;
+}
+
+ossimRefPtr<ossimImageData> ossimTableRemapper::remapTile(
+   const ossimRefPtr<ossimImageData>& inputTile)
+{
+   ossimRefPtr<ossimImageData> result = inputTile;
+   
+   if (theEnableFlag&&result.valid())
+   {  
+      // Get its status of the input tile.
+      ossimDataObjectStatus tile_status = result->getDataObjectStatus();
+      
+      // Check for remap bypass:
+      if ( (tile_status != OSSIM_NULL) &&
+           (tile_status != OSSIM_EMPTY) && theTable.size() )
+      {
+         const ossimIrect tile_rect = result->getImageRectangle();
+
+         // OK we have an input tile... and it's not null or empty.
+         if(!theTile)
+         {
+            allocate(tile_rect);
+         }
+         if (theTile.valid())
          {
+            ossim_uint32 oldSize = theTile->getSize();
+            theTile->setImageRectangle(tile_rect);
+            if(theTmpTile.valid()) // not mandatory for all modes.
+            {
+               theTmpTile->setImageRectangle(tile_rect);
+            }
+            if (theNormBuf && (theTile->getSize() != oldSize))
+            {
+               // Size changed, the normalized buffer must follow:
+               delete [] theNormBuf;
+               theNormBuf = new ossim_float64[theTile->getSize()];
+            }
 
-            // OK we have an input tile... and it's not null or empty.
-            if(!theTile)
+            // Think things are good.  Do the real work...
+            if (theTableType == ossimTableRemapper::NATIVE)
             {
-               allocate(tile_rect);
+               // Most efficient case...
+               remapFromNativeTable(result);
             }
-            if (theTile.valid())
+            else
             {
-               theTile->setImageRectangle(tile_rect);
-               if(theTmpTile.valid()) // not mandatory for all modes.
-               {
-                  theTmpTile->setImageRectangle(tile_rect);
-               }   
-               // Think things are good.  Do the real work...
-               if (theTableType == ossimTableRemapper::NATIVE)
-               {
-                  // Most efficient case...
-                  remapFromNativeTable(result);
-               }
-               else
-               {
-                  remapFromNormalizedTable(result);
-               }
-              
-               theTile->validate();
-               result = theTile;
+               remapFromNormalizedTable(result);
             }
+           
+            theTile->validate();
+            result = theTile;
          }
       }
    }
@@ -0,0 +1,357 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/imaging/ossimTerrainKernels.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
+#include <cmath>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define OSSIM_TERRAIN_AVX2 1
+#  include <immintrin.h>
+#  define OSSIM_AVX2 __attribute__((target("avx2")))
+#endif
+
+ossimTerrainKernels::Params::Params()
+   : m_stencil(ZEVENBERGEN_THORNE),
+     m_xScale(1.0),
+     m_yScale(1.0),
+     m_inputNull(0.0),
+     m_outputNull(OSSIM_DEFAULT_NULL_PIX_DOUBLE)
+{
+   m_light[0] = 0.0;
+   m_light[1] = 0.0;
+   m_light[2] = 1.0;
+}
+
+ossimTerrainKernels::Outputs::Outputs()
+   : m_normalX(0),
+     m_normalY(0),
+     m_normalZ(0),
+     m_aspect(0),
+     m_shade(0)
+{
+}
+
+//---
+// Plain loops, also the reference of the AVX2 one.
+//---
+static inline ossim_float64 aspect(ossim_float64 p, ossim_float64 q)
+{
+   if ( (p == 0.0) && (q == 0.0) )
+   {
+      return -1.0;
+   }
+
+   // Downhill is (-p, -q) in x east, y south:
+   ossim_float64 a = std::atan2(-p, q) * DEG_PER_RAD;
+   return (a < 0.0) ? a + 360.0 : a;
+}
+
+//---
+// Gradient of the pixel at c, rows stride apart. Returns false if there is none, i.e. both
+// differences of an axis are missing.
+//---
+template <class T>
+static inline bool gradient(const T* c, ossim_int64 stride, T np,
+                            const ossimTerrainKernels::Params& params,
+                            ossim_float64& p, ossim_float64& q)
+{
+   if ( (params.m_stencil == ossimTerrainKernels::HORN) &&
+        (c[-stride - 1] != np) && (c[-stride] != np) && (c[-stride + 1] != np) &&
+        (c[-1] != np) && (c[0] != np) && (c[1] != np) &&
+        (c[stride - 1] != np) && (c[stride] != np) && (c[stride + 1] != np) )
+   {
+      p = params.m_xScale *
+         ( (ossim_float64(c[-stride + 1]) + 2.0 * c[1] + c[stride + 1]) -
+           (ossim_float64(c[-stride - 1]) + 2.0 * c[-1] + c[stride - 1]) ) / 8.0;
+      q = params.m_yScale *
+         ( (ossim_float64(c[stride - 1]) + 2.0 * c[stride] + c[stride + 1]) -
+           (ossim_float64(c[-stride - 1]) + 2.0 * c[-stride] + c[-stride + 1]) ) / 8.0;
+      return true;
+   }
+
+   p = 0.0;
+   q = 0.0;
+   if (c[1] != np)
+   {
+      if (c[-1] != np)
+         p = params.m_xScale * (ossim_float64(c[1]) - c[-1]) / 2.0;
+      else if (c[0] != np)
+         p = params.m_xScale * (ossim_float64(c[1]) - c[0]);
+   }
+   else if ( (c[0] != np) && (c[-1] != np) )
+   {
+      p = params.m_xScale * (ossim_float64(c[0]) - c[-1]);
+   }
+   else
+   {
+      return false;
+   }
+
+   if (c[stride] != np)
+   {
+      if (c[-stride] != np)
+         q = params.m_yScale * (ossim_float64(c[stride]) - c[-stride]) / 2.0;
+      else if (c[0] != np)
+         q = params.m_yScale * (ossim_float64(c[stride]) - c[0]);
+   }
+   else if ( (c[0] != np) && (c[-stride] != np) )
+   {
+      q = params.m_yScale * (ossim_float64(c[0]) - c[-stride]);
+   }
+   else
+   {
+      return false;
+   }
+   return true;
+}
+
+// count pixels of a row from c on, written from index n of the outputs:
+template <class T>
+static void computeLoop(const T* c, ossim_int64 stride, ossim_uint32 count, ossim_uint32 n,
+                        const ossimTerrainKernels::Params& params,
+                        const ossimTerrainKernels::Outputs& out)
+{
+   const T NP = static_cast<T>(params.m_inputNull);
+   const ossim_float64 ONP = params.m_outputNull;
+   for (ossim_uint32 i = 0; i < count; ++i, ++c, ++n)
+   {
+      ossim_float64 p;
+      ossim_float64 q;
+      if ( gradient(c, stride, NP, params, p, q) )
+      {
+         const ossim_float64 M = 1.0 / std::sqrt(p * p + q * q + 1.0);
+         const ossim_float64 X = p * M;
+         const ossim_float64 Y = q * M;
+         if (out.m_normalX) out.m_normalX[n] = X;
+         if (out.m_normalY) out.m_normalY[n] = Y;
+         if (out.m_normalZ) out.m_normalZ[n] = M;
+         if (out.m_aspect)  out.m_aspect[n]  = aspect(p, q);
+         if (out.m_shade)
+         {
+            out.m_shade[n] = X * params.m_light[0] + Y * params.m_light[1] +
+                             M * params.m_light[2];
+         }
+      }
+      else
+      {
+         if (out.m_normalX) out.m_normalX[n] = ONP;
+         if (out.m_normalY) out.m_normalY[n] = ONP;
+         if (out.m_normalZ) out.m_normalZ[n] = ONP;
+         if (out.m_aspect)  out.m_aspect[n]  = ONP;
+         if (out.m_shade)   out.m_shade[n]   = ONP;
+      }
+   }
+}
+
+#ifdef OSSIM_TERRAIN_AVX2
+
+//---
+// AVX2 loop. Types without one get the generic template, which returns false so the plain loop
+// runs.
+//---
+template <class T>
+static bool computeAvx2(const T*, ossim_uint32, ossim_uint32,
+                        const ossimTerrainKernels::Params&, const ossimTerrainKernels::Outputs&)
+{
+   return false;
+}
+
+static inline OSSIM_AVX2 __m256d load4(const ossim_uint8* s)
+{
+   ossim_int32 v;
+   memcpy(&v, s, sizeof(v));
+   return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(v)));
+}
+static inline OSSIM_AVX2 __m256d load4(const ossim_uint16* s)
+{
+   return _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)s)));
+}
+static inline OSSIM_AVX2 __m256d load4(const ossim_sint16* s)
+{
+   return _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*)s)));
+}
+static inline OSSIM_AVX2 __m256d load4(const ossim_float32* s)
+{
+   return _mm256_cvtps_pd(_mm_loadu_ps(s));
+}
+static inline OSSIM_AVX2 __m256d load4(const ossim_float64* s)
+{
+   return _mm256_loadu_pd(s);
+}
+
+static inline OSSIM_AVX2 void store4(ossim_float64* d, __m256d v)
+{
+   if (d)
+   {
+      _mm256_storeu_pd(d, v);
+   }
+}
+
+// (a + 2b) + c, the plain loop's Horn sum:
+static inline OSSIM_AVX2 __m256d weigh121(__m256d a, __m256d b, __m256d c)
+{
+   return _mm256_add_pd(_mm256_add_pd(a, _mm256_mul_pd(_mm256_set1_pd(2.0), b)), c);
+}
+
+template <class T>
+static OSSIM_AVX2 void computeRun(const T* dem, ossim_uint32 width, ossim_uint32 height,
+                                  const ossimTerrainKernels::Params& params,
+                                  const ossimTerrainKernels::Outputs& out)
+{
+   const ossim_int64 S = width + 2;
+   const bool HORN = (params.m_stencil == ossimTerrainKernels::HORN);
+   const __m256d NP  = _mm256_set1_pd( static_cast<T>(params.m_inputNull) );
+   const __m256d XS  = _mm256_set1_pd(params.m_xScale);
+   const __m256d YS  = _mm256_set1_pd(params.m_yScale);
+   const __m256d ONE = _mm256_set1_pd(1.0);
+   const __m256d TWO = _mm256_set1_pd(2.0);
+   const __m256d EIGHT = _mm256_set1_pd(8.0);
+   const __m256d L0 = _mm256_set1_pd(params.m_light[0]);
+   const __m256d L1 = _mm256_set1_pd(params.m_light[1]);
+   const __m256d L2 = _mm256_set1_pd(params.m_light[2]);
+   const ossim_uint32 END = width & ~3u;
+
+   for (ossim_uint32 y = 0; y < height; ++y)
+   {
+      const T* row = dem + (y + 1) * S + 1;
+      ossim_uint32 n = y * width;
+      for (ossim_uint32 x = 0; x < END; x += 4, n += 4)
+      {
+         const T* c = row + x;
+         const __m256d W = load4(c - 1);
+         const __m256d E = load4(c + 1);
+         const __m256d N = load4(c - S);
+         const __m256d SO = load4(c + S);
+         __m256d nulls = _mm256_or_pd(
+            _mm256_or_pd(_mm256_cmp_pd(W, NP, _CMP_EQ_OQ), _mm256_cmp_pd(E, NP, _CMP_EQ_OQ)),
+            _mm256_or_pd(_mm256_cmp_pd(N, NP, _CMP_EQ_OQ), _mm256_cmp_pd(SO, NP, _CMP_EQ_OQ)));
+
+         __m256d p;
+         __m256d q;
+         if (HORN)
+         {
+            const __m256d NW = load4(c - S - 1);
+            const __m256d NE = load4(c - S + 1);
+            const __m256d SW = load4(c + S - 1);
+            const __m256d SE = load4(c + S + 1);
+            const __m256d C  = load4(c);
+            nulls = _mm256_or_pd(nulls, _mm256_or_pd(
+               _mm256_or_pd(_mm256_cmp_pd(NW, NP, _CMP_EQ_OQ), _mm256_cmp_pd(NE, NP, _CMP_EQ_OQ)),
+               _mm256_or_pd(_mm256_cmp_pd(SW, NP, _CMP_EQ_OQ), _mm256_cmp_pd(SE, NP, _CMP_EQ_OQ))));
+            nulls = _mm256_or_pd(nulls, _mm256_cmp_pd(C, NP, _CMP_EQ_OQ));
+            p = _mm256_div_pd(_mm256_mul_pd(XS, _mm256_sub_pd(weigh121(NE, E, SE),
+                                                              weigh121(NW, W, SW))), EIGHT);
+            q = _mm256_div_pd(_mm256_mul_pd(YS, _mm256_sub_pd(weigh121(SW, SO, SE),
+                                                              weigh121(NW, N, NE))), EIGHT);
+         }
+         else
+         {
+            p = _mm256_div_pd(_mm256_mul_pd(XS, _mm256_sub_pd(E, W)), TWO);
+            q = _mm256_div_pd(_mm256_mul_pd(YS, _mm256_sub_pd(SO, N)), TWO);
+         }
+
+         if ( _mm256_movemask_pd(nulls) )
+         {
+            computeLoop(c, S, 4, n, params, out);
+            continue;
+         }
+
+         // Multiply then add, never fused, as the plain loop:
+         const __m256d M = _mm256_div_pd(ONE, _mm256_sqrt_pd(_mm256_add_pd(
+            _mm256_add_pd(_mm256_mul_pd(p, p), _mm256_mul_pd(q, q)), ONE)));
+         const __m256d X = _mm256_mul_pd(p, M);
+         const __m256d Y = _mm256_mul_pd(q, M);
+         store4(out.m_normalX ? out.m_normalX + n : 0, X);
+         store4(out.m_normalY ? out.m_normalY + n : 0, Y);
+         store4(out.m_normalZ ? out.m_normalZ + n : 0, M);
+         if (out.m_shade)
+         {
+            store4(out.m_shade + n, _mm256_add_pd(
+               _mm256_add_pd(_mm256_mul_pd(X, L0), _mm256_mul_pd(Y, L1)), _mm256_mul_pd(M, L2)));
+         }
+         if (out.m_aspect)
+         {
+            ossim_float64 pq[8];
+            _mm256_storeu_pd(pq, p);
+            _mm256_storeu_pd(pq + 4, q);
+            for (ossim_uint32 i = 0; i < 4; ++i)
+            {
+               out.m_aspect[n + i] = aspect(pq[i], pq[i + 4]);
+            }
+         }
+      }
+      computeLoop(row + END, S, width - END, n, params, out);
+   }
+}
+
+#define OSSIM_TERRAIN_AVX2_TYPE(T)                                                                 \
+static bool computeAvx2(const T* dem, ossim_uint32 width, ossim_uint32 height,                     \
+                        const ossimTerrainKernels::Params& params,                                 \
+                        const ossimTerrainKernels::Outputs& outputs)                               \
+{                                                                                                  \
+   computeRun(dem, width, height, params, outputs);                                                \
+   return true;                                                                                    \
+}
+
+OSSIM_TERRAIN_AVX2_TYPE(ossim_uint8)
+OSSIM_TERRAIN_AVX2_TYPE(ossim_uint16)
+OSSIM_TERRAIN_AVX2_TYPE(ossim_sint16)
+OSSIM_TERRAIN_AVX2_TYPE(ossim_float32)
+OSSIM_TERRAIN_AVX2_TYPE(ossim_float64)
+
+#undef OSSIM_TERRAIN_AVX2_TYPE
+
+#endif /* #ifdef OSSIM_TERRAIN_AVX2 */
+
+template <class T>
+void ossimTerrainKernels::compute(const T* dem, ossim_uint32 width, ossim_uint32 height,
+                                  const Params& params, const Outputs& outputs)
+{
+#ifdef OSSIM_TERRAIN_AVX2
+   if ( (ossimImageDataKernels::getIsa() == ossimImageDataKernels::ISA_AVX2) &&
+        computeAvx2(dem, width, height, params, outputs) )
+   {
+      return;
+   }
+#endif
+   const ossim_int64 S = width + 2;
+   for (ossim_uint32 y = 0; y < height; ++y)
+   {
+      computeLoop(dem + (y + 1) * S + 1, S, width, y * width, params, outputs);
+   }
+}
+
+void ossimTerrainKernels::fillFlat(ossim_uint32 count, const Params& params,
+                                   const Outputs& outputs)
+{
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      if (outputs.m_normalX) outputs.m_normalX[i] = 0.0;
+      if (outputs.m_normalY) outputs.m_normalY[i] = 0.0;
+      if (outputs.m_normalZ) outputs.m_normalZ[i] = 1.0;
+      if (outputs.m_aspect)  outputs.m_aspect[i]  = -1.0;
+      if (outputs.m_shade)   outputs.m_shade[i]   = params.m_light[2];
+   }
+}
+
+#define OSSIM_INSTANTIATE_TERRAIN_KERNELS(T)                                                       \
+template void ossimTerrainKernels::compute<T>(const T*, ossim_uint32, ossim_uint32,                \
+                                              const Params&, const Outputs&);
+
+OSSIM_INSTANTIATE_TERRAIN_KERNELS(ossim_uint8)
+OSSIM_INSTANTIATE_TERRAIN_KERNELS(ossim_sint8)
+OSSIM_INSTANTIATE_TERRAIN_KERNELS(ossim_uint16)
+OSSIM_INSTANTIATE_TERRAIN_KERNELS(ossim_sint16)
+OSSIM_INSTANTIATE_TERRAIN_KERNELS(ossim_uint32)
+OSSIM_INSTANTIATE_TERRAIN_KERNELS(ossim_sint32)
+OSSIM_INSTANTIATE_TERRAIN_KERNELS(ossim_float32)
+OSSIM_INSTANTIATE_TERRAIN_KERNELS(ossim_float64)
+
+#undef OSSIM_INSTANTIATE_TERRAIN_KERNELS
@@ -73,7 +73,7 @@ ossimTiffOverviewBuilder::ossimTiffOverviewBuilder()
       m_currentTiffDir(0),
       m_tiffCompressType(COMPRESSION_NONE),
       m_jpegCompressQuality(DEFAULT_COMPRESS_QUALITY),
-      m_resampleType(ossimFilterResampler::ossimFilterResampler_BOX),
+      m_decimationMethod(ossimDecimator::BOX),
       m_nullPixelValues(),
       m_copyAllFlag(false),
       m_outputTileSizeSetFlag(false),
@@ -102,7 +102,23 @@ ossimTiffOverviewBuilder::~ossimTiffOverviewBuilder()
 void ossimTiffOverviewBuilder::setResampleType(
    ossimFilterResampler::ossimFilterResamplerType resampleType)
 {
-   m_resampleType = resampleType;
+   switch (resampleType)
+   {
+      case ossimFilterResampler::ossimFilterResampler_NEAREST_NEIGHBOR:
+         m_decimationMethod = ossimDecimator::NEAREST;
+         break;
+      case ossimFilterResampler::ossimFilterResampler_LANCZOS:
+         m_decimationMethod = ossimDecimator::LANCZOS3;
+         break;
+      default:
+         m_decimationMethod = ossimDecimator::BOX;
+         break;
+   }
+}
+
+void ossimTiffOverviewBuilder::setDecimationMethod(ossimDecimator::Method method)
+{
+   m_decimationMethod = method;
 }
 
 bool ossimTiffOverviewBuilder::buildOverview(const ossimFilename& overview_file, bool copy_all)
@@ -669,7 +685,7 @@ bool ossimTiffOverviewBuilder::writeRn( ossimImageHandler* imageHandler,
       imageHandler->getStartingResLevel() - 1;
 
    sequencer->setSourceLevel(sourceResLevel);
-   sequencer->setResampleType(m_resampleType);
+   sequencer->setDecimationMethod(m_decimationMethod);
    sequencer->setTileSize( ossimIpt(m_tileWidth, m_tileHeight) );
    
    if ( firstResLevel )
@@ -1306,12 +1322,19 @@ bool ossimTiffOverviewBuilder::setOverviewType(const ossimString& type)
    bool result = true;
    if (type == "ossim_tiff_nearest")
    {
-      m_resampleType =
-         ossimFilterResampler::ossimFilterResampler_NEAREST_NEIGHBOR;
+      m_decimationMethod = ossimDecimator::NEAREST;
    }
    else if (type == "ossim_tiff_box")
    {
-      m_resampleType = ossimFilterResampler::ossimFilterResampler_BOX;
+      m_decimationMethod = ossimDecimator::BOX;
+   }
+   else if (type == "ossim_tiff_lanczos")
+   {
+      m_decimationMethod = ossimDecimator::LANCZOS3;
+   }
+   else if (type == "ossim_tiff_mode")
+   {
+      m_decimationMethod = ossimDecimator::MODE;
    }
    else
    {
@@ -1322,16 +1345,8 @@ bool ossimTiffOverviewBuilder::setOverviewType(const ossimString& type)
 
 ossimString ossimTiffOverviewBuilder::getOverviewType() const
 {
-   ossimString type;
-   if (m_resampleType == ossimFilterResampler::ossimFilterResampler_NEAREST_NEIGHBOR)
-   {
-      type = "ossim_tiff_nearest";
-   }
-   else
-   {
-      type = "ossim_tiff_box"; // This is default...
-   }
-   return type;
+   // "ossim_tiff_box" is default...
+   return ossimString("ossim_tiff_") + ossimDecimator::getMethodName(m_decimationMethod);
 }
 
 void ossimTiffOverviewBuilder::getTypeNameList(
@@ -1339,6 +1354,8 @@ void ossimTiffOverviewBuilder::getTypeNameList(
 {
    typeList.push_back(ossimString("ossim_tiff_box"));
    typeList.push_back(ossimString("ossim_tiff_nearest"));
+   typeList.push_back(ossimString("ossim_tiff_lanczos"));
+   typeList.push_back(ossimString("ossim_tiff_mode"));
 }
 
 void ossimTiffOverviewBuilder::setProperty(ossimRefPtr<ossimProperty> property)
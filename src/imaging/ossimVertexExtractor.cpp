@@ -8,14 +8,22 @@
 //*************************************************************************
 // $Id: ossimVertexExtractor.cpp 21184 2012-06-29 15:13:09Z dburken $
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <fstream>
+#include <thread>
 using namespace std;
 
 #include <ossim/imaging/ossimVertexExtractor.h>
 #include <ossim/imaging/ossimImageSource.h>
 #include <ossim/imaging/ossimImageHandler.h>
+#include <ossim/imaging/ossimImageHandlerRegistry.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimTrace.h>
 #include <ossim/base/ossimNotifyContext.h>
+#include <ossim/parallel/ossimParallelFor.h>
 
 static ossimTrace traceDebug("ossimVertexExtractor:debug");
 
@@ -35,8 +43,16 @@ ossimVertexExtractor::ossimVertexExtractor(ossimImageSource* inputSource)
       theFileStream(),
       theVertice(4),
       theLeftEdge(0),
-      theRightEdge(0)
+      theRightEdge(0),
+      theCoarseToFineFlag(true)
 {
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("vertex_extractor.coarse_to_fine");
+   if (lookup)
+   {
+      theCoarseToFineFlag = ossimString(lookup).toBool();
+   }
+
    if (inputSource == 0)
    {
       ossimNotify(ossimNotifyLevel_WARN) << "ossimVertexExtractor::ossimVertexExtractor ERROR"
@@ -79,8 +95,14 @@ bool ossimVertexExtractor::execute()
    }
 
    setProcessStatus(ossimProcessInterface::PROCESS_STATUS_EXECUTING);
+
+   bool scanned = theCoarseToFineFlag && scanForEdgesCoarseToFine();
+   if (!scanned)
+   {
+      scanned = scanForEdges();
+   }
    
-   if (scanForEdges())
+   if (scanned)
    {
       if (extractVertices())
       {
@@ -297,6 +319,384 @@ bool ossimVertexExtractor::scanForEdges()
    return true;
 }
 
+//---
+// Coarse to fine edge scan.  Each line of a level is searched only in
+// windows around the edges of the coarser level, a coarser pixel either
+// side.  Window pixels go through the image a band of tile lines at a time.
+//---
+namespace
+{
+   // Least width and height of the coarsest level used, in pixels:
+   const ossim_int32 MIN_COARSE_SIZE = 64;
+
+   // Search windows of one line: the left edge is the first pixel not null
+   // in [left0, left1], the right edge the last one in [right0, right1].
+   // left0 is OSSIM_INT_NAN for lines with nothing to search.
+   struct EdgeWindow
+   {
+      ossim_int32 left0;
+      ossim_int32 left1;
+      ossim_int32 right0;
+      ossim_int32 right1;
+   };
+
+   ossim_int32 floorDiv(ossim_int32 a, ossim_int32 b)
+   {
+      return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+   }
+
+   bool hasData(const ossimImageData* tile)
+   {
+      return tile && (tile->getDataObjectStatus() != OSSIM_NULL) &&
+         (tile->getDataObjectStatus() != OSSIM_EMPTY);
+   }
+
+   // First pixel of line y, from x0 to x1 in either direction, that is not
+   // null.  Returns OSSIM_INT_NAN if none.
+   ossim_int32 findEdge(const ossimImageData* tile, ossim_int32 y,
+                        ossim_int32 x0, ossim_int32 x1)
+   {
+      if (hasData(tile))
+      {
+         const ossim_int32 STEP = (x0 <= x1) ? 1 : -1;
+         for (ossim_int32 x = x0; x != x1 + STEP; x += STEP)
+         {
+            if (!tile->isNull(ossimIpt(x, y)))
+            {
+               return x;
+            }
+         }
+      }
+      return OSSIM_INT_NAN;
+   }
+
+   // Scans lines y0 to y1 of rect at level.  Edges, in pixels of the level,
+   // go to left and right at y - rect.ul().y.  An edge on the outer side of
+   // its window may go further out, so the rest of that line is searched too.
+   void scanLines(ossimImageSource* src, ossim_uint32 level, const ossimIrect& rect,
+                  ossim_int32 y0, ossim_int32 y1, const vector<EdgeWindow>& windows,
+                  vector<ossim_int32>& left, vector<ossim_int32>& right)
+   {
+      const ossim_int32 FIRST = rect.ul().y;
+      ossim_int32 leftMin  = rect.lr().x;
+      ossim_int32 leftMax  = rect.ul().x;
+      ossim_int32 rightMin = rect.lr().x;
+      ossim_int32 rightMax = rect.ul().x;
+      bool any = false;
+      for (ossim_int32 y = y0; y <= y1; ++y)
+      {
+         const EdgeWindow& W = windows[y - FIRST];
+         if (W.left0 != OSSIM_INT_NAN)
+         {
+            leftMin  = std::min(leftMin, W.left0);
+            leftMax  = std::max(leftMax, W.left1);
+            rightMin = std::min(rightMin, W.right0);
+            rightMax = std::max(rightMax, W.right1);
+            any = true;
+         }
+      }
+      if (!any)
+      {
+         return;
+      }
+
+      // One read when the left and right windows meet, else one each:
+      ossimRefPtr<ossimImageData> leftTile;
+      ossimRefPtr<ossimImageData> rightTile;
+      if (rightMin <= leftMax + 1)
+      {
+         leftTile = src->getTile(ossimIrect(leftMin, y0, std::max(leftMax, rightMax), y1), level);
+         rightTile = leftTile;
+      }
+      else
+      {
+         leftTile  = src->getTile(ossimIrect(leftMin, y0, leftMax, y1), level);
+         rightTile = src->getTile(ossimIrect(rightMin, y0, rightMax, y1), level);
+      }
+
+      for (ossim_int32 y = y0; y <= y1; ++y)
+      {
+         const EdgeWindow& W = windows[y - FIRST];
+         if (W.left0 == OSSIM_INT_NAN)
+         {
+            continue;
+         }
+
+         ossim_int32 l = findEdge(leftTile.get(), y, W.left0, W.left1);
+         if ( (l == W.left0) && (l > rect.ul().x) )
+         {
+            ossimRefPtr<ossimImageData> tile =
+               src->getTile(ossimIrect(rect.ul().x, y, l - 1, y), level);
+            ossim_int32 x = findEdge(tile.get(), y, rect.ul().x, l - 1);
+            if (x != OSSIM_INT_NAN)
+            {
+               l = x;
+            }
+         }
+
+         ossim_int32 r = findEdge(rightTile.get(), y, W.right1, W.right0);
+         if ( (r == W.right1) && (r < rect.lr().x) )
+         {
+            ossimRefPtr<ossimImageData> tile =
+               src->getTile(ossimIrect(r + 1, y, rect.lr().x, y), level);
+            ossim_int32 x = findEdge(tile.get(), y, rect.lr().x, r + 1);
+            if (x != OSSIM_INT_NAN)
+            {
+               r = x;
+            }
+         }
+
+         // A line with one edge has the other, look for it over the whole line:
+         if ( (l == OSSIM_INT_NAN) != (r == OSSIM_INT_NAN) )
+         {
+            ossimRefPtr<ossimImageData> tile =
+               src->getTile(ossimIrect(rect.ul().x, y, rect.lr().x, y), level);
+            if (l == OSSIM_INT_NAN)
+            {
+               l = findEdge(tile.get(), y, rect.ul().x, r);
+            }
+            else
+            {
+               r = findEdge(tile.get(), y, rect.lr().x, l);
+            }
+         }
+
+         left[y - FIRST]  = l;
+         right[y - FIRST] = r;
+      }
+   }
+}
+
+bool ossimVertexExtractor::scanForEdgesCoarseToFine()
+{
+   static const char MODULE[] = "ossimVertexExtractor::scanForEdgesCoarseToFine";
+
+   ossimImageSource* src = dynamic_cast<ossimImageSource*>(getInput(0));
+   if (!src || theAreaOfInterest.hasNans())
+   {
+      return false;
+   }
+
+   //---
+   // Levels to scan, full resolution first, with their pixel size in full
+   // resolution pixels.  Each must be a whole multiple of the one before.
+   //---
+   vector<ossim_uint32> levels(1, 0);
+   vector<ossim_int32>  scales(1, 1);
+   const ossim_int32 AOI_SIZE = std::min(theAreaOfInterest.width(), theAreaOfInterest.height());
+   for (ossim_uint32 level = 1; level < src->getNumberOfDecimationLevels(); ++level)
+   {
+      ossimDpt decimation;
+      src->getDecimationFactor(level, decimation);
+      if ( decimation.hasNans() || (decimation.x <= 0.0) || (decimation.x != decimation.y) )
+      {
+         break;
+      }
+      const ossim_int32 SCALE = ossim::round<ossim_int32>(1.0 / decimation.x);
+      if ( (SCALE <= scales.back()) || (SCALE % scales.back()) ||
+           (fabs(SCALE * decimation.x - 1.0) > 1.0e-6) )
+      {
+         continue;
+      }
+      if (AOI_SIZE / SCALE < MIN_COARSE_SIZE)
+      {
+         break;
+      }
+      levels.push_back(level);
+      scales.push_back(SCALE);
+   }
+   if (levels.size() < 2)
+   {
+      return false;
+   }
+
+   if (traceDebug())
+   {
+      CLOG << " coarsest level: " << levels.back()
+           << "  scale: " << scales.back() << endl;
+   }
+
+   //---
+   // Tile reads are not thread safe so each worker needs its own source.
+   // Image handlers are opened again, other sources run on one thread.
+   //---
+   vector< ossimRefPtr<ossimImageSource> > sources(1, src);
+   ossimImageHandler* ih = dynamic_cast<ossimImageHandler*>(src);
+   if (ih)
+   {
+      const ossim_uint32 THREADS = ossim::getNumberOfThreads();
+      for (ossim_uint32 i = 1; i < THREADS; ++i)
+      {
+         ossimRefPtr<ossimImageHandler> worker =
+            ossimImageHandlerRegistry::instance()->open(ih->getFilename());
+         if ( !worker.valid() || !worker->setCurrentEntry(ih->getCurrentEntry()) ||
+              (worker->getNumberOfDecimationLevels() != ih->getNumberOfDecimationLevels()) )
+         {
+            break;
+         }
+         sources.push_back(worker.get());
+      }
+   }
+
+   ossim_int32 band = ossim::max<ossim_int32>(static_cast<ossim_int32>(src->getTileHeight()), 1);
+
+   // For percent complete status, lines of all levels:
+   double totalLines = 0.0;
+   for (ossim_uint32 i = 0; i < scales.size(); ++i)
+   {
+      totalLines += theAreaOfInterest.height() / scales[i] + 1;
+   }
+   std::atomic<ossim_uint32> linesDone(0);
+   const std::thread::id CALLER = std::this_thread::get_id();
+
+   ossimNotify(ossimNotifyLevel_INFO) << "Scanning image source for edges..." << std::endl;
+   setPercentComplete(0.0);
+
+   // Edges of the level done last, absolute, in its pixels:
+   vector<ossim_int32> left;
+   vector<ossim_int32> right;
+   ossimIrect coarseRect;
+
+   for (ossim_uint32 i = static_cast<ossim_uint32>(levels.size()); i-- > 0; )
+   {
+      const ossim_int32 SCALE = scales[i];
+      const ossimIrect RECT(floorDiv(theAreaOfInterest.ul().x, SCALE),
+                            floorDiv(theAreaOfInterest.ul().y, SCALE),
+                            floorDiv(theAreaOfInterest.lr().x, SCALE),
+                            floorDiv(theAreaOfInterest.lr().y, SCALE));
+      const ossim_int32 HEIGHT = RECT.height();
+
+      vector<EdgeWindow> windows(HEIGHT);
+      if (left.empty())
+      {
+         // Coarsest level, whole lines:
+         const EdgeWindow ALL = { RECT.ul().x, RECT.lr().x, RECT.ul().x, RECT.lr().x };
+         std::fill(windows.begin(), windows.end(), ALL);
+      }
+      else
+      {
+         const ossim_int32 RATIO = scales[i + 1] / SCALE;
+         const ossim_int32 COARSE_HEIGHT = coarseRect.height();
+         for (ossim_int32 y = 0; y < HEIGHT; ++y)
+         {
+            const ossim_int32 CY = floorDiv(RECT.ul().y + y, RATIO) - coarseRect.ul().y;
+            ossim_int32 leftMin  = OSSIM_INT_NAN;
+            ossim_int32 leftMax  = OSSIM_INT_NAN;
+            ossim_int32 rightMin = OSSIM_INT_NAN;
+            ossim_int32 rightMax = OSSIM_INT_NAN;
+            for (ossim_int32 c = std::max(CY - 1, 0); c <= std::min(CY + 1, COARSE_HEIGHT - 1); ++c)
+            {
+               if (left[c] == OSSIM_INT_NAN)
+               {
+                  continue;
+               }
+               if (leftMin == OSSIM_INT_NAN)
+               {
+                  leftMin  = leftMax  = left[c];
+                  rightMin = rightMax = right[c];
+               }
+               else
+               {
+                  leftMin  = std::min(leftMin, left[c]);
+                  leftMax  = std::max(leftMax, left[c]);
+                  rightMin = std::min(rightMin, right[c]);
+                  rightMax = std::max(rightMax, right[c]);
+               }
+            }
+
+            EdgeWindow& w = windows[y];
+            if (leftMin == OSSIM_INT_NAN)
+            {
+               w.left0 = w.left1 = w.right0 = w.right1 = OSSIM_INT_NAN;
+            }
+            else
+            {
+               w.left0  = std::max((leftMin - 1) * RATIO, RECT.ul().x);
+               w.left1  = std::min((leftMax + 2) * RATIO - 1, RECT.lr().x);
+               w.right0 = std::max((rightMin - 1) * RATIO, RECT.ul().x);
+               w.right1 = std::min((rightMax + 2) * RATIO - 1, RECT.lr().x);
+            }
+         }
+      }
+
+      vector<ossim_int32> levelLeft(HEIGHT, OSSIM_INT_NAN);
+      vector<ossim_int32> levelRight(HEIGHT, OSSIM_INT_NAN);
+      const ossim_uint32 BANDS = static_cast<ossim_uint32>((HEIGHT + band - 1) / band);
+      std::atomic<ossim_uint32> next(0);
+      const ossim_uint32 LEVEL = levels[i];
+
+      std::vector<std::exception_ptr> errors(sources.size());
+      ossim::parallelFor(static_cast<ossim_uint32>(sources.size()), 0,
+                         [&](ossim_uint32 worker)
+      {
+         try
+         {
+            for (ossim_uint32 b = next++; b < BANDS; b = next++)
+            {
+               const ossim_int32 Y0 = RECT.ul().y + static_cast<ossim_int32>(b) * band;
+               const ossim_int32 Y1 = std::min(Y0 + band - 1, RECT.lr().y);
+               scanLines(sources[worker].get(), LEVEL, RECT, Y0, Y1, windows,
+                         levelLeft, levelRight);
+
+               linesDone += static_cast<ossim_uint32>(Y1 - Y0 + 1);
+               if (std::this_thread::get_id() == CALLER)
+               {
+                  setPercentComplete(linesDone / totalLines * 100.0);
+               }
+            }
+         }
+         catch (...)
+         {
+            errors[worker] = std::current_exception();
+            next = BANDS; // Stops the other workers.
+         }
+      });
+      for (ossim_uint32 worker = 0; worker < errors.size(); ++worker)
+      {
+         if (errors[worker])
+            std::rethrow_exception(errors[worker]);
+      }
+
+      left.swap(levelLeft);
+      right.swap(levelRight);
+      coarseRect = RECT;
+   }
+
+   // Full resolution edges relative to the area of interest, as scanForEdges leaves them:
+   theLeftEdge.resize(left.size());
+   theRightEdge.resize(right.size());
+   for (ossim_uint32 i = 0; i < left.size(); ++i)
+   {
+      if (left[i] == OSSIM_INT_NAN)
+      {
+         theLeftEdge[i]  = OSSIM_INT_NAN;
+         theRightEdge[i] = OSSIM_INT_NAN;
+      }
+      else
+      {
+         theLeftEdge[i]  = left[i]  - theAreaOfInterest.ul().x;
+         theRightEdge[i] = right[i] - theAreaOfInterest.ul().x;
+      }
+   }
+
+   setPercentComplete(100.0);
+
+   if (traceDebug())
+   {
+      CLOG << "DEBUG:" << endl;
+      for (ossim_uint32 i = 0; i < theLeftEdge.size(); ++i)
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG) << "DEBUG: left[" << i << "]:  "
+                                             << theLeftEdge[i]
+                                             << " right[" << i << "]:  "
+                                             << theRightEdge[i]
+                                             << std::endl;
+      }
+   }
+
+   return true;
+}
+
 bool ossimVertexExtractor::extractVertices()
 {
    //***
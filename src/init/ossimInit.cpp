@@ -35,6 +35,7 @@
 #include <ossim/base/ossimObjectFactoryRegistry.h>
 #include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimStreamFactoryRegistry.h>
+#include <ossim/base/ossimTileBufferPool.h>
 #include <ossim/base/ossimTrace.h>
 #include <ossim/base/ossimTraceManager.h>
 #include <ossim/base/ossimGeoidEgm96.h>
@@ -73,6 +74,7 @@ using namespace std;
 
 static ossimTrace traceExec = ossimTrace("ossimInit:exec");
 static ossimTrace traceDebug = ossimTrace("ossimInit:debug");
+static ossimTrace tracePool = ossimTrace("ossimTileBufferPool:debug");
 
 extern "C"
 {
@@ -267,6 +269,10 @@ void ossimInit::initialize()
 
 void ossimInit::finalize()
 {
+   if (tracePool())
+   {
+      ossimTileBufferPool::instance()->print(ossimNotify(ossimNotifyLevel_DEBUG));
+   }
    finishGEOS();
 }
 /*!****************************************************************************
@@ -0,0 +1,257 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+//**************************************************************************************************
+
+#include <ossim/parallel/ossimParallelChipRenderer.h>
+#include <ossim/parallel/ossimParallelFor.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimKeywordNames.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTrace.h>
+#include <ossim/base/ossimVisitor.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+#include <ossim/imaging/ossimImageSource.h>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <string>
+
+static ossimTrace traceDebug("ossimParallelChipRenderer:debug");
+
+static const ossim_int32 DEFAULT_TILE_SIZE = 512;
+
+namespace
+{
+   // The "type" keywords of a saved state, i.e. the class of every object and sub-object.
+   // An object the factories could not make shows up as one missing:
+   std::map<std::string, std::string> typesOf(const ossimKeywordlist& state)
+   {
+      std::map<std::string, std::string> result;
+      const std::string TYPE = ossimKeywordNames::TYPE_KW;
+      for (const auto& entry : state.getMap())
+      {
+         const std::string& key = entry.first;
+         if ( (key.size() >= TYPE.size()) &&
+              !key.compare(key.size() - TYPE.size(), TYPE.size(), TYPE) )
+         {
+            result.insert(entry);
+         }
+      }
+      return result;
+   }
+}
+
+ossimParallelChipRenderer::ossimParallelChipRenderer()
+   : m_numThreads(0),
+     m_defaultThreads(1),
+     m_tileSize(DEFAULT_TILE_SIZE, DEFAULT_TILE_SIZE),
+     m_source(0),
+     m_sourceState(),
+     m_containers(),
+     m_clones()
+{
+   // Chips render on the calling thread unless asked, callers often run several at once:
+   const char* lookup = ossimPreferences::instance()->findPreference("chip.threads");
+   if (lookup)
+   {
+      m_defaultThreads = ossimString(lookup).toUInt32();
+      if (!m_defaultThreads)
+         m_defaultThreads = ossim::getNumberOfThreads();
+   }
+   lookup = ossimPreferences::instance()->findPreference("chip.tile_size");
+   if (lookup)
+   {
+      setTileSize( ossimIpt(ossimString(lookup).toInt32(), ossimString(lookup).toInt32()) );
+   }
+}
+
+ossimParallelChipRenderer::~ossimParallelChipRenderer()
+{
+   clear();
+}
+
+void ossimParallelChipRenderer::setNumberOfThreads(ossim_uint32 numThreads)
+{
+   m_numThreads = numThreads;
+}
+
+ossim_uint32 ossimParallelChipRenderer::getNumberOfThreads() const
+{
+   return m_numThreads ? m_numThreads : m_defaultThreads;
+}
+
+void ossimParallelChipRenderer::setTileSize(const ossimIpt& tileSize)
+{
+   // Anything smaller costs more in per tile setup down the chain than it gains:
+   m_tileSize.x = ossim::max<ossim_int32>(tileSize.x, 64);
+   m_tileSize.y = ossim::max<ossim_int32>(tileSize.y, 64);
+}
+
+void ossimParallelChipRenderer::clear()
+{
+   m_clones.clear();
+   m_containers.clear();
+   m_sourceState.clear();
+   m_source = 0;
+}
+
+ossimRefPtr<ossimImageData> ossimParallelChipRenderer::getChip(ossimImageSource* source,
+                                                               const ossimIrect& rect,
+                                                               ossim_uint32 resLevel)
+{
+   if (!source)
+      return 0;
+
+   const ossim_uint32 TILES_X = (rect.width()  + m_tileSize.x - 1) / m_tileSize.x;
+   const ossim_uint32 TILES_Y = (rect.height() + m_tileSize.y - 1) / m_tileSize.y;
+   const ossim_uint32 TILES   = TILES_X * TILES_Y;
+   const ossim_uint32 WORKERS = ossim::min<ossim_uint32>(getNumberOfThreads(), TILES);
+
+   // The calling thread renders on the source itself, the others on a clone each:
+   if ( (WORKERS <= 1) || rect.hasNans() || !cloneSource(source, resLevel, WORKERS - 1) )
+      return source->getTile(rect, resLevel);
+
+   ossimRefPtr<ossimImageData> chip = ossimImageDataFactory::instance()->create(0, source);
+   if (!chip.valid())
+      return source->getTile(rect, resLevel);
+   chip->setImageRectangle(rect);
+   chip->initialize();
+
+   std::atomic<ossim_uint32> next(0);
+   std::atomic<bool> failed(false);
+   ossim::parallelFor(WORKERS, WORKERS, [&](ossim_uint32 worker)
+   {
+      ossimImageSource* input = worker ? m_clones[worker - 1] : source;
+      for (ossim_uint32 i = next++; (i < TILES) && !failed; i = next++)
+      {
+         const ossim_int32 X = rect.ul().x + static_cast<ossim_int32>(i % TILES_X) * m_tileSize.x;
+         const ossim_int32 Y = rect.ul().y + static_cast<ossim_int32>(i / TILES_X) * m_tileSize.y;
+         ossimIrect tileRect(X, Y,
+                             ossim::min<ossim_int32>(X + m_tileSize.x - 1, rect.lr().x),
+                             ossim::min<ossim_int32>(Y + m_tileSize.y - 1, rect.lr().y));
+         try
+         {
+            ossimRefPtr<ossimImageData> tile = input->getTile(tileRect, resLevel);
+            if ( tile.valid() && (tile->getDataObjectStatus() != OSSIM_NULL) &&
+                 (tile->getDataObjectStatus() != OSSIM_EMPTY) )
+            {
+               if ( !copyTile(tile.get(), chip.get()) )
+                  failed = true;
+            }
+         }
+         catch (const std::exception& e)
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << "ossimParallelChipRenderer::getChip caught exception: " << e.what() << std::endl;
+            failed = true;
+         }
+         catch (...)
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << "ossimParallelChipRenderer::getChip caught unknown exception." << std::endl;
+            failed = true;
+         }
+      }
+   });
+
+   if (failed)
+   {
+      // Whatever went wrong in a clone, the source itself has the last word:
+      clear();
+      return source->getTile(rect, resLevel);
+   }
+
+   chip->validate();
+   return chip;
+}
+
+bool ossimParallelChipRenderer::cloneSource(ossimImageSource* source,
+                                            ossim_uint32 resLevel,
+                                            ossim_uint32 count)
+{
+   ossimKeywordlist state;
+   source->saveStateOfAllInputs(state, true, 0, 0);
+
+   if ( (source != m_source) || (state.getMap() != m_sourceState.getMap()) )
+   {
+      clear();
+      m_source = source;
+      m_sourceState.getMap() = state.getMap();
+   }
+
+   const std::map<std::string, std::string> TYPES = typesOf(m_sourceState);
+   while (m_clones.size() < count)
+   {
+      ossimRefPtr<ossimConnectableContainer> container = new ossimConnectableContainer;
+      container->loadState(m_sourceState);
+
+      ossimIdVisitor visitor( source->getId(),
+                              (ossimVisitor::VISIT_CHILDREN|ossimVisitor::VISIT_INPUTS) );
+      container->accept(visitor);
+      ossimImageSource* clone = dynamic_cast<ossimImageSource*>(visitor.getObject());
+      ossimKeywordlist cloneState;
+      if (clone)
+      {
+         clone->saveStateOfAllInputs(cloneState, true, 0, 0);
+      }
+
+      // A source with objects the factories cannot make, or holding state it does not save
+      // (memory images, histograms worked out on the fly...) must not be rendered from a clone:
+      if ( !clone || (typesOf(cloneState) != TYPES) ||
+           (clone->getBoundingRect(resLevel) != source->getBoundingRect(resLevel)) ||
+           (clone->getNumberOfOutputBands() != source->getNumberOfOutputBands()) ||
+           (clone->getOutputScalarType() != source->getOutputScalarType()) )
+      {
+         if (traceDebug())
+         {
+            ossimNotify(ossimNotifyLevel_DEBUG)
+               << "ossimParallelChipRenderer::cloneSource: Could not clone "
+               << source->getClassName() << ", rendering on one thread." << std::endl;
+         }
+         clear();
+         return false;
+      }
+
+      m_containers.push_back(container);
+      m_clones.push_back(clone);
+   }
+
+   return true;
+}
+
+bool ossimParallelChipRenderer::copyTile(const ossimImageData* tile, ossimImageData* chip) const
+{
+   if ( !tile->getBuf() || (tile->getScalarType() != chip->getScalarType()) ||
+        (tile->getNumberOfBands() != chip->getNumberOfBands()) )
+      return false;
+
+   const ossimIrect TILE_RECT = tile->getImageRectangle();
+   const ossimIrect CHIP_RECT = chip->getImageRectangle();
+   if ( !TILE_RECT.intersects(CHIP_RECT) )
+      return true;
+   const ossimIrect CLIP = TILE_RECT.clipToRect(CHIP_RECT);
+
+   // Each sub-tile lands on its own rows and columns of the chip, so workers never meet here:
+   const ossim_uint32 PIXEL_BYTES = ossim::scalarSizeInBytes(chip->getScalarType());
+   const ossim_uint32 ROW_BYTES   = CLIP.width() * PIXEL_BYTES;
+   for (ossim_uint32 band = 0; band < chip->getNumberOfBands(); ++band)
+   {
+      const ossim_uint8* s = static_cast<const ossim_uint8*>(tile->getBuf(band));
+      ossim_uint8* d = static_cast<ossim_uint8*>(chip->getBuf(band));
+      for (ossim_int32 y = CLIP.ul().y; y <= CLIP.lr().y; ++y)
+      {
+         memcpy( d + ( (y - CHIP_RECT.ul().y) * CHIP_RECT.width() +
+                       (CLIP.ul().x - CHIP_RECT.ul().x) ) * PIXEL_BYTES,
+                 s + ( (y - TILE_RECT.ul().y) * TILE_RECT.width() +
+                       (CLIP.ul().x - TILE_RECT.ul().x) ) * PIXEL_BYTES,
+                 ROW_BYTES );
+      }
+   }
+   return true;
+}
@@ -0,0 +1,184 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+//**************************************************************************************************
+
+#include <ossim/parallel/ossimParallelChipSequencer.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/base/ossimTrace.h>
+#include <ossim/imaging/ossimImageDataFactory.h>
+
+static ossimTrace traceDebug("ossimParallelChipSequencer:debug");
+
+// Sub-tiles of the renderer per thread in a strip, so threads finishing early have more to take:
+static const ossim_uint32 SUB_TILES_PER_THREAD = 2;
+
+// Single thread cost of a sub-tile below which adaptive threads go down to one:
+static const double MIN_SUB_TILE_SECONDS = 0.002;
+
+ossimParallelChipSequencer::ossimParallelChipSequencer(ossimParallelChipRenderer* renderer,
+                                                       ossimImageSource* inputSource,
+                                                       ossimObject* owner)
+   : ossimImageSourceSequencer(inputSource, owner),
+     m_renderer(renderer),
+     m_rowsPerStrip(0),
+     m_strip(0),
+     m_stripFirstRow(-1),
+     m_stripRows(0),
+     m_tile(0),
+     m_adaptive(false),
+     m_threads(0),
+     m_stripsRendered(0),
+     m_renderSeconds(0.0)
+{
+}
+
+ossimParallelChipSequencer::~ossimParallelChipSequencer()
+{
+}
+
+void ossimParallelChipSequencer::setToStartOfSequence()
+{
+   ossimImageSourceSequencer::setToStartOfSequence();
+   m_strip = 0;
+   m_stripFirstRow = -1;
+   m_stripRows = 0;
+   m_threads = 0;
+   m_stripsRendered = 0;
+   m_renderSeconds = 0.0;
+}
+
+void ossimParallelChipSequencer::setRowsPerStrip(ossim_uint32 rows)
+{
+   m_rowsPerStrip = rows;
+}
+
+void ossimParallelChipSequencer::setAdaptiveThreads(bool adaptive)
+{
+   m_adaptive = adaptive;
+}
+
+ossim_uint32 ossimParallelChipSequencer::getNumberOfThreads() const
+{
+   if (m_threads)
+      return m_threads;
+   return m_renderer ? m_renderer->getNumberOfThreads() : 1;
+}
+
+ossim_uint32 ossimParallelChipSequencer::getRowsPerStrip() const
+{
+   if (m_rowsPerStrip)
+      return m_rowsPerStrip;
+
+   const ossim_int64 ROW_PIXELS = static_cast<ossim_int64>(theAreaOfInterest.width()) *
+                                  theTileSize.y;
+   if (!m_renderer || (ROW_PIXELS <= 0))
+      return 1;
+
+   const ossimIpt SUB_TILE = m_renderer->getTileSize();
+   const ossim_int64 STRIP_PIXELS = static_cast<ossim_int64>(SUB_TILE.x) * SUB_TILE.y *
+      getNumberOfThreads() * SUB_TILES_PER_THREAD;
+   return static_cast<ossim_uint32>( ossim::max<ossim_int64>(
+      (STRIP_PIXELS + ROW_PIXELS - 1) / ROW_PIXELS, 1) );
+}
+
+ossimRefPtr<ossimImageData> ossimParallelChipSequencer::getNextTile(ossim_uint32 resLevel)
+{
+   if (!m_renderer)
+      return ossimImageSourceSequencer::getNextTile(resLevel);
+
+   ossimRefPtr<ossimImageData> result = 0;
+   ossimIrect tileRect;
+   if ( !theInputConnection || (theNumberOfTilesHorizontal <= 0) ||
+        !getTileRect(theCurrentTileNumber, tileRect) )
+      return result;
+
+   const ossim_int64 ROW = theCurrentTileNumber / theNumberOfTilesHorizontal;
+   ++theCurrentTileNumber;
+   if ( (m_stripFirstRow < 0) || (ROW < m_stripFirstRow) ||
+        (ROW >= m_stripFirstRow + m_stripRows) )
+   {
+      renderStrip(ROW, resLevel);
+   }
+
+   if ( !m_strip.valid() )
+   {
+      theBlankTile->setImageRectangle(tileRect);
+      return theBlankTile;
+   }
+
+   // Made like the strip, from the input, so the two agree on null, min and max:
+   if ( !m_tile.valid() || (m_tile->getScalarType() != m_strip->getScalarType()) ||
+        (m_tile->getNumberOfBands() != m_strip->getNumberOfBands()) )
+   {
+      m_tile = ossimImageDataFactory::instance()->create(this, theInputConnection);
+   }
+   m_tile->setImageRectangle(tileRect);
+   m_tile->initialize();
+   m_tile->loadTile(m_strip.get());
+   m_tile->validate();
+   result = m_tile;
+   return result;
+}
+
+void ossimParallelChipSequencer::renderStrip(ossim_int64 tileRow, ossim_uint32 resLevel)
+{
+   m_strip = 0;
+   m_stripFirstRow = tileRow;
+   m_stripRows = ossim::min<ossim_int64>(getRowsPerStrip(), theNumberOfTilesVertical - tileRow);
+
+   ossimIrect first;
+   ossimIrect last;
+   if ( (m_stripRows <= 0) ||
+        !getTileRect(tileRow * theNumberOfTilesHorizontal, first) ||
+        !getTileRect((tileRow + m_stripRows) * theNumberOfTilesHorizontal - 1, last) )
+      return;
+
+   const ossimIrect STRIP_RECT(first.ul(), last.lr());
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimParallelChipSequencer::renderStrip: rows " << tileRow << " to "
+         << tileRow + m_stripRows - 1 << ", rect " << STRIP_RECT << std::endl;
+   }
+
+   ossimTimer* timer = ossimTimer::instance();
+   const ossimTimer::Timer_t T0 = timer->tick();
+   ossimRefPtr<ossimImageData> strip;
+   if (m_threads == 1)
+      strip = theInputConnection->getTile(STRIP_RECT, resLevel);
+   else
+      strip = m_renderer->getChip(theInputConnection, STRIP_RECT, resLevel);
+   const double SECONDS = timer->delta_s(T0, timer->tick());
+   m_renderSeconds += SECONDS;
+   if ( (++m_stripsRendered == 2) && m_adaptive && !m_threads )
+      adaptThreads(SECONDS, STRIP_RECT);
+
+   if ( strip.valid() && strip->getBuf() && (strip->getDataObjectStatus() != OSSIM_NULL) &&
+        (strip->getDataObjectStatus() != OSSIM_EMPTY) )
+   {
+      m_strip = strip;
+   }
+}
+
+void ossimParallelChipSequencer::adaptThreads(double seconds, const ossimIrect& stripRect)
+{
+   // Seconds of one thread a sub-tile, as if the threads had run flat out:
+   const ossim_uint32 THREADS = getNumberOfThreads();
+   const ossimIpt SUB_TILE = m_renderer->getTileSize();
+   const double SUB_TILES = static_cast<double>(stripRect.width()) * stripRect.height() /
+                            (static_cast<double>(SUB_TILE.x) * SUB_TILE.y);
+   const double SUB_TILE_SECONDS = (SUB_TILES > 0.0) ? seconds * THREADS / SUB_TILES : 0.0;
+
+   m_threads = (SUB_TILE_SECONDS < MIN_SUB_TILE_SECONDS) ? 1 : THREADS;
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG)
+         << "ossimParallelChipSequencer::adaptThreads: " << SUB_TILE_SECONDS
+         << " s a sub-tile, " << m_threads << " thread(s)" << std::endl;
+   }
+}
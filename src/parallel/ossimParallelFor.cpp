@@ -0,0 +1,52 @@
+//**************************************************************************************************
+//                          OSSIM -- Open Source Software Image Map
+//
+// LICENSE: See top level LICENSE.txt file.
+//
+//**************************************************************************************************
+
+#include <ossim/parallel/ossimParallelFor.h>
+#include <ossim/base/ossimCommon.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+void ossim::parallelFor(ossim_uint32 count,
+                        ossim_uint32 numThreads,
+                        const std::function<void(ossim_uint32)>& body)
+{
+   if ( count == 0 )
+      return;
+
+   if ( numThreads == 0 )
+      numThreads = ossim::getNumberOfThreads();
+   if ( numThreads > count )
+      numThreads = count;
+
+   if ( numThreads <= 1 )
+   {
+      for ( ossim_uint32 i = 0; i < count; ++i )
+         body(i);
+      return;
+   }
+
+   std::atomic<ossim_uint32> next(0);
+   auto worker = [&next, count, &body]()
+   {
+      ossim_uint32 i = next++;
+      while ( i < count )
+      {
+         body(i);
+         i = next++;
+      }
+   };
+
+   // Calling thread is one of the workers:
+   std::vector<std::thread> threads;
+   threads.reserve(numThreads - 1);
+   for ( ossim_uint32 t = 1; t < numThreads; ++t )
+      threads.push_back( std::thread(worker) );
+   worker();
+   for ( std::vector<std::thread>::iterator i = threads.begin(); i != threads.end(); ++i )
+      i->join();
+}
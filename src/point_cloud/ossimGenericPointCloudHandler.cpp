@@ -44,16 +44,20 @@ ossim_uint32 ossimGenericPointCloudHandler::getNumPoints() const
 
 void ossimGenericPointCloudHandler::getFileBlock(ossim_uint32 offset,
                                                  ossimPointBlock& block,
-                                                 ossim_uint32 /* maxNumPoints */) const
+                                                 ossim_uint32 maxNumPoints) const
 {
    block.clear();
    if (offset >= m_pointBlock.size())
       return;
 
-   for (ossim_uint32 i=offset; i<m_pointBlock.size(); ++i)
+   ossim_uint32 end = m_pointBlock.size();
+   if (maxNumPoints < end - offset)
+      end = offset + maxNumPoints;
+
+   for (ossim_uint32 i=offset; i<end; ++i)
       block.addPoint(new ossimPointRecord(*(m_pointBlock[i])));
 
-   m_currentPID = block.size();
+   m_currentPID = end;
 }
 
 ossim_uint32 ossimGenericPointCloudHandler::getFieldCode() const 
@@ -0,0 +1,442 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/point_cloud/ossimLasGridder.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimEndian.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/parallel/ossimParallelFor.h>
+#include <ossim/support_data/ossimLasHdr.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+// Default is 256 megabytes, a 3600 x 3600 raster at 20 bytes per cell.
+static const ossim_uint64 DEFAULT_MEMORY_LIMIT = 256 * 1024 * 1024;
+
+// lowest + highest + sum + count
+static const ossim_uint64 BYTES_PER_CELL = 4 + 4 + 8 + 4;
+
+// X, Y and Z are the first three fields of every point data format.
+static const ossim_uint32 MIN_RECORD_LENGTH = 12;
+
+// Fraction of a pixel beyond the grid edges still taken as on the edge.
+static const ossim_float64 EDGE = 1.0e-6;
+
+ossimLasGridder::ossimLasGridder()
+   :
+   m_str(),
+   m_hdr(0),
+   m_recordLength(0),
+   m_ulCorner(),
+   m_gsd(),
+   m_width(0),
+   m_height(0),
+   m_unitScale(1.0),
+   m_numThreads(0),
+   m_memoryLimit(DEFAULT_MEMORY_LIMIT),
+   m_stripStart(0),
+   m_stripLines(0),
+   m_tilesAcross(0),
+   m_lowest(),
+   m_highest(),
+   m_sum(),
+   m_count(),
+   m_bins()
+{
+   m_ulCorner.makeNan();
+   m_gsd.makeNan();
+
+   const char* lookup =
+      ossimPreferences::instance()->findPreference("las.gridder_memory_limit");
+   if ( lookup )
+   {
+      ossim_uint64 mb = ossimString(lookup).toUInt64();
+      if ( mb )
+      {
+         m_memoryLimit = mb * 1024 * 1024;
+      }
+   }
+}
+
+ossimLasGridder::~ossimLasGridder()
+{
+   close();
+}
+
+bool ossimLasGridder::open(const ossimFilename& lasFile)
+{
+   close();
+
+   m_str.open(lasFile.c_str(), std::ios_base::in | std::ios_base::binary);
+   if ( m_str.good() )
+   {
+      m_hdr = new ossimLasHdr();
+      if ( m_hdr->checkSignature( m_str ) )
+      {
+         m_str.seekg(0, std::ios_base::beg);
+         m_hdr->readStream(m_str);
+         m_recordLength = m_hdr->getPointDataRecordLength();
+         if ( m_str.good() && ( m_hdr->getPointDataFormatId() <= 10 ) &&
+              ( m_recordLength >= MIN_RECORD_LENGTH ) )
+         {
+            return true;
+         }
+      }
+   }
+
+   close();
+   return false;
+}
+
+void ossimLasGridder::close()
+{
+   if ( m_str.is_open() )
+   {
+      m_str.close();
+   }
+   m_str.clear();
+   delete m_hdr;
+   m_hdr = 0;
+   m_recordLength = 0;
+   m_stripLines = 0;
+}
+
+void ossimLasGridder::setGrid(const ossimDpt& ulCorner,
+                              const ossimDpt& gsd,
+                              ossim_uint32 width,
+                              ossim_uint32 height,
+                              ossim_float64 unitScale)
+{
+   m_ulCorner  = ulCorner;
+   m_gsd       = gsd;
+   m_width     = width;
+   m_height    = height;
+   m_unitScale = unitScale;
+
+   // Invalidate the current strip and release it:
+   m_stripLines = 0;
+   m_tilesAcross = (m_width + TILE_DIM - 1) / TILE_DIM;
+   std::vector<ossim_float32>().swap(m_lowest);
+   std::vector<ossim_float32>().swap(m_highest);
+   std::vector<ossim_float64>().swap(m_sum);
+   std::vector<ossim_uint32>().swap(m_count);
+}
+
+void ossimLasGridder::setNumberOfThreads(ossim_uint32 nThreads)
+{
+   m_numThreads = nThreads;
+}
+
+void ossimLasGridder::setMemoryLimit(ossim_uint64 bytes)
+{
+   m_memoryLimit = bytes;
+}
+
+bool ossimLasGridder::getValues(const ossimIrect& rect,
+                                Statistic stat,
+                                ossim_float32* buf,
+                                ossim_float32 nullValue)
+{
+   if ( !m_hdr || !buf || !m_width || !m_height )
+   {
+      return false;
+   }
+
+   const ossim_int32 W = static_cast<ossim_int32>(rect.width());
+   const ossim_int32 H = static_cast<ossim_int32>(rect.height());
+   const ossim_int32 X0 = rect.ul().x;
+   const ossim_int32 Y0 = rect.ul().y;
+   const ossim_uint32 STRIP_LINES = getStripLines( static_cast<ossim_uint32>( H ) );
+
+   for ( ossim_int32 row = 0; row < H; ++row )
+   {
+      ossim_float32* out = buf + (ossim_int64) row * W;
+      const ossim_int32 line = Y0 + row;
+      if ( ( line < 0 ) || ( line >= (ossim_int32) m_height ) )
+      {
+         std::fill(out, out + W, nullValue);
+         continue;
+      }
+
+      if ( !m_stripLines || ( (ossim_uint32) line < m_stripStart ) ||
+           ( (ossim_uint32) line >= m_stripStart + m_stripLines ) )
+      {
+         // Strips are aligned so walking down the image streams the file once per strip. A
+         // request straddling the aligned strip gets one starting at its line instead, so the
+         // rest of the request is covered by the same pass:
+         ossim_uint32 start = ( line / STRIP_LINES ) * STRIP_LINES;
+         const ossim_uint32 LAST = std::min<ossim_uint32>( Y0 + H, m_height );
+         if ( start + STRIP_LINES < LAST )
+         {
+            start = line;
+         }
+         if ( !accumulate( start, std::min( STRIP_LINES, m_height - start ) ) )
+         {
+            return false;
+         }
+      }
+
+      const ossim_uint32 localLine = line - m_stripStart;
+      for ( ossim_int32 col = 0; col < W; ++col )
+      {
+         const ossim_int32 samp = X0 + col;
+         if ( ( samp < 0 ) || ( samp >= (ossim_int32) m_width ) )
+         {
+            out[col] = nullValue;
+            continue;
+         }
+
+         const ossim_uint64 i = cellIndex( localLine, samp );
+         const ossim_uint32 count = m_count[i];
+         if ( !count )
+         {
+            out[col] = ( stat == COUNT ) ? 0 : nullValue;
+            continue;
+         }
+
+         switch ( stat )
+         {
+            case LOWEST:
+               out[col] = m_lowest[i];
+               break;
+            case HIGHEST:
+               out[col] = m_highest[i];
+               break;
+            case MEAN:
+               out[col] = static_cast<ossim_float32>( m_sum[i] / count );
+               break;
+            default: // COUNT
+               out[col] = static_cast<ossim_float32>( count );
+               break;
+         }
+      }
+   }
+
+   return true;
+}
+
+bool ossimLasGridder::accumulate(ossim_uint32 startLine, ossim_uint32 numLines)
+{
+   if ( !m_hdr || !m_width || !numLines || ( startLine >= m_height ) ||
+        m_gsd.hasNans() || m_ulCorner.hasNans() || !m_gsd.x || !m_gsd.y )
+   {
+      return false;
+   }
+
+   allocateStrip( startLine, std::min( numLines, m_height - startLine ) );
+
+   // Number of records actually in the file guards against a bad or zero header count:
+   m_str.clear();
+   m_str.seekg(0, std::ios_base::end);
+   const ossim_uint64 FILE_SIZE = static_cast<ossim_uint64>( m_str.tellg() );
+   const ossim_uint64 OFFSET = m_hdr->getOffsetToPointData();
+   ossim_uint64 numPoints = ( FILE_SIZE > OFFSET ) ? ( FILE_SIZE - OFFSET ) / m_recordLength : 0;
+   if ( m_hdr->getNumberOfPoints() && ( m_hdr->getNumberOfPoints() < numPoints ) )
+   {
+      numPoints = m_hdr->getNumberOfPoints();
+   }
+
+   const ossim_uint32 SLICES = m_numThreads ? m_numThreads : ossim::getNumberOfThreads();
+   const ossim_uint32 NUM_SLICES = std::max<ossim_uint32>( SLICES, 1 );
+   m_bins.resize( NUM_SLICES * NUM_SLICES );
+
+   //---
+   // Double buffered: the next block is read on a second thread while the current one is binned.
+   //---
+   std::vector<char> blocks[2];
+   int current = 0;
+   ossim_uint64 nextPoint = 0;
+   ossim_uint64 got = ( numPoints ) ? readBlock( blocks[current], 0, numPoints ) : 0;
+   nextPoint += got;
+
+   while ( got )
+   {
+      std::thread reader;
+      ossim_uint64 nextGot = 0;
+      if ( nextPoint < numPoints )
+      {
+         const ossim_uint64 FIRST = nextPoint;
+         std::vector<char>& nextBlock = blocks[1 - current];
+         reader = std::thread( [this, FIRST, numPoints, &nextBlock, &nextGot]()
+         {
+            nextGot = readBlock( nextBlock, FIRST, numPoints - FIRST );
+         } );
+      }
+
+      // Bin the slices, each into per owner lists:
+      const char* records = &blocks[current].front();
+      const ossim_uint64 COUNT = got;
+      ossim::parallelFor( NUM_SLICES, NUM_SLICES, [this, records, COUNT, NUM_SLICES](ossim_uint32 s)
+      {
+         const ossim_uint64 BEGIN = COUNT * s / NUM_SLICES;
+         const ossim_uint64 END = COUNT * ( s + 1 ) / NUM_SLICES;
+         binSlice( records + BEGIN * m_recordLength, END - BEGIN,
+                   &m_bins[s * NUM_SLICES], NUM_SLICES );
+      } );
+
+      // Each owner merges what every slice binned for its tiles:
+      ossim::parallelFor( NUM_SLICES, NUM_SLICES, [this, NUM_SLICES](ossim_uint32 owner)
+      {
+         mergeOwner( owner, NUM_SLICES );
+      } );
+
+      if ( reader.joinable() )
+      {
+         reader.join();
+      }
+      current = 1 - current;
+      got = nextGot;
+      nextPoint += got;
+   }
+
+   // Release the bins, they can be as large as a block:
+   std::vector< std::vector<BinnedPoint> >().swap( m_bins );
+
+   return !m_str.bad();
+}
+
+ossim_uint32 ossimLasGridder::getStripLines(ossim_uint32 requestLines) const
+{
+   // Strips are whole multiples of the request height, at least one request even past the
+   // memory limit, so walking down in requests of that height never scans twice for one:
+   const ossim_uint64 UNIT =
+      ( ( (ossim_uint64) std::max<ossim_uint32>( requestLines, 1 ) + TILE_DIM - 1 ) / TILE_DIM ) *
+      TILE_DIM;
+   const ossim_uint64 LINE_BYTES = (ossim_uint64) m_tilesAcross * TILE_DIM * BYTES_PER_CELL;
+   ossim_uint64 lines = LINE_BYTES ? ( m_memoryLimit / LINE_BYTES ) : UNIT;
+   lines = ( lines / UNIT ) * UNIT;
+   if ( lines < UNIT )
+   {
+      lines = UNIT;
+   }
+   const ossim_uint64 ALL_LINES = ( ( (ossim_uint64) m_height + TILE_DIM - 1 ) / TILE_DIM ) * TILE_DIM;
+
+   // Binned points address cells with 32 bits:
+   const ossim_uint64 LINE_CELLS = (ossim_uint64) m_tilesAcross * TILE_DIM;
+   const ossim_uint64 MAX_LINES = LINE_CELLS ?
+      ( ( std::numeric_limits<ossim_uint32>::max() / LINE_CELLS ) / TILE_DIM ) * TILE_DIM :
+      (ossim_uint64) TILE_DIM;
+   if ( lines > MAX_LINES )
+   {
+      lines = ( MAX_LINES >= UNIT ) ? ( MAX_LINES / UNIT ) * UNIT :
+                                      std::max<ossim_uint64>( MAX_LINES, TILE_DIM );
+   }
+   return static_cast<ossim_uint32>( std::min( lines, ALL_LINES ) );
+}
+
+void ossimLasGridder::allocateStrip(ossim_uint32 startLine, ossim_uint32 numLines)
+{
+   m_stripStart = startLine;
+   m_stripLines = numLines;
+
+   const ossim_uint64 TILES_DOWN = ( numLines + TILE_DIM - 1 ) / TILE_DIM;
+   const ossim_uint64 CELLS = TILES_DOWN * m_tilesAcross * TILE_CELLS;
+
+   m_lowest.assign( CELLS, std::numeric_limits<ossim_float32>::max() );
+   m_highest.assign( CELLS, -std::numeric_limits<ossim_float32>::max() );
+   m_sum.assign( CELLS, 0.0 );
+   m_count.assign( CELLS, 0 );
+}
+
+ossim_uint64 ossimLasGridder::readBlock(std::vector<char>& block,
+                                        ossim_uint64 firstPoint,
+                                        ossim_uint64 maxPoints)
+{
+   // Only called from one thread at a time; the stream belongs to the reader.
+   const ossim_uint64 OFFSET = m_hdr->getOffsetToPointData() + firstPoint * m_recordLength;
+   const ossim_uint64 POINTS = std::min<ossim_uint64>( maxPoints, BLOCK_POINTS );
+   block.resize( (std::size_t) ( POINTS * m_recordLength ) );
+
+   m_str.clear();
+   m_str.seekg( OFFSET, std::ios_base::beg );
+   m_str.read( &block.front(), block.size() );
+   return static_cast<ossim_uint64>( m_str.gcount() ) / m_recordLength;
+}
+
+void ossimLasGridder::binSlice(const char* records,
+                               ossim_uint64 count,
+                               std::vector<BinnedPoint>* bins,
+                               ossim_uint32 numOwners) const
+{
+   const ossim_uint32 OWNERS = numOwners;
+   for ( ossim_uint32 o = 0; o < OWNERS; ++o )
+   {
+      bins[o].clear();
+   }
+
+   //---
+   // Fold scale, offset, unit conversion and grid origin into one multiply add per axis:
+   //    samp = X * AX + BX
+   //    line = Y * AY + BY
+   //---
+   const ossim_float64 AX = m_hdr->getScaleFactorX() * m_unitScale / m_gsd.x;
+   const ossim_float64 BX = ( m_hdr->getOffsetX() * m_unitScale - m_ulCorner.x ) / m_gsd.x;
+   const ossim_float64 AY = -m_hdr->getScaleFactorY() * m_unitScale / m_gsd.y;
+   const ossim_float64 BY = ( m_ulCorner.y - m_hdr->getOffsetY() * m_unitScale ) / m_gsd.y;
+   const ossim_float64 AZ = m_hdr->getScaleFactorZ() * m_unitScale;
+   const ossim_float64 BZ = m_hdr->getOffsetZ() * m_unitScale;
+   const ossim_float64 WIDTH = m_width;
+   const ossim_float64 HEIGHT = m_height;
+   const bool SWAP = ( ossim::byteOrder() == OSSIM_BIG_ENDIAN );
+   ossimEndian endian;
+
+   BinnedPoint pt;
+   ossim_int32 xyz[3];
+   for ( ossim_uint64 i = 0; i < count; ++i, records += m_recordLength )
+   {
+      memcpy( xyz, records, sizeof(xyz) );
+      if ( SWAP )
+      {
+         endian.swap( xyz[0] );
+         endian.swap( xyz[1] );
+         endian.swap( xyz[2] );
+      }
+
+      //---
+      // Points on the outer edges of the grid, give or take rounding, go to the edge pixels,
+      // so gridding over the header bounds keeps the points at the maximum x and minimum y.
+      //---
+      const ossim_float64 samp = xyz[0] * AX + BX;
+      const ossim_float64 line = xyz[1] * AY + BY;
+      if ( ( samp > -EDGE ) && ( samp < WIDTH + EDGE ) && ( line > -EDGE ) && ( line < HEIGHT + EDGE ) )
+      {
+         const ossim_uint32 s = std::min( static_cast<ossim_uint32>( std::max( samp, 0.0 ) ), m_width - 1 );
+         const ossim_uint32 l = std::min( static_cast<ossim_uint32>( std::max( line, 0.0 ) ), m_height - 1 );
+         if ( ( l < m_stripStart ) || ( l - m_stripStart >= m_stripLines ) )
+         {
+            continue;
+         }
+
+         const ossim_uint64 cell = cellIndex( l - m_stripStart, s );
+         pt.m_cell = static_cast<ossim_uint32>( cell );
+         pt.m_z = static_cast<ossim_float32>( xyz[2] * AZ + BZ );
+         bins[ ( cell / TILE_CELLS ) % OWNERS ].push_back( pt );
+      }
+   }
+}
+
+void ossimLasGridder::mergeOwner(ossim_uint32 owner, ossim_uint32 numSlices)
+{
+   for ( ossim_uint32 s = 0; s < numSlices; ++s )
+   {
+      const std::vector<BinnedPoint>& bin = m_bins[ s * numSlices + owner ];
+      for ( std::vector<BinnedPoint>::const_iterator i = bin.begin(); i != bin.end(); ++i )
+      {
+         const ossim_uint32 cell = i->m_cell;
+         const ossim_float32 z = i->m_z;
+         if ( z < m_lowest[cell] )  m_lowest[cell] = z;
+         if ( z > m_highest[cell] ) m_highest[cell] = z;
+         m_sum[cell] += z;
+         ++m_count[cell];
+      }
+   }
+}
@@ -8,6 +8,8 @@
 // $Id$
 
 #include <ossim/point_cloud/ossimPointCloudHandler.h>
+#include <ossim/base/ossimNotify.h>
+#include <algorithm>
 
 using namespace std;
 
@@ -39,6 +41,12 @@ void ossimPointCloudHandler::getNextFileBlock(ossimPointBlock& block, ossim_uint
 
 void ossimPointCloudHandler::getBlock(const ossimGrect& bounds, ossimPointBlock& block) const
 {
+   if (m_index.valid())
+   {
+      getBlock(bounds, block, 0);
+      return;
+   }
+
    block.clear();
 
    // This default implementation simply reads the whole datafile in file-blocks, retaining
@@ -65,6 +73,78 @@ void ossimPointCloudHandler::getBlock(const ossimGrect& bounds, ossimPointBlock&
    } while (file_block.size() == DEFAULT_BLOCK_SIZE);
 }
 
+void ossimPointCloudHandler::getBlock(const ossimGrect& bounds,
+                                      ossimPointBlock& block,
+                                      ossim_uint32 resLevel) const
+{
+   if (!m_index.valid())
+   {
+      getBlock(bounds, block);
+      return;
+   }
+
+   block.clear();
+
+   // Read only the runs of points the index has for the nodes overlapping the bounds:
+   std::vector<ossimPointCloudIndex::Range> ranges;
+   m_index->getRanges(bounds, resLevel, ranges);
+
+   ossimPointBlock file_block (0, block.getFieldCode());
+   ossimGpt gpt;
+   std::vector<ossimPointCloudIndex::Range>::const_iterator range = ranges.begin();
+   while (range != ranges.end())
+   {
+      ossim_uint32 offset = range->m_start;
+      ossim_uint32 remaining = range->m_count;
+      while (remaining)
+      {
+         file_block.clear();
+         getFileBlock(offset, file_block, std::min(remaining, DEFAULT_BLOCK_SIZE));
+         ossim_uint32 numRead = std::min(file_block.size(), remaining);
+         if (!numRead)
+            break;
+
+         for (ossim_uint32 i=0; i<numRead; ++i)
+         {
+            gpt = file_block[i]->getPosition();
+            if (bounds.pointWithin(gpt))
+               block.addPoint(file_block[i]);
+         }
+         offset += numRead;
+         remaining -= numRead;
+      }
+      ++range;
+   }
+}
+
+bool ossimPointCloudHandler::openIndex()
+{
+   m_index = new ossimPointCloudIndex;
+
+   ossimFilename indexFile;
+   if (!m_inputFilename.empty())
+   {
+      indexFile = ossimPointCloudIndex::getIndexFilename(m_inputFilename);
+      if (indexFile.exists() && m_index->read(indexFile, m_inputFilename, getNumPoints()))
+         return true;
+   }
+
+   if (!m_index->build(this))
+   {
+      m_index = 0;
+      return false;
+   }
+
+   // A read-only directory only costs rebuilding the index next time:
+   if (!indexFile.empty() && !m_index->write(indexFile, m_inputFilename))
+   {
+      ossimNotify(ossimNotifyLevel_INFO)
+         << "ossimPointCloudHandler::openIndex: Could not write <"<<indexFile<<">"<<endl;
+   }
+
+   return true;
+}
+
 void ossimPointCloudHandler::getBounds(ossimGrect& bounds) const
 {
    if (m_minRecord.valid() && m_maxRecord.valid())
@@ -115,6 +115,7 @@ bool ossimPointCloudImageHandler::open()
    if (!m_pch.valid())
       return false;
 
+   openIndex();
    getImageGeometry();
    ossimImageHandler::completeOpen();
 
@@ -133,6 +134,7 @@ bool ossimPointCloudImageHandler::setPointCloudHandler(ossimPointCloudHandler* p
    if (!m_pch.valid())
       return false;
 
+   openIndex();
    getImageGeometry();
    ossimImageHandler::completeOpen();
 
@@ -142,6 +144,16 @@ bool ossimPointCloudImageHandler::setPointCloudHandler(ossimPointCloudHandler* p
    return true;
 }
 
+void ossimPointCloudImageHandler::openIndex()
+{
+   // Tiles are served from the spatial index unless disabled:
+   const char* lookup = ossimPreferences::instance()->findPreference("point_cloud.index");
+   if (lookup && !ossimString(lookup).toBool())
+      return;
+
+   m_pch->openIndex();
+}
+
 void ossimPointCloudImageHandler::close()
 {
    if (isOpen())
@@ -269,7 +281,7 @@ bool ossimPointCloudImageHandler::getTile(ossimImageData* result, ossim_uint32 r
 
 #define USE_GETBLOCK
 #ifdef USE_GETBLOCK
-   m_pch->getBlock(gnd_rect, pointBlock);
+   m_pch->getBlock(gnd_rect, pointBlock, resLevel);
    for (ossim_uint32 id=0; id<pointBlock.size(); ++id)
    {
       pos = pointBlock[id]->getPosition();
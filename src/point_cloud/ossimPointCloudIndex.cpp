@@ -0,0 +1,401 @@
+//**************************************************************************************************
+//
+// OSSIM (http://trac.osgeo.org/ossim/)
+//
+// License:  MIT -- See LICENSE.txt file in the top level directory for more details.
+//
+//**************************************************************************************************
+
+#include <ossim/point_cloud/ossimPointCloudIndex.h>
+#include <ossim/point_cloud/ossimPointCloudHandler.h>
+#include <ossim/base/ossimDate.h>
+#include <ossim/base/ossimNotify.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+static const char   MAGIC[] = "OSSIMPCI";
+static const ossim_uint32 MAGIC_SIZE = 8;
+static const ossim_uint32 VERSION = 2;
+
+// Written as is; an index read on a host of the other byte order is rebuilt.
+static const ossim_uint32 BYTE_ORDER_MARK = 0x01020304;
+
+// Points per getFileBlock() call while building.
+static const ossim_uint32 BUILD_BLOCK_SIZE = 0x100000;
+
+template <class T> static void writeValue(ostream& out, const T& value)
+{
+   out.write((const char*)&value, sizeof(T));
+}
+
+template <class T> static bool readValue(istream& in, T& value)
+{
+   in.read((char*)&value, sizeof(T));
+   return in.good();
+}
+
+// Modification time of the file in seconds since the epoch, 0 if it cannot be read.
+static ossim_int64 modificationTime(const ossimFilename& file)
+{
+   ossimLocalTm modTime;
+   if (!file.getTimes(0, &modTime, 0))
+      return 0;
+   return (ossim_int64) modTime.getEpoc();
+}
+
+// True if v does not decrease, so consecutive entries bound valid slices.
+template <class T> static bool isNonDecreasing(const vector<T>& v)
+{
+   for (size_t i=1; i<v.size(); ++i)
+   {
+      if (v[i] < v[i-1])
+         return false;
+   }
+   return true;
+}
+
+template <class T> static void writeVector(ostream& out, const vector<T>& v)
+{
+   ossim_uint64 size = v.size();
+   writeValue(out, size);
+   if (size)
+      out.write((const char*)&v.front(), size * sizeof(T));
+}
+
+template <class T> static bool readVector(istream& in, vector<T>& v, ossim_uint64 maxSize)
+{
+   ossim_uint64 size = 0;
+   if (!readValue(in, size) || (size > maxSize))
+      return false;
+   v.resize((size_t) size);
+   if (size)
+      in.read((char*)&v.front(), size * sizeof(T));
+   return !in.fail();
+}
+
+ossimPointCloudIndex::ossimPointCloudIndex()
+:  m_numPoints(0),
+   m_depth(0),
+   m_minLat(0),
+   m_minLon(0),
+   m_maxLat(0),
+   m_maxLon(0)
+{
+}
+
+ossim_uint32 ossimPointCloudIndex::levelStart(ossim_uint32 d)
+{
+   // 1 + 4 + 16 + ... + 4^(d-1)
+   return (ossim_uint32) (((1ull << (2 * d)) - 1) / 3);
+}
+
+ossim_uint32 ossimPointCloudIndex::nodeAt(double lat, double lon, ossim_uint32 d) const
+{
+   const ossim_int64 n = 1ll << d;
+   const double dLon = m_maxLon - m_minLon;
+   const double dLat = m_maxLat - m_minLat;
+   ossim_int64 x = (dLon > 0) ? (ossim_int64) ((lon - m_minLon) / dLon * n) : 0;
+   ossim_int64 y = (dLat > 0) ? (ossim_int64) ((m_maxLat - lat) / dLat * n) : 0;
+   x = std::max<ossim_int64>(0, std::min<ossim_int64>(x, n - 1));
+   y = std::max<ossim_int64>(0, std::min<ossim_int64>(y, n - 1));
+   return (ossim_uint32) (y * n + x);
+}
+
+bool ossimPointCloudIndex::build(const ossimPointCloudHandler* pch)
+{
+   m_numPoints = 0;
+   if (!pch || !pch->getNumPoints())
+      return false;
+
+   ossimGrect bounds;
+   pch->getBounds(bounds);
+   if (bounds.ul().isLatLonNan() || bounds.lr().isLatLonNan())
+      return false;
+
+   m_minLat = std::min(bounds.ul().lat, bounds.lr().lat);
+   m_maxLat = std::max(bounds.ul().lat, bounds.lr().lat);
+   m_minLon = std::min(bounds.ul().lon, bounds.lr().lon);
+   m_maxLon = std::max(bounds.ul().lon, bounds.lr().lon);
+
+   const ossim_uint32 numPoints = pch->getNumPoints();
+   m_depth = 0;
+   while ((m_depth < MAX_DEPTH) && ((numPoints >> (2 * m_depth)) > LEAF_POINTS))
+      ++m_depth;
+
+   // One pass over the points in file order, extending the last run of each leaf:
+   const ossim_uint32 numLeaves = 1u << (2 * m_depth);
+   vector< vector<Range> > leafRanges (numLeaves);
+   ossimPointBlock block;
+   ossim_uint32 id = 0;
+   while (id < numPoints)
+   {
+      block.clear();
+      pch->getFileBlock(id, block, std::min(BUILD_BLOCK_SIZE, numPoints - id));
+      const ossim_uint32 size = std::min(block.size(), numPoints - id);
+      if (!size)
+         break;
+
+      for (ossim_uint32 i=0; i<size; ++i, ++id)
+      {
+         const ossimGpt& pos = block[i]->getPosition();
+         vector<Range>& runs = leafRanges[nodeAt(pos.lat, pos.lon, m_depth)];
+         if (!runs.empty() && (runs.back().m_start + runs.back().m_count == id))
+         {
+            ++runs.back().m_count;
+         }
+         else
+         {
+            Range r = { id, 1 };
+            runs.push_back(r);
+         }
+      }
+   }
+   pch->rewind();
+
+   if (id != numPoints)
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+         << "ossimPointCloudIndex::build WARN: Read "<<id<<" of "<<numPoints<<" points."<<endl;
+      return false;
+   }
+
+   // Flatten:
+   m_leafStart.resize(numLeaves + 1);
+   m_ranges.clear();
+   for (ossim_uint32 leaf=0; leaf<numLeaves; ++leaf)
+   {
+      m_leafStart[leaf] = (ossim_uint32) m_ranges.size();
+      m_ranges.insert(m_ranges.end(), leafRanges[leaf].begin(), leafRanges[leaf].end());
+   }
+   m_leafStart[numLeaves] = (ossim_uint32) m_ranges.size();
+
+   buildSamples(leafRanges);
+
+   m_numPoints = numPoints;
+   return true;
+}
+
+void ossimPointCloudIndex::buildSamples(const vector< vector<Range> >& leafRanges)
+{
+   m_sampleStart.assign(levelStart(m_depth) + 1, 0);
+   m_samples.clear();
+
+   const ossim_uint32 leavesAcross = 1u << m_depth;
+   for (ossim_uint32 d=0; d<m_depth; ++d)
+   {
+      const ossim_uint32 nodesAcross = 1u << d;
+      const ossim_uint32 span = leavesAcross / nodesAcross; // leaves per node side
+      for (ossim_uint32 node=0; node<nodesAcross*nodesAcross; ++node)
+      {
+         m_sampleStart[levelStart(d) + node] = (ossim_uint32) m_samples.size();
+         const ossim_uint32 x0 = (node % nodesAcross) * span;
+         const ossim_uint32 y0 = (node / nodesAcross) * span;
+
+         // Count the node's points, then take every stride'th one:
+         ossim_uint64 count = 0;
+         for (ossim_uint32 y=y0; y<y0+span; ++y)
+            for (ossim_uint32 x=x0; x<x0+span; ++x)
+               for (size_t r=0; r<leafRanges[y*leavesAcross+x].size(); ++r)
+                  count += leafRanges[y*leavesAcross+x][r].m_count;
+         if (!count)
+            continue;
+
+         const double stride = (count > LOD_POINTS) ? (double) count / LOD_POINTS : 1.0;
+         const size_t first = m_samples.size();
+         double next = 0.0;
+         ossim_uint64 position = 0;
+         for (ossim_uint32 y=y0; y<y0+span; ++y)
+         {
+            for (ossim_uint32 x=x0; x<x0+span; ++x)
+            {
+               const vector<Range>& runs = leafRanges[y*leavesAcross+x];
+               for (size_t r=0; r<runs.size(); ++r)
+               {
+                  while (next < (double) (position + runs[r].m_count))
+                  {
+                     m_samples.push_back(runs[r].m_start + (ossim_uint32) ((ossim_uint64) next - position));
+                     next += stride;
+                  }
+                  position += runs[r].m_count;
+               }
+            }
+         }
+         std::sort(m_samples.begin() + first, m_samples.end());
+      }
+   }
+   m_sampleStart[levelStart(m_depth)] = (ossim_uint32) m_samples.size();
+}
+
+void ossimPointCloudIndex::getRanges(const ossimGrect& bounds,
+                                     ossim_uint32 level,
+                                     vector<Range>& ranges) const
+{
+   ranges.clear();
+   // Heights do not matter, only the horizontal extent is indexed:
+   if (!isValid() || bounds.ul().isLatLonNan() || bounds.lr().isLatLonNan())
+      return;
+
+   const double minLat = std::min(bounds.ul().lat, bounds.lr().lat);
+   const double maxLat = std::max(bounds.ul().lat, bounds.lr().lat);
+   const double minLon = std::min(bounds.ul().lon, bounds.lr().lon);
+   const double maxLon = std::max(bounds.ul().lon, bounds.lr().lon);
+   if ((minLat > m_maxLat) || (maxLat < m_minLat) || (minLon > m_maxLon) || (maxLon < m_minLon))
+      return;
+
+   const ossim_uint32 d = (level >= m_depth) ? 0 : m_depth - level;
+   const ossim_uint32 across = 1u << d;
+   const ossim_uint32 ul = nodeAt(maxLat, minLon, d);
+   const ossim_uint32 lr = nodeAt(minLat, maxLon, d);
+   for (ossim_uint32 y=ul/across; y<=lr/across; ++y)
+   {
+      for (ossim_uint32 x=ul%across; x<=lr%across; ++x)
+      {
+         const ossim_uint32 node = y * across + x;
+         if (d == m_depth)
+         {
+            ranges.insert(ranges.end(),
+                          m_ranges.begin() + m_leafStart[node],
+                          m_ranges.begin() + m_leafStart[node + 1]);
+         }
+         else
+         {
+            const ossim_uint32 i = levelStart(d) + node;
+            for (ossim_uint32 s=m_sampleStart[i]; s<m_sampleStart[i + 1]; ++s)
+            {
+               Range r = { m_samples[s], 1 };
+               ranges.push_back(r);
+            }
+         }
+      }
+   }
+
+   // Sort and merge touching runs so the handler reads as few blocks as possible:
+   std::sort(ranges.begin(), ranges.end(),
+             [](const Range& a, const Range& b) { return a.m_start < b.m_start; });
+   size_t out = 0;
+   for (size_t i=0; i<ranges.size(); ++i)
+   {
+      if (out && (ranges[out-1].m_start + ranges[out-1].m_count >= ranges[i].m_start))
+      {
+         ossim_uint32 end = std::max(ranges[out-1].m_start + ranges[out-1].m_count,
+                                     ranges[i].m_start + ranges[i].m_count);
+         ranges[out-1].m_count = end - ranges[out-1].m_start;
+      }
+      else
+      {
+         ranges[out++] = ranges[i];
+      }
+   }
+   ranges.resize(out);
+}
+
+ossimFilename ossimPointCloudIndex::getIndexFilename(const ossimFilename& sourceFile)
+{
+   ossimFilename indexFile (sourceFile);
+   indexFile.setExtension("pci");
+   return indexFile;
+}
+
+bool ossimPointCloudIndex::read(const ossimFilename& indexFile,
+                                const ossimFilename& sourceFile,
+                                ossim_uint32 numPoints)
+{
+   m_numPoints = 0;
+   ifstream in (indexFile.c_str(), ios::in | ios::binary);
+   if (!in.good())
+      return false;
+
+   char magic[MAGIC_SIZE];
+   ossim_uint32 version = 0;
+   ossim_uint32 mark = 0;
+   ossim_int64 sourceSize = 0;
+   ossim_int64 sourceTime = 0;
+   ossim_uint32 indexedPoints = 0;
+   in.read(magic, MAGIC_SIZE);
+   if (!in.good() || strncmp(magic, MAGIC, MAGIC_SIZE) ||
+       !readValue(in, version) || (version != VERSION) ||
+       !readValue(in, mark) || (mark != BYTE_ORDER_MARK) ||
+       !readValue(in, sourceSize) || (sourceSize != sourceFile.fileSize()) ||
+       !readValue(in, sourceTime) || (sourceTime != modificationTime(sourceFile)) ||
+       !readValue(in, indexedPoints) || (indexedPoints != numPoints))
+   {
+      return false;
+   }
+
+   if (!readData(in))
+      return false;
+
+   // Every point ID must be one of the source's:
+   for (size_t i=0; i<m_ranges.size(); ++i)
+   {
+      if ((ossim_uint64) m_ranges[i].m_start + m_ranges[i].m_count > indexedPoints)
+         return false;
+   }
+   for (size_t i=0; i<m_samples.size(); ++i)
+   {
+      if (m_samples[i] >= indexedPoints)
+         return false;
+   }
+
+   m_numPoints = indexedPoints;
+   return true;
+}
+
+bool ossimPointCloudIndex::readData(istream& in)
+{
+   if (!readValue(in, m_depth) || (m_depth > MAX_DEPTH) ||
+       !readValue(in, m_minLat) || !readValue(in, m_minLon) ||
+       !readValue(in, m_maxLat) || !readValue(in, m_maxLon))
+   {
+      return false;
+   }
+
+   // Offsets must not decrease and must end at the size of what they index, so every
+   // [start[i], start[i + 1]) slice getRanges() walks is inside the vector:
+   const ossim_uint64 numLeaves = 1ull << (2 * m_depth);
+   const ossim_uint64 maxEntries = 0xFFFFFFFFull;
+   return readVector(in, m_leafStart, numLeaves + 1) && (m_leafStart.size() == numLeaves + 1) &&
+          isNonDecreasing(m_leafStart) &&
+          readVector(in, m_ranges, maxEntries) && (m_leafStart.back() == m_ranges.size()) &&
+          readVector(in, m_sampleStart, levelStart(m_depth) + 1) &&
+          (m_sampleStart.size() == levelStart(m_depth) + 1) && isNonDecreasing(m_sampleStart) &&
+          readVector(in, m_samples, maxEntries) && (m_sampleStart.back() == m_samples.size());
+}
+
+bool ossimPointCloudIndex::write(const ossimFilename& indexFile,
+                                 const ossimFilename& sourceFile) const
+{
+   if (!isValid())
+      return false;
+
+   ofstream out (indexFile.c_str(), ios::out | ios::binary);
+   if (!out.good())
+      return false;
+
+   out.write(MAGIC, MAGIC_SIZE);
+   writeValue(out, VERSION);
+   writeValue(out, BYTE_ORDER_MARK);
+   writeValue(out, sourceFile.fileSize());
+   writeValue(out, modificationTime(sourceFile));
+   writeValue(out, m_numPoints);
+   writeData(out);
+   out.close();
+
+   return !out.fail();
+}
+
+void ossimPointCloudIndex::writeData(ostream& out) const
+{
+   writeValue(out, m_depth);
+   writeValue(out, m_minLat);
+   writeValue(out, m_minLon);
+   writeValue(out, m_maxLat);
+   writeValue(out, m_maxLon);
+   writeVector(out, m_leafStart);
+   writeVector(out, m_ranges);
+   writeVector(out, m_sampleStart);
+   writeVector(out, m_samples);
+}
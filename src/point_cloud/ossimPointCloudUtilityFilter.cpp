@@ -11,6 +11,7 @@
 //  $Id$
 
 #include <ossim/point_cloud/ossimPointCloudUtilityFilter.h>
+#include <ossim/base/ossimCommon.h>
 #include <ossim/imaging/ossimImageData.h>
 #include <ossim/imaging/ossimImageGeometry.h>
 #include <ossim/elevation/ossimElevManager.h>
@@ -24,9 +25,23 @@ ossimPointCloudUtilityFilter::ossimPointCloudUtilityFilter( ossimPointCloudTool*
 {
 }
 
+ossimRefPtr<ossimImageData> ossimPointCloudUtilityFilter::getTile(const ossimIrect& tileRect,
+                                                                  ossim_uint32 resLevel)
+{
+   if (!m_tile.valid())
+   {
+      m_tile = new ossimImageData(this, OSSIM_FLOAT32, 1);
+      m_tile->initialize();
+   }
+   m_tile->setImageRectangle(tileRect);
+   if (!getTile(m_tile.get(), resLevel))
+      m_tile->makeBlank();
+   return m_tile;
+}
+
 bool ossimPointCloudUtilityFilter::getTile(ossimImageData* result, ossim_uint32 resLevel)
 {
-   if (!result)
+   if (!result || !m_util.valid())
       return false;
 
    ossimIrect irect (result->getImageRectangle());
@@ -41,16 +56,22 @@ bool ossimPointCloudUtilityFilter::getTile(ossimImageData* result, ossim_uint32
    if ((m_util->m_operation == ossimPointCloudTool::HIGHEST_DEM) ||
          (m_util->m_operation == ossimPointCloudTool::HIGHEST_LOWEST))
    {
-      m_util->m_pciHandler->setCurrentEntry(ossimPointCloudImageHandler::HIGHEST);
-      highest = m_util->m_pciHandler->getTile(irect, resLevel);
+      highest = m_util->getElevationTile(true, irect, resLevel);
+      if (!highest.valid())
+         return false;
    }
    if ((m_util->m_operation == ossimPointCloudTool::LOWEST_DEM) ||
          (m_util->m_operation == ossimPointCloudTool::HIGHEST_LOWEST))
    {
-      m_util->m_pciHandler->setCurrentEntry(ossimPointCloudImageHandler::LOWEST);
-      lowest = m_util->m_pciHandler->getTile(irect, resLevel);
+      lowest = m_util->getElevationTile(false, irect, resLevel);
+      if (!lowest.valid())
+         return false;
    }
 
+   // Pixels without points stay null:
+   const double null_dh = result->getNullPix(0);
+   const double null_pc = highest.valid() ? highest->getNullPix(0) : lowest->getNullPix(0);
+
    // Now loop over all pixels in tile and perform operations as needed:
    ossimIpt pt_l0;
    for (ipt.y=irect.ul().y; ipt.y<=irect.lr().y; ++ipt.y)
@@ -64,16 +85,22 @@ bool ossimPointCloudUtilityFilter::getTile(ossimImageData* result, ossim_uint32
             m_util->m_prodGeom->localToWorld(pt_l0, gpt);
             h = elevation->getHeightAboveEllipsoid(gpt);
             dh = highest->getPix(ipt) - h;
+            if ((highest->getPix(ipt) == null_pc) || ossim::isnan(h))
+               dh = null_dh;
             break;
 
          case ossimPointCloudTool::HIGHEST_LOWEST:
             dh = highest->getPix(ipt) - lowest->getPix(ipt);
+            if ((highest->getPix(ipt) == null_pc) || (lowest->getPix(ipt) == null_pc))
+               dh = null_dh;
             break;
 
          default: // LOWEST_DEM
             m_util->m_prodGeom->localToWorld(pt_l0, gpt);
             h = elevation->getHeightAboveEllipsoid(gpt);
             dh = lowest->getPix(ipt) - h;
+            if ((lowest->getPix(ipt) == null_pc) || ossim::isnan(h))
+               dh = null_dh;
             break;
 
          }
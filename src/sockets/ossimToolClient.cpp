@@ -6,11 +6,13 @@
 //**************************************************************************************************
 
 #include <ossim/sockets/ossimToolClient.h>
+#include <ossim/sockets/ossimToolProtocol.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <netinet/in.h>
 #include <netdb.h>
 #include <iostream>
@@ -75,6 +77,32 @@ int ossimToolClient::connectToServer(char* hostname, char* portname)
    m_svrsockfd = -1;
    while (1)
    {
+      // A path is the local socket of a server on this host:
+      if (hostname && (hostname[0] == '/') && !portname)
+      {
+         struct sockaddr_un addr;
+         memset(&addr, 0, sizeof addr);
+         addr.sun_family = AF_UNIX;
+         if (strlen(hostname) >= sizeof(addr.sun_path))
+         {
+            error("Local socket path too long");
+            break;
+         }
+         strncpy(addr.sun_path, hostname, sizeof(addr.sun_path) - 1);
+         m_svrsockfd = socket(AF_UNIX, SOCK_STREAM, 0);
+         if (m_svrsockfd < 0)
+         {
+            error("Error opening socket");
+            break;
+         }
+         if (connect(m_svrsockfd, (struct sockaddr*) &addr, sizeof addr) < 0)
+         {
+            error("ERROR connecting");
+            disconnect();
+         }
+         break;
+      }
+
       // Consider port number in host URL:
       ossimString host (hostname);
       ossimString port;
@@ -148,54 +176,31 @@ bool ossimToolClient::execute(const char* command_spec)
    if (command_spec == NULL)
       return false;
 
-   // Write command to the OSSIM tool server socket:
+   // Write length framed command to the OSSIM tool server socket:
    if (_DEBUG_) cout<<"ossimToolClient:"<<__LINE__<<" sending <"<<command_spec<<">..."<<endl; //TODO REMOVE DEBUG
-   int n = send(m_svrsockfd, command_spec, strlen(command_spec), 0);
-   if (n < 0)
-   {
-      error("ERROR writing to socket");
+   // One send for header and command so Nagle does not hold back the second segment:
+   ossim_uint32 length = (ossim_uint32) strlen(command_spec);
+   std::string request (4, '\0');
+   ossimToolProtocol::encodeU32(length, (ossim_uint8*) &request[0]);
+   request.append(command_spec, length);
+   if (!sendAll(request.data(), request.size()))
       return false;
-   }
-   while (n < (int) strlen(command_spec))
-   {
-      // Partial send, try remainder of buffer:
-      if (_DEBUG_) cout<<"ossimToolClient:"<<__LINE__<<" sending <"<<&(command_spec[n])<<">..."<<endl; //TODO REMOVE DEBUG
-      int r = send(m_svrsockfd, &(command_spec[n]), strlen(command_spec)-n, 0);
-      if (r < 0)
-      {
-         error("ERROR writing to socket");
-         return false;
-      }
-      n += r;
-   }
 
    // Process response from server. First read the response type. Can be either:
-   //     "TEXT"  -- only text is streamed
-   //     "FILE"  -- a file is treamed
-   //     "MIXED" -- Both file and text
+   //     "TEXT " -- only text is streamed
+   //     "FILE " -- text followed by a file
    //     "ERROR" -- only text with error message. No product generated.
-   //     "ADIOS" -- Server acknowledges disconnect
    bool success = false;
-   memset(m_buffer, 0, MAX_BUF_LEN);
-   if (_DEBUG_) cout<<"ossimToolClient:"<<__LINE__<<" Waiting to recv"<<endl; //TODO REMOVE DEBUG
-   n = recv(m_svrsockfd, m_buffer, 5, 0);
-   if (_DEBUG_) cout<<"ossimToolClient:"<<__LINE__<<" Received <"<<m_buffer<<">"<<endl; //TODO REMOVE DEBUG
-   if (n < 0)
-   {
-      error("ERROR reading from socket");
+   char type[ossimToolProtocol::TYPE_SIZE];
+   if (!recvAll(type, ossimToolProtocol::TYPE_SIZE))
       return false;
-   }
-   ossimString response (string(m_buffer, n));
-   if (response.contains("TEXT"))
+   ossimString response (string(type, ossimToolProtocol::TYPE_SIZE));
+   if (response == ossimToolProtocol::TEXT_TYPE)
       success = receiveText();
-   else if (response.contains("FILE"))
-      success = receiveFile();
-   else if (response.contains("MIXED"))
+   else if (response == ossimToolProtocol::FILE_TYPE)
       success = receiveText() && receiveFile();
-   else if (response.contains("ERROR"))
+   else if (response == ossimToolProtocol::ERROR_TYPE)
       receiveText(); // success = false;
-   else if (response.contains("ADIOS"))
-      error("Received unexpected disconnect message from server.");
    else
       error("Unknown type in response header");
 
@@ -205,25 +210,19 @@ bool ossimToolClient::execute(const char* command_spec)
 
 bool ossimToolClient::receiveText()
 {
-   int n = MAX_BUF_LEN;
    m_textResponse.clear();
-   while (n == MAX_BUF_LEN)
-   {
-      memset(m_buffer, 0, MAX_BUF_LEN);
-      if (_DEBUG_) cout<<"ossimToolClient:"<<__LINE__<<" Waiting to recv"<<endl; //TODO REMOVE DEBUG
-      n = recv(m_svrsockfd, m_buffer, MAX_BUF_LEN, 0);
-      if (_DEBUG_) cout<<"ossimToolClient:"<<__LINE__<<" Received <"<<m_buffer<<">"<<endl; //TODO REMOVE DEBUG
-      if (n < 0)
-      {
-         error("ERROR reading from socket");
-         return false;
-      }
-      m_textResponse.append(m_buffer);
-   }
-   if (!acknowledgeRcv())
+
+   ossim_uint8 header[8];
+   if (!recvAll(header, 8))
+      return false;
+   ossim_uint64 length = ossimToolProtocol::decodeU64(header);
+
+   std::string text ((size_t) length, '\0');
+   if (length && !recvAll(&text[0], (size_t) length))
       return false;
+   m_textResponse = text;
 
-   printf("Text response:\n-----------------\n%s\n-----------------\n",m_textResponse.c_str());
+   if (_DEBUG_) printf("Text response:\n-----------------\n%s\n-----------------\n",m_textResponse.c_str());
    return true;
 }
 
@@ -231,23 +230,30 @@ bool ossimToolClient::receiveText()
 bool ossimToolClient::receiveFile()
 {
    ostringstream xmsg;
-   cout << "Server requesting file send. " <<endl;
 
-   // Fetch the file size in bytes as the next message "SIZE: GGGMMMKKKBBB", (18 bytes)
-   if (!receiveText())
+   // Fetch the file name and size:
+   ossim_uint8 header[8];
+   if (!recvAll(header, 4))
       return false;
-   int filesize = m_textResponse.after("SIZE: ").toInt();
-   cout << "File size = " <<filesize<<endl;
-
-   // Fetch the filename as next message "NAME: AAAAA...", (256 bytes)
-   if (!receiveText())
+   ossim_uint32 nameLength = ossimToolProtocol::decodeU32(header);
+   if (nameLength > MAX_BUF_LEN)
+   {
+      error("ERROR bad file name length from server");
+      return false;
+   }
+   std::string name (nameLength, '\0');
+   if (nameLength && !recvAll(&name[0], nameLength))
       return false;
-   ossimFilename fileName (m_textResponse.after("NAME: "));
-   m_prodFilePath = m_prodFilePath.dirCat(fileName);
-   cout << "File name = " <<m_prodFilePath<<endl;
+   if (!recvAll(header, 8))
+      return false;
+   ossim_uint64 filesize = ossimToolProtocol::decodeU64(header);
+
+   ossimFilename fileName (name);
+   m_prodFilePath = m_prodFilePath.dirCat(fileName.file());
+   if (_DEBUG_) cout << "File name = " <<m_prodFilePath<<" size = "<<filesize<<endl;
 
    // Open file for writing:
-   ofstream fout (m_prodFilePath.chars());
+   ofstream fout (m_prodFilePath.chars(), ios::binary);
    if (fout.fail())
    {
       xmsg <<"ERROR opening output file: <"<<m_prodFilePath<<">"<<ends;
@@ -255,13 +261,12 @@ bool ossimToolClient::receiveFile()
       return false;
    }
 
-   memset(m_buffer, 0, MAX_BUF_LEN);
-   int n = MAX_BUF_LEN;
-   int numBytes = 0;
-   while ((n == MAX_BUF_LEN) && (numBytes < filesize))
+   ossim_uint64 numBytes = 0;
+   while (numBytes < filesize)
    {
-      n = recv(m_svrsockfd, m_buffer, MAX_BUF_LEN, 0);
-      if (n < 0)
+      ossim_uint64 remaining = filesize - numBytes;
+      int n = recv(m_svrsockfd, m_buffer, (remaining < MAX_BUF_LEN) ? (int) remaining : MAX_BUF_LEN, 0);
+      if (n <= 0)
       {
          error("ERROR reading from socket");
          return false;
@@ -274,27 +279,45 @@ bool ossimToolClient::receiveFile()
       }
       numBytes += n;
    }
+   fout.close();
 
-   if (!acknowledgeRcv())
-      return false;
+   if (_DEBUG_) cout<<"\nossim-client: Received and wrote "<<numBytes<<" bytes to: <"<<m_prodFilePath<<">."<<endl;;
+   return true;
+}
 
-   cout<<"\nossim-client: Received and wrote "<<numBytes<<" bytes to: <"<<m_prodFilePath<<">."<<endl;;
-   fout.close();
 
+bool ossimToolClient::sendAll(const void* buf, size_t size)
+{
+   const char* p = (const char*) buf;
+   while (size)
+   {
+      int n = send(m_svrsockfd, p, size, 0);
+      if (n < 0)
+      {
+         error("ERROR writing to socket");
+         return false;
+      }
+      p += n;
+      size -= n;
+   }
    return true;
 }
 
 
-bool ossimToolClient::acknowledgeRcv()
+bool ossimToolClient::recvAll(void* buf, size_t size)
 {
-   if (_DEBUG_) cout<<"ossimToolClient:"<<__LINE__<<" sending \"ok_to_send\"..."<<endl; //TODO REMOVE DEBUG
-   int r = send(m_svrsockfd, "ok_to_send", 11, 0);
-   if (r < 0)
+   char* p = (char*) buf;
+   while (size)
    {
-      error("ERROR writing to socket");
-      return false;
+      int n = recv(m_svrsockfd, p, size, 0);
+      if (n <= 0)
+      {
+         error("ERROR reading from socket");
+         return false;
+      }
+      p += n;
+      size -= n;
    }
-   if (_DEBUG_) cout << "Receive acknowledged."<<endl;
    return true;
 }
 
@@ -6,142 +6,538 @@
 //**************************************************************************************************
 
 #include <ossim/sockets/ossimToolServer.h>
+#include <ossim/sockets/ossimToolProtocol.h>
 #include <iostream>
+#include <algorithm>
+#include <iomanip>
 #include <sstream>
 #include <map>
+#include <set>
+#include <vector>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <fcntl.h>
 #include <errno.h>
-#include <sys/wait.h>
 #include <signal.h>
 #include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimString.h>
 #include <ossim/base/ossimFilename.h>
 #include <ossim/base/ossimException.h>
 #include <ossim/base/ossimNotify.h>
 #include <ossim/base/ossimArgumentParser.h>
+#include <ossim/parallel/ossimJob.h>
+#include <ossim/parallel/ossimJobMultiThreadQueue.h>
 #include <ossim/util/ossimChipProcTool.h>
+#include <ossim/util/ossimChipperTool.h>
 #include <ossim/util/ossimToolRegistry.h>
 
-#ifdef _MSC_VER
-#include <winsock2.h>
-#include <process.h> /* for getpid() and the exec..() family */
-#include <io.h>
-#define dup2 _dup2
-#define close closesocket
-#define pipe(phandles)  _pipe(phandles, 4096, _O_BINARY)
-#else
 #include <unistd.h>
+#include <poll.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <netinet/tcp.h>
 #include <netinet/in.h>
-
-using namespace std;
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/sendfile.h>
 #endif
 
+using namespace std;
 
 #define OWARN ossimNotify(ossimNotifyLevel_WARN)
 #define OINFO ossimNotify(ossimNotifyLevel_INFO)
-#define MAX_BUF_LEN 4096
-#define FORK_PROCESS false
+#define MAX_BUF_LEN 65536
 #define _DEBUG_ false
 
-ossimToolServer::ossimToolServer()
-:  m_svrsockfd(-1),
-   m_clisockfd(-1),
-   m_buffer(new char[MAX_BUF_LEN])
-{}
-
-ossimToolServer::~ossimToolServer()
+namespace
 {
-   close(m_svrsockfd);
-}
+   // Give up on a client that does not drain its socket for this long:
+   const int WRITE_TIMEOUT_MS = 60000;
+
+   /**
+    * Stream buffer installed on std::cout while the server runs. Worker threads point
+    * s_capture at their own string so that console output of concurrent tools does not mix.
+    * Threads with no capture string write through to the original buffer.
+    */
+   class ThreadRoutedBuffer : public std::streambuf
+   {
+   public:
+      ThreadRoutedBuffer(std::streambuf* passThrough) : m_passThrough(passThrough) {}
 
+      static thread_local std::string* s_capture;
 
-void ossimToolServer::startListening(const char* portid)
-{
-   initSocket(portid);
+   protected:
+      virtual int_type overflow(int_type c)
+      {
+         if (s_capture)
+         {
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+               s_capture->push_back(traits_type::to_char_type(c));
+            return traits_type::not_eof(c);
+         }
+         return m_passThrough->sputc(traits_type::to_char_type(c));
+      }
 
-   socklen_t clilen;
-   ostringstream xmsg;
-   bool status_ok = true;
+      virtual std::streamsize xsputn(const char* s, std::streamsize n)
+      {
+         if (s_capture)
+         {
+            s_capture->append(s, (size_t) n);
+            return n;
+         }
+         return m_passThrough->sputn(s, n);
+      }
 
-   // Loop forever to listen for OSSIM requests:
-   OINFO<<"Waiting for connections...\n"<<endl;
-   while (1)
-   {
-      // Message received at server socket, establish connection to client's socket:
-      struct sockaddr_in cli_addr;
-      clilen = sizeof(cli_addr);
-      m_clisockfd = accept(m_svrsockfd, (struct sockaddr *) &cli_addr, &clilen);
-      if (m_clisockfd < 0)
-         error("Error accepting message on port.");
+      virtual int sync()
+      {
+         return s_capture ? 0 : m_passThrough->pubsync();
+      }
 
-      // Test code:
-      char clientname[256];
-      char clientport[256];
-      getnameinfo((struct sockaddr *) &cli_addr, clilen, clientname, 256, clientport, 256, 0);
-      cout<<"ossimToolServer: Got connection from  "<<clientname<<":"<<clientport
-            <<" Forking child process..."<<endl;
+   private:
+      std::streambuf* m_passThrough;
+   };
 
+   thread_local std::string* ThreadRoutedBuffer::s_capture = 0;
 
-#if 1
-      // Fork process to handle client request:
-      if (FORK_PROCESS)
+   /** Writes all of the buffers, waiting for the socket to drain as needed. */
+   bool writeAll(int fd, struct iovec* iov, int iovcnt)
+   {
+      while (iovcnt > 0)
       {
-         if (!fork())
+         ssize_t n = writev(fd, iov, iovcnt);
+         if (n < 0)
+         {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+               struct pollfd pfd = { fd, POLLOUT, 0 };
+               if (poll(&pfd, 1, WRITE_TIMEOUT_MS) <= 0)
+                  return false;
+               continue;
+            }
+            if (errno == EINTR)
+               continue;
+            return false;
+         }
+
+         // Skip what went out:
+         while ((iovcnt > 0) && ((size_t) n >= iov->iov_len))
          {
-            // this is the child process
-            close(m_svrsockfd); // child doesn't need the listener
+            n -= iov->iov_len;
+            ++iov;
+            --iovcnt;
+         }
+         if (iovcnt > 0)
+         {
+            iov->iov_base = (char*) iov->iov_base + n;
+            iov->iov_len -= n;
+         }
+      }
+      return true;
+   }
 
-            // Receive request from client:
-            bool connected = true;
-            while (connected)
-               connected = processOssimRequest(cli_addr);
+   bool writeAll(int fd, const void* buf, size_t size)
+   {
+      struct iovec iov;
+      iov.iov_base = (void*) buf;
+      iov.iov_len = size;
+      return writeAll(fd, &iov, 1);
+   }
 
-            exit(0); // exit forked process
+   /** Copies size bytes of the open file to the socket, in kernel where possible. */
+   bool sendFileData(int sockfd, int filefd, ossim_uint64 size)
+   {
+#if defined(__linux__)
+      off_t offset = 0;
+      while ((ossim_uint64) offset < size)
+      {
+         ssize_t n = sendfile(sockfd, filefd, &offset, (size_t) (size - offset));
+         if (n < 0)
+         {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+               struct pollfd pfd = { sockfd, POLLOUT, 0 };
+               if (poll(&pfd, 1, WRITE_TIMEOUT_MS) <= 0)
+                  return false;
+               continue;
+            }
+            if (errno == EINTR)
+               continue;
+            return false;
          }
+         if (n == 0)
+            return false; // File shrank underneath us.
       }
-      else
+      return true;
+#else
+      std::vector<char> buf (MAX_BUF_LEN);
+      ossim_uint64 remaining = size;
+      while (remaining)
+      {
+         ssize_t n = read(filefd, &buf.front(), (size_t) std::min<ossim_uint64>(remaining, MAX_BUF_LEN));
+         if (n <= 0)
+            return false;
+         if (!writeAll(sockfd, &buf.front(), (size_t) n))
+            return false;
+         remaining -= n;
+      }
+      return true;
+#endif
+   }
+
+   void setNonBlocking(int fd)
+   {
+      int flags = fcntl(fd, F_GETFL, 0);
+      fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+   }
+}
+
+/** State of one client connection. Only the thread currently servicing it touches m_input. */
+class ossimToolServer::Connection
+{
+public:
+   Connection(int fd, const std::string& peer) : m_fd(fd), m_peer(peer), m_closing(false) {}
+   int m_fd;
+   std::string m_peer;
+   std::string m_input;
+   bool m_closing;
+};
+
+/** Runs one request on a worker thread. */
+class ossimToolServer::RequestJob : public ossimJob
+{
+public:
+   RequestJob(ossimToolServer* server,
+              std::shared_ptr<Connection> conn,
+              const std::string& command,
+              std::chrono::steady_clock::time_point received)
+   :  m_server(server), m_conn(conn), m_command(command), m_received(received) {}
+
+protected:
+   virtual void run()
+   {
+      m_server->processRequest(m_conn, m_command, m_received);
+   }
+
+private:
+   ossimToolServer* m_server;
+   std::shared_ptr<Connection> m_conn;
+   std::string m_command;
+   std::chrono::steady_clock::time_point m_received;
+};
+
+/**
+ * Read readiness for the listening socket (level triggered) and client sockets (one shot: a
+ * client is not watched again until rearm() after its request is answered). A pipe is used to
+ * wake the loop for rearm() on the poll() version and for stop().
+ */
+class ossimToolServer::Poller
+{
+public:
+   Poller() : m_pollfd(-1), m_listenfd(-1)
+   {
+      m_wake[0] = m_wake[1] = -1;
+   }
+
+   ~Poller()
+   {
+      if (m_pollfd >= 0)
+         close(m_pollfd);
+      if (m_wake[0] >= 0)
+         close(m_wake[0]);
+      if (m_wake[1] >= 0)
+         close(m_wake[1]);
+   }
+
+   bool init(int listenfd)
+   {
+      if (pipe(m_wake) == -1)
+         return false;
+      setNonBlocking(m_wake[0]);
+      setNonBlocking(m_wake[1]);
+      m_listenfd = listenfd;
+#if defined(__linux__)
+      m_pollfd = epoll_create1(0);
+      if (m_pollfd < 0)
+         return false;
+      return control(EPOLL_CTL_ADD, listenfd, EPOLLIN) && control(EPOLL_CTL_ADD, m_wake[0], EPOLLIN);
+#else
+      return true;
+#endif
+   }
+
+   bool add(int fd)
+   {
+#if defined(__linux__)
+      return control(EPOLL_CTL_ADD, fd, EPOLLIN | EPOLLRDHUP | EPOLLONESHOT);
+#else
+      return rearm(fd);
+#endif
+   }
+
+   bool rearm(int fd)
+   {
+#if defined(__linux__)
+      return control(EPOLL_CTL_MOD, fd, EPOLLIN | EPOLLRDHUP | EPOLLONESHOT);
+#else
       {
-         bool connected = true;
-         while (connected)
-            connected = processOssimRequest(cli_addr);
+         std::lock_guard<std::mutex> lock (m_mutex);
+         m_armed.insert(fd);
       }
+      wake();
+      return true;
+#endif
+   }
+
+   void remove(int fd)
+   {
+#if defined(__linux__)
+      control(EPOLL_CTL_DEL, fd, 0);
 #else
-      int n=0;
-      while (1)
+      std::lock_guard<std::mutex> lock (m_mutex);
+      m_armed.erase(fd);
+#endif
+   }
+
+   void wake()
+   {
+      char c = 0;
+      ssize_t n = write(m_wake[1], &c, 1);
+      (void) n; // Pipe full means a wake is already pending.
+   }
+
+   /** Waits for events. Ready client fds are returned, listenReady set if accept is pending. */
+   bool wait(std::vector<int>& ready, bool& listenReady)
+   {
+      ready.clear();
+      listenReady = false;
+#if defined(__linux__)
+      struct epoll_event events[64];
+      int n = epoll_wait(m_pollfd, events, 64, -1);
+      if (n < 0)
+         return errno == EINTR;
+      for (int i = 0; i < n; ++i)
       {
-         // Clear the input m_buffer and read the message sent:
-         memset(m_buffer, 0, 256);
-         n = recv(m_clisockfd,m_buffer,256,0);
-         if (n < 0)
+         int fd = events[i].data.fd;
+         if (fd == m_listenfd)
+            listenReady = true;
+         else if (fd == m_wake[0])
+            drainWake();
+         else
+            ready.push_back(fd);
+      }
+#else
+      std::vector<struct pollfd> pfds;
+      struct pollfd pfd = { m_listenfd, POLLIN, 0 };
+      pfds.push_back(pfd);
+      pfd.fd = m_wake[0];
+      pfds.push_back(pfd);
+      {
+         std::lock_guard<std::mutex> lock (m_mutex);
+         for (std::set<int>::const_iterator i = m_armed.begin(); i != m_armed.end(); ++i)
          {
-            printf("recv returned -1 from port %d.\n", m_clisockfd);
+            pfd.fd = *i;
+            pfds.push_back(pfd);
+         }
+      }
+      int n = poll(&pfds.front(), pfds.size(), -1);
+      if (n < 0)
+         return errno == EINTR;
+      if (pfds[0].revents)
+         listenReady = true;
+      if (pfds[1].revents)
+         drainWake();
+      std::lock_guard<std::mutex> lock (m_mutex);
+      for (size_t i = 2; i < pfds.size(); ++i)
+      {
+         if (pfds[i].revents)
+         {
+            m_armed.erase(pfds[i].fd); // one shot
+            ready.push_back(pfds[i].fd);
          }
-
-         // Send acknowledgement back to client:
-         printf("Received: %s\n",m_buffer);
-         string msg ="server received message: ";
-         msg.append(m_buffer, strlen(m_buffer));
-         n = send(m_clisockfd, msg.c_str(), msg.size(), 0);
-         if (n < 0)
-            error("ERROR writing to socket");
       }
 #endif
-      // Finished serving this client. Close the connection:
-      close(m_clisockfd);
+      return true;
+   }
+
+private:
+   void drainWake()
+   {
+      char buf[256];
+      while (read(m_wake[0], buf, sizeof(buf)) > 0);
+   }
+
+#if defined(__linux__)
+   bool control(int op, int fd, ossim_uint32 events)
+   {
+      struct epoll_event ev;
+      memset(&ev, 0, sizeof(ev));
+      ev.events = events;
+      ev.data.fd = fd;
+      return epoll_ctl(m_pollfd, op, fd, &ev) == 0;
+   }
+#else
+   std::mutex m_mutex;
+   std::set<int> m_armed;
+#endif
+
+   int m_pollfd;
+   int m_listenfd;
+   int m_wake[2];
+};
+
+ossimToolServer::Metrics::Metrics()
+:  m_requests(0),
+   m_errors(0),
+   m_connections(0),
+   m_totalSeconds(0.0),
+   m_maxSeconds(0.0)
+{
+   memset(m_histogram, 0, sizeof(m_histogram));
+}
+
+double ossimToolServer::Metrics::percentile(double fraction) const
+{
+   if (m_requests == 0)
+      return 0.0;
+
+   ossim_uint64 target = (ossim_uint64) (fraction * m_requests + 0.5);
+   if (target == 0)
+      target = 1;
+   ossim_uint64 count = 0;
+   for (int i = 0; i < NUM_LATENCY_BUCKETS - 1; ++i)
+   {
+      count += m_histogram[i];
+      if (count >= target)
+         return std::min(m_maxSeconds, (double) (1 << i) / 1000.0);
+   }
+   return m_maxSeconds;
+}
+
+void ossimToolServer::Metrics::print(std::ostream& out) const
+{
+   double mean = m_requests ? m_totalSeconds / m_requests : 0.0;
+   out << "connections: " << m_connections
+       << "\nrequests:    " << m_requests
+       << "\nerrors:      " << m_errors
+       << std::setiosflags(ios::fixed) << std::setprecision(6)
+       << "\nmean_s:      " << mean
+       << "\np50_s:       " << percentile(0.50)
+       << "\np95_s:       " << percentile(0.95)
+       << "\np99_s:       " << percentile(0.99)
+       << "\nmax_s:       " << m_maxSeconds
+       << "\n";
+}
+
+ossimToolServer::ossimToolServer()
+:  m_svrsockfd(-1),
+   m_localPath(),
+   m_numThreads(0),
+   m_stop(false),
+   m_poller(),
+   m_jobQueue(),
+   m_mutex(),
+   m_connections(),
+   m_metrics()
+{}
+
+ossimToolServer::~ossimToolServer()
+{
+   if (m_svrsockfd >= 0)
+      close(m_svrsockfd);
+}
+
+void ossimToolServer::setNumberOfThreads(ossim_uint32 nThreads)
+{
+   m_numThreads = nThreads;
+}
+
+void ossimToolServer::stop()
+{
+   m_stop = true;
+   if (m_poller)
+      m_poller->wake();
+}
+
+ossimToolServer::Metrics ossimToolServer::getMetrics() const
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   return m_metrics;
+}
+
+void ossimToolServer::startListening(const char* portid)
+{
+   initSocket(portid);
+
+   // A client dropping mid-response must not kill the server:
+   signal(SIGPIPE, SIG_IGN);
+
+   ossim_uint32 nThreads = m_numThreads ? m_numThreads : ossim::getNumberOfThreads();
+   m_jobQueue = std::make_shared<ossimJobMultiThreadQueue>(std::make_shared<ossimJobQueue>(),
+                                                           nThreads);
+
+   // Route console output of each worker to its own response:
+   std::streambuf* coutBuffer = cout.rdbuf();
+   ThreadRoutedBuffer routedBuffer (coutBuffer);
+   cout.rdbuf(&routedBuffer);
+
+   OINFO<<"Waiting for connections on "<<nThreads<<" worker threads...\n"<<endl;
+   std::vector<int> ready;
+   bool listenReady = false;
+   while (!m_stop)
+   {
+      if (!m_poller->wait(ready, listenReady))
+         error("Error waiting on sockets.");
+
+      if (listenReady)
+         acceptConnections();
+
+      for (std::vector<int>::const_iterator i = ready.begin(); i != ready.end(); ++i)
+         readConnection(*i);
+   }
+
+   // Shut down: drop queued requests, wait out running ones (the queue destructor cancels and
+   // joins its threads), then drop the clients.
+   m_jobQueue->getJobQueue()->clear();
+   m_jobQueue.reset();
+
+   std::vector<int> fds;
+   {
+      std::lock_guard<std::mutex> lock (m_mutex);
+      for (std::map<int, std::shared_ptr<Connection> >::iterator i = m_connections.begin();
+           i != m_connections.end(); ++i)
+         fds.push_back(i->first);
+   }
+   for (std::vector<int>::const_iterator i = fds.begin(); i != fds.end(); ++i)
+      closeConnection(*i);
+
+   cout.rdbuf(coutBuffer);
+   m_poller.reset();
+   close(m_svrsockfd);
+   m_svrsockfd = -1;
+   if (!m_localPath.empty())
+   {
+      unlink(m_localPath.c_str());
+      m_localPath.clear();
    }
+   m_stop = false;
 }
 
 void ossimToolServer::initSocket(const char* portid)
 {
+   if (strchr(portid, '/'))
+   {
+      initLocalSocket(portid);
+      return;
+   }
+
    // Establish full server address including port:
    struct addrinfo hints;
    memset(&hints, 0, sizeof hints); // make sure the struct is empty
@@ -180,160 +576,323 @@ void ossimToolServer::initSocket(const char* portid)
    if ( bindResult < 0)
       error("Error on binding to socket:port.");
 
-   struct sockaddr_in *server_addr = (sockaddr_in*) &(server_info->ai_addr);
-
    OINFO<<"ossimToolServer daemon started. Listening on port "<<portid<<". Process ID: "<<getpid()<<"\n"<<endl;
-   freeaddrinfo(server_info);
+   freeaddrinfo(res);
 
    // Start listening:
-   if (listen(m_svrsockfd, 5) == -1)
+   if (listen(m_svrsockfd, SOMAXCONN) == -1)
       error("Error on listen()");
+   setNonBlocking(m_svrsockfd);
 
-   // Reap all dead processes:
-   struct sigaction sa;
-   sa.sa_handler = ossimToolServer::sigchld_handler;
-   sigemptyset(&sa.sa_mask);
-   sa.sa_flags = SA_RESTART;
-   if (sigaction(SIGCHLD, &sa, NULL) == -1)
-      error("Error on sigaction()");
+   m_poller.reset(new Poller);
+   if (!m_poller->init(m_svrsockfd))
+      error("Error initializing socket poller");
 }
 
-void ossimToolServer::sigchld_handler(int s)
+void ossimToolServer::initLocalSocket(const char* path)
 {
-   // waitpid() might overwrite errno, so we save and restore it:
-   int saved_errno = errno;
-   while(waitpid(-1, NULL, WNOHANG) > 0);
-   errno = saved_errno;
-}
+   // A unix domain socket for clients on the same host, saving the TCP stack on every request:
+   struct sockaddr_un addr;
+   memset(&addr, 0, sizeof addr);
+   addr.sun_family = AF_UNIX;
+   if (strlen(path) >= sizeof(addr.sun_path))
+      error("Local socket path too long.");
+   strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+   m_svrsockfd = socket(AF_UNIX, SOCK_STREAM, 0);
+   if (m_svrsockfd < 0)
+      error("Error opening socket");
 
-void ossimToolServer::error(const char* msg)
-{
-   perror(msg);
-   exit (1);
+   // A socket left over from a server that did not shut down cleanly is replaced, anything else
+   // at the path is left alone:
+   struct stat st;
+   if (lstat(path, &st) == 0)
+   {
+      if (!S_ISSOCK(st.st_mode))
+      {
+         errno = EEXIST;
+         error("Local socket path exists and is not a socket");
+      }
+      unlink(path);
+   }
+   if (::bind(m_svrsockfd, (struct sockaddr *) &addr, sizeof addr) < 0)
+      error("Error on binding to local socket.");
+   m_localPath = path;
+
+   OINFO<<"ossimToolServer daemon started. Listening on "<<path<<". Process ID: "<<getpid()<<"\n"<<endl;
+
+   if (listen(m_svrsockfd, SOMAXCONN) == -1)
+      error("Error on listen()");
+   setNonBlocking(m_svrsockfd);
+
+   m_poller.reset(new Poller);
+   if (!m_poller->init(m_svrsockfd))
+      error("Error initializing socket poller");
 }
 
-void ossimToolServer::writeSocket(const char* buf, int bufsize)
+void ossimToolServer::acceptConnections()
 {
-   int remaining = bufsize;
-   int n;
+   while (1)
+   {
+      struct sockaddr_storage cli_addr;
+      socklen_t clilen = sizeof(cli_addr);
+      int fd = accept(m_svrsockfd, (struct sockaddr *) &cli_addr, &clilen);
+      if (fd < 0)
+      {
+         if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+            OWARN<<"ossimToolServer: Error accepting connection: "<<strerror(errno)<<endl;
+         break;
+      }
+      setNonBlocking(fd);
 
-   //int optval = 1;
-   //setsockopt(clientfd, IPPROTO_TCP, TCP_NODELAY, &optval, sizeof(int));
+      std::string peer = "local";
+      if (cli_addr.ss_family != AF_UNIX)
+      {
+         int one = 1;
+         setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+         char clientname[256];
+         char clientport[256];
+         clientname[0] = clientport[0] = 0;
+         getnameinfo((struct sockaddr *) &cli_addr, clilen, clientname, 256, clientport, 256,
+                     NI_NUMERICHOST | NI_NUMERICSERV);
+         peer = std::string(clientname) + ":" + clientport;
+      }
+      if (_DEBUG_) OINFO<<"ossimToolServer: Got connection from "<<peer<<endl;
 
-   while (remaining)
-   {
-      n = send(m_clisockfd, buf, remaining, 0);
-      if (n < 0)
-         error("ERROR writing to socket");
-      remaining -= n;
+      std::shared_ptr<Connection> conn = std::make_shared<Connection>(fd, peer);
+      {
+         std::lock_guard<std::mutex> lock (m_mutex);
+         m_connections[fd] = conn;
+         ++m_metrics.m_connections;
+      }
+      if (!m_poller->add(fd))
+         closeConnection(fd);
    }
 }
 
-bool ossimToolServer::sendFile(const ossimFilename& fname)
+void ossimToolServer::readConnection(int fd)
 {
-   ostringstream xmsg;
+   std::shared_ptr<Connection> conn;
+   {
+      std::lock_guard<std::mutex> lock (m_mutex);
+      std::map<int, std::shared_ptr<Connection> >::iterator i = m_connections.find(fd);
+      if (i == m_connections.end())
+         return;
+      conn = i->second;
+   }
 
-   // Open the server-side image file:
-   ifstream svrfile (fname.chars(), ios::binary|ios::in);
-   if (svrfile.fail())
+   // Drain what the client sent:
+   char buf[MAX_BUF_LEN];
+   bool closed = false;
+   while (1)
    {
-      xmsg<<"ossimToolServer.sendFile() -- Error opening file <"<<fname<<">."<<endl;
-      error(xmsg.str().c_str());
+      ssize_t n = recv(fd, buf, MAX_BUF_LEN, 0);
+      if (n > 0)
+      {
+         conn->m_input.append(buf, n);
+         continue;
+      }
+      if ((n < 0) && (errno == EINTR))
+         continue;
+      if ((n == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK)))
+         closed = true;
+      break;
    }
 
-   // Determine file size:
-   std::streampos fsize = svrfile.tellg();
-   svrfile.seekg( 0, std::ios::end );
-   fsize = svrfile.tellg() -fsize;
-   svrfile.seekg( 0, std::ios::beg );
+   if (dispatchRequest(conn))
+      return; // Worker owns the connection until the response is sent.
+
+   if (closed || conn->m_closing)
+      closeConnection(fd);
+   else if (!m_poller->rearm(fd))
+      closeConnection(fd);
+}
 
-   // Send file size to the client:
-   char size_response[19];
-   sprintf(size_response, "SIZE: %012d", (int) fsize);
-   if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" sending <"<<size_response<<">"<<endl; //TODO REMOVE DEBUG
-   writeSocket(size_response, strlen(size_response));
-   if (!acknowledgeRcvd())
+bool ossimToolServer::dispatchRequest(std::shared_ptr<Connection> conn)
+{
+   if (conn->m_input.size() < 4)
       return false;
 
-   // Send file name to the client:
-   char name_response[256];
-   memset(name_response, 0, 256);
-   sprintf(name_response, "NAME: %s", fname.file().chars());
-   if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" sending <"<<name_response<<">"<<endl; //TODO REMOVE DEBUG
-   writeSocket(name_response, strlen(name_response));
-   if (!acknowledgeRcvd())
+   ossim_uint32 length = ossimToolProtocol::decodeU32((const ossim_uint8*) conn->m_input.data());
+   if (length > ossimToolProtocol::MAX_REQUEST_SIZE)
+   {
+      OWARN<<"ossimToolServer: Request of "<<length<<" bytes from "<<conn->m_peer
+           <<" is too large. Closing connection."<<endl;
+      conn->m_closing = true;
+      return false;
+   }
+   if (conn->m_input.size() < 4 + (size_t) length)
       return false;
 
-   memset(m_buffer, 0, MAX_BUF_LEN);
+   std::string command = conn->m_input.substr(4, length);
+   conn->m_input.erase(0, 4 + length);
 
-   // Send image in MAX_BUF_LEN byte packets
-   int n = 0;
-   int r = 0;
-   if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" sending binary data..."<<endl; //TODO REMOVE DEBUG
-   while (!svrfile.eof())
+   std::shared_ptr<RequestJob> job =
+      std::make_shared<RequestJob>(this, conn, command, std::chrono::steady_clock::now());
+   job->ready();
+   m_jobQueue->getJobQueue()->add(job);
+   return true;
+}
+
+void ossimToolServer::processRequest(std::shared_ptr<Connection> conn,
+                                     std::string& commandString,
+                                     std::chrono::steady_clock::time_point received)
+{
+   if (_DEBUG_)
    {
-      // Read server-side file block:
-      svrfile.read(m_buffer, MAX_BUF_LEN);
-      if (svrfile.bad())
-         error("ossimToolServer.sendFile() -- Error during file read()");
+      OINFO << "\nossimToolServer: received message from: "<<conn->m_peer
+            <<"\n---------------\n"<<commandString<<"\n---------------\n"<< endl;
+   }
+
+   ossimString command (commandString);
+   command.trim();
 
-      n = svrfile.gcount();
-      r += n;
+   bool status_ok = true;
+   if (command == "goodbye")
+      conn->m_closing = true;
+   else
+      status_ok = runCommand(*conn, command);
 
-      // transmit the block to the client:
-      writeSocket(m_buffer, n);
+   std::chrono::duration<double> latency = std::chrono::steady_clock::now() - received;
+   recordRequest(latency.count(), status_ok);
+
+   // Serve any pipelined request already read, otherwise go back to waiting on the client:
+   if (conn->m_closing)
+      closeConnection(conn->m_fd);
+   else if (!dispatchRequest(conn))
+   {
+      if (conn->m_closing || !m_poller->rearm(conn->m_fd))
+         closeConnection(conn->m_fd);
    }
-   if (!acknowledgeRcvd())
-      return false;
+}
 
-   cout << "Send complete."<<endl;
-   svrfile.close();
-   return true;
+void ossimToolServer::recordRequest(double seconds, bool ok)
+{
+   std::lock_guard<std::mutex> lock (m_mutex);
+   ++m_metrics.m_requests;
+   if (!ok)
+      ++m_metrics.m_errors;
+   m_metrics.m_totalSeconds += seconds;
+   if (seconds > m_metrics.m_maxSeconds)
+      m_metrics.m_maxSeconds = seconds;
+
+   int bucket = 0;
+   double limit = 0.001;
+   while ((bucket < NUM_LATENCY_BUCKETS - 1) && (seconds >= limit))
+   {
+      ++bucket;
+      limit *= 2.0;
+   }
+   ++m_metrics.m_histogram[bucket];
+}
+
+void ossimToolServer::closeConnection(int fd)
+{
+   {
+      std::lock_guard<std::mutex> lock (m_mutex);
+      if (!m_connections.erase(fd))
+         return;
+   }
+   m_poller->remove(fd);
+   close(fd);
+}
+
+void ossimToolServer::error(const char* msg)
+{
+   perror(msg);
+   exit (1);
 }
-bool ossimToolServer::acknowledgeRcvd()
+
+bool ossimToolServer::writeResponse(Connection& conn, const char* type, const std::string& text)
 {
-   if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" Waiting to recv"<<endl; //TODO REMOVE DEBUG
-   int n = recv(m_clisockfd, m_buffer, 11, 0);
-   if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" Received <"<<m_buffer<<">"<<endl; //TODO REMOVE DEBUG
-   if (n < 0)
-      error("ossimToolServer: EOF encountered reading from port");
-   if (strcmp(m_buffer, "ok_to_send"))
+   ossim_uint8 length[8];
+   ossimToolProtocol::encodeU64(text.size(), length);
+
+   struct iovec iov[3];
+   iov[0].iov_base = (void*) type;
+   iov[0].iov_len = ossimToolProtocol::TYPE_SIZE;
+   iov[1].iov_base = length;
+   iov[1].iov_len = 8;
+   iov[2].iov_base = (void*) text.data();
+   iov[2].iov_len = text.size();
+
+   if (!writeAll(conn.m_fd, iov, 3))
+   {
+      conn.m_closing = true;
       return false;
-   if (_DEBUG_) cout << "Send acknowledged by client."<<endl;
+   }
    return true;
 }
 
-bool ossimToolServer::runCommand(ossimString& command)
+bool ossimToolServer::sendFile(Connection& conn, const std::string& text, const ossimFilename& fname)
+{
+   // Open the server-side product file:
+   int filefd = open(fname.chars(), O_RDONLY);
+   struct stat st;
+   if ((filefd < 0) || (fstat(filefd, &st) != 0))
+   {
+      if (filefd >= 0)
+         close(filefd);
+      ostringstream xmsg;
+      xmsg<<"ossimToolServer.sendFile() -- Error opening file <"<<fname<<">."<<endl;
+      writeResponse(conn, ossimToolProtocol::ERROR_TYPE, text + xmsg.str());
+      return false;
+   }
+
+   // Header, console text, name and size go out in one gather write, then the file itself:
+   std::string name = fname.file().string();
+   ossim_uint8 textLength[8];
+   ossim_uint8 nameLength[4];
+   ossim_uint8 fileSize[8];
+   ossimToolProtocol::encodeU64(text.size(), textLength);
+   ossimToolProtocol::encodeU32((ossim_uint32) name.size(), nameLength);
+   ossimToolProtocol::encodeU64((ossim_uint64) st.st_size, fileSize);
+
+   struct iovec iov[6];
+   iov[0].iov_base = (void*) ossimToolProtocol::FILE_TYPE;
+   iov[0].iov_len = ossimToolProtocol::TYPE_SIZE;
+   iov[1].iov_base = textLength;
+   iov[1].iov_len = 8;
+   iov[2].iov_base = (void*) text.data();
+   iov[2].iov_len = text.size();
+   iov[3].iov_base = nameLength;
+   iov[3].iov_len = 4;
+   iov[4].iov_base = (void*) name.data();
+   iov[4].iov_len = name.size();
+   iov[5].iov_base = fileSize;
+   iov[5].iov_len = 8;
+
+   bool ok = writeAll(conn.m_fd, iov, 6) && sendFileData(conn.m_fd, filefd, st.st_size);
+   close(filefd);
+   if (!ok)
+      conn.m_closing = true; // Stream is out of sync with the client now.
+   return ok;
+}
+
+bool ossimToolServer::runCommand(Connection& conn, ossimString& command)
 {
-   ostringstream xmsg;
    bool status_ok = false;
    static const char* msg = "\nossimToolServer.runCommand(): ";
 
    // Intercept test mode:
-   if (command == "sendfile")
+   if (command.before(" ") == "sendfile")
    {
       ossimFilename fname = command.after("sendfile").trim();
-      const char* response = "FILE ";
-      writeSocket(response, strlen(response));
-      sendFile(fname);
-      return true;
+      return sendFile(conn, std::string(), fname);
    }
 
-   // Redirect stdout:
-   memset(m_buffer, 0, MAX_BUF_LEN);
-   int pipeDesc[2] = {0,0};
-   int savedStdout = dup( fileno(stdout) );
-   if( pipe( pipeDesc ) == -1 )
-      error("Could not redirect stdout (1).");
-   setbuf( stdout, NULL );
-   dup2( pipeDesc[1], fileno(stdout) );
+   // Intercept metrics request:
+   if (command == "stats")
+   {
+      ostringstream out;
+      getMetrics().print(out);
+      return writeResponse(conn, ossimToolProtocol::TEXT_TYPE, out.str());
+   }
 
-#ifdef _MSC_VER
-   u_long iMode = 1;
-   ioctlsocket(pipeDesc[0], FIONBIO, &iMode);
-#else
-   fcntl( pipeDesc[0], F_SETFL, O_NONBLOCK );
-#endif
+   // Capture console output of this thread:
+   string full_output;
+   ThreadRoutedBuffer::s_capture = &full_output;
 
    ossimToolFactoryBase* factory = ossimToolRegistry::instance();
    ossimRefPtr<ossimTool> utility = 0;
@@ -391,86 +950,31 @@ bool ossimToolServer::runCommand(ossimString& command)
       break;
    }
 
-   // Stop redirecting stdout and copy the output stream buffer to local memory:
-   dup2( savedStdout, fileno(stdout) );
-   int n = MAX_BUF_LEN;
-   string full_output;
-   while (n == MAX_BUF_LEN)
-   {
-       n = read(pipeDesc[0], m_buffer, MAX_BUF_LEN);
-       if (n > 0)
-          full_output.append(m_buffer, n);
-   }
+   // Stop capturing:
+   ThreadRoutedBuffer::s_capture = 0;
 
    if (status_ok)
    {
-      if (utility.valid() && !utility->helpRequested() && utility->isChipProcessor())
+      ossimChipProcTool* ocp = dynamic_cast<ossimChipProcTool*>(utility.get());
+      ossimChipperTool* chipper = dynamic_cast<ossimChipperTool*>(utility.get());
+      if (utility.valid() && !utility->helpRequested() && ocp)
+      {
+         status_ok = sendFile(conn, full_output, ocp->getProductFilename());
+      }
+      else if (utility.valid() && !utility->helpRequested() && chipper)
       {
-         const char* response = "FILE ";
-         writeSocket(response, strlen(response));
-         ossimChipProcTool* ocp = (ossimChipProcTool*) utility.get();
-         ossimFilename prodFilename = ocp->getProductFilename();
-         sendFile(prodFilename);
+         status_ok = sendFile(conn, full_output, chipper->getProductFilename());
       }
       else
       {
-         const char* response = "TEXT ";
-         writeSocket(response, strlen(response));
-         writeSocket(full_output.c_str(), full_output.size());
-         if (!acknowledgeRcvd())
-            error("ERROR receiving acknowledge from client.");
+         status_ok = writeResponse(conn, ossimToolProtocol::TEXT_TYPE, full_output);
       }
    }
    else
    {
-      const char* response = "ERROR";
-      writeSocket(response, strlen(response));
-      writeSocket(full_output.c_str(), full_output.size());
-      cout << "Sending ERROR to client and closing connection: <"<<full_output<<">"<<endl;
-      close(m_clisockfd);
+      writeResponse(conn, ossimToolProtocol::ERROR_TYPE, full_output);
+      if (_DEBUG_) OINFO << "Sending ERROR to client: <"<<full_output<<">"<<endl;
    }
 
    return status_ok;
 }
-
-bool ossimToolServer::processOssimRequest(struct sockaddr_in& cli_addr)
-{
-   char dst[INET6_ADDRSTRLEN];
-
-   // TEST CODE:
-   cout << "\nprocessOssimRequest() -- Process ID: "<<getpid()<<endl;
-   cout <<   "                  Parent process ID: "<<getppid()<<endl;
-
-   // Clear the input m_buffer and read the message sent:
-   memset(m_buffer, 0, MAX_BUF_LEN);
-   if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" Waiting to recv"<<endl; //TODO REMOVE DEBUG
-   int n = recv(m_clisockfd, m_buffer, MAX_BUF_LEN, 0);
-   if (_DEBUG_) cout<<"ossimToolServer:"<<__LINE__<<" Received <"<<m_buffer<<">"<<endl; //TODO REMOVE DEBUG
-   if (n < 0)
-      error("ossimToolServer: EOF encountered reading from port");
-
-   // If message received, acknowledge back:
-   if (n != 0)
-   {
-      // Log the message received:
-      void* addr = &(cli_addr.sin_addr);
-      if (!inet_ntop(AF_INET, addr, dst, INET6_ADDRSTRLEN))
-         error("ossimToolServer: Error returned from inet_ntop(). ");
-      cout << "\nossimToolServer: received message from: "<<dst<<"\n---------------\n"<<m_buffer
-            <<"\n---------------\n"<< endl;
-
-      // process request:
-      ossimString command (m_buffer);
-      command.trim();
-
-      if (command == "goodbye")
-      {
-         close(m_clisockfd);
-         return true;
-      }
-
-      runCommand(command);
-      return true;
-   }
-   return false;
-}
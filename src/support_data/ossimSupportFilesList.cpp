@@ -34,6 +34,7 @@ ossimSupportFilesList* ossimSupportFilesList::instance()
 void ossimSupportFilesList::save(ossimKeywordlist& kwl, const char* prefix) const
 {
    ossimString baseName ("support_file");
+   std::lock_guard<std::mutex> lock(m_mutex);
    for (unsigned int i=0; i< (unsigned int) m_list.size(); i++)
    {
       ossimString key = baseName + ossimString::toString(i);
@@ -7,6 +7,7 @@
 
 #include <ossim/base/ossimArgumentParser.h>
 #include <ossim/base/ossimApplicationUsage.h>
+#include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimConnectableObject.h>
 #include <ossim/base/ossimException.h>
 #include <ossim/base/ossimFilename.h>
@@ -14,11 +15,13 @@
 #include <ossim/base/ossimKeywordlist.h>
 #include <ossim/base/ossimKeywordNames.h>
 #include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
 #include <ossim/base/ossimProperty.h>
 #include <ossim/base/ossimRefreshEvent.h>
 #include <ossim/base/ossimScalarTypeLut.h>
 #include <ossim/base/ossimStdOutProgress.h>
 #include <ossim/base/ossimStringProperty.h>
+#include <ossim/base/ossimTimer.h>
 #include <ossim/base/ossimTrace.h>
 #include <ossim/base/ossimVisitor.h>
 #include <ossim/imaging/ossimImageData.h>
@@ -37,8 +40,12 @@
 #include <ossim/projection/ossimProjectionFactoryRegistry.h>
 #include <ossim/projection/ossimUtmProjection.h>
 #include <ossim/elevation/ossimElevManager.h>
+#include <ossim/parallel/ossimParallelChipSequencer.h>
+#include <ossim/parallel/ossimParallelFor.h>
 #include <ossim/util/ossimChipProcTool.h>
+#include <atomic>
 #include <cmath>
+#include <iomanip>
 #include <sstream>
 #include <string>
 
@@ -56,6 +63,7 @@ static const std::string OUTPUT_RADIOMETRY_KW    = "output_radiometry";
 static const std::string READER_PROPERTY_KW      = "reader_property";
 static const std::string SNAP_TIE_TO_ORIGIN_KW   = "snap_tie_to_origin";
 static const std::string SRS_KW                  = "srs";
+static const std::string THREADS_KW              = "threads";
 static const std::string TILE_SIZE_KW            = "tile_size"; // pixels
 static const std::string TRUE_KW                 = "true";
 static const std::string WRITER_KW               = "writer";
@@ -65,14 +73,16 @@ ossimChipProcTool::ossimChipProcTool( const ossimChipProcTool& /* obj */)
 : m_projIsIdentity(false),
   m_geoScaled (false),
   m_productScalarType(OSSIM_SCALAR_UNKNOWN),
-  m_needCutRect(false)
+  m_needCutRect(false),
+  m_tiledWrite(false)
 {}
 
 ossimChipProcTool::ossimChipProcTool()
 :  m_projIsIdentity(false),
    m_geoScaled(false),
    m_productScalarType(OSSIM_SCALAR_UNKNOWN),
-   m_needCutRect(false)
+   m_needCutRect(false),
+   m_tiledWrite(false)
 {
    m_kwl.setExpandEnvVarsFlag(true);
    m_gsd.makeNan();
@@ -94,6 +104,7 @@ void ossimChipProcTool::clear()
    m_writer = 0;
    m_geom = 0;
    m_needCutRect = false;
+   m_chipRenderer.clear();
 }
 
 bool ossimChipProcTool::initialize(ossimArgumentParser& ap)
@@ -238,6 +249,9 @@ bool ossimChipProcTool::initialize(ossimArgumentParser& ap)
       m_kwl.addPair( SRS_KW, os.string() );
    }
 
+   if( ap.read("--threads", stringParam1) )
+      m_kwl.addPair( THREADS_KW, tempString1 );
+
    if( ap.read("--tile-size", stringParam1) )
       m_kwl.addPair( TILE_SIZE_KW, tempString1 );
 
@@ -338,6 +352,9 @@ void ossimChipProcTool::initialize( const ossimKeywordlist& kwl )
 
    m_productFilename = m_kwl.findKey( std::string(ossimKeywordNames::OUTPUT_FILE_KW) );
 
+   m_chipRenderer.clear();
+   m_chipRenderer.setNumberOfThreads( ossimString(m_kwl.findKey( THREADS_KW )).toUInt32() );
+
    // Create chains for input sources.
    loadImageFiles();
 
@@ -412,8 +429,25 @@ bool ossimChipProcTool::execute()
       throw ossimException(xmsg.str());
    }
 
-   // Set up the writer.
+   //---
+   // Set up the writer. Tiled writes stream the product through a strip at a time, rendered on
+   // the clones the chip renderer keeps of the chain, and come out in tile order. Unless the
+   // threads were given they start on all cores and the sequencer drops to one for a chain too
+   // cheap to gain from them.
+   //---
    m_writer = newWriter();
+   ossimRefPtr<ossimParallelChipSequencer> sequencer = 0;
+   bool adaptive = false;
+   if (m_tiledWrite)
+   {
+      sequencer = new ossimParallelChipSequencer(&m_chipRenderer);
+      adaptive = m_kwl.findKey( THREADS_KW ).empty() &&
+                 !ossimPreferences::instance()->findPreference("chip.threads");
+      if (adaptive)
+         m_chipRenderer.setNumberOfThreads( ossim::getNumberOfThreads() );
+      sequencer->setAdaptiveThreads(adaptive);
+      m_writer->changeSequencer(sequencer.get());
+   }
 
    // Connect the writer to the processing chain.
    m_writer->connectMyInputTo(0, m_procChain.get());
@@ -430,7 +464,12 @@ bool ossimChipProcTool::execute()
    m_writer->addListener(&prog);
 
    // Write the file:
+   ossimTimer* timer = ossimTimer::instance();
+   const ossimTimer::Timer_t T0 = timer->tick();
    m_writer->execute();
+   const double SECONDS = timer->delta_s(T0, timer->tick());
+   if (adaptive)
+      m_chipRenderer.setNumberOfThreads(0); // Back to the default for chips.
    m_writer->removeListener(&prog);
    if(m_writer->isAborted())
    {
@@ -440,6 +479,20 @@ bool ossimChipProcTool::execute()
 
    ossimNotify(ossimNotifyLevel_INFO)<<"Wrote product image to <"<<m_productFilename<<">"<<endl;
 
+   // Throughput, and where the time went for tiled writes:
+   const double MPIX = static_cast<double>(m_aoiViewRect.width()) * m_aoiViewRect.height() / 1.0e6;
+   ossimNotify(ossimNotifyLevel_INFO)
+      << std::setiosflags(ios::fixed) << std::setprecision(2)
+      << MPIX << " Mpix in " << SECONDS << " s, "
+      << ( (SECONDS > 0.0) ? MPIX / SECONDS : 0.0 ) << " Mpix/s";
+   if (sequencer.valid())
+   {
+      ossimNotify(ossimNotifyLevel_INFO)
+         << ", " << sequencer->getNumberOfThreads() << " thread(s), "
+         << sequencer->getRenderSeconds() << " s rendering";
+   }
+   ossimNotify(ossimNotifyLevel_INFO) << std::resetiosflags(ios::fixed) << endl;
+
    return true;
 }
 
@@ -511,7 +564,7 @@ ossimRefPtr<ossimImageData> ossimChipProcTool::getChip(const ossimIrect& boundin
       m_procChain->add(m_cutRectFilter.get());
    }
    m_cutRectFilter->setRectangle( m_aoiViewRect );
-   return m_procChain->getTile( m_aoiViewRect, 0 );
+   return m_chipRenderer.getChip( m_procChain.get(), m_aoiViewRect, 0 );
 }
 
 ossimRefPtr<ossimImageData> ossimChipProcTool::getChip()
@@ -519,7 +572,7 @@ ossimRefPtr<ossimImageData> ossimChipProcTool::getChip()
    ossimRefPtr<ossimImageData> chip = 0;
    if(m_procChain.valid())
    {
-      chip = m_procChain->getTile( m_aoiViewRect, 0 );
+      chip = m_chipRenderer.getChip( m_procChain.get(), m_aoiViewRect, 0 );
    }
    return chip;
 }
@@ -1426,6 +1479,115 @@ ossimRefPtr<ossimImageSource> ossimChipProcTool::mosaicDemSources()
    return demMosaic;
 }
 
+ossimRefPtr<ossimHistogram> ossimChipProcTool::computeHistogram(ossimImageHandler* handler,
+                                                                ossim_uint32 band,
+                                                                ossim_uint64 maxPixels)
+{
+   // Bins past this add nothing to thresholds and the like but memory per thread:
+   static const ossim_uint32 MAX_BINS = 4096;
+
+   ossimRefPtr<ossimHistogram> result = 0;
+   if (!handler || (band >= handler->getNumberOfOutputBands()))
+      return result;
+
+   // The finest level small enough, else the coarsest there is:
+   const ossim_uint32 LEVELS = handler->getNumberOfDecimationLevels();
+   ossim_uint32 resLevel = 0;
+   ossimIrect rect = handler->getBoundingRect(0);
+   while ( (resLevel + 1 < LEVELS) &&
+           ((ossim_uint64)rect.width() * (ossim_uint64)rect.height() > maxPixels) )
+   {
+      rect = handler->getBoundingRect(++resLevel);
+   }
+   if (rect.hasNans())
+      return result;
+
+   ossim_uint32 bins = 0;
+   ossim_float32 minValue = 0;
+   ossim_float32 maxValue = 0;
+   ossim_float32 nullValue = 0;
+   if (!ossim::getBinInformation(handler, band, bins, minValue, maxValue, nullValue))
+      return result;
+   const ossimScalarType SCALAR = handler->getOutputScalarType();
+   if ((SCALAR == OSSIM_FLOAT32) || (SCALAR == OSSIM_FLOAT64))
+   {
+      minValue = (ossim_float32) handler->getMinPixelValue(band);
+      maxValue = (ossim_float32) handler->getMaxPixelValue(band);
+   }
+   bins = ossim::min<ossim_uint32>(bins, MAX_BINS);
+   if (!bins || !(maxValue > minValue))
+      return result;
+
+   const ossimIpt TILE_SIZE = m_chipRenderer.getTileSize();
+   const ossim_uint32 TILES_X = (rect.width()  + TILE_SIZE.x - 1) / TILE_SIZE.x;
+   const ossim_uint32 TILES_Y = (rect.height() + TILE_SIZE.y - 1) / TILE_SIZE.y;
+   const ossim_uint32 TILES   = TILES_X * TILES_Y;
+
+   // The calling thread reads on handler, the others on a handler of their own each:
+   std::vector< ossimRefPtr<ossimImageHandler> > handlers(1, handler);
+   const ossim_uint32 WORKERS = ossim::min<ossim_uint32>(m_chipRenderer.getNumberOfThreads(), TILES);
+   while (handlers.size() < WORKERS)
+   {
+      ossimRefPtr<ossimImageHandler> h =
+         ossimImageHandlerRegistry::instance()->open(handler->getFilename());
+      if ( !h.valid() || !h->setCurrentEntry(handler->getCurrentEntry()) ||
+           (h->getNumberOfDecimationLevels() != LEVELS) )
+         break;
+      handlers.push_back(h);
+   }
+
+   std::vector< ossimRefPtr<ossimHistogram> > histos(handlers.size());
+   std::atomic<ossim_uint32> next(0);
+   ossim::parallelFor((ossim_uint32) handlers.size(), (ossim_uint32) handlers.size(),
+                      [&](ossim_uint32 worker)
+   {
+      ossimRefPtr<ossimHistogram> histo =
+         new ossimHistogram(bins, minValue, maxValue, nullValue, SCALAR);
+      for (ossim_uint32 i = next++; i < TILES; i = next++)
+      {
+         const ossim_int32 X = rect.ul().x + (ossim_int32)(i % TILES_X) * TILE_SIZE.x;
+         const ossim_int32 Y = rect.ul().y + (ossim_int32)(i / TILES_X) * TILE_SIZE.y;
+         const ossimIrect TILE_RECT(X, Y,
+                                    ossim::min<ossim_int32>(X + TILE_SIZE.x - 1, rect.lr().x),
+                                    ossim::min<ossim_int32>(Y + TILE_SIZE.y - 1, rect.lr().y));
+         try
+         {
+            ossimRefPtr<ossimImageData> tile = handlers[worker]->getTile(TILE_RECT, resLevel);
+            if ( !tile.valid() || !tile->getBuf() ||
+                 (tile->getDataObjectStatus() == OSSIM_NULL) ||
+                 (tile->getDataObjectStatus() == OSSIM_EMPTY) )
+               continue;
+
+            const ossim_float64 NULL_PIX = tile->getNullPix(band);
+            const ossim_uint32 SIZE = tile->getSizePerBand();
+            for (ossim_uint32 p = 0; p < SIZE; ++p)
+            {
+               const ossim_float64 V = tile->getPix(p, band);
+               if (V != NULL_PIX)
+                  histo->UpCount(V);
+            }
+         }
+         catch (const std::exception& e)
+         {
+            ossimNotify(ossimNotifyLevel_WARN) << "ossimChipProcTool::computeHistogram caught "
+                                               "exception: " << e.what() << endl;
+         }
+      }
+      histos[worker] = histo;
+   });
+
+   // Reduce:
+   result = histos[0];
+   ossim_int64* counts = result->GetCounts();
+   for (ossim_uint32 w = 1; w < histos.size(); ++w)
+   {
+      const ossim_int64* other = histos[w]->GetCounts();
+      for (int b = 0; b < result->GetRes(); ++b)
+         counts[b] += other[b];
+   }
+   return result;
+}
+
 
 ossimRefPtr<ossimImageSource>
 ossimChipProcTool::combineLayers(std::vector< ossimRefPtr<ossimSingleImageChain> >& layers) const
@@ -1559,6 +1721,7 @@ void ossimChipProcTool::setUsage(ossimArgumentParser& ap)
    au->addCommandLineOption("--snap-tie-to-origin", "Snaps tie point to projection origin so that (tie-origin)/gsd come out on an even integer boundary.");
    au->addCommandLineOption("--srs","<src_code>\nSpecify a spatial reference system(srs) code for the output projection. Example: --srs EPSG:4326");
    au->addCommandLineOption("-t or --thumbnail", "<max_dimension>\nSpecify a thumbnail resolution.\nScale will be adjusted so the maximum dimension = argument given.");
+   au->addCommandLineOption("--threads", "<n>\nThreads to render chips and products on. Default is the \"chip.threads\" preference, else 1, the calling thread only. Without either, products written in tiles start on all cores and are cut to one if too cheap to gain from more.");
    au->addCommandLineOption("--tile-size", "<size_in_pixels>\nSets the output tile size if supported by writer.  Notes: This sets both dimensions. Must be a multiple of 16, e.g. 1024.");
    au->addCommandLineOption("-w or --writer","<writer>\nSpecifies the output writer.  Default uses output file extension to determine writer. For valid output writer types use: \"ossim-info --writers\"\n");
    au->addCommandLineOption("--writer-prop", "<writer-property>\nPasses a name=value pair to the writer for setting it's property. Any number of these can appear on the line.");
@@ -0,0 +1,169 @@
+//**************************************************************************************************
+//
+//     OSSIM Open Source Geospatial Data Processing Library
+//     See top level LICENSE.txt file for license information
+//
+//**************************************************************************************************
+
+#include <ossim/util/ossimChipperPool.h>
+#include <ossim/base/ossimNotify.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTrace.h>
+#include <sstream>
+
+static ossimTrace traceDebug("ossimChipperPool:debug");
+
+static const ossim_uint32 DEFAULT_MAX_IDLE = 8;
+
+ossimChipperPool* ossimChipperPool::instance()
+{
+   static ossimChipperPool inst;
+   return &inst;
+}
+
+ossimChipperPool::ossimChipperPool()
+   : m_mutex(),
+     m_idle(),
+     m_maxIdle(DEFAULT_MAX_IDLE),
+     m_stats()
+{
+   const char* lookup = ossimPreferences::instance()->findPreference("chipper_pool.size");
+   if (lookup)
+   {
+      m_maxIdle = ossimString(lookup).toUInt32();
+   }
+}
+
+std::string ossimChipperPool::getChainKey(const ossimKeywordlist& options)
+{
+   std::ostringstream key;
+   ossimKeywordlist::KeywordMap::const_iterator i = options.getMap().begin();
+   while (i != options.getMap().end())
+   {
+      if (!ossimChipperUtil::isViewOption(i->first))
+      {
+         key << i->first << "=" << i->second << "\n";
+      }
+      ++i;
+   }
+   return key.str();
+}
+
+void ossimChipperPool::execute(const ossimKeywordlist& options)
+{
+   const std::string KEY = getChainKey(options);
+   ossimRefPtr<ossimChipperUtil> chipper = checkOut(options, KEY);
+   chipper->execute();
+   checkIn(KEY, chipper);
+}
+
+ossimRefPtr<ossimImageData> ossimChipperPool::getChip(const ossimKeywordlist& options)
+{
+   const std::string KEY = getChainKey(options);
+   ossimRefPtr<ossimChipperUtil> chipper = checkOut(options, KEY);
+   ossimRefPtr<ossimImageData> chip = chipper->getChip();
+
+   // The chip may be the tile buffer of the chain, which the next request would write over:
+   ossimRefPtr<ossimImageData> result = 0;
+   if (chip.valid())
+   {
+      result = static_cast<ossimImageData*>(chip->dup());
+   }
+   checkIn(KEY, chipper);
+   return result;
+}
+
+void ossimChipperPool::setMaxIdle(ossim_uint32 maxIdle)
+{
+   std::list<Entry> released;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_maxIdle = maxIdle;
+      trim(released);
+   }
+}
+
+ossim_uint32 ossimChipperPool::getMaxIdle() const
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   return m_maxIdle;
+}
+
+ossimChipperPool::Stats ossimChipperPool::getStats() const
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   Stats result = m_stats;
+   result.m_idle = static_cast<ossim_uint32>(m_idle.size());
+   return result;
+}
+
+void ossimChipperPool::clear()
+{
+   std::list<Entry> released;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      released.swap(m_idle);
+   }
+   // Handlers are closed here, outside the lock.
+}
+
+ossimRefPtr<ossimChipperUtil> ossimChipperPool::checkOut(const ossimKeywordlist& options,
+                                                         const std::string& key)
+{
+   ossimRefPtr<ossimChipperUtil> chipper = 0;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (std::list<Entry>::iterator i = m_idle.begin(); i != m_idle.end(); ++i)
+      {
+         if (i->first == key)
+         {
+            chipper = i->second;
+            m_idle.erase(i);
+            break;
+         }
+      }
+      if (chipper.valid())
+      {
+         ++m_stats.m_hits;
+      }
+      else
+      {
+         ++m_stats.m_misses;
+      }
+   }
+
+   if (chipper.valid())
+   {
+      if (traceDebug())
+      {
+         ossimNotify(ossimNotifyLevel_DEBUG)
+            << "ossimChipperPool::checkOut: reusing chains for:\n" << key << std::endl;
+      }
+      chipper->setViewOptions(options);
+   }
+   else
+   {
+      chipper = new ossimChipperUtil();
+      chipper->initialize(options);
+   }
+   return chipper;
+}
+
+void ossimChipperPool::checkIn(const std::string& key, ossimRefPtr<ossimChipperUtil> chipper)
+{
+   std::list<Entry> released;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_idle.push_front(Entry(key, chipper));
+      trim(released);
+   }
+}
+
+void ossimChipperPool::trim(std::list<Entry>& released)
+{
+   while (m_idle.size() > m_maxIdle)
+   {
+      released.splice(released.end(), m_idle, --m_idle.end());
+   }
+}
@@ -0,0 +1,72 @@
+//**************************************************************************************************
+//
+//     OSSIM Open Source Geospatial Data Processing Library
+//     See top level LICENSE.txt file for license information
+//
+//**************************************************************************************************
+
+#include <ossim/util/ossimChipperTool.h>
+#include <ossim/util/ossimChipperPool.h>
+#include <ossim/util/ossimChipperUtil.h>
+#include <ossim/base/ossimApplicationUsage.h>
+#include <ossim/base/ossimKeywordNames.h>
+
+const char* ossimChipperTool::DESCRIPTION =
+   "Runs ossim-chipper commands, keeping the input chains open between requests.";
+
+ossimChipperTool::ossimChipperTool()
+:  m_productFilename()
+{
+}
+
+ossimChipperTool::~ossimChipperTool()
+{
+}
+
+void ossimChipperTool::setUsage(ossimArgumentParser& ap)
+{
+   ossimApplicationUsage* au = ap.getApplicationUsage();
+   ossimString usageString = ap.getApplicationName();
+   usageString += " chipper <ossim-chipper options> <input> <output>";
+   au->setCommandLineUsage(usageString);
+   au->setDescription(DESCRIPTION);
+}
+
+bool ossimChipperTool::initialize(ossimArgumentParser& ap)
+{
+   clear();
+
+   // The chipper knows its options. It is let go of before opening anything:
+   ossimRefPtr<ossimChipperUtil> chipper = new ossimChipperUtil();
+   if (!chipper->parseOptions(ap))
+   {
+      // Usage was written.
+      m_helpRequested = true;
+      return true;
+   }
+   m_kwl.getMap() = chipper->getOptions().getMap();
+   return true;
+}
+
+void ossimChipperTool::initialize(const ossimKeywordlist& kwl)
+{
+   clear();
+   m_kwl.getMap() = kwl.getMap();
+}
+
+bool ossimChipperTool::execute()
+{
+   if (m_helpRequested)
+      return true;
+
+   ossimChipperPool::instance()->execute(m_kwl);
+   m_productFilename = m_kwl.findKey(std::string(ossimKeywordNames::OUTPUT_FILE_KW));
+   return true;
+}
+
+void ossimChipperTool::clear()
+{
+   m_kwl.clear();
+   m_helpRequested = false;
+   m_productFilename.clear();
+}
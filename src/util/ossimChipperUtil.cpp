@@ -135,6 +135,7 @@ static const std::string SHARPEN_PERCENT_KW = "sharpen_percent";
 static const std::string SNAP_TIE_TO_ORIGIN_KW = "snap_tie_to_origin";
 static const std::string SRC_FILE_KW = "src_file";
 static const std::string SRS_KW = "srs";
+static const std::string THREADS_KW = "threads";
 static const std::string THREE_BAND_OUT_KW = "three_band_out";					// bool
 static const std::string THUMBNAIL_RESOLUTION_KW = "thumbnail_resolution"; // pixels
 static const std::string TILE_SIZE_KW = "tile_size";								// pixels
@@ -375,6 +376,8 @@ void ossimChipperUtil::clear()
       m_writer->disconnect();
       m_writer = 0;
    }
+
+   m_chipRenderer.clear();
 }
 
 bool ossimChipperUtil::initialize(ossimArgumentParser &ap)
@@ -386,6 +389,25 @@ bool ossimChipperUtil::initialize(ossimArgumentParser &ap)
       ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " entered...\n";
    }
 
+   if (!parseOptions(ap))
+   {
+      return false; // Indicates process should be terminated to caller.
+   }
+
+   initialize();
+
+   if (traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " exited..." << std::endl;
+   }
+   return true;
+
+} // End: void ossimChipperUtil::initialize(ossimArgumentParser& ap)
+
+bool ossimChipperUtil::parseOptions(ossimArgumentParser &ap)
+{
+   static const char MODULE[] = "ossimChipperUtil::parseOptions(ossimArgumentParser&)";
+
    clear();
    if (ap.read("-h") || ap.read("--help") || (ap.argc() == 1))
    {
@@ -912,15 +934,9 @@ bool ossimChipperUtil::initialize(ossimArgumentParser &ap)
 
    } // End: if ( ap.argc() > 2 )
 
-   initialize();
-
-   if (traceDebug())
-   {
-      ossimNotify(ossimNotifyLevel_DEBUG) << MODULE << " exited..." << std::endl;
-   }
    return true;
 
-} // End: void ossimChipperUtil::initialize(ossimArgumentParser& ap)
+} // End: bool ossimChipperUtil::parseOptions(ossimArgumentParser& ap)
 
 void ossimChipperUtil::initialize(const ossimKeywordlist &kwl)
 {
@@ -934,6 +950,84 @@ void ossimChipperUtil::initialize(const ossimKeywordlist &kwl)
    initialize();
 }
 
+const ossimKeywordlist& ossimChipperUtil::getOptions() const
+{
+   return *(m_kwl.get());
+}
+
+bool ossimChipperUtil::isViewOption(const std::string& key)
+{
+   // Keys read by createOutputProjection, getAreaOfInterest and createNewWriter only:
+   static const std::string VIEW_KEYS[] =
+   {
+      DEGREES_X_KW,
+      DEGREES_Y_KW,
+      FULLRES_XYS_KW,
+      IMAGE_SPACE_SCALE_X_KW,
+      IMAGE_SPACE_SCALE_Y_KW,
+      METERS_KW,
+      NORTH_UP_KW,
+      PAD_THUMBNAIL_KW,
+      ROTATE_TO_INPUT,
+      ROTATION_KW,
+      RRDS_KW,
+      SNAP_TIE_TO_ORIGIN_KW,
+      SRS_KW,
+      THREADS_KW,
+      THUMBNAIL_RESOLUTION_KW,
+      TILE_SIZE_KW,
+      UP_IS_UP_KW,
+      WRITER_KW,
+      std::string(ossimKeywordNames::CENTRAL_MERIDIAN_KW),
+      std::string(ossimKeywordNames::HEMISPHERE_KW),
+      std::string(ossimKeywordNames::ORIGIN_LATITUDE_KW),
+      std::string(ossimKeywordNames::OUTPUT_FILE_KW),
+      std::string(ossimKeywordNames::PROJECTION_KW),
+      std::string(ossimKeywordNames::ZONE_KW)
+   };
+
+   bool result = (key.compare(0, 4, "cut_") == 0) ||
+                 (key.compare(0, WRITER_PROPERTY_KW.size(), WRITER_PROPERTY_KW) == 0);
+   for (ossim_uint32 i = 0; !result && (i < sizeof(VIEW_KEYS) / sizeof(VIEW_KEYS[0])); ++i)
+   {
+      result = (key == VIEW_KEYS[i]);
+   }
+   return result;
+}
+
+void ossimChipperUtil::setViewOptions(const ossimKeywordlist& kwl)
+{
+   std::vector<std::string> keys;
+   ossimKeywordlist::KeywordMap::const_iterator i = m_kwl->getMap().begin();
+   while (i != m_kwl->getMap().end())
+   {
+      if (isViewOption(i->first))
+      {
+         keys.push_back(i->first);
+      }
+      ++i;
+   }
+   for (std::vector<std::string>::const_iterator key = keys.begin(); key != keys.end(); ++key)
+   {
+      m_kwl->remove(key->c_str());
+   }
+
+   i = kwl.getMap().begin();
+   while (i != kwl.getMap().end())
+   {
+      if (isViewOption(i->first))
+      {
+         m_kwl->addPair(i->first, i->second);
+      }
+      ++i;
+   }
+
+   // The combined source is made again for the new view on the next getChip:
+   m_source = 0;
+
+   initializeOutputProjection();
+}
+
 void ossimChipperUtil::initialize()
 {
    static const char MODULE[] = "ossimChipperUtil::initialize()";
@@ -1770,7 +1864,21 @@ ossimRefPtr<ossimImageData> ossimChipperUtil::getChip(const ossimKeywordlist &op
    if (m_source.valid())
    {
       ossimRefPtr<ossimImageSource> source = getFinalInput(aoi, m_source.get());
-      result = source->getTile(aoi);
+
+      // A viewport stretch works its histogram out on the first tile, which every clone of
+      // the chain would do again, so those chips stay on one thread:
+      ossim_uint32 threads = 0;
+      std::string value = m_kwl->findKey(THREADS_KW);
+      if (value.size())
+      {
+         threads = ossimString(value).toUInt32();
+      }
+      if (m_viewPortStretchEnabled)
+      {
+         threads = 1;
+      }
+      m_chipRenderer.setNumberOfThreads(threads);
+      result = m_chipRenderer.getChip(source.get(), aoi);
    }
 
    return result;
@@ -17,14 +17,144 @@
 // $Id$
 
 #include <ossim/util/ossimFileWalker.h>
+#include <ossim/base/ossimCommon.h>
 #include <ossim/base/ossimDirectory.h>
 #include <ossim/base/ossimFileProcessorInterface.h>
+#include <ossim/base/ossimNotify.h>
 #include <ossim/base/ossimTrace.h>
-#include <ossim/base/Thread.h>
 #include <ossim/parallel/ossimJobQueue.h>
+#include <ossim/parallel/ossimParallelFor.h>
+#include <sstream>
+#include <sys/types.h>
+#include <sys/stat.h>
+#if !defined(_WIN32)
+#  include <dirent.h>
+#  include <fcntl.h>
+#endif
 
 static ossimTrace traceDebug(ossimString("ossimFileWalker:debug"));
 
+// Jobs queued ahead of the processing threads before the crawl waits for them:
+static const ossim_uint32 MAX_QUEUED_JOBS = 4096;
+
+namespace
+{
+   // Recurse flag of the directory of the file processFile is running on in this thread, and
+   // whether that call turned it off:
+   thread_local std::atomic<bool>* s_recurseFlag = 0;
+   thread_local bool s_stoppedRecursion = false;
+
+   struct DirEntry
+   {
+      ossimFilename m_file;
+      bool          m_isDir;
+      ossim_int64   m_mtime;
+      ossim_int64   m_size; // Negative if not stat'ed.
+   };
+
+   //---
+   // Lists dir in one pass.  The type of an entry comes from the directory
+   // itself where the file system gives it, so only entries of unknown type,
+   // links and, if wantStamps, files are stat'ed, relative to the open
+   // directory to save the path lookups.
+   //---
+   bool listDirectory(const ossimFilename& dir, bool wantStamps, std::vector<DirEntry>& entries)
+   {
+#if defined(_WIN32)
+      ossimDirectory d;
+      if ( !d.open(dir) )
+      {
+         return false;
+      }
+      ossimFilename f;
+      bool valid_file = d.getFirst(f);
+      while ( valid_file )
+      {
+         DirEntry entry;
+         entry.m_file  = f;
+         entry.m_isDir = f.isDir();
+         entry.m_mtime = 0;
+         entry.m_size  = -1;
+         struct _stat64 sbuf;
+         if ( wantStamps && !entry.m_isDir && (_stat64(f.c_str(), &sbuf) == 0) )
+         {
+            entry.m_mtime = (ossim_int64)sbuf.st_mtime;
+            entry.m_size  = (ossim_int64)sbuf.st_size;
+         }
+         entries.push_back(entry);
+         valid_file = d.getNext(f);
+      }
+      return true;
+#else
+      DIR* d = opendir(dir.c_str());
+      if ( !d )
+      {
+         return false;
+      }
+      const int FD = dirfd(d);
+      struct dirent* e = 0;
+      while ( (e = readdir(d)) != 0 )
+      {
+         const char* name = e->d_name;
+         if ( (name[0] == '.') && ( !name[1] || ((name[1] == '.') && !name[2]) ) )
+         {
+            continue; // "." and ".."
+         }
+
+         DirEntry entry;
+         entry.m_file  = dir.dirCat(ossimFilename(name));
+         entry.m_isDir = false;
+         entry.m_mtime = 0;
+         entry.m_size  = -1;
+
+         bool known = false;
+#if defined(DT_DIR) && defined(DT_REG)
+         if ( e->d_type == DT_DIR )
+         {
+            entry.m_isDir = true;
+            known = true;
+         }
+         else if ( e->d_type == DT_REG )
+         {
+            known = true;
+         }
+#endif
+         if ( !known || (wantStamps && !entry.m_isDir) )
+         {
+            // Follows links, as ossimFilename::isDir does.
+            struct stat sbuf;
+            if ( fstatat(FD, name, &sbuf, 0) == 0 )
+            {
+               entry.m_isDir = S_ISDIR(sbuf.st_mode);
+               entry.m_mtime = (ossim_int64)sbuf.st_mtime;
+               entry.m_size  = (ossim_int64)sbuf.st_size;
+            }
+         }
+         entries.push_back(entry);
+      }
+      closedir(d);
+      return true;
+#endif
+   }
+
+   bool getStamp(const ossimFilename& file, ossim_int64& mtime, ossim_int64& size)
+   {
+#if defined(_WIN32)
+      struct _stat64 sbuf;
+      if ( _stat64(file.c_str(), &sbuf) != 0 )
+#else
+      struct stat sbuf;
+      if ( stat(file.c_str(), &sbuf) != 0 )
+#endif
+      {
+         return false;
+      }
+      mtime = (ossim_int64)sbuf.st_mtime;
+      size  = (ossim_int64)sbuf.st_size;
+      return true;
+   }
+}
+
 ossimFileWalker::ossimFileWalker()
    : m_fileProcessor(0),
      m_jobQueue(std::make_shared<ossimJobMultiThreadQueue>(std::make_shared<ossimJobQueue>(), 1)),     
@@ -32,7 +162,20 @@ ossimFileWalker::ossimFileWalker()
      m_recurseFlag(true),
      m_waitOnDirFlag(false),
      m_abortFlag(false),
-     m_mutex()
+     m_mutex(),
+     m_crawlThreads(ossim::getNumberOfThreads()),
+     m_dirStack(),
+     m_activeCrawlers(0),
+     m_crawlMutex(),
+     m_crawlCondition(),
+     m_outstandingJobs(0),
+     m_jobMutex(),
+     m_jobCondition(),
+     m_checkpointFile(),
+     m_checkpoint(),
+     m_checkpointStream(),
+     m_checkpointMutex(),
+     m_skippedFiles(0)
 {
 }
 
@@ -49,77 +192,47 @@ void ossimFileWalker::walk(const std::vector<ossimFilename>& files)
       ossimNotify(ossimNotifyLevel_DEBUG) << M << " entered\n";
    }
 
-   if ( files.size() )
+   // Must have call back set at this point.
+   if ( files.size() && !m_abortFlag && m_fileProcessor )
    {
+      beginWalk();
+
+      std::vector<ossimFilename> dirs;
       std::vector<ossimFilename>::const_iterator i = files.begin();
-      while ( i != files.end() )
+      while ( (i != files.end()) && !m_abortFlag )
       {
-         // Must have call back set at this point.
-         if ( !m_abortFlag && m_fileProcessor )
+         ossimFilename file = (*i).expand();
+         if ( file.size() && file.exists() )
          {
-            ossimFilename file = (*i).expand();
-            if ( file.size() && file.exists() )
+            if ( file.isDir() ) // Directory:
             {
-               if ( file.isDir() ) // Directory:
-               {
-                  walkDir(file);
-               }  
-               else // File:
+               dirs.push_back(file);
+            }  
+            else if ( isFiltered(file) == false ) // File:
+            {
+               FileStamp stamp;
+               if ( m_checkpointFile.size() )
                {
-                  if ( isFiltered(file) == false )
-                  {
-                     if(traceDebug())
-                     {
-                        ossimNotify(ossimNotifyLevel_DEBUG)
-                           << "Making the job for: " << (*i) << std::endl;
-                     }
-                     
-                     // Make the job:
-                     std::shared_ptr<ossimFileWalkerJob> job =
-                        std::make_shared<ossimFileWalkerJob>( m_fileProcessor, file );
-                     
-                     job->setName( ossimString( file.string() ) );
-                     
-                     job->setCallback( std::make_shared<ossimFileWalkerJobCallback>() );
-                     
-                     // Set the state to ready:
-                     job->ready();
-                     
-                     // Add job to the queue:
-                     m_jobQueue->getJobQueue()->add( job );
-                     
-                     m_mutex.lock();
-                     if ( m_abortFlag )
-                     {
-                        // Clear out the queue.
-                        m_jobQueue->getJobQueue()->clear();
-                        
-                        break; // Callee set our abort flag so break out of loop.
-                     }
-                     m_mutex.unlock();
-                  }
+                  getStamp(file, stamp.m_mtime, stamp.m_size);
                }
-            }
-            else
-            {
-               ossimNotify(ossimNotifyLevel_WARN)
-                  << M << " WARNING: file: \""<< file << "\" does not exist" << std::endl;
+               submit(file, stamp, std::shared_ptr<DirState>());
             }
          }
-
+         else
+         {
+            ossimNotify(ossimNotifyLevel_WARN)
+               << M << " WARNING: file: \""<< file << "\" does not exist" << std::endl;
+         }
          ++i;
       
       } // while ( i != files.end() )
 
-      // FOREVER loop until all jobs are completed.
-      while (1)
-      {
-         ossim::Thread::sleepInMicroSeconds(250);
-         if ( m_jobQueue->hasJobsToProcess() == false )
-         {
-            break;
-         }
-      }
+      crawl(dirs);
+
+      // Wait until all jobs are completed.
+      waitForJobs(0);
+
+      endWalk();
 
    } // if ( files.size() )
 
@@ -143,28 +256,43 @@ void ossimFileWalker::walk(const ossimFilename& root)
       ossimFilename rootFile = root.expand();
       if ( rootFile.size() && rootFile.exists() )
       {
+         beginWalk();
+
          if ( rootFile.isDir() )
          {
-            walkDir(rootFile);
+            crawl( std::vector<ossimFilename>(1, rootFile) );
 
-            // FOREVER loop until all jobs are completed.
-            while (1)
-            {
-               ossim::Thread::sleepInMicroSeconds(250);
-               if ( m_jobQueue->hasJobsToProcess() == false )
-               {
-                  break;
-               }
-            }
+            // Wait until all jobs are completed.
+            waitForJobs(0);
          }
          else
          {
             // Single file no job queue needed.
             if ( isFiltered( rootFile ) == false )
             {
-               m_fileProcessor->processFile( rootFile );
+               FileStamp stamp;
+               if ( m_checkpointFile.size() )
+               {
+                  getStamp(rootFile, stamp.m_mtime, stamp.m_size);
+               }
+               bool stopsRecursion = false;
+               if ( isUnchanged(rootFile, stamp, stopsRecursion) )
+               {
+                  ++m_skippedFiles;
+               }
+               else
+               {
+                  // No directory to stop, setRecurseFlag calls from processFile go nowhere:
+                  std::atomic<bool> ownRecurse(true);
+                  s_recurseFlag = &ownRecurse;
+                  m_fileProcessor->processFile( rootFile );
+                  s_recurseFlag = 0;
+                  checkpoint(rootFile, stamp);
+               }
             }
          }
+
+         endWalk();
       }
       else
       {
@@ -179,7 +307,56 @@ void ossimFileWalker::walk(const ossimFilename& root)
    }  
 }
 
-void ossimFileWalker::walkDir(const ossimFilename& dir)
+void ossimFileWalker::crawl(const std::vector<ossimFilename>& dirs)
+{
+   if ( dirs.empty() )
+   {
+      return;
+   }
+
+   m_crawlMutex.lock();
+   m_dirStack.assign(dirs.rbegin(), dirs.rend()); // First one on top.
+   m_activeCrawlers = 0;
+   m_crawlMutex.unlock();
+
+   ossim_uint32 threads = m_crawlThreads ? m_crawlThreads : 1;
+   ossim::parallelFor(threads, threads, [this](ossim_uint32) { crawlDirs(); });
+}
+
+void ossimFileWalker::crawlDirs()
+{
+   std::unique_lock<std::mutex> lock(m_crawlMutex);
+   while ( 1 )
+   {
+      // Wait for a directory, unless there is none and none coming:
+      while ( m_dirStack.empty() && m_activeCrawlers && !m_abortFlag )
+      {
+         m_crawlCondition.wait(lock);
+      }
+      if ( m_dirStack.empty() || m_abortFlag )
+      {
+         break;
+      }
+
+      ossimFilename dir = m_dirStack.back();
+      m_dirStack.pop_back();
+      ++m_activeCrawlers;
+      lock.unlock();
+
+      std::vector<ossimFilename> subDirs;
+      walkDir(dir, subDirs);
+
+      lock.lock();
+      --m_activeCrawlers;
+
+      // Depth first, in listing order, keeps the stack small:
+      m_dirStack.insert(m_dirStack.end(), subDirs.rbegin(), subDirs.rend());
+      m_crawlCondition.notify_all();
+   }
+   m_crawlCondition.notify_all();
+}
+
+void ossimFileWalker::walkDir(const ossimFilename& dir, std::vector<ossimFilename>& subDirs)
 {
    static const char M[] = "ossimFileWalker::walkDir";
    if(traceDebug())
@@ -188,123 +365,245 @@ void ossimFileWalker::walkDir(const ossimFilename& dir)
          << M << " entered...\n" << "processing dir: " << dir << "\n";
    }
 
-   // List of directories in this directory...
-   std::vector<ossimFilename> dirs;
-   
-   // List of files in this directory...
-   std::vector<ossimFilename> files;
-
-   m_mutex.lock();
-   ossimDirectory d;
-   bool ossimDirectoryStatus = d.open(dir);
-   m_mutex.unlock();
-
-   if ( ossimDirectoryStatus )
+   std::vector<DirEntry> entries;
+   if ( listDirectory(dir, m_checkpointFile.size() != 0, entries) )
    {
-      // Loop to get the list of files and directories in this directory.
-      m_mutex.lock();
-      ossimFilename f;
-      bool valid_file = d.getFirst(f);
-      while ( valid_file )
+      std::shared_ptr<DirState> dirState = std::make_shared<DirState>();
+
+      //---
+      // Process files first before recursing directories.  If a file is a directory base image,
+      // e.g. RPF, then the callee should call ossimFileWalker::setRecurseFlag to false to
+      // stop us from going into sub directories.
+      //---
+      std::vector<DirEntry>::const_iterator i = entries.begin();
+      while ( (i != entries.end()) && !m_abortFlag )
       {
-         if ( isFiltered(f) == false )
+         if ( isFiltered( (*i).m_file ) == false )
          {
-            if (f.isDir())
+            if ( (*i).m_isDir )
             {
-               dirs.push_back(f);
+               subDirs.push_back( (*i).m_file );
             }
             else
             {
-               files.push_back(f);
+               FileStamp stamp;
+               stamp.m_mtime = (*i).m_mtime;
+               stamp.m_size  = (*i).m_size;
+               submit( (*i).m_file, stamp, dirState );
             }
          }
-         valid_file = d.getNext(f);
+         ++i;
+      }
+
+      if ( m_waitOnDirFlag )
+      {
+         // Wait until this directory's jobs are completed.
+         waitForJobs( dirState.get() );
+      }
+
+      m_mutex.lock();
+      if ( m_abortFlag || !m_recurseFlag || !dirState->m_recurse )
+      {
+         subDirs.clear();
       }
       m_mutex.unlock();
 
-      //---
-      // Process files first before recursing directories.  If a file is a directory base image,
-      // e.g. RPF, then the callee should call ossimFileWalker::setRecurseFlag to false to
-      // stop us from going into sub directories.
-      //---
-      std::vector<ossimFilename>::const_iterator i = files.begin();
-      while (i != files.end())
+   } // if ( listDirectory(...) )
+
+   if(traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG) << M << " exited...\n";
+   }
+}
+
+void ossimFileWalker::submit(const ossimFilename& file,
+                             const FileStamp& stamp,
+                             std::shared_ptr<DirState> dirState)
+{
+   bool stopsRecursion = false;
+   if ( isUnchanged(file, stamp, stopsRecursion) )
+   {
+      ++m_skippedFiles;
+      if ( stopsRecursion && dirState )
       {
-         if(traceDebug())
-         {
-            ossimNotify(ossimNotifyLevel_DEBUG) << "Making the job for: " << (*i) << std::endl;
-         }
-         
-         // Make the job:
-         std::shared_ptr<ossimFileWalkerJob> job =
-            std::make_shared<ossimFileWalkerJob>( m_fileProcessor, (*i) );
+         dirState->m_recurse = false;
+      }
+      return;
+   }
 
-         job->setName( ossimString( (*i).string() ) );
+   {
+      std::unique_lock<std::mutex> lock(m_jobMutex);
+      while ( (m_outstandingJobs >= MAX_QUEUED_JOBS) && !m_abortFlag )
+      {
+         m_jobCondition.wait(lock);
+      }
+      if ( m_abortFlag )
+      {
+         return;
+      }
+      ++m_outstandingJobs;
+      if ( dirState )
+      {
+         ++dirState->m_pending;
+      }
+   }
 
-         job->setCallback( std::make_shared<ossimFileWalkerJobCallback>() );
+   if(traceDebug())
+   {
+      ossimNotify(ossimNotifyLevel_DEBUG) << "Making the job for: " << file << std::endl;
+   }
+
+   // Make the job:
+   std::shared_ptr<ossimFileWalkerJob> job =
+      std::make_shared<ossimFileWalkerJob>( this, m_fileProcessor, file, stamp, dirState );
+
+   job->setName( ossimString( file.string() ) );
+
+   job->setCallback( std::make_shared<ossimFileWalkerJobCallback>() );
 
-         // Set the state to ready:
-         job->ready();
+   // Set the state to ready:
+   job->ready();
 
-         // Add job to the queue:
-         m_jobQueue->getJobQueue()->add( job );
+   // Add job to the queue:
+   m_jobQueue->getJobQueue()->add( job );
+
+   if ( m_abortFlag )
+   {
+      // Callee set our abort flag.  Clear out the queue.
+      m_jobQueue->getJobQueue()->clear();
+   }
+}
 
-         m_mutex.lock();
-         if ( m_abortFlag )
+void ossimFileWalker::waitForJobs(const DirState* dirState)
+{
+   std::unique_lock<std::mutex> lock(m_jobMutex);
+   while ( dirState ? dirState->m_pending : m_outstandingJobs )
+   {
+      if ( m_abortFlag )
+      {
+         // Cleared jobs count themselves out as they are let go of, which takes m_jobMutex.
+         lock.unlock();
+         m_jobQueue->getJobQueue()->clear();
+         lock.lock();
+         if ( !(dirState ? dirState->m_pending : m_outstandingJobs) )
          {
-            // Clear out the queue.
-            m_jobQueue->getJobQueue()->clear();
-            
-            break; // Callee set our abort flag so break out of loop.
+            break;
          }
-         m_mutex.unlock();
-
-         ++i;
       }
+      m_jobCondition.wait(lock);
+   }
+}
 
-      if ( m_waitOnDirFlag )
+void ossimFileWalker::jobDone(DirState* dirState)
+{
+   std::lock_guard<std::mutex> lock(m_jobMutex);
+   --m_outstandingJobs;
+   if ( dirState )
+   {
+      --dirState->m_pending;
+   }
+   m_jobCondition.notify_all();
+}
+
+void ossimFileWalker::beginWalk()
+{
+   m_mutex.lock();
+   m_recurseFlag = true;
+   m_mutex.unlock();
+   m_skippedFiles = 0;
+
+   std::lock_guard<std::mutex> lock(m_checkpointMutex);
+   m_checkpoint.clear();
+   if ( m_checkpointFile.size() )
+   {
+      //---
+      // Lines of "<mtime> <size> <stops_recursion> <file>", the last one of a file counting.
+      // stops_recursion is 1 for a file that called setRecurseFlag(false).
+      //---
+      std::ifstream in( m_checkpointFile.c_str() );
+      std::string line;
+      while ( std::getline(in, line) )
       {
-         // FOREVER loop until all jobs are completed.
-         while (1)
+         if ( line.empty() || (line[0] == '#') )
          {
-            ossim::Thread::sleepInMicroSeconds(250);
-            if ( m_jobQueue->hasJobsToProcess() == false )
-            {
-               break;
-            }
+            continue;
+         }
+         std::istringstream is(line);
+         FileStamp stamp;
+         std::string file;
+         if ( (is >> stamp.m_mtime >> stamp.m_size >> stamp.m_stopsRecursion) &&
+              std::getline(is >> std::ws, file) && file.size() )
+         {
+            m_checkpoint[file] = stamp;
          }
       }
+      in.close();
 
-      m_mutex.lock();
-      if ( !m_abortFlag && m_recurseFlag )
+      m_checkpointStream.open( m_checkpointFile.c_str(), std::ios::out | std::ios::app );
+      if ( !m_checkpointStream.good() )
       {
-         // Process sub directories...
-         i = dirs.begin();
-         while (i != dirs.end())
-         {
-            m_mutex.unlock();
-            walkDir( (*i) );
-            m_mutex.lock();
+         ossimNotify(ossimNotifyLevel_WARN)
+            << "ossimFileWalker WARNING: Could not open checkpoint file: "
+            << m_checkpointFile << std::endl;
+      }
+   }
+}
 
-            if ( m_abortFlag )
-            {
-               break; // Callee set our abort flag so break out of loop.
-            }
-            ++i;
-         }
+void ossimFileWalker::endWalk()
+{
+   std::lock_guard<std::mutex> lock(m_checkpointMutex);
+   if ( m_checkpointStream.is_open() )
+   {
+      m_checkpointStream.close();
+
+      // Drop the records of files processed again:
+      ossimFilename tmpFile = m_checkpointFile + ".tmp";
+      std::ofstream out( tmpFile.c_str() );
+      out << "# ossimFileWalker checkpoint: <mtime> <size> <stops_recursion> <file>\n";
+      std::unordered_map<std::string, FileStamp>::const_iterator i = m_checkpoint.begin();
+      while ( i != m_checkpoint.end() )
+      {
+         out << i->second.m_mtime << " " << i->second.m_size << " "
+             << i->second.m_stopsRecursion << " " << i->first << "\n";
+         ++i;
       }
-      m_mutex.unlock();
-      
-   } // if ( ossimDirectoryOpenStatus )
+      out.close();
+      if ( out.good() )
+      {
+         tmpFile.rename( m_checkpointFile, true );
+      }
+   }
+}
 
-   // Reset the m_recurseFlag.
-   m_mutex.lock();
-   m_recurseFlag = true;
-   m_mutex.unlock();
-   
-   if(traceDebug())
+bool ossimFileWalker::isUnchanged(const ossimFilename& file,
+                                  const FileStamp& stamp,
+                                  bool& stopsRecursion) const
+{
+   bool result = false;
+   if ( m_checkpointFile.size() && (stamp.m_size >= 0) )
    {
-      ossimNotify(ossimNotifyLevel_DEBUG) << M << " exited...\n";
+      std::lock_guard<std::mutex> lock(m_checkpointMutex);
+      std::unordered_map<std::string, FileStamp>::const_iterator i =
+         m_checkpoint.find( file.string() );
+      result = ( (i != m_checkpoint.end()) && (i->second.m_mtime == stamp.m_mtime) &&
+                 (i->second.m_size == stamp.m_size) );
+      stopsRecursion = result && i->second.m_stopsRecursion;
+   }
+   return result;
+}
+
+void ossimFileWalker::checkpoint(const ossimFilename& file, const FileStamp& stamp)
+{
+   if ( m_checkpointFile.size() && (stamp.m_size >= 0) )
+   {
+      std::lock_guard<std::mutex> lock(m_checkpointMutex);
+      m_checkpoint[file.string()] = stamp;
+      if ( m_checkpointStream.is_open() )
+      {
+         // Flushed each time so a killed walk loses nothing done:
+         m_checkpointStream << stamp.m_mtime << " " << stamp.m_size << " "
+                            << stamp.m_stopsRecursion << " " << file << std::endl;
+      }
    }
 }
 
@@ -459,9 +758,18 @@ void ossimFileWalker::initializeDefaultFilterList()
 
 void ossimFileWalker::setRecurseFlag(bool flag)
 {
-   m_mutex.lock();
-   m_recurseFlag = flag;
-   m_mutex.unlock();
+   if ( s_recurseFlag )
+   {
+      // From processFile, for the directory of the file:
+      *s_recurseFlag = flag;
+      s_stoppedRecursion = !flag;
+   }
+   else
+   {
+      m_mutex.lock();
+      m_recurseFlag = flag;
+      m_mutex.unlock();
+   }
 }
 
 void ossimFileWalker::setWaitOnDirFlag(bool flag)
@@ -473,9 +781,18 @@ void ossimFileWalker::setWaitOnDirFlag(bool flag)
 
 void ossimFileWalker::setAbortFlag(bool flag)
 {
-   m_mutex.lock();
    m_abortFlag = flag;
-   m_mutex.unlock();
+   if ( flag )
+   {
+      // Clear out the queue, then wake the crawl threads and the walk waiting on jobs:
+      m_jobQueue->getJobQueue()->clear();
+      m_crawlMutex.lock();
+      m_crawlCondition.notify_all();
+      m_crawlMutex.unlock();
+      m_jobMutex.lock();
+      m_jobCondition.notify_all();
+      m_jobMutex.unlock();
+   }
 }
 
 void ossimFileWalker::setNumberOfThreads(ossim_uint32 nThreads)
@@ -485,6 +802,29 @@ void ossimFileWalker::setNumberOfThreads(ossim_uint32 nThreads)
    m_mutex.unlock();
 }
 
+void ossimFileWalker::setNumberOfCrawlThreads(ossim_uint32 nThreads)
+{
+   m_mutex.lock();
+   m_crawlThreads = nThreads;
+   m_mutex.unlock();
+}
+
+void ossimFileWalker::setCheckpointFile(const ossimFilename& file)
+{
+   std::lock_guard<std::mutex> lock(m_checkpointMutex);
+   m_checkpointFile = file.expand();
+}
+
+const ossimFilename& ossimFileWalker::getCheckpointFile() const
+{
+   return m_checkpointFile;
+}
+
+ossim_uint64 ossimFileWalker::getNumberOfSkippedFiles() const
+{
+   return m_skippedFiles;
+}
+
 void ossimFileWalker::setFileProcessor(ossimFileProcessorInterface* fpi)
 {
    m_mutex.lock();
@@ -493,18 +833,39 @@ void ossimFileWalker::setFileProcessor(ossimFileProcessorInterface* fpi)
 }
 
 ossimFileWalker::ossimFileWalkerJob::ossimFileWalkerJob(
+   ossimFileWalker* walker,
    ossimFileProcessorInterface* fpi,
-   const ossimFilename& file)
-   : m_fileProcessor( fpi ),
-     m_file( file )
+   const ossimFilename& file,
+   const FileStamp& stamp,
+   std::shared_ptr<DirState> dirState)
+   : m_walker( walker ),
+     m_fileProcessor( fpi ),
+     m_file( file ),
+     m_stamp( stamp ),
+     m_dirState( dirState )
 {
 }
 
+ossimFileWalker::ossimFileWalkerJob::~ossimFileWalkerJob()
+{
+   m_walker->jobDone( m_dirState.get() );
+}
+
 void ossimFileWalker::ossimFileWalkerJob::run()
 {
    if ( m_fileProcessor && m_file.size() )
    {
+      // So setRecurseFlag calls from processFile find the directory. A file given on its own
+      // has none, its call applies to nothing else:
+      std::atomic<bool> ownRecurse(true);
+      s_recurseFlag = m_dirState ? &(m_dirState->m_recurse) : &ownRecurse;
+      s_stoppedRecursion = false;
       m_fileProcessor->processFile( m_file );
+      s_recurseFlag = 0;
+
+      // Skipping the file next time must still stop the recursion:
+      m_stamp.m_stopsRecursion = s_stoppedRecursion;
+      m_walker->checkpoint( m_file, m_stamp );
    }
 }
 
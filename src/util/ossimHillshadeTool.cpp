@@ -66,6 +66,7 @@ static const std::string COLOR_BLUE_KW           = "color_blue";
 static const std::string COLOR_GREEN_KW          = "color_green";
 static const std::string COLOR_RED_KW            = "color_red";
 static const std::string COLOR_SOURCE_KW         = "color_source";
+static const std::string STENCIL_KW              = "stencil";
 
 const char*  ossimHillshadeTool::DESCRIPTION =
    "Computes shaded representation of input elevation surface with specified lighting parameters.";
@@ -73,6 +74,7 @@ const char*  ossimHillshadeTool::DESCRIPTION =
 ossimHillshadeTool::ossimHillshadeTool()
 {
    m_kwl.setExpandEnvVarsFlag(true);
+   m_tiledWrite = true;
 }
 
 // Private/hidden from use.
@@ -144,6 +146,11 @@ bool ossimHillshadeTool::initialize(ossimArgumentParser& ap)
       m_kwl.addPair( std::string(ossimKeywordNames::ELEVATION_ANGLE_KW), tempString1 );
    }
 
+   if ( ap.read("--stencil", stringParam1) )
+   {
+      m_kwl.addPair( STENCIL_KW, tempString1 );
+   }
+
    processRemainingArgs(ap);
    return true;
 }
@@ -164,6 +171,11 @@ void ossimHillshadeTool::initProcessingChain()
    ossim_float64 gain = 1.0;
    normSource->setSmoothnessFactor(gain);
 
+   // Gradient stencil:
+   ossimString stencil = m_kwl.findKey( STENCIL_KW );
+   if ( stencil.downcase() == "horn" )
+      normSource->setStencil(ossimTerrainKernels::HORN);
+
    // Create the bump shade.
    ossimRefPtr<ossimBumpShadeTileSource> bumpShade = new ossimBumpShadeTileSource;
    m_procChain->add(bumpShade.get());
@@ -238,6 +250,7 @@ void ossimHillshadeTool::setUsage(ossimArgumentParser& ap)
    au->addCommandLineOption("--color","<r> <g> <b>\nSet the red, green and blue color values to be used with hillshade.\nRange 0 to 255, Default r=255, g=255, b=255");
    au->addCommandLineOption("--color-source","<file>\nSpecifies the image file to use as a color source instead of a fixed RGB value.");
    au->addCommandLineOption("--elevation", "<elevation>\nhillshade option - Light source elevation angle for bumb shade.\nRange: 0 to 90, Default = 45.0");
+   au->addCommandLineOption("--stencil", "<horn|zt>\nGradient stencil, Horn's eight neighbor or Zevenbergen-Thorne's four neighbor differences.\nDefault = zt");
 
    // Base class has its own:
    ossimChipProcTool::setUsage(ap);
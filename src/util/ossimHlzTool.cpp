@@ -28,7 +28,8 @@
 #include <ossim/imaging/ossimIndexToRgbLutFilter.h>
 #include <ossim/point_cloud/ossimPointCloudHandlerRegistry.h>
 #include <ossim/util/ossimHlzTool.h>
-#include <ossim/base/Thread.h>
+#include <ossim/base/ossimPlaneFitTable.h>
+#include <ossim/parallel/ossimParallelFor.h>
 #include <fstream>
 #include <cstddef>
 
@@ -41,6 +42,7 @@ static const string POINT_CLOUD_FILE_KW = "point_clouds";
 static const string HLZ_CODING_KW = "hlz_coding";
 static const string LZ_MIN_RADIUS_KW = "min_lz_radius";
 static const string ROUGHNESS_THRESHOLD_KW = "max_roughness";
+static const string RMS_ROUGHNESS_THRESHOLD_KW = "max_rms_roughness";
 static const string SLOPE_THRESHOLD_KW = "max_slope";
 
 const char* ossimHlzTool::DESCRIPTION =
@@ -50,13 +52,14 @@ const char* ossimHlzTool::DESCRIPTION =
 ossimHlzTool::ossimHlzTool()
 : m_slopeThreshold(7.0),
   m_roughnessThreshold(0.5),
+  m_rmsRoughnessThreshold(ossim::nan()),
   m_hlzMinRadius(25.0),
   m_outBuffer(NULL),
   m_badLzValue(255),
   m_marginalLzValue(128),
   m_goodLzValue(64),
   m_useLsFitMethod(true),
-  m_numThreads(1),
+  m_numThreads(0),
   d_accumT(0)
 {
 }
@@ -97,12 +100,16 @@ void ossimHlzTool::setUsage(ossimArgumentParser& ap)
    au->addCommandLineOption("--min-lz-radius <meters>",
          "Specifies minimum radius of landing zone. Defaults to 25 m. ");
    au->addCommandLineOption("--max-roughness <meters>",
-         "Specifies the terrain roughness threshold (meters). This is the maximum deviation from a "
-         "flat plane permitted. Defaults to 0.5 m. Valid only with --ls-fit specified.");
+         "Specifies the terrain roughness threshold (meters). This is the maximum deviation of "
+         "any post from the best-fit plane permitted. Defaults to 0.5 m. Not used with "
+         "--use-slope.");
+   au->addCommandLineOption("--max-rms-roughness <meters>",
+         "Optional threshold on the RMS deviation of the posts from the best-fit plane (meters). "
+         "Not used with --use-slope.");
    au->addCommandLineOption("--max-slope <degrees>",
          "Threshold for acceptable landing zone terrain slope. Defaults to 7 deg.");
    au->addCommandLineOption("--threads <n>",
-         "Number of threads. Defaults to use single core. For engineering/debug purposes.");
+         "Number of threads evaluating bands of the AOI. Defaults to use all available cores.");
    au->addCommandLineOption("--use-slope",
          "Slope is computed from the normal vector using neighboring posts instead of "
          "least-squares fit to a plane (preferred). For engineering/debug purposes.");
@@ -166,6 +173,9 @@ bool ossimHlzTool::initialize(ossimArgumentParser& ap)
    if (ap.read("--max-roughness", sp1) || ap.read("--roughness", sp1))
       m_kwl.addPair(ROUGHNESS_THRESHOLD_KW, ts1);
 
+   if (ap.read("--max-rms-roughness", sp1))
+      m_kwl.addPair(RMS_ROUGHNESS_THRESHOLD_KW, ts1);
+
    if (ap.read("--max-slope", sp1) || ap.read("--slope", sp1))
       m_kwl.addPair(SLOPE_THRESHOLD_KW, ts1);
 
@@ -211,6 +221,10 @@ void ossimHlzTool::initialize(const ossimKeywordlist& kwl)
    if (!value.empty())
       m_roughnessThreshold = value.toDouble();
 
+   value = m_kwl.findKey(RMS_ROUGHNESS_THRESHOLD_KW);
+   if (!value.empty())
+      m_rmsRoughnessThreshold = value.toDouble();
+
    value = m_kwl.findKey(SLOPE_THRESHOLD_KW);
    if (!value.empty())
       m_slopeThreshold = value.toDouble();
@@ -445,229 +459,240 @@ bool ossimHlzTool::computeHLZ()
 
    d_accumT = 0;
 
-   // Establish loop limits in input DEM raster coordinate space:
-   ossim_int32 min_x = m_aoiViewRect.ul().x;
-   ossim_int32 min_y = m_aoiViewRect.ul().y;
-   ossim_int32 max_x = m_aoiViewRect.lr().x - m_demFilterSize.x;
-   ossim_int32 max_y = m_aoiViewRect.lr().y - m_demFilterSize.y;
-   ossimIpt chip_origin;
-   ossim_uint32 numPatches = (max_x-min_x)*(max_y-min_y);
-
-   // Determine the DEM step size as a fraction of the LZ radius:
-   const double CHIP_STEP_FACTOR = 0.25; // chip position increment as fraction of chip width
-   ossim_int32 dem_step =
-         (ossim_int32) floor(4*CHIP_STEP_FACTOR*m_hlzMinRadius/(m_gsd.x+m_gsd.y));
-   if (dem_step <= 0)
-      dem_step = 1;
-
-   // Hack: degrading to single thread when slope-image scheme is used. Runs extremely slow in
-   // multithread mode, but much faster as single thread than multithreaded ls-fit
-   if ((m_numThreads == 1) || !m_useLsFitMethod)
+   // A patch at every AOI pixel it fits below and to the right of:
+   const ossim_int32 numPatchesX = m_aoiViewRect.width() - m_demFilterSize.x;
+   const ossim_int32 numPatchesY = m_aoiViewRect.height() - m_demFilterSize.y;
+   if ((numPatchesX <= 0) || (numPatchesY <= 0))
    {
-      // Not threaded (or slope-image scheme):
-      setPercentComplete(0);
-      ossim_uint32 chipId = 0;
-      for (chip_origin.y = min_y; chip_origin.y <= max_y; chip_origin.y += dem_step)
-      {
-         for (chip_origin.x = min_x; chip_origin.x <= max_x; chip_origin.x += dem_step)
-         {
-            std::shared_ptr<ossimHlzTool::PatchProcessorJob> job = 0;
-            if (m_useLsFitMethod)
-               job = std::make_shared<ossimHlzTool::LsFitPatchProcessorJob>(this, chip_origin, chipId++);
-            else
-               job = std::make_shared<ossimHlzTool::NormPatchProcessorJob>(this, chip_origin, chipId++);
-            job->start();
-         }
-         setPercentComplete(100*chipId/numPatches);
-      }
+      ossimNotify(ossimNotifyLevel_WARN) << "ossimHlzUtil::computeHLZ() -- The AOI is smaller than "
+            "a landing zone." << endl;
+      return true;
    }
-   else
+
+   if (m_numThreads == 0)
+      m_numThreads = ossim::getNumberOfThreads();
+
+   setPercentComplete(0);
+   vector<double> heights;
+   vector<ossim_uint8> rejects;
+   loadCells(heights, rejects);
+
+   // Bands of patch rows a thread each, a few per thread to even out the point cloud tests, and
+   // several patches tall so the rows the tables of neighboring bands share stay few:
+   ossim_int32 bandRows = numPatchesY/(4*(ossim_int32) m_numThreads);
+   bandRows = ossim::max<ossim_int32>(bandRows, 4*m_demFilterSize.y);
+   const ossim_int32 numBands = (numPatchesY + bandRows - 1)/bandRows;
+
+   ossimNotify(ossimNotifyLevel_INFO) << "\nEvaluating " << numPatchesX*numPatchesY
+         << " patches in " << numBands << " bands..." << endl;
+   vector<ossim_uint8> goodPatches (numPatchesX*numPatchesY, 0);
+   ossim::parallelFor(numBands, m_numThreads, [&](ossim_uint32 band)
    {
-      if (m_numThreads == 0)
-         m_numThreads = ossim::getNumberOfThreads();
-
-      // Loop over input DEM, creating a thread job for each filter window:
-      std::shared_ptr<ossimJobMultiThreadQueue> jobMtQueue =
-            std::make_shared<ossimJobMultiThreadQueue>(nullptr, m_numThreads);
-      std::shared_ptr<ossimJobQueue> jobQueue = jobMtQueue->getJobQueue();
-
-      ossimNotify(ossimNotifyLevel_INFO) << "\nPreparing " << numPatches << " jobs..." << endl; // TODO: DEBUG
-      setPercentComplete(0);
-      ossim_int32 qsize = 0;
-      ossimIpt chip_origin;
-      ossim_uint32 chipId = 0;
-      for (chip_origin.y = min_y; chip_origin.y <= max_y; ++chip_origin.y)
+      const ossim_int32 firstRow = band*bandRows;
+      evaluatePatches(firstRow, ossim::min(bandRows, numPatchesY - firstRow), heights, rejects,
+                      goodPatches);
+   });
+   if (needsAborting())
+      return false;
+
+   paintPatches(goodPatches);
+   setPercentComplete(100);
+
+   ossimNotify(ossimNotifyLevel_INFO) << "Finished processing chips." << endl;
+   return true;
+}
+
+void ossimHlzTool::loadCells(vector<double>& heights, vector<ossim_uint8>& rejects)
+{
+   const ossim_uint32 width = m_aoiViewRect.width();
+   const ossim_uint32 height = m_aoiViewRect.height();
+   heights.resize(width*height);
+   rejects.assign(width*height, 0);
+
+   // Nulls, and with the slope image for heights, slopes over the threshold:
+   const double nullValue = m_demBuffer->getNullPix(0);
+   ossim::parallelFor(height, m_numThreads, [&](ossim_uint32 y)
+   {
+      for (ossim_uint32 i=y*width; i<(y+1)*width; ++i)
       {
-         for (chip_origin.x = min_x; chip_origin.x <= max_x; ++chip_origin.x)
+         const double z = m_demBuffer->getPix(i, 0);
+         heights[i] = z;
+         if ((z == nullValue) || ossim::isnan(z) ||
+             (!m_useLsFitMethod && (z > m_slopeThreshold)))
          {
-            //ossimNotify(ossimNotifyLevel_INFO) << "Submitting " << chipId << endl;
-            std::shared_ptr<ossimHlzTool::PatchProcessorJob> job = 0;
-            if (m_useLsFitMethod)
-               job = std::make_shared<ossimHlzTool::LsFitPatchProcessorJob>(this, chip_origin, chipId++);
-            else
-               job = std::make_shared<ossimHlzTool::NormPatchProcessorJob>(this, chip_origin, chipId++);
-            jobQueue->add(job, false);
+            rejects[i] = 1;
          }
-         qsize = jobQueue->size();
-         setPercentComplete(100*(chipId-qsize)/numPatches);
       }
+   });
 
-      // Wait until all chips have been processed before proceeding:
-      ossimNotify(ossimNotifyLevel_INFO) << "All jobs queued. Waiting for job threads to finish..." << endl;
-      while (jobMtQueue->hasJobsToProcess() || jobMtQueue->numberOfBusyThreads())
+   // Masks, each read once over the whole AOI:
+   vector<MaskSource>::iterator mask_source = m_maskSources.begin();
+   while (mask_source != m_maskSources.end())
+   {
+      ossimRefPtr<ossimImageData> mask_data = mask_source->image->getTile(m_aoiViewRect);
+      const bool hasData = mask_data.valid() && mask_data->getBuf();
+      ossimIpt p;
+      ossim_uint32 i = 0;
+      for (p.y = m_aoiViewRect.ul().y; p.y <= m_aoiViewRect.lr().y; ++p.y)
       {
-         qsize = jobMtQueue->getJobQueue()->size();
-         setPercentComplete(100*(numPatches-qsize)/numPatches);
-         ossim::Thread::sleepInMicroSeconds(10000);
+         for (p.x = m_aoiViewRect.ul().x; p.x <= m_aoiViewRect.lr().x; ++p.x, ++i)
+         {
+            const bool mask_value = hasData && (mask_data->getPix(p) != 0.0);
+            if (( mask_value &&  mask_source->exclude) || (!mask_value && !mask_source->exclude))
+               rejects[i] = 1;
+         }
       }
-      jobMtQueue = 0;
+      ++mask_source;
    }
-
-   ossimNotify(ossimNotifyLevel_INFO) << "Finished processing chips." << endl;
-   return true;
 }
 
-void ossimHlzTool::writeSlopeImage()
+void ossimHlzTool::evaluatePatches(ossim_int32 first_row,
+                                   ossim_int32 num_rows,
+                                   const vector<double>& heights,
+                                   const vector<ossim_uint8>& rejects,
+                                   vector<ossim_uint8>& good_patches) const
 {
-   // Set up the writer:
-   ossimRefPtr<ossimImageFileWriter> writer = 0;
-   ossimTiffWriter* tif_writer = new ossimTiffWriter();
-   tif_writer->setGeotiffFlag(true);
-   tif_writer->setFilename(m_slopeFile);
-   writer = tif_writer;
-   writer->connectMyInputTo(0, m_combinedElevSource.get());
-   writer->setAreaOfInterest(m_aoiViewRect);
-   if (writer->execute())
-      ossimNotify(ossimNotifyLevel_INFO)<<"Wrote slope image to <"<<m_slopeFile<<">."<<endl;
-   else
-   {
-      ossimNotify(ossimNotifyLevel_WARN)<<"ossimHLZUtil::writeSlopeImage() Error encountered "
-            "writing slope image to <"<<m_slopeFile<<">."<<endl;
-   }
-}
+   const ossim_int32 width = m_aoiViewRect.width();
+   const ossim_int32 numPatchesX = width - m_demFilterSize.x;
+   const size_t bandStart = (size_t) first_row*width;
 
-std::mutex ossimHlzTool::PatchProcessorJob::m_bufMutex;
+   // Tables of the rows under the band's patches. The slope image only needs the rejects:
+   ossimPlaneFitTable table;
+   table.build((m_useLsFitMethod ? &heights[bandStart] : 0), &rejects[bandStart], width,
+               num_rows + m_demFilterSize.y - 1);
 
-ossimHlzTool::PatchProcessorJob::PatchProcessorJob(ossimHlzTool* hlzUtil, const ossimIpt& origin,
-                                   ossim_uint32 /*chip_id*/)
-: m_hlzUtil (hlzUtil),
-  m_demPatchUL (origin),
-  m_status (0),
-  m_nullValue (hlzUtil->m_demBuffer->getNullPix(0))
-{
-   m_demPatchLR.x = m_demPatchUL.x + m_hlzUtil->m_demFilterSize.x;
-   m_demPatchLR.y = m_demPatchUL.y + m_hlzUtil->m_demFilterSize.y;
-}
+   const double slopeLimit = ossim::cosd(m_slopeThreshold);
 
-void ossimHlzTool::PatchProcessorJob::run()
-{
-   bool passed = level1Test() && level2Test() && maskTest();
-   ossimIpt p;
+   // The peak deviation is at least the RMS, so the RMS from the tables rules out most patches
+   // before the posts of the rest are visited:
+   double rmsLimit = m_roughnessThreshold;
+   if (!ossim::isnan(m_rmsRoughnessThreshold))
+      rmsLimit = ossim::min(rmsLimit, m_rmsRoughnessThreshold);
 
-   std::lock_guard<std::mutex> lock (m_bufMutex);
-   for (p.y = m_demPatchUL.y; p.y < m_demPatchLR.y; ++p.y)
+   double a, b, rms;
+   for (ossim_int32 y=0; y<num_rows; ++y)
    {
-      for (p.x = m_demPatchUL.x; p.x < m_demPatchLR.x; ++p.x)
+      for (ossim_int32 x=0; x<numPatchesX; ++x)
       {
-         if (passed && (m_status == 2))
-            m_hlzUtil->m_outBuffer->setValue(p.x, p.y, m_hlzUtil->m_goodLzValue);
-         else if (passed && (m_status == 1))
-            m_hlzUtil->m_outBuffer->setValue(p.x, p.y, m_hlzUtil->m_marginalLzValue);
+         bool passed;
+         if (m_useLsFitMethod)
+         {
+            // Slope from the normal of the best-fit plane, and roughness as the distance of the
+            // posts from it:
+            passed = table.fit(x, y, m_demFilterSize.x, m_demFilterSize.y, a, b, rms);
+            if (passed)
+            {
+               const double dzdx = a/m_gsd.x;
+               const double dzdy = b/m_gsd.y;
+               const double z_proj = 1.0 / sqrt(dzdx*dzdx + dzdy*dzdy + 1.0);
+               passed = (z_proj >= slopeLimit) && (z_proj*rms <= rmsLimit) &&
+                  (z_proj*peakDeviation(heights, bandStart + (size_t) y*width + x, a, b) <=
+                   m_roughnessThreshold);
+            }
+         }
          else
-            m_hlzUtil->m_outBuffer->setValue(p.x, p.y, m_hlzUtil->m_badLzValue);
+         {
+            passed = !table.getFlagCount(x, y, m_demFilterSize.x, m_demFilterSize.y);
+         }
+
+         const ossimIpt ul (m_aoiViewRect.ul().x + x, m_aoiViewRect.ul().y + first_row + y);
+         if (passed && !m_pcSources.empty())
+            passed = level2Test(ul, ul + m_demFilterSize);
+
+         good_patches[(size_t) (first_row + y)*numPatchesX + x] = passed ? 1 : 0;
       }
    }
 }
 
-bool ossimHlzTool::LsFitPatchProcessorJob::level1Test()
+double ossimHlzTool::peakDeviation(const vector<double>& heights, size_t origin,
+                                   double a, double b) const
 {
-   // Start with computing best-fit plane:
-   ossimIpt p;
-   double z;
-   double y_meters;
-   for (p.y = m_demPatchUL.y; p.y < m_demPatchLR.y; ++p.y)
+   // The plane goes through the mean height at the center of the patch:
+   const ossim_int32 width = m_aoiViewRect.width();
+   double mean = 0.0;
+   for (ossim_int32 y=0; y<m_demFilterSize.y; ++y)
    {
-      y_meters = p.y*m_hlzUtil->m_gsd.y;
-      for (p.x = m_demPatchUL.x; p.x < m_demPatchLR.x; ++p.x)
-      {
-         z = m_hlzUtil->m_demBuffer->getPix(p, 0);
-         if ((z == m_nullValue) || ossim::isnan(z))
-            return false;
-         m_plane->addSample(p.x*m_hlzUtil->m_gsd.x, y_meters, z);
-      }
+      const double* row = &heights[origin + (size_t) y*width];
+      for (ossim_int32 x=0; x<m_demFilterSize.x; ++x)
+         mean += row[x];
    }
-   if (!m_plane->solveLS())
-      return false;
-
-   // The slope is derived from the normal unit vector. Extract that from the solution and test
-   // against threshold:
-   double a, b, c;
-   m_plane->getLSParms(a, b, c);
-   double z_proj = 1.0 / sqrt(a*a + b*b + 1.0);
-   double theta = fabs(ossim::acosd(z_proj));
-   if (theta > m_hlzUtil->m_slopeThreshold)
-      return false;
+   mean /= (double) m_demFilterSize.x*m_demFilterSize.y;
 
-   // Passed the slope test. Now measure the roughness as peak deviation from the plane:
-   double distance;
-   for (p.y = m_demPatchUL.y; (p.y < m_demPatchLR.y); ++p.y)
+   const double xc = 0.5*(m_demFilterSize.x - 1.0);
+   const double yc = 0.5*(m_demFilterSize.y - 1.0);
+   double peak = 0.0;
+   for (ossim_int32 y=0; y<m_demFilterSize.y; ++y)
    {
-      for (p.x = m_demPatchUL.x; (p.x < m_demPatchLR.x); ++p.x)
-      {
-         z = m_hlzUtil->m_demBuffer->getPix(p, 0);
-         distance = fabs(z_proj * (a*p.x + b*p.y + c - z));
-         if (distance > m_hlzUtil->m_roughnessThreshold)
-            return false;
-      }
+      const double* row = &heights[origin + (size_t) y*width];
+      for (ossim_int32 x=0; x<m_demFilterSize.x; ++x)
+         peak = ossim::max(peak, fabs(row[x] - mean - a*(x - xc) - b*(y - yc)));
    }
-
-   m_status = 1; // indicates passed level 1
-   return true;
+   return peak;
 }
 
-bool ossimHlzTool::NormPatchProcessorJob::level1Test()
+void ossimHlzTool::paintPatches(const vector<ossim_uint8>& good_patches)
 {
-   // The processing chain is outputing slope values in degrees from vertical.
-   // Scan the data tile for slopes outside the threshold:
-   ossimIpt p;
-   float theta;
-   for (p.y = m_demPatchUL.y; p.y < m_demPatchLR.y; ++p.y)
+   const ossim_int32 width = m_aoiViewRect.width();
+   const ossim_int32 numPatchesX = width - m_demFilterSize.x;
+   const ossim_int32 numPatchesY = m_aoiViewRect.height() - m_demFilterSize.y;
+
+   // Counts of good patches over the origins of those covering a pixel:
+   ossimPlaneFitTable goodCounts;
+   goodCounts.build(0, &good_patches.front(), numPatchesX, numPatchesY);
+
+   ossim_uint8* buf = static_cast<ossim_uint8*>(m_outBuffer->getBuf(0));
+   const ossim_int32 coveredRows = numPatchesY + m_demFilterSize.y - 1;
+   ossim::parallelFor(coveredRows, m_numThreads, [&](ossim_uint32 y)
    {
-      for (p.x = m_demPatchUL.x; p.x < m_demPatchLR.x; ++p.x)
+      const ossim_int32 y0 = ossim::max<ossim_int32>(0, y - m_demFilterSize.y + 1);
+      const ossim_int32 y1 = ossim::min<ossim_int32>(y, numPatchesY - 1);
+      for (ossim_int32 x=0; x<numPatchesX + m_demFilterSize.x - 1; ++x)
       {
-         theta = m_hlzUtil->m_demBuffer->getPix(p, 0);
-         if ((theta == m_nullValue) || ossim::isnan(theta) || (theta > m_hlzUtil->m_slopeThreshold))
-            return false;
+         const ossim_int32 x0 = ossim::max<ossim_int32>(0, x - m_demFilterSize.x + 1);
+         const ossim_int32 x1 = ossim::min<ossim_int32>(x, numPatchesX - 1);
+         if (goodCounts.getFlagCount(x0, y0, x1 - x0 + 1, y1 - y0 + 1))
+            buf[y*width + x] = m_goodLzValue;
+         else
+            buf[y*width + x] = m_badLzValue;
       }
-   }
-
-   m_status = 1; // indicates passed level 1
-   return true;
+   });
+   m_outBuffer->validate();
 }
 
-bool ossimHlzTool::PatchProcessorJob::level2Test()
+void ossimHlzTool::writeSlopeImage()
 {
-   // Level 2 only valid if a point cloud dataset is available:
-   if (m_hlzUtil->m_pcSources.empty())
+   // Set up the writer:
+   ossimRefPtr<ossimImageFileWriter> writer = 0;
+   ossimTiffWriter* tif_writer = new ossimTiffWriter();
+   tif_writer->setGeotiffFlag(true);
+   tif_writer->setFilename(m_slopeFile);
+   writer = tif_writer;
+   writer->connectMyInputTo(0, m_combinedElevSource.get());
+   writer->setAreaOfInterest(m_aoiViewRect);
+   if (writer->execute())
+      ossimNotify(ossimNotifyLevel_INFO)<<"Wrote slope image to <"<<m_slopeFile<<">."<<endl;
+   else
    {
-      ++m_status; // assumes level2 passes
-      return true;
+      ossimNotify(ossimNotifyLevel_WARN)<<"ossimHLZUtil::writeSlopeImage() Error encountered "
+            "writing slope image to <"<<m_slopeFile<<">."<<endl;
    }
+}
 
+bool ossimHlzTool::level2Test(const ossimIpt& ul, const ossimIpt& lr) const
+{
    // Need to convert DEM file coordinate bounds to geographic.
    ossimGpt chipUlGpt, chipLrGpt;
-   m_hlzUtil->m_geom->localToWorld(ossimDpt(m_demPatchUL), chipUlGpt);
-   m_hlzUtil->m_geom->localToWorld(ossimDpt(m_demPatchLR), chipLrGpt);
+   m_geom->localToWorld(ossimDpt(ul), chipUlGpt);
+   m_geom->localToWorld(ossimDpt(lr), chipLrGpt);
    chipUlGpt.hgt = ossim::nan();
    chipLrGpt.hgt = ossim::nan();
    ossimGrect grect (chipUlGpt, chipLrGpt);
 
    // TODO: LIMITATION: Only a single point cloud source is considered. Need to expand to handle
    // a list:
-   const ossimPointCloudHandler* pc_src = m_hlzUtil->m_pcSources[0].get();
+   const ossimPointCloudHandler* pc_src = m_pcSources[0].get();
 
    // First check if there is even any coverage:
-   m_status = 0; // reset assumes no coverage
    ossimGrect bb;
    pc_src->getBounds(bb);
    if (!bb.intersects(grect))
@@ -678,59 +703,19 @@ bool ossimHlzTool::PatchProcessorJob::level2Test()
    if (pc_block.empty())
       return false;
 
-   bool found_obstruction = false;
-
    // Scan the block for obstructions:
-   ossimGpt point_plh;
-   ossimDpt point_xy;
    ossim_uint32 numPoints = pc_block.size();
-   for (ossim_uint32 i=0; (i<numPoints) && !found_obstruction; ++i)
+   for (ossim_uint32 i=0; i<numPoints; ++i)
    {
       //If this is not the only return, implies clutter along the ray:
       int num_returns = (int) pc_block[i]->getField(ossimPointRecord::NumberOfReturns);
       if (num_returns > 1)
-      {
-         found_obstruction = true;
-         break;
-      }
+         return false;
    }
 
-   if (!found_obstruction)
-      m_status = 2;
-
    return true;
 }
 
-bool ossimHlzTool::PatchProcessorJob::maskTest()
-{
-   // Threat dome only valid if a mask source is available:
-   if (m_hlzUtil->m_maskSources.empty())
-      return true;
-
-   ossimIrect chipRect (m_demPatchUL, m_demPatchLR);
-   vector<MaskSource>::iterator mask_source = m_hlzUtil->m_maskSources.begin();
-   bool test_passed = true;
-   ossimIpt p;
-   ossim_uint8 mask_value;
-
-   while ((mask_source != m_hlzUtil->m_maskSources.end()) && test_passed)
-   {
-      ossimRefPtr<ossimImageData> mask_data = mask_source->image->getTile(chipRect);
-      for (p.y = m_demPatchUL.y; (p.y < m_demPatchLR.y) && test_passed; ++p.y)
-      {
-         for (p.x = m_demPatchUL.x; (p.x < m_demPatchLR.x) && test_passed; ++p.x)
-         {
-            mask_value = mask_data->getPix(p);
-            if (( mask_value &&  mask_source->exclude) || (!mask_value && !mask_source->exclude))
-               test_passed = false;
-         }
-      }
-      ++mask_source;
-   }
-
-   return test_passed;
-}
-
 ossimHlzTool::MaskSource::MaskSource(ossimHlzTool* hlzUtil,
                                      const ossimFilename& mask_image,
                                      bool exclusion)
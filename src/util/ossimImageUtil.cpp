@@ -70,6 +70,7 @@
 
 using namespace std;
  
+static std::string CHECKPOINT_KW               = "checkpoint";
 static std::string CMM_MAX_KW                  = "cmm_max"; // CMM(ComputeMinMax)
 static std::string CMM_MIN_KW                  = "cmm_min";
 static std::string CMM_NULL_KW                 = "cmm_null";
@@ -133,6 +134,9 @@ void ossimImageUtil::addOptions(ossimApplicationUsage* au)
    au->addCommandLineOption("--ch or --create-histogram", "Computes full histogram alongside overview.");
 
    au->addCommandLineOption("--chf or --create-histogram-fast", "Computes a histogram in fast mode which samples partial tiles.");
+
+   au->addCommandLineOption("--checkpoint", "<file> Records each file processed with its modification time and size in file, and skips files recorded unchanged. Lets an interrupted run over a large tree pick up where it stopped.");
+
    au->addCommandLineOption("--ct or --create-thumbnail", "computes a thumbnail of the image");
    au->addCommandLineOption("--tt or --thumbnail-type", "Can be of of values png or jpeg");
    au->addCommandLineOption("--tst or --thumbnail-stretch-type", "Can be of values none,auto-minmax,auto-percentile,std-stretch-1,std-stretch-2,std-stretch-3");
@@ -281,6 +285,15 @@ bool ossimImageUtil::initialize(ossimArgumentParser& ap)
             }
          }
 
+         if( ap.read("--checkpoint", sp1) )
+         {
+            addOption( CHECKPOINT_KW, ts1 );
+            if ( ap.argc() < 2 )
+            {
+               break;
+            }
+         }
+
          if( ap.read("--compute-min-max") )
          {
             setScanForMinMax( true );
@@ -606,6 +619,9 @@ ossim_int32 ossimImageUtil::execute()
       }
  
       m_fileWalker->setNumberOfThreads( getNumberOfThreads() );
+
+      // Skips files done in a previous run:
+      m_fileWalker->setCheckpointFile( ossimFilename( m_kwl->findKey( CHECKPOINT_KW ) ) );
  
       // Must set this so we can stop recursion on directory based images.
       m_fileWalker->setWaitOnDirFlag( true );
@@ -43,20 +43,27 @@
 #include <ossim/imaging/ossimImageWriterFactoryRegistry.h>
 #include <ossim/imaging/ossimOverviewBuilderFactoryRegistry.h>
 #include <ossim/init/ossimInit.h>
+#include <ossim/parallel/ossimParallelFor.h>
 #include <ossim/plugin/ossimSharedPluginRegistry.h>
 #include <ossim/projection/ossimProjectionFactoryRegistry.h>
 #include <ossim/support_data/ossimInfoBase.h>
 #include <ossim/support_data/ossimInfoFactoryRegistry.h>
 #include <ossim/support_data/ossimSupportFilesList.h>
 #include <ossim/support_data/ImageHandlerStateRegistry.h>
+#include <json/json.h>
 
+#include <atomic>
+#include <fstream>
 #include <iomanip>
+#include <iostream>
+#include <mutex>
 #include <sstream>
 #include <vector>
 #include <memory>
 
 using namespace std;
 
+static const char BATCH_KW[]                = "batch";
 static const char BUILD_DATE_KW[]           = "build_date";
 static const char CAN_OPEN_KW[]             = "can_open";
 static const char CENTER_GROUND_KW[]        = "center_ground";
@@ -85,6 +92,7 @@ static const char GRD2IMG_KW[]              = "grd2img";
 static const char METADATA_KW[]             = "metadata";
 static const char MTRS2FT_KW[]              = "mtrs2ft";
 static const char MTRS2FT_US_SURVEY_KW[]    = "mtrs2ft_us_survey";
+static const char MAX_DEPTH_KW[]            = "max_depth";
 static const char MTRSPERDEG_KW[]           = "mtrs_per_deg";
 static const char NORTH_UP_KW[]             = "north_up_angle";
 static const char OUTPUT_FILE_KW[]          = "output_file";
@@ -99,6 +107,8 @@ static const char RAD2DEG_KW[]              = "rad2deg";
 static const char READER_PROPS_KW[]         = "reader_props";
 static const char RESAMPLER_FILTERS_KW[]    = "resampler_filters";
 static const char REVISION_NUMBER_KW[]      = "revision_number";
+static const char SKIP_KW[]                 = "skip";
+static const char THREADS_KW[]              = "threads";
 static const char UP_IS_UP_KW[]             = "up_is_up";
 static const char UP_IS_UP_GPT_KW[]         = "up_is_up_gpt";
 static const char UP_IS_UP_IPT_KW[]         = "up_is_up_ipt";
@@ -110,6 +120,14 @@ static const char ECEF2LLH_KW[]             = "ecef2llh";
 static const char DUMP_STATE_KW[]           = "dump_state";
 static const char STATE_KW[]                = "state";
 
+// Items --skip can leave out of a batch record:
+static const char SKIP_CORNERS[]            = "corners";
+static const char SKIP_DUMP[]               = "dump";
+static const char SKIP_GEOMETRY[]           = "geometry";
+static const char SKIP_METADATA[]           = "metadata";
+static const char SKIP_PALETTE[]            = "palette";
+static const char SKIP_SUPPORT_FILES[]      = "support_files";
+
 const char* ossimInfo::DESCRIPTION =
       "Dumps metadata information about input image and OSSIM in general.";
 
@@ -137,6 +155,8 @@ void ossimInfo::setUsage(ossimArgumentParser& ap)
    au->setCommandLineUsage(usageString);
 
    // Set the command line options:
+   au->addCommandLineOption("--batch", "<file-list | ->\nBatch mode. Reads image files, one a line, from file-list, or standard in for \"-\", and writes a JSON record a line for each with what the image options -i, -p, -m, -d, --dno and --palette ask for, -i -p if none. Files are read concurrently (see --threads), so records come out in the order files finish. Files that cannot be read get a record with an \"error\" member.");
+
    au->addCommandLineOption("--bounds", "Will print out the edge to edge image bounds.");
    
    au->addCommandLineOption("--build-date", "Build date of code.");
@@ -188,6 +208,8 @@ void ossimInfo::setUsage(ossimArgumentParser& ap)
 
    au->addCommandLineOption("-m", "Will print out meta data image information.");
 
+   au->addCommandLineOption("--max-depth", "<levels>\nBatch mode. Keywords are nested as JSON objects on their dots down to this many levels; what is left of a keyword below that is kept whole as a member name. Default is no limit.");
+
    au->addCommandLineOption("--mtrsPerDeg", "<latitude> Gives meters per degree and meters per minute for a given latitude.");
 
    au->addCommandLineOption("--mtrs2ft", "<meters> Gives feet from meters (0.3048 meters per foot).");
@@ -222,6 +244,10 @@ void ossimInfo::setUsage(ossimArgumentParser& ap)
 
    au->addCommandLineOption("-s", "Force the ground rect to be the specified datum");
 
+   au->addCommandLineOption("--skip", "<item>[,<item>...]\nBatch mode. Leaves expensive items out of the records: corners (ground corners, i.e. four image to ground projections), dump (-d tag dump, e.g. all NITF TREs), geometry (-p), metadata (-m), palette (--palette) and support_files.");
+
+   au->addCommandLineOption("--threads", "<n>\nBatch mode. Files read at once. Default is the number of cores.");
+
    au->addCommandLineOption("--up-is-up or -u", "Rotation angle to \"up is up\" for an image.\nWill return 0 if image's projection is not affected by elevation.");
    au->addCommandLineOption("--up-is-up-gpt", "Computes up angle given gpt: <lat> <lon>");
    au->addCommandLineOption("--up-is-up-ipt", "Computes up angle given full res image point: <x> <y>");
@@ -263,6 +289,9 @@ void ossimInfo::setUsage(ossimArgumentParser& ap)
          << "    ossim-info -d -i -p myfile.ntf\n"
          << "      Typical usage case, i.e. do a dump of tags and print out image and\n"
          << "      projection information.\n\n"
+         << "    find /data -name \"*.ntf\" | ossim-info -i -p -m --skip corners --batch - > catalog.json\n"
+         << "      Image, projection and metadata information of every NITF under /data as\n"
+         << "      one JSON record a line, without the ground corners.\n\n"
          << std::endl;
    au->setDescription(description.str());
 
@@ -301,6 +330,15 @@ bool ossimInfo::initialize(ossimArgumentParser& ap)
       ossimArgumentParser::ossimParameter sp3(ts3);
       const char TRUE_KW[] = "true";
 
+      if( ap.read("--batch", sp1) )
+      {
+         m_kwl.add( BATCH_KW, ts1.c_str() );
+         if ( ap.argc() < 2 )
+         {
+            break;
+         }
+      }
+
       if( ap.read("--bounds") )
       {
          m_kwl.add( IMAGE_BOUNDS_KW, TRUE_KW );
@@ -561,6 +599,15 @@ bool ossimInfo::initialize(ossimArgumentParser& ap)
          }
       }
 
+      if( ap.read("--max-depth", sp1) )
+      {
+         m_kwl.add( MAX_DEPTH_KW, ts1.c_str() );
+         if ( ap.argc() < 2 )
+         {
+            break;
+         }
+      }
+
       if( ap.read("--mtrs2ft", sp1) )
       {
          m_kwl.add( MTRS2FT_KW, ts1.c_str());
@@ -710,6 +757,24 @@ bool ossimInfo::initialize(ossimArgumentParser& ap)
          }
       }
 
+      if( ap.read("--skip", sp1) )
+      {
+         m_kwl.add( SKIP_KW, ts1.c_str() );
+         if ( ap.argc() < 2 )
+         {
+            break;
+         }
+      }
+
+      if( ap.read("--threads", sp1) )
+      {
+         m_kwl.add( THREADS_KW, ts1.c_str() );
+         if ( ap.argc() < 2 )
+         {
+            break;
+         }
+      }
+
       if( ap.read("-u") || ap.read("--up-is-up") )
       {
          requiresInputImage = true;
@@ -803,6 +868,12 @@ bool ossimInfo::initialize(ossimArgumentParser& ap)
       m_kwl.add( IMAGE_FILE_KW, ap[1]  );
    }
 
+   // Batch mode takes its images from the list:
+   if ( m_kwl.find( BATCH_KW ) )
+   {
+      requiresInputImage = false;
+   }
+
    if ( (( ap.argc() == 1 ) && requiresInputImage) || (m_kwl.getSize() == 0) )
    {
       if ( requiresInputImage )
@@ -845,8 +916,16 @@ bool ossimInfo::execute()
 
       const char* lookup;
 
-      lookup = m_kwl.find(IMAGE_FILE_KW);
+      lookup = m_kwl.find(BATCH_KW);
       if ( lookup )
+      {
+         // Batch mode; the image options are for every file on the list:
+         executeBatch( ossimFilename(lookup) );
+         consumedKeys = KEY_COUNT;
+      }
+
+      lookup = m_kwl.find(IMAGE_FILE_KW);
+      if ( lookup && (consumedKeys < KEY_COUNT) )
       {
          ++consumedKeys;
          ossimFilename image = lookup;
@@ -1531,6 +1610,232 @@ ossim_uint32 ossimInfo::executeImageOptions(const ossimFilename& file)
 
 } // ossim_uint32 ossimInfo::executeImageOptions(const ossimFilename& file)
 
+namespace
+{
+   //---
+   // Adds key:value to root, one object a level for the dot separated parts
+   // of key down to maxDepth levels (0 for no limit). What is left of key
+   // below that, or below a part already holding a value, is the member name.
+   //---
+   void addToRecord( Json::Value& root,
+                     const std::string& key,
+                     const std::string& value,
+                     ossim_uint32 maxDepth )
+   {
+      Json::Value* node = &root;
+      std::string::size_type start = 0;
+      std::string::size_type dot = key.find( '.' );
+      ossim_uint32 depth = 1;
+      while ( ( dot != std::string::npos ) && ( !maxDepth || ( depth < maxDepth ) ) )
+      {
+         const std::string NAME = key.substr( start, dot - start );
+         const Json::Value* member = node->find( NAME.data(), NAME.data() + NAME.size() );
+         if ( member && !member->isObject() )
+         {
+            break;
+         }
+         node = &(*node)[NAME];
+         start = dot + 1;
+         dot = key.find( '.', start );
+         ++depth;
+      }
+      (*node)[ key.substr( start ) ] = value;
+   }
+
+   std::string toRecord( const Json::Value& root )
+   {
+      Json::StreamWriterBuilder builder;
+      builder["indentation"] = "";
+      return Json::writeString( builder, root );
+   }
+}
+
+void ossimInfo::executeBatch( const ossimFilename& list )
+{
+   std::ifstream listFile;
+   if ( list != "-" )
+   {
+      listFile.open( list.c_str() );
+      if ( !listFile.good() )
+      {
+         std::string errMsg = "ossimInfo::executeBatch ERROR:\nCould not open: ";
+         errMsg += list.string();
+         throw ossimException(errMsg);
+      }
+   }
+   std::istream& in = ( list != "-" ) ? listFile : std::cin;
+
+   ossimFilename outputFile = m_kwl.find( OUTPUT_FILE_KW );
+   ossim_uint64 failures = 0;
+   if ( outputFile.size() )
+   {
+      if ( !keyIsTrue( std::string(OVERWRITE_KW) ) && outputFile.exists() )
+      {
+         ossimNotify(ossimNotifyLevel_INFO)
+                  << "ERROR: File already exists: "  << outputFile
+                  << "\nUse -v option to overwrite."
+                  << std::endl;
+         return;
+      }
+      std::ofstream out( outputFile.c_str() );
+      if ( !out.good() )
+      {
+         std::string errMsg = "ossimInfo::executeBatch ERROR:\nCould not open: ";
+         errMsg += outputFile.string();
+         throw ossimException(errMsg);
+      }
+      failures = executeBatch( in, out );
+   }
+   else
+   {
+      failures = executeBatch( in, std::cout );
+   }
+
+   if ( failures )
+   {
+      ossimNotify(ossimNotifyLevel_WARN)
+               << "ossimInfo::executeBatch: " << failures
+               << " file(s) could not be read." << std::endl;
+   }
+}
+
+ossim_uint64 ossimInfo::executeBatch( std::istream& in, std::ostream& out )
+{
+   //---
+   // Support files are logged for the whole session, not per file, so they
+   // cannot be told apart with files read at once:
+   //---
+   if ( !isSkipped( SKIP_SUPPORT_FILES ) )
+   {
+      ossimString skip = m_kwl.findKey( std::string(SKIP_KW) );
+      m_kwl.addPair( std::string(SKIP_KW),
+                     ( skip.size() ? skip + "," : skip ) + SKIP_SUPPORT_FILES, true );
+   }
+
+   ossim_uint32 threads = ossimString( m_kwl.findKey( std::string(THREADS_KW) ) ).toUInt32();
+   if ( !threads )
+   {
+      threads = ossim::getNumberOfThreads();
+   }
+
+   std::mutex inMutex;
+   std::mutex outMutex;
+   std::atomic<ossim_uint64> failures(0);
+   ossim::parallelFor( threads, threads, [&](ossim_uint32 /* worker */)
+   {
+      std::string line;
+      while ( 1 )
+      {
+         {
+            std::lock_guard<std::mutex> lock( inMutex );
+            if ( !std::getline( in, line ) )
+            {
+               break;
+            }
+         }
+
+         const ossimFilename IMAGE_FILE = ossimString( line ).trim();
+         if ( IMAGE_FILE.empty() )
+         {
+            continue;
+         }
+
+         std::string record;
+         try
+         {
+            record = getImageRecord( IMAGE_FILE );
+         }
+         catch ( const std::exception& e )
+         {
+            ++failures;
+            Json::Value error( Json::objectValue );
+            error["file"]  = IMAGE_FILE.string();
+            error["error"] = e.what();
+            record = toRecord( error );
+         }
+         catch ( ... )
+         {
+            // Anything else thrown, e.g. a string, must not leave the worker:
+            ++failures;
+            Json::Value error( Json::objectValue );
+            error["file"]  = IMAGE_FILE.string();
+            error["error"] = "unknown exception";
+            record = toRecord( error );
+         }
+
+         // Keeps the list from growing with every file read:
+         ossimSupportFilesList::instance()->clear();
+
+         std::lock_guard<std::mutex> lock( outMutex );
+         out << record << "\n";
+      }
+   } );
+   out.flush();
+
+   return failures;
+}
+
+std::string ossimInfo::getImageRecord( const ossimFilename& file ) const
+{
+   const bool DUMP_FLAG    = keyIsTrue( std::string(DUMP_KW) );
+   const bool DNO_FLAG     = keyIsTrue( std::string(DUMP_NO_OVERVIEWS_KW) );
+   const bool GEOM_FLAG    = keyIsTrue( std::string(GEOM_INFO_KW) );
+   const bool INFO_FLAG    = keyIsTrue( std::string(IMAGE_INFO_KW) );
+   const bool META_FLAG    = keyIsTrue( std::string(METADATA_KW) );
+   const bool PALETTE_FLAG = keyIsTrue( std::string(PALETTE_KW) );
+
+   // Same default as executeImageOptions, image and geometry info:
+   const bool DEFAULTS = !( DUMP_FLAG || GEOM_FLAG || INFO_FLAG || META_FLAG || PALETTE_FLAG );
+
+   const bool dumpFlag     = DUMP_FLAG && !isSkipped( SKIP_DUMP );
+   const bool imageGeomFlag = ( DEFAULTS || GEOM_FLAG ) && !isSkipped( SKIP_GEOMETRY );
+   const bool imageInfoFlag = DEFAULTS || INFO_FLAG;
+   const bool metaDataFlag = META_FLAG && !isSkipped( SKIP_METADATA );
+   const bool paletteFlag  = PALETTE_FLAG && !isSkipped( SKIP_PALETTE );
+
+   ossimKeywordlist kwl;
+   if ( dumpFlag )
+   {
+      dumpImage( file, DNO_FLAG, kwl );
+   }
+   if ( imageGeomFlag || imageInfoFlag || metaDataFlag || paletteFlag )
+   {
+      // Note: openImageHandler throws ossimException if it can't open.
+      ossimRefPtr<ossimImageHandler> ih = openImageHandler( file );
+      if ( ih.valid() )
+      {
+         if ( metaDataFlag )
+         {
+            getImageMetadata( ih.get(), kwl );
+         }
+         if ( paletteFlag )
+         {
+            getImagePalette( ih.get(), kwl );
+         }
+         if ( imageInfoFlag )
+         {
+            getImageInfo( ih.get(), kwl, DNO_FLAG );
+         }
+         if ( imageGeomFlag )
+         {
+            getImageGeometryInfo( ih.get(), kwl, DNO_FLAG );
+         }
+      }
+   }
+
+   const ossim_uint32 MAX_DEPTH =
+      ossimString( m_kwl.findKey( std::string(MAX_DEPTH_KW) ) ).toUInt32();
+   Json::Value root( Json::objectValue );
+   root["file"] = file.string();
+   ossimKeywordlist::KeywordMap::const_iterator i = kwl.getMap().begin();
+   while ( i != kwl.getMap().end() )
+   {
+      addToRecord( root, i->first, i->second, MAX_DEPTH );
+      ++i;
+   }
+   return toRecord( root );
+}
+
 void ossimInfo::getImageInfo( const ossimFilename& file,
                               bool dumpFlag,
                               bool dnoFlag,
@@ -1862,7 +2167,7 @@ bool ossimInfo::getImageInfo( ossimImageHandler* ih, ossim_uint32 entry,
          bool outputEntry = true;
          if ( dnoFlag )
          {
-            if ( isImageEntryOverview() )
+            if ( isImageEntryOverview( ih ) )
             {
                outputEntry = false;
             }
@@ -2003,7 +2308,7 @@ bool ossimInfo::getImageGeometryInfo( ossimImageHandler* ih,
          bool outputEntry = true;
          if ( dnoFlag )
          {
-            if ( isImageEntryOverview() )
+            if ( isImageEntryOverview( ih ) )
             {
                outputEntry = false;
             }
@@ -2022,52 +2327,59 @@ bool ossimInfo::getImageGeometryInfo( ossimImageHandler* ih,
                geom->saveState(kwl, prefix);
 
                // Output support files list:
-               ossimSupportFilesList::instance()->save(kwl, prefix);
-
-               ossimGpt ulg;
-               ossimGpt llg;
-               ossimGpt lrg;
-               ossimGpt urg;
-
-               ossimDrect outputRect = ih->getBoundingRect();
-
-               geom->localToWorld(outputRect.ul(), ulg);
-               geom->localToWorld(outputRect.ll(), llg);
-               geom->localToWorld(outputRect.lr(), lrg);
-               geom->localToWorld(outputRect.ur(), urg);
-
-               //---
-               // *** HACK *** 
-               // Encountered CADRG RPF imagery where the left edge was longitude -180 and
-               // right edge +180. The projection code above reasonably maps all -180 to +180.
-               // This however breaks the image footprint since it would appear that the left
-               // and right edges were coincident instead of 360 degrees apart, i.e., a line
-               // segment instead of a rect. So added check here for coincident left and right
-               // edges and remapping left edge to -180.
-               //---
-               if ((ulg.lon == 180.0) && (urg.lon == 180.0))  
+               if ( !isSkipped( SKIP_SUPPORT_FILES ) )
                {
-                  ulg.lon = -180.0;
+                  ossimSupportFilesList::instance()->save(kwl, prefix);
                }
-               if ((llg.lon == 180.0) && (lrg.lon == 180.0))  
+
+               // Four image to ground projections; costly for sensor models:
+               if ( !isSkipped( SKIP_CORNERS ) )
                {
-                  llg.lon = -180.0;
-               }
+                  ossimGpt ulg;
+                  ossimGpt llg;
+                  ossimGpt lrg;
+                  ossimGpt urg;
+
+                  ossimDrect outputRect = ih->getBoundingRect();
+
+                  geom->localToWorld(outputRect.ul(), ulg);
+                  geom->localToWorld(outputRect.ll(), llg);
+                  geom->localToWorld(outputRect.lr(), lrg);
+                  geom->localToWorld(outputRect.ur(), urg);
+
+                  //---
+                  // *** HACK *** 
+                  // Encountered CADRG RPF imagery where the left edge was longitude -180 and
+                  // right edge +180. The projection code above reasonably maps all -180 to +180.
+                  // This however breaks the image footprint since it would appear that the left
+                  // and right edges were coincident instead of 360 degrees apart, i.e., a line
+                  // segment instead of a rect. So added check here for coincident left and right
+                  // edges and remapping left edge to -180.
+                  //---
+                  if ((ulg.lon == 180.0) && (urg.lon == 180.0))  
+                  {
+                     ulg.lon = -180.0;
+                  }
+                  if ((llg.lon == 180.0) && (lrg.lon == 180.0))  
+                  {
+                     llg.lon = -180.0;
+                  }
 
-               kwl.add(prefix, "ul_lat", ulg.latd(), true);
-               kwl.add(prefix, "ul_lon", ulg.lond(), true);
-               kwl.add(prefix, "ll_lat", llg.latd(), true);
-               kwl.add(prefix, "ll_lon", llg.lond(), true);
-               kwl.add(prefix, "lr_lat", lrg.latd(), true);
-               kwl.add(prefix, "lr_lon", lrg.lond(), true);
-               kwl.add(prefix, "ur_lat", urg.latd(), true);
-               kwl.add(prefix, "ur_lon", urg.lond(), true);
+                  kwl.add(prefix, "ul_lat", ulg.latd(), true);
+                  kwl.add(prefix, "ul_lon", ulg.lond(), true);
+                  kwl.add(prefix, "ll_lat", llg.latd(), true);
+                  kwl.add(prefix, "ll_lon", llg.lond(), true);
+                  kwl.add(prefix, "lr_lat", lrg.latd(), true);
+                  kwl.add(prefix, "lr_lon", lrg.lond(), true);
+                  kwl.add(prefix, "ur_lat", urg.latd(), true);
+                  kwl.add(prefix, "ur_lon", urg.lond(), true);
 
-               if(!kwl.find(ossimKeywordNames::TIE_POINT_LAT_KW))
-               {
-                  kwl.add(prefix, ossimKeywordNames::TIE_POINT_LAT_KW, ulg.latd(), true);
-                  kwl.add(prefix, ossimKeywordNames::TIE_POINT_LON_KW, ulg.lond(), true);
-               }
+                  if(!kwl.find(ossimKeywordNames::TIE_POINT_LAT_KW))
+                  {
+                     kwl.add(prefix, ossimKeywordNames::TIE_POINT_LAT_KW, ulg.latd(), true);
+                     kwl.add(prefix, ossimKeywordNames::TIE_POINT_LON_KW, ulg.lond(), true);
+                  }
+               } // if ( !isSkipped( SKIP_CORNERS ) )
 
                ossimDpt dpp;
                geom->getDegreesPerPixel( dpp );
@@ -3419,3 +3731,22 @@ bool ossimInfo::keyIsTrue( const std::string& key ) const
    }
    return result;
 }
+
+bool ossimInfo::isSkipped( const std::string& item ) const
+{
+   bool result = false;
+   ossimString value = m_kwl.findKey( std::string(SKIP_KW) );
+   if ( value.size() )
+   {
+      std::vector<ossimString> items = value.split( "," );
+      for ( std::vector<ossimString>::const_iterator i = items.begin(); i != items.end(); ++i )
+      {
+         if ( ossimString(*i).trim().downcase() == item )
+         {
+            result = true;
+            break;
+         }
+      }
+   }
+   return result;
+}
@@ -14,6 +14,7 @@
 #include <ossim/init/ossimInit.h>
 #include <ossim/base/ossimApplicationUsage.h>
 #include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimStringProperty.h>
 #include <ossim/elevation/ossimElevManager.h>
 #include <ossim/imaging/ossimImageHandler.h>
 #include <ossim/imaging/ossimImageHandlerRegistry.h>
@@ -36,6 +37,7 @@ ossimPointCloudTool::ossimPointCloudTool()
 ossimPointCloudTool::~ossimPointCloudTool()
 {
    m_pcHandler = 0;
+   m_lasReader = 0;
    m_prodGeom = 0;
    m_pcuFilter = 0;
 }
@@ -161,7 +163,7 @@ void ossimPointCloudTool::loadJSON(const Json::Value &json_request)
 
 bool ossimPointCloudTool::initialize()
 {
-   if (loadPC())
+   if (!loadPC())
    {
       ossimNotify(ossimNotifyLevel_WARN)
               << "ossimPointCloudTool::initialize ERR: Cannot open PC file at <"<<m_pcFile
@@ -172,13 +174,35 @@ bool ossimPointCloudTool::initialize()
    if (!m_demFile.empty() && !loadDem())
       return false;
 
+   // The input supplies the filter's bounding rect and null value:
    m_pcuFilter = new ossimPointCloudUtilityFilter(this);
+   if (m_lasReader.valid())
+      m_pcuFilter->connectMyInputTo(m_lasReader.get());
+   else
+      m_pcuFilter->connectMyInputTo(m_pciHandler.get());
+   m_pcuFilter->initialize();
    return true;
 }
 
 bool ossimPointCloudTool::loadPC()
 {
-   // DEM provided as file on command line, reset the elev manager to use only this:
+   // LAS is binned straight from the point records (see ossimLasGridder), so memory does not
+   // grow with the point count:
+   m_lasReader = new ossimLasReader;
+   m_lasReader->setFilename(m_pcFile);
+   if (m_lasReader->open())
+   {
+      m_prodGeom = m_lasReader->getImageGeometry();
+      if (!m_prodGeom.valid() || !m_prodGeom->getAsMapProjection())
+         return false;
+
+      if (m_gsd != 0)
+         setGSD(m_gsd);
+
+      return true;
+   }
+   m_lasReader = 0;
+
    m_pcHandler = ossimPointCloudHandlerRegistry::instance()->open(m_pcFile);
    if(!m_pcHandler.valid())
    {
@@ -227,13 +251,45 @@ bool ossimPointCloudTool::loadDem()
 
 void ossimPointCloudTool::setGSD(const double& meters_per_pixel)
 {
-   if (m_prodGeom->getAsMapProjection() && (meters_per_pixel > 0))
+   ossimMapProjection* proj = m_prodGeom->getAsMapProjection();
+   if (proj && (meters_per_pixel > 0))
    {
       m_gsd = meters_per_pixel;
-      m_prodGeom->getAsMapProjection()->setMetersPerPixel(ossimDpt(m_gsd, m_gsd));
+      proj->setMetersPerPixel(ossimDpt(m_gsd, m_gsd));
+
+      // The LAS reader grids in projection units, keep it in step with the product geometry:
+      if (m_lasReader.valid())
+      {
+         ossim_float64 gsd = proj->isGeographic() ? proj->getDecimalDegreesPerPixel().x : m_gsd;
+         m_lasReader->setProperty(new ossimStringProperty("gsd", ossimString::toString(gsd)));
+      }
    }
 }
 
+ossimRefPtr<ossimImageData> ossimPointCloudTool::getElevationTile(bool highest,
+                                                                  const ossimIrect& rect,
+                                                                  ossim_uint32 resLevel)
+{
+   ossimRefPtr<ossimImageData> tile = 0;
+   if (m_lasReader.valid())
+   {
+      m_lasReader->setElevationStatistic(highest ? ossimLasGridder::HIGHEST : ossimLasGridder::LOWEST);
+      tile = m_lasReader->getTile(rect, resLevel);
+   }
+   else if (m_pciHandler.valid())
+   {
+      m_pciHandler->setCurrentEntry(highest ? ossimPointCloudImageHandler::HIGHEST
+                                            : ossimPointCloudImageHandler::LOWEST);
+      tile = m_pciHandler->getTile(rect, resLevel);
+   }
+
+   // Both sources hand back their one internal tile:
+   if (tile.valid())
+      tile = static_cast<ossimImageData*>(tile->dup());
+
+   return tile;
+}
+
 bool ossimPointCloudTool::execute()
 {
    // See if an LUT is requested:
@@ -59,6 +59,7 @@ ossimShorelineTool::ossimShorelineTool()
      m_smoothing(0),
      m_noVector(false)
 {
+   m_tiledWrite = true;
 }
 
 ossimShorelineTool::~ossimShorelineTool()
@@ -346,7 +347,7 @@ ossimRefPtr<ossimImageData> ossimShorelineTool::getChip(const ossimIrect& boundi
    m_geom->setImageSize( m_aoiViewRect.size() );
    m_geom->localToWorld(m_aoiViewRect, m_aoiGroundRect);
 
-   return m_procChain->getTile( m_aoiViewRect, 0 );
+   return m_chipRenderer.getChip( m_procChain.get(), m_aoiViewRect, 0 );
 }
 
 bool ossimShorelineTool::execute()
@@ -504,22 +505,22 @@ void ossimShorelineTool::autoComputeThreshold()
    // Use the K-means classifier to determine the threshold point based on the histogram clustering
    // into two groups: land and water.
 
-   // If an input histogram was provided, use it. Otherwise compute one:
+   // If an input histogram was provided, use it. Otherwise compute one over the overviews:
    ossimImageHandler* handler = dynamic_cast<ossimImageHandler*>(m_procChain->getFirstSource());
+   if (!handler && (m_algorithm == PAN_THRESHOLD) && !m_imgLayers.empty())
+      handler = m_imgLayers[0]->getImageHandler().get();
    ostringstream xmsg;
    if (!handler)
    {
       xmsg<<"ossimShorelineUtil:"<<__LINE__<<"  No input handler in procession chain.";
       throw ossimException(xmsg.str());
    }
+   ossimRefPtr<ossimHistogram> band_histo = 0;
    ossimRefPtr<ossimMultiResLevelHistogram> multi_histo = handler->getImageHistogram();
-   if (!multi_histo.valid())
-   {
-      xmsg<<"ossimShorelineUtil:"<<__LINE__<<"  Could not establish an index histogram.";
-      throw ossimException(xmsg.str());
-   }
-
-   ossimRefPtr<ossimHistogram> band_histo = multi_histo->getHistogram(0);
+   if (multi_histo.valid())
+      band_histo = multi_histo->getHistogram(0);
+   else
+      band_histo = computeHistogram(handler, 0);
    if (!band_histo.valid())
    {
       xmsg<<"ossimShorelineUtil:"<<__LINE__<<"  Null band histogram returned!";
@@ -39,6 +39,7 @@ const char* ossimSlopeTool::DESCRIPTION  =
 ossimSlopeTool::ossimSlopeTool()
 : m_recursiveCall (false)
 {
+   m_tiledWrite = true;
 }
 
 ossimSlopeTool::~ossimSlopeTool()
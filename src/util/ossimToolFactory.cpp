@@ -6,6 +6,7 @@
 //**************************************************************************************************
 
 #include <ossim/util/ossimBandMergeTool.h>
+#include <ossim/util/ossimChipperTool.h>
 #include <ossim/util/ossimHillshadeTool.h>
 #include <ossim/util/ossimHlzTool.h>
 #include <ossim/util/ossimInfo.h>
@@ -81,6 +82,9 @@ ossimTool* ossimToolFactory::createTool(const std::string& argName) const
    if ((utilName == "pointcloud") || (argName == "ossimPointCloudTool"))
       return new ossimPointCloudTool;
 
+   if ((utilName == "chipper") || (argName == "ossimChipperTool"))
+      return new ossimChipperTool;
+
 #if OSSIM_HAS_HDF5
    if ((utilName == "hdf5") || (argName == "ossimHdf5Tool"))
       return new ossimHdf5Tool;
@@ -102,6 +106,7 @@ void ossimToolFactory::getCapabilities(std::map<std::string, std::string>& capab
    capabilities.insert(pair<string, string>("bandmerge", ossimBandMergeTool::DESCRIPTION));
    capabilities.insert(pair<string, string>("subimage", ossimSubImageTool::DESCRIPTION));
    capabilities.insert(pair<string, string>("pointcloud", ossimPointCloudTool::DESCRIPTION));
+   capabilities.insert(pair<string, string>("chipper", ossimChipperTool::DESCRIPTION));
 #if OSSIM_HAS_HDF5
    capabilities.insert(pair<string, string>("hdf5", ossimHdf5Tool::DESCRIPTION));
 #endif
@@ -127,6 +132,7 @@ void ossimToolFactory::getTypeNameList(vector<ossimString>& typeList) const
    typeList.push_back("ossimBandMergeUtil");
    typeList.push_back("ossimSubImageTool");
    typeList.push_back("ossimPointCloudTool");
+   typeList.push_back("ossimChipperTool");
 #if OSSIM_HAS_HDF5
    typeList.push_back("ossimHdf5Tool");
 #endif
@@ -0,0 +1,176 @@
+//**************************************************************************************************
+//
+//     OSSIM Open Source Geospatial Data Processing Library
+//     See top level LICENSE.txt file for license information
+//
+//**************************************************************************************************
+
+#include <ossim/util/ossimViewshedSweep.h>
+#include <ossim/base/ossimCommon.h>
+#include <cmath>
+
+// Horizon of the observer's own cell, below any line of sight. Finite so interpolating against it
+// never makes a NaN:
+static const ossim_float32 NO_HORIZON = -1.0e30f;
+
+ossimViewshedSweep::ossimViewshedSweep()
+   : m_heights(0),
+     m_width(0),
+     m_height(0),
+     m_gsd(1.0, 1.0),
+     m_radius(0.0),
+     m_startFov(0.0),
+     m_stopFov(0.0),
+     m_visibleValue(1),
+     m_hiddenValue(128),
+     m_overlayValue(255)
+{
+}
+
+void ossimViewshedSweep::setElevations(const ossim_float32* heights,
+                                       ossim_uint32 width,
+                                       ossim_uint32 height,
+                                       const ossimDpt& gsd)
+{
+   m_heights = heights;
+   m_width = static_cast<ossim_int32>(width);
+   m_height = static_cast<ossim_int32>(height);
+   m_gsd = gsd;
+}
+
+void ossimViewshedSweep::setRadius(double radius)
+{
+   m_radius = radius;
+}
+
+void ossimViewshedSweep::setFov(double start, double stop)
+{
+   m_startFov = start;
+   m_stopFov = stop;
+}
+
+void ossimViewshedSweep::setCoding(ossim_uint8 visible, ossim_uint8 hidden, ossim_uint8 overlay)
+{
+   m_visibleValue = visible;
+   m_hiddenValue = hidden;
+   m_overlayValue = overlay;
+}
+
+bool ossimViewshedSweep::inFov(ossim_int32 dx, ossim_int32 dy) const
+{
+   if (m_startFov == m_stopFov)
+      return true;
+
+   // Azimuth clockwise from north, image y pointing south:
+   double azimuth = std::atan2(static_cast<double>(dx), static_cast<double>(-dy)) * DEG_PER_RAD;
+   if (azimuth < 0.0)
+      azimuth += 360.0;
+   if (m_startFov < m_stopFov)
+      return (azimuth >= m_startFov) && (azimuth <= m_stopFov);
+   return (azimuth >= m_startFov) || (azimuth <= m_stopFov);
+}
+
+void ossimViewshedSweep::compute(const ossimIpt& observer,
+                                 double height,
+                                 ossim_uint8* bitmap,
+                                 std::vector<ossim_float32>& horizon) const
+{
+   const ossim_int32 OX = observer.x;
+   const ossim_int32 OY = observer.y;
+   if ( !m_heights || !bitmap || (OX < 0) || (OY < 0) || (OX >= m_width) || (OY >= m_height) )
+      return;
+
+   horizon.resize(static_cast<size_t>(m_width) * m_height);
+   ossim_float32* hz = &horizon.front();
+   hz[OY * m_width + OX] = NO_HORIZON;
+
+   // Rings out to the farthest edge, or just past the radius for its circle:
+   ossim_int32 lastRing = ossim::max(ossim::max(OX, OY),
+                                     ossim::max(m_width - 1 - OX, m_height - 1 - OY));
+   const double R2 = m_radius * m_radius;
+   const double R2_CIRCLE = (m_radius + 1.0) * (m_radius + 1.0);
+   if (m_radius > 0.0)
+      lastRing = ossim::min(lastRing, static_cast<ossim_int32>(std::ceil(m_radius)) + 1);
+
+   for (ossim_int32 k = 1; k <= lastRing; ++k)
+   {
+      const ossim_int32 TOP    = OY - k;
+      const ossim_int32 BOTTOM = OY + k;
+      const ossim_int32 LEFT   = OX - k;
+      const ossim_int32 RIGHT  = OX + k;
+      const double INNER = static_cast<double>(k - 1) / k;
+
+      for (ossim_int32 y = ossim::max(TOP, 0); y <= ossim::min(BOTTOM, m_height - 1); ++y)
+      {
+         // Whole rows at the top and bottom of the ring, its two sides in between:
+         const bool EDGE = (y == TOP) || (y == BOTTOM);
+         const ossim_int32 STEP = EDGE ? 1 : 2 * k;
+         for (ossim_int32 x = EDGE ? ossim::max(LEFT, 0) : LEFT;
+              x <= ossim::min(RIGHT, m_width - 1); x += STEP)
+         {
+            if (x < 0)
+               continue;
+
+            const ossim_int32 DX = x - OX;
+            const ossim_int32 DY = y - OY;
+            const size_t IDX = static_cast<size_t>(y) * m_width + x;
+
+            // Horizon from the two cells of the previous ring the line of sight passes between:
+            ossim_float32 sightHorizon = NO_HORIZON;
+            if (k > 1)
+            {
+               size_t a;
+               size_t b;
+               double t;
+               if (std::abs(DX) >= std::abs(DY))
+               {
+                  t = DY * INNER;
+                  const double T0 = std::floor(t);
+                  const ossim_int32 XI = OX + ( (DX > 0) ? k - 1 : 1 - k );
+                  a = static_cast<size_t>(OY + static_cast<ossim_int32>(T0)) * m_width + XI;
+                  t -= T0;
+                  b = (t > 0.0) ? a + m_width : a;
+               }
+               else
+               {
+                  t = DX * INNER;
+                  const double T0 = std::floor(t);
+                  const ossim_int32 YI = OY + ( (DY > 0) ? k - 1 : 1 - k );
+                  a = static_cast<size_t>(YI) * m_width + OX + static_cast<ossim_int32>(T0);
+                  t -= T0;
+                  b = (t > 0.0) ? a + 1 : a;
+               }
+               sightHorizon = hz[a] + static_cast<ossim_float32>(t) * (hz[b] - hz[a]);
+            }
+
+            // Elevation angle, as rise over run, of the cell, and the horizon it leaves behind:
+            const ossim_float32 Z = m_heights[IDX];
+            const bool NULL_CELL = ossim::isnan(Z);
+            ossim_float32 angle = NO_HORIZON;
+            if (!NULL_CELL)
+            {
+               const double RUN_X = DX * m_gsd.x;
+               const double RUN_Y = DY * m_gsd.y;
+               angle = static_cast<ossim_float32>(
+                  (Z - height) / std::sqrt(RUN_X * RUN_X + RUN_Y * RUN_Y));
+            }
+            hz[IDX] = ossim::max(sightHorizon, angle);
+
+            if (m_radius > 0.0)
+            {
+               const double D2 = static_cast<double>(DX) * DX + static_cast<double>(DY) * DY;
+               if (D2 >= R2)
+               {
+                  if (D2 < R2_CIRCLE)
+                     bitmap[IDX] = m_overlayValue;
+                  continue;
+               }
+            }
+            if ( NULL_CELL || !inFov(DX, DY) )
+               continue;
+
+            bitmap[IDX] = (angle >= sightHorizon) ? m_visibleValue : m_hiddenValue;
+         }
+      }
+   }
+}
@@ -25,8 +25,12 @@
 #include <ossim/imaging/ossimImageWriterFactoryRegistry.h>
 #include <ossim/imaging/ossimMemoryImageSource.h>
 #include <ossim/imaging/ossimIndexToRgbLutFilter.h>
+#include <ossim/parallel/ossimParallelFor.h>
 #include <ossim/util/ossimViewshedTool.h>
+#include <ossim/util/ossimViewshedSweep.h>
 #include <ossim/base/Thread.h>
+#include <fstream>
+#include <iomanip>
 
 using namespace std;
 
@@ -42,6 +46,8 @@ static const string RETICLE_SIZE_KW      = "reticle_size";
 static const string VIEWSHED_CODING_KW   = "viewshed_coding";
 static const string AOI_SIZE_METERS_KW   = "aoi_size_meters";
 static const string THREADS_KW            = "threads";
+static const string ALGORITHM_KW          = "algorithm";
+static const string OBSERVERS_FILE_KW     = "observers_file";
 
 
 ossimViewshedTool::ossimViewshedTool()
@@ -61,6 +67,7 @@ ossimViewshedTool::ossimViewshedTool()
     m_startFov(0),
     m_stopFov(0),
     m_threadBySector(false),
+    m_algorithm(RADIAL_ALGORITHM),
     d_accumT(0)
 {
    m_observerGpt.makeNan();
@@ -86,6 +93,13 @@ void ossimViewshedTool::setUsage(ossimArgumentParser& ap)
    au->setCommandLineUsage(usageString);
 
    // Set the command line options:
+   au->addCommandLineOption(
+         "--algorithm <radial|xdraw>", "Line-of-sight algorithm. \"radial\" (default) marches "
+         "each radial separately, exact along the radials. \"xdraw\" sweeps the DEM in memory "
+         "once, sharing the horizon of the cells near the observer among all the lines of sight "
+         "through them. It is much faster but interpolates that horizon, so a few cells in a "
+         "thousand on rolling terrain can come out differently from exact lines of sight. "
+         "--horizon and --tbs always use radials.");
    au->addCommandLineOption(
          "--fov <start> <end>", "Optional arguments specifying the field-of"
          "-view boundary azimuths (in degrees). By default, a 360 deg FOV is"
@@ -97,6 +111,12 @@ void ossimViewshedTool::setUsage(ossimArgumentParser& ap)
    au->addCommandLineOption(
          "--horizon <filename>", "Experimental. Outputs the max elevation angles "
          "for all azimuths to <filename>, for horizon profiling.");
+   au->addCommandLineOption(
+         "--observers <filename>", "Batch mode. Computes the viewshed of each observer listed in "
+         "<filename>, one \"<lat> <lon> [<height-of-eye>]\" a line, on one DEM chip. The output "
+         "image holds the number of observers seeing each pixel, and the bitmap of each observer "
+         "is written beside it as <output>_<n>.<ext>. Replaces <obs_lat> <obs_lon>. Always uses "
+         "the xdraw sweep.");
    au->addCommandLineOption(
          "--radius <meters>", "Specifies max visibility in meters. Required "
          "unless --size is specified. This option constrains output to a circle, "
@@ -126,7 +146,9 @@ void ossimViewshedTool::setUsage(ossimArgumentParser& ap)
    description << DESCRIPTION << "\n\nExamples:\n\n"
          "    "<<appName<<" viewshed --radius 50  28.0 -80.5 output-hlz.tif\n"
          "\nAn alternate command line provides switch for observer lat and lon:\n\n"
-         "    "<<appName<<" viewshed --rlz 25 --observer 28.0 -80.5  output-hlz.tif \n";
+         "    "<<appName<<" viewshed --rlz 25 --observer 28.0 -80.5  output-hlz.tif \n"
+         "\nCumulative viewshed of the observers listed in a file:\n\n"
+         "    "<<appName<<" viewshed --radius 5000 --observers towers.txt  output-counts.tif \n";
    au->setDescription(description.str());
 }
 
@@ -150,6 +172,9 @@ bool ossimViewshedTool::initialize(ossimArgumentParser& ap)
    string ts3;
    ossimArgumentParser::ossimParameter sp3(ts3);
 
+   if ( ap.read("--algorithm", sp1) )
+      m_kwl.addPair( ALGORITHM_KW, ts1 );
+
    if ( ap.read("--fov", sp1, sp2) )
    {
       double startFov = ossimString(ts1).toDouble();
@@ -174,6 +199,12 @@ bool ossimViewshedTool::initialize(ossimArgumentParser& ap)
       numArgsExpected -= 2;
    }
 
+   if ( ap.read("--observers", sp1) )
+   {
+      m_kwl.addPair( OBSERVERS_FILE_KW, ts1 );
+      numArgsExpected -= 2;
+   }
+
    if ( ap.read("--radius", sp1) )
       m_kwl.addPair( VISIBILITY_RADIUS_KW, ts1 );
 
@@ -210,12 +241,15 @@ bool ossimViewshedTool::initialize(ossimArgumentParser& ap)
    }
    else
    {
-      ossimString latstr = ap[1];
-      ossimString lonstr = ap[2];
-      ostringstream value;
-      value<<latstr<<" "<<lonstr;
-      m_kwl.addPair( OBSERVER_KW, value.str() );
-      ap.remove(1,2);
+      if (numArgsExpected == 4)
+      {
+         ossimString latstr = ap[1];
+         ossimString lonstr = ap[2];
+         ostringstream value;
+         value<<latstr<<" "<<lonstr;
+         m_kwl.addPair( OBSERVER_KW, value.str() );
+         ap.remove(1,2);
+      }
       processRemainingArgs(ap);
    }
 
@@ -234,6 +268,22 @@ void ossimViewshedTool::initialize(const ossimKeywordlist& kwl)
       }
    }
    
+   value = kwl.findKey(ALGORITHM_KW);
+   if (!value.empty())
+   {
+      value.downcase();
+      if (value == "radial")
+         m_algorithm = RADIAL_ALGORITHM;
+      else if (value == "xdraw")
+         m_algorithm = XDRAW_ALGORITHM;
+      else
+      {
+         ostringstream xmsg;
+         xmsg<<"ossimViewshedUtil:"<<__LINE__<<" Unknown algorithm <"<<value<<">."<<ends;
+         throw ossimException(xmsg.str());
+      }
+   }
+
    value = kwl.findKey(FOV_KW);
    if (!value.empty())
    {
@@ -291,6 +341,11 @@ void ossimViewshedTool::initialize(const ossimKeywordlist& kwl)
       m_displayAsRadar = true;
    }
 
+   // Batch of observers, the first standing in for the single one where one is needed:
+   m_observersFile = kwl.findKey(OBSERVERS_FILE_KW);
+   if (!m_observersFile.empty() && readObserversFile() && m_observerGpt.hasNans())
+      m_observerGpt = m_observers.front().gpt;
+
    // If running simulation, clear out all pre-loaded elevation databases:
    if (m_simulation)
    {
@@ -308,6 +363,7 @@ void ossimViewshedTool::clear()
    m_visRadius = 0;
    m_outBuffer = 0;
    m_horizonMap.clear();
+   m_observers.clear();
    m_jobMtQueue = 0;
    ossimChipProcTool::clear();
 }
@@ -363,11 +419,21 @@ void ossimViewshedTool::initializeAOI()
       if (!proj)
          return;
 
-      ossimDpt metersPerDegree (m_observerGpt.metersPerDegree());
-      double dlat = m_visRadius/metersPerDegree.y;
-      double dlon = m_visRadius/metersPerDegree.x;
-      ossimGpt ulg (m_observerGpt.lat + dlat, m_observerGpt.lon - dlon);
-      ossimGpt lrg (m_observerGpt.lat - dlat, m_observerGpt.lon + dlon);
+      // Bounds of the visibility circles of the observers:
+      ossimGpt ulg (m_observerGpt);
+      ossimGpt lrg (m_observerGpt);
+      ossim_uint32 numObservers = ossim::max<ossim_uint32>(m_observers.size(), 1);
+      for (ossim_uint32 i=0; i<numObservers; ++i)
+      {
+         const ossimGpt& obs = m_observers.empty() ? m_observerGpt : m_observers[i].gpt;
+         ossimDpt metersPerDegree (obs.metersPerDegree());
+         double dlat = m_visRadius/metersPerDegree.y;
+         double dlon = m_visRadius/metersPerDegree.x;
+         ulg.lat = ossim::max(ulg.lat, obs.lat + dlat);
+         ulg.lon = ossim::min(ulg.lon, obs.lon - dlon);
+         lrg.lat = ossim::min(lrg.lat, obs.lat - dlat);
+         lrg.lon = ossim::max(lrg.lon, obs.lon + dlon);
+      }
 
       m_aoiGroundRect = ossimGrect(ulg, lrg);
       proj->setUlTiePoints(ulg);
@@ -392,6 +458,12 @@ void ossimViewshedTool::initProcessingChain()
    m_observerGpt.hgt = elevMgr->getHeightAboveEllipsoid(m_observerGpt);
    m_observerGpt.hgt += m_obsHgtAbvTer;
    m_geom->worldToLocal(m_observerGpt, m_observerVpt);
+   for (ossim_uint32 i=0; i<m_observers.size(); ++i)
+   {
+      Observer& obs = m_observers[i];
+      obs.gpt.hgt = elevMgr->getHeightAboveEllipsoid(obs.gpt) + obs.heightOfEye;
+      m_geom->worldToLocal(obs.gpt, obs.vpt);
+   }
 
    ossimRefPtr<ossimMapProjection> mapProj =
          dynamic_cast<ossimMapProjection*>(m_geom->getProjection());
@@ -401,10 +473,9 @@ void ossimViewshedTool::initProcessingChain()
       computeRadius();
    if (m_halfWindow == 0)
       m_halfWindow = ossim::round<ossim_int32, double>(m_visRadius/m_gsd.x);
-   ossim_uint32 size = 2*m_halfWindow + 1;
 
    // If no AOI defined, just use the visibility rectangle:
-   ossimIrect visRect (ossimIpt(m_observerVpt), size, size);
+   ossimIrect visRect = getVisibilityRect();
    if (m_aoiViewRect.hasNans())
    {
       m_aoiViewRect = visRect;
@@ -420,7 +491,8 @@ void ossimViewshedTool::initProcessingChain()
       throw ossimException(xmsg.str());
    }
    m_outBuffer = ossimImageDataFactory::instance()->
-         create(0, OSSIM_UINT8, 1, m_aoiViewRect.width(), m_aoiViewRect.height());
+         create(0, (m_observers.empty() ? OSSIM_UINT8 : OSSIM_UINT16), 1,
+                m_aoiViewRect.width(), m_aoiViewRect.height());
    if(!m_outBuffer.valid())
    {
       xmsg<<"ossimViewshedUtil:"<<__LINE__<<" Output buffer allocation failed." << ends;
@@ -485,9 +557,10 @@ bool ossimViewshedTool::execute()
 
 bool ossimViewshedTool::computeViewshed()
 {
-   // Allocate the output image buffer:
-   m_outBuffer = ossimImageDataFactory::instance()->create(0, OSSIM_UINT8, 1, m_aoiViewRect.width(),
-                                                           m_aoiViewRect.height());
+   // Allocate the output image buffer, of counts of observers in batch mode:
+   m_outBuffer = ossimImageDataFactory::instance()->create(
+         0, (m_observers.empty() ? OSSIM_UINT8 : OSSIM_UINT16), 1, m_aoiViewRect.width(),
+         m_aoiViewRect.height());
 
    ostringstream xmsg;
    if (!m_outBuffer.valid() || !m_memSource.valid())
@@ -502,6 +575,14 @@ bool ossimViewshedTool::computeViewshed()
    m_outBuffer->fill(m_procChain->getNullPixelValue());
    m_memSource->setImage(m_outBuffer);
 
+   // The sweep handles batches, the field of view and the AOI itself. Horizon profiles and thread
+   // by sector belong to the radials:
+   if ( !m_observers.empty() ||
+        ((m_algorithm == XDRAW_ALGORITHM) && m_horizonFile.empty() && !m_threadBySector) )
+   {
+      return computeSweepViewshed();
+   }
+
    // Initialize the radials after intersecting the requested FOV with the FOV required to see the
    // full AOI (not applicable if observer inside AOI). Skip radial init if no intersection found:
    if (!optimizeFOV())
@@ -574,6 +655,233 @@ bool ossimViewshedTool::computeViewshed()
    return true;
 }
 
+bool ossimViewshedTool::computeSweepViewshed()
+{
+   // The observers, the single one when not in batch mode:
+   vector<Observer> observers (m_observers);
+   const bool BATCH = !observers.empty();
+   if (!BATCH)
+   {
+      Observer obs;
+      obs.gpt = m_observerGpt;
+      obs.vpt = m_observerVpt;
+      obs.heightOfEye = m_obsHgtAbvTer;
+      observers.push_back(obs);
+   }
+
+   // One DEM chip for all observers, covering the lines of sight from each into the AOI:
+   ossimIrect chipRect (m_aoiViewRect);
+   for (ossim_uint32 i=0; i<observers.size(); ++i)
+      chipRect = chipRect.combine(ossimIrect(ossimIpt(observers[i].vpt), 1, 1));
+   chipRect = chipRect.clipToRect(getVisibilityRect());
+   const ossim_uint32 CHIP_WIDTH = chipRect.width();
+   const size_t CHIP_SIZE = static_cast<size_t>(CHIP_WIDTH) * chipRect.height();
+
+   if (m_numThreads == 0)
+      m_numThreads = ossim::getNumberOfThreads();
+
+   ossimNotify(ossimNotifyLevel_INFO) << "\nLoading "<<CHIP_WIDTH<<" x "<<chipRect.height()
+         <<" DEM chip..."<<endl;
+   vector<ossim_float32> heights;
+   loadElevations(chipRect, heights);
+   if (needsAborting())
+      return false;
+
+   ossimViewshedSweep sweep;
+   sweep.setElevations(&heights.front(), CHIP_WIDTH, chipRect.height(), m_gsd);
+   if (m_displayAsRadar)
+      sweep.setRadius(m_halfWindow);
+   sweep.setFov(m_startFov, m_stopFov);
+   sweep.setCoding(m_visibleValue, m_hiddenValue, m_overlayValue);
+
+   // Observers are swept a thread each, each thread with its own bitmap and horizon:
+   const ossim_uint32 SLOTS = ossim::max<ossim_uint32>(
+         ossim::min<ossim_uint32>(m_numThreads, observers.size()), 1);
+   vector< vector<ossim_uint8> > bitmaps (SLOTS, vector<ossim_uint8>(CHIP_SIZE));
+   vector< vector<ossim_float32> > horizons (SLOTS);
+
+   // In batch mode the counts of observers seeing each AOI pixel add up as the bitmaps come out:
+   vector<ossim_uint32> counts;
+   ossimRefPtr<ossimImageData> bitmap = m_outBuffer;
+   const bool WRITE_BITMAPS = BATCH && !m_productFilename.empty();
+   if (BATCH)
+   {
+      counts.resize(m_aoiViewRect.area(), 0);
+      bitmap = ossimImageDataFactory::instance()->create(0, OSSIM_UINT8, 1, m_aoiViewRect.width(),
+                                                         m_aoiViewRect.height());
+      bitmap->initialize();
+      bitmap->setImageRectangle(m_aoiViewRect);
+   }
+
+   ossimNotify(ossimNotifyLevel_INFO) << "Sweeping "<<observers.size()<<" observer(s) with "
+         <<SLOTS<<" thread(s)..."<<endl;
+   for (ossim_uint32 first=0; first<observers.size(); first+=SLOTS)
+   {
+      const ossim_uint32 COUNT = ossim::min<ossim_uint32>(SLOTS, observers.size() - first);
+      ossim::parallelFor(COUNT, SLOTS, [&](ossim_uint32 slot)
+      {
+         const Observer& obs = observers[first + slot];
+         std::fill(bitmaps[slot].begin(), bitmaps[slot].end(), 0);
+         sweep.compute(ossimIpt(obs.vpt) - chipRect.ul(), obs.gpt.hgt, &bitmaps[slot].front(),
+                       horizons[slot]);
+      });
+
+      for (ossim_uint32 slot=0; slot<COUNT; ++slot)
+      {
+         if (BATCH)
+         {
+            const ossimIpt OFFSET = m_aoiViewRect.ul() - chipRect.ul();
+            ossim_uint32* count = &counts.front();
+            for (ossim_uint32 y=0; y<m_aoiViewRect.height(); ++y)
+            {
+               const ossim_uint8* row =
+                     &bitmaps[slot][static_cast<size_t>(y + OFFSET.y) * CHIP_WIDTH + OFFSET.x];
+               for (ossim_uint32 x=0; x<m_aoiViewRect.width(); ++x, ++count)
+               {
+                  if (row[x] == m_visibleValue)
+                     ++(*count);
+               }
+            }
+         }
+         if (!BATCH || WRITE_BITMAPS)
+            bitmap->loadTile(&bitmaps[slot].front(), chipRect, OSSIM_BSQ);
+         if (WRITE_BITMAPS)
+         {
+            paintReticle(bitmap.get(), observers[first + slot].vpt);
+            writeObserverBitmap(bitmap.get(), getObserverFilename(first + slot));
+         }
+      }
+
+      if (needsAborting())
+         return false;
+   }
+
+   if (BATCH)
+   {
+      ossim_uint16* buf = static_cast<ossim_uint16*>(m_outBuffer->getBuf(0));
+      for (size_t i=0; i<counts.size(); ++i)
+      {
+         buf[i] = static_cast<ossim_uint16>(
+               ossim::min<ossim_uint32>(counts[i], OSSIM_DEFAULT_MAX_PIX_UINT16));
+      }
+   }
+   else
+      paintReticle();
+   m_outBuffer->validate();
+
+   ossimNotify(ossimNotifyLevel_INFO) << "Finished sweeping observers."<<endl;
+   return true;
+}
+
+void ossimViewshedTool::loadElevations(const ossimIrect& rect, vector<ossim_float32>& heights) const
+{
+   const ossim_uint32 WIDTH = rect.width();
+   heights.resize(static_cast<size_t>(WIDTH) * rect.height());
+   const double GROUND = m_observerGpt.hgt - m_obsHgtAbvTer;
+
+   // A row at a time, like the radials, through the geometry and the elevation manager:
+   ossim::parallelFor(rect.height(), m_numThreads, [&](ossim_uint32 y)
+   {
+      ossimGpt gpt;
+      ossim_float32* row = &heights[static_cast<size_t>(y) * WIDTH];
+      for (ossim_uint32 x=0; x<WIDTH; ++x)
+      {
+         m_geom->localToWorld(ossimDpt(rect.ul().x + x, rect.ul().y + y), gpt);
+         if (m_simulation && ossim::isnan(gpt.hgt))
+            gpt.hgt = GROUND;
+         row[x] = static_cast<ossim_float32>(gpt.hgt);
+      }
+   });
+}
+
+ossimIrect ossimViewshedTool::getVisibilityRect() const
+{
+   ossim_uint32 size = 2*m_halfWindow + 1;
+   ossimIrect visRect (ossimIpt(m_observerVpt), size, size);
+   for (ossim_uint32 i=0; i<m_observers.size(); ++i)
+      visRect = visRect.combine(ossimIrect(ossimIpt(m_observers[i].vpt), size, size));
+   return visRect;
+}
+
+bool ossimViewshedTool::readObserversFile()
+{
+   ostringstream xmsg;
+   m_observers.clear();
+
+   ifstream in (m_observersFile.chars());
+   if (!in.is_open())
+   {
+      xmsg<<"ossimViewshedUtil:"<<__LINE__<<" Could not open observers file <"<<m_observersFile
+            <<">."<<ends;
+      throw ossimException(xmsg.str());
+   }
+
+   // "<lat> <lon> [<height-of-eye>]" a line, comma or space separated, '#' for comments:
+   string line;
+   while (getline(in, line))
+   {
+      ossimString value (line);
+      value.trim();
+      if (value.empty() || (value[0] == '#'))
+         continue;
+
+      vector <ossimString> coordstr;
+      value.split(coordstr, ossimString(" ,\t"), true);
+      if (coordstr.size() < 2)
+      {
+         xmsg<<"ossimViewshedUtil:"<<__LINE__<<" Bad observer <"<<line<<"> in <"
+               <<m_observersFile<<">."<<ends;
+         throw ossimException(xmsg.str());
+      }
+
+      Observer obs;
+      obs.gpt = ossimGpt(coordstr[0].toDouble(), coordstr[1].toDouble(), 0.0);
+      obs.heightOfEye = (coordstr.size() > 2) ? coordstr[2].toDouble() : m_obsHgtAbvTer;
+      m_observers.push_back(obs);
+   }
+
+   if (m_observers.empty())
+   {
+      xmsg<<"ossimViewshedUtil:"<<__LINE__<<" No observers in <"<<m_observersFile<<">."<<ends;
+      throw ossimException(xmsg.str());
+   }
+
+   ossimNotify(ossimNotifyLevel_INFO) << "Read "<<m_observers.size()<<" observers from <"
+         <<m_observersFile<<">"<<endl;
+   return true;
+}
+
+ossimFilename ossimViewshedTool::getObserverFilename(ossim_uint32 index) const
+{
+   // <output>_<n>.<ext>, n from 1 and padded to the same width for all observers:
+   ostringstream suffix;
+   const ossim_uint32 DIGITS =
+         ossimString::toString(static_cast<ossim_uint32>(m_observers.size())).size();
+   suffix<<"_"<<setw(DIGITS)<<setfill('0')<<index+1;
+   ossimFilename filename (m_productFilename.noExtension());
+   filename += suffix.str();
+   filename.setExtension(m_productFilename.ext());
+   return filename;
+}
+
+void ossimViewshedTool::writeObserverBitmap(ossimImageData* bitmap, const ossimFilename& filename)
+{
+   ossimRefPtr<ossimMemoryImageSource> source = new ossimMemoryImageSource;
+   source->setImage(bitmap);
+   source->setImageGeometry(m_geom.get());
+
+   ossimRefPtr<ossimImageFileWriter> writer = newWriter();
+   writer->setFilename(filename);
+   writer->connectMyInputTo(0, source.get());
+   writer->setAreaOfInterest(m_aoiViewRect);
+   if (writer->getErrorStatus() != ossimErrorCodes::OSSIM_OK)
+      throw ossimException( "Unable to initialize writer for observer bitmap" );
+
+   writer->execute();
+   writer->disconnect();
+   ossimNotify(ossimNotifyLevel_INFO) << "Wrote observer bitmap to <"<<filename<<">"<<endl;
+}
+
 bool ossimViewshedTool::optimizeFOV()
 {
    bool intersects = false;
@@ -708,17 +1016,26 @@ void ossimViewshedTool::computeRadius()
       throw ossimException(xmsg.str());
    }
 
-   // Compute distance from observer to farthest corner of AOI. This is the radius
-   m_visRadius= m_observerGpt.distanceTo(m_aoiGroundRect.ul());
-   double d = m_observerGpt.distanceTo(m_aoiGroundRect.ur());
-   if (d > m_visRadius)
-      m_visRadius = d;
-   d = m_observerGpt.distanceTo(m_aoiGroundRect.lr());
-   if (d > m_visRadius)
-      m_visRadius = d;
-   d = m_observerGpt.distanceTo(m_aoiGroundRect.ll());
-   if (d > m_visRadius)
-      m_visRadius = d;
+   // Compute distance from observer to farthest corner of AOI. This is the radius. In batch mode,
+   // the farthest of any observer:
+   m_visRadius = 0;
+   ossim_uint32 numObservers = ossim::max<ossim_uint32>(m_observers.size(), 1);
+   for (ossim_uint32 i=0; i<numObservers; ++i)
+   {
+      const ossimGpt& obs = m_observers.empty() ? m_observerGpt : m_observers[i].gpt;
+      double d = obs.distanceTo(m_aoiGroundRect.ul());
+      if (d > m_visRadius)
+         m_visRadius = d;
+      d = obs.distanceTo(m_aoiGroundRect.ur());
+      if (d > m_visRadius)
+         m_visRadius = d;
+      d = obs.distanceTo(m_aoiGroundRect.lr());
+      if (d > m_visRadius)
+         m_visRadius = d;
+      d = obs.distanceTo(m_aoiGroundRect.ll());
+      if (d > m_visRadius)
+         m_visRadius = d;
+   }
 }
 
 void ossimViewshedTool::initRadials()
@@ -793,20 +1110,23 @@ void ossimViewshedTool::initRadials()
 
 void ossimViewshedTool::paintReticle()
 {
-   if (m_reticleSize == 0)
+   paintReticle(m_outBuffer.get(), m_observerVpt);
+}
+
+void ossimViewshedTool::paintReticle(ossimImageData* buffer, const ossimDpt& observerVpt)
+{
+   if ((m_reticleSize == 0) || !buffer)
       return;
 
    // Highlight the observer position with X reticle:
-   ossimDpt obsViewPt;
-   m_geom->worldToLocal(m_observerGpt, obsViewPt);
-   if (m_aoiViewRect.pointWithin(ossimIpt(obsViewPt)))
+   if (m_aoiViewRect.pointWithin(ossimIpt(observerVpt)))
    {
       for (int i=-m_reticleSize; i<=m_reticleSize; ++i)
       {
-         if (m_aoiViewRect.pointWithin(ossimIpt(m_observerVpt.x + i, m_observerVpt.y)))
-            m_outBuffer->setValue(m_observerVpt.x + i, m_observerVpt.y    , m_overlayValue);
-         if (m_aoiViewRect.pointWithin(ossimIpt(m_observerVpt.x, m_observerVpt.y + i)))
-            m_outBuffer->setValue(m_observerVpt.x    , m_observerVpt.y + i, m_overlayValue);
+         if (m_aoiViewRect.pointWithin(ossimIpt(observerVpt.x + i, observerVpt.y)))
+            buffer->setValue(observerVpt.x + i, observerVpt.y    , m_overlayValue);
+         if (m_aoiViewRect.pointWithin(ossimIpt(observerVpt.x, observerVpt.y + i)))
+            buffer->setValue(observerVpt.x    , observerVpt.y + i, m_overlayValue);
       }
    }
 
@@ -815,13 +1135,13 @@ void ossimViewshedTool::paintReticle()
    {
       for (int y=m_aoiViewRect.ul().y; y<=m_aoiViewRect.lr().y; y++)
       {
-         m_outBuffer->setValue(m_aoiViewRect.ul().x, y, m_overlayValue);
-         m_outBuffer->setValue(m_aoiViewRect.lr().x, y, m_overlayValue);
+         buffer->setValue(m_aoiViewRect.ul().x, y, m_overlayValue);
+         buffer->setValue(m_aoiViewRect.lr().x, y, m_overlayValue);
       }
       for (int x=m_aoiViewRect.ul().x; x<=m_aoiViewRect.lr().x; x++)
       {
-         m_outBuffer->setValue(x, m_aoiViewRect.ul().y, m_overlayValue);
-         m_outBuffer->setValue(x, m_aoiViewRect.lr().y, m_overlayValue);
+         buffer->setValue(x, m_aoiViewRect.ul().y, m_overlayValue);
+         buffer->setValue(x, m_aoiViewRect.lr().y, m_overlayValue);
       }
    }
 }
@@ -0,0 +1,105 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test application for multivariate ossimKMeansClustering.
+// Draws samples around known 4 band centers, clusters them with full Lloyd
+// passes and with mini-batches, and checks every center is found and every
+// sample is classified to the cluster of its center. Prints the times.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimKMeansClustering.h>
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static const ossim_uint32 K = 5;
+static const ossim_uint32 BANDS = 4;
+
+static int check(const char* name, ossim_uint32 batchSize, const vector<double>& samples,
+                 const vector<ossim_uint32>& truth, const double centers[K][BANDS])
+{
+   const ossim_uint32 n = (ossim_uint32) truth.size();
+   ossimTimer* timer = ossimTimer::instance();
+   ossimRefPtr<ossimKMeansClustering> kmeans = new ossimKMeansClustering;
+   kmeans->setNumClusters(K);
+   kmeans->setSamples(&samples.front(), n, BANDS);
+   if (batchSize)
+   {
+      kmeans->setBatchSize(batchSize);
+      kmeans->setMaxIterations(100);
+   }
+
+   ossimTimer::Timer_t t0 = timer->tick();
+   bool ok = kmeans->computeKmeans();
+   double trainTime = timer->delta_s(t0, timer->tick());
+
+   // Each center must have a centroid within a fraction of the spread:
+   vector<ossim_uint32> match (K, K);
+   for (ossim_uint32 c = 0; ok && (c < K); ++c)
+   {
+      match[c] = kmeans->classify(centers[c]);
+      const double* centroid = kmeans->getCentroid(match[c]);
+      double d2 = 0.0;
+      for (ossim_uint32 b = 0; b < BANDS; ++b)
+         d2 += (centroid[b] - centers[c][b]) * (centroid[b] - centers[c][b]);
+      if (sqrt(d2) > 1.0)
+         ok = false;
+   }
+
+   vector<ossim_uint32> labels (n);
+   t0 = timer->tick();
+   kmeans->classify(&samples.front(), n, &labels.front());
+   double classifyTime = timer->delta_s(t0, timer->tick());
+
+   ossim_uint32 wrong = 0;
+   for (ossim_uint32 i = 0; i < n; ++i)
+      if (labels[i] != match[truth[i]])
+         ++wrong;
+
+   cout << "  " << name << "  train: " << trainTime << "s  classify: " << classifyTime
+        << "s  misclassified: " << wrong << " of " << n << endl;
+   return (ok && (wrong < n / 1000)) ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-kmeans-multivariate Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+   cout << setiosflags(ios::fixed) << setprecision(4);
+
+   ossim_uint32 n = (argc > 1) ? ossimString(argv[1]).toUInt32() : 500000;
+
+   // Well separated centers, unit spread:
+   const double centers[K][BANDS] = { {  20,  20,  20,  20 },
+                                      {  60,  20,  40,  10 },
+                                      {  20,  70,  30,  50 },
+                                      { 100, 100, 100, 100 },
+                                      {  60,  60,  80,  20 } };
+   mt19937 rng (7);
+   normal_distribution<double> noise (0.0, 2.0);
+   vector<double> samples ((size_t) n * BANDS);
+   vector<ossim_uint32> truth (n);
+   for (ossim_uint32 i = 0; i < n; ++i)
+   {
+      truth[i] = i % K;
+      for (ossim_uint32 b = 0; b < BANDS; ++b)
+         samples[(size_t) i * BANDS + b] = centers[truth[i]][b] + noise(rng);
+   }
+
+   int failures = 0;
+   failures += check("lloyd     ", 0, samples, truth, centers);
+   failures += check("mini-batch", 1000, samples, truth, centers);
+
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
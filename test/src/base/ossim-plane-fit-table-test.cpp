@@ -0,0 +1,99 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test of ossimPlaneFitTable. Fits planes to random rectangles
+// of a noisy, tilted grid with a few rejected cells and checks them, and the
+// RMS of their residuals, against ossimLeastSquaresPlane.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimLeastSquaresPlane.h>
+#include <ossim/base/ossimPlaneFitTable.h>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+static const ossim_uint32 W = 300;
+static const ossim_uint32 H = 200;
+
+int main(int /*argc*/, char* /*argv*/[])
+{
+   cout << "ossim-plane-fit-table Test:" << endl;
+
+   vector<double> z(W * H);
+   vector<ossim_uint8> reject(W * H, 0);
+   srand(W);
+   for (ossim_uint32 y = 0; y < H; ++y)
+   {
+      for (ossim_uint32 x = 0; x < W; ++x)
+      {
+         z[y * W + x] = 1500.0 + 0.3 * x - 0.7 * y + 5.0 * sin(x * 0.1) + (rand() % 100) * 0.01;
+         reject[y * W + x] = (rand() % 2000 == 0) ? 1 : 0;
+      }
+   }
+
+   ossimPlaneFitTable table;
+   table.build(&z.front(), &reject.front(), W, H);
+
+   int failures = 0;
+   int fits = 0;
+   for (int i = 0; i < 2000; ++i)
+   {
+      const ossim_uint32 PW = 2 + rand() % 30;
+      const ossim_uint32 PH = 2 + rand() % 30;
+      const ossim_uint32 PX = rand() % (W - PW + 1);
+      const ossim_uint32 PY = rand() % (H - PH + 1);
+
+      ossim_uint32 rejects = 0;
+      ossimLeastSquaresPlane plane;
+      for (ossim_uint32 y = PY; y < PY + PH; ++y)
+      {
+         for (ossim_uint32 x = PX; x < PX + PW; ++x)
+         {
+            rejects += reject[y * W + x];
+            plane.addSample(x, y, z[y * W + x]);
+         }
+      }
+
+      double a = 0.0;
+      double b = 0.0;
+      double rms = 0.0;
+      const bool FIT = table.fit(PX, PY, PW, PH, a, b, rms);
+      if ( (table.getFlagCount(PX, PY, PW, PH) != rejects) || (FIT == (rejects != 0)) )
+      {
+         ++failures;
+         continue;
+      }
+      if (!FIT)
+         continue;
+
+      ++fits;
+      plane.solveLS();
+      double pa, pb, pc;
+      plane.getLSParms(pa, pb, pc);
+      double rss = 0.0;
+      for (ossim_uint32 y = PY; y < PY + PH; ++y)
+      {
+         for (ossim_uint32 x = PX; x < PX + PW; ++x)
+         {
+            const double R = z[y * W + x] - (pa * x + pb * y + pc);
+            rss += R * R;
+         }
+      }
+      const double RMS = sqrt(rss / (PW * PH));
+      if ( (fabs(a - pa) > 1e-6) || (fabs(b - pb) > 1e-6) || (fabs(rms - RMS) > 1e-6) )
+      {
+         cout << "  " << PX << "," << PY << " " << PW << "x" << PH << ": a " << a << " / " << pa
+              << "  b " << b << " / " << pb << "  rms " << rms << " / " << RMS << endl;
+         ++failures;
+      }
+   }
+
+   cout << "  " << fits << " fits, " << failures << " wrong" << endl;
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
@@ -0,0 +1,148 @@
+//----------------------------------------------------------------------------
+//
+// License:  MIT
+//
+// See LICENSE.txt file in the top level directory for more details.
+//
+// Description:
+//
+// Checks that the buffer based keyword list and XML parsers give the same
+// result as the stream based parsers and times both over a set of support
+// files (.geom, .omd, .kwl, DIMAP/SICD .xml and so on).
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimKeywordlist.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/base/ossimXmlDocument.h>
+#include <ossim/init/ossimInit.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+static bool isXml(const ossimFilename& file)
+{
+   ossimString ext = file.ext().downcase();
+   return ( ext == "xml" ) || ( ext == "dim" );
+}
+
+static std::string toString(const ossimKeywordlist& kwl, bool status)
+{
+   ostringstream os;
+   os << status << "\n" << kwl;
+   return os.str();
+}
+
+static std::string toString(const ossimXmlDocument& doc, bool status)
+{
+   ostringstream os;
+   os << status << "\n" << doc.getErrorStatus() << "\n";
+   if ( doc.getRoot().valid() )
+   {
+      os << doc;
+   }
+   return os.str();
+}
+
+int main(int argc, char *argv[])
+{
+   ossimInit::instance()->initialize(argc, argv);
+
+   if (argc < 2)
+   {
+      cout << "usage: " << argv[0] << " <iterations> <support_file> [<support_file>...]\n"
+           << "   or: " << argv[0] << " <support_file> [<support_file>...]\n"
+           << "\nFiles with a .xml or .dim extension are parsed as XML, all others as"
+           << "\nkeyword lists.  Returns non-zero if any buffer parse differs from the"
+           << "\nstream parse.\n";
+      return 0;
+   }
+
+   int firstFile = 1;
+   ossim_uint32 iterations = 10;
+   ossimString arg1 = argv[1];
+   if ( !ossimFilename(arg1).exists() && ( arg1.toUInt32() > 0 ) )
+   {
+      iterations = arg1.toUInt32();
+      firstFile = 2;
+   }
+
+   ossimTimer* timer = ossimTimer::instance();
+   double totalStream = 0.0;
+   double totalBuffer = 0.0;
+   int mismatches = 0;
+
+   cout << setiosflags(ios::fixed) << setprecision(6);
+
+   for ( int i = firstFile; i < argc; ++i )
+   {
+      ossimFilename file = argv[i];
+      std::string streamResult;
+      std::string bufferResult;
+      double streamTime = 0.0;
+      double bufferTime = 0.0;
+
+      for ( ossim_uint32 n = 0; n < iterations; ++n )
+      {
+         ossimTimer::Timer_t t0 = timer->tick();
+         if ( isXml(file) )
+         {
+            ossimXmlDocument doc;
+            ifstream in( file.c_str(), ios::binary );
+            bool status = doc.read( in );
+            if ( n == 0 ) streamResult = toString( doc, status );
+         }
+         else
+         {
+            ossimKeywordlist kwl;
+            ifstream in( file.c_str(), ios::binary );
+            bool status = kwl.parseStream( in );
+            if ( n == 0 ) streamResult = toString( kwl, status );
+         }
+         ossimTimer::Timer_t t1 = timer->tick();
+         if ( isXml(file) )
+         {
+            ossimXmlDocument doc;
+            bool status = doc.openFile( file );
+            if ( n == 0 ) bufferResult = toString( doc, status );
+         }
+         else
+         {
+            ossimKeywordlist kwl;
+            bool status = kwl.addFile( file );
+            if ( n == 0 ) bufferResult = toString( kwl, status );
+         }
+         ossimTimer::Timer_t t2 = timer->tick();
+
+         streamTime += timer->delta_s( t0, t1 );
+         bufferTime += timer->delta_s( t1, t2 );
+      }
+
+      streamTime /= iterations;
+      bufferTime /= iterations;
+      totalStream += streamTime;
+      totalBuffer += bufferTime;
+
+      bool same = ( streamResult == bufferResult );
+      if ( !same )
+      {
+         ++mismatches;
+      }
+
+      cout << file
+           << "\nsize:   " << file.fileSize()
+           << "\nstream: " << streamTime
+           << "\nbuffer: " << bufferTime
+           << "\nresult: " << ( same ? "identical" : "DIFFERENT" ) << "\n\n";
+   }
+
+   cout << "total stream: " << totalStream
+        << "\ntotal buffer: " << totalBuffer
+        << "\nmismatches:   " << mismatches << endl;
+
+   return ( mismatches == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test application for ossimTileBufferPool. Checks the size
+// classes, that freed tile buffers are reused by the same and other
+// threads, that the byte caps hold and that no pooled bytes leak, then
+// prints the time of a tile churn with the pool on and off.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimTileBufferPool.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+static int checkClasses()
+{
+   int failures = 0;
+   const size_t min = ossimTileBufferPool::getMinimumPooledSize();
+   if (ossimTileBufferPool::getClassSize(100) != 100)
+      ++failures;
+   if (ossimTileBufferPool::getClassSize(min) != min)
+      ++failures;
+   if (ossimTileBufferPool::getClassSize(min + 1) != min + min / 4)
+      ++failures;
+   if (ossimTileBufferPool::getClassSize(256 * 256) != 256 * 256)
+      ++failures;
+   if (ossimTileBufferPool::getClassSize(256 * 256 * 3 + 7) != 256 * 256 * 7 / 2)
+      ++failures;
+
+   // Rounding up never adds more than a quarter:
+   for (size_t bytes = min; bytes < (size_t(1) << 24); bytes = bytes * 9 / 8 + 13)
+   {
+      size_t c = ossimTileBufferPool::getClassSize(bytes);
+      if ((c < bytes) || (c > bytes + bytes / 4))
+         ++failures;
+   }
+   cout << "  size classes: " << (failures ? "FAILED" : "ok") << endl;
+   return failures;
+}
+
+static int checkReuse(ossimTileBufferPool* pool)
+{
+   int failures = 0;
+
+   // Same thread, same class:
+   void* a = pool->allocate(256 * 256 * 2);
+   pool->deallocate(a, 256 * 256 * 2);
+   void* b = pool->allocate(256 * 256 * 2 - 100);
+   if (a != b)
+      ++failures;
+   pool->deallocate(b, 256 * 256 * 2 - 100);
+
+   // A tile's buffer goes back on destruction:
+   ossimTileBufferPool::Statistics before = pool->getStatistics();
+   for (int i = 0; i < 10; ++i)
+   {
+      ossimRefPtr<ossimImageData> tile = new ossimImageData(0, OSSIM_UINT16, 3, 256, 256);
+      tile->initialize();
+   }
+   ossimTileBufferPool::Statistics after = pool->getStatistics();
+   if (after.heapAllocations - before.heapAllocations > 1)
+      ++failures;
+
+   // Buffers of an exited thread are picked up by others:
+   vector<void*> buffers;
+   thread worker ([&buffers, pool]()
+   {
+      for (int i = 0; i < 4; ++i)
+         buffers.push_back(pool->allocate(1 << 20));
+      for (int i = 0; i < 4; ++i)
+         pool->deallocate(buffers[i], 1 << 20);
+   });
+   worker.join();
+   before = pool->getStatistics();
+   void* c = pool->allocate(1 << 20);
+   after = pool->getStatistics();
+   if (after.globalHits != before.globalHits + 1)
+      ++failures;
+   pool->deallocate(c, 1 << 20);
+
+   cout << "  reuse: " << (failures ? "FAILED" : "ok") << endl;
+   return failures;
+}
+
+static int checkCaps(ossimTileBufferPool* pool)
+{
+   int failures = 0;
+   pool->trim();
+   pool->setThreadCacheBytes(1 << 20);
+   pool->setMaxBytes(4 << 20);
+
+   vector<void*> buffers;
+   for (int i = 0; i < 32; ++i)
+      buffers.push_back(pool->allocate(1 << 20));
+   for (int i = 0; i < 32; ++i)
+      pool->deallocate(buffers[i], 1 << 20);
+   if (pool->getStatistics().bytesCached > (4 << 20))
+      ++failures;
+
+   pool->setMaxBytes(1 << 20);
+   if (pool->getStatistics().bytesCached > (1 << 20))
+      ++failures;
+
+   pool->setMaxBytes(256 << 20);
+   pool->setThreadCacheBytes(32 << 20);
+   cout << "  caps: " << (failures ? "FAILED" : "ok") << endl;
+   return failures;
+}
+
+// Tiles of a few shapes made and dropped by several threads, like a chain under load:
+static double churn(ossim_uint32 numThreads, ossim_uint32 count)
+{
+   ossimTimer* timer = ossimTimer::instance();
+   ossimTimer::Timer_t t0 = timer->tick();
+   vector<thread> threads;
+   for (ossim_uint32 t = 0; t < numThreads; ++t)
+   {
+      threads.push_back(thread([count]()
+      {
+         const ossimScalarType types[] = { OSSIM_UINT8, OSSIM_UINT16, OSSIM_FLOAT32 };
+         for (ossim_uint32 i = 0; i < count; ++i)
+         {
+            ossimRefPtr<ossimImageData> tile =
+               new ossimImageData(0, types[i % 3], 1 + i % 4, 256, 256);
+            tile->initialize();
+            tile->makeBlank();
+         }
+      }));
+   }
+   for (size_t t = 0; t < threads.size(); ++t)
+      threads[t].join();
+   return timer->delta_s(t0, timer->tick());
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-tile-buffer-pool Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+   cout << setiosflags(ios::fixed) << setprecision(4);
+
+   ossimTileBufferPool* pool = ossimTileBufferPool::instance();
+   pool->setEnabled(true);
+   const ossim_uint64 inUse = pool->getStatistics().bytesInUse;
+
+   int failures = checkClasses();
+   failures += checkReuse(pool);
+   failures += checkCaps(pool);
+
+   double pooled = churn(4, 2000);
+   if (pool->getStatistics().bytesInUse != inUse)
+   {
+      cout << "  leaked pooled bytes: " << pool->getStatistics().bytesInUse - inUse << endl;
+      ++failures;
+   }
+   pool->print(cout);
+
+   pool->setEnabled(false);
+   double heap = churn(4, 2000);
+   pool->setEnabled(true);
+   cout << "  tile churn  pooled: " << pooled << "s  heap: " << heap << "s" << endl;
+
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
@@ -0,0 +1,113 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test of ossimImageData band views. Checks that viewed bands
+// share the source's pixels, that a tile viewing all bands of one tile in
+// order hands out the source's buffer, that resolving copies other views in,
+// that reading the buffer leaves the views alone, and that copies, loads,
+// fills and blanks behave as they do for tiles that own their pixels.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/base/ossimRefPtr.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/init/ossimInit.h>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+static const ossim_uint32 W = 64;
+static const ossim_uint32 H = 32;
+static int failures = 0;
+
+static void report(const char* name, bool ok)
+{
+   if (!ok)
+   {
+      ++failures;
+   }
+   cout << "  " << name << ": " << (ok ? "ok" : "WRONG") << endl;
+}
+
+static ossimRefPtr<ossimImageData> makeTile(ossim_uint32 bands, ossim_uint16 base)
+{
+   ossimRefPtr<ossimImageData> tile = new ossimImageData(0, OSSIM_UINT16, bands, W, H);
+   tile->initialize();
+   for (ossim_uint32 band = 0; band < bands; ++band)
+   {
+      ossim_uint16* p = tile->getUshortBuf(band);
+      for (ossim_uint32 i = 0; i < W * H; ++i)
+      {
+         p[i] = static_cast<ossim_uint16>(base + band * 1000 + i % 100 + 1);
+      }
+   }
+   tile->validate();
+   return tile;
+}
+
+static bool sameBand(const ossimImageData* a, ossim_uint32 aBand,
+                     const ossimImageData* b, ossim_uint32 bBand)
+{
+   return memcmp(a->getBuf(aBand), b->getBuf(bBand), a->getSizePerBandInBytes()) == 0;
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-band-view Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+
+   ossimRefPtr<ossimImageData> a = makeTile(3, 0);
+   ossimRefPtr<ossimImageData> b = makeTile(2, 10000);
+
+   // Bands 1 and 2 of a, in order, need no copy for getBuf():
+   ossimRefPtr<ossimImageData> sel = new ossimImageData(0, OSSIM_UINT16, 2, W, H);
+   sel->initialize();
+   report("set", sel->setBandView(0, a.get(), 1) && sel->setBandView(1, a.get(), 2));
+   report("shared band", sel->getBuf(1) == a->getBuf(2));
+   sel->resolveBandViews();
+   report("contiguous", (sel->getBuf() == a->getBuf(1)) && sel->hasBandViews());
+
+   // A band of each tile, copied in when resolved:
+   ossimRefPtr<ossimImageData> merged = new ossimImageData(0, OSSIM_UINT16, 2, W, H);
+   merged->initialize();
+   merged->setBandView(0, b.get(), 1);
+   merged->setBandView(1, a.get(), 0);
+   report("mismatch", !merged->setBandView(0, makeTile(1, 0).get(), 5));
+   ossimRefPtr<ossimImageData> copy = static_cast<ossimImageData*>(merged->dup());
+   report("deep copy", !copy->hasBandViews() && sameBand(copy.get(), 0, b.get(), 1) &&
+          sameBand(copy.get(), 1, a.get(), 0));
+
+   ossimRefPtr<ossimImageData> loaded = new ossimImageData(0, OSSIM_UINT16, 2, W, H);
+   loaded->initialize();
+   loaded->loadTile(merged.get());
+   report("load", merged->hasBandViews() && sameBand(loaded.get(), 0, b.get(), 1) &&
+          sameBand(loaded.get(), 1, a.get(), 0));
+
+   const ossimImageData* reader = merged.get();
+   report("read", (reader->getBuf() != b->getBuf(1)) && (reader->getBuf(0) == b->getBuf(1)) &&
+          merged->hasBandViews());
+
+   merged->resolveBandViews();
+   const ossim_uint16* whole = static_cast<const ossim_uint16*>(reader->getBuf());
+   report("copied in", !merged->hasBandViews() &&
+          (memcmp(whole, b->getBuf(1), merged->getSizePerBandInBytes()) == 0) &&
+          (memcmp(whole + W * H, a->getBuf(0), merged->getSizePerBandInBytes()) == 0));
+
+   // Filling or blanking a viewed band leaves the source alone:
+   sel->fill(0, 7);
+   report("fill", (sel->getUshortBuf(0)[0] == 7) && (a->getUshortBuf(1)[0] == 1001) &&
+          (sel->getBuf(1) == a->getBuf(2)));
+   sel->makeBlank();
+   report("blank", !sel->hasBandViews() && (a->getUshortBuf(2)[0] == 2001));
+
+   // The view keeps its source alive:
+   ossimRefPtr<ossimImageData> held = new ossimImageData(0, OSSIM_UINT16, 1, W, H);
+   held->initialize();
+   held->setBandView(0, makeTile(1, 500).get(), 0);
+   report("held", held->getUshortBuf(0)[W * H - 1] == 500 + (W * H - 1) % 100 + 1);
+
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
@@ -0,0 +1,126 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test and benchmark for the ossimDiscreteConvolutionKernel
+// engine. For square kernels from 3x3 to 31x31, separable (Gaussian) and not
+// (random), checks convolveBuffer() and convolveFull() against the per pixel
+// convolveSubImage() and prints the time of each.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimDiscreteConvolutionKernel.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-convolution Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+
+   long size = (argc > 1) ? ossimString(argv[1]).toInt32() : 512;
+
+   ossimTimer* timer = ossimTimer::instance();
+   int failures = 0;
+   srand(1);
+   cout << setiosflags(ios::fixed) << setprecision(4);
+
+   for (long k = 3; k <= 31; k += 4)
+   {
+      long srcSize = size + k - 1;
+      vector<float> src (srcSize * srcSize);
+      for (size_t i = 0; i < src.size(); ++i)
+         src[i] = (float) (rand() % 256);
+
+      ossimRefPtr<ossimImageData> input =
+         new ossimImageData(0, OSSIM_UINT8, 1, srcSize, srcSize);
+      input->initialize();
+      input->setOrigin(ossimIpt(0, 0));
+      for (size_t i = 0; i < src.size(); ++i)
+         ((ossim_uint8*) input->getBuf(0))[i] = (ossim_uint8) src[i];
+      input->validate();
+      ossimRefPtr<ossimImageData> output =
+         new ossimImageData(0, OSSIM_UINT8, 1, size, size);
+      output->initialize();
+      output->setOrigin(ossimIpt(k / 2, k / 2));
+
+      for (int separable = 1; separable >= 0; --separable)
+      {
+         NEWMAT::Matrix m (k, k);
+         double sigma = k / 5.0;
+         for (long r = 0; r < k; ++r)
+         {
+            for (long c = 0; c < k; ++c)
+            {
+               if (separable)
+               {
+                  double y = r - k / 2;
+                  double x = c - k / 2;
+                  m[r][c] = exp(-(x * x + y * y) / (2.0 * sigma * sigma));
+               }
+               else
+                  m[r][c] = (double) rand() / RAND_MAX;
+            }
+         }
+         ossimDiscreteConvolutionKernel kernel (m, true);
+         if (kernel.isSeparable() != (separable != 0))
+         {
+            cout << "  " << k << "x" << k << ": separable detection FAILED" << endl;
+            ++failures;
+         }
+
+         // Per pixel reference:
+         vector<double> reference (size * size);
+         ossimTimer::Timer_t t0 = timer->tick();
+         for (long y = 0; y < size; ++y)
+            for (long x = 0; x < size; ++x)
+               kernel.convolveSubImage(&src[y * srcSize + x], srcSize,
+                                       reference[y * size + x], -1.0f);
+         double pixelTime = timer->delta_s(t0, timer->tick());
+
+         vector<float> dst (size * size);
+         t0 = timer->tick();
+         kernel.convolveBuffer(&src.front(), srcSize, &dst.front(), size, size);
+         double engineTime = timer->delta_s(t0, timer->tick());
+
+         double maxError = 0.0;
+         for (size_t i = 0; i < dst.size(); ++i)
+            maxError = max(maxError, fabs(dst[i] - reference[i]));
+
+         // Tile level, integer output may differ by one from float rounding:
+         double minPix = 1.0;
+         double maxPix = 255.0;
+         long tileMismatches = 0;
+         if (!kernel.convolveFull(input.get(), output.get(), &minPix, &maxPix))
+            tileMismatches = size * size;
+         const ossim_uint8* out = (const ossim_uint8*) output->getBuf(0);
+         for (long i = 0; i < size * size; ++i)
+         {
+            double expected = reference[i] < minPix ? minPix : reference[i];
+            expected = expected > maxPix ? maxPix : expected;
+            if (fabs(out[i] - floor(expected)) > 1.0)
+               ++tileMismatches;
+         }
+
+         cout << "  " << setw(2) << k << "x" << setw(2) << k
+              << (separable ? " separable " : " 2-D       ")
+              << " per pixel: " << pixelTime << "s  engine: " << engineTime
+              << "s  max error: " << maxError << "  tile mismatches: " << tileMismatches << endl;
+
+         if ((maxError > 1.0e-3) || tileMismatches)
+            ++failures;
+      }
+   }
+
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
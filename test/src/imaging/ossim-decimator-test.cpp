@@ -0,0 +1,219 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test and benchmark of ossimDecimator. Halves tiles of the
+// common scalar types with each reducer, plain and with the best instruction
+// set of the cpu. Checks the outputs are the same bits, checks the box and
+// mode reducers against a direct computation and constant data against its
+// constant, and prints the throughput of each.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimDecimator.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+static const ossim_int32 SIZE   = 1024;
+static const int         REPEAT = 10;
+
+static int failures = 0;
+
+// Random values with a null block in a corner, null streaks and odd nulls:
+static ossimRefPtr<ossimImageData> makeInput(ossimScalarType scalar, bool constant)
+{
+   ossimRefPtr<ossimImageData> tile = new ossimImageData(0, scalar, 1, SIZE, SIZE);
+   tile->initialize();
+   const double MIN_PIX  = tile->getMinPix(0);
+   const double MAX_PIX  = std::min(tile->getMaxPix(0), 60000.0);
+   const double NULL_PIX = tile->getNullPix(0);
+   srand(SIZE);
+   for (ossim_int32 y = 0; y < SIZE; ++y)
+   {
+      for (ossim_int32 x = 0; x < SIZE; ++x)
+      {
+         double v = constant ? 100.0 :
+            std::floor(MIN_PIX + (MAX_PIX - MIN_PIX) * (rand() / (double)RAND_MAX));
+         if ( ((x < 301) && (y < 257)) || (x % 97 == 5) || (rand() % 13 == 0) )
+         {
+            v = NULL_PIX;
+         }
+         tile->setValue(x, y, v);
+      }
+   }
+   tile->validate();
+   return tile;
+}
+
+static ossimRefPtr<ossimImageData> makeOutput(const ossimImageData* input, ossim_uint32 factor)
+{
+   ossimRefPtr<ossimImageData> tile =
+      new ossimImageData(0, input->getScalarType(), 1, SIZE / factor, SIZE / factor);
+   tile->initialize();
+   return tile;
+}
+
+static double run(const ossimImageData* input, ossimImageData* output,
+                  ossimDecimator::Method method, ossimImageDataKernels::Isa isa)
+{
+   ossimImageDataKernels::setIsa(isa);
+   ossimTimer* timer = ossimTimer::instance();
+   ossimTimer::Timer_t t0 = timer->tick();
+   for (int i = 0; i < REPEAT; ++i)
+   {
+      ossimDecimator::decimate(input, output, method);
+   }
+   return timer->delta_s(t0, timer->tick());
+}
+
+// Box and mode of one output pixel worked out directly:
+static bool reference(const ossimImageData* input, ossimDecimator::Method method,
+                      ossim_int32 x, ossim_int32 y, double& value)
+{
+   double v[4];
+   int n = 0;
+   for (ossim_int32 j = 0; j < 2; ++j)
+   {
+      for (ossim_int32 i = 0; i < 2; ++i)
+      {
+         if (!input->isNull(ossimIpt(2 * x + i, 2 * y + j)))
+         {
+            v[n++] = input->getPix(ossimIpt(2 * x + i, 2 * y + j));
+         }
+      }
+   }
+   if (!n)
+   {
+      return false;
+   }
+   if (method == ossimDecimator::BOX)
+   {
+      value = (v[0] + (n > 1 ? v[1] : 0) + (n > 2 ? v[2] : 0) + (n > 3 ? v[3] : 0)) / n;
+      if (input->getScalarType() != OSSIM_FLOAT32 && input->getScalarType() != OSSIM_FLOAT64)
+      {
+         value = std::floor(value + 0.5);
+      }
+   }
+   else
+   {
+      int best = 0;
+      for (int i = 0; i < n; ++i)
+      {
+         int count = 0;
+         for (int j = 0; j < n; ++j)
+         {
+            count += (v[j] == v[i]);
+         }
+         if (count > best)
+         {
+            best  = count;
+            value = v[i];
+         }
+      }
+   }
+   return true;
+}
+
+static void check(const char* name, ossimScalarType scalar)
+{
+   ossimRefPtr<ossimImageData> input = makeInput(scalar, false);
+   const ossimImageDataKernels::Isa BEST = ossimImageDataKernels::getBestIsa();
+   const double MPIX = double(SIZE) * SIZE * REPEAT / 1.0e6;
+
+   for (int m = ossimDecimator::NEAREST; m <= ossimDecimator::MODE; ++m)
+   {
+      const ossimDecimator::Method METHOD = static_cast<ossimDecimator::Method>(m);
+      ossimRefPtr<ossimImageData> plain = makeOutput(input.get(), 2);
+      ossimRefPtr<ossimImageData> fast  = makeOutput(input.get(), 2);
+      const double PLAIN_TIME = run(input.get(), plain.get(), METHOD,
+                                    ossimImageDataKernels::ISA_SCALAR);
+      const double FAST_TIME  = run(input.get(), fast.get(), METHOD, BEST);
+      bool ok = !memcmp(plain->getBuf(), fast->getBuf(), plain->getSizeInBytes());
+
+      // Against the direct computation, nulls only where the whole block is null:
+      ossim_uint32 wrong = 0;
+      for (ossim_int32 y = 0; y < SIZE / 2; ++y)
+      {
+         for (ossim_int32 x = 0; x < SIZE / 2; ++x)
+         {
+            double expected = 0.0;
+            const bool VALID = reference(input.get(), METHOD, x, y, expected);
+            const bool IS_NULL = fast->isNull(ossimIpt(x, y));
+            if ( (METHOD == ossimDecimator::BOX) || (METHOD == ossimDecimator::MODE) )
+            {
+               const double GOT = fast->getPix(ossimIpt(x, y));
+               const double TOLERANCE = std::fabs(expected) * 1.0e-6;
+               if ( (VALID == IS_NULL) || (VALID && (std::fabs(GOT - expected) > TOLERANCE)) )
+               {
+                  ++wrong;
+               }
+            }
+            else if ( (METHOD == ossimDecimator::NEAREST) &&
+                      (IS_NULL != input->isNull(ossimIpt(2 * x, 2 * y))) )
+            {
+               ++wrong;
+            }
+         }
+      }
+      ok = ok && (wrong == 0);
+
+      if (!ok)
+      {
+         ++failures;
+      }
+      cout << "  " << setw(8) << left << ossimDecimator::getMethodName(METHOD) << name
+           << "  plain: " << setw(7) << right << MPIX / PLAIN_TIME << " Mpix/s  "
+           << ossimImageDataKernels::getIsaName(BEST) << ": " << setw(7) << MPIX / FAST_TIME
+           << " Mpix/s  " << (ok ? "ok" : "FAILED") << endl;
+   }
+
+   // Constant data stays constant, to float rounding, through every reducer
+   // and a reduction by 4:
+   ossimRefPtr<ossimImageData> flat = makeInput(scalar, true);
+   for (int m = ossimDecimator::NEAREST; m <= ossimDecimator::MODE; ++m)
+   {
+      ossimRefPtr<ossimImageData> output = makeOutput(flat.get(), 4);
+      ossimDecimator::decimate(flat.get(), output.get(), static_cast<ossimDecimator::Method>(m), 4);
+      bool ok = true;
+      for (ossim_uint32 i = 0; i < output->getSizePerBand(); ++i)
+      {
+         if ( !output->isNull(i) && (std::fabs(output->getPix(i) - 100.0) > 1.0e-4) )
+         {
+            ok = false;
+         }
+      }
+      if (!ok)
+      {
+         ++failures;
+         cout << "  " << ossimDecimator::getMethodName(static_cast<ossimDecimator::Method>(m))
+              << " " << name << " by 4 of constant data: FAILED" << endl;
+      }
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-decimator Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+   cout << setiosflags(ios::fixed) << setprecision(1);
+
+   check("uint8  ", OSSIM_UINT8);
+   check("uint16 ", OSSIM_UINT16);
+   check("sint16 ", OSSIM_SINT16);
+   check("float32", OSSIM_FLOAT32);
+   check("float64", OSSIM_FLOAT64);
+
+   ossimImageDataKernels::setIsa(ossimImageDataKernels::getBestIsa());
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
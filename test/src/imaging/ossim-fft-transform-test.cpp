@@ -0,0 +1,154 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test application for ossimFft. Checks 1-D transforms of
+// mixed radix and prime lengths against a direct DFT, 2-D real transforms
+// against NEWMAT::FFT2, and float and double round trips, and prints the
+// times of ossimFft and NEWMAT.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimFft.h>
+#include <ossim/matrix/newmat.h>
+#include <ossim/matrix/newmatap.h>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+static double maxDiff(const complex<double>& a, const complex<double>& b)
+{
+   return max(fabs(a.real() - b.real()), fabs(a.imag() - b.imag()));
+}
+
+// 1-D against the direct sum:
+static int checkLengths()
+{
+   const ossim_uint32 lengths[] = { 1, 2, 3, 5, 7, 8, 12, 17, 30, 64, 97, 100, 210, 256 };
+   ossimFft fft (1);
+   int failures = 0;
+   for (size_t li = 0; li < sizeof(lengths) / sizeof(lengths[0]); ++li)
+   {
+      const ossim_uint32 n = lengths[li];
+      vector< complex<double> > x (n);
+      for (ossim_uint32 i = 0; i < n; ++i)
+         x[i] = complex<double>(rand() % 100 - 50, rand() % 100 - 50);
+
+      vector< complex<double> > y (x);
+      fft.transform(&y.front(), n, false);
+
+      double error = 0.0;
+      for (ossim_uint32 k = 0; k < n; ++k)
+      {
+         complex<double> sum (0.0, 0.0);
+         for (ossim_uint32 i = 0; i < n; ++i)
+            sum += x[i] * polar(1.0, -2.0 * M_PI * ((double) k * i / n));
+         error = max(error, maxDiff(sum, y[k]));
+      }
+
+      // Inverse is not scaled:
+      fft.transform(&y.front(), n, true);
+      for (ossim_uint32 i = 0; i < n; ++i)
+         error = max(error, maxDiff(y[i] / (double) n, x[i]));
+
+      if (error > 1.0e-6 * n)
+      {
+         cout << "  length " << n << " FAILED, error: " << error << endl;
+         ++failures;
+      }
+   }
+   cout << "  1-D lengths: " << (failures ? "FAILED" : "ok") << endl;
+   return failures;
+}
+
+// 2-D real transforms against NEWMAT, same layout as ossimFftFilter:
+static int checkImage(ossim_uint32 w, ossim_uint32 h)
+{
+   int failures = 0;
+   ossimTimer* timer = ossimTimer::instance();
+   vector<double> image (w * h);
+   for (size_t i = 0; i < image.size(); ++i)
+      image[i] = (double) rand() / RAND_MAX;
+
+   NEWMAT::Matrix realIn (h, w), imgIn (h, w), realOut (h, w), imgOut (h, w);
+   for (ossim_uint32 y = 0; y < h; ++y)
+      for (ossim_uint32 x = 0; x < w; ++x)
+      {
+         realIn[y][x] = image[y * w + x];
+         imgIn[y][x] = 0.0;
+      }
+   ossimTimer::Timer_t t0 = timer->tick();
+   NEWMAT::FFT2(realIn, imgIn, realOut, imgOut);
+   double newmatTime = timer->delta_s(t0, timer->tick());
+
+   const ossim_uint32 cw = w / 2 + 1;
+   ossimFft fft;
+   vector< complex<double> > spectrum (cw * h);
+   t0 = timer->tick();
+   fft.forward2d(&image.front(), w, h, &spectrum.front());
+   double fftTime = timer->delta_s(t0, timer->tick());
+
+   double error = 0.0;
+   for (ossim_uint32 y = 0; y < h; ++y)
+      for (ossim_uint32 x = 0; x < cw; ++x)
+         error = max(error, maxDiff(spectrum[y * cw + x],
+                                    complex<double>(realOut[y][x], imgOut[y][x])));
+
+   vector<double> back (w * h);
+   fft.inverse2d(&spectrum.front(), w, h, &back.front());
+   double roundTrip = 0.0;
+   for (size_t i = 0; i < back.size(); ++i)
+      roundTrip = max(roundTrip, fabs(back[i] - image[i]));
+
+   // Float:
+   vector<float> imageF (image.begin(), image.end());
+   vector< complex<float> > spectrumF (cw * h);
+   vector<float> backF (w * h);
+   t0 = timer->tick();
+   fft.forward2d(&imageF.front(), w, h, &spectrumF.front());
+   double floatTime = timer->delta_s(t0, timer->tick());
+   fft.inverse2d(&spectrumF.front(), w, h, &backF.front());
+   double roundTripF = 0.0;
+   for (size_t i = 0; i < backF.size(); ++i)
+      roundTripF = max(roundTripF, (double) fabs(backF[i] - imageF[i]));
+
+   // Complex 2-D against the real one:
+   vector< complex<double> > full (image.begin(), image.end());
+   fft.transform2d(&full.front(), w, h, false);
+   for (ossim_uint32 y = 0; y < h; ++y)
+      for (ossim_uint32 x = 0; x < cw; ++x)
+         error = max(error, maxDiff(spectrum[y * cw + x], full[y * w + x]));
+
+   cout << "  " << setw(4) << w << "x" << setw(4) << h << "  newmat: " << newmatTime
+        << "s  double: " << fftTime << "s  float: " << floatTime << "s  error: "
+        << scientific << error << "  round trip: " << roundTrip << " / " << roundTripF
+        << fixed << endl;
+
+   if ((error > 1.0e-8 * w * h) || (roundTrip > 1.0e-10) || (roundTripF > 1.0e-4))
+      ++failures;
+   return failures;
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-fft-transform Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+   srand(1);
+   cout << setiosflags(ios::fixed) << setprecision(4);
+
+   int failures = checkLengths();
+   failures += checkImage(256, 256);
+   failures += checkImage(200, 120);
+   failures += checkImage(97, 64);
+   failures += checkImage(512, 512);
+
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
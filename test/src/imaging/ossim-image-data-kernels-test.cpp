@@ -0,0 +1,253 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test and benchmark of ossimImageDataKernels. Runs every kernel
+// for the common scalar types with the plain loops and with the best
+// instruction set of the cpu, checks the outputs are the same bits and
+// prints the time of both.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+// A 256 x 256 tile and a few odd pixels so the tails run too:
+static const ossim_uint32 COUNT  = 256 * 256 + 7;
+static const int          REPEAT = 50;
+
+static ossimImageDataKernels::Isa best;
+static int failures = 0;
+
+template <class T> static const char* typeName();
+template <> const char* typeName<ossim_uint8>()   { return "uint8  "; }
+template <> const char* typeName<ossim_uint16>()  { return "uint16 "; }
+template <> const char* typeName<ossim_sint16>()  { return "sint16 "; }
+template <> const char* typeName<ossim_float32>() { return "float32"; }
+template <> const char* typeName<ossim_float64>() { return "float64"; }
+
+// Values over min to max, every 11th a null:
+template <class T>
+static vector<T> makeData(ossim_uint32 count, T nullPix, double minPix, double maxPix)
+{
+   vector<T> data(count);
+   srand(count);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      double v = minPix + (maxPix - minPix) * (rand() / (double)RAND_MAX);
+      data[i] = (i % 11 == 3) ? nullPix : static_cast<T>(v);
+   }
+   data[5] = static_cast<T>(minPix);
+   return data;
+}
+
+// Normalized values with zeros and values past 1 for the clamp:
+template <class F>
+static vector<F> makeNormalized(ossim_uint32 count)
+{
+   vector<F> data(count);
+   srand(count + 1);
+   for (ossim_uint32 i = 0; i < count; ++i)
+   {
+      data[i] = (i % 13 == 2) ? F(0) : static_cast<F>(1.05 * rand() / (double)RAND_MAX);
+   }
+   return data;
+}
+
+template <class T>
+static bool same(const vector<T>& a, const vector<T>& b)
+{
+   return (a.size() == b.size()) && !memcmp(&a.front(), &b.front(), a.size() * sizeof(T));
+}
+
+static void report(const char* kernel, const char* type, bool ok, double plain, double fast)
+{
+   if (!ok)
+   {
+      ++failures;
+   }
+   cout << "  " << setw(14) << left << kernel << type << "  plain: " << plain
+        << "s  " << ossimImageDataKernels::getIsaName(best) << ": " << fast << "s  "
+        << (ok ? "ok" : "FAILED") << endl;
+}
+
+// Times REPEAT calls of f, with the plain loops when plain is set:
+template <class Func>
+static double timeIt(bool plain, Func f)
+{
+   ossimImageDataKernels::setIsa(plain ? ossimImageDataKernels::ISA_SCALAR : best);
+   ossimTimer* timer = ossimTimer::instance();
+   ossimTimer::Timer_t t0 = timer->tick();
+   for (int i = 0; i < REPEAT; ++i)
+   {
+      f();
+   }
+   return timer->delta_s(t0, timer->tick());
+}
+
+template <class T, class F>
+static void checkNormalize(const char* kernel, const vector<T>& data, double nullPix,
+                           double minPix, double maxPix)
+{
+   vector<F> a(COUNT);
+   vector<F> b(COUNT);
+   double plain = timeIt(true, [&]()
+   {
+      ossimImageDataKernels::normalize(&data.front(), &a.front(), COUNT,
+                                       nullPix, minPix, maxPix);
+   });
+   double fast = timeIt(false, [&]()
+   {
+      ossimImageDataKernels::normalize(&data.front(), &b.front(), COUNT,
+                                       nullPix, minPix, maxPix);
+   });
+   report(kernel, typeName<T>(), same(a, b), plain, fast);
+}
+
+template <class T, class F>
+static void checkUnnormalize(const char* kernel, double nullPix, double minPix, double maxPix)
+{
+   vector<F> data = makeNormalized<F>(COUNT);
+   vector<T> a(COUNT);
+   vector<T> b(COUNT);
+   bool ok = true;
+   double plain = 0.0;
+   double fast  = 0.0;
+   for (int clamp = 0; clamp < 2; ++clamp)
+   {
+      plain += timeIt(true, [&]()
+      {
+         ossimImageDataKernels::unnormalize(&data.front(), &a.front(), COUNT,
+                                            nullPix, minPix, maxPix, clamp != 0);
+      });
+      fast += timeIt(false, [&]()
+      {
+         ossimImageDataKernels::unnormalize(&data.front(), &b.front(), COUNT,
+                                            nullPix, minPix, maxPix, clamp != 0);
+      });
+      ok = ok && same(a, b);
+   }
+   report(kernel, typeName<T>(), ok, plain / 2, fast / 2);
+}
+
+template <class T>
+static void checkType(double minPix, double maxPix)
+{
+   const T NP = static_cast<T>(ossim::isnan(minPix) ? 0 : minPix - 1);
+   vector<T> data = makeData<T>(COUNT, NP, minPix, maxPix);
+
+   checkNormalize<T, ossim_float32>("normalize f32", data, NP, minPix, maxPix);
+   checkNormalize<T, ossim_float64>("normalize f64", data, NP, minPix, maxPix);
+   checkUnnormalize<T, ossim_float32>("unnormal. f32", NP, minPix, maxPix);
+   checkUnnormalize<T, ossim_float64>("unnormal. f64", NP, minPix, maxPix);
+
+   // Nulls counted, all null and no null:
+   {
+      ossim_uint32 a = 0;
+      ossim_uint32 b = 0;
+      double plain = timeIt(true, [&]()
+      {
+         a = ossimImageDataKernels::countNonNull(&data.front(), COUNT, NP);
+      });
+      double fast = timeIt(false, [&]()
+      {
+         b = ossimImageDataKernels::countNonNull(&data.front(), COUNT, NP);
+      });
+      vector<T> nulls(COUNT, NP);
+      bool ok = (a == b) && (ossimImageDataKernels::countNonNull(&nulls.front(), COUNT, NP) == 0);
+      report("count non-null", typeName<T>(), ok, plain, fast);
+   }
+
+   // Min/max, also of an all null run which must leave them alone:
+   {
+      double minA = maxPix, maxA = minPix, minB = maxPix, maxB = minPix;
+      double plain = timeIt(true, [&]()
+      {
+         ossimImageDataKernels::minMax(&data.front(), COUNT, NP, minA, maxA);
+      });
+      double fast = timeIt(false, [&]()
+      {
+         ossimImageDataKernels::minMax(&data.front(), COUNT, NP, minB, maxB);
+      });
+      vector<T> nulls(COUNT, NP);
+      double minC = 12.0, maxC = 11.0;
+      ossimImageDataKernels::minMax(&nulls.front(), COUNT, NP, minC, maxC);
+      bool ok = (minA == minB) && (maxA == maxB) && (minC == 12.0) && (maxC == 11.0);
+      report("min/max", typeName<T>(), ok, plain, fast);
+   }
+
+   // Band interleave both ways, 1 to 5 bands:
+   for (ossim_uint32 bands = 1; bands <= 5; ++bands)
+   {
+      const ossim_uint32 PIXELS = COUNT / bands;
+      vector< vector<T> > a(bands, vector<T>(PIXELS));
+      vector< vector<T> > b(bands, vector<T>(PIXELS));
+      vector<T*> pa(bands);
+      vector<T*> pb(bands);
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         pa[band] = &a[band].front();
+         pb[band] = &b[band].front();
+      }
+      double plain = timeIt(true, [&]()
+      {
+         ossimImageDataKernels::deinterleave(&data.front(), &pa.front(), PIXELS, bands);
+      });
+      double fast = timeIt(false, [&]()
+      {
+         ossimImageDataKernels::deinterleave(&data.front(), &pb.front(), PIXELS, bands);
+      });
+      bool ok = true;
+      for (ossim_uint32 band = 0; band < bands; ++band)
+      {
+         ok = ok && same(a[band], b[band]);
+      }
+
+      vector<T> back(PIXELS * bands);
+      vector<const T*> cb(pb.begin(), pb.end());
+      double plain2 = timeIt(true, [&]()
+      {
+         ossimImageDataKernels::interleave(&cb.front(), &back.front(), PIXELS, bands);
+      });
+      double fast2 = timeIt(false, [&]()
+      {
+         ossimImageDataKernels::interleave(&cb.front(), &back.front(), PIXELS, bands);
+      });
+      ok = ok && !memcmp(&back.front(), &data.front(), back.size() * sizeof(T));
+
+      char name[32];
+      sprintf(name, "interleave %ub", bands);
+      report(name, typeName<T>(), ok, plain + plain2, fast + fast2);
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-image-data-kernels Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+   cout << setiosflags(ios::fixed) << setprecision(4);
+
+   best = ossimImageDataKernels::getBestIsa();
+   cout << "  best instruction set: " << ossimImageDataKernels::getIsaName(best) << endl;
+
+   checkType<ossim_uint8>(1.0, 255.0);
+   checkType<ossim_uint16>(1.0, 2047.0);
+   checkType<ossim_uint16>(1.0, 65535.0);
+   checkType<ossim_sint16>(-32767.0, 32767.0);
+   checkType<ossim_float32>(-500.0, 9000.0);
+   checkType<ossim_float64>(0.5, 1.0e6);
+
+   ossimImageDataKernels::setIsa(best);
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
@@ -0,0 +1,222 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test application for ossimMaskMorphology. Checks erosion,
+// dilation, opening and closing of random 8 bit and float tiles with null
+// blobs, with and without a valid image polygon, against scanning every
+// window, and prints the times.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimPolygon.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimMaskMorphology.h>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+static const char* OPERATION_NAMES[] = { "erosion ", "dilation", "opening ", "closing " };
+
+// Random values with null squares of random size so there are holes and specks of every scale:
+template <class T>
+static ossimRefPtr<ossimImageData> makeInput(ossimScalarType type, long size, long margin)
+{
+   long width = size + 2 * margin;
+   ossimRefPtr<ossimImageData> tile = new ossimImageData(0, type, 1, width, width);
+   tile->initialize();
+   tile->setOrigin(ossimIpt(-margin, -margin));
+   T* buf = (T*) tile->getBuf(0);
+   T np = (T) tile->getNullPix(0);
+   for (long i = 0; i < width * width; ++i)
+   {
+      buf[i] = (T) (rand() % 250 + 1);
+      if (buf[i] == np)
+         ++buf[i];
+   }
+   for (int blob = 0; blob < width / 2; ++blob)
+   {
+      long s = rand() % 12 + 1;
+      long x0 = rand() % width;
+      long y0 = rand() % width;
+      for (long y = y0; (y < y0 + s) && (y < width); ++y)
+         for (long x = x0; (x < x0 + s) && (x < width); ++x)
+            buf[y * width + x] = np;
+   }
+   tile->validate();
+   return tile;
+}
+
+// Scans every window:
+template <class T>
+static void reference(const ossimImageData* input, long size, long w,
+                      ossimMaskMorphology::Operation op, const ossimPolygon* poly,
+                      vector<T>& out)
+{
+   const T* in = (const T*) input->getBuf(0);
+   const T np = (T) input->getNullPix(0);
+   const long iw = input->getWidth();
+   const long margin = -input->getOrigin().x;
+   const long half = w / 2;
+
+   struct Mask
+   {
+      const T* in; T np; long iw; long margin;
+      bool valid(long x, long y) const
+      {
+         x += margin;
+         y += margin;
+         return (x >= 0) && (y >= 0) && (x < iw) && (y < iw) && (in[y * iw + x] != np);
+      }
+   } m = { in, np, iw, margin };
+
+   out.resize(size * size);
+   for (long y = 0; y < size; ++y)
+   {
+      for (long x = 0; x < size; ++x)
+      {
+         bool inside = !poly || poly->isPointWithin(ossimDpt(x, y));
+         bool valid = m.valid(x, y);
+         T center = valid ? in[(y + margin) * iw + x + margin] : np;
+
+         bool keep = true;
+         if (op == ossimMaskMorphology::EROSION)
+         {
+            for (long r = -half; r <= half; ++r)
+               for (long c = -half; c <= half; ++c)
+                  keep = keep && m.valid(x + c, y + r);
+         }
+         else if (op == ossimMaskMorphology::OPENING)
+         {
+            keep = false;
+            for (long r = -half; (r <= half) && !keep; ++r)
+               for (long c = -half; (c <= half) && !keep; ++c)
+               {
+                  bool all = true;
+                  for (long r2 = -half; (r2 <= half) && all; ++r2)
+                     for (long c2 = -half; (c2 <= half) && all; ++c2)
+                        all = m.valid(x + c + c2, y + r + r2);
+                  keep = all;
+               }
+         }
+         else if (op == ossimMaskMorphology::CLOSING)
+         {
+            for (long r = -half; (r <= half) && keep; ++r)
+               for (long c = -half; (c <= half) && keep; ++c)
+               {
+                  bool any = false;
+                  for (long r2 = -half; (r2 <= half) && !any; ++r2)
+                     for (long c2 = -half; (c2 <= half) && !any; ++c2)
+                        any = m.valid(x + c + c2, y + r + r2);
+                  keep = any;
+               }
+         }
+
+         T& o = out[y * size + x];
+         if ((op == ossimMaskMorphology::EROSION) || (op == ossimMaskMorphology::OPENING))
+         {
+            o = (valid && keep && inside) ? center : np;
+         }
+         else if (valid)
+         {
+            o = center;
+         }
+         else
+         {
+            double sum = 0.0;
+            long n = 0;
+            for (long r = -half; r <= half; ++r)
+               for (long c = -half; c <= half; ++c)
+                  if (m.valid(x + c, y + r))
+                  {
+                     sum += in[(y + r + margin) * iw + x + c + margin];
+                     ++n;
+                  }
+            o = (inside && keep && n) ? (T) (sum / n) : np;
+         }
+      }
+   }
+}
+
+template <class T>
+static int check(ossimScalarType type, const char* name)
+{
+   const long size = 64;
+   const long windows[] = { 3, 5, 9 };
+   int failures = 0;
+   ossimTimer* timer = ossimTimer::instance();
+
+   // Triangle over part of the tile:
+   vector<ossimDpt> vertices;
+   vertices.push_back(ossimDpt(-5, -5));
+   vertices.push_back(ossimDpt(size + 5, 10));
+   vertices.push_back(ossimDpt(20, size + 5));
+   ossimPolygon triangle (vertices);
+
+   for (int wi = 0; wi < 3; ++wi)
+   {
+      const long w = windows[wi];
+      for (int op = 0; op < 4; ++op)
+      {
+         ossimMaskMorphology engine;
+         engine.setWindowSize(w);
+         engine.setOperation((ossimMaskMorphology::Operation) op);
+
+         ossimRefPtr<ossimImageData> input = makeInput<T>(type, size, engine.getMargin());
+         ossimRefPtr<ossimImageData> output = new ossimImageData(0, type, 1, size, size);
+         output->initialize();
+         output->setOrigin(ossimIpt(0, 0));
+
+         long mismatches = 0;
+         double engineTime = 0.0;
+         double scanTime = 0.0;
+         for (int withPoly = 0; withPoly < 2; ++withPoly)
+         {
+            const ossimPolygon* poly = withPoly ? &triangle : 0;
+            ossimTimer::Timer_t t0 = timer->tick();
+            if (!engine.apply(input.get(), output.get(), poly))
+               ++failures;
+            ossimTimer::Timer_t t1 = timer->tick();
+            vector<T> expected;
+            reference<T>(input.get(), size, w, (ossimMaskMorphology::Operation) op, poly,
+                         expected);
+            ossimTimer::Timer_t t2 = timer->tick();
+            engineTime += timer->delta_s(t0, t1);
+            scanTime += timer->delta_s(t1, t2);
+
+            const T* out = (const T*) output->getBuf(0);
+            for (long i = 0; i < size * size; ++i)
+               if (fabs((double) out[i] - (double) expected[i]) > 1.0e-3)
+                  ++mismatches;
+         }
+
+         cout << "  " << name << " " << OPERATION_NAMES[op] << " " << w << "x" << w
+              << "  engine: " << engineTime << "s  scan: " << scanTime
+              << "s  mismatches: " << mismatches << endl;
+         if (mismatches)
+            ++failures;
+      }
+   }
+   return failures;
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-morphology Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+   srand(1);
+   cout << setiosflags(ios::fixed) << setprecision(4);
+
+   int failures = 0;
+   failures += check<ossim_uint8>(OSSIM_UINT8, "uint8");
+   failures += check<ossim_float32>(OSSIM_FLOAT32, "float");
+
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
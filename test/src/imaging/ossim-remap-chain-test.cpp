@@ -0,0 +1,199 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test application for ossimRemapChain. Runs chains of
+// pointwise remappers over 8 bit, 16 bit and float images with fusion on
+// and off, checks the outputs match and prints the times of both. Also checks
+// that a fused chain picks up a change made upstream of its head after the
+// first tile.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimPreferences.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimBrightnessContrastSource.h>
+#include <ossim/imaging/ossimGammaRemapper.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimLinearStretchRemapper.h>
+#include <ossim/imaging/ossimMemoryImageSource.h>
+#include <ossim/imaging/ossimScalarRemapper.h>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+static const ossim_uint32 SIZE  = 1024;
+static const ossim_uint32 TILE  = 256;
+static const ossim_uint32 BANDS = 2;
+
+// Tiles of ossimMemoryImageSource have the default null, min and max of their type, so the image
+// has those too. Values cover the whole range, with some nulls.
+static ossimRefPtr<ossimMemoryImageSource> makeSource(ossimScalarType scalar)
+{
+   ossimRefPtr<ossimImageData> image = new ossimImageData(0, scalar, BANDS, SIZE, SIZE);
+   image->initialize();
+   const double MIN_PIX = ossim::defaultMin(scalar);
+   const double MAX_PIX = ossim::defaultMax(scalar);
+   const bool   INTEGER = (scalar != OSSIM_NORMALIZED_FLOAT);
+   for (ossim_uint32 band = 0; band < BANDS; ++band)
+   {
+      for (ossim_uint32 y = 0; y < SIZE; ++y)
+      {
+         for (ossim_uint32 x = 0; x < SIZE; ++x)
+         {
+            ossim_uint32 i = (x * 7 + y * 13 + band * 31) % 997;
+            double v = ossim::defaultNull(scalar);
+            if (i)
+            {
+               v = MIN_PIX + (i - 1) * (MAX_PIX - MIN_PIX) / 995.0;
+               if (INTEGER)
+               {
+                  v = std::floor(v);
+               }
+            }
+            image->setValue(x, y, v, band);
+         }
+      }
+   }
+   image->validate();
+
+   ossimRefPtr<ossimMemoryImageSource> source = new ossimMemoryImageSource();
+   source->setImage(image);
+   return source;
+}
+
+// Output of head over the whole image, fused or not:
+static ossimRefPtr<ossimImageData> run(ossimImageSourceFilter* head, bool fuse, double& seconds,
+                                       bool init = true)
+{
+   ossimPreferences::instance()->addPreference("remap_chain.fuse", fuse ? "true" : "false");
+   if (init)
+   {
+      head->initialize();
+   }
+
+   ossimScalarType scalar = head->getOutputScalarType();
+   ossimRefPtr<ossimImageData> result = new ossimImageData(0, scalar, BANDS, SIZE, SIZE);
+   result->initialize();
+
+   ossimTimer* timer = ossimTimer::instance();
+   ossimTimer::Timer_t t0 = timer->tick();
+   for (ossim_uint32 y = 0; y < SIZE; y += TILE)
+   {
+      for (ossim_uint32 x = 0; x < SIZE; x += TILE)
+      {
+         ossimRefPtr<ossimImageData> tile = head->getTile(ossimIrect(x, y, x + TILE - 1,
+                                                                     y + TILE - 1));
+         if (tile.valid())
+         {
+            result->loadTile(tile.get());
+         }
+      }
+   }
+   seconds = timer->delta_s(t0, timer->tick());
+   return result;
+}
+
+static double worstDifference(const ossimImageData* a, const ossimImageData* b)
+{
+   double worst = 0.0;
+   for (ossim_uint32 band = 0; band < BANDS; ++band)
+   {
+      for (ossim_uint32 i = 0; i < SIZE * SIZE; ++i)
+      {
+         double d = std::fabs(a->getPix(i, band) - b->getPix(i, band));
+         if (d > worst)
+            worst = d;
+      }
+   }
+   return worst;
+}
+
+static int check(const char* name, ossimImageSourceFilter* head, double tolerance)
+{
+   double unfusedTime = 0.0;
+   double fusedTime   = 0.0;
+   ossimRefPtr<ossimImageData> unfused = run(head, false, unfusedTime);
+   ossimRefPtr<ossimImageData> fused   = run(head, true, fusedTime);
+
+   double worst = worstDifference(fused.get(), unfused.get());
+   int failures = (worst > tolerance) ? 1 : 0;
+   cout << "  " << name << ": max difference " << worst
+        << "  unfused: " << unfusedTime << "s  fused: " << fusedTime << "s  "
+        << (failures ? "FAILED" : "ok") << endl;
+   return failures;
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-remap-chain Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+   cout << setiosflags(ios::fixed) << setprecision(4);
+
+   int failures = 0;
+
+   // 8 bit: gamma -> brightness/contrast, table of 256.
+   {
+      ossimRefPtr<ossimMemoryImageSource> source = makeSource(OSSIM_UINT8);
+      ossimRefPtr<ossimGammaRemapper> gamma = new ossimGammaRemapper(0.7);
+      gamma->connectMyInputTo(0, source.get());
+      ossimRefPtr<ossimBrightnessContrastSource> bc = new ossimBrightnessContrastSource();
+      bc->connectMyInputTo(0, gamma.get());
+      bc->setBrightnessContrast(0.1, 1.3);
+      failures += check("uint8 gamma/brightness-contrast", bc.get(), 0.0);
+   }
+
+   // 16 bit: gamma -> scalar remapper to 8 bit, table of 65536.
+   {
+      ossimRefPtr<ossimMemoryImageSource> source = makeSource(OSSIM_UINT16);
+      ossimRefPtr<ossimGammaRemapper> gamma = new ossimGammaRemapper(1.8);
+      gamma->connectMyInputTo(0, source.get());
+      ossimRefPtr<ossimScalarRemapper> scalar = new ossimScalarRemapper(gamma.get(), OSSIM_UINT8);
+      failures += check("uint16 gamma/scalar", scalar.get(), 0.0);
+   }
+
+   // Float: gamma -> linear stretch, interpolated knots.
+   {
+      ossimRefPtr<ossimMemoryImageSource> source = makeSource(OSSIM_NORMALIZED_FLOAT);
+      ossimRefPtr<ossimGammaRemapper> gamma = new ossimGammaRemapper(0.5);
+      gamma->connectMyInputTo(0, source.get());
+      ossimRefPtr<ossimLinearStretchRemapper> stretch = new ossimLinearStretchRemapper();
+      stretch->connectMyInputTo(0, gamma.get());
+      for (ossim_uint32 band = 0; band < BANDS; ++band)
+      {
+         stretch->setMinPixelValue(0.1, band);
+         stretch->setMaxPixelValue(0.9, band);
+      }
+      failures += check("float gamma/linear-stretch", stretch.get(), 1.0e-3);
+   }
+
+   // 8 bit: gamma changed after the chain was fused, without initializing the head again.
+   {
+      ossimRefPtr<ossimMemoryImageSource> source = makeSource(OSSIM_UINT8);
+      ossimRefPtr<ossimGammaRemapper> gamma = new ossimGammaRemapper(0.7);
+      gamma->connectMyInputTo(0, source.get());
+      ossimRefPtr<ossimBrightnessContrastSource> bc = new ossimBrightnessContrastSource();
+      bc->connectMyInputTo(0, gamma.get());
+      bc->setBrightnessContrast(0.1, 1.3);
+
+      double seconds = 0.0;
+      ossimRefPtr<ossimImageData> before = run(bc.get(), true, seconds);
+      gamma->setGamma(1.6);
+      ossimRefPtr<ossimImageData> fused   = run(bc.get(), true, seconds, false);
+      ossimRefPtr<ossimImageData> unfused = run(bc.get(), false, seconds);
+
+      double worst   = worstDifference(fused.get(), unfused.get());
+      bool   changed = (worstDifference(before.get(), unfused.get()) > 0.0);
+      int    failed  = ((worst > 0.0) || !changed) ? 1 : 0;
+      cout << "  uint8 upstream gamma change: max difference " << worst << "  "
+           << (failed ? "FAILED" : "ok") << endl;
+      failures += failed;
+   }
+
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
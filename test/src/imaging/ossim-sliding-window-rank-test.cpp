@@ -0,0 +1,177 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test application for ossimSlidingWindowRank. Checks medians,
+// percentiles and valid counts of random 8 bit, 16 bit and float tiles, with
+// and without nulls, against sorting every window, and prints the times.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimSlidingWindowRank.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+template <class T>
+static ossimRefPtr<ossimImageData> makeInput(ossimScalarType type, long size, long half,
+                                             bool withNulls, int range)
+{
+   ossimRefPtr<ossimImageData> tile =
+      new ossimImageData(0, type, 1, size + 2 * half, size + 2 * half);
+   tile->initialize();
+   tile->setOrigin(ossimIpt(-half, -half));
+   T* buf = (T*) tile->getBuf(0);
+   T np = (T) tile->getNullPix(0);
+   for (ossim_uint32 i = 0; i < tile->getSizePerBand(); ++i)
+   {
+      buf[i] = (T) ((rand() % range) - ((type == OSSIM_SINT16) ? range / 2 : 0));
+      if (buf[i] == np)
+         ++buf[i];
+      if (withNulls && ((rand() % 4) == 0))
+         buf[i] = np;
+   }
+   tile->validate();
+   return tile;
+}
+
+// Sorts every window:
+template <class T>
+static void reference(const ossimImageData* input, long size, long w, double rank,
+                      ossimSlidingWindowRank::NullMode mode, vector<T>& out)
+{
+   const T* in = (const T*) input->getBuf(0);
+   const T np = (T) input->getNullPix(0);
+   long iw = input->getWidth();
+   bool checkNulls = input->getDataObjectStatus() != OSSIM_FULL;
+   out.resize(size * size);
+   vector<T> values;
+   for (long y = 0; y < size; ++y)
+   {
+      for (long x = 0; x < size; ++x)
+      {
+         values.clear();
+         for (long r = 0; r < w; ++r)
+            for (long c = 0; c < w; ++c)
+            {
+               T v = in[(y + r) * iw + x + c];
+               if (!checkNulls || (v != np))
+                  values.push_back(v);
+            }
+         sort(values.begin(), values.end());
+         T center = in[(y + w / 2) * iw + x + w / 2];
+         bool nullCenter = checkNulls && (center == np);
+         ossim_uint32 k = min((ossim_uint32) values.size() - 1,
+                              (ossim_uint32) (rank * values.size()));
+         T& o = out[y * size + x];
+         if (nullCenter)
+            o = ((mode != ossimSlidingWindowRank::SKIP_NULL_CENTER) && values.size()) ? values[k] : np;
+         else if (mode == ossimSlidingWindowRank::NULL_CENTER_ONLY)
+            o = center;
+         else
+            o = values[k];
+      }
+   }
+}
+
+template <class T>
+static int check(ossimScalarType type, const char* name, int range)
+{
+   const long size = 96;
+   const long windows[] = { 3, 5, 9, 15 };
+   const double ranks[] = { 0.5, 0.1, 0.9 };
+   int failures = 0;
+   ossimTimer* timer = ossimTimer::instance();
+
+   for (int withNulls = 0; withNulls < 2; ++withNulls)
+   {
+      for (int wi = 0; wi < 4; ++wi)
+      {
+         long w = windows[wi];
+         ossimRefPtr<ossimImageData> input = makeInput<T>(type, size, w / 2, withNulls, range);
+         ossimRefPtr<ossimImageData> output = new ossimImageData(0, type, 1, size, size);
+         output->initialize();
+         output->setOrigin(ossimIpt(0, 0));
+
+         double engineTime = 0.0;
+         double sortTime = 0.0;
+         long mismatches = 0;
+         for (int ri = 0; ri < 3; ++ri)
+         {
+            for (int mode = 0; mode < 3; ++mode)
+            {
+               ossimSlidingWindowRank engine;
+               engine.setWindowSize(w);
+               engine.setRank(ranks[ri]);
+               engine.setNullMode((ossimSlidingWindowRank::NullMode) mode);
+
+               ossimTimer::Timer_t t0 = timer->tick();
+               if (!engine.apply(input.get(), output.get()))
+                  ++failures;
+               ossimTimer::Timer_t t1 = timer->tick();
+               vector<T> expected;
+               reference<T>(input.get(), size, w, ranks[ri],
+                            (ossimSlidingWindowRank::NullMode) mode, expected);
+               ossimTimer::Timer_t t2 = timer->tick();
+               engineTime += timer->delta_s(t0, t1);
+               sortTime += timer->delta_s(t1, t2);
+
+               const T* out = (const T*) output->getBuf(0);
+               for (long i = 0; i < size * size; ++i)
+                  if (out[i] != expected[i])
+                     ++mismatches;
+            }
+         }
+
+         // Valid counts:
+         ossimSlidingWindowRank counter;
+         counter.setWindowSize(w);
+         vector<ossim_uint32> counts;
+         counter.countValid(input.get(), 0, output.get(), counts);
+         const T* in = (const T*) input->getBuf(0);
+         const T np = (T) input->getNullPix(0);
+         long iw = input->getWidth();
+         for (long y = 0; y < size; ++y)
+            for (long x = 0; x < size; ++x)
+            {
+               ossim_uint32 n = 0;
+               for (long r = 0; r < w; ++r)
+                  for (long c = 0; c < w; ++c)
+                     n += (in[(y + r) * iw + x + c] != np);
+               if (n != counts[y * size + x])
+                  ++mismatches;
+            }
+
+         cout << "  " << name << (withNulls ? " nulls " : " full  ") << setw(2) << w << "x"
+              << setw(2) << w << "  engine: " << engineTime << "s  sort: " << sortTime
+              << "s  mismatches: " << mismatches << endl;
+         if (mismatches)
+            ++failures;
+      }
+   }
+   return failures;
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-sliding-window-rank Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+   srand(1);
+   cout << setiosflags(ios::fixed) << setprecision(4);
+
+   int failures = 0;
+   failures += check<ossim_uint8>(OSSIM_UINT8, "uint8 ", 256);
+   failures += check<ossim_uint16>(OSSIM_UINT16, "uint16", 65536);
+   failures += check<ossim_sint16>(OSSIM_SINT16, "sint16", 4000);
+   failures += check<ossim_float32>(OSSIM_FLOAT32, "float ", 1000);
+
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
@@ -0,0 +1,191 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test and benchmark of ossimTerrainKernels. Runs both stencils
+// on a rough surface with nulls with the plain loop and with the best
+// instruction set of the cpu, checks the outputs are the same bits, checks a
+// tilted plane gives its known normal, aspect and shade, and prints the time
+// of both.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimImageDataKernels.h>
+#include <ossim/imaging/ossimTerrainKernels.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+static const ossim_uint32 W      = 256 + 3; // Odd pixels so the tails run too.
+static const ossim_uint32 H      = 256;
+static const int          REPEAT = 50;
+
+static ossimImageDataKernels::Isa best;
+static int failures = 0;
+
+template <class T> static const char* typeName();
+template <> const char* typeName<ossim_uint8>()   { return "uint8  "; }
+template <> const char* typeName<ossim_uint16>()  { return "uint16 "; }
+template <> const char* typeName<ossim_sint16>()  { return "sint16 "; }
+template <> const char* typeName<ossim_float32>() { return "float32"; }
+template <> const char* typeName<ossim_float64>() { return "float64"; }
+
+struct Planes
+{
+   Planes() : m_planes(5, vector<ossim_float64>(W * H)) {}
+
+   ossimTerrainKernels::Outputs outputs()
+   {
+      ossimTerrainKernels::Outputs result;
+      result.m_normalX = &m_planes[0].front();
+      result.m_normalY = &m_planes[1].front();
+      result.m_normalZ = &m_planes[2].front();
+      result.m_aspect  = &m_planes[3].front();
+      result.m_shade   = &m_planes[4].front();
+      return result;
+   }
+
+   bool operator==(const Planes& rhs) const
+   {
+      for (size_t i = 0; i < m_planes.size(); ++i)
+      {
+         if ( memcmp(&m_planes[i].front(), &rhs.m_planes[i].front(), W * H * sizeof(double)) )
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   vector< vector<ossim_float64> > m_planes;
+};
+
+template <class T>
+static void check(ossimTerrainKernels::Stencil stencil, double nullFraction)
+{
+   // Random heights, 0 the null:
+   vector<T> dem( (W + 2) * (H + 2) );
+   srand(W);
+   for (size_t i = 0; i < dem.size(); ++i)
+   {
+      dem[i] = (rand() < nullFraction * RAND_MAX) ? T(0) : static_cast<T>(1 + rand() % 200);
+   }
+
+   ossimTerrainKernels::Params params;
+   params.m_stencil   = stencil;
+   params.m_xScale    = 1.0 / 30.0;
+   params.m_yScale    = 1.0 / 30.0;
+   params.m_light[0]  = 0.5;
+   params.m_light[1]  = 0.5;
+   params.m_light[2]  = sqrt(0.5);
+
+   Planes a;
+   Planes b;
+   ossimTerrainKernels::Outputs outA = a.outputs();
+   ossimTerrainKernels::Outputs outB = b.outputs();
+   outA.m_aspect = 0; // atan2 a pixel at a time either way, it would only hide the rest.
+   outB.m_aspect = 0;
+   ossimTimer* timer = ossimTimer::instance();
+
+   ossimImageDataKernels::setIsa(ossimImageDataKernels::ISA_SCALAR);
+   ossimTimer::Timer_t t0 = timer->tick();
+   for (int i = 0; i < REPEAT; ++i)
+   {
+      ossimTerrainKernels::compute(&dem.front(), W, H, params, outA);
+   }
+   const double PLAIN = timer->delta_s(t0, timer->tick());
+
+   ossimImageDataKernels::setIsa(best);
+   t0 = timer->tick();
+   for (int i = 0; i < REPEAT; ++i)
+   {
+      ossimTerrainKernels::compute(&dem.front(), W, H, params, outB);
+   }
+   const double FAST = timer->delta_s(t0, timer->tick());
+
+   // With aspect, once each way:
+   ossimImageDataKernels::setIsa(ossimImageDataKernels::ISA_SCALAR);
+   ossimTerrainKernels::compute(&dem.front(), W, H, params, a.outputs());
+   ossimImageDataKernels::setIsa(best);
+   ossimTerrainKernels::compute(&dem.front(), W, H, params, b.outputs());
+
+   const bool OK = (a == b);
+   if (!OK)
+   {
+      ++failures;
+   }
+   cout << "  " << ((stencil == ossimTerrainKernels::HORN) ? "horn " : "zt   ")
+        << typeName<T>() << " nulls: " << setw(4) << nullFraction
+        << "  plain: " << PLAIN << "s  " << ossimImageDataKernels::getIsaName(best) << ": "
+        << FAST << "s  " << (OK ? "ok" : "DIFFERENT") << endl;
+}
+
+// A plane rising 1 to the east and 2 to the south a pixel:
+static void checkPlane(ossimTerrainKernels::Stencil stencil)
+{
+   vector<ossim_float32> dem( (W + 2) * (H + 2) );
+   for (ossim_uint32 y = 0; y < H + 2; ++y)
+   {
+      for (ossim_uint32 x = 0; x < W + 2; ++x)
+      {
+         dem[y * (W + 2) + x] = 1000.0f + x + 2.0f * y;
+      }
+   }
+   ossimTerrainKernels::Params params;
+   params.m_stencil = stencil;
+   params.m_light[0] = 0.0;
+   params.m_light[1] = 0.0;
+   params.m_light[2] = 1.0;
+   Planes planes;
+   ossimTerrainKernels::compute(&dem.front(), W, H, params, planes.outputs());
+
+   // Normal (1, 2, 1) / sqrt(6), downhill to the north west:
+   const double N = 1.0 / sqrt(6.0);
+   const double ASPECT = 360.0 - atan2(1.0, 2.0) * DEG_PER_RAD;
+   bool ok = true;
+   for (ossim_uint32 i = 0; i < W * H; ++i)
+   {
+      ok = ok && (fabs(planes.m_planes[0][i] - N) < 1e-12) &&
+         (fabs(planes.m_planes[1][i] - 2.0 * N) < 1e-12) &&
+         (fabs(planes.m_planes[2][i] - N) < 1e-12) &&
+         (fabs(planes.m_planes[3][i] - ASPECT) < 1e-9) &&
+         (fabs(planes.m_planes[4][i] - N) < 1e-12);
+   }
+   if (!ok)
+   {
+      ++failures;
+   }
+   cout << "  " << ((stencil == ossimTerrainKernels::HORN) ? "horn " : "zt   ")
+        << "plane: " << (ok ? "ok" : "WRONG") << endl;
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-terrain-kernels Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+   best = ossimImageDataKernels::getBestIsa();
+   cout << setiosflags(ios::fixed) << setprecision(4);
+
+   const ossimTerrainKernels::Stencil STENCILS[2] =
+      { ossimTerrainKernels::ZEVENBERGEN_THORNE, ossimTerrainKernels::HORN };
+   for (int s = 0; s < 2; ++s)
+   {
+      check<ossim_uint8>(STENCILS[s], 0.05);
+      check<ossim_uint16>(STENCILS[s], 0.0);
+      check<ossim_sint16>(STENCILS[s], 0.0);
+      check<ossim_sint16>(STENCILS[s], 0.01);
+      check<ossim_float32>(STENCILS[s], 0.0);
+      check<ossim_float64>(STENCILS[s], 0.01);
+      checkPlane(STENCILS[s]);
+   }
+
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
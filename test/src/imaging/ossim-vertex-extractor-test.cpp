@@ -0,0 +1,158 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test application for ossimVertexExtractor. Finds the edges
+// of a synthetic image with reduced resolution levels by the full scan and
+// by the coarse to fine scan, checks they match and prints the pixels read
+// and the time of both.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimImageSource.h>
+#include <ossim/imaging/ossimVertexExtractor.h>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+static const ossim_int32 WIDTH  = 4000;
+static const ossim_int32 HEIGHT = 3000;
+static const ossim_int32 LEVELS = 7;
+
+// Image with a quadrilateral of valid data, the left side wavy. Level r has
+// pixels 2^r wide, taking the value of the full resolution pixel at their
+// center.
+class PolygonSource : public ossimImageSource
+{
+public:
+   PolygonSource() : ossimImageSource(0, 0, 0, true, false), m_pixelsRead(0) {}
+
+   static bool inside(ossim_int32 x, ossim_int32 y)
+   {
+      const double LEFT  = 300.0 + 0.2 * y + 40.0 * std::sin(y / 50.0);
+      const double RIGHT = 3700.0 - 0.3 * y;
+      return (y >= 100) && (y <= 2800) && (x >= LEFT) && (x <= RIGHT) && (x + y >= 700);
+   }
+
+   virtual ossimRefPtr<ossimImageData> getTile(const ossimIrect& rect, ossim_uint32 resLevel = 0)
+   {
+      const ossim_int32 SCALE = 1 << resLevel;
+      ossimRefPtr<ossimImageData> tile =
+         new ossimImageData(this, OSSIM_UINT8, 1, rect.width(), rect.height());
+      tile->setImageRectangle(rect);
+      tile->initialize();
+      ossim_uint8* buf = static_cast<ossim_uint8*>(tile->getBuf());
+      for (ossim_int32 y = rect.ul().y; y <= rect.lr().y; ++y)
+      {
+         for (ossim_int32 x = rect.ul().x; x <= rect.lr().x; ++x)
+         {
+            if (inside(x * SCALE + SCALE / 2, y * SCALE + SCALE / 2))
+            {
+               *buf = 1;
+            }
+            ++buf;
+         }
+      }
+      tile->validate();
+      m_pixelsRead += static_cast<double>(rect.width()) * rect.height();
+      return tile;
+   }
+
+   virtual ossimIrect getBoundingRect(ossim_uint32 resLevel = 0) const
+   {
+      const ossim_int32 SCALE = 1 << resLevel;
+      return ossimIrect(0, 0, (WIDTH - 1) / SCALE, (HEIGHT - 1) / SCALE);
+   }
+
+   virtual void getDecimationFactor(ossim_uint32 resLevel, ossimDpt& result) const
+   {
+      result.x = result.y = 1.0 / (1 << resLevel);
+   }
+
+   virtual ossim_uint32 getNumberOfDecimationLevels() const { return LEVELS; }
+   virtual ossim_uint32 getNumberOfInputBands() const { return 1; }
+   virtual ossim_uint32 getNumberOfOutputBands() const { return 1; }
+   virtual ossimScalarType getOutputScalarType() const { return OSSIM_UINT8; }
+   virtual ossim_uint32 getTileWidth() const { return 256; }
+   virtual ossim_uint32 getTileHeight() const { return 256; }
+   virtual void initialize() {}
+   virtual bool canConnectMyInputTo(ossim_int32, const ossimConnectableObject*) const
+   {
+      return false;
+   }
+
+   //! Pixels read, all levels.
+   double m_pixelsRead;
+};
+
+// Gets at the edge scans:
+class TestExtractor : public ossimVertexExtractor
+{
+public:
+   TestExtractor(ossimImageSource* src) : ossimVertexExtractor(src)
+   {
+      setAreaOfInterest(src->getBoundingRect(0));
+   }
+   bool scan(bool coarseToFine)
+   {
+      return (coarseToFine ? scanForEdgesCoarseToFine() : scanForEdges()) && extractVertices();
+   }
+   const vector<ossim_int32>& left() const { return theLeftEdge; }
+   const vector<ossim_int32>& right() const { return theRightEdge; }
+};
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-vertex-extractor Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+   cout << setiosflags(ios::fixed) << setprecision(4);
+
+   ossimRefPtr<PolygonSource> source = new PolygonSource();
+   ossimRefPtr<TestExtractor> full   = new TestExtractor(source.get());
+   ossimRefPtr<TestExtractor> fast   = new TestExtractor(source.get());
+   ossimTimer* timer = ossimTimer::instance();
+
+   ossimTimer::Timer_t t0 = timer->tick();
+   bool status = full->scan(false);
+   double fullTime = timer->delta_s(t0, timer->tick());
+   double fullPixels = source->m_pixelsRead;
+
+   source->m_pixelsRead = 0;
+   t0 = timer->tick();
+   status = fast->scan(true) && status;
+   double fastTime = timer->delta_s(t0, timer->tick());
+   double fastPixels = source->m_pixelsRead;
+
+   ossim_uint32 differences = 0;
+   for (ossim_uint32 i = 0; i < full->left().size(); ++i)
+   {
+      if ( (full->left()[i] != fast->left()[i]) || (full->right()[i] != fast->right()[i]) )
+      {
+         ++differences;
+      }
+   }
+   for (ossim_uint32 i = 0; i < 4; ++i)
+   {
+      if (full->getVertices()[i] != fast->getVertices()[i])
+      {
+         ++differences;
+      }
+      cout << "  vertex " << i << ": " << fast->getVertices()[i] << endl;
+   }
+
+   cout << "  full scan:      " << setprecision(0) << fullPixels << " pixels read  "
+        << setprecision(4) << fullTime << "s" << endl;
+   cout << "  coarse to fine: " << setprecision(0) << fastPixels << " pixels read  "
+        << setprecision(4) << fastTime << "s" << endl;
+   cout << "  differences: " << differences << endl;
+
+   const bool PASSED = status && (differences == 0) && (fastPixels < fullPixels / 4);
+   cout << (PASSED ? "  Passed." : "  Failed.") << endl;
+   return PASSED ? 0 : 1;
+}
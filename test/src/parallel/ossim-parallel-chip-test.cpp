@@ -0,0 +1,88 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test application for ossimParallelChipRenderer. Renders a
+// chip of an image through a rendered ossimSingleImageChain with one
+// getTile() and with the parallel renderer, checks the two chips are the
+// same and prints the time of both.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimCommon.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/imaging/ossimImageData.h>
+#include <ossim/imaging/ossimSingleImageChain.h>
+#include <ossim/parallel/ossimParallelChipRenderer.h>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-parallel-chip Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+
+   if (argc < 2)
+   {
+      cout << argv[0] << " <image_file> [<chip_size> [<threads>]]"
+           << "\nRenders a chip_size square chip (default 4096) from the center of image_file"
+           << "\non one thread and on threads threads (default all) and compares them." << endl;
+      return 0;
+   }
+
+   const ossimFilename IMAGE_FILE = argv[1];
+   const ossim_int32 SIZE = (argc > 2) ? ossimString(argv[2]).toInt32() : 4096;
+   const ossim_uint32 THREADS = (argc > 3) ? ossimString(argv[3]).toUInt32() : 0;
+
+   ossimRefPtr<ossimSingleImageChain> chain = new ossimSingleImageChain();
+   if ( !chain->open(IMAGE_FILE) )
+   {
+      cout << "  Could not open " << IMAGE_FILE << "\n  Failed." << endl;
+      return 1;
+   }
+   chain->createRenderedChain();
+
+   const ossimIrect BOUNDS = chain->getBoundingRect();
+   const ossimIpt CENTER = BOUNDS.midPoint();
+   const ossimIrect RECT(CENTER.x - SIZE / 2, CENTER.y - SIZE / 2,
+                         CENTER.x - SIZE / 2 + SIZE - 1, CENTER.y - SIZE / 2 + SIZE - 1);
+
+   ossimParallelChipRenderer renderer;
+   renderer.setNumberOfThreads(THREADS);
+   ossimTimer* timer = ossimTimer::instance();
+
+   ossimTimer::Timer_t t0 = timer->tick();
+   ossimRefPtr<ossimImageData> serial = chain->getTile(RECT);
+   const double SERIAL_TIME = timer->delta_s(t0, timer->tick());
+
+   // The first call makes the clones, the second reuses them:
+   t0 = timer->tick();
+   ossimRefPtr<ossimImageData> parallel = renderer.getChip(chain.get(), RECT);
+   const double COLD_TIME = timer->delta_s(t0, timer->tick());
+   t0 = timer->tick();
+   parallel = renderer.getChip(chain.get(), RECT);
+   const double WARM_TIME = timer->delta_s(t0, timer->tick());
+
+   bool passed = serial.valid() && parallel.valid() &&
+      (serial->getImageRectangle() == parallel->getImageRectangle()) &&
+      (serial->getSizeInBytes() == parallel->getSizeInBytes()) &&
+      (serial->getDataObjectStatus() == parallel->getDataObjectStatus());
+   for (ossim_uint32 band = 0; passed && (band < serial->getNumberOfBands()); ++band)
+   {
+      passed = !memcmp(serial->getBuf(band), parallel->getBuf(band), serial->getSizePerBandInBytes());
+   }
+
+   cout << setiosflags(ios::fixed) << setprecision(4)
+        << "  chip:            " << RECT
+        << "\n  threads:         " << renderer.getNumberOfThreads()
+        << "\n  one getTile():   " << SERIAL_TIME << "s"
+        << "\n  parallel, cold:  " << COLD_TIME << "s"
+        << "\n  parallel, warm:  " << WARM_TIME << "s"
+        << (passed ? "\n  Passed." : "\n  Failed.") << endl;
+   return passed ? 0 : 1;
+}
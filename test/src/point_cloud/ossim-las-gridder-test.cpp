@@ -0,0 +1,123 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test application for ossimLasGridder. Grids a LAS file over its
+// header bounds once in a single thread with the whole raster in memory, and
+// once with all threads, a memory limit small enough to force strips and
+// requests of 256 lines as an image handler makes them, then checks the two
+// agree and that every point in bounds was counted.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/point_cloud/ossimLasGridder.h>
+#include <ossim/support_data/ossimLasHdr.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+static bool grid(const ossimFilename& fname,
+                 ossim_float64 gsd,
+                 ossim_uint32 threads,
+                 ossim_uint64 memoryLimit,
+                 ossim_uint32 requestLines,
+                 ossimLasGridder::Statistic stat,
+                 vector<ossim_float32>& values,
+                 ossimIrect& rect,
+                 double& seconds)
+{
+   ossimLasGridder gridder;
+   if ( !gridder.open(fname) )
+      return false;
+
+   const ossimLasHdr* hdr = gridder.getHeader();
+   ossim_uint32 width  = (ossim_uint32) floor( (hdr->getMaxX() - hdr->getMinX()) / gsd ) + 1;
+   ossim_uint32 height = (ossim_uint32) floor( (hdr->getMaxY() - hdr->getMinY()) / gsd ) + 1;
+   gridder.setGrid( ossimDpt(hdr->getMinX(), hdr->getMaxY()), ossimDpt(gsd, gsd), width, height );
+   gridder.setNumberOfThreads( threads );
+   gridder.setMemoryLimit( memoryLimit );
+
+   rect = ossimIrect( 0, 0, width - 1, height - 1 );
+   values.resize( (size_t) width * height );
+
+   ossimTimer::Timer_t t0 = ossimTimer::instance()->tick();
+   bool status = true;
+   const ossim_uint32 STEP = requestLines ? requestLines : height;
+   for ( ossim_uint32 y = 0; status && ( y < height ); y += STEP )
+   {
+      ossimIrect request( 0, y, width - 1, std::min( y + STEP, height ) - 1 );
+      status = gridder.getValues( request, stat, &values[(size_t) y * width], -99999.0 );
+   }
+   seconds = ossimTimer::instance()->delta_s( t0, ossimTimer::instance()->tick() );
+   return status;
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-las-gridder Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+
+   if ( argc < 2 )
+   {
+      cout  << "Missing input LAS file name.\n"
+            << "Usage: " << argv[0] << " <filename.las> [<gsd>]" << endl;
+      return -1;
+   }
+   ossimFilename fname (argv[1]);
+   ossim_float64 gsd = ( argc > 2 ) ? ossimString(argv[2]).toFloat64() : 1.0;
+
+   const ossimLasGridder::Statistic STATS[] =
+      { ossimLasGridder::LOWEST, ossimLasGridder::HIGHEST,
+        ossimLasGridder::MEAN, ossimLasGridder::COUNT };
+   const char* NAMES[] = { "lowest", "highest", "mean", "count" };
+
+   int failures = 0;
+   cout << setiosflags(ios::fixed) << setprecision(4);
+   for ( int s = 0; s < 4; ++s )
+   {
+      vector<ossim_float32> reference;
+      vector<ossim_float32> strips;
+      ossimIrect rect;
+      double t1 = 0.0;
+      double tn = 0.0;
+
+      // Whole raster, one thread, against one strip at a time, all threads:
+      if ( !grid( fname, gsd, 1, 0xffffffffull, 0, STATS[s], reference, rect, t1 ) ||
+           !grid( fname, gsd, 0, 1024 * 1024, 256, STATS[s], strips, rect, tn ) )
+      {
+         cout << "  Could not grid " << fname << endl;
+         return -1;
+      }
+
+      ossim_uint64 mismatches = 0;
+      double total = 0.0;
+      for ( size_t i = 0; i < reference.size(); ++i )
+      {
+         // Mean may differ in the last bit from summation order:
+         double tolerance = ( STATS[s] == ossimLasGridder::MEAN ) ?
+            1.0e-5 * ( fabs( reference[i] ) + 1.0 ) : 0.0;
+         if ( fabs( reference[i] - strips[i] ) > tolerance )
+            ++mismatches;
+         total += reference[i];
+      }
+
+      cout << "  " << NAMES[s] << ": " << rect.width() << "x" << rect.height()
+           << "  1 thread: " << t1 << "s  strips: " << tn << "s  mismatches: " << mismatches;
+      if ( STATS[s] == ossimLasGridder::COUNT )
+         cout << "  points: " << (ossim_uint64) total;
+      cout << endl;
+
+      if ( mismatches )
+         ++failures;
+   }
+
+   cout << ( failures ? "  Failed." : "  Passed." ) << endl;
+   return failures;
+}
@@ -0,0 +1,169 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test application for ossimPointCloudIndex. Fills a generic
+// point cloud handler with random points, in runs to mimic flight lines, and
+// checks that indexed getBlock() queries return the same points as a full
+// scan, that reduced resolution queries thin the points, and that the index
+// survives a write/read round trip but is refused once the source is modified
+// or its offsets are corrupt.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimDate.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/point_cloud/ossimGenericPointCloudHandler.h>
+#include <ossim/point_cloud/ossimPointCloudIndex.h>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <vector>
+
+using namespace std;
+
+static bool operator<(const ossimGpt& a, const ossimGpt& b)
+{
+   if (a.lat != b.lat) return a.lat < b.lat;
+   if (a.lon != b.lon) return a.lon < b.lon;
+   return a.hgt < b.hgt;
+}
+
+static set<ossimGpt> toSet(ossimPointBlock& block)
+{
+   set<ossimGpt> points;
+   for (ossim_uint32 i=0; i<block.size(); ++i)
+      points.insert(block[i]->getPosition());
+   return points;
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-point-cloud-index Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+
+   ossim_uint32 numPoints = (argc > 1) ? ossimString(argv[1]).toUInt32() : 500000;
+
+   // Runs of points along short random "flight line" segments:
+   srand(1);
+   vector<ossimGpt> points;
+   points.reserve(numPoints);
+   while (points.size() < numPoints)
+   {
+      double lat = 30.0 + 0.1 * rand() / RAND_MAX;
+      double lon = -90.0 + 0.1 * rand() / RAND_MAX;
+      for (int i=0; (i<200) && (points.size()<numPoints); ++i)
+      {
+         points.push_back(ossimGpt(lat, lon, 100.0 * rand() / RAND_MAX));
+         lon += 0.00001;
+      }
+   }
+   ossimRefPtr<ossimGenericPointCloudHandler> pch = new ossimGenericPointCloudHandler(points);
+   ossimRefPtr<ossimGenericPointCloudHandler> indexedPch = new ossimGenericPointCloudHandler(points);
+   indexedPch->openIndex();
+
+   ossimTimer* timer = ossimTimer::instance();
+   ossimTimer::Timer_t t0 = timer->tick();
+   ossimRefPtr<ossimPointCloudIndex> index = new ossimPointCloudIndex;
+   bool built = index->build(pch.get());
+   cout << "  Build: " << (built ? "ok" : "FAILED") << "  depth: " << index->getDepth()
+        << "  " << timer->delta_s(t0, timer->tick()) << "s" << endl;
+   if (!built)
+      return 1;
+
+   int failures = 0;
+   ossimPointBlock scanned;
+   ossimPointBlock indexed;
+   double scanTime = 0;
+   double indexTime = 0;
+   for (int q=0; q<20; ++q)
+   {
+      double lat = 30.0 + 0.09 * rand() / RAND_MAX;
+      double lon = -90.0 + 0.09 * rand() / RAND_MAX;
+      ossimGrect bounds (ossimGpt(lat + 0.01, lon), ossimGpt(lat, lon + 0.01));
+
+      t0 = timer->tick();
+      pch->getBlock(bounds, scanned);
+      ossimTimer::Timer_t t1 = timer->tick();
+      indexedPch->getBlock(bounds, indexed);
+      ossimTimer::Timer_t t2 = timer->tick();
+      scanTime += timer->delta_s(t0, t1);
+      indexTime += timer->delta_s(t1, t2);
+
+      if (toSet(scanned) != toSet(indexed))
+      {
+         cout << "  Query " << q << ": scan " << scanned.size() << " indexed " << indexed.size()
+              << " DIFFERENT" << endl;
+         ++failures;
+      }
+
+      // Reduced resolution must be a subset with fewer points:
+      ossimPointBlock coarse;
+      indexedPch->getBlock(bounds, coarse, 1);
+      set<ossimGpt> all = toSet(indexed);
+      set<ossimGpt> some = toSet(coarse);
+      for (set<ossimGpt>::const_iterator i = some.begin(); i != some.end(); ++i)
+      {
+         if (!all.count(*i))
+         {
+            ++failures;
+            break;
+         }
+      }
+      if ((index->getDepth() > 0) && (coarse.size() >= indexed.size()) && indexed.size())
+         ++failures;
+   }
+   cout << "  20 queries  scan: " << scanTime << "s  indexed: " << indexTime << "s" << endl;
+
+   // Round trip through a sidecar:
+   ossimFilename source ("ossim-point-cloud-index-test.dat");
+   ofstream(source.c_str()) << "source";
+   ossimFilename indexFile = ossimPointCloudIndex::getIndexFilename(source);
+   ossimRefPtr<ossimPointCloudIndex> copy = new ossimPointCloudIndex;
+   ossimRefPtr<ossimPointCloudIndex> stale = new ossimPointCloudIndex;
+   if (!index->write(indexFile, source) || !copy->read(indexFile, source, numPoints) ||
+       stale->read(indexFile, source, numPoints + 1))
+   {
+      cout << "  Write/read: FAILED" << endl;
+      ++failures;
+   }
+   else
+   {
+      ossimGrect bounds (ossimGpt(30.06, -89.96), ossimGpt(30.04, -89.94));
+      vector<ossimPointCloudIndex::Range> a, b;
+      index->getRanges(bounds, 0, a);
+      copy->getRanges(bounds, 0, b);
+      if ((a.size() != b.size()) || (!a.empty() && (a.back().m_start != b.back().m_start)))
+         ++failures;
+
+      // A leaf offset past the next one, after the header, depth, bounds and leaf count:
+      {
+         fstream f (indexFile.c_str(), ios::in | ios::out | ios::binary);
+         f.seekp(8 + 4 + 4 + 8 + 8 + 4 + 4 + 4 * 8 + 8 + 4);
+         const ossim_uint32 BAD = 0xFFFFFFFF;
+         f.write((const char*) &BAD, sizeof BAD);
+      }
+      ossimRefPtr<ossimPointCloudIndex> corrupt = new ossimPointCloudIndex;
+      bool corruptRead = corrupt->read(indexFile, source, numPoints);
+
+      // Same size and point count, other modification time:
+      index->write(indexFile, source);
+      ossimLocalTm earlier (time(0) - 3600);
+      source.setTimes(0, &earlier, 0);
+      bool modifiedRead = stale->read(indexFile, source, numPoints);
+
+      cout << "  Corrupt offsets: " << (corruptRead ? "READ" : "refused")
+           << "  modified source: " << (modifiedRead ? "READ" : "refused") << endl;
+      if (corruptRead || modifiedRead)
+         ++failures;
+   }
+   source.remove();
+   indexFile.remove();
+
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}
@@ -0,0 +1,156 @@
+//**************************************************************************************************
+//
+//     OSSIM Open Source Geospatial Data Processing Library
+//     See top level LICENSE.txt file for license information
+//
+// Load test for ossimToolServer. Runs a number of concurrent ossimToolClient connections that
+// each issue the same command repeatedly and reports client side latency and throughput along
+// with the server's own "stats" response. Without --host a server is started in this process.
+//
+//**************************************************************************************************
+
+#include <ossim/base/ossimArgumentParser.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/init/ossimInit.h>
+#include <ossim/sockets/ossimToolClient.h>
+#include <ossim/sockets/ossimToolServer.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace std;
+
+void usage(char* appName)
+{
+   cout << "\nUsage: "<<appName<<" [options]\n"<<endl;
+   cout << "Options:\n"<<endl;
+   cout << "  --host <host:port>  Server to load. Default starts a server in this process."<<endl;
+   cout << "  --port <port>       Port for the in-process server. Default 8777."<<endl;
+   cout << "  --threads <n>       Worker threads for the in-process server. Default ossim_threads."<<endl;
+   cout << "  --clients <n>       Number of concurrent client connections. Default 8."<<endl;
+   cout << "  --requests <n>      Requests per client. Default 100."<<endl;
+   cout << "  --command <cmd>     Command to send. Default \"help\"."<<endl;
+   cout << endl;
+}
+
+int main(int argc, char *argv[])
+{
+   ossimArgumentParser ap(&argc, argv);
+   ossimInit::instance()->addOptions(ap);
+   ossimInit::instance()->initialize(ap);
+   ossimString tempString;
+   ossimArgumentParser::ossimParameter stringParam(tempString);
+
+   if ( ap.read("-h") || ap.read("--help") )
+   {
+      usage(ap[0]);
+      return 0;
+   }
+
+   ossimString host;
+   if ( ap.read("--host", stringParam) )
+      host = tempString;
+
+   ossimString port = "8777";
+   if ( ap.read("--port", stringParam) )
+      port = tempString;
+
+   ossim_uint32 threads = 0;
+   if ( ap.read("--threads", stringParam) )
+      threads = tempString.toUInt32();
+
+   ossim_uint32 clients = 8;
+   if ( ap.read("--clients", stringParam) )
+      clients = tempString.toUInt32();
+
+   ossim_uint32 requests = 100;
+   if ( ap.read("--requests", stringParam) )
+      requests = tempString.toUInt32();
+
+   ossimString command = "help";
+   if ( ap.read("--command", stringParam) )
+      command = tempString;
+
+   // Start an in-process server if no host given:
+   ossimToolServer server;
+   std::thread serverThread;
+   if ( host.empty() )
+   {
+      server.setNumberOfThreads(threads);
+      std::string portid = port.string();
+      serverThread = std::thread([&server, portid]() { server.startListening(portid.c_str()); });
+      host = ossimString("localhost:") + port;
+      sleep(1); // Give the listener a moment to bind.
+   }
+
+   std::mutex mutex;
+   std::vector<double> latencies;
+   std::atomic<ossim_uint32> failures(0);
+
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   std::vector<std::thread> workers;
+   for ( ossim_uint32 c = 0; c < clients; ++c )
+   {
+      workers.push_back( std::thread([&]()
+      {
+         ossimToolClient client;
+         std::string hostport = host.string();
+         if ( client.connectToServer(&hostport[0]) < 0 )
+         {
+            failures += requests;
+            return;
+         }
+         std::vector<double> mine;
+         for ( ossim_uint32 r = 0; r < requests; ++r )
+         {
+            std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            if ( !client.execute(command.chars()) )
+               ++failures;
+            std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+            mine.push_back(dt.count());
+         }
+         client.disconnect();
+         std::lock_guard<std::mutex> lock(mutex);
+         latencies.insert(latencies.end(), mine.begin(), mine.end());
+      }) );
+   }
+   for ( std::vector<std::thread>::iterator i = workers.begin(); i != workers.end(); ++i )
+      i->join();
+   std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+   std::sort(latencies.begin(), latencies.end());
+   cout << setiosflags(ios::fixed) << setprecision(6)
+        << "clients:     " << clients
+        << "\nrequests:    " << latencies.size()
+        << "\nfailures:    " << failures
+        << "\nelapsed_s:   " << elapsed.count()
+        << "\nrequests/s:  " << ( elapsed.count() > 0 ? latencies.size() / elapsed.count() : 0.0 );
+   if ( latencies.size() )
+   {
+      cout << "\np50_s:       " << latencies[latencies.size() / 2]
+           << "\np95_s:       " << latencies[(latencies.size() * 95) / 100]
+           << "\nmax_s:       " << latencies.back();
+   }
+   cout << endl;
+
+   // Ask the server for its view:
+   ossimToolClient statsClient;
+   std::string hostport = host.string();
+   if ( ( statsClient.connectToServer(&hostport[0]) >= 0 ) && statsClient.execute("stats") )
+      cout << "\nServer stats:\n" << statsClient.getTextResponse() << endl;
+   statsClient.disconnect();
+
+   if ( serverThread.joinable() )
+   {
+      server.stop();
+      serverThread.join();
+   }
+
+   return ( failures == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Replay benchmark of ossimChipperPool. Reads recorded
+// ossim-chipper command lines, one a line, and runs them all once with a new
+// ossimChipperUtil for each ("cold", what a run of ossim-chipper costs) and
+// then through the pool ("warm", what ossim-tool-server "chipper" costs).
+// Prints the time of every request, the totals and the pool hits.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimArgumentParser.h>
+#include <ossim/base/ossimException.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/util/ossimChipperPool.h>
+#include <ossim/util/ossimChipperUtil.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-chipper-replay Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+
+   if (argc < 2)
+   {
+      cout << argv[0] << " <requests_file> [<passes>]"
+           << "\nRuns the ossim-chipper command lines of requests_file, e.g."
+           << "\n  chipper --op ortho --cut-wms-bbox -80,40,-79.9,40.1"
+           << " --cut-width 256 --cut-height 256 in.tif out1.tif"
+           << "\nonce each on a new chipper and passes times (default 3) on pooled chippers."
+           << "\nThe first word of a line is taken as the program name and ignored." << endl;
+      return 0;
+   }
+
+   std::vector<std::string> requests;
+   std::ifstream in(argv[1]);
+   std::string line;
+   while (std::getline(in, line))
+   {
+      if (!line.empty() && (line[0] != '#'))
+      {
+         requests.push_back(line);
+      }
+   }
+   if (requests.empty())
+   {
+      cout << "  No requests in " << argv[1] << "\n  Failed." << endl;
+      return 1;
+   }
+   const ossim_uint32 PASSES = (argc > 2) ? ossimString(argv[2]).toUInt32() : 3;
+
+   ossimTimer* timer = ossimTimer::instance();
+   ossimChipperPool* pool = ossimChipperPool::instance();
+   cout << setiosflags(ios::fixed) << setprecision(4);
+
+   int failures = 0;
+   double coldTotal = 0.0;
+   double warmTotal = 0.0;
+   for (ossim_uint32 i = 0; i < requests.size(); ++i)
+   {
+      try
+      {
+         // Cold: everything opened and built for the one request.
+         ossimTimer::Timer_t t0 = timer->tick();
+         {
+            ossimString command = requests[i];
+            ossimArgumentParser ap(command);
+            ossimRefPtr<ossimChipperUtil> chipper = new ossimChipperUtil();
+            if (chipper->initialize(ap))
+            {
+               chipper->execute();
+            }
+         }
+         const double COLD = timer->delta_s(t0, timer->tick());
+         coldTotal += COLD;
+         cout << "  request " << setw(4) << i << "  cold: " << COLD << "s" << endl;
+      }
+      catch (const ossimException& e)
+      {
+         cout << "  request " << i << " failed: " << e.what() << endl;
+         ++failures;
+      }
+   }
+
+   for (ossim_uint32 pass = 0; pass < PASSES; ++pass)
+   {
+      double passTotal = 0.0;
+      for (ossim_uint32 i = 0; i < requests.size(); ++i)
+      {
+         try
+         {
+            ossimTimer::Timer_t t0 = timer->tick();
+            ossimString command = requests[i];
+            ossimArgumentParser ap(command);
+            ossimRefPtr<ossimChipperUtil> parser = new ossimChipperUtil();
+            if (parser->parseOptions(ap))
+            {
+               pool->execute(parser->getOptions());
+            }
+            passTotal += timer->delta_s(t0, timer->tick());
+         }
+         catch (const ossimException& e)
+         {
+            cout << "  request " << i << " failed on the pool: " << e.what() << endl;
+            ++failures;
+         }
+      }
+      cout << "  pass " << pass << "  warm: " << passTotal / requests.size() << "s a request"
+           << endl;
+      warmTotal += passTotal;
+   }
+
+   const ossimChipperPool::Stats STATS = pool->getStats();
+   const double COLD_MEAN = coldTotal / requests.size();
+   const double WARM_MEAN = PASSES ? warmTotal / (requests.size() * PASSES) : 0.0;
+   cout << "  requests:        " << requests.size()
+        << "\n  cold mean:       " << COLD_MEAN << "s"
+        << "\n  warm mean:       " << WARM_MEAN << "s"
+        << "\n  speedup:         " << setprecision(2) << (WARM_MEAN > 0.0 ? COLD_MEAN / WARM_MEAN : 0.0)
+        << "\n  pool hits:       " << STATS.m_hits
+        << "\n  pool misses:     " << STATS.m_misses
+        << "\n  idle chippers:   " << STATS.m_idle
+        << (failures ? "\n  Failed." : "\n  Passed.") << endl;
+
+   pool->clear();
+   return failures ? 1 : 0;
+}
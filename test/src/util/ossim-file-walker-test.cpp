@@ -0,0 +1,199 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test application for ossimFileWalker. Makes a directory tree,
+// walks it, and checks every file is processed once, filtered files and
+// directories a processFile asked not to recurse are left alone, and a
+// checkpointed walk skips unchanged files. The tree is made in a scratch
+// directory and removed after. Given a directory to walk, times a walk of it.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimFileProcessorInterface.h>
+#include <ossim/base/ossimFilename.h>
+#include <ossim/base/ossimString.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/util/ossimFileWalker.h>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <vector>
+
+using namespace std;
+
+static const int DIRS  = 20;
+static const int FILES = 50;
+
+class Counter : public ossimFileProcessorInterface
+{
+public:
+   Counter() : m_walker(0), m_count(0) {}
+
+   virtual void processFile(const ossimFilename& file)
+   {
+      ++m_count;
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if ( !m_files.insert(file.string()).second )
+      {
+         cout << "  processed twice: " << file << endl;
+      }
+      // Stands in for a directory based image, e.g. RPF:
+      if ( m_walker && (file.file() == "A.TOC") )
+      {
+         m_walker->setRecurseFlag(false);
+      }
+   }
+
+   void reset()
+   {
+      m_count = 0;
+      m_files.clear();
+   }
+
+   ossimFileWalker*      m_walker;
+   std::atomic<int>      m_count;
+   std::mutex            m_mutex;
+   std::set<std::string> m_files;
+};
+
+// Everything made, to remove in reverse order:
+static std::vector<ossimFilename> made;
+
+static void makeDir(const ossimFilename& dir)
+{
+   if ( !dir.exists() )
+   {
+      makeDir( dir.path() );
+      dir.createDirectory(false);
+      made.push_back(dir);
+   }
+}
+
+static void write(const ossimFilename& file, const std::string& text)
+{
+   if ( !file.exists() )
+   {
+      made.push_back(file);
+   }
+   std::ofstream out( file.c_str() );
+   out << text;
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-file-walker Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+
+   Counter counter;
+   ossimFileWalker walker;
+   walker.initializeDefaultFilterList();
+   walker.setFileProcessor(&counter);
+   walker.setNumberOfThreads(4);
+   ossimTimer* timer = ossimTimer::instance();
+
+   if (argc < 2)
+   {
+      cout << argv[0] << " <scratch_dir> [<dir_to_walk>]"
+           << "\nTests on a tree made in scratch_dir, or times a walk of dir_to_walk." << endl;
+      return 0;
+   }
+   if (argc > 2)
+   {
+      ossimTimer::Timer_t t0 = timer->tick();
+      walker.walk( ossimFilename(argv[2]) );
+      cout << "  files: " << counter.m_count << "  seconds: "
+           << timer->delta_s(t0, timer->tick()) << endl;
+      return 0;
+   }
+
+   // DIRS directories of FILES files each, with a filtered file, a dot file and a
+   // directory based "image" whose sub directory must not be walked:
+   ossimFilename root = ossimFilename(argv[1]).dirCat("ossim-file-walker-test");
+   if ( root.exists() )
+   {
+      cout << "  " << root << " is in the way.\n  Failed." << endl;
+      return 1;
+   }
+   for (int d = 0; d < DIRS; ++d)
+   {
+      ossimFilename dir = root.dirCat( ossimString::toString(d / 5) ).dirCat(
+         ossimString::toString(d) );
+      makeDir(dir);
+      for (int f = 0; f < FILES; ++f)
+      {
+         write( dir.dirCat( ossimString::toString(f) + ".tif" ), "x" );
+      }
+      write( dir.dirCat("a.ovr"), "x" );
+      write( dir.dirCat(".hidden"), "x" );
+   }
+   ossimFilename rpf = root.dirCat("rpf");
+   makeDir( rpf.dirCat("sub") );
+   write( rpf.dirCat("A.TOC"), "x" );
+   write( rpf.dirCat("sub").dirCat("1.tif"), "x" );
+   const int EXPECTED = DIRS * FILES + 1;
+
+   int failures = 0;
+   walker.setWaitOnDirFlag(true);
+   counter.m_walker = &walker;
+   ossimTimer::Timer_t t0 = timer->tick();
+   walker.walk(root);
+   const double SECONDS = timer->delta_s(t0, timer->tick());
+   if ( (counter.m_count != EXPECTED) || (counter.m_files.size() != (size_t)EXPECTED) )
+   {
+      cout << "  walk processed " << counter.m_count << " of " << EXPECTED << " files." << endl;
+      ++failures;
+   }
+
+   // A directory based image given on its own stops no later directory:
+   ossimFilename toc = ossimFilename(argv[1]).dirCat("ossim-file-walker-test-toc");
+   makeDir(toc);
+   write( toc.dirCat("A.TOC"), "x" );
+   std::vector<ossimFilename> files;
+   files.push_back( toc.dirCat("A.TOC") );
+   files.push_back(root);
+   counter.reset();
+   walker.walk(files);
+   if ( counter.m_count != EXPECTED + 1 )
+   {
+      cout << "  walk of a file and a directory processed " << counter.m_count << " of "
+           << EXPECTED + 1 << " files." << endl;
+      ++failures;
+   }
+
+   // Checkpointed: everything, then nothing, then the one file changed:
+   ossimFilename checkpoint = root + ".checkpoint";
+   made.insert(made.begin(), checkpoint);
+   walker.setCheckpointFile(checkpoint);
+   int counts[3];
+   for (int pass = 0; pass < 3; ++pass)
+   {
+      if (pass == 2)
+      {
+         write( root.dirCat("0").dirCat("0").dirCat("7.tif"), "changed" );
+      }
+      counter.reset();
+      walker.walk(root);
+      counts[pass] = counter.m_count;
+   }
+   if ( (counts[0] != EXPECTED) || (counts[1] != 0) || (counts[2] != 1) ||
+        (walker.getNumberOfSkippedFiles() != (ossim_uint64)(EXPECTED - 1)) )
+   {
+      cout << "  checkpointed walks processed " << counts[0] << ", " << counts[1] << " and "
+           << counts[2] << " files, expected " << EXPECTED << ", 0 and 1." << endl;
+      ++failures;
+   }
+
+   for (std::vector<ossimFilename>::reverse_iterator i = made.rbegin(); i != made.rend(); ++i)
+   {
+      i->remove();
+   }
+
+   cout << "  files: " << EXPECTED << "  seconds: " << setprecision(4) << SECONDS
+        << (failures ? "\n  Failed." : "\n  Passed.") << endl;
+   return failures;
+}
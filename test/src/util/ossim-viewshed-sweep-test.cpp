@@ -0,0 +1,138 @@
+//----------------------------------------------------------------------------
+//
+// License:  See top level LICENSE.txt file.
+//
+// Description: Test and benchmark of ossimViewshedSweep. Checks a flat plane
+// is all visible, the cells behind a wall are hidden, and that the sweep
+// agrees with exact lines of sight to every cell of rolling terrain but for a
+// few cells along the edges of hidden areas, and prints the time of both.
+//
+//----------------------------------------------------------------------------
+
+#include <ossim/init/ossimInit.h>
+#include <ossim/base/ossimTimer.h>
+#include <ossim/util/ossimViewshedSweep.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+static const ossim_int32 SIZE = 401;
+static const ossimIpt    OBSERVER(200, 200);
+static const double      EYE = 2.0;
+
+static int failures = 0;
+
+static void report(const char* name, bool ok)
+{
+   if (!ok)
+   {
+      ++failures;
+   }
+   cout << "  " << name << ": " << (ok ? "ok" : "WRONG") << endl;
+}
+
+// Height at a fractional position, bilinear between cells:
+static double heightAt(const vector<ossim_float32>& z, double x, double y)
+{
+   const ossim_int32 X0 = min<ossim_int32>(static_cast<ossim_int32>(x), SIZE - 2);
+   const ossim_int32 Y0 = min<ossim_int32>(static_cast<ossim_int32>(y), SIZE - 2);
+   const double FX = x - X0;
+   const double FY = y - Y0;
+   const ossim_float32* row = &z[Y0 * SIZE + X0];
+   return (1 - FY) * ((1 - FX) * row[0] + FX * row[1]) +
+          FY * ((1 - FX) * row[SIZE] + FX * row[SIZE + 1]);
+}
+
+// Exact line of sight to each cell, sampled every half cell:
+static void bruteForce(const vector<ossim_float32>& z, double height, vector<ossim_uint8>& bitmap)
+{
+   for (ossim_int32 y = 0; y < SIZE; ++y)
+   {
+      for (ossim_int32 x = 0; x < SIZE; ++x)
+      {
+         const double DX = x - OBSERVER.x;
+         const double DY = y - OBSERVER.y;
+         const double D = sqrt(DX * DX + DY * DY);
+         if (D == 0.0)
+         {
+            continue;
+         }
+         const double ANGLE = (z[y * SIZE + x] - height) / D;
+         bool visible = true;
+         for (double s = 0.5; visible && (s < D - 0.5); s += 0.5)
+         {
+            const double H = heightAt(z, OBSERVER.x + DX * s / D, OBSERVER.y + DY * s / D);
+            visible = ( (H - height) / s <= ANGLE );
+         }
+         bitmap[y * SIZE + x] = visible ? 1 : 128;
+      }
+   }
+}
+
+static void run(const vector<ossim_float32>& z, vector<ossim_uint8>& bitmap)
+{
+   ossimViewshedSweep sweep;
+   sweep.setElevations(&z.front(), SIZE, SIZE, ossimDpt(1.0, 1.0));
+   vector<ossim_float32> horizon;
+   fill(bitmap.begin(), bitmap.end(), 0);
+   sweep.compute(OBSERVER, z[OBSERVER.y * SIZE + OBSERVER.x] + EYE, &bitmap.front(), horizon);
+}
+
+int main(int argc, char* argv[])
+{
+   cout << "ossim-viewshed-sweep Test:" << endl;
+   ossimInit::instance()->initialize(argc, argv);
+   cout << setiosflags(ios::fixed) << setprecision(4);
+
+   vector<ossim_float32> z(SIZE * SIZE, 100.0f);
+   vector<ossim_uint8> bitmap(SIZE * SIZE);
+
+   // Flat plane, all visible:
+   run(z, bitmap);
+   report("flat", count(bitmap.begin(), bitmap.end(), 1) == SIZE * SIZE - 1);
+
+   // A wall ten cells east of the observer hides what is behind it:
+   for (ossim_int32 y = 150; y <= 250; ++y)
+   {
+      z[y * SIZE + 210] = 150.0f;
+   }
+   run(z, bitmap);
+   report("wall", (bitmap[200 * SIZE + 210] == 1) && (bitmap[200 * SIZE + 211] == 128) &&
+          (bitmap[200 * SIZE + 400] == 128) && (bitmap[200 * SIZE + 190] == 1));
+
+   // Rolling terrain:
+   for (ossim_int32 y = 0; y < SIZE; ++y)
+   {
+      for (ossim_int32 x = 0; x < SIZE; ++x)
+      {
+         z[y * SIZE + x] = static_cast<ossim_float32>(
+            100.0 + 20.0 * sin(x * 0.05) * cos(y * 0.037) + 8.0 * sin((x + 2 * y) * 0.11));
+      }
+   }
+   ossimTimer* timer = ossimTimer::instance();
+   ossimTimer::Timer_t t0 = timer->tick();
+   run(z, bitmap);
+   const double SWEEP = timer->delta_s(t0, timer->tick());
+
+   vector<ossim_uint8> exact(SIZE * SIZE, 0);
+   t0 = timer->tick();
+   bruteForce(z, z[OBSERVER.y * SIZE + OBSERVER.x] + EYE, exact);
+   const double EXACT = timer->delta_s(t0, timer->tick());
+
+   ossim_int32 same = 0;
+   for (ossim_int32 i = 0; i < SIZE * SIZE; ++i)
+   {
+      same += (bitmap[i] == exact[i]) ? 1 : 0;
+   }
+   const double AGREEMENT = static_cast<double>(same) / (SIZE * SIZE - 1);
+   cout << "  agreement with exact lines of sight: " << AGREEMENT << "  sweep: " << SWEEP
+        << "s  exact: " << EXACT << "s" << endl;
+   report("rolling", AGREEMENT > 0.95);
+
+   cout << (failures ? "  Failed." : "  Passed.") << endl;
+   return failures;
+}